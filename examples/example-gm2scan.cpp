@@ -20,10 +20,13 @@
 #include "gm2calc/gm2_2loop.hpp"
 #include "gm2calc/gm2_uncertainty.hpp"
 #include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_result_file.hpp"
 #include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/MSSMNoFV_onshell_pool.hpp"
 
 #include <cstdio>
 #include <iostream>
+#include <memory>
 #include <string>
 
 gm2calc::MSSMNoFV_onshell setup()
@@ -68,12 +71,34 @@ gm2calc::MSSMNoFV_onshell setup()
    return model;
 }
 
-int main()
+int main(int argc, char* argv[])
 {
    const double tanb_start = 2.;
    const double tanb_stop = 100.;
    const unsigned nsteps = 100;
 
+   const gm2calc::MSSMNoFV_onshell inputs(setup());
+   auto& pool = gm2calc::MSSMNoFV_onshell_pool::thread_local_instance();
+
+   // write results to a binary result file, if a file name is given
+   if (argc > 1) {
+      gm2calc::Result_file_writer writer(argv[1], gm2calc::get_mssmnofv_result_columns());
+
+      for (unsigned n = 0; n < nsteps; n++) {
+         auto model = pool.acquire(inputs);
+         model->set_TB(tanb_start + (tanb_stop - tanb_start) * n / nsteps);
+
+         try {
+            model->calculate_masses();
+            gm2calc::write_result(writer, *model);
+         } catch (const gm2calc::Error&) {
+            writer.write_error_row();
+         }
+      }
+
+      return 0;
+   }
+
    printf("# %14s %16s %16s %16s\n",
           "tan(beta)", "amu", "uncertainty", "error");
 
@@ -82,14 +107,15 @@ int main()
       const double tanb = tanb_start + (tanb_stop - tanb_start) * n / nsteps;
       std::string error;
 
-      gm2calc::MSSMNoFV_onshell model(setup());
-      model.set_TB(tanb);
+      // re-use a model from the pool
+      auto model = pool.acquire(inputs);
+      model->set_TB(tanb);
 
       try {
-         model.calculate_masses();
-         amu = gm2calc::calculate_amu_1loop(model)
-             + gm2calc::calculate_amu_2loop(model);
-         delta_amu = gm2calc::calculate_uncertainty_amu_2loop(model);
+         model->calculate_masses();
+         amu = gm2calc::calculate_amu_1loop(*model)
+             + gm2calc::calculate_amu_2loop(*model);
+         delta_amu = gm2calc::calculate_uncertainty_amu_2loop(*model);
       } catch (const gm2calc::Error& e) {
          error = "# " + std::string(e.what());
          amu = delta_amu = std::numeric_limits<double>::signaling_NaN();
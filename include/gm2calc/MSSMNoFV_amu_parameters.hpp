@@ -0,0 +1,101 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_MSSMNOFV_AMU_PARAMETERS_HPP
+#define GM2_MSSMNOFV_AMU_PARAMETERS_HPP
+
+#include <complex>
+#include <type_traits>
+
+namespace gm2calc {
+
+class MSSMNoFV_onshell;
+
+/**
+ * @class MSSMNoFV_amu_parameters
+ * @brief Flat snapshot of all MSSMNoFV parameters which enter the 1-
+ * and 2-loop contributions to a_mu.
+ *
+ * The struct is trivially copyable and contains no pointers, so it
+ * can be copied with memcpy, stored in arrays, shared between
+ * threads and written to/read from binary files.  It is filled by
+ * make_amu_parameters() from a model, after the model has been
+ * converted to the on-shell scheme.  All matrices are stored in
+ * column-major order, i.e. element (i,k) of an N x N matrix M is
+ * M[i + N*k].  Of the soft-breaking and Yukawa matrices only the
+ * diagonal elements are stored.
+ */
+struct MSSMNoFV_amu_parameters {
+   // SM parameters
+   double MM{0.};           ///< muon pole mass
+   double MW{0.};           ///< W boson pole mass
+   double MZ{0.};           ///< Z boson pole mass
+   double MT{0.};           ///< top quark pole mass
+   double EL{0.};           ///< electromagnetic gauge coupling in the MS-bar scheme at Q = MZ
+   double EL0{0.};          ///< electromagnetic gauge coupling in the Thomson limit
+   double gY{0.};           ///< hypercharge gauge coupling
+   double g2{0.};           ///< left-handed gauge coupling
+   double g3{0.};           ///< strong gauge coupling
+   double Ye[3]{};          ///< diagonal elements of the lepton Yukawa coupling
+   double Yu[3]{};          ///< diagonal elements of the up-type quark Yukawa coupling
+   double Yd[3]{};          ///< diagonal elements of the down-type quark Yukawa coupling
+
+   // SUSY parameters
+   double scale{0.};        ///< renormalization scale
+   double TB{0.};           ///< tan(beta)
+   double Mu{0.};           ///< superpotential parameter mu
+   double MassB{0.};        ///< bino mass parameter M1
+   double MassWB{0.};       ///< wino mass parameter M2
+   double MassG{0.};        ///< gluino mass parameter M3
+   double MA0{0.};          ///< CP-odd Higgs boson mass
+   double Ae[3]{};          ///< diagonal elements of the lepton trilinear couplings
+   double Au[3]{};          ///< diagonal elements of the up-type trilinear couplings
+   double Ad[3]{};          ///< diagonal elements of the down-type trilinear couplings
+   double ml2[3]{};         ///< diagonal elements of the left-handed slepton mass matrix
+   double me2[3]{};         ///< diagonal elements of the right-handed slepton mass matrix
+   double mq2[3]{};         ///< diagonal elements of the left-handed squark mass matrix
+   double mu2[3]{};         ///< diagonal elements of the right-handed up-type squark mass matrix
+   double md2[3]{};         ///< diagonal elements of the right-handed down-type squark mass matrix
+
+   // masses and mixing matrices
+   double MSvmL{0.};        ///< muon sneutrino mass
+   double MSm[2]{};         ///< smuon masses
+   double USm[4]{};         ///< smuon mixing matrix
+   double MSt[2]{};         ///< stop masses
+   double USt[4]{};         ///< stop mixing matrix
+   double MSb[2]{};         ///< sbottom masses
+   double USb[4]{};         ///< sbottom mixing matrix
+   double MStau[2]{};       ///< stau masses
+   double UStau[4]{};       ///< stau mixing matrix
+   double Mhh[2]{};         ///< CP-even Higgs boson masses
+   double MChi[4]{};        ///< neutralino masses
+   std::complex<double> ZN[16]{}; ///< neutralino mixing matrix
+   double MCha[2]{};        ///< chargino masses
+   std::complex<double> UM[4]{};  ///< chargino mixing matrix U
+   std::complex<double> UP[4]{};  ///< chargino mixing matrix V
+};
+
+static_assert(std::is_trivially_copyable<MSSMNoFV_amu_parameters>::value,
+              "MSSMNoFV_amu_parameters must be trivially copyable");
+
+/// extracts the parameters which enter a_mu from the given model
+MSSMNoFV_amu_parameters make_amu_parameters(const MSSMNoFV_onshell&);
+
+} // namespace gm2calc
+
+#endif
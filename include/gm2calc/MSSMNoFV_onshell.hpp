@@ -28,6 +28,8 @@
 
 namespace gm2calc {
 
+class Cancellation_token;
+
 /**
  * @class MSSMNoFV_onshell
  * @brief contains the MSSMNoFV parameters in the on-shell scheme
@@ -55,6 +57,12 @@ public:
    void set_alpha_MZ(double);
    /// set alpha in the Thomson limit
    void set_alpha_thompson(double);
+   /// set electromagnetic gauge coupling at MZ w/o hadronic corrections
+   void set_EL(double e) { EL = e; }
+   /// set electromagnetic gauge coupling in the Thomson limit
+   void set_EL0(double e) { EL0 = e; }
+   /// set mb(MZ) DR-bar
+   void set_MB(double m) { mb_DRbar_MZ = m; }
    /// soft-breaking trilinear on-shell down-type slepton coupling
    void set_Ae(const Eigen::Matrix<double,3,3>& A) { Ae = A; }
    /// soft-breaking trilinear up-type squark coupling
@@ -72,6 +80,11 @@ public:
    /// set tan(beta)
    void set_TB(double);
 
+   /// reset all parameters to their default values
+   void reset();
+   /// copy the input parameters from the given model and clear the problems
+   void assign_inputs(const MSSMNoFV_onshell&);
+
    /// electromagnetic gauge coupling at MZ w/o hadronic corrections
    double get_EL() const { return EL; }
    /// electromagnetic gauge coupling in Thomson limit
@@ -144,7 +157,8 @@ public:
 
    /// convert given (DR-bar) parameters to mixed on-shell/DR-bar scheme
    void convert_to_onshell(double precision = 1e-8,
-                           unsigned max_iterations = 1000);
+                           unsigned max_iterations = 1000,
+                           const Cancellation_token* token = nullptr);
 
    /// convert mixed on-shell/DR-bar parameters to non-tan(beta) resummed case
    void convert_to_non_tan_beta_resummed();
@@ -157,9 +171,11 @@ private:
    Eigen::Matrix<double,3,3> Au{Eigen::Matrix<double,3,3>::Zero()}; ///< trilinear couplings
    Eigen::Matrix<double,3,3> Ad{Eigen::Matrix<double,3,3>::Zero()}; ///< trilinear couplings
    Eigen::Matrix<double,3,3> Ae{Eigen::Matrix<double,3,3>::Zero()}; ///< trilinear couplings
+   const Cancellation_token* cancellation_token{nullptr}; ///< token of the running conversion
 
    void check_input() const;
    void check_problems() const;
+   bool is_cancelled() const;
    void calculate_mb_DRbar_MZ();
    void convert_gauge_couplings();
    void convert_yukawa_couplings_treelevel();
@@ -168,9 +184,14 @@ private:
    void convert_me2(double, unsigned);
    double convert_me2_fpi(double, unsigned);
    double convert_me2_fpi_modify(double, unsigned);
+   double convert_me2_newton(double, unsigned);
+   double convert_me2_newton_modify(double, unsigned);
    double convert_me2_root(double, unsigned);
    double convert_me2_root_modify(double, unsigned);
    void convert_Mu_M1_M2(double, unsigned);
+   double convert_Mu_M1_M2_fpi(double, unsigned);
+   double convert_Mu_M1_M2_newton(double, unsigned);
+   double convert_Mu_M1_M2_newton_modify(double, unsigned);
    void convert_vev();
    void convert_yukawa_couplings();
    void copy_susy_masses_to_pole();
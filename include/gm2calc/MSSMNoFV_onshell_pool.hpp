@@ -0,0 +1,111 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_MSSMNoFV_ONSHELL_POOL_HPP
+#define GM2_MSSMNoFV_ONSHELL_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace gm2calc {
+
+class MSSMNoFV_onshell;
+
+/**
+ * @class MSSMNoFV_onshell_pool
+ * @brief pool of re-usable MSSMNoFV_onshell objects for parameter scans
+ *
+ * A model is borrowed from the pool with acquire() and is returned to
+ * the pool when the returned handle is destroyed.  Once the pool
+ * holds enough models (see reserve()), acquiring and returning a
+ * model does not allocate memory on the heap.
+ *
+ * A pool must only be used by one thread at a time.  Each thread has
+ * its own pool, which is returned by thread_local_instance().
+ *
+ * Example:
+ * @code
+ * const MSSMNoFV_onshell inputs = ...;
+ * auto& pool = MSSMNoFV_onshell_pool::thread_local_instance();
+ *
+ * for (...) {
+ *    auto model = pool.acquire(inputs);
+ *    model->set_TB(tanb);
+ *    model->calculate_masses();
+ *    ...
+ * }
+ * @endcode
+ */
+class MSSMNoFV_onshell_pool {
+public:
+   /**
+    * @class Handle
+    * @brief model borrowed from a pool, returned to the pool on destruction
+    */
+   class Handle {
+   public:
+      Handle(Handle&&) noexcept;
+      Handle(const Handle&) = delete;
+      ~Handle();
+      Handle& operator=(Handle&&) noexcept;
+      Handle& operator=(const Handle&) = delete;
+
+      MSSMNoFV_onshell& operator*() const { return *model; }
+      MSSMNoFV_onshell* operator->() const { return model.get(); }
+      MSSMNoFV_onshell* get() const { return model.get(); }
+
+   private:
+      friend class MSSMNoFV_onshell_pool;
+
+      Handle(MSSMNoFV_onshell_pool*, std::unique_ptr<MSSMNoFV_onshell>) noexcept;
+      void release() noexcept;
+
+      MSSMNoFV_onshell_pool* pool{nullptr};   ///< pool to return the model to
+      std::unique_ptr<MSSMNoFV_onshell> model; ///< borrowed model
+   };
+
+   MSSMNoFV_onshell_pool();
+   MSSMNoFV_onshell_pool(const MSSMNoFV_onshell_pool&) = delete;
+   MSSMNoFV_onshell_pool(MSSMNoFV_onshell_pool&&) = delete;
+   ~MSSMNoFV_onshell_pool();
+   MSSMNoFV_onshell_pool& operator=(const MSSMNoFV_onshell_pool&) = delete;
+   MSSMNoFV_onshell_pool& operator=(MSSMNoFV_onshell_pool&&) = delete;
+
+   /// borrow a model with default parameters
+   Handle acquire();
+   /// borrow a model with the parameters of the given model
+   Handle acquire(const MSSMNoFV_onshell&);
+   /// pre-allocate models, such that n models can be borrowed at the same time
+   void reserve(std::size_t n);
+   /// number of models available in the pool
+   std::size_t size() const { return models.size(); }
+
+   /// returns the pool of the current thread
+   static MSSMNoFV_onshell_pool& thread_local_instance();
+
+private:
+   std::vector<std::unique_ptr<MSSMNoFV_onshell>> models; ///< available models
+
+   std::unique_ptr<MSSMNoFV_onshell> take();
+   void put_back(std::unique_ptr<MSSMNoFV_onshell>) noexcept;
+};
+
+} // namespace gm2calc
+
+#endif
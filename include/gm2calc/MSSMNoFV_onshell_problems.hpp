@@ -45,11 +45,14 @@ public:
    void clear();              ///< delete all problems and warnings
    void clear_problems();     ///< delete all problems
    void clear_warnings();     ///< delete all warnings
+   void flag_conversion_cancelled();
    void flag_no_convergence_Mu_MassB_MassWB(double, unsigned);
    void flag_no_convergence_me2(double, unsigned);
    void flag_tachyon(const std::string&);
+   void unflag_conversion_cancelled();
    void unflag_no_convergence_Mu_MassB_MassWB();
    void unflag_no_convergence_me2();
+   bool conversion_cancelled() const;
    bool no_Mu_MassB_MassWB_convergence() const;
    bool no_me2_convergence() const;
    Convergence_problem get_Mu_MassB_MassWB_convergence_problem() const;
@@ -64,6 +67,7 @@ public:
    void print_warnings(std::ostream&) const; ///< print warnings to stream
 
 private:
+   bool have_conversion_cancelled{false};
    bool have_no_convergence_Mu_MassB_MassWB{false};
    bool have_no_convergence_me2{false};
    std::vector<std::string> tachyons;
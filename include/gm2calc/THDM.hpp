@@ -122,6 +122,11 @@ public:
    Eigen::Matrix<std::complex<double>,3,3> get_ylHp() const;
 
    const SM& get_sm() const { return sm; }
+   thdm::Yukawa_type get_yukawa_type() const { return yukawa_type; }
+   const Eigen::Matrix<double,3,3>& get_Delta_u() const { return Delta_u; }
+   const Eigen::Matrix<double,3,3>& get_Delta_d() const { return Delta_d; }
+   const Eigen::Matrix<double,3,3>& get_Delta_l() const { return Delta_l; }
+   const thdm::Config& get_config() const { return config; }
 
    void set_tan_beta(double);
 
@@ -188,12 +193,6 @@ private:
    Eigen::Matrix<double,3,3> Delta_l{Eigen::Matrix<double,3,3>::Zero()}; ///< deviation from alignment
    thdm::Config config{}; ///< configuration options
 
-   Eigen::Matrix<double,3,1> get_mu(double) const;
-   Eigen::Matrix<double,3,1> get_md(double) const;
-   Eigen::Matrix<double,3,1> get_ml(double) const;
-   Eigen::Matrix<std::complex<double>,3,3> get_rho_u(const Eigen::Matrix<double,3,3>&) const;
-   Eigen::Matrix<std::complex<double>,3,3> get_rho_d(const Eigen::Matrix<double,3,3>&) const;
-   Eigen::Matrix<std::complex<double>,3,3> get_rho_l(const Eigen::Matrix<double,3,3>&) const;
    void init_gauge_couplings();
    void init_yukawas();
    void set_basis(const thdm::Gauge_basis&);
@@ -0,0 +1,159 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_THDM_EMULATOR_HPP
+#define GM2_THDM_EMULATOR_HPP
+
+#include "gm2calc/SM.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file THDM_emulator.hpp
+ * @brief fast approximation of a_mu(1-loop + 2-loop) in the THDM by a
+ * tensor product Chebyshev expansion
+ *
+ * The emulator approximates a_mu in a box of a few THDM parameters
+ * (e.g. mA, mH, mHp, tan(beta), zeta_l, cos(beta - alpha)), while all
+ * other parameters are fixed.  It is built once from a_mu evaluated at
+ * the Chebyshev nodes, can be written to a file and is then evaluated
+ * with a few floating point operations per coefficient.  The error of
+ * the emulator is estimated from a_mu evaluated at random points in
+ * the box.
+ *
+ * Example:
+ * @code
+ * thdm::Emulator_options options;
+ * options.axes = {{"mA", 20, 100, 16, true}, {"tan_beta", 10, 100, 16}};
+ * const auto emulator = THDM_emulator::build(basis, options);
+ * emulator.write("amu_mA_tb.emu");
+ * ...
+ * const THDM_emulator emulator("amu_mA_tb.emu");
+ * const double x[2] = {mA, tb};
+ * const double amu = emulator.evaluate(x);
+ * @endcode
+ */
+
+namespace gm2calc {
+
+namespace thdm {
+
+/**
+ * @class Emulator_axis
+ * @brief parameter of the emulator
+ *
+ * The name is one of the column names of a THDM table in the mass
+ * basis (see GM2_thdm_table), e.g. mA or tan_beta, or
+ * cos_beta_minus_alpha, which sets sin(beta - alpha) =
+ * sqrt(1 - cos(beta - alpha)^2).  As the mass basis only represents
+ * cos(beta - alpha) >= 0, its range must lie within [0,1].
+ */
+struct Emulator_axis {
+   std::string name{};      ///< parameter name
+   double min{0.0};         ///< lower end of the range
+   double max{0.0};         ///< upper end of the range
+   unsigned nodes{16};      ///< number of Chebyshev nodes
+   bool log_scale{false};   ///< expansion in the logarithm of the parameter
+};
+
+/**
+ * @class Emulator_options
+ * @brief options for building an emulator
+ *
+ * Chebyshev coefficients are dropped, as long as the sum of their
+ * absolute values (an upper bound of the change of the emulator) is
+ * below truncation*max|a_mu| at the nodes.
+ */
+struct Emulator_options {
+   std::vector<Emulator_axis> axes{};  ///< parameters of the emulator
+   double truncation{1e-6};            ///< relative truncation threshold
+   unsigned samples{1000};             ///< number of random points to estimate the error
+   std::uint64_t seed{1};              ///< seed of the random number generator
+   unsigned threads{0};                ///< number of threads (0 = number of CPU cores)
+};
+
+} // namespace thdm
+
+/**
+ * @class THDM_emulator
+ * @brief tensor product Chebyshev expansion of a_mu(1-loop + 2-loop)
+ * in the THDM
+ */
+class THDM_emulator {
+public:
+   /// maximum number of parameters
+   static constexpr unsigned max_dimension = 8;
+   /// maximum number of Chebyshev nodes per parameter
+   static constexpr unsigned max_nodes = 64;
+
+   THDM_emulator() = default;
+   /// reads the emulator from a file
+   explicit THDM_emulator(const std::string& file_name);
+
+   /// builds the emulator around the given parameter point
+   static THDM_emulator build(const thdm::Mass_basis&, const thdm::Emulator_options&,
+                              const SM& sm = SM{}, const thdm::Config& config = thdm::Config{});
+
+   /// writes the emulator to a file
+   void write(const std::string& file_name) const;
+
+   /// approximation of a_mu at the given parameter values
+   double evaluate(const double* x) const;
+   /// approximation of a_mu at the given parameter values
+   double evaluate(const std::vector<double>& x) const;
+   /// a_mu at the given parameter values, calculated without the emulator
+   double evaluate_exact(const double* x, const SM& sm = SM{},
+                         const thdm::Config& config = thdm::Config{}) const;
+   /// THDM parameters at the given parameter values
+   thdm::Mass_basis get_basis(const double* x) const;
+
+   /// number of parameters
+   std::size_t get_dimension() const { return axes.size(); }
+   /// parameters of the emulator
+   const std::vector<thdm::Emulator_axis>& get_axes() const { return axes; }
+   /// number of stored Chebyshev coefficients
+   std::size_t get_number_of_coefficients() const { return coefficients.size(); }
+   /// maximum absolute deviation from a_mu at the random sample points
+   double get_max_abs_error() const { return max_abs_error; }
+   /// maximum relative deviation from a_mu at the random sample points
+   double get_max_rel_error() const { return max_rel_error; }
+   /// number of random sample points used to estimate the error
+   std::uint64_t get_number_of_samples() const { return samples; }
+
+private:
+   thdm::Mass_basis basis{};              ///< fixed parameters
+   std::vector<thdm::Emulator_axis> axes; ///< parameters of the emulator
+   std::vector<std::uint8_t> indices;     ///< Chebyshev degrees of the coefficients (dimension per coefficient)
+   std::vector<double> coefficients;      ///< Chebyshev coefficients
+   double max_abs_error{0.0};             ///< estimated maximum absolute error
+   double max_rel_error{0.0};             ///< estimated maximum relative error
+   std::uint64_t samples{0};              ///< number of random sample points
+   std::vector<double> scales;            ///< t = scale*x + offset (or log(x)) for each axis
+   std::vector<double> offsets;           ///< t = scale*x + offset (or log(x)) for each axis
+   std::vector<unsigned> degrees;         ///< number of Chebyshev polynomials used for each axis
+
+   void check() const;
+   void initialize();
+};
+
+} // namespace gm2calc
+
+#endif
@@ -23,23 +23,28 @@ namespace gm2calc {
 
 class THDM;
 class MSSMNoFV_onshell;
+struct MSSMNoFV_amu_parameters;
 
 /// calculates full 1-loop contributions to a_mu in the general THDM
 double calculate_amu_1loop(const THDM&);
 
 /// calculates full 1-loop SUSY contributions to (g-2) in the MSSM (w/ tan(beta) resummation)
 double calculate_amu_1loop(const MSSMNoFV_onshell&);
+double calculate_amu_1loop(const MSSMNoFV_amu_parameters&);
 
 /// calculates full 1-loop SUSY contributions to (g-2) in the MSSM (no tan(beta) resummation)
+/// (needs the model to re-calculate the masses, so there is no MSSMNoFV_amu_parameters overload)
 double calculate_amu_1loop_non_tan_beta_resummed(const MSSMNoFV_onshell&);
 
 // === routines for individual 1-loop contributions ===
 
 /// 1-loop neutralino contribution
 double amu1LChi0(const MSSMNoFV_onshell&);
+double amu1LChi0(const MSSMNoFV_amu_parameters&);
 
 /// 1-loop chargino contribution
 double amu1LChipm(const MSSMNoFV_onshell&);
+double amu1LChipm(const MSSMNoFV_amu_parameters&);
 
 } // namespace gm2calc
 
@@ -23,14 +23,17 @@ namespace gm2calc {
 
 class THDM;
 class MSSMNoFV_onshell;
+struct MSSMNoFV_amu_parameters;
 
 /// calculates full 2-loop contributions to a_mu in the general THDM
 double calculate_amu_2loop(const THDM&);
 
 /// calculates best 2-loop SUSY contributions to a_mu in the MSSM (with tan(beta) resummation)
 double calculate_amu_2loop(const MSSMNoFV_onshell&);
+double calculate_amu_2loop(const MSSMNoFV_amu_parameters&);
 
 /// calculates best 2-loop SUSY contributions to a_mu in the MSSM (no tan(beta) resummation)
+/// (needs the model to re-calculate the masses, so there is no MSSMNoFV_amu_parameters overload)
 double calculate_amu_2loop_non_tan_beta_resummed(const MSSMNoFV_onshell&);
 
 // === routines for individual 2-loop contributions ===
@@ -43,21 +46,27 @@ double calculate_amu_2loop_fermionic(const THDM&);
 
 /// 2-loop fermion/sfermion contribution (approximation)
 double amu2LFSfapprox(const MSSMNoFV_onshell&);
+double amu2LFSfapprox(const MSSMNoFV_amu_parameters&);
 
 /// 2-loop fermion/sfermion contribution (approximation) w/o tan(beta) resummation
 double amu2LFSfapprox_non_tan_beta_resummed(const MSSMNoFV_onshell&);
+double amu2LFSfapprox_non_tan_beta_resummed(const MSSMNoFV_amu_parameters&);
 
 /// 2-loop photonic chargino contribution
 double amu2LChipmPhotonic(const MSSMNoFV_onshell&);
+double amu2LChipmPhotonic(const MSSMNoFV_amu_parameters&);
 
 /// 2-loop photonic neutralino contribution
 double amu2LChi0Photonic(const MSSMNoFV_onshell&);
+double amu2LChi0Photonic(const MSSMNoFV_amu_parameters&);
 
 /// 2-loop 2L(a) sfermion contribution
 double amu2LaSferm(const MSSMNoFV_onshell&);
+double amu2LaSferm(const MSSMNoFV_amu_parameters&);
 
 /// 2-loop 2L(a) chargino/neutralino contribution
 double amu2LaCha(const MSSMNoFV_onshell&);
+double amu2LaCha(const MSSMNoFV_amu_parameters&);
 
 } // namespace gm2calc
 
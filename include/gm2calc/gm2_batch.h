@@ -0,0 +1,66 @@
+/* ====================================================================
+ * This file is part of GM2Calc.
+ *
+ * GM2Calc is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * GM2Calc is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GM2Calc.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ * ==================================================================== */
+
+#ifndef GM2_BATCH_H
+#define GM2_BATCH_H
+
+/**
+ * @file gm2_batch.h
+ * @brief contains declarations of C interface functions for lists of
+ * parameter points
+ *
+ * This file contains the declarations for the C interface functions
+ * used to calculate \f$a_\mu\f$ and its uncertainty for many
+ * parameter points in one call, optionally on multiple threads.
+ */
+
+#include "gm2calc/gm2_error.h"
+#include "gm2calc/MSSMNoFV_onshell.h"
+#include "gm2calc/THDM.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** calculates amu and its uncertainty for a list of THDM points with gauge basis input */
+void gm2calc_thdm_calculate_amu_gauge_basis_list(
+   const gm2calc_THDM_gauge_basis* /* basis */, size_t /* n */,
+   const gm2calc_SM*, const gm2calc_THDM_config*, int /* loop_order */,
+   unsigned /* threads */, double* /* amu */, double* /* damu */,
+   gm2calc_error* /* status */);
+
+/** calculates amu and its uncertainty for a list of THDM points with mass basis input */
+void gm2calc_thdm_calculate_amu_mass_basis_list(
+   const gm2calc_THDM_mass_basis* /* basis */, size_t /* n */,
+   const gm2calc_SM*, const gm2calc_THDM_config*, int /* loop_order */,
+   unsigned /* threads */, double* /* amu */, double* /* damu */,
+   gm2calc_error* /* status */);
+
+/** calculates amu and its uncertainty for a list of MSSMNoFV points in the GM2Calc input scheme */
+void gm2calc_mssmnofv_calculate_amu_gm2calc_scheme_list(
+   MSSMNoFV_onshell** /* model */, size_t /* n */, int /* loop_order */,
+   int /* tan_beta_resummation */, unsigned /* threads */,
+   double* /* amu */, double* /* damu */, gm2calc_error* /* status */);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,235 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_BATCH_HPP
+#define GM2_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file gm2_batch.hpp
+ * @brief ring buffer of parameter points, which are evaluated by a
+ * pool of worker threads
+ *
+ * A producer writes input records into the slots of a Batch_queue,
+ * the workers evaluate the records in place and the producer reads
+ * the results in the order in which the records have been written.
+ * Handing a point over does not involve a system call or a
+ * serialization step.
+ *
+ * The queue either lives in the memory of the process or in a named
+ * POSIX shared memory object, such that the producer and the workers
+ * may run in different processes on the same node (see the command
+ * line option `--batch-queue=<name>` of gm2calc.x).
+ */
+
+namespace gm2calc {
+
+/// type of a batch record
+enum Batch_record_type : std::uint32_t {
+   Batch_thdm_mass_basis = 1, ///< THDM in the mass basis
+   Batch_mssmnofv = 2,        ///< MSSMNoFV in the GM2Calc input scheme
+};
+
+/// status of a batch record
+enum Batch_status : std::uint32_t {
+   Batch_ok = 0,               ///< success
+   Batch_invalid_input = 1,    ///< invalid input parameters
+   Batch_physical_problem = 2, ///< physical problem (e.g. tachyon)
+   Batch_error = 3,            ///< other error
+};
+
+/**
+ * @class Batch_record
+ * @brief input parameters and results of one parameter point
+ *
+ * The input parameters are:
+ *
+ * - Batch_thdm_mass_basis: yukawa_type, mh, mH, mA, mHp,
+ *   sin_beta_minus_alpha, lambda_6, lambda_7, tan_beta, m122, zeta_u,
+ *   zeta_d, zeta_l (13 values)
+ *
+ * - Batch_mssmnofv: TB, Mu, MassB, MassWB, MassG, MA0, scale,
+ *   followed by the diagonal elements of mq2, mu2, md2, ml2, me2, Au,
+ *   Ad, Ae (31 values)
+ *
+ * The SM parameters and the configuration options are set to their
+ * default values.  The results are a_mu (1- plus 2-loop) and its
+ * uncertainty.  If the evaluation fails, the results are NaN and the
+ * status describes the error.
+ */
+struct Batch_record {
+   static constexpr std::size_t max_inputs = 31;
+
+   std::uint32_t type{Batch_thdm_mass_basis}; ///< record type
+   std::uint32_t status{Batch_ok};            ///< status
+   double input[max_inputs]{};                ///< input parameters
+   double amu{0.0};                           ///< a_mu
+   double damu{0.0};                          ///< uncertainty of a_mu
+};
+
+/// evaluates the record (throws on error)
+void evaluate(Batch_record&);
+
+/**
+ * @class Batch_columns
+ * @brief column-wise input parameters of a list of points
+ *
+ * Each input parameter of the Batch_record (see there for the order)
+ * is given either by an array of n values, which is not copied and
+ * must outlive the object, or by a single value for all points.
+ * Parameters which are not set are zero.
+ *
+ * Example:
+ * @code
+ * Batch_columns columns(Batch_thdm_mass_basis, n);
+ * columns.set_value(0, 2);     // yukawa_type
+ * columns.set_column(2, mH);   // mH
+ * ...
+ * evaluate(columns, amu, damu, status, 4);
+ * @endcode
+ */
+class Batch_columns {
+public:
+   Batch_columns(Batch_record_type type, std::size_t n);
+
+   /// sets the i-th input parameter to an array of n values
+   void set_column(std::size_t i, const double* values);
+   /// sets the i-th input parameter to the same value for all points
+   void set_value(std::size_t i, double value);
+   /// returns the number of points
+   std::size_t size() const { return n; }
+   /// returns the record type
+   Batch_record_type get_type() const { return type; }
+   /// fills the record of the k-th point
+   void fill(std::size_t k, Batch_record&) const;
+
+private:
+   Batch_record_type type{Batch_thdm_mass_basis}; ///< record type
+   std::size_t n{0};                              ///< number of points
+   const double* columns[Batch_record::max_inputs]{}; ///< arrays of values
+   double values[Batch_record::max_inputs]{};         ///< single values
+};
+
+/// evaluates all points, writes n results into amu, damu and status
+void evaluate(const Batch_columns&, double* amu, double* damu,
+              std::uint32_t* status, unsigned threads = 0);
+
+/**
+ * @class Batch_queue
+ * @brief ring buffer of batch records
+ *
+ * The queue has one producer and any number of workers.  The producer
+ * writes a record with begin_write()/end_write() and reads the result
+ * with begin_read()/end_read(); the results are read in the order in
+ * which the records have been written.  At most get_capacity()
+ * records may be written, but not yet read.  The workers evaluate the
+ * records with consume() until the queue is closed.
+ *
+ * Example:
+ * @code
+ * Batch_queue queue(1024);
+ * Batch_worker_pool workers(queue, 4);
+ *
+ * std::vector<Batch_record> records = ...;
+ * queue.process(records.data(), records.size());
+ * @endcode
+ */
+class Batch_queue {
+public:
+   /// creates a queue in the memory of the process
+   explicit Batch_queue(std::size_t capacity);
+   /// creates a queue in a named shared memory object (name starts with /)
+   Batch_queue(const std::string& name, std::size_t capacity);
+   /// opens a queue created by another process
+   explicit Batch_queue(const std::string& name);
+   Batch_queue(const Batch_queue&) = delete;
+   Batch_queue(Batch_queue&&) = delete;
+   ~Batch_queue();
+   Batch_queue& operator=(const Batch_queue&) = delete;
+   Batch_queue& operator=(Batch_queue&&) = delete;
+
+   /// maximum number of records in flight
+   std::size_t get_capacity() const;
+
+   // producer interface
+   /// waits for a free slot and returns its record
+   Batch_record& begin_write();
+   /// passes the record of the slot to the workers
+   void end_write();
+   /// waits for the result of the oldest record and returns it
+   const Batch_record& begin_read();
+   /// releases the slot of the oldest record
+   void end_read();
+   /// number of records written, but not yet read
+   std::size_t get_number_of_pending() const;
+   /// evaluates the given records in place
+   void process(Batch_record*, std::size_t);
+   /// stops the workers
+   void close();
+
+   // worker interface
+   /// evaluates the next record, returns false if the queue is closed
+   bool consume();
+   /// returns true if the queue is closed
+   bool is_closed() const;
+
+private:
+   struct Header;
+   struct Slot;
+
+   std::string name;            ///< shared memory name (empty if private)
+   bool owner{false};           ///< queue has been created by this object
+   std::size_t size{0};         ///< size of the memory
+   void* memory{nullptr};       ///< memory
+   Header* header{nullptr};     ///< header
+   Slot* slots{nullptr};        ///< slots
+
+   void init(std::size_t);
+   void attach();
+   Slot& get_slot(std::uint64_t) const;
+};
+
+/**
+ * @class Batch_worker_pool
+ * @brief worker threads which evaluate the records of a queue
+ *
+ * The queue is closed and the threads are joined when the pool is
+ * destroyed.
+ */
+class Batch_worker_pool {
+public:
+   Batch_worker_pool(Batch_queue&, unsigned threads);
+   Batch_worker_pool(const Batch_worker_pool&) = delete;
+   Batch_worker_pool(Batch_worker_pool&&) = delete;
+   ~Batch_worker_pool();
+   Batch_worker_pool& operator=(const Batch_worker_pool&) = delete;
+   Batch_worker_pool& operator=(Batch_worker_pool&&) = delete;
+
+private:
+   Batch_queue& queue;               ///< queue
+   std::vector<std::thread> workers; ///< worker threads
+};
+
+} // namespace gm2calc
+
+#endif
@@ -0,0 +1,96 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_CANCELLATION_HPP
+#define GM2_CANCELLATION_HPP
+
+#include <atomic>
+#include <chrono>
+
+/**
+ * @file gm2_cancellation.hpp
+ * @brief time budget and cancellation of long-running calculations
+ *
+ * A Cancellation_token is passed (as pointer) to
+ * MSSMNoFV_onshell::convert_to_onshell() and to the scan functions.
+ * These check the token once per iteration or per point and stop
+ * early if it has been cancelled or its deadline has passed.
+ *
+ * Example:
+ * @code
+ * const Cancellation_token token(std::chrono::milliseconds(200));
+ * model.convert_to_onshell(1e-8, 1000, &token);
+ * if (model.get_problems().conversion_cancelled()) {
+ *    ...
+ * }
+ * @endcode
+ */
+
+namespace gm2calc {
+
+/**
+ * @class Cancellation_token
+ * @brief flag to cancel a calculation, with an optional deadline
+ *
+ * The token may be cancelled from any thread.
+ */
+class Cancellation_token {
+public:
+   using Clock = std::chrono::steady_clock;
+
+   /// token without deadline
+   Cancellation_token() = default;
+   /// token with deadline now + budget
+   explicit Cancellation_token(Clock::duration budget)
+      : with_deadline(true), deadline(Clock::now() + budget) {}
+   /// token with the given deadline
+   explicit Cancellation_token(Clock::time_point deadline_)
+      : with_deadline(true), deadline(deadline_) {}
+   Cancellation_token(const Cancellation_token&) = delete;
+   Cancellation_token(Cancellation_token&&) = delete;
+   ~Cancellation_token() = default;
+   Cancellation_token& operator=(const Cancellation_token&) = delete;
+   Cancellation_token& operator=(Cancellation_token&&) = delete;
+
+   /// cancels the calculation
+   void cancel() noexcept { cancelled.store(true, std::memory_order_relaxed); }
+   /// returns true if the token has been cancelled or the deadline has passed
+   bool is_cancelled() const noexcept {
+      return cancelled.load(std::memory_order_relaxed)
+         || (with_deadline && Clock::now() >= deadline);
+   }
+   /// returns true if the token has a deadline
+   bool has_deadline() const noexcept { return with_deadline; }
+   /// returns the deadline
+   Clock::time_point get_deadline() const noexcept { return deadline; }
+
+private:
+   std::atomic<bool> cancelled{false}; ///< cancelled explicitly
+   bool with_deadline{false};          ///< deadline is set
+   Clock::time_point deadline{};       ///< deadline
+};
+
+/// returns true if the token is set and has been cancelled
+inline bool is_cancelled(const Cancellation_token* token) noexcept
+{
+   return token != nullptr && token->is_cancelled();
+}
+
+} // namespace gm2calc
+
+#endif
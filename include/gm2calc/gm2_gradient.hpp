@@ -0,0 +1,53 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_GRADIENT_HPP
+#define GM2_GRADIENT_HPP
+
+#include <Eigen/Core>
+
+namespace gm2calc {
+
+class THDM;
+
+namespace thdm {
+
+/**
+ * @class Amu_gradient
+ * @brief a_mu and its gradient w.r.t. the THDM mass basis parameters
+ */
+struct Amu_gradient {
+   /// indices of the mass basis parameters in the gradient
+   enum Index : int {
+      mh, mH, mA, mHp, sin_beta_minus_alpha, lambda_6, lambda_7,
+      tan_beta, m122, zeta_u, zeta_d, zeta_l, NUMBER_OF_PARAMETERS
+   };
+
+   double amu{0.0}; ///< 1-loop + 2-loop contribution to a_mu
+   Eigen::Matrix<double,NUMBER_OF_PARAMETERS,1> gradient{
+      Eigen::Matrix<double,NUMBER_OF_PARAMETERS,1>::Zero()}; ///< d(a_mu)/d(parameter)
+};
+
+} // namespace thdm
+
+/// calculates amu(1-loop + 2-loop) and its gradient in the THDM
+thdm::Amu_gradient calculate_amu_gradient(const THDM&);
+
+} // namespace gm2calc
+
+#endif
@@ -0,0 +1,57 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_PROFILE_HPP
+#define GM2_PROFILE_HPP
+
+#include <iosfwd>
+#include <vector>
+
+namespace gm2calc {
+
+/**
+ * @class Profile_entry
+ * @brief call count and cumulative run time of a profiled contribution
+ */
+struct Profile_entry {
+   const char* name{""};     ///< name of the contribution function
+   unsigned long long calls{0}; ///< number of calls
+   double seconds{0.};       ///< cumulative run time in seconds
+};
+
+/// enables/disables profiling of the individual THDM contributions
+void enable_profiling(bool enable = true) noexcept;
+
+/// returns true if profiling is enabled
+bool is_profiling_enabled() noexcept;
+
+/// resets all call counters and timers
+void reset_profile() noexcept;
+
+/// returns the call counts and cumulative run times of all contributions
+std::vector<Profile_entry> get_profile();
+
+/// prints the profile in form of a table
+void print_profile_table(std::ostream&, const std::vector<Profile_entry>&);
+
+/// prints the profile in JSON format
+void print_profile_json(std::ostream&, const std::vector<Profile_entry>&);
+
+} // namespace gm2calc
+
+#endif
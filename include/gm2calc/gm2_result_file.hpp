@@ -0,0 +1,232 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_RESULT_FILE_HPP
+#define GM2_RESULT_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/**
+ * @file gm2_result_file.hpp
+ * @brief columnar binary file format for the results of large scans
+ *
+ * A result file consists of a header, which describes the columns,
+ * followed by a sequence of chunks.  Each chunk contains a number of
+ * rows, stored column by column:
+ *
+ * @code
+ * header: char[8]  magic "GM2CRSLT"
+ *         uint64   format version
+ *         uint64   number of columns
+ *         columns: char[48] name (zero-padded), uint64 type
+ * chunk:  uint64   number of rows n
+ *         n values of column 0, n values of column 1, ...
+ * @endcode
+ *
+ * All values are 8 bytes wide and stored in the native byte order,
+ * so every column of a chunk is aligned and can be accessed in place
+ * when the file is memory mapped.  A Python reader is provided in
+ * gm2_result_file.py.
+ */
+
+namespace gm2calc {
+
+class MSSMNoFV_onshell;
+class THDM;
+
+/**
+ * @class Result_column
+ * @brief name and type of a column of a result file
+ */
+struct Result_column {
+   enum Type : std::uint64_t { Float64 = 0, UInt64 = 1 };
+   static constexpr std::size_t max_name_length = 47;
+
+   std::string name; ///< column name (at most max_name_length characters)
+   Type type{Float64}; ///< column type
+};
+
+/// bits of the "problems" column
+enum Result_problem : std::uint64_t {
+   Result_problem_error = 1,   ///< calculation failed (results are NaN)
+   Result_problem_tachyon = 2, ///< tachyonic particle
+};
+
+/// bits of the "warnings" column
+enum Result_warning : std::uint64_t {
+   Result_warning_no_convergence_Mu_MassB_MassWB = 1, ///< no convergence of Mu, MassB, MassWB
+   Result_warning_no_convergence_me2 = 2,             ///< no convergence of me2
+   Result_warning_conversion_cancelled = 4,           ///< on-shell conversion cancelled
+};
+
+/**
+ * @class Result_value
+ * @brief value of a column in a row (a double or an unsigned integer)
+ */
+class Result_value {
+public:
+   Result_value() = default;
+   Result_value(double);
+   Result_value(std::uint64_t);
+
+   Result_column::Type get_type() const { return type; }
+   std::uint64_t get_bits() const { return bits; }
+
+private:
+   std::uint64_t bits{0};
+   Result_column::Type type{Result_column::Float64};
+};
+
+/**
+ * @class Result_file_writer
+ * @brief writes rows to a result file
+ *
+ * The rows are collected column by column in a buffer and are
+ * written as one chunk when the buffer is full, when flush() is
+ * called or when the writer is destroyed.
+ *
+ * Example:
+ * @code
+ * Result_file_writer writer("scan.bin", get_mssmnofv_result_columns());
+ *
+ * for (...) {
+ *    MSSMNoFV_onshell model;
+ *    ...
+ *    write_result(writer, model);
+ * }
+ * @endcode
+ */
+class Result_file_writer {
+public:
+   Result_file_writer(const std::string&, const std::vector<Result_column>&,
+                      std::size_t rows_per_chunk = 16384);
+   Result_file_writer(const Result_file_writer&) = delete;
+   Result_file_writer(Result_file_writer&&) = delete;
+   ~Result_file_writer() noexcept;
+   Result_file_writer& operator=(const Result_file_writer&) = delete;
+   Result_file_writer& operator=(Result_file_writer&&) = delete;
+
+   /// columns of the file
+   const std::vector<Result_column>& get_columns() const { return columns; }
+   /// number of rows written so far (including buffered rows)
+   std::size_t get_number_of_rows() const { return rows_written + rows_buffered; }
+
+   /// appends a row (one value per column)
+   void write_row(const Result_value*, std::size_t);
+   /// appends a row (one value per column)
+   void write_row(std::initializer_list<Result_value>);
+   /// appends a row (one value per column)
+   void write_row(const std::vector<Result_value>&);
+   /// appends a row with NaN results and the error flag set
+   void write_error_row();
+   /// writes the buffered rows to the file
+   void flush();
+
+private:
+   std::string file_name;               ///< file name
+   std::ofstream ostr;                  ///< output file
+   std::vector<Result_column> columns;  ///< columns
+   std::vector<std::uint64_t> buffer;   ///< buffered rows, column-major
+   std::size_t rows_per_chunk{0};       ///< capacity of the buffer (in rows)
+   std::size_t rows_buffered{0};        ///< number of buffered rows
+   std::size_t rows_written{0};         ///< number of rows written to the file
+};
+
+/**
+ * @class Result_file_reader
+ * @brief reads a result file
+ *
+ * The file is memory mapped (if supported by the platform), so the
+ * columns of each chunk can be accessed without copying.
+ */
+class Result_file_reader {
+public:
+   explicit Result_file_reader(const std::string&);
+   Result_file_reader(const Result_file_reader&) = delete;
+   Result_file_reader(Result_file_reader&&) = delete;
+   ~Result_file_reader();
+   Result_file_reader& operator=(const Result_file_reader&) = delete;
+   Result_file_reader& operator=(Result_file_reader&&) = delete;
+
+   /// columns of the file
+   const std::vector<Result_column>& get_columns() const { return columns; }
+   /// index of the column with the given name
+   std::size_t get_column_index(const std::string&) const;
+   /// total number of rows
+   std::size_t get_number_of_rows() const { return number_of_rows; }
+   /// number of chunks
+   std::size_t get_number_of_chunks() const { return chunks.size(); }
+   /// number of rows in the given chunk
+   std::size_t get_chunk_rows(std::size_t chunk) const { return chunks.at(chunk).rows; }
+
+   /// values of a Float64 column in the given chunk
+   const double* get_float64_data(std::size_t chunk, std::size_t column) const;
+   /// values of a UInt64 column in the given chunk
+   const std::uint64_t* get_uint64_data(std::size_t chunk, std::size_t column) const;
+
+   /// all values of a Float64 column
+   std::vector<double> read_float64_column(std::size_t) const;
+   /// all values of a UInt64 column
+   std::vector<std::uint64_t> read_uint64_column(std::size_t) const;
+
+private:
+   struct Chunk {
+      std::size_t offset{0}; ///< position of the first value
+      std::size_t rows{0};   ///< number of rows
+   };
+
+   std::string file_name;              ///< file name
+   const char* data{nullptr};          ///< file content
+   std::size_t size{0};                ///< file size
+   std::vector<char> content;          ///< file content (if not memory mapped)
+   bool mapped{false};                 ///< file is memory mapped
+   std::vector<Result_column> columns; ///< columns
+   std::vector<Chunk> chunks;          ///< chunks
+   std::size_t number_of_rows{0};      ///< total number of rows
+
+   void map_file();
+   void read_header_and_chunks();
+   const char* get_column_data(std::size_t, std::size_t, Result_column::Type) const;
+};
+
+/// columns written by write_result() for the MSSMNoFV
+std::vector<Result_column> get_mssmnofv_result_columns();
+
+/// columns written by write_result() for the THDM
+std::vector<Result_column> get_thdm_result_columns();
+
+/// calculates the contributions to amu and returns them as a row
+std::vector<Result_value> make_result_row(const MSSMNoFV_onshell&);
+
+/// calculates the contributions to amu and returns them as a row
+std::vector<Result_value> make_result_row(const THDM&);
+
+/// calculates the contributions to amu and appends them as a row
+void write_result(Result_file_writer&, const MSSMNoFV_onshell&);
+
+/// calculates the contributions to amu and appends them as a row
+void write_result(Result_file_writer&, const THDM&);
+
+} // namespace gm2calc
+
+#endif
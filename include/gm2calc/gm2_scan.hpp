@@ -0,0 +1,194 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_SCAN_HPP
+#define GM2_SCAN_HPP
+
+#include "gm2calc/gm2_cancellation.hpp"
+#include "gm2calc/gm2_sequence.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file gm2_scan.hpp
+ * @brief scans of a_mu over a 2-dimensional parameter plane
+ *
+ * The adaptive scan starts from a coarse uniform grid of cells and
+ * splits a cell into four (quadtree) only where a_mu varies strongly,
+ * where the band a_mu +- uncertainty crosses one of the target values
+ * or where the problem flags change between the corners of the cell.
+ * Away from these regions a_mu is interpolated bilinearly from the
+ * corners of the cell.  The points of each refinement level are
+ * evaluated in parallel.
+ *
+ * The contour tracer follows the line a_mu = target through the
+ * parameter plane with predictor-corrector steps, which requires a
+ * number of evaluations proportional to the length of the contour.
+ *
+ * Scans of more than 2 parameters evaluate a_mu at the points of a
+ * (quasi-)random sequence, see gm2_sequence.hpp.
+ *
+ * All scans accept an optional Cancellation_token, which is checked
+ * before the evaluation of each point.  A cancelled scan returns the
+ * points evaluated so far.
+ */
+
+namespace gm2calc {
+
+/**
+ * @class Scan_value
+ * @brief result of the evaluation of a point of a scan
+ */
+struct Scan_value {
+   /// flag set if the evaluation of the point has thrown an exception
+   static constexpr std::uint32_t evaluation_error = 1u << 31;
+   /// flag set if the point has not been evaluated, because the scan has been cancelled
+   static constexpr std::uint32_t cancelled = 1u << 30;
+
+   double amu{0.0};        ///< a_mu
+   double damu{0.0};       ///< uncertainty of a_mu
+   std::uint32_t flags{0}; ///< problem flags (0 = no problem)
+};
+
+/**
+ * @class Scan_point
+ * @brief parameter point of a scan and its value
+ */
+struct Scan_point {
+   double x{0.0};     ///< 1st parameter
+   double y{0.0};     ///< 2nd parameter
+   Scan_value value;  ///< a_mu, its uncertainty and problem flags
+};
+
+/// function which evaluates a_mu at a parameter point (x,y)
+using Scan_function = std::function<Scan_value(double, double)>;
+
+/**
+ * @class Adaptive_scan_options
+ * @brief options of the adaptive 2-dimensional scan
+ *
+ * The initial grid has 2^min_level x 2^min_level cells.  The finest
+ * cells correspond to a uniform grid of (2^max_level + 1)^2 points.
+ * A cell is refined if
+ *
+ * - max(amu) - min(amu) > max_variation on its corners,
+ * - min(amu - damu) <= target <= max(amu + damu) on its corners for
+ *   one of the targets, or
+ * - the problem flags differ between its corners.
+ */
+struct Adaptive_scan_options {
+   double x_min{0.0};   ///< lower bound of the 1st parameter
+   double x_max{1.0};   ///< upper bound of the 1st parameter
+   double y_min{0.0};   ///< lower bound of the 2nd parameter
+   double y_max{1.0};   ///< upper bound of the 2nd parameter
+   unsigned min_level{2}; ///< refinement level of the initial grid
+   unsigned max_level{6}; ///< maximum refinement level (at most 24)
+   double max_variation{std::numeric_limits<double>::infinity()}; ///< maximum variation of amu within a cell
+   std::vector<double> targets{}; ///< values of amu, whose crossing is resolved
+   unsigned threads{0};   ///< number of threads (0 = number of hardware threads)
+   const Cancellation_token* cancellation{nullptr}; ///< optional cancellation token
+};
+
+/**
+ * @class Adaptive_scan_result
+ * @brief evaluated points and cells of an adaptive 2-dimensional scan
+ */
+class Adaptive_scan_result {
+public:
+   /// returns the evaluated points in the order of their evaluation
+   const std::vector<Scan_point>& get_points() const { return points; }
+   /// returns the number of evaluations
+   std::size_t get_number_of_evaluations() const { return points.size(); }
+   /// returns the number of cells, which have not been refined
+   std::size_t get_number_of_cells() const;
+   /// returns the interpolated value at the point (x,y)
+   Scan_value interpolate(double x, double y) const;
+   /// returns true if the scan has been cancelled before reaching the refinement goal
+   bool is_cancelled() const { return cancelled; }
+
+private:
+   Adaptive_scan_options options{};  ///< options
+   bool cancelled{false};             ///< scan has been cancelled
+   std::vector<Scan_point> points{};  ///< evaluated points
+   std::unordered_map<std::uint64_t, std::size_t> index{}; ///< node -> position in points
+   std::unordered_set<std::uint64_t> refined{}; ///< refined cells
+
+   friend Adaptive_scan_result scan_adaptive(const Scan_function&, const Adaptive_scan_options&);
+};
+
+/// performs an adaptive 2-dimensional scan
+Adaptive_scan_result scan_adaptive(const Scan_function&, const Adaptive_scan_options&);
+
+/**
+ * @class Contour_options
+ * @brief options of the contour tracer
+ *
+ * The steps are given in units of the size of the parameter region.
+ * A point is on the contour if |amu - target| <= rel_tolerance*|target|
+ * + abs_tolerance.
+ */
+struct Contour_options {
+   double x_min{0.0};   ///< lower bound of the 1st parameter
+   double x_max{1.0};   ///< upper bound of the 1st parameter
+   double y_min{0.0};   ///< lower bound of the 2nd parameter
+   double y_max{1.0};   ///< upper bound of the 2nd parameter
+   double step{0.01};      ///< initial step size
+   double min_step{1e-5};  ///< minimum step size
+   double max_step{0.05};  ///< maximum step size
+   double rel_tolerance{1e-6}; ///< relative tolerance of a_mu
+   double abs_tolerance{0.0};  ///< absolute tolerance of a_mu
+   unsigned max_corrector_iterations{6}; ///< maximum number of corrector steps per point
+   std::size_t max_points{10000}; ///< maximum number of points on the contour
+   const Cancellation_token* cancellation{nullptr}; ///< optional cancellation token
+};
+
+/**
+ * @class Contour
+ * @brief points of a traced contour
+ */
+struct Contour {
+   std::vector<Scan_point> points{}; ///< points along the contour
+   bool closed{false};   ///< contour is a closed curve
+   bool complete{false}; ///< contour has been traced from boundary to boundary or is closed
+   bool cancelled{false}; ///< tracing has been cancelled
+   std::size_t number_of_evaluations{0}; ///< number of function evaluations
+};
+
+/// traces the contour a_mu = target, starting from a bracket [(x0,y0), (x1,y1)]
+Contour trace_contour(const Scan_function&, double target,
+                      double x0, double y0, double x1, double y1,
+                      const Contour_options&);
+
+/// function which evaluates a_mu at a parameter point x[0], ..., x[d-1]
+using Scan_sequence_function = std::function<Scan_value(const double*)>;
+
+/// evaluates a_mu at the points first, ..., first + count - 1 of the sequence in parallel
+std::vector<Scan_value> scan_sequence(const Scan_sequence_function&, const Scan_sequence&,
+                                      std::uint64_t first, std::uint64_t count,
+                                      unsigned threads = 0,
+                                      const Cancellation_token* token = nullptr);
+
+} // namespace gm2calc
+
+#endif
@@ -0,0 +1,115 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_SEQUENCE_HPP
+#define GM2_SEQUENCE_HPP
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file gm2_sequence.hpp
+ * @brief deterministic sequences of parameter points for scans
+ *
+ * The i-th point of a sequence is a function of the index i (and the
+ * seed) only.  Therefore, any range of points can be generated by any
+ * thread in any order, and a parallel scan yields the same points
+ * independent of the number of threads.
+ *
+ * Example:
+ * @code
+ * const Scan_sequence sequence(Scan_sequence::Type::sobol,
+ *                              {{20, 100}, {10, 100}}, 1024);
+ * double x[2];
+ * for (std::uint64_t i = 0; i < sequence.size(); i++) {
+ *    sequence.get_point(i, x);
+ *    ...
+ * }
+ * @endcode
+ */
+
+namespace gm2calc {
+
+/**
+ * @class Scan_range
+ * @brief range of a parameter of a scan
+ */
+struct Scan_range {
+   double min{0.0}; ///< lower bound
+   double max{1.0}; ///< upper bound
+};
+
+/**
+ * @class Scan_sequence
+ * @brief sequence of points in a box of parameters
+ *
+ * The following sequences are available:
+ *
+ * - uniform: independent uniformly distributed random points from a
+ *   counter-based random number generator, i.e. the random numbers
+ *   of point i are a hash of (seed, i)
+ * - halton: Halton sequence with the first prime numbers as bases
+ * - sobol: Sobol sequence (Gray code order) with the direction
+ *   numbers of S. Joe and F. Y. Kuo, SIAM J. Sci. Comput. 30 (2008)
+ *   2635
+ * - latin_hypercube: each parameter range is split into `size'
+ *   intervals of equal width and each interval contains exactly one
+ *   point, with a random position within the interval
+ *
+ * If the seed is non-zero, the Halton and Sobol points are shifted
+ * randomly modulo 1 (Cranley-Patterson rotation), which preserves the
+ * uniformity of the sequence.
+ */
+class Scan_sequence {
+public:
+   enum class Type { uniform, halton, sobol, latin_hypercube };
+
+   /// maximum number of parameters
+   static constexpr unsigned max_dimension = 16;
+
+   Scan_sequence(Type, const std::vector<Scan_range>&, std::uint64_t size, std::uint64_t seed = 0);
+
+   /// type of the sequence
+   Type get_type() const { return type; }
+   /// number of parameters
+   unsigned get_dimension() const { return static_cast<unsigned>(ranges.size()); }
+   /// number of points
+   std::uint64_t size() const { return n; }
+   /// seed
+   std::uint64_t get_seed() const { return seed; }
+
+   /// returns the i-th point
+   void get_point(std::uint64_t i, double* x) const;
+   /// returns the i-th point
+   std::vector<double> get_point(std::uint64_t i) const;
+
+private:
+   Type type{Type::uniform};
+   std::vector<Scan_range> ranges;        ///< parameter ranges
+   std::uint64_t n{0};                    ///< number of points
+   std::uint64_t seed{0};                 ///< seed
+   std::vector<double> shifts;            ///< random shifts (Halton, Sobol)
+   std::vector<std::uint32_t> directions; ///< direction numbers (Sobol)
+   std::vector<std::uint32_t> strata;     ///< interval of each point (Latin hypercube)
+
+   double get_unit_coordinate(std::uint64_t, unsigned) const;
+};
+
+} // namespace gm2calc
+
+#endif
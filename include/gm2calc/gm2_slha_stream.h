@@ -0,0 +1,85 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_SLHA_STREAM_H
+#define GM2_SLHA_STREAM_H
+
+#include "gm2calc/gm2_error.h"
+#include "gm2calc/MSSMNoFV_onshell.h"
+#include "gm2calc/SM.h"
+#include "gm2calc/THDM.h"
+
+/**
+ * @file gm2_slha_stream.h
+ * @brief contains declarations of C interface functions for reading
+ * a sequence of SLHA documents
+ *
+ * A stream is opened with gm2calc_slha_stream_open() and the
+ * documents are read one at a time with gm2calc_slha_stream_next().
+ * The parameters of the current document can then be read with the
+ * gm2calc_slha_stream_fill_*() functions.
+ *
+ * Example:
+ * @code
+ * int status;
+ * while ((status = gm2calc_slha_stream_next(stream)) != 0) {
+ *    if (status < 0) {
+ *       ... malformed document, continue with the next one ...
+ *       continue;
+ *    }
+ *    ... read the parameters of the current document ...
+ * }
+ * @endcode
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct gm2calc_slha_stream;
+typedef struct gm2calc_slha_stream gm2calc_slha_stream;
+
+/** open a stream of SLHA documents (file name or - for stdin) */
+gm2calc_error gm2calc_slha_stream_open(gm2calc_slha_stream**, const char* source, const char* separator);
+
+/** delete a stream of SLHA documents */
+void gm2calc_slha_stream_free(gm2calc_slha_stream*);
+
+/** read the next document, returns 1 on success, 0 at the end of the stream, -1 on error */
+int gm2calc_slha_stream_next(gm2calc_slha_stream*);
+
+/** read MSSMNoFV parameters in SLHA format from the current document */
+gm2calc_error gm2calc_slha_stream_fill_mssmnofv_slha(const gm2calc_slha_stream*, MSSMNoFV_onshell*);
+
+/** read MSSMNoFV parameters in GM2Calc format from the current document */
+gm2calc_error gm2calc_slha_stream_fill_mssmnofv_gm2calc(const gm2calc_slha_stream*, MSSMNoFV_onshell*);
+
+/** read SM parameters from the current document */
+gm2calc_error gm2calc_slha_stream_fill_sm(const gm2calc_slha_stream*, gm2calc_SM*);
+
+/** read THDM gauge basis parameters from the current document */
+gm2calc_error gm2calc_slha_stream_fill_thdm_gauge_basis(const gm2calc_slha_stream*, gm2calc_THDM_gauge_basis*);
+
+/** read THDM mass basis parameters from the current document */
+gm2calc_error gm2calc_slha_stream_fill_thdm_mass_basis(const gm2calc_slha_stream*, gm2calc_THDM_mass_basis*);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_SM_UNCERTAINTY_HPP
+#define GM2_SM_UNCERTAINTY_HPP
+
+#include "gm2calc/gm2_sequence.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace gm2calc {
+
+namespace thdm {
+
+/**
+ * @class SM_uncertainty_options
+ * @brief options for the propagation of the uncertainties of the SM
+ * input parameters to a_mu
+ *
+ * The SM input parameters are sampled from independent normal
+ * distributions with the central values of the given SM object and
+ * the given standard deviations.  A standard deviation of zero keeps
+ * the parameter fixed.
+ */
+struct SM_uncertainty_options {
+   double delta_alpha_s_mz{0.0007}; ///< standard deviation of alpha_s(MZ)
+   double delta_mt{0.76};           ///< standard deviation of the top quark pole mass
+   double delta_mbmb{0.03};         ///< standard deviation of the bottom quark mass mb(mb)
+   double delta_mw{0.015};          ///< standard deviation of the W boson pole mass
+   std::uint64_t samples{1000};     ///< number of samples
+   std::uint64_t seed{1};           ///< seed of the random numbers
+   Scan_sequence::Type sequence{Scan_sequence::Type::uniform}; ///< sequence of the samples
+   std::vector<double> probabilities{0.025, 0.16, 0.5, 0.84, 0.975}; ///< probabilities of the quantiles
+   unsigned threads{0};             ///< number of threads (0 = number of hardware threads)
+};
+
+/**
+ * @class SM_uncertainty_result
+ * @brief distribution of a_mu(1-loop + 2-loop) induced by the
+ * uncertainties of the SM input parameters
+ */
+struct SM_uncertainty_result {
+   double mean{0.0};                ///< mean of a_mu
+   double stddev{0.0};              ///< standard deviation of a_mu
+   std::vector<double> quantiles{}; ///< quantiles of a_mu for the given probabilities
+   std::uint64_t samples{0};        ///< number of successfully evaluated samples
+   std::uint64_t failed{0};         ///< number of samples, where the evaluation has failed
+};
+
+} // namespace thdm
+
+/// propagates the uncertainties of the SM input parameters to amu(1-loop + 2-loop) in the THDM
+thdm::SM_uncertainty_result calculate_sm_uncertainty_amu(
+   const thdm::Mass_basis&, const SM&, const thdm::SM_uncertainty_options&,
+   const thdm::Config& config = thdm::Config{});
+
+} // namespace gm2calc
+
+#endif
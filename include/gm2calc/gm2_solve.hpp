@@ -0,0 +1,109 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_SOLVE_HPP
+#define GM2_SOLVE_HPP
+
+#include "gm2calc/SM.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <functional>
+
+/**
+ * @file gm2_solve.hpp
+ * @brief determination of the value of a model parameter, for which
+ * a_mu takes a given target value
+ *
+ * The parameter is determined with a bracketing root finder
+ * (TOMS 748), where each step is a full evaluation of a_mu.  The
+ * bracket must enclose a sign change of a_mu - target.
+ *
+ * Example: tan(beta) with a_mu = 2.5e-9 in the type X THDM
+ * @code
+ * thdm::Mass_basis basis = ...;
+ * const auto result = solve_for_parameter(
+ *    basis, [] (thdm::Mass_basis& b, double tb) { b.tan_beta = tb; },
+ *    2.5e-9, 10, 100, Solve_options{});
+ * if (result.converged) {
+ *    std::cout << "tan(beta) = " << result.value << '\n';
+ * }
+ * @endcode
+ */
+
+namespace gm2calc {
+
+class MSSMNoFV_onshell;
+
+/**
+ * @class Solve_options
+ * @brief options of the root finder
+ *
+ * The iteration stops when the bracket of the parameter is smaller
+ * than abs_tolerance + rel_tolerance*|x|.
+ */
+struct Solve_options {
+   double rel_tolerance{1e-8};    ///< relative tolerance of the parameter
+   double abs_tolerance{0.0};     ///< absolute tolerance of the parameter
+   unsigned max_iterations{100};  ///< maximum number of iterations
+   bool convert_to_onshell{false}; ///< MSSMNoFV: convert the DR-bar input parameters to the on-shell scheme
+   double onshell_precision{1e-8}; ///< MSSMNoFV: precision goal of the on-shell conversion
+};
+
+/**
+ * @class Solve_result
+ * @brief result of the root finder
+ */
+struct Solve_result {
+   double value{0.0};         ///< parameter value
+   double amu{0.0};           ///< a_mu at the parameter value
+   double lower{0.0};         ///< lower end of the final bracket
+   double upper{0.0};         ///< upper end of the final bracket
+   unsigned iterations{0};    ///< number of iterations
+   unsigned evaluations{0};   ///< number of evaluations of a_mu
+   double seconds{0.0};       ///< wall-clock time
+   bool converged{false};     ///< whether the tolerance has been reached
+};
+
+/// a_mu as a function of a parameter
+using Solve_function = std::function<double(double)>;
+
+/// setter of a THDM parameter
+using THDM_setter = std::function<void(thdm::Mass_basis&, double)>;
+
+/// setter of a MSSMNoFV parameter
+using MSSMNoFV_setter = std::function<void(MSSMNoFV_onshell&, double)>;
+
+/// finds x in [x_min, x_max] with amu(x) = target
+Solve_result solve_for_parameter(const Solve_function& amu, double target,
+                                 double x_min, double x_max,
+                                 const Solve_options&);
+
+/// finds the THDM parameter value in [x_min, x_max] with a_mu(1-loop + 2-loop) = target
+Solve_result solve_for_parameter(const thdm::Mass_basis&, const THDM_setter&,
+                                 double target, double x_min, double x_max,
+                                 const Solve_options&, const SM& sm = SM{},
+                                 const thdm::Config& config = thdm::Config{});
+
+/// finds the MSSMNoFV parameter value in [x_min, x_max] with a_mu(1-loop + 2-loop) = target
+Solve_result solve_for_parameter(const MSSMNoFV_onshell&, const MSSMNoFV_setter&,
+                                 double target, double x_min, double x_max,
+                                 const Solve_options&);
+
+} // namespace gm2calc
+
+#endif
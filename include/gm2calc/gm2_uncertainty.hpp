@@ -22,6 +22,7 @@
 namespace gm2calc {
 
 class MSSMNoFV_onshell;
+struct MSSMNoFV_amu_parameters;
 class THDM;
 
 /// calculates uncertainty for amu(0-loop)
@@ -35,12 +36,15 @@ double calculate_uncertainty_amu_2loop(const THDM&);
 
 /// calculates uncertainty for amu(0-loop) w/ tan(beta) resummation
 double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell&);
+double calculate_uncertainty_amu_0loop(const MSSMNoFV_amu_parameters&);
 
 /// calculates uncertainty for amu(1-loop) w/ tan(beta) resummation
 double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell&);
+double calculate_uncertainty_amu_1loop(const MSSMNoFV_amu_parameters&);
 
 /// calculates uncertainty for amu(2-loop)
 double calculate_uncertainty_amu_2loop(const MSSMNoFV_onshell&);
+double calculate_uncertainty_amu_2loop(const MSSMNoFV_amu_parameters&);
 
 } // namespace gm2calc
 
@@ -0,0 +1,89 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/MSSMNoFV_amu_parameters.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+
+#include "MSSMNoFV/gm2_amu_parameters_helpers.hpp"
+
+namespace gm2calc {
+
+/**
+ * Copies all parameters of the given model which enter the 1- and
+ * 2-loop contributions to a_mu into a MSSMNoFV_amu_parameters
+ * object.  The model should have been converted to the on-shell
+ * scheme before, see MSSMNoFV_onshell::calculate_masses() and
+ * MSSMNoFV_onshell::convert_to_onshell().
+ *
+ * @param model model parameters
+ *
+ * @return snapshot of the parameters
+ */
+MSSMNoFV_amu_parameters make_amu_parameters(const MSSMNoFV_onshell& model)
+{
+   MSSMNoFV_amu_parameters pars;
+
+   pars.MM = model.get_MM();
+   pars.MW = model.get_MW();
+   pars.MZ = model.get_MZ();
+   pars.MT = model.get_MT();
+   pars.EL = model.get_EL();
+   pars.EL0 = model.get_EL0();
+   pars.gY = model.get_gY();
+   pars.g2 = model.get_g2();
+   pars.g3 = model.get_g3();
+   from_eigen(model.get_Ye().diagonal(), pars.Ye);
+   from_eigen(model.get_Yu().diagonal(), pars.Yu);
+   from_eigen(model.get_Yd().diagonal(), pars.Yd);
+
+   pars.scale = model.get_scale();
+   pars.TB = model.get_TB();
+   pars.Mu = model.get_Mu();
+   pars.MassB = model.get_MassB();
+   pars.MassWB = model.get_MassWB();
+   pars.MassG = model.get_MassG();
+   pars.MA0 = model.get_MA0();
+   from_eigen(model.get_Ae().diagonal(), pars.Ae);
+   from_eigen(model.get_Au().diagonal(), pars.Au);
+   from_eigen(model.get_Ad().diagonal(), pars.Ad);
+   from_eigen(model.get_ml2().diagonal(), pars.ml2);
+   from_eigen(model.get_me2().diagonal(), pars.me2);
+   from_eigen(model.get_mq2().diagonal(), pars.mq2);
+   from_eigen(model.get_mu2().diagonal(), pars.mu2);
+   from_eigen(model.get_md2().diagonal(), pars.md2);
+
+   pars.MSvmL = model.get_MSvmL();
+   from_eigen(model.get_MSm(), pars.MSm);
+   from_eigen(model.get_USm(), pars.USm);
+   from_eigen(model.get_MSt(), pars.MSt);
+   from_eigen(model.get_USt(), pars.USt);
+   from_eigen(model.get_MSb(), pars.MSb);
+   from_eigen(model.get_USb(), pars.USb);
+   from_eigen(model.get_MStau(), pars.MStau);
+   from_eigen(model.get_UStau(), pars.UStau);
+   from_eigen(model.get_Mhh(), pars.Mhh);
+   from_eigen(model.get_MChi(), pars.MChi);
+   from_eigen(model.get_ZN(), pars.ZN);
+   from_eigen(model.get_MCha(), pars.MCha);
+   from_eigen(model.get_UM(), pars.UM);
+   from_eigen(model.get_UP(), pars.UP);
+
+   return pars;
+}
+
+} // namespace gm2calc
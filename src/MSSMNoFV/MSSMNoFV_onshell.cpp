@@ -17,6 +17,7 @@
 // ====================================================================
 
 #include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/gm2_cancellation.hpp"
 #include "gm2calc/gm2_error.hpp"
 
 #include "MSSMNoFV/gm2_1loop_helpers.hpp"
@@ -25,6 +26,7 @@
 #include "gm2_log.hpp"
 #include "gm2_mf.hpp"
 #include "gm2_numerics.hpp"
+#include "gm2_raii.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -33,6 +35,9 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <utility>
+
+#include <Eigen/LU>
 
 #include <boost/math/tools/roots.hpp>
 
@@ -158,6 +163,51 @@ void MSSMNoFV_onshell::set_TB(double tanb)
    set_vu(vev * sinb);
 }
 
+/**
+ * Resets all parameters to the values of a default-constructed model
+ * and clears all problems and warnings.  Memory allocated by the
+ * model is kept, so that the model can be re-used in a scan without
+ * heap allocations.
+ */
+void MSSMNoFV_onshell::reset()
+{
+   // a default-constructed model has no problems, so the move
+   // assignment does not allocate
+   auto problems = std::move(get_problems());
+   *this = MSSMNoFV_onshell();
+   get_problems() = std::move(problems);
+   get_problems().clear();
+}
+
+/**
+ * Copies the input parameters (SUSY and soft-breaking parameters,
+ * pole masses and settings) from the given model and clears all
+ * problems and warnings.  The problems of the given model are not
+ * copied and the memory allocated by the problems object of this
+ * model is kept.  The DR-bar masses and mixings are not copied, they
+ * must be re-calculated by calling calculate_masses() or
+ * convert_to_onshell().
+ *
+ * @param other model to copy the input parameters from
+ */
+void MSSMNoFV_onshell::assign_inputs(const MSSMNoFV_onshell& other)
+{
+   if (this != &other) {
+      MSSMNoFV_onshell_soft_parameters::operator=(other);
+      set_physical(other.get_physical());
+      do_force_output(other.do_force_output());
+      verbose_output = other.verbose_output;
+      EL = other.EL;
+      EL0 = other.EL0;
+      mb_DRbar_MZ = other.mb_DRbar_MZ;
+      Au = other.Au;
+      Ad = other.Ad;
+      Ae = other.Ae;
+   }
+
+   get_problems().clear();
+}
+
 double MSSMNoFV_onshell::get_vev() const
 {
    const double cW = get_MW() / get_MZ();
@@ -187,12 +237,23 @@ double MSSMNoFV_onshell::get_TB() const
  * This function is intended to be used with input parameters in the
  * (SLHA-compatible) DR-bar scheme.
  *
+ * If a cancellation token is given, it is checked in every
+ * iteration.  When the token has been cancelled (or its deadline has
+ * passed), the iterations stop with the parameters reached so far.
+ * In this case the conversion is flagged as cancelled and the
+ * achieved precision is stored in the convergence warnings, see
+ * MSSMNoFV_onshell_problems.
+ *
  * @param precision accuracy goal for the conversion
  * @param max_iterations maximum number of iterations
+ * @param token optional cancellation token (may be nullptr)
  */
 void MSSMNoFV_onshell::convert_to_onshell(
-   double precision, unsigned max_iterations)
+   double precision, unsigned max_iterations, const Cancellation_token* token)
 {
+   const auto save = make_raii_save(cancellation_token);
+   cancellation_token = token;
+
    check_input();
    calculate_DRbar_masses();
    copy_susy_masses_to_pole();
@@ -210,6 +271,14 @@ void MSSMNoFV_onshell::convert_to_onshell(
    convert_me2(precision, max_iterations);
    convert_yukawa_couplings();
 
+   if (is_cancelled() &&
+       (get_problems().no_Mu_MassB_MassWB_convergence() ||
+        get_problems().no_me2_convergence())) {
+      get_problems().flag_conversion_cancelled();
+   } else {
+      get_problems().unflag_conversion_cancelled();
+   }
+
    // final mass spectrum
    get_problems().clear_problems();
    calculate_DRbar_masses();
@@ -292,6 +361,12 @@ void MSSMNoFV_onshell::check_input() const
 #undef WARN_OR_THROW_IF_ZERO
 }
 
+/// returns true if the running conversion has been cancelled
+bool MSSMNoFV_onshell::is_cancelled() const
+{
+   return gm2calc::is_cancelled(cancellation_token);
+}
+
 void MSSMNoFV_onshell::check_problems() const
 {
    if (get_problems().have_problem()) {
@@ -477,6 +552,190 @@ unsigned MSSMNoFV_onshell::find_bino_like_neutralino()
    return detail::find_bino_like_neutralino(get_ZN());
 }
 
+/**
+ * Determines the Mu parameter and the soft-breaking Bino and Wino
+ * mass parameters from the two chargino pole masses and the most
+ * bino-like neutralino pole mass.  The function first uses a Newton
+ * iteration and falls back to a fixed-point iteration if the Newton
+ * iteration does not converge.
+ *
+ * @param precision_goal precision goal of iteration
+ * @param max_iterations maximum number of iterations
+ */
+void MSSMNoFV_onshell::convert_Mu_M1_M2(
+   double precision_goal,
+   unsigned max_iterations)
+{
+   double precision = convert_Mu_M1_M2_newton(precision_goal, max_iterations);
+
+   if (precision > precision_goal && !is_cancelled()) {
+      precision = convert_Mu_M1_M2_fpi(precision_goal, max_iterations);
+   }
+
+   calculate_DRbar_masses();
+
+   if (precision > precision_goal) {
+      get_problems().flag_no_convergence_Mu_MassB_MassWB(precision, max_iterations);
+   } else {
+      get_problems().unflag_no_convergence_Mu_MassB_MassWB();
+   }
+}
+
+/**
+ * Determines the Mu parameter and the soft-breaking Bino and Wino
+ * mass parameters from the two chargino pole masses and the most
+ * bino-like neutralino pole mass.  The function uses a Newton
+ * iteration, where the derivatives of the chargino and neutralino
+ * masses w.r.t. Mu, M1 and M2 are calculated analytically from the
+ * mixing matrices (Hellmann-Feynman theorem).
+ *
+ * @param precision_goal precision goal of iteration
+ * @param max_iterations maximum number of iterations
+ * @return achieved precision
+ */
+double MSSMNoFV_onshell::convert_Mu_M1_M2_newton_modify(
+   double precision_goal,
+   unsigned max_iterations)
+{
+   const auto bino_idx_pole = find_bino_like_neutralino();
+   auto bino_idx_DR = detail::find_bino_like_neutralino(get_ZN());
+   Eigen::Matrix<double,3,1> goal;
+   goal << get_physical().MCha(0), get_physical().MCha(1),
+      get_physical().MChi(bino_idx_pole);
+
+   if (verbose_output) {
+      VERBOSE("Converting Mu, M1, M2 to on-shell scheme with Newton iteration ...\n"
+              "   Goal: MCha = " << pretty_print(goal.head<2>().transpose())
+              << ", MChi(" << bino_idx_DR << ") = " << goal(2)
+              << ", accuracy goal = " << precision_goal);
+   }
+
+   auto calc_difference = [&goal, this] (unsigned idx) {
+      Eigen::Matrix<double,3,1> diff;
+      diff << goal(0) - get_MCha(0), goal(1) - get_MCha(1), goal(2) - get_MChi(idx);
+      return diff;
+   };
+
+   Eigen::Matrix<double,3,1> diff = calc_difference(bino_idx_DR);
+   double precision = diff.cwiseAbs().maxCoeff();
+   unsigned it = 0;
+
+   while (precision > precision_goal && it < max_iterations && !is_cancelled()) {
+      const auto U(get_UM()); // neg. chargino mixing matrix
+      const auto V(get_UP()); // pos. chargino mixing matrix
+      const auto N(get_ZN()); // neutralino mixing matrix
+      const auto b = bino_idx_DR;
+
+      // derivatives of (MCha(0), MCha(1), MChi(b)) w.r.t. (M1, M2, Mu)
+      Eigen::Matrix<double,3,3> J;
+      J << 0, std::real(U(0,0)*V(0,0)), std::real(U(0,1)*V(0,1)),
+           0, std::real(U(1,0)*V(1,0)), std::real(U(1,1)*V(1,1)),
+           std::real(N(b,0)*N(b,0)), std::real(N(b,1)*N(b,1)), -2*std::real(N(b,2)*N(b,3));
+
+      const Eigen::Matrix<double,3,1> step = J.fullPivLu().solve(diff);
+
+      if (!step.allFinite()) {
+         if (verbose_output) {
+            VERBOSE("   Singular Jacobian, stopping iteration ...");
+         }
+         break;
+      }
+
+      const double M1_old = get_MassB(), M2_old = get_MassWB(), Mu_old = get_Mu();
+
+      set_MassB(M1_old + step(0));
+      set_MassWB(M2_old + step(1));
+      set_Mu(Mu_old + step(2));
+
+      calculate_MChi();
+      calculate_MCha();
+
+      bino_idx_DR = detail::find_bino_like_neutralino(get_ZN());
+
+      const double old_precision = precision;
+      diff = calc_difference(bino_idx_DR);
+      precision = diff.cwiseAbs().maxCoeff();
+
+      if (!(precision < old_precision)) {
+         if (verbose_output) {
+            VERBOSE("   No improvement in last iteration step, stopping iteration ...");
+         }
+         // undo last step
+         set_MassB(M1_old);
+         set_MassWB(M2_old);
+         set_Mu(Mu_old);
+         calculate_MChi();
+         calculate_MCha();
+         precision = old_precision;
+         break;
+      }
+
+      if (verbose_output) {
+         VERBOSE("   Iteration " << it << ": Mu = " << get_Mu()
+                 << ", M1 = " << get_MassB()
+                 << ", M2 = " << get_MassWB()
+                 << ", MCha = " << pretty_print(get_MCha().transpose())
+                 << ", MChi(" << bino_idx_DR << ") = " << get_MChi(bino_idx_DR)
+                 << ", accuracy = " << precision << " GeV");
+      }
+
+      it++;
+   }
+
+   if (verbose_output) {
+      if (precision > precision_goal) {
+         VERBOSE(
+            "   DR-bar to on-shell conversion for Mu, M1 and M2 did"
+            " not converge with Newton iteration (reached absolute accuracy: "
+            << precision << " GeV, accuracy goal: " << precision_goal <<
+            ", max. iterations: " << max_iterations << ")");
+      }
+      VERBOSE("   Achieved absolute accuracy: " << precision << " GeV");
+   }
+
+   return precision;
+}
+
+/**
+ * Determines the Mu parameter and the soft-breaking Bino and Wino
+ * mass parameters with a Newton iteration, see
+ * convert_Mu_M1_M2_newton_modify().
+ *
+ * If a NaN appears during the iteration, the function resets Mu, M1
+ * and M2 to the initial values and returns the maximum double.
+ *
+ * @param precision_goal precision goal of iteration
+ * @param max_iterations maximum number of iterations
+ * @return achieved precision
+ */
+double MSSMNoFV_onshell::convert_Mu_M1_M2_newton(
+   double precision_goal,
+   unsigned max_iterations)
+{
+   const double M1_save = get_MassB();
+   const double M2_save = get_MassWB();
+   const double Mu_save = get_Mu();
+   const double precision = convert_Mu_M1_M2_newton_modify(precision_goal, max_iterations);
+
+   if (!std::isfinite(precision) ||
+       !std::isfinite(get_MassB()) ||
+       !std::isfinite(get_MassWB()) ||
+       !std::isfinite(get_Mu()) ||
+       !get_MChi().allFinite() ||
+       !get_MCha().allFinite()) {
+      // reset
+      set_MassB(M1_save);
+      set_MassWB(M2_save);
+      set_Mu(Mu_save);
+      calculate_MChi();
+      calculate_MCha();
+
+      return std::numeric_limits<double>::max();
+   }
+
+   return precision;
+}
+
 /**
  * Determines the Mu parameter and the soft-breaking Bino and Wino
  * mass parameters from the two chargino pole masses and the most
@@ -485,8 +744,9 @@ unsigned MSSMNoFV_onshell::find_bino_like_neutralino()
  *
  * @param precision_goal precision goal of iteration
  * @param max_iterations maximum number of iterations
+ * @return achieved precision
  */
-void MSSMNoFV_onshell::convert_Mu_M1_M2(
+double MSSMNoFV_onshell::convert_Mu_M1_M2_fpi(
    double precision_goal,
    unsigned max_iterations)
 {
@@ -497,7 +757,7 @@ void MSSMNoFV_onshell::convert_Mu_M1_M2(
    MChi_goal(bino_idx_DR) = get_physical().MChi(bino_idx_pole);
 
    if (verbose_output) {
-      VERBOSE("Converting Mu, M1, M2 to on-shell scheme ...\n"
+      VERBOSE("Converting Mu, M1, M2 to on-shell scheme with FPI ...\n"
               "   Goal: MCha = " << pretty_print(MCha_goal.transpose())
               << ", MChi(" << bino_idx_DR << ") = " << MChi_goal(bino_idx_DR)
               << ", accuracy goal = " << precision_goal);
@@ -511,7 +771,7 @@ void MSSMNoFV_onshell::convert_Mu_M1_M2(
    double precision = calc_precision(bino_idx_DR);
    unsigned it = 0;
 
-   while (precision > precision_goal && it < max_iterations) {
+   while (precision > precision_goal && it < max_iterations && !is_cancelled()) {
 
       const auto U(get_UM()); // neg. chargino mixing matrix
       const auto V(get_UP()); // pos. chargino mixing matrix
@@ -563,24 +823,18 @@ void MSSMNoFV_onshell::convert_Mu_M1_M2(
       it++;
    }
 
-   calculate_DRbar_masses();
-
-   if (precision > precision_goal) {
-      get_problems().flag_no_convergence_Mu_MassB_MassWB(precision, max_iterations);
-   } else {
-      get_problems().unflag_no_convergence_Mu_MassB_MassWB();
-   }
-
    if (verbose_output) {
       if (precision > precision_goal) {
          VERBOSE(
             "   DR-bar to on-shell conversion for Mu, M1 and M2 did"
-            " not converge (reached absolute accuracy: " << precision <<
+            " not converge with FPI (reached absolute accuracy: " << precision <<
             " GeV, accuracy goal: " << precision_goal <<
             ", max. iterations: " << max_iterations << ")");
       }
       VERBOSE("   Achieved absolute accuracy: " << precision << " GeV");
    }
+
+   return precision;
 }
 
 /**
@@ -618,7 +872,9 @@ void MSSMNoFV_onshell::convert_ml2()
 
 /**
  * Determines soft-breaking right-handed smuon mass parameter from one
- * smuon pole mass.
+ * smuon pole mass.  The function first uses a Newton iteration and
+ * falls back to a fixed-point iteration and a root finder if the
+ * Newton iteration does not converge.
  *
  * @param precision_goal precision goal of iteration
  * @param max_iterations maximum number of iterations
@@ -627,9 +883,13 @@ void MSSMNoFV_onshell::convert_me2(
    double precision_goal,
    unsigned max_iterations)
 {
-   double precision = convert_me2_fpi(precision_goal, max_iterations);
+   double precision = convert_me2_newton(precision_goal, max_iterations);
 
-   if (precision > precision_goal) {
+   if (precision > precision_goal && !is_cancelled()) {
+      precision = convert_me2_fpi(precision_goal, max_iterations);
+   }
+
+   if (precision > precision_goal && !is_cancelled()) {
       precision = convert_me2_root(precision_goal, max_iterations);
    }
 
@@ -640,6 +900,136 @@ void MSSMNoFV_onshell::convert_me2(
    }
 }
 
+/**
+ * Determines soft-breaking right-handed smuon mass parameter from one
+ * smuon pole mass.  The function uses a Newton iteration for the
+ * squared smuon mass, where the derivative w.r.t. mse2(2,2) is
+ * calculated analytically from the smuon mixing matrix
+ * (Hellmann-Feynman theorem).
+ *
+ * @param precision_goal precision goal of iteration
+ * @param max_iterations maximum number of iterations
+ * @return achieved precision
+ */
+double MSSMNoFV_onshell::convert_me2_newton_modify(
+   double precision_goal,
+   unsigned max_iterations)
+{
+   // sorted pole masses
+   Eigen::Array<double,2,1> MSm_pole_sorted(get_physical().MSm);
+   std::sort(MSm_pole_sorted.data(),
+             MSm_pole_sorted.data() + MSm_pole_sorted.size());
+
+   int right_index = detail::find_right_like_smuon(get_ZM());
+
+   if (verbose_output) {
+      VERBOSE("Converting mse(2,2) to on-shell scheme with Newton iteration ...\n"
+              "   Goal: MSm(" << right_index << ") = "
+              << MSm_pole_sorted(right_index));
+   }
+
+   auto calc_precision = [&MSm_pole_sorted, this] (unsigned idx) {
+      return std::abs(get_MSm(idx) - MSm_pole_sorted(idx));
+   };
+
+   double precision = calc_precision(right_index);
+   unsigned it = 0;
+
+   while (precision > precision_goal && it < max_iterations && !is_cancelled()) {
+      // d(MSm(i)^2)/d(mse2(2,2)) = |ZM(i,1)|^2
+      const double deriv = sqr(get_ZM(right_index,1));
+      const double diff = sqr(MSm_pole_sorted(right_index)) - sqr(get_MSm(right_index));
+      const double me211_old = get_me2(1,1);
+      const double me211 = me211_old + diff/deriv;
+
+      if (!std::isfinite(me211)) {
+         if (verbose_output) {
+            VERBOSE("   Vanishing derivative, stopping iteration ...");
+         }
+         break;
+      }
+
+      set_me2(1,1,me211);
+      calculate_MSm();
+
+      if (!get_MSm().allFinite() || !get_ZM().allFinite()) {
+         return std::numeric_limits<double>::max();
+      }
+
+      right_index = detail::find_right_like_smuon(get_ZM());
+
+      const double old_precision = precision;
+      precision = calc_precision(right_index);
+
+      if (!(precision < old_precision)) {
+         if (verbose_output) {
+            VERBOSE("   No improvement in last iteration step, stopping iteration ...");
+         }
+         // undo last step
+         set_me2(1,1,me211_old);
+         calculate_MSm();
+         precision = old_precision;
+         break;
+      }
+
+      if (verbose_output) {
+         VERBOSE("   Iteration " << it << ": mse(2,2) = "
+                 << signed_abs_sqrt(me211) << ", MSm(" << right_index
+                 << ") = " << get_MSm(right_index)
+                 << ", accuracy = " << precision);
+      }
+
+      it++;
+   }
+
+   if (verbose_output) {
+      if (precision > precision_goal) {
+         VERBOSE(
+            "   DR-bar to on-shell conversion for mse did not converge with"
+            " Newton iteration (reached absolute accuracy: " << precision <<
+            " GeV, accuracy goal: " << precision_goal <<
+            ", max. iterations: " << max_iterations << ")");
+      }
+      VERBOSE("   Achieved absolute accuracy: " << precision << " GeV");
+   }
+
+   return precision;
+}
+
+/**
+ * Determines soft-breaking right-handed smuon mass parameter from one
+ * smuon pole mass with a Newton iteration, see
+ * convert_me2_newton_modify().
+ *
+ * If a NaN appears during the iteration, the function resets the
+ * soft-breaking right-handed smuon mass parameter to the initial
+ * value and returns the maximum double.
+ *
+ * @param precision_goal precision goal of iteration
+ * @param max_iterations maximum number of iterations
+ * @return achieved precision
+ */
+double MSSMNoFV_onshell::convert_me2_newton(
+   double precision_goal,
+   unsigned max_iterations)
+{
+   const double me2_save = get_me2(1,1);
+   const double precision = convert_me2_newton_modify(precision_goal, max_iterations);
+
+   if (!std::isfinite(precision) ||
+       !std::isfinite(get_me2(1,1)) ||
+       !get_MSm().allFinite() ||
+       !get_ZM().allFinite()) {
+      // reset
+      set_me2(1,1,me2_save);
+      calculate_MSm();
+
+      return std::numeric_limits<double>::max();
+   }
+
+   return precision;
+}
+
 /**
  * Determines soft-breaking right-handed smuon mass parameter from one
  * smuon pole mass.  The function uses a one-dimensional root-finding
@@ -675,8 +1065,8 @@ double MSSMNoFV_onshell::convert_me2_root_modify(
    boost::uintmax_t it = max_iterations;
 
    // stopping criterion, given two brackets a, b
-   auto Stop_crit = [precision_goal](double a, double b) -> bool {
-      return gm2calc::is_equal(a,b,precision_goal);
+   auto Stop_crit = [this, precision_goal](double a, double b) -> bool {
+      return gm2calc::is_equal(a,b,precision_goal) || is_cancelled();
    };
 
    if (verbose_output) {
@@ -784,7 +1174,7 @@ double MSSMNoFV_onshell::convert_me2_fpi_modify(
    double precision = calc_precision(right_index);
    unsigned it = 0;
 
-   while (precision > precision_goal && it < max_iterations) {
+   while (precision > precision_goal && it < max_iterations && !is_cancelled()) {
       const Eigen::Matrix<double,2,2> ZM(get_ZM()); // smuon mixing matrix
       const Eigen::Matrix<double,2,2> M(
          ZM.adjoint() * MSm_goal.square().matrix().asDiagonal() * ZM);
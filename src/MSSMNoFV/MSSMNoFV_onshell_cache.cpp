@@ -0,0 +1,496 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "MSSMNoFV/MSSMNoFV_onshell_cache.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/gm2_error.hpp"
+
+#include <complex>
+#include <cstring>
+#include <fstream>
+
+#include <Eigen/Core>
+
+namespace gm2calc {
+
+namespace {
+
+/// magic number at the beginning of a cache file
+const char cache_magic[8] = {'G', 'M', '2', 'C', 'O', 'S', 'C', 'H'};
+
+/// version of the cache file format, increment when the entry layout changes
+const std::uint64_t cache_version = 1;
+
+/// size of the cache file header
+const std::streamoff header_size = sizeof(cache_magic) + 2 * sizeof(std::uint64_t);
+
+/// number of values in the state which describe the convergence warnings
+const std::size_t number_of_warning_values = 6;
+
+template <class F>
+void visit_value(F& f, double& x) { f(x); }
+
+template <class F>
+void visit_value(F& f, const double& x) { f(x); }
+
+template <class F>
+void visit_value(F& f, std::complex<double>& z)
+{
+   auto& re_im = reinterpret_cast<double(&)[2]>(z);
+   f(re_im[0]);
+   f(re_im[1]);
+}
+
+template <class F>
+void visit_value(F& f, const std::complex<double>& z)
+{
+   const auto& re_im = reinterpret_cast<const double(&)[2]>(z);
+   f(re_im[0]);
+   f(re_im[1]);
+}
+
+template <class F, class Derived>
+void visit_value(F& f, Eigen::PlainObjectBase<Derived>& m)
+{
+   for (Eigen::Index i = 0; i < m.size(); ++i) {
+      visit_value(f, m.data()[i]);
+   }
+}
+
+template <class F, class Derived>
+void visit_value(F& f, const Eigen::PlainObjectBase<Derived>& m)
+{
+   for (Eigen::Index i = 0; i < m.size(); ++i) {
+      visit_value(f, m.data()[i]);
+   }
+}
+
+/// a const model is only read
+template <class T, class Set>
+void set_parameter(const MSSMNoFV_onshell&, const T&, Set) {}
+
+template <class T, class Set>
+void set_parameter(MSSMNoFV_onshell& model, const T& value, Set set)
+{
+   set(model, value);
+}
+
+template <class T>
+void write_value(std::ostream& ostr, const T& value)
+{
+   ostr.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool read_value(std::istream& istr, T& value)
+{
+   return static_cast<bool>(istr.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // anonymous namespace
+
+/**
+ * Opens the cache file with the given name.  If the file does not
+ * exist, an empty cache file is created.
+ *
+ * @param file_name_ name of the cache file
+ *
+ * @throw EReadError if the file cannot be created or is not a valid
+ * cache file
+ */
+MSSMNoFV_onshell_cache::MSSMNoFV_onshell_cache(const std::string& file_name_)
+   : file_name(file_name_)
+{
+   if (!std::ifstream(file_name, std::ios::binary)) {
+      write_header();
+   }
+
+   file.open(file_name, std::ios::in | std::ios::out | std::ios::binary);
+
+   if (!file) {
+      throw EReadError("cannot open cache file \"" + file_name + "\"");
+   }
+
+   read_index();
+}
+
+/**
+ * Converts the given model to the on-shell scheme, see
+ * MSSMNoFV_onshell::convert_to_onshell().  If the conversion of the
+ * same input parameters (with the same precision and maximum number
+ * of iterations) has been stored in the cache before, the converted
+ * parameters are taken from the cache and only the DR-bar mass
+ * spectrum is re-calculated.  Otherwise the model is converted and
+ * the result is appended to the cache file, unless the conversion
+ * has been cancelled.
+ *
+ * @param model model to convert
+ * @param precision accuracy goal for the conversion
+ * @param max_iterations maximum number of iterations
+ * @param token optional cancellation token (may be nullptr)
+ */
+void MSSMNoFV_onshell_cache::convert_to_onshell(
+   MSSMNoFV_onshell& model, double precision, unsigned max_iterations,
+   const Cancellation_token* token)
+{
+   const auto input = get_input(model, precision, max_iterations);
+   const auto key = hash(input);
+   State output;
+
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (find_entry(input, key, output)) {
+         hits++;
+         set_output(model, output);
+         return;
+      }
+      misses++;
+   }
+
+   model.convert_to_onshell(precision, max_iterations, token);
+
+   if (!model.get_problems().have_problem() &&
+       !model.get_problems().conversion_cancelled()) {
+      const auto result = get_output(model);
+      std::lock_guard<std::mutex> lock(mutex);
+      write_entry(key, input, result);
+   }
+}
+
+std::size_t MSSMNoFV_onshell_cache::size() const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return index.size();
+}
+
+unsigned long MSSMNoFV_onshell_cache::get_hits() const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return hits;
+}
+
+unsigned long MSSMNoFV_onshell_cache::get_misses() const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return misses;
+}
+
+/// reads the hashes of all entries from the cache file
+void MSSMNoFV_onshell_cache::read_index()
+{
+   char magic[sizeof(cache_magic)];
+   std::uint64_t version = 0, size = 0;
+
+   if (!file.read(magic, sizeof(magic)) || !read_value(file, version) ||
+       !read_value(file, size) ||
+       std::memcmp(magic, cache_magic, sizeof(cache_magic)) != 0) {
+      throw EReadError("\"" + file_name + "\" is not a GM2Calc cache file");
+   }
+
+   if (version != cache_version || size != static_cast<std::uint64_t>(entry_size())) {
+      throw EReadError("cache file \"" + file_name + "\" has an incompatible format");
+   }
+
+   file.seekg(0, std::ios::end);
+   end = file.tellg();
+
+   if ((end - header_size) % entry_size() != 0) {
+      throw EReadError("cache file \"" + file_name + "\" is corrupt");
+   }
+
+   for (std::streamoff pos = header_size; pos < end; pos += entry_size()) {
+      std::uint64_t key = 0;
+      file.seekg(pos);
+      if (!read_value(file, key)) {
+         throw EReadError("cannot read from cache file \"" + file_name + "\"");
+      }
+      index.emplace(key, pos);
+   }
+}
+
+/// creates a new cache file with an empty index
+void MSSMNoFV_onshell_cache::write_header() const
+{
+   std::ofstream ostr(file_name, std::ios::binary | std::ios::trunc);
+
+   ostr.write(cache_magic, sizeof(cache_magic));
+   write_value(ostr, cache_version);
+   write_value(ostr, static_cast<std::uint64_t>(entry_size()));
+
+   if (!ostr) {
+      throw EReadError("cannot create cache file \"" + file_name + "\"");
+   }
+}
+
+/**
+ * Searches the cache for an entry with the given input parameters.
+ *
+ * @param input input parameters
+ * @param key hash of the input parameters
+ * @param output output parameters (set if an entry has been found)
+ *
+ * @return true if an entry has been found, false otherwise
+ */
+bool MSSMNoFV_onshell_cache::find_entry(
+   const State& input, std::uint64_t key, State& output)
+{
+   const auto range = index.equal_range(key);
+
+   for (auto it = range.first; it != range.second; ++it) {
+      if (read_entry(it->second, input, output)) {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+/**
+ * Reads the entry at the given position.  If the input parameters of
+ * the entry are equal to the given ones, the stored output parameters
+ * are returned.
+ *
+ * @param pos position of the entry in the cache file
+ * @param input input parameters
+ * @param output output parameters (set if the input parameters match)
+ *
+ * @return true if the input parameters match, false otherwise
+ */
+bool MSSMNoFV_onshell_cache::read_entry(
+   std::streamoff pos, const State& input, State& output)
+{
+   file.seekg(pos + static_cast<std::streamoff>(sizeof(std::uint64_t)));
+
+   State stored_input(input.size());
+   output.resize(input.size() - 2 + number_of_warning_values);
+
+   if (!file.read(reinterpret_cast<char*>(stored_input.data()), stored_input.size() * sizeof(double)) ||
+       !file.read(reinterpret_cast<char*>(output.data()), output.size() * sizeof(double))) {
+      throw EReadError("cannot read from cache file \"" + file_name + "\"");
+   }
+
+   return std::memcmp(stored_input.data(), input.data(), input.size() * sizeof(double)) == 0;
+}
+
+/// appends an entry to the cache file
+void MSSMNoFV_onshell_cache::write_entry(
+   std::uint64_t key, const State& input, const State& output)
+{
+   file.seekp(end);
+
+   write_value(file, key);
+   file.write(reinterpret_cast<const char*>(input.data()), input.size() * sizeof(double));
+   file.write(reinterpret_cast<const char*>(output.data()), output.size() * sizeof(double));
+   file.flush();
+
+   if (!file) {
+      throw EReadError("cannot write to cache file \"" + file_name + "\"");
+   }
+
+   index.emplace(key, end);
+   end += entry_size();
+}
+
+/// returns the size of an entry in the cache file (in bytes)
+std::streamoff MSSMNoFV_onshell_cache::entry_size()
+{
+   static const std::size_t n = get_output(MSSMNoFV_onshell()).size()
+                                - number_of_warning_values;
+   // hash + input (parameters, precision, max. iterations) + output
+   return sizeof(std::uint64_t) +
+          (n + 2 + n + number_of_warning_values) * sizeof(double);
+}
+
+/// calculates the FNV-1a hash of the given parameters
+std::uint64_t MSSMNoFV_onshell_cache::hash(const State& state)
+{
+   std::uint64_t h = 14695981039346656037ULL;
+   const auto bytes = reinterpret_cast<const unsigned char*>(state.data());
+
+   for (std::size_t i = 0; i < state.size() * sizeof(double); ++i) {
+      h ^= bytes[i];
+      h *= 1099511628211ULL;
+   }
+
+   return h;
+}
+
+/// returns the parameters which determine the result of the conversion
+MSSMNoFV_onshell_cache::State MSSMNoFV_onshell_cache::get_input(
+   const MSSMNoFV_onshell& model, double precision, unsigned max_iterations)
+{
+   State state;
+   visit_parameters(model, [&state] (double x) { state.push_back(x); });
+   state.push_back(precision);
+   state.push_back(max_iterations);
+   return state;
+}
+
+/// returns the converted parameters, the pole masses and the convergence warnings
+MSSMNoFV_onshell_cache::State MSSMNoFV_onshell_cache::get_output(
+   const MSSMNoFV_onshell& model)
+{
+   State state;
+   visit_parameters(model, [&state] (double x) { state.push_back(x); });
+
+   const auto& problems = model.get_problems();
+   const auto p1 = problems.get_Mu_MassB_MassWB_convergence_problem();
+   const auto p2 = problems.get_me2_convergence_problem();
+   state.push_back(problems.no_Mu_MassB_MassWB_convergence() ? 1 : 0);
+   state.push_back(p1.precision);
+   state.push_back(p1.iterations);
+   state.push_back(problems.no_me2_convergence() ? 1 : 0);
+   state.push_back(p2.precision);
+   state.push_back(p2.iterations);
+
+   return state;
+}
+
+/// sets the converted parameters and re-calculates the DR-bar masses
+void MSSMNoFV_onshell_cache::set_output(
+   MSSMNoFV_onshell& model, const State& state)
+{
+   std::size_t i = 0;
+   visit_parameters(model, [&state, &i] (double& x) { x = state.at(i++); });
+
+   auto& problems = model.get_problems();
+   problems.clear();
+   if (state.at(i) != 0) {
+      problems.flag_no_convergence_Mu_MassB_MassWB(state.at(i + 1), static_cast<unsigned>(state.at(i + 2)));
+   }
+   if (state.at(i + 3) != 0) {
+      problems.flag_no_convergence_me2(state.at(i + 4), static_cast<unsigned>(state.at(i + 5)));
+   }
+
+   model.calculate_DRbar_masses();
+}
+
+/**
+ * Calls the given function for every parameter of the model which
+ * is an input or an output of the on-shell conversion.  If the model
+ * is not const, the function receives a reference to a copy of the
+ * parameter, which is written back to the model afterwards.
+ *
+ * @note Changing the order or the number of the visited parameters
+ * changes the cache file format.
+ *
+ * @param model model
+ * @param f function to be called with (a reference to) each parameter
+ */
+template <class Model, class F>
+void MSSMNoFV_onshell_cache::visit_parameters(Model& model, F&& f)
+{
+#define VISIT_PARAMETER(p)                                              \
+   do {                                                                 \
+      auto x = model.get_##p();                                         \
+      visit_value(f, x);                                                \
+      set_parameter(model, x, [] (MSSMNoFV_onshell& m, const decltype(x)& v) { m.set_##p(v); }); \
+   } while (false)
+
+   // SUSY parameters
+   VISIT_PARAMETER(scale);
+   VISIT_PARAMETER(Yd);
+   VISIT_PARAMETER(Ye);
+   VISIT_PARAMETER(Yu);
+   VISIT_PARAMETER(Mu);
+   VISIT_PARAMETER(g1);
+   VISIT_PARAMETER(g2);
+   VISIT_PARAMETER(g3);
+   VISIT_PARAMETER(vd);
+   VISIT_PARAMETER(vu);
+
+   // soft-breaking parameters
+   VISIT_PARAMETER(TYd);
+   VISIT_PARAMETER(TYe);
+   VISIT_PARAMETER(TYu);
+   VISIT_PARAMETER(BMu);
+   VISIT_PARAMETER(mq2);
+   VISIT_PARAMETER(ml2);
+   VISIT_PARAMETER(mHd2);
+   VISIT_PARAMETER(mHu2);
+   VISIT_PARAMETER(md2);
+   VISIT_PARAMETER(mu2);
+   VISIT_PARAMETER(me2);
+   VISIT_PARAMETER(MassB);
+   VISIT_PARAMETER(MassWB);
+   VISIT_PARAMETER(MassG);
+
+   // on-shell parameters
+   VISIT_PARAMETER(EL);
+   VISIT_PARAMETER(EL0);
+   VISIT_PARAMETER(MB);
+   VISIT_PARAMETER(Au);
+   VISIT_PARAMETER(Ad);
+   VISIT_PARAMETER(Ae);
+
+#undef VISIT_PARAMETER
+
+   // pole masses and mixings
+   auto& physical = model.get_physical();
+   visit_value(f, physical.MVG);
+   visit_value(f, physical.MGlu);
+   visit_value(f, physical.MVP);
+   visit_value(f, physical.MVZ);
+   visit_value(f, physical.MVWm);
+   visit_value(f, physical.MFd);
+   visit_value(f, physical.MFs);
+   visit_value(f, physical.MFb);
+   visit_value(f, physical.MFu);
+   visit_value(f, physical.MFc);
+   visit_value(f, physical.MFt);
+   visit_value(f, physical.MFve);
+   visit_value(f, physical.MFvm);
+   visit_value(f, physical.MFvt);
+   visit_value(f, physical.MFe);
+   visit_value(f, physical.MFm);
+   visit_value(f, physical.MFtau);
+   visit_value(f, physical.MSveL);
+   visit_value(f, physical.MSvmL);
+   visit_value(f, physical.MSvtL);
+   visit_value(f, physical.MSd);
+   visit_value(f, physical.MSu);
+   visit_value(f, physical.MSe);
+   visit_value(f, physical.MSm);
+   visit_value(f, physical.MStau);
+   visit_value(f, physical.MSs);
+   visit_value(f, physical.MSc);
+   visit_value(f, physical.MSb);
+   visit_value(f, physical.MSt);
+   visit_value(f, physical.Mhh);
+   visit_value(f, physical.MAh);
+   visit_value(f, physical.MHpm);
+   visit_value(f, physical.MChi);
+   visit_value(f, physical.MCha);
+   visit_value(f, physical.ZD);
+   visit_value(f, physical.ZU);
+   visit_value(f, physical.ZE);
+   visit_value(f, physical.ZM);
+   visit_value(f, physical.ZTau);
+   visit_value(f, physical.ZS);
+   visit_value(f, physical.ZC);
+   visit_value(f, physical.ZB);
+   visit_value(f, physical.ZT);
+   visit_value(f, physical.ZH);
+   visit_value(f, physical.ZA);
+   visit_value(f, physical.ZP);
+   visit_value(f, physical.ZN);
+   visit_value(f, physical.UM);
+   visit_value(f, physical.UP);
+}
+
+} // namespace gm2calc
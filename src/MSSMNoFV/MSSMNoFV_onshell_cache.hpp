@@ -0,0 +1,99 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_MSSMNOFV_ONSHELL_CACHE_HPP
+#define GM2_MSSMNOFV_ONSHELL_CACHE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gm2calc {
+
+class Cancellation_token;
+class MSSMNoFV_onshell;
+
+/**
+ * @class MSSMNoFV_onshell_cache
+ * @brief persistent cache of MSSMNoFV points converted to the on-shell scheme
+ *
+ * The cache stores the result of MSSMNoFV_onshell::convert_to_onshell()
+ * (the converged on-shell parameters, the pole mass spectrum and the
+ * convergence warnings) in an append-only binary file.  The entries
+ * are keyed by a hash of the model parameters before the conversion,
+ * i.e. of the parameters read from the SLHA input blocks.
+ *
+ * The file consists of a header followed by fixed-size entries.  When
+ * the cache is opened only the hashes are read to build the index;
+ * the parameters of an entry are read from the file on a cache hit.
+ * Points with a physical problem (e.g. tachyons) and cancelled
+ * conversions are not cached.  The cache file is kept open while the
+ * object exists.
+ *
+ * The member functions may be called from several threads at the
+ * same time.  The conversion itself runs outside of the lock, so the
+ * same point may be converted (and stored) more than once.
+ */
+class MSSMNoFV_onshell_cache {
+public:
+   explicit MSSMNoFV_onshell_cache(const std::string&);
+
+   /// convert model to the on-shell scheme, re-using a cached result if available
+   void convert_to_onshell(MSSMNoFV_onshell&, double precision = 1e-8,
+                           unsigned max_iterations = 1000,
+                           const Cancellation_token* token = nullptr);
+
+   /// number of entries in the cache
+   std::size_t size() const;
+   /// number of conversions taken from the cache
+   unsigned long get_hits() const;
+   /// number of conversions not found in the cache
+   unsigned long get_misses() const;
+
+private:
+   using State = std::vector<double>;
+
+   std::string file_name;  ///< cache file name
+   std::fstream file;      ///< cache file
+   mutable std::mutex mutex; ///< protects the file, the index and the counters
+   std::unordered_multimap<std::uint64_t, std::streamoff> index; ///< hash -> position of entry
+   std::streamoff end{0};  ///< end of the cache file
+   unsigned long hits{0};  ///< number of cache hits
+   unsigned long misses{0}; ///< number of cache misses
+
+   void read_index();
+   void write_header() const;
+   bool find_entry(const State&, std::uint64_t, State&);
+   bool read_entry(std::streamoff, const State&, State&);
+   void write_entry(std::uint64_t, const State&, const State&);
+
+   static std::streamoff entry_size();
+   static std::uint64_t hash(const State&);
+   static State get_input(const MSSMNoFV_onshell&, double, unsigned);
+   static State get_output(const MSSMNoFV_onshell&);
+   static void set_output(MSSMNoFV_onshell&, const State&);
+   template <class Model, class F>
+   static void visit_parameters(Model&, F&&);
+};
+
+} // namespace gm2calc
+
+#endif
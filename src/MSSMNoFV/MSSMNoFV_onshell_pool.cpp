@@ -0,0 +1,148 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/MSSMNoFV_onshell_pool.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+
+#include <utility>
+
+namespace gm2calc {
+
+MSSMNoFV_onshell_pool::Handle::Handle(
+   MSSMNoFV_onshell_pool* pool_, std::unique_ptr<MSSMNoFV_onshell> model_) noexcept
+   : pool(pool_), model(std::move(model_))
+{
+}
+
+MSSMNoFV_onshell_pool::Handle::Handle(Handle&& other) noexcept
+   : pool(other.pool), model(std::move(other.model))
+{
+   other.pool = nullptr;
+}
+
+MSSMNoFV_onshell_pool::Handle::~Handle()
+{
+   release();
+}
+
+MSSMNoFV_onshell_pool::Handle&
+MSSMNoFV_onshell_pool::Handle::operator=(Handle&& other) noexcept
+{
+   if (this != &other) {
+      release();
+      pool = other.pool;
+      model = std::move(other.model);
+      other.pool = nullptr;
+   }
+   return *this;
+}
+
+/// returns the model to the pool
+void MSSMNoFV_onshell_pool::Handle::release() noexcept
+{
+   if (pool && model) {
+      pool->put_back(std::move(model));
+   }
+   pool = nullptr;
+}
+
+MSSMNoFV_onshell_pool::MSSMNoFV_onshell_pool() = default;
+
+MSSMNoFV_onshell_pool::~MSSMNoFV_onshell_pool() = default;
+
+/**
+ * Borrows a model from the pool and resets its parameters to the
+ * default values.
+ *
+ * @return handle to the borrowed model
+ */
+MSSMNoFV_onshell_pool::Handle MSSMNoFV_onshell_pool::acquire()
+{
+   auto model = take();
+   model->reset();
+   return Handle(this, std::move(model));
+}
+
+/**
+ * Borrows a model from the pool and copies the parameters of the
+ * given model into it, see MSSMNoFV_onshell::assign_inputs().
+ *
+ * @param inputs model to copy the parameters from
+ *
+ * @return handle to the borrowed model
+ */
+MSSMNoFV_onshell_pool::Handle MSSMNoFV_onshell_pool::acquire(const MSSMNoFV_onshell& inputs)
+{
+   auto model = take();
+   model->assign_inputs(inputs);
+   return Handle(this, std::move(model));
+}
+
+/**
+ * Allocates models until the pool holds at least n models.  After
+ * this call, up to n models can be borrowed at the same time without
+ * heap allocations.
+ *
+ * @param n number of models
+ */
+void MSSMNoFV_onshell_pool::reserve(std::size_t n)
+{
+   models.reserve(n);
+   while (models.size() < n) {
+      models.emplace_back(new MSSMNoFV_onshell());
+   }
+}
+
+/**
+ * Returns the pool of the current thread.  Models borrowed from this
+ * pool must be returned before the thread exits.
+ *
+ * @return pool of the current thread
+ */
+MSSMNoFV_onshell_pool& MSSMNoFV_onshell_pool::thread_local_instance()
+{
+   thread_local MSSMNoFV_onshell_pool pool;
+   return pool;
+}
+
+/// removes a model from the pool, allocates a new one if the pool is empty
+std::unique_ptr<MSSMNoFV_onshell> MSSMNoFV_onshell_pool::take()
+{
+   if (models.empty()) {
+      // make room for returning the new model
+      models.reserve(models.capacity() + 1);
+      return std::unique_ptr<MSSMNoFV_onshell>(new MSSMNoFV_onshell());
+   }
+
+   auto model = std::move(models.back());
+   models.pop_back();
+
+   return model;
+}
+
+/// returns a model to the pool
+void MSSMNoFV_onshell_pool::put_back(std::unique_ptr<MSSMNoFV_onshell> model) noexcept
+{
+   try {
+      models.push_back(std::move(model));
+   } catch (...) {
+      // model is deleted
+   }
+}
+
+} // namespace gm2calc
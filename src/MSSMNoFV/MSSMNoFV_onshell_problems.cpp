@@ -31,6 +31,7 @@ void MSSMNoFV_onshell_problems::clear_problems()
 
 void MSSMNoFV_onshell_problems::clear_warnings()
 {
+   have_conversion_cancelled = false;
    have_no_convergence_Mu_MassB_MassWB = false;
    have_no_convergence_me2 = false;
    convergence_problem_Mu_MassB_MassWB.clear();
@@ -50,6 +51,16 @@ void MSSMNoFV_onshell_problems::flag_tachyon(const std::string& particle_name)
    tachyons.erase(std::unique(tachyons.begin(), tachyons.end()), tachyons.end());
 }
 
+void MSSMNoFV_onshell_problems::flag_conversion_cancelled()
+{
+   have_conversion_cancelled = true;
+}
+
+void MSSMNoFV_onshell_problems::unflag_conversion_cancelled()
+{
+   have_conversion_cancelled = false;
+}
+
 void MSSMNoFV_onshell_problems::flag_no_convergence_Mu_MassB_MassWB(
    double precision, unsigned iterations)
 {
@@ -90,7 +101,14 @@ bool MSSMNoFV_onshell_problems::have_problem() const
 
 bool MSSMNoFV_onshell_problems::have_warning() const
 {
-   return have_no_convergence_Mu_MassB_MassWB || have_no_convergence_me2;
+   return have_conversion_cancelled || have_no_convergence_Mu_MassB_MassWB
+      || have_no_convergence_me2;
+}
+
+/// returns true if DR-bar to OS conversion has been stopped by a cancellation token
+bool MSSMNoFV_onshell_problems::conversion_cancelled() const
+{
+   return have_conversion_cancelled;
 }
 
 /// returns true if DR-bar to OS conversion for Mu, M1, M2 did not converge
@@ -155,6 +173,10 @@ void MSSMNoFV_onshell_problems::print_warnings(std::ostream& ostr) const
       ostr << "Warning:";
    }
 
+   if (have_conversion_cancelled) {
+      ostr << " DR-bar to on-shell conversion cancelled,";
+   }
+
    if (have_no_convergence_Mu_MassB_MassWB) {
       ostr << " DR-bar to on-shell conversion for Mu, M1, M2 failed"
               " (reached absolute accuracy: "
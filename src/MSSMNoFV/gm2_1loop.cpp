@@ -17,9 +17,11 @@
 // ====================================================================
 
 #include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/MSSMNoFV_amu_parameters.hpp"
 #include "gm2calc/MSSMNoFV_onshell.hpp"
 
 #include "MSSMNoFV/gm2_1loop_helpers.hpp"
+#include "MSSMNoFV/gm2_amu_parameters_helpers.hpp"
 #include "gm2_ffunctions.hpp"
 #include "gm2_numerics.hpp"
 
@@ -60,7 +62,7 @@ double calculate_amu_1loop_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
    MSSMNoFV_onshell model_ytree(model);
    model_ytree.convert_to_non_tan_beta_resummed();
 
-   return amu1LChi0(model_ytree) + amu1LChipm(model_ytree);
+   return calculate_amu_1loop(make_amu_parameters(model_ytree));
 }
 
 /**
@@ -73,20 +75,29 @@ double calculate_amu_1loop_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
  */
 double calculate_amu_1loop(const MSSMNoFV_onshell& model)
 {
-   return amu1LChi0(model) + amu1LChipm(model);
+   return calculate_amu_1loop(make_amu_parameters(model));
+}
+
+/**
+ * Calculates full 1-loop SUSY contribution to (g-2), Eq (45) of
+ * arXiv:hep-ph/0609168, with tan(beta) resummation.
+ */
+double calculate_amu_1loop(const MSSMNoFV_amu_parameters& pars)
+{
+   return amu1LChi0(pars) + amu1LChipm(pars);
 }
 
 /**
  * Calculates 1-loop neutralino contribution to (g-2), Eq (2.11a) of
  * arXiv:1311.1775.
  */
-double amu1LChi0(const MSSMNoFV_onshell& model)
+double amu1LChi0(const MSSMNoFV_amu_parameters& pars)
 {
-   const Eigen::Array<double,2,1>& m_smu(model.get_MSm());
-   const Eigen::Array<double,4,2> AAN_(AAN(model));
-   const Eigen::Array<double,4,2> BBN_(BBN(model));
-   const Eigen::Array<double,4,2> x(x_im(model));
-   const Eigen::Array<double,4,1>& m_chi(model.get_MChi());
+   const Eigen::Array<double,2,1> m_smu(to_array(pars.MSm));
+   const Eigen::Array<double,4,2> AAN_(AAN(pars));
+   const Eigen::Array<double,4,2> BBN_(BBN(pars));
+   const Eigen::Array<double,4,2> x(x_im(pars));
+   const Eigen::Array<double,4,1> m_chi(to_array(pars.MChi));
 
    double result = 0;
 
@@ -94,47 +105,47 @@ double amu1LChi0(const MSSMNoFV_onshell& model)
       for (int m = 0; m < 2; ++m) {
          result += - AAN_(i, m) * F1N(x(i, m)) / (12 * sqr(m_smu(m)))
                    - m_chi(i) * BBN_(i, m) * F2N(x(i, m))
-                      / (6 * model.get_MM() * sqr(m_smu(m)));
+                      / (6 * pars.MM * sqr(m_smu(m)));
       }
    }
 
-   return result * sqr(model.get_MM()) * oneOver16PiSqr;
+   return result * sqr(pars.MM) * oneOver16PiSqr;
 }
 
 /**
  * Calculates 1-loop chargino contribution to (g-2), Eq (2.11b) of
  * arXiv:1311.1775.
  */
-double amu1LChipm(const MSSMNoFV_onshell& model)
+double amu1LChipm(const MSSMNoFV_amu_parameters& pars)
 {
-   const Eigen::Array<double,2,1> x(x_k(model));
-   const double MSvm(model.get_MSvmL());
-   const Eigen::Array<double,2,1> AAC_(AAC(model));
-   const Eigen::Array<double,2,1> BBC_(BBC(model));
-   const Eigen::Array<double,2,1>& m_cha(model.get_MCha());
+   const Eigen::Array<double,2,1> x(x_k(pars));
+   const double MSvm(pars.MSvmL);
+   const Eigen::Array<double,2,1> AAC_(AAC(pars));
+   const Eigen::Array<double,2,1> BBC_(BBC(pars));
+   const Eigen::Array<double,2,1> m_cha(to_array(pars.MCha));
 
    double result = 0;
 
    for (int k = 0; k < 2; ++k) {
       result +=
          AAC_(k) * F1C(x(k)) / 12 +
-         m_cha(k) * BBC_(k) * F2C(x(k)) / (3 * model.get_MM());
+         m_cha(k) * BBC_(k) * F2C(x(k)) / (3 * pars.MM);
    }
 
-   return result * sqr(model.get_MM()/MSvm) * oneOver16PiSqr;
+   return result * sqr(pars.MM/MSvm) * oneOver16PiSqr;
 }
 
 /**
  * Calculates \f$n^L_{i\tilde{l}_k}\f$, Eq (2.5o) of arXiv:1311.1775,
  * for \f$l=\mu\f$
  */
-Eigen::Array<std::complex<double>,4,2> n_L(const MSSMNoFV_onshell& model)
+Eigen::Array<std::complex<double>,4,2> n_L(const MSSMNoFV_amu_parameters& pars)
 {
-   const double gY(model.get_gY());
-   const double g2(model.get_g2());
-   const double ymu(model.get_Ye(1, 1));
-   const Eigen::Matrix<std::complex<double>,4,4>& ZN(model.get_ZN());
-   const Eigen::Matrix<double,2,2>& u_smu(model.get_USm());
+   const double gY(pars.gY);
+   const double g2(pars.g2);
+   const double ymu(pars.Ye[1]);
+   const Eigen::Matrix<std::complex<double>,4,4> ZN(to_matrix<4>(pars.ZN));
+   const Eigen::Matrix<double,2,2> u_smu(to_matrix<2>(pars.USm));
 
    Eigen::Array<std::complex<double>,4,2> result;
 
@@ -154,12 +165,12 @@ Eigen::Array<std::complex<double>,4,2> n_L(const MSSMNoFV_onshell& model)
  * Calculates \f$n^R_{i\tilde{l}_k}\f$, Eq (2.5p) of arXiv:1311.1775,
  * with \f$l=\mu\f$.
  */
-Eigen::Array<std::complex<double>,4,2> n_R(const MSSMNoFV_onshell& model)
+Eigen::Array<std::complex<double>,4,2> n_R(const MSSMNoFV_amu_parameters& pars)
 {
-   const double gY(model.get_gY());
-   const double ymu(model.get_Ye(1, 1));
-   const Eigen::Matrix<std::complex<double>,4,4>& ZN(model.get_ZN());
-   const Eigen::Matrix<double,2,2>& u_smu(model.get_USm());
+   const double gY(pars.gY);
+   const double ymu(pars.Ye[1]);
+   const Eigen::Matrix<std::complex<double>,4,4> ZN(to_matrix<4>(pars.ZN));
+   const Eigen::Matrix<double,2,2> u_smu(to_matrix<2>(pars.USm));
 
    Eigen::Array<std::complex<double>,4,2> result;
 
@@ -180,9 +191,9 @@ Eigen::Array<std::complex<double>,4,2> n_R(const MSSMNoFV_onshell& model)
  * This expression is the complex conjugate of Eq. (50) of
  * arXiv:hep-ph/0609168.
  */
-Eigen::Array<std::complex<double>,2,1> c_L(const MSSMNoFV_onshell& model)
+Eigen::Array<std::complex<double>,2,1> c_L(const MSSMNoFV_amu_parameters& pars)
 {
-   return -model.get_g2() * model.get_UP().col(0).conjugate();
+   return -pars.g2 * to_matrix<2>(pars.UP).col(0).conjugate();
 }
 
 /**
@@ -191,9 +202,9 @@ Eigen::Array<std::complex<double>,2,1> c_L(const MSSMNoFV_onshell& model)
  *
  * This expression is equal to Eq. (51) of arXiv:hep-ph/0609168.
  */
-Eigen::Array<std::complex<double>,2,1> c_R(const MSSMNoFV_onshell& model)
+Eigen::Array<std::complex<double>,2,1> c_R(const MSSMNoFV_amu_parameters& pars)
 {
-   return model.get_Ye(1, 1) * model.get_UM().col(1);
+   return pars.Ye[1] * to_matrix<2>(pars.UM).col(1);
 }
 
 /**
@@ -204,9 +215,9 @@ Eigen::Array<std::complex<double>,2,1> c_R(const MSSMNoFV_onshell& model)
  * This expression is identical to \f$|c^L_{im}|^2 + |c^R_{im}|^2\f$,
  * which appears in Eq. (47) of arXiv:hep-ph/0609168.
  */
-Eigen::Array<double,2,1> AAC(const MSSMNoFV_onshell& model)
+Eigen::Array<double,2,1> AAC(const MSSMNoFV_amu_parameters& pars)
 {
-   return c_L(model).cwiseAbs2() + c_R(model).cwiseAbs2();
+   return c_L(pars).cwiseAbs2() + c_R(pars).cwiseAbs2();
 }
 
 /**
@@ -217,9 +228,9 @@ Eigen::Array<double,2,1> AAC(const MSSMNoFV_onshell& model)
  * This expression is identical to \f$|n^L_{im}|^2 + |n^R_{im}|^2\f$,
  * which appears in Eq. (46) of arXiv:hep-ph/0609168.
  */
-Eigen::Array<double,4,2> AAN(const MSSMNoFV_onshell& model)
+Eigen::Array<double,4,2> AAN(const MSSMNoFV_amu_parameters& pars)
 {
-   return n_L(model).cwiseAbs2() + n_R(model).cwiseAbs2();
+   return n_L(pars).cwiseAbs2() + n_R(pars).cwiseAbs2();
 }
 
 /**
@@ -227,9 +238,9 @@ Eigen::Array<double,4,2> AAN(const MSSMNoFV_onshell& model)
  * [(c^L_{i\tilde{\nu}_\mu})^* c^R_{i\tilde{\nu}_\mu}]\f$,
  * Eqs (2.11b), (2.7b) in arXiv:1311.1775.
  */
-Eigen::Array<double,2,1> BBC(const MSSMNoFV_onshell& model)
+Eigen::Array<double,2,1> BBC(const MSSMNoFV_amu_parameters& pars)
 {
-   return 2 * (c_L(model).conjugate() * c_R(model)).real();
+   return 2 * (c_L(pars).conjugate() * c_R(pars)).real();
 }
 
 /**
@@ -237,19 +248,19 @@ Eigen::Array<double,2,1> BBC(const MSSMNoFV_onshell& model)
  * [(n^L_{i\tilde{\mu}_m})^* n^R_{i\tilde{\mu}_m}]\f$, Eqs (2.11a),
  * (2.7b) in arXiv:1311.1775.
  */
-Eigen::Array<double,4,2> BBN(const MSSMNoFV_onshell& model)
+Eigen::Array<double,4,2> BBN(const MSSMNoFV_amu_parameters& pars)
 {
-   return 2 * (n_L(model).conjugate() * n_R(model)).real();
+   return 2 * (n_L(pars).conjugate() * n_R(pars)).real();
 }
 
 /**
  * Calculates \f$x_{im} = m^2_{\chi_i^0} / m^2_{\tilde{\mu}_m}\f$,
  * which appears in Eq (46) of arXiv:hep-ph/0609168.
  */
-Eigen::Array<double,4,2> x_im(const MSSMNoFV_onshell& model)
+Eigen::Array<double,4,2> x_im(const MSSMNoFV_amu_parameters& pars)
 {
-   const Eigen::Matrix<double,4,1> m_chi(model.get_MChi());
-   const Eigen::Matrix<double,2,1> m_sm(model.get_MSm());
+   const Eigen::Matrix<double,4,1> m_chi(to_array(pars.MChi));
+   const Eigen::Matrix<double,2,1> m_sm(to_array(pars.MSm));
 
    return (m_chi * m_sm.cwiseInverse().transpose()).array().square();
 }
@@ -258,9 +269,9 @@ Eigen::Array<double,4,2> x_im(const MSSMNoFV_onshell& model)
  * Calculates \f$x_k = m^2_{\chi_k^\pm} / m^2_{\tilde{\nu}_\mu}\f$,
  * which appears in Eq (47) of arXiv:hep-ph/0609168.
  */
-Eigen::Array<double,2,1> x_k(const MSSMNoFV_onshell& model)
+Eigen::Array<double,2,1> x_k(const MSSMNoFV_amu_parameters& pars)
 {
-   return (model.get_MCha() / model.get_MSvmL()).square();
+   return (to_array(pars.MCha) / pars.MSvmL).square();
 }
 
 // === approximations ===
@@ -269,15 +280,15 @@ Eigen::Array<double,2,1> x_k(const MSSMNoFV_onshell& model)
  * Calculates the 1-loop leading log approximation: Wino--Higgsino,
  * muon-sneutrino, Eq (6.2a) arXiv:1311.1775
  */
-double amu1LWHnu(const MSSMNoFV_onshell& model)
+double amu1LWHnu(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tan_beta = model.get_TB();
-   const double M2 = model.get_MassWB();
-   const double mu = model.get_Mu();
-   const double msv_2 = model.get_MSvmL();
+   const double tan_beta = pars.TB;
+   const double M2 = pars.MassWB;
+   const double mu = pars.Mu;
+   const double msv_2 = pars.MSvmL;
 
-   return sqr(model.get_g2()) * 2 * oneOver16PiSqr
-      * (sqr(model.get_MM()) * M2 * mu * tan_beta) / sqr(sqr(msv_2))
+   return sqr(pars.g2) * 2 * oneOver16PiSqr
+      * (sqr(pars.MM) * M2 * mu * tan_beta) / sqr(sqr(msv_2))
       * Fa(sqr(M2 / msv_2), sqr(mu / msv_2));
 }
 
@@ -285,15 +296,15 @@ double amu1LWHnu(const MSSMNoFV_onshell& model)
  * Calculates the 1-loop leading log approximation: Wino--Higgsino,
  * left-handed smuon, Eq (6.2b) arXiv:1311.1775
  */
-double amu1LWHmuL(const MSSMNoFV_onshell& model)
+double amu1LWHmuL(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tan_beta = model.get_TB();
-   const double M2 = model.get_MassWB();
-   const double mu = model.get_Mu();
-   const double msl_2 = std::sqrt(model.get_ml2(1, 1));
+   const double tan_beta = pars.TB;
+   const double M2 = pars.MassWB;
+   const double mu = pars.Mu;
+   const double msl_2 = std::sqrt(pars.ml2[1]);
 
-   return - sqr(model.get_g2()) * oneOver16PiSqr
-      * (sqr(model.get_MM()) * M2 * mu * tan_beta) / sqr(sqr(msl_2))
+   return - sqr(pars.g2) * oneOver16PiSqr
+      * (sqr(pars.MM) * M2 * mu * tan_beta) / sqr(sqr(msl_2))
       * Fb(sqr(M2 / msl_2), sqr(mu / msl_2));
 }
 
@@ -301,16 +312,16 @@ double amu1LWHmuL(const MSSMNoFV_onshell& model)
  * Calculates the 1-loop leading log approximation: Bino--Higgsino,
  * left-handed smuon, Eq (6.2c) arXiv:1311.1775
  */
-double amu1LBHmuL(const MSSMNoFV_onshell& model)
+double amu1LBHmuL(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tan_beta = model.get_TB();
-   const double M1 = model.get_MassB();
-   const double mu = model.get_Mu();
-   const double msl_2 = std::sqrt(model.get_ml2(1, 1));
-   const double gY = model.get_gY();
+   const double tan_beta = pars.TB;
+   const double M1 = pars.MassB;
+   const double mu = pars.Mu;
+   const double msl_2 = std::sqrt(pars.ml2[1]);
+   const double gY = pars.gY;
 
    return sqr(gY) * oneOver16PiSqr
-      * (sqr(model.get_MM()) * M1 * mu * tan_beta) / sqr(sqr(msl_2))
+      * (sqr(pars.MM) * M1 * mu * tan_beta) / sqr(sqr(msl_2))
       * Fb(sqr(M1 / msl_2), sqr(mu / msl_2));
 }
 
@@ -318,16 +329,16 @@ double amu1LBHmuL(const MSSMNoFV_onshell& model)
  * Calculates the 1-loop leading log approximation: Bino--Higgsino,
  * right-handed smuon, Eq (6.2d) arXiv:1311.1775
  */
-double amu1LBHmuR(const MSSMNoFV_onshell& model)
+double amu1LBHmuR(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tan_beta = model.get_TB();
-   const double M1 = model.get_MassB();
-   const double mu = model.get_Mu();
-   const double mse_2 = std::sqrt(model.get_me2(1, 1));
-   const double gY = model.get_gY();
+   const double tan_beta = pars.TB;
+   const double M1 = pars.MassB;
+   const double mu = pars.Mu;
+   const double mse_2 = std::sqrt(pars.me2[1]);
+   const double gY = pars.gY;
 
    return - sqr(gY) * 2 * oneOver16PiSqr
-      * (sqr(model.get_MM()) * M1 * mu * tan_beta) / sqr(sqr(mse_2))
+      * (sqr(pars.MM) * M1 * mu * tan_beta) / sqr(sqr(mse_2))
       * Fb(sqr(M1 / mse_2), sqr(mu / mse_2));
 }
 
@@ -335,21 +346,21 @@ double amu1LBHmuR(const MSSMNoFV_onshell& model)
  * Calculates the 1-loop leading log approximation: Bino, left-handed
  * smuon, right-handed smuon, Eq (6.2e) arXiv:1311.1775
  */
-double amu1LBmuLmuR(const MSSMNoFV_onshell& model)
+double amu1LBmuLmuR(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tan_beta = model.get_TB();
-   const double M1 = model.get_MassB();
-   const double mu = model.get_Mu();
-   const double msl_2 = std::sqrt(model.get_ml2(1, 1));
-   const double mse_2 = std::sqrt(model.get_me2(1, 1));
-   const double gY = model.get_gY();
+   const double tan_beta = pars.TB;
+   const double M1 = pars.MassB;
+   const double mu = pars.Mu;
+   const double msl_2 = std::sqrt(pars.ml2[1]);
+   const double mse_2 = std::sqrt(pars.me2[1]);
+   const double gY = pars.gY;
 
    if (is_zero(M1, eps)) {
       return 0;
    }
 
    return sqr(gY) * 2 * oneOver16PiSqr
-      * (sqr(model.get_MM()) * mu * tan_beta) / (M1 * sqr(M1))
+      * (sqr(pars.MM) * mu * tan_beta) / (M1 * sqr(M1))
       * Fb(sqr(msl_2 / M1), sqr(mse_2 / M1));
 }
 
@@ -358,10 +369,10 @@ double amu1LBmuLmuR(const MSSMNoFV_onshell& model)
  * arXiv:1311.1775
  * as it stands, without tan(beta) resummation
  */
-double amu1Lapprox_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
+double amu1Lapprox_non_tan_beta_resummed(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu1LWHnu(model) + amu1LWHmuL(model) + amu1LBHmuL(model) +
-          amu1LBHmuR(model) + amu1LBmuLmuR(model);
+   return amu1LWHnu(pars) + amu1LWHmuL(pars) + amu1LBHmuL(pars) +
+          amu1LBHmuR(pars) + amu1LBmuLmuR(pars);
 }
 
 /**
@@ -369,9 +380,9 @@ double amu1Lapprox_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
  * arXiv:1311.1775
  * but include tan(beta) resummation
  */
-double amu1Lapprox(const MSSMNoFV_onshell& model)
+double amu1Lapprox(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu1Lapprox_non_tan_beta_resummed(model) * tan_beta_cor(model);
+   return amu1Lapprox_non_tan_beta_resummed(pars) * tan_beta_cor(pars);
 }
 
 // tan(beta) corrections
@@ -379,13 +390,13 @@ double amu1Lapprox(const MSSMNoFV_onshell& model)
 /**
  * Calculates \f$\frac{1}{1 + \Delta_{\mu}}\f$
  *
- * @param model model parameters
+ * @param pars model parameters
  *
  * @return \f$\frac{1}{1 + \Delta_{\mu}}\f$
  */
-double tan_beta_cor(const MSSMNoFV_onshell& model)
+double tan_beta_cor(const MSSMNoFV_amu_parameters& pars)
 {
-   const double delta_mu = delta_mu_correction(model);
+   const double delta_mu = delta_mu_correction(pars);
 
    return 1.0 / (1.0 + delta_mu);
 }
@@ -394,30 +405,30 @@ double tan_beta_cor(const MSSMNoFV_onshell& model)
  * Calculates \f$\Delta_{\ell}\f$ using a generalized form of Eq (8)
  * arxiv:0808.1530.
  *
- * @param model model parameters
+ * @param pars model parameters
  * @param gen lepton generation (0 = electron, 1 = muon, 2 = tau)
  *
  * @return \f$\Delta_{\ell}\f$
  */
-double delta_down_lepton_correction(const MSSMNoFV_onshell& model, int gen)
-{
-   const double mu = model.get_Mu();
-   const double tb = model.get_TB();
-   const double g2 = model.get_g2();
-   const double gY = model.get_gY();
-   const double M1 = model.get_MassB();
-   const double M2 = model.get_MassWB();
-   const double mw2 = sqr(model.get_MW());
-   const double mz2 = sqr(model.get_MZ());
+double delta_down_lepton_correction(const MSSMNoFV_amu_parameters& pars, int gen)
+{
+   const double mu = pars.Mu;
+   const double tb = pars.TB;
+   const double g2 = pars.g2;
+   const double gY = pars.gY;
+   const double M1 = pars.MassB;
+   const double M2 = pars.MassWB;
+   const double mw2 = sqr(pars.MW);
+   const double mz2 = sqr(pars.MZ);
    const double sw = std::sqrt(1 - mw2/mz2);
    const double sw2 = sw*sw;
    const double x1 = sqr(M2) + sqr(mu) + 2*mw2;
    const double x2 = abs_sqrt(sqr(x1) - sqr(2*M2*mu));
    const double m1 = abs_sqrt(0.5*(x1 - x2));
    const double m2 = abs_sqrt(0.5*(x1 + x2));
-   const double m_sneu_lep = abs_sqrt(model.get_ml2(gen, gen) - 0.5*mz2);
-   const double m_slep_L = abs_sqrt(model.get_ml2(gen, gen) - mz2*(sw2 - 0.5));
-   const double m_slep_R = abs_sqrt(model.get_me2(gen, gen) + mz2*sw2);
+   const double m_sneu_lep = abs_sqrt(pars.ml2[gen] - 0.5*mz2);
+   const double m_slep_L = abs_sqrt(pars.ml2[gen] - mz2*(sw2 - 0.5));
+   const double m_slep_R = abs_sqrt(pars.me2[gen] + mz2*sw2);
 
    const double delta_lep =
       - mu*tb*oneOver16PiSqr
@@ -431,47 +442,47 @@ double delta_down_lepton_correction(const MSSMNoFV_onshell& model, int gen)
 /**
  * Calculates \f$\Delta_{\mu}\f$ using delta_down_lepton_correction()
  *
- * @param model model parameters
+ * @param pars model parameters
  *
  * @return \f$\Delta_{\mu}\f$
  */
-double delta_mu_correction(const MSSMNoFV_onshell& model)
+double delta_mu_correction(const MSSMNoFV_amu_parameters& pars)
 {
-   return delta_down_lepton_correction(model, 1);
+   return delta_down_lepton_correction(pars, 1);
 }
 
 /**
  * Calculates \f$\Delta_{\tau}\f$ using delta_down_lepton_correction()
  *
- * @param model model parameters
+ * @param pars model parameters
  *
  * @return \f$\Delta_{\tau}\f$
  */
-double delta_tau_correction(const MSSMNoFV_onshell& model)
+double delta_tau_correction(const MSSMNoFV_amu_parameters& pars)
 {
-   return delta_down_lepton_correction(model, 2);
+   return delta_down_lepton_correction(pars, 2);
 }
 
 /**
  * Returns the \f$\Delta_b\f$ corrections from arxiv:0901.2065,
  * Eq (103) and Eqs (31)-(35)
  */
-double delta_bottom_correction(const MSSMNoFV_onshell& model)
+double delta_bottom_correction(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tb = model.get_TB();
-   const double At = model.get_Au(2,2);
-   const double yt = model.get_Yu(2,2);
-   const double gY = model.get_gY();
-   const double g2 = model.get_g2();
-   const double alpha_S = sqr(model.get_g3()) / (4*Pi);
-   const double mu = model.get_Mu();
-   const double M1 = model.get_MassB();
-   const double M2 = model.get_MassWB();
-   const double M3 = model.get_MassG();
-   const double mstL = abs_sqrt(model.get_mq2(2,2));
-   const double mstR = abs_sqrt(model.get_mu2(2,2));
-   const double msbL = abs_sqrt(model.get_mq2(2,2));
-   const double msbR = abs_sqrt(model.get_md2(2,2));
+   const double tb = pars.TB;
+   const double At = pars.Au[2];
+   const double yt = pars.Yu[2];
+   const double gY = pars.gY;
+   const double g2 = pars.g2;
+   const double alpha_S = sqr(pars.g3) / (4*Pi);
+   const double mu = pars.Mu;
+   const double M1 = pars.MassB;
+   const double M2 = pars.MassWB;
+   const double M3 = pars.MassG;
+   const double mstL = abs_sqrt(pars.mq2[2]);
+   const double mstR = abs_sqrt(pars.mu2[2]);
+   const double msbL = abs_sqrt(pars.mq2[2]);
+   const double msbR = abs_sqrt(pars.md2[2]);
 
    // Note:
    // 1/z^2 H_2(x^2/z^2, y^2/z^2) = - Iabc(x,y,z)
@@ -509,4 +520,101 @@ double delta_bottom_correction(const MSSMNoFV_onshell& model)
    return delta_b;
 }
 
+// === overloads for MSSMNoFV_onshell ===
+
+double amu1LChi0(const MSSMNoFV_onshell& model)
+{
+   return amu1LChi0(make_amu_parameters(model));
+}
+
+double amu1LChipm(const MSSMNoFV_onshell& model)
+{
+   return amu1LChipm(make_amu_parameters(model));
+}
+
+Eigen::Array<double,2,1> AAC(const MSSMNoFV_onshell& model)
+{
+   return AAC(make_amu_parameters(model));
+}
+
+Eigen::Array<double,4,2> AAN(const MSSMNoFV_onshell& model)
+{
+   return AAN(make_amu_parameters(model));
+}
+
+Eigen::Array<double,2,1> BBC(const MSSMNoFV_onshell& model)
+{
+   return BBC(make_amu_parameters(model));
+}
+
+Eigen::Array<double,4,2> BBN(const MSSMNoFV_onshell& model)
+{
+   return BBN(make_amu_parameters(model));
+}
+
+Eigen::Array<double,4,2> x_im(const MSSMNoFV_onshell& model)
+{
+   return x_im(make_amu_parameters(model));
+}
+
+Eigen::Array<double,2,1> x_k(const MSSMNoFV_onshell& model)
+{
+   return x_k(make_amu_parameters(model));
+}
+
+double amu1LWHnu(const MSSMNoFV_onshell& model)
+{
+   return amu1LWHnu(make_amu_parameters(model));
+}
+
+double amu1LWHmuL(const MSSMNoFV_onshell& model)
+{
+   return amu1LWHmuL(make_amu_parameters(model));
+}
+
+double amu1LBHmuL(const MSSMNoFV_onshell& model)
+{
+   return amu1LBHmuL(make_amu_parameters(model));
+}
+
+double amu1LBHmuR(const MSSMNoFV_onshell& model)
+{
+   return amu1LBHmuR(make_amu_parameters(model));
+}
+
+double amu1LBmuLmuR(const MSSMNoFV_onshell& model)
+{
+   return amu1LBmuLmuR(make_amu_parameters(model));
+}
+
+double amu1Lapprox_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
+{
+   return amu1Lapprox_non_tan_beta_resummed(make_amu_parameters(model));
+}
+
+double amu1Lapprox(const MSSMNoFV_onshell& model)
+{
+   return amu1Lapprox(make_amu_parameters(model));
+}
+
+double tan_beta_cor(const MSSMNoFV_onshell& model)
+{
+   return tan_beta_cor(make_amu_parameters(model));
+}
+
+double delta_mu_correction(const MSSMNoFV_onshell& model)
+{
+   return delta_mu_correction(make_amu_parameters(model));
+}
+
+double delta_tau_correction(const MSSMNoFV_onshell& model)
+{
+   return delta_tau_correction(make_amu_parameters(model));
+}
+
+double delta_bottom_correction(const MSSMNoFV_onshell& model)
+{
+   return delta_bottom_correction(make_amu_parameters(model));
+}
+
 } // namespace gm2calc
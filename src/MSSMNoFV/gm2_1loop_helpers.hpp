@@ -24,6 +24,7 @@
 namespace gm2calc {
 
 class MSSMNoFV_onshell;
+struct MSSMNoFV_amu_parameters;
 
 // === 1-loop approximations ===
 
@@ -31,42 +32,59 @@ class MSSMNoFV_onshell;
 
 /// 1-loop leading log approximation
 double amu1Lapprox(const MSSMNoFV_onshell&);
+double amu1Lapprox(const MSSMNoFV_amu_parameters&);
 
 /// 1-loop leading log approximation w/o explicit tan(beta) resummation
 double amu1Lapprox_non_tan_beta_resummed(const MSSMNoFV_onshell&);
+double amu1Lapprox_non_tan_beta_resummed(const MSSMNoFV_amu_parameters&);
 
 // routines for individual 1-loop contributions for approximations
 
 /// 1-loop wino--Higgsino, muon-sneutrino leading log approximation
 double amu1LWHnu(const MSSMNoFV_onshell&);
+double amu1LWHnu(const MSSMNoFV_amu_parameters&);
 /// 1-loop wino--Higgsino, left-handed smuon leading log approximation
 double amu1LWHmuL(const MSSMNoFV_onshell&);
+double amu1LWHmuL(const MSSMNoFV_amu_parameters&);
 /// 1-loop bino--Higgsino, left-handed smuon leading log approximation
 double amu1LBHmuL(const MSSMNoFV_onshell&);
+double amu1LBHmuL(const MSSMNoFV_amu_parameters&);
 /// 1-loop bino--Higgsino, right-handed smuon leading log approximation
 double amu1LBHmuR(const MSSMNoFV_onshell&);
+double amu1LBHmuR(const MSSMNoFV_amu_parameters&);
 /// 1-loop bino, left-handed smuon--right-handed smuon leading log approximation
 double amu1LBmuLmuR(const MSSMNoFV_onshell&);
+double amu1LBmuLmuR(const MSSMNoFV_amu_parameters&);
 
 // === resummations ===
 
 double delta_mu_correction(const MSSMNoFV_onshell&);
+double delta_mu_correction(const MSSMNoFV_amu_parameters&);
 double delta_tau_correction(const MSSMNoFV_onshell&);
+double delta_tau_correction(const MSSMNoFV_amu_parameters&);
 double delta_bottom_correction(const MSSMNoFV_onshell&);
+double delta_bottom_correction(const MSSMNoFV_amu_parameters&);
 
 double tan_beta_cor(const MSSMNoFV_onshell&);
+double tan_beta_cor(const MSSMNoFV_amu_parameters&);
 
 // === couplings ===
 
 Eigen::Array<double,2,1> AAC(const MSSMNoFV_onshell&);
+Eigen::Array<double,2,1> AAC(const MSSMNoFV_amu_parameters&);
 Eigen::Array<double,4,2> AAN(const MSSMNoFV_onshell&);
+Eigen::Array<double,4,2> AAN(const MSSMNoFV_amu_parameters&);
 Eigen::Array<double,2,1> BBC(const MSSMNoFV_onshell&);
+Eigen::Array<double,2,1> BBC(const MSSMNoFV_amu_parameters&);
 Eigen::Array<double,4,2> BBN(const MSSMNoFV_onshell&);
+Eigen::Array<double,4,2> BBN(const MSSMNoFV_amu_parameters&);
 
 /// squared neutralino smuon mass ratio
 Eigen::Array<double,4,2> x_im(const MSSMNoFV_onshell&);
+Eigen::Array<double,4,2> x_im(const MSSMNoFV_amu_parameters&);
 /// squared chargino muon-sneutrino mass ratio
 Eigen::Array<double,2,1> x_k(const MSSMNoFV_onshell&);
+Eigen::Array<double,2,1> x_k(const MSSMNoFV_amu_parameters&);
 
 } // namespace gm2calc
 
@@ -17,10 +17,12 @@
 // ====================================================================
 
 #include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/MSSMNoFV_amu_parameters.hpp"
 #include "gm2calc/MSSMNoFV_onshell.hpp"
 
 #include "MSSMNoFV/gm2_2loop_helpers.hpp"
 #include "MSSMNoFV/gm2_1loop_helpers.hpp"
+#include "MSSMNoFV/gm2_amu_parameters_helpers.hpp"
 #include "gm2_ffunctions.hpp"
 #include "gm2_numerics.hpp"
 
@@ -44,41 +46,41 @@ const double root2 = 1.414213562373095; // Sqrt[2]
 /**
  * Calculates 1st line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LWHnu(const MSSMNoFV_onshell& model, double delta_g2, double delta_yuk, double delta_tb)
+double amu2LWHnu(const MSSMNoFV_amu_parameters& pars, double delta_g2, double delta_yuk, double delta_tb)
 {
-   return amu1LWHnu(model) * (0.015 + delta_g2 + delta_yuk + delta_tb);
+   return amu1LWHnu(pars) * (0.015 + delta_g2 + delta_yuk + delta_tb);
 }
 
 /**
  * Calculates 2nd line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LWHmuL(const MSSMNoFV_onshell& model, double delta_g2, double delta_yuk, double delta_tb)
+double amu2LWHmuL(const MSSMNoFV_amu_parameters& pars, double delta_g2, double delta_yuk, double delta_tb)
 {
-   return amu1LWHmuL(model) * (0.015 + delta_g2 + delta_yuk + delta_tb);
+   return amu1LWHmuL(pars) * (0.015 + delta_g2 + delta_yuk + delta_tb);
 }
 
 /**
  * Calculates 3rd line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LBHmuL(const MSSMNoFV_onshell& model, double delta_g1, double delta_yuk, double delta_tb)
+double amu2LBHmuL(const MSSMNoFV_amu_parameters& pars, double delta_g1, double delta_yuk, double delta_tb)
 {
-   return amu1LBHmuL(model) * (0.015 + delta_g1 + delta_yuk + delta_tb);
+   return amu1LBHmuL(pars) * (0.015 + delta_g1 + delta_yuk + delta_tb);
 }
 
 /**
  * Calculates 4th line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LBHmuR(const MSSMNoFV_onshell& model, double delta_g1, double delta_yuk, double delta_tb)
+double amu2LBHmuR(const MSSMNoFV_amu_parameters& pars, double delta_g1, double delta_yuk, double delta_tb)
 {
-   return amu1LBHmuR(model) * (0.04 + delta_g1 + delta_yuk + delta_tb);
+   return amu1LBHmuR(pars) * (0.04 + delta_g1 + delta_yuk + delta_tb);
 }
 
 /**
  * Calculates 5th line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LBmuLmuR(const MSSMNoFV_onshell& model, double delta_g1, double delta_tb)
+double amu2LBmuLmuR(const MSSMNoFV_amu_parameters& pars, double delta_g1, double delta_tb)
 {
-   return amu1LBmuLmuR(model) * (0.03 + delta_g1 + delta_tb);
+   return amu1LBmuLmuR(pars) * (0.03 + delta_g1 + delta_tb);
 }
 
 } // anonymous namespace
@@ -97,11 +99,13 @@ double calculate_amu_2loop_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
    MSSMNoFV_onshell model_ytree(model);
    model_ytree.convert_to_non_tan_beta_resummed();
 
-   return amu2LFSfapprox_non_tan_beta_resummed(model_ytree)
-      + amu2LChipmPhotonic(model_ytree)
-      + amu2LChi0Photonic(model_ytree)
-      + amu2LaSferm(model_ytree)
-      + amu2LaCha(model_ytree);
+   const auto pars = make_amu_parameters(model_ytree);
+
+   return amu2LFSfapprox_non_tan_beta_resummed(pars)
+      + amu2LChipmPhotonic(pars)
+      + amu2LChi0Photonic(pars)
+      + amu2LaSferm(pars)
+      + amu2LaCha(pars);
 }
 
 /**
@@ -110,11 +114,20 @@ double calculate_amu_2loop_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
  */
 double calculate_amu_2loop(const MSSMNoFV_onshell& model)
 {
-   return amu2LFSfapprox(model)
-      + amu2LChipmPhotonic(model)
-      + amu2LChi0Photonic(model)
-      + amu2LaSferm(model)
-      + amu2LaCha(model);
+   return calculate_amu_2loop(make_amu_parameters(model));
+}
+
+/**
+ * Calculates best 2-loop SUSY contribution to a_mu with tan(beta)
+ * resummation.
+ */
+double calculate_amu_2loop(const MSSMNoFV_amu_parameters& pars)
+{
+   return amu2LFSfapprox(pars)
+      + amu2LChipmPhotonic(pars)
+      + amu2LChi0Photonic(pars)
+      + amu2LaSferm(pars)
+      + amu2LaCha(pars);
 }
 
 // fermion/sfermion corrections, log-approximations
@@ -123,13 +136,13 @@ double calculate_amu_2loop(const MSSMNoFV_onshell& model)
  * Calculates \f$m_{SUSY}\f$, p.37 arxiv:1311.1775.
  * Finds minimum of special masses to normalize logarithms.
  */
-double log_scale(const MSSMNoFV_onshell& model)
+double log_scale(const MSSMNoFV_amu_parameters& pars)
 {
-   return std::fmin(std::abs(model.get_MassB()),
-           std::fmin(std::abs(model.get_MassWB()),
-            std::fmin(std::abs(model.get_Mu()),
-             std::fmin(std::sqrt(model.get_me2(1, 1)),
-              std::sqrt(model.get_ml2(1, 1))))));
+   return std::fmin(std::abs(pars.MassB),
+           std::fmin(std::abs(pars.MassWB),
+            std::fmin(std::abs(pars.Mu),
+             std::fmin(std::sqrt(pars.me2[1]),
+              std::sqrt(pars.ml2[1])))));
 }
 
 /**
@@ -138,72 +151,72 @@ double log_scale(const MSSMNoFV_onshell& model)
  * Contributions from 1st and 2nd generation sleptons have been
  * included in addition.
  */
-double delta_g1(const MSSMNoFV_onshell& model)
+double delta_g1(const MSSMNoFV_amu_parameters& pars)
 {
-   const double gY = model.get_gY();
-   const Eigen::Matrix<double,3,3>& mu2(model.get_mu2());
-   const Eigen::Matrix<double,3,3>& md2(model.get_md2());
-   const Eigen::Matrix<double,3,3>& mq2(model.get_mq2());
-   const Eigen::Matrix<double,3,3>& me2(model.get_me2());
-   const Eigen::Matrix<double,3,3>& ml2(model.get_ml2());
-   const double logscale = log_scale(model);
+   const double gY = pars.gY;
+   const Eigen::Array<double,3,1> mu2(to_array(pars.mu2));
+   const Eigen::Array<double,3,1> md2(to_array(pars.md2));
+   const Eigen::Array<double,3,1> mq2(to_array(pars.mq2));
+   const Eigen::Array<double,3,1> me2(to_array(pars.me2));
+   const Eigen::Array<double,3,1> ml2(to_array(pars.ml2));
+   const double logscale = log_scale(pars);
 
    return sqr(gY) * oneOver16PiSqr * 4. / 3. *
-          (4. / 3. * std::log(std::sqrt(mu2(0, 0)) / logscale) +
-           4. / 3. * std::log(std::sqrt(mu2(1, 1)) / logscale) +
-           4. / 3. * std::log(std::sqrt(mu2(2, 2)) / logscale) +
-           1. / 3. * std::log(std::sqrt(md2(0, 0)) / logscale) +
-           1. / 3. * std::log(std::sqrt(md2(1, 1)) / logscale) +
-           1. / 3. * std::log(std::sqrt(md2(2, 2)) / logscale) +
-           1. / 6. * std::log(std::sqrt(mq2(0, 0)) / logscale) +
-           1. / 6. * std::log(std::sqrt(mq2(1, 1)) / logscale) +
-           1. / 6. * std::log(std::sqrt(mq2(2, 2)) / logscale) +
-           std::log(std::sqrt(me2(0, 0)) / logscale) +
-           std::log(std::sqrt(me2(1, 1)) / logscale) +
-           std::log(std::sqrt(me2(2, 2)) / logscale) +
-           0.5 * std::log(std::sqrt(ml2(0, 0)) / logscale) +
-           0.5 * std::log(std::sqrt(ml2(1, 1)) / logscale) +
-           0.5 * std::log(std::sqrt(ml2(2, 2)) / logscale));
+          (4. / 3. * std::log(std::sqrt(mu2(0)) / logscale) +
+           4. / 3. * std::log(std::sqrt(mu2(1)) / logscale) +
+           4. / 3. * std::log(std::sqrt(mu2(2)) / logscale) +
+           1. / 3. * std::log(std::sqrt(md2(0)) / logscale) +
+           1. / 3. * std::log(std::sqrt(md2(1)) / logscale) +
+           1. / 3. * std::log(std::sqrt(md2(2)) / logscale) +
+           1. / 6. * std::log(std::sqrt(mq2(0)) / logscale) +
+           1. / 6. * std::log(std::sqrt(mq2(1)) / logscale) +
+           1. / 6. * std::log(std::sqrt(mq2(2)) / logscale) +
+           std::log(std::sqrt(me2(0)) / logscale) +
+           std::log(std::sqrt(me2(1)) / logscale) +
+           std::log(std::sqrt(me2(2)) / logscale) +
+           0.5 * std::log(std::sqrt(ml2(0)) / logscale) +
+           0.5 * std::log(std::sqrt(ml2(1)) / logscale) +
+           0.5 * std::log(std::sqrt(ml2(2)) / logscale));
 }
 
 /**
  * Calculates \f$\Delta_{\tilde{H}}\f$, Eq (6.6c) arxiv:1311.1775.
  */
-double delta_yuk_higgsino(const MSSMNoFV_onshell& model)
+double delta_yuk_higgsino(const MSSMNoFV_amu_parameters& pars)
 {
-   const double ytau = model.get_Ye(2, 2);
-   const double ytop = model.get_Yu(2, 2);
-   const double ybot = model.get_Yd(2, 2);
-   const Eigen::Matrix<double,3,3>& mu2(model.get_mu2());
-   const Eigen::Matrix<double,3,3>& md2(model.get_md2());
-   const Eigen::Matrix<double,3,3>& mq2(model.get_mq2());
-   const Eigen::Matrix<double,3,3>& me2(model.get_me2());
-   const Eigen::Matrix<double,3,3>& ml2(model.get_ml2());
-   const double logscale = log_scale(model);
+   const double ytau = pars.Ye[2];
+   const double ytop = pars.Yu[2];
+   const double ybot = pars.Yd[2];
+   const Eigen::Array<double,3,1> mu2(to_array(pars.mu2));
+   const Eigen::Array<double,3,1> md2(to_array(pars.md2));
+   const Eigen::Array<double,3,1> mq2(to_array(pars.mq2));
+   const Eigen::Array<double,3,1> me2(to_array(pars.me2));
+   const Eigen::Array<double,3,1> ml2(to_array(pars.ml2));
+   const double logscale = log_scale(pars);
 
    return oneOver16PiSqr * 0.5 *
-          (3 * sqr(ytop) * std::log(std::sqrt(mu2(2, 2)) / logscale) +
-           3 * sqr(ybot) * std::log(std::sqrt(md2(2, 2)) / logscale) +
+          (3 * sqr(ytop) * std::log(std::sqrt(mu2(2)) / logscale) +
+           3 * sqr(ybot) * std::log(std::sqrt(md2(2)) / logscale) +
            3 * (sqr(ytop) + sqr(ybot)) *
-              std::log(std::sqrt(mq2(2, 2)) / logscale) +
-           sqr(ytau) * (std::log(std::sqrt(me2(2, 2)) / logscale) +
-                        std::log(std::sqrt(ml2(2, 2)) / logscale)));
+              std::log(std::sqrt(mq2(2)) / logscale) +
+           sqr(ytau) * (std::log(std::sqrt(me2(2)) / logscale) +
+                        std::log(std::sqrt(ml2(2)) / logscale)));
 }
 
 /**
  * Calculates \f$\Delta_{\tilde{B}\tilde{H}}\f$, Eq (6.6d)
  * arxiv:1311.1775.
  */
-double delta_yuk_bino_higgsino(const MSSMNoFV_onshell& model)
+double delta_yuk_bino_higgsino(const MSSMNoFV_amu_parameters& pars)
 {
-   const double ytop = model.get_Yu(2, 2);
-   const Eigen::Matrix<double,3,3>& mu2(model.get_mu2());
-   const Eigen::Matrix<double,3,3>& mq2(model.get_mq2());
-   const double logscale = log_scale(model);
+   const double ytop = pars.Yu[2];
+   const Eigen::Array<double,3,1> mu2(to_array(pars.mu2));
+   const Eigen::Array<double,3,1> mq2(to_array(pars.mq2));
+   const double logscale = log_scale(pars);
 
    return oneOver16PiSqr * sqr(ytop) *
-          (-8 * std::log(std::sqrt(mu2(2, 2)) / logscale) +
-            2 * std::log(std::sqrt(mq2(2, 2)) / logscale));
+          (-8 * std::log(std::sqrt(mu2(2)) / logscale) +
+            2 * std::log(std::sqrt(mq2(2)) / logscale));
 }
 
 /**
@@ -212,46 +225,46 @@ double delta_yuk_bino_higgsino(const MSSMNoFV_onshell& model)
  * Contributions from 1st and 2nd generation sleptons have been
  * included in addition.
  */
-double delta_g2(const MSSMNoFV_onshell& model)
+double delta_g2(const MSSMNoFV_amu_parameters& pars)
 {
-   const double g2 = model.get_g2();
-   const Eigen::Matrix<double,3,3>& mq2(model.get_mq2());
-   const Eigen::Matrix<double,3,3>& ml2(model.get_ml2());
-   const double logscale = log_scale(model);
+   const double g2 = pars.g2;
+   const Eigen::Array<double,3,1> mq2(to_array(pars.mq2));
+   const Eigen::Array<double,3,1> ml2(to_array(pars.ml2));
+   const double logscale = log_scale(pars);
 
    return sqr(g2) * oneOver16PiSqr * 4. / 3. *
-          (1.5 * std::log(std::sqrt(mq2(0, 0)) / logscale) +
-           1.5 * std::log(std::sqrt(mq2(1, 1)) / logscale) +
-           1.5 * std::log(std::sqrt(mq2(2, 2)) / logscale) +
-           0.5 * std::log(std::sqrt(ml2(0, 0)) / logscale) +
-           0.5 * std::log(std::sqrt(ml2(1, 1)) / logscale) +
-           0.5 * std::log(std::sqrt(ml2(2, 2)) / logscale));
+          (1.5 * std::log(std::sqrt(mq2(0)) / logscale) +
+           1.5 * std::log(std::sqrt(mq2(1)) / logscale) +
+           1.5 * std::log(std::sqrt(mq2(2)) / logscale) +
+           0.5 * std::log(std::sqrt(ml2(0)) / logscale) +
+           0.5 * std::log(std::sqrt(ml2(1)) / logscale) +
+           0.5 * std::log(std::sqrt(ml2(2)) / logscale));
 }
 
 /**
  * Calculates \f$\Delta_{\tilde{W}\tilde{H}}\f$, Eq (6.6e)
  * arxiv:1311.1775.
  */
-double delta_yuk_wino_higgsino(const MSSMNoFV_onshell& model)
+double delta_yuk_wino_higgsino(const MSSMNoFV_amu_parameters& pars)
 {
-   const double ytop = model.get_Yu(2, 2);
-   const Eigen::Matrix<double,3,3>& mq2(model.get_mq2());
-   const double logscale = log_scale(model);
+   const double ytop = pars.Yu[2];
+   const Eigen::Array<double,3,1> mq2(to_array(pars.mq2));
+   const double logscale = log_scale(pars);
 
    return oneOver16PiSqr * (-6) * sqr(ytop) *
-          std::log(std::sqrt(mq2(2, 2)) / logscale);
+          std::log(std::sqrt(mq2(2)) / logscale);
 }
 
 /**
  * Calculates \f$\Delta_{t_\beta}\f$, Eq (6.6f) arxiv:1311.1775.
  */
-double delta_tan_beta(const MSSMNoFV_onshell& model)
+double delta_tan_beta(const MSSMNoFV_amu_parameters& pars)
 {
-   const double ytau = model.get_Ye(2, 2);
-   const double ytop = model.get_Yu(2, 2);
-   const double ybot = model.get_Yd(2, 2);
-   const double logscale = log_scale(model);
-   const double Q = model.get_scale();
+   const double ytau = pars.Ye[2];
+   const double ytop = pars.Yu[2];
+   const double ybot = pars.Yd[2];
+   const double logscale = log_scale(pars);
+   const double Q = pars.scale;
 
    return oneOver16PiSqr * (sqr(ytau) - 3 * sqr(ytop) + 3 * sqr(ybot)) *
           std::log(Q / logscale);
@@ -260,53 +273,53 @@ double delta_tan_beta(const MSSMNoFV_onshell& model)
 /**
  * Calculates 1st line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LWHnu(const MSSMNoFV_onshell& model)
+double amu2LWHnu(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu2LWHnu(model,
-                    delta_g2(model),
-                    delta_yuk_higgsino(model) + delta_yuk_wino_higgsino(model),
-                    delta_tan_beta(model));
+   return amu2LWHnu(pars,
+                    delta_g2(pars),
+                    delta_yuk_higgsino(pars) + delta_yuk_wino_higgsino(pars),
+                    delta_tan_beta(pars));
 }
 
 /**
  * Calculates 2nd line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LWHmuL(const MSSMNoFV_onshell& model)
+double amu2LWHmuL(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu2LWHmuL(model,
-                     delta_g2(model),
-                     delta_yuk_higgsino(model) + delta_yuk_wino_higgsino(model),
-                     delta_tan_beta(model));
+   return amu2LWHmuL(pars,
+                     delta_g2(pars),
+                     delta_yuk_higgsino(pars) + delta_yuk_wino_higgsino(pars),
+                     delta_tan_beta(pars));
 }
 
 /**
  * Calculates 3rd line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LBHmuL(const MSSMNoFV_onshell& model)
+double amu2LBHmuL(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu2LBHmuL(model,
-                     delta_g1(model),
-                     delta_yuk_higgsino(model) + delta_yuk_bino_higgsino(model),
-                     delta_tan_beta(model));
+   return amu2LBHmuL(pars,
+                     delta_g1(pars),
+                     delta_yuk_higgsino(pars) + delta_yuk_bino_higgsino(pars),
+                     delta_tan_beta(pars));
 }
 
 /**
  * Calculates 4th line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LBHmuR(const MSSMNoFV_onshell& model)
+double amu2LBHmuR(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu2LBHmuR(model,
-                     delta_g1(model),
-                     delta_yuk_higgsino(model) + delta_yuk_bino_higgsino(model),
-                     delta_tan_beta(model));
+   return amu2LBHmuR(pars,
+                     delta_g1(pars),
+                     delta_yuk_higgsino(pars) + delta_yuk_bino_higgsino(pars),
+                     delta_tan_beta(pars));
 }
 
 /**
  * Calculates 5th line of Eq (6.5) arxiv:1311.1775.
  */
-double amu2LBmuLmuR(const MSSMNoFV_onshell& model)
+double amu2LBmuLmuR(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu2LBmuLmuR(model, delta_g1(model), delta_tan_beta(model));
+   return amu2LBmuLmuR(pars, delta_g1(pars), delta_tan_beta(pars));
 }
 
 /**
@@ -315,19 +328,19 @@ double amu2LBmuLmuR(const MSSMNoFV_onshell& model)
  *
  * No tan(beta) resummation
  */
-double amu2LFSfapprox_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
+double amu2LFSfapprox_non_tan_beta_resummed(const MSSMNoFV_amu_parameters& pars)
 {
-   const double dg1 = delta_g1(model);
-   const double dg2 = delta_g2(model);
-   const double dyb = delta_yuk_higgsino(model) + delta_yuk_bino_higgsino(model);
-   const double dyw = delta_yuk_higgsino(model) + delta_yuk_wino_higgsino(model);
-   const double dtb = delta_tan_beta(model);
-
-   return amu2LWHnu(model, dg2, dyw, dtb)
-        + amu2LWHmuL(model, dg2, dyw, dtb)
-        + amu2LBHmuL(model, dg1, dyb, dtb)
-        + amu2LBHmuR(model, dg1, dyb, dtb)
-        + amu2LBmuLmuR(model, dg1, dtb);
+   const double dg1 = delta_g1(pars);
+   const double dg2 = delta_g2(pars);
+   const double dyb = delta_yuk_higgsino(pars) + delta_yuk_bino_higgsino(pars);
+   const double dyw = delta_yuk_higgsino(pars) + delta_yuk_wino_higgsino(pars);
+   const double dtb = delta_tan_beta(pars);
+
+   return amu2LWHnu(pars, dg2, dyw, dtb)
+        + amu2LWHmuL(pars, dg2, dyw, dtb)
+        + amu2LBHmuL(pars, dg1, dyb, dtb)
+        + amu2LBHmuR(pars, dg1, dyb, dtb)
+        + amu2LBmuLmuR(pars, dg1, dtb);
 }
 
 /**
@@ -336,9 +349,9 @@ double amu2LFSfapprox_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
  *
  * Includes tan(beta) resummation
  */
-double amu2LFSfapprox(const MSSMNoFV_onshell& model)
+double amu2LFSfapprox(const MSSMNoFV_amu_parameters& pars)
 {
-   return amu2LFSfapprox_non_tan_beta_resummed(model) * tan_beta_cor(model);
+   return amu2LFSfapprox_non_tan_beta_resummed(pars) * tan_beta_cor(pars);
 }
 
 // === photonic 2-loop corrections ===
@@ -347,15 +360,15 @@ double amu2LFSfapprox(const MSSMNoFV_onshell& model)
  * Calculates the photonic 2-loop contribution to the 1-loop chargino
  * diagram, Eq (35) arXiv:1003.5820.
  */
-double amu2LChipmPhotonic(const MSSMNoFV_onshell& model)
+double amu2LChipmPhotonic(const MSSMNoFV_amu_parameters& pars)
 {
-   const double mm = model.get_MM();
-   const Eigen::Array<double,2,1> AAC_(AAC(model));
-   const Eigen::Array<double,2,1> BBC_(BBC(model));
-   const Eigen::Array<double,2,1>& MCha(model.get_MCha());
-   const double MSvmL = model.get_MSvmL();
-   const Eigen::Array<double,2,1> x(x_k(model));
-   const double Q = model.get_scale();
+   const double mm = pars.MM;
+   const Eigen::Array<double,2,1> AAC_(AAC(pars));
+   const Eigen::Array<double,2,1> BBC_(BBC(pars));
+   const Eigen::Array<double,2,1> MCha(to_array(pars.MCha));
+   const double MSvmL = pars.MSvmL;
+   const Eigen::Array<double,2,1> x(x_k(pars));
+   const double Q = pars.scale;
    const double x_mv = mm / MSvmL;
    const double log_x_mv = std::log(x_mv);
    const double log_x_vq = std::log(MSvmL / Q);
@@ -373,22 +386,22 @@ double amu2LChipmPhotonic(const MSSMNoFV_onshell& model)
          - (AAC_(k)*f1c + 2*BBC_(k)*y*f2c)*log_x_vq;
    }
 
-   return sqr(model.get_EL0() * oneOver16PiSqr * x_mv) * result;
+   return sqr(pars.EL0 * oneOver16PiSqr * x_mv) * result;
 }
 
 /**
  * Calculates the photonic 2-loop contribution to the 1-loop
  * neutralino diagram, Eq (36) arXiv:1003.5820.
  */
-double amu2LChi0Photonic(const MSSMNoFV_onshell& model)
+double amu2LChi0Photonic(const MSSMNoFV_amu_parameters& pars)
 {
-   const double mm = model.get_MM();
-   const Eigen::Matrix<double,4,2> AAN_(AAN(model));
-   const Eigen::Matrix<double,4,2> BBN_(BBN(model));
-   const Eigen::Array<double,4,1>& MNeu(model.get_MChi());
-   const Eigen::Array<double,2,1>& MSmu(model.get_MSm());
-   const Eigen::Matrix<double,4,2> x(x_im(model));
-   const double Q = model.get_scale();
+   const double mm = pars.MM;
+   const Eigen::Matrix<double,4,2> AAN_(AAN(pars));
+   const Eigen::Matrix<double,4,2> BBN_(BBN(pars));
+   const Eigen::Array<double,4,1> MNeu(to_array(pars.MChi));
+   const Eigen::Array<double,2,1> MSmu(to_array(pars.MSm));
+   const Eigen::Matrix<double,4,2> x(x_im(pars));
+   const double Q = pars.scale;
    const Eigen::Array<double,2,1> log_x_mm((MSmu / mm).log());
    const Eigen::Array<double,2,1> log_x_mq((MSmu / Q).log());
 
@@ -408,7 +421,7 @@ double amu2LChi0Photonic(const MSSMNoFV_onshell& model)
       }
    }
 
-   return sqr(model.get_EL0() * oneOver16PiSqr * mm) * result;
+   return sqr(pars.EL0 * oneOver16PiSqr * mm) * result;
 }
 
 // ==== amu2Loop_a corrections ====
@@ -423,11 +436,11 @@ double amu2LChi0Photonic(const MSSMNoFV_onshell& model)
  *
  * @note the result is < 0
  */
-double tan_alpha(const MSSMNoFV_onshell& model)
+double tan_alpha(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tb = model.get_TB();
-   const double mz = model.get_MZ();
-   const double ma = model.get_MA0();
+   const double tb = pars.TB;
+   const double mz = pars.MZ;
+   const double ma = pars.MA0;
    const double tan2beta = 2*tb/(1 - sqr(tb));
    const double tan2alpha = tan2beta * (sqr(ma) + sqr(mz)) / (sqr(ma) - sqr(mz));
 
@@ -444,22 +457,22 @@ double tan_alpha(const MSSMNoFV_onshell& model)
  *
  * includes tan(beta) resummation
  */
-Eigen::Matrix<std::complex<double>,3,3> lambda_mu_cha(const MSSMNoFV_onshell& model)
+Eigen::Matrix<std::complex<double>,3,3> lambda_mu_cha(const MSSMNoFV_amu_parameters& pars)
 {
-   const Eigen::Array<double,2,1>& MCha(model.get_MCha());
-   const double mw = model.get_MW();
-   const double tb = model.get_TB();
+   const Eigen::Array<double,2,1> MCha(to_array(pars.MCha));
+   const double mw = pars.MW;
+   const double tb = pars.TB;
    const double rtb = std::sqrt(1 + sqr(tb));
    const double cb = 1/rtb;
    const double sb = tb/rtb;
-   const double ta = tan_alpha(model);
+   const double ta = tan_alpha(pars);
    const double rta = std::sqrt(1 + sqr(ta));
    const double ca = 1/rta;
    const double sa = ta/rta;
-   const Eigen::Matrix<std::complex<double>,2,2>& U(model.get_UM());
-   const Eigen::Matrix<std::complex<double>,2,2>& V(model.get_UP());
-   const double one_over_cb_eff = root2 * model.get_Ye(1,1)
-      * mw / (model.get_MM() * model.get_g2());
+   const Eigen::Matrix<std::complex<double>,2,2> U(to_matrix<2>(pars.UM));
+   const Eigen::Matrix<std::complex<double>,2,2> V(to_matrix<2>(pars.UP));
+   const double one_over_cb_eff = root2 * pars.Ye[1]
+      * mw / (pars.MM * pars.g2);
 
    Eigen::Matrix<std::complex<double>,3,3> result;
 
@@ -483,20 +496,20 @@ Eigen::Matrix<std::complex<double>,3,3> lambda_mu_cha(const MSSMNoFV_onshell& mo
  * Calculates \f$\lambda_{\tilde{t}_i}\f$, Eq (67)
  * arXiv:hep-ph/0609168
  */
-Eigen::Matrix<std::complex<double>,2,2> lambda_stop(const MSSMNoFV_onshell& model)
+Eigen::Matrix<std::complex<double>,2,2> lambda_stop(const MSSMNoFV_amu_parameters& pars)
 {
-   const double tb = model.get_TB();
+   const double tb = pars.TB;
    const double rtb = std::sqrt(1 + sqr(tb));
    const double sb = tb/rtb;
-   const double ta = tan_alpha(model);
+   const double ta = tan_alpha(pars);
    const double rta = std::sqrt(1 + sqr(ta));
    const double ca = 1/rta;
    const double sa = ta/rta;
-   const double mt = model.get_MT();
-   const Eigen::Array<double,2,1>& m_stop(model.get_MSt());
-   const Eigen::Matrix<double,2,2>& u_stop(model.get_USt());
-   const double At = model.get_Au(2, 2);
-   const double mu = model.get_Mu();
+   const double mt = pars.MT;
+   const Eigen::Array<double,2,1> m_stop(to_array(pars.MSt));
+   const Eigen::Matrix<double,2,2> u_stop(to_matrix<2>(pars.USt));
+   const double At = pars.Au[2];
+   const double mu = pars.Mu;
 
    Eigen::Matrix<std::complex<double>,2,2> result;
 
@@ -517,18 +530,18 @@ Eigen::Matrix<std::complex<double>,2,2> lambda_stop(const MSSMNoFV_onshell& mode
  *
  * includes tan(beta) resummation
  */
-Eigen::Matrix<std::complex<double>,2,2> lambda_sbot(const MSSMNoFV_onshell& model)
+Eigen::Matrix<std::complex<double>,2,2> lambda_sbot(const MSSMNoFV_amu_parameters& pars)
 {
-   const double ta = tan_alpha(model);
+   const double ta = tan_alpha(pars);
    const double rta = std::sqrt(1 + sqr(ta));
    const double ca = 1/rta;
    const double sa = ta/rta;
-   const Eigen::Array<double,2,1>& m_sbot(model.get_MSb());
-   const Eigen::Matrix<double,2,2>& u_sbot(model.get_USb());
-   const double Ab = model.get_Ad(2, 2);
-   const double mu = model.get_Mu();
-   const double mb_over_cb_eff = root2 * model.get_Yd(2,2)
-      * model.get_MW() / model.get_g2();
+   const Eigen::Array<double,2,1> m_sbot(to_array(pars.MSb));
+   const Eigen::Matrix<double,2,2> u_sbot(to_matrix<2>(pars.USb));
+   const double Ab = pars.Ad[2];
+   const double mu = pars.Mu;
+   const double mb_over_cb_eff = root2 * pars.Yd[2]
+      * pars.MW / pars.g2;
 
    Eigen::Matrix<std::complex<double>,2,2> result;
 
@@ -549,18 +562,18 @@ Eigen::Matrix<std::complex<double>,2,2> lambda_sbot(const MSSMNoFV_onshell& mode
  *
  * includes tan(beta) resummation
  */
-Eigen::Matrix<std::complex<double>,2,2> lambda_stau(const MSSMNoFV_onshell& model)
+Eigen::Matrix<std::complex<double>,2,2> lambda_stau(const MSSMNoFV_amu_parameters& pars)
 {
-   const double ta = tan_alpha(model);
+   const double ta = tan_alpha(pars);
    const double rta = std::sqrt(1 + sqr(ta));
    const double ca = 1/rta;
    const double sa = ta/rta;
-   const Eigen::Array<double,2,1>& m_stau(model.get_MStau());
-   const Eigen::Matrix<double,2,2>& u_stau(model.get_UStau());
-   const double Al = model.get_Ae(2, 2);
-   const double mu = model.get_Mu();
-   const double mtau_over_cb_eff = root2 * model.get_Ye()(2,2)
-      * model.get_MW() / model.get_g2();
+   const Eigen::Array<double,2,1> m_stau(to_array(pars.MStau));
+   const Eigen::Matrix<double,2,2> u_stau(to_matrix<2>(pars.UStau));
+   const double Al = pars.Ae[2];
+   const double mu = pars.Mu;
+   const double mtau_over_cb_eff = root2 * pars.Ye[2]
+      * pars.MW / pars.g2;
 
    Eigen::Matrix<std::complex<double>,2,2> result;
 
@@ -581,22 +594,22 @@ Eigen::Matrix<std::complex<double>,2,2> lambda_stau(const MSSMNoFV_onshell& mode
  * Barr-Zee diagram \f$(\tilde{f}\gamma H)\f$), Eq (64)
  * arXiv:hep-ph/0609168.
  */
-double amu2LaSferm(const MSSMNoFV_onshell& model)
+double amu2LaSferm(const MSSMNoFV_amu_parameters& pars)
 {
-   const double mm = model.get_MM();
-   const double mw = model.get_MW();
-   const double sw = std::sqrt(1. - sqr(mw / model.get_MZ()));
-   const double el = model.get_EL();
-   const Eigen::Array<double,2,1>& m_stop(model.get_MSt());
-   const Eigen::Array<double,2,1>& m_sbot(model.get_MSb());
-   const Eigen::Array<double,2,1>& m_stau(model.get_MStau());
-   const Eigen::Array<double,2,1>& m_higgs(model.get_Mhh());
-   const Eigen::Matrix<std::complex<double>,3,3> lambda(lambda_mu_cha(model));
+   const double mm = pars.MM;
+   const double mw = pars.MW;
+   const double sw = std::sqrt(1. - sqr(mw / pars.MZ));
+   const double el = pars.EL;
+   const Eigen::Array<double,2,1> m_stop(to_array(pars.MSt));
+   const Eigen::Array<double,2,1> m_sbot(to_array(pars.MSb));
+   const Eigen::Array<double,2,1> m_stau(to_array(pars.MStau));
+   const Eigen::Array<double,2,1> m_higgs(to_array(pars.Mhh));
+   const Eigen::Matrix<std::complex<double>,3,3> lambda(lambda_mu_cha(pars));
    const Eigen::Array<std::complex<double>,2,1> lambda_mu(
       (Eigen::Array<std::complex<double>,2,1>() << lambda(2, 0), lambda(2, 1)).finished());
-   const Eigen::Matrix<std::complex<double>,2,2> lambdastop(lambda_stop(model));
-   const Eigen::Matrix<std::complex<double>,2,2> lambdasbot(lambda_sbot(model));
-   const Eigen::Matrix<std::complex<double>,2,2> lambdastau(lambda_stau(model));
+   const Eigen::Matrix<std::complex<double>,2,2> lambdastop(lambda_stop(pars));
+   const Eigen::Matrix<std::complex<double>,2,2> lambdasbot(lambda_sbot(pars));
+   const Eigen::Matrix<std::complex<double>,2,2> lambdastau(lambda_stau(pars));
 
    double result = 0;
 
@@ -632,16 +645,16 @@ double amu2LaSferm(const MSSMNoFV_onshell& model)
  * Barr-Zee diagram \f$(\chi\gamma H)\f$), Eq (63)
  * arXiv:hep-ph/0609168.
  */
-double amu2LaCha(const MSSMNoFV_onshell& model)
+double amu2LaCha(const MSSMNoFV_amu_parameters& pars)
 {
-   const double mm = model.get_MM();
-   const double mw = model.get_MW() ;
-   const double ma = model.get_MA0();
-   const Eigen::Array<double,2,1>& m_higgs(model.get_Mhh());
-   const double sw = std::sqrt(1. - sqr(mw / model.get_MZ()));
-   const double el = model.get_EL();
-   const Eigen::Array<double,2,1>& m_cha(model.get_MCha());
-   const Eigen::Matrix<std::complex<double>,3,3> lambda(lambda_mu_cha(model));
+   const double mm = pars.MM;
+   const double mw = pars.MW ;
+   const double ma = pars.MA0;
+   const Eigen::Array<double,2,1> m_higgs(to_array(pars.Mhh));
+   const double sw = std::sqrt(1. - sqr(mw / pars.MZ));
+   const double el = pars.EL;
+   const Eigen::Array<double,2,1> m_cha(to_array(pars.MCha));
+   const Eigen::Matrix<std::complex<double>,3,3> lambda(lambda_mu_cha(pars));
 
    double result = 0;
 
@@ -656,4 +669,121 @@ double amu2LaCha(const MSSMNoFV_onshell& model)
    return result * 2 * sqr(oneOver16PiSqr * sqr(el) * mm / (mw * sw));
 }
 
+// === overloads for MSSMNoFV_onshell ===
+
+double amu2LWHnu(const MSSMNoFV_onshell& model)
+{
+   return amu2LWHnu(make_amu_parameters(model));
+}
+
+double amu2LWHmuL(const MSSMNoFV_onshell& model)
+{
+   return amu2LWHmuL(make_amu_parameters(model));
+}
+
+double amu2LBHmuL(const MSSMNoFV_onshell& model)
+{
+   return amu2LBHmuL(make_amu_parameters(model));
+}
+
+double amu2LBHmuR(const MSSMNoFV_onshell& model)
+{
+   return amu2LBHmuR(make_amu_parameters(model));
+}
+
+double amu2LBmuLmuR(const MSSMNoFV_onshell& model)
+{
+   return amu2LBmuLmuR(make_amu_parameters(model));
+}
+
+double log_scale(const MSSMNoFV_onshell& model)
+{
+   return log_scale(make_amu_parameters(model));
+}
+
+double delta_g1(const MSSMNoFV_onshell& model)
+{
+   return delta_g1(make_amu_parameters(model));
+}
+
+double delta_g2(const MSSMNoFV_onshell& model)
+{
+   return delta_g2(make_amu_parameters(model));
+}
+
+double delta_yuk_higgsino(const MSSMNoFV_onshell& model)
+{
+   return delta_yuk_higgsino(make_amu_parameters(model));
+}
+
+double delta_yuk_bino_higgsino(const MSSMNoFV_onshell& model)
+{
+   return delta_yuk_bino_higgsino(make_amu_parameters(model));
+}
+
+double delta_yuk_wino_higgsino(const MSSMNoFV_onshell& model)
+{
+   return delta_yuk_wino_higgsino(make_amu_parameters(model));
+}
+
+double delta_tan_beta(const MSSMNoFV_onshell& model)
+{
+   return delta_tan_beta(make_amu_parameters(model));
+}
+
+double amu2LFSfapprox_non_tan_beta_resummed(const MSSMNoFV_onshell& model)
+{
+   return amu2LFSfapprox_non_tan_beta_resummed(make_amu_parameters(model));
+}
+
+double amu2LFSfapprox(const MSSMNoFV_onshell& model)
+{
+   return amu2LFSfapprox(make_amu_parameters(model));
+}
+
+double amu2LChipmPhotonic(const MSSMNoFV_onshell& model)
+{
+   return amu2LChipmPhotonic(make_amu_parameters(model));
+}
+
+double amu2LChi0Photonic(const MSSMNoFV_onshell& model)
+{
+   return amu2LChi0Photonic(make_amu_parameters(model));
+}
+
+double tan_alpha(const MSSMNoFV_onshell& model)
+{
+   return tan_alpha(make_amu_parameters(model));
+}
+
+Eigen::Matrix<std::complex<double>,3,3> lambda_mu_cha(const MSSMNoFV_onshell& model)
+{
+   return lambda_mu_cha(make_amu_parameters(model));
+}
+
+Eigen::Matrix<std::complex<double>,2,2> lambda_stop(const MSSMNoFV_onshell& model)
+{
+   return lambda_stop(make_amu_parameters(model));
+}
+
+Eigen::Matrix<std::complex<double>,2,2> lambda_sbot(const MSSMNoFV_onshell& model)
+{
+   return lambda_sbot(make_amu_parameters(model));
+}
+
+Eigen::Matrix<std::complex<double>,2,2> lambda_stau(const MSSMNoFV_onshell& model)
+{
+   return lambda_stau(make_amu_parameters(model));
+}
+
+double amu2LaSferm(const MSSMNoFV_onshell& model)
+{
+   return amu2LaSferm(make_amu_parameters(model));
+}
+
+double amu2LaCha(const MSSMNoFV_onshell& model)
+{
+   return amu2LaCha(make_amu_parameters(model));
+}
+
 } // namespace gm2calc
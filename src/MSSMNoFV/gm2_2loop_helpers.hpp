@@ -24,6 +24,7 @@
 namespace gm2calc {
 
 class MSSMNoFV_onshell;
+struct MSSMNoFV_amu_parameters;
 
 // === 2-loop fermion/sfermion approximations ===
 
@@ -31,31 +32,48 @@ class MSSMNoFV_onshell;
 // approximations
 
 double amu2LWHnu(const MSSMNoFV_onshell&);
+double amu2LWHnu(const MSSMNoFV_amu_parameters&);
 double amu2LWHmuL(const MSSMNoFV_onshell&);
+double amu2LWHmuL(const MSSMNoFV_amu_parameters&);
 double amu2LBHmuL(const MSSMNoFV_onshell&);
+double amu2LBHmuL(const MSSMNoFV_amu_parameters&);
 double amu2LBHmuR(const MSSMNoFV_onshell&);
+double amu2LBHmuR(const MSSMNoFV_amu_parameters&);
 double amu2LBmuLmuR(const MSSMNoFV_onshell&);
+double amu2LBmuLmuR(const MSSMNoFV_amu_parameters&);
 
 // routines for sub-expressions
 
 double log_scale(const MSSMNoFV_onshell&);
+double log_scale(const MSSMNoFV_amu_parameters&);
 
 double delta_g1(const MSSMNoFV_onshell&);
+double delta_g1(const MSSMNoFV_amu_parameters&);
 double delta_g2(const MSSMNoFV_onshell&);
+double delta_g2(const MSSMNoFV_amu_parameters&);
 double delta_yuk_higgsino(const MSSMNoFV_onshell&);
+double delta_yuk_higgsino(const MSSMNoFV_amu_parameters&);
 double delta_yuk_bino_higgsino(const MSSMNoFV_onshell&);
+double delta_yuk_bino_higgsino(const MSSMNoFV_amu_parameters&);
 double delta_yuk_wino_higgsino(const MSSMNoFV_onshell&);
+double delta_yuk_wino_higgsino(const MSSMNoFV_amu_parameters&);
 double delta_tan_beta(const MSSMNoFV_onshell&);
+double delta_tan_beta(const MSSMNoFV_amu_parameters&);
 
 // === SUSY 2L(a) diagrams ===
 
 // routines for sub-expressions (with tan(beta) resummation)
 
 double tan_alpha(const MSSMNoFV_onshell&);
+double tan_alpha(const MSSMNoFV_amu_parameters&);
 Eigen::Matrix<std::complex<double>,3,3> lambda_mu_cha(const MSSMNoFV_onshell&);
+Eigen::Matrix<std::complex<double>,3,3> lambda_mu_cha(const MSSMNoFV_amu_parameters&);
 Eigen::Matrix<std::complex<double>,2,2> lambda_stop(const MSSMNoFV_onshell&);
+Eigen::Matrix<std::complex<double>,2,2> lambda_stop(const MSSMNoFV_amu_parameters&);
 Eigen::Matrix<std::complex<double>,2,2> lambda_sbot(const MSSMNoFV_onshell&);
+Eigen::Matrix<std::complex<double>,2,2> lambda_sbot(const MSSMNoFV_amu_parameters&);
 Eigen::Matrix<std::complex<double>,2,2> lambda_stau(const MSSMNoFV_onshell&);
+Eigen::Matrix<std::complex<double>,2,2> lambda_stau(const MSSMNoFV_amu_parameters&);
 
 } // namespace gm2calc
 
@@ -0,0 +1,54 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_MSSMNOFV_AMU_PARAMETERS_HELPERS_HPP
+#define GM2_MSSMNOFV_AMU_PARAMETERS_HELPERS_HPP
+
+#include <Eigen/Core>
+#include <cstddef>
+
+namespace gm2calc {
+
+/// converts a plain array of MSSMNoFV_amu_parameters to an Eigen array
+template <typename T, std::size_t N>
+Eigen::Array<T,N,1> to_array(const T (&a)[N])
+{
+   return Eigen::Map<const Eigen::Array<T,N,1>>(a);
+}
+
+/// converts a plain column-major N x N array of MSSMNoFV_amu_parameters to an Eigen matrix
+template <int N, typename T, std::size_t S>
+Eigen::Matrix<T,N,N> to_matrix(const T (&m)[S])
+{
+   static_assert(S == N*N, "array size must be N*N");
+   return Eigen::Map<const Eigen::Matrix<T,N,N>>(m);
+}
+
+/// copies an Eigen array or matrix to a plain array of MSSMNoFV_amu_parameters
+template <typename Derived, typename T, std::size_t S>
+void from_eigen(const Eigen::DenseBase<Derived>& src, T (&dst)[S])
+{
+   static_assert(Derived::SizeAtCompileTime == S, "array sizes must match");
+   using Target = Eigen::Array<T,Derived::RowsAtCompileTime,Derived::ColsAtCompileTime>;
+   Eigen::Map<Target> target(dst);
+   target = src.derived().array();
+}
+
+} // namespace gm2calc
+
+#endif
@@ -0,0 +1,135 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_batch.h"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2_log.hpp"
+#include "gm2_parallel.hpp"
+#include "gm2_uncertainty_helpers.hpp"
+
+#include <algorithm>
+
+namespace gm2calc {
+namespace {
+
+/**
+ * Calculates the masses, amu and its uncertainty of a single point
+ * given in the GM2Calc input scheme.
+ *
+ * @return error code
+ */
+gm2calc_error calculate_amu_gm2calc_scheme_point(
+   ::MSSMNoFV_onshell* ptr, int loop_order, int tan_beta_resummation,
+   double& amu, double& damu) noexcept
+{
+   amu = damu = 0;
+
+   try {
+      auto& model = *reinterpret_cast<MSSMNoFV_onshell*>(ptr);
+      model.calculate_masses();
+
+      if (model.get_problems().have_problem()) {
+         return gm2calc_PhysicalProblem;
+      }
+
+      double amu1L = 0, amu2L = 0;
+
+      if (loop_order > 0) {
+         amu1L = tan_beta_resummation
+            ? calculate_amu_1loop(model)
+            : calculate_amu_1loop_non_tan_beta_resummed(model);
+      }
+      if (loop_order > 1) {
+         amu2L = tan_beta_resummation
+            ? calculate_amu_2loop(model)
+            : calculate_amu_2loop_non_tan_beta_resummed(model);
+      }
+
+      if (loop_order == 0) {
+         damu = calculate_uncertainty_amu_0loop(model, amu1L);
+      } else if (loop_order == 1) {
+         damu = calculate_uncertainty_amu_1loop(model, amu2L);
+      } else if (loop_order > 1) {
+         damu = calculate_uncertainty_amu_2loop(model);
+      }
+
+      amu = amu1L + amu2L;
+   } catch (const EInvalidInput&) {
+      amu = damu = 0;
+      return gm2calc_InvalidInput;
+   } catch (const EPhysicalProblem&) {
+      amu = damu = 0;
+      return gm2calc_PhysicalProblem;
+   } catch (...) {
+      amu = damu = 0;
+      return gm2calc_UnknownError;
+   }
+
+   return gm2calc_NoError;
+}
+
+} // anonymous namespace
+} // namespace gm2calc
+
+extern "C" {
+
+/**
+ * @brief Calculates amu and its uncertainty for a list of MSSMNoFV
+ * points in the GM2Calc input scheme.
+ *
+ * Each model must be filled with the SM and the GM2Calc-scheme input
+ * parameters.  For each point, the masses are calculated as with
+ * gm2calc_mssmnofv_calculate_masses() and the contributions up to
+ * the given loop order are summed.  The points are distributed
+ * dynamically over the threads.  If the calculation fails or the
+ * point has a problem, amu and its uncertainty are set to 0 and the
+ * status contains the error code.
+ *
+ * @param model array of n models (modified)
+ * @param n number of points
+ * @param loop_order loop order (0, 1 or 2)
+ * @param tan_beta_resummation 1 with tan(beta) resummation, 0 without
+ * @param threads number of threads (0 = number of hardware threads)
+ * @param amu array of n values of amu (output)
+ * @param damu array of n uncertainties of amu (output)
+ * @param status array of n error codes (output)
+ */
+void gm2calc_mssmnofv_calculate_amu_gm2calc_scheme_list(
+   MSSMNoFV_onshell** model, size_t n, int loop_order,
+   int tan_beta_resummation, unsigned threads,
+   double* amu, double* damu, gm2calc_error* status)
+{
+   std::fill(status, status + n, gm2calc_UnknownError);
+   std::fill(amu, amu + n, 0.0);
+   std::fill(damu, damu + n, 0.0);
+
+   try {
+      gm2calc::parallel_for(n, threads, [&] (std::size_t i) {
+         status[i] = gm2calc::calculate_amu_gm2calc_scheme_point(
+            model[i], loop_order, tan_beta_resummation, amu[i], damu[i]);
+      });
+   } catch (...) {
+      ERROR("unknown exception thrown");
+   }
+}
+
+} // extern "C"
@@ -0,0 +1,206 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_result_file.hpp"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/MSSMNoFV_amu_parameters.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+
+#include <array>
+#include <limits>
+#include <vector>
+
+/**
+ * \file gm2_result_file.cpp
+ *
+ * Contains the columns of the MSSMNoFV result file.
+ */
+
+namespace gm2calc {
+
+namespace {
+
+/// input parameter column (matrix indices are 1-based, as in SLHA)
+struct Input_column {
+   const char* name;
+   double (*get)(const MSSMNoFV_onshell&);
+};
+
+const Input_column input_columns[] = {
+   {"TB"    , [] (const MSSMNoFV_onshell& m) { return m.get_TB(); }},
+   {"Mu"    , [] (const MSSMNoFV_onshell& m) { return m.get_Mu(); }},
+   {"MassB" , [] (const MSSMNoFV_onshell& m) { return m.get_MassB(); }},
+   {"MassWB", [] (const MSSMNoFV_onshell& m) { return m.get_MassWB(); }},
+   {"MassG" , [] (const MSSMNoFV_onshell& m) { return m.get_MassG(); }},
+   {"MA0"   , [] (const MSSMNoFV_onshell& m) { return m.get_MA0(); }},
+   {"ml2_22", [] (const MSSMNoFV_onshell& m) { return m.get_ml2(1,1); }},
+   {"me2_22", [] (const MSSMNoFV_onshell& m) { return m.get_me2(1,1); }},
+   {"ml2_33", [] (const MSSMNoFV_onshell& m) { return m.get_ml2(2,2); }},
+   {"me2_33", [] (const MSSMNoFV_onshell& m) { return m.get_me2(2,2); }},
+   {"mq2_33", [] (const MSSMNoFV_onshell& m) { return m.get_mq2(2,2); }},
+   {"mu2_33", [] (const MSSMNoFV_onshell& m) { return m.get_mu2(2,2); }},
+   {"md2_33", [] (const MSSMNoFV_onshell& m) { return m.get_md2(2,2); }},
+   {"Ae_22" , [] (const MSSMNoFV_onshell& m) { return m.get_Ae(1,1); }},
+   {"Ae_33" , [] (const MSSMNoFV_onshell& m) { return m.get_Ae(2,2); }},
+   {"Au_33" , [] (const MSSMNoFV_onshell& m) { return m.get_Au(2,2); }},
+   {"Ad_33" , [] (const MSSMNoFV_onshell& m) { return m.get_Ad(2,2); }},
+   {"scale" , [] (const MSSMNoFV_onshell& m) { return m.get_scale(); }},
+};
+
+/// contributions to amu and the uncertainty
+const char* const result_columns[] = {
+   "amu1L", "amu1L_chi0", "amu1L_chipm",
+   "amu2L", "amu2L_photonic_chi0", "amu2L_photonic_chipm",
+   "amu2L_a_sfermion", "amu2L_a_cha", "amu2L_ferm_sferm_approx",
+   "amu", "damu"
+};
+
+constexpr std::size_t number_of_input_columns = sizeof(input_columns) / sizeof(input_columns[0]);
+constexpr std::size_t number_of_result_columns = sizeof(result_columns) / sizeof(result_columns[0]);
+constexpr std::size_t number_of_columns = number_of_input_columns + number_of_result_columns + 2;
+
+using Results = std::array<double, number_of_result_columns>;
+
+/// calculates the contributions in the order of result_columns
+Results calculate_results(const MSSMNoFV_onshell& model)
+{
+   const auto pars = make_amu_parameters(model);
+   const double amu_1l = calculate_amu_1loop(pars);
+   const double amu_2l = calculate_amu_2loop(pars);
+
+   return Results{
+      amu_1l, amu1LChi0(pars), amu1LChipm(pars),
+      amu_2l, amu2LChi0Photonic(pars), amu2LChipmPhotonic(pars),
+      amu2LaSferm(pars), amu2LaCha(pars), amu2LFSfapprox(pars),
+      amu_1l + amu_2l, calculate_uncertainty_amu_2loop(pars)
+   };
+}
+
+std::uint64_t get_problem_flags(const MSSMNoFV_onshell& model)
+{
+   std::uint64_t flags = 0;
+
+   if (model.get_problems().have_tachyon()) {
+      flags |= Result_problem_tachyon;
+   }
+
+   return flags;
+}
+
+std::uint64_t get_warning_flags(const MSSMNoFV_onshell& model)
+{
+   const auto& problems = model.get_problems();
+   std::uint64_t flags = 0;
+
+   if (problems.no_Mu_MassB_MassWB_convergence()) {
+      flags |= Result_warning_no_convergence_Mu_MassB_MassWB;
+   }
+   if (problems.no_me2_convergence()) {
+      flags |= Result_warning_no_convergence_me2;
+   }
+   if (problems.conversion_cancelled()) {
+      flags |= Result_warning_conversion_cancelled;
+   }
+
+   return flags;
+}
+
+} // anonymous namespace
+
+/**
+ * Returns the columns written by write_result(): the input
+ * parameters, the 1- and 2-loop contributions to amu, the sum amu =
+ * amu1L + amu2L, its uncertainty damu and the problem and warning
+ * flags.
+ *
+ * @return columns
+ */
+std::vector<Result_column> get_mssmnofv_result_columns()
+{
+   std::vector<Result_column> columns;
+   columns.reserve(number_of_columns);
+
+   for (const auto& c: input_columns) {
+      columns.push_back({c.name, Result_column::Float64});
+   }
+   for (const auto& c: result_columns) {
+      columns.push_back({c, Result_column::Float64});
+   }
+
+   columns.push_back({"problems", Result_column::UInt64});
+   columns.push_back({"warnings", Result_column::UInt64});
+
+   return columns;
+}
+
+/**
+ * Calculates the contributions to amu and returns the input
+ * parameters and the results as a row with the columns returned by
+ * get_mssmnofv_result_columns().  If the calculation fails, the
+ * results are set to NaN and the flag Result_problem_error is set.
+ *
+ * @param model model (must be initialized)
+ *
+ * @return row
+ */
+std::vector<Result_value> make_result_row(const MSSMNoFV_onshell& model)
+{
+   std::vector<Result_value> row(number_of_columns);
+   std::size_t i = 0;
+   std::uint64_t problems = get_problem_flags(model);
+
+   for (const auto& c: input_columns) {
+      row[i++] = c.get(model);
+   }
+
+   Results results;
+
+   try {
+      results = calculate_results(model);
+   } catch (const Error&) {
+      results.fill(std::numeric_limits<double>::quiet_NaN());
+      problems |= Result_problem_error;
+   }
+
+   for (const auto r: results) {
+      row[i++] = r;
+   }
+
+   row[i++] = problems;
+   row[i++] = get_warning_flags(model);
+
+   return row;
+}
+
+/**
+ * Calculates the contributions to amu and appends the input
+ * parameters and the results as a row to the result file.
+ *
+ * @param writer result file writer with the columns returned by
+ * get_mssmnofv_result_columns()
+ * @param model model (must be initialized)
+ */
+void write_result(Result_file_writer& writer, const MSSMNoFV_onshell& model)
+{
+   writer.write_row(make_result_row(model));
+}
+
+} // namespace gm2calc
@@ -19,6 +19,9 @@
 #include "gm2calc/gm2_uncertainty.hpp"
 #include "gm2calc/gm2_1loop.hpp"
 #include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/MSSMNoFV_amu_parameters.hpp"
+
+#include "gm2_uncertainty_helpers.hpp"
 
 #include <cmath>
 
@@ -38,12 +41,12 @@ namespace gm2calc {
  * The estimated uncertainty is the magnitude amu(1-loop) (including
  * tan(beta) resummation).
  *
- * @param model model parameters (unused tag type)
+ * @param pars model parameters (unused tag type)
  * @param amu_1L 1-loop contribution to amu
  *
  * @return uncertainty for amu(0-loop) w/ tan(beta) resummation
  */
-double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell& /* model */, double amu_1L)
+double calculate_uncertainty_amu_0loop(const MSSMNoFV_amu_parameters& /* pars */, double amu_1L)
 {
    return std::abs(amu_1L);
 }
@@ -52,15 +55,15 @@ double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell& /* model */, doub
  * Calculates uncertainty associated with amu(0-loop) including
  * tan(beta) resummation.
  *
- * @param model model parameters
+ * @param pars model parameters
  *
  * @return uncertainty for amu(0-loop) w/ tan(beta) resummation
  */
-double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell& model)
+double calculate_uncertainty_amu_0loop(const MSSMNoFV_amu_parameters& pars)
 {
-   const double amu_1L = calculate_amu_1loop(model);
+   const double amu_1L = calculate_amu_1loop(pars);
 
-   return calculate_uncertainty_amu_0loop(model, amu_1L);
+   return calculate_uncertainty_amu_0loop(pars, amu_1L);
 }
 
 /**
@@ -70,14 +73,14 @@ double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell& model)
  * The estimated uncertainty is the sum of magnitude amu(2-loop)
  * (including tan(beta) resummation) and the 2-loop uncertainty.
  *
- * @param model model parameters
+ * @param pars model parameters
  * @param amu_2L 2-loop contribution to amu
  *
  * @return uncertainty for amu(1-loop) w/ tan(beta) resummation
  */
-double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell& model, double amu_2L)
+double calculate_uncertainty_amu_1loop(const MSSMNoFV_amu_parameters& pars, double amu_2L)
 {
-   const double delta_amu_2L = calculate_uncertainty_amu_2loop(model);
+   const double delta_amu_2L = calculate_uncertainty_amu_2loop(pars);
 
    return std::abs(amu_2L) + std::abs(delta_amu_2L);
 }
@@ -86,15 +89,15 @@ double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell& model, double amu
  * Calculates uncertainty associated with amu(1-loop) including
  * tan(beta) resummation.
  *
- * @param model model parameters
+ * @param pars model parameters
  *
  * @return uncertainty for amu(1-loop) w/ tan(beta) resummation
  */
-double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell& model)
+double calculate_uncertainty_amu_1loop(const MSSMNoFV_amu_parameters& pars)
 {
-   const double amu_2L = calculate_amu_2loop(model);
+   const double amu_2L = calculate_amu_2loop(pars);
 
-   return calculate_uncertainty_amu_1loop(model, amu_2L);
+   return calculate_uncertainty_amu_1loop(pars, amu_2L);
 }
 
 /**
@@ -103,16 +106,43 @@ double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell& model)
  * Eq. (4) takes into account the unknown two-loop contributions and
  * the employed approximation for the 2L(a) contributions.
  *
- * @param model model parameters
+ * @param pars model parameters
  *
  * @return uncertainty for amu(2-loop)
  */
-double calculate_uncertainty_amu_2loop(const MSSMNoFV_onshell& model)
+double calculate_uncertainty_amu_2loop(const MSSMNoFV_amu_parameters& pars)
 {
-   const double amu_2La_Cha = amu2LaCha(model);
-   const double amu_2La_Sferm = amu2LaSferm(model);
+   const double amu_2La_Cha = amu2LaCha(pars);
+   const double amu_2La_Sferm = amu2LaSferm(pars);
 
    return 2.3e-10 + 0.3 * (std::abs(amu_2La_Cha) + std::abs(amu_2La_Sferm));
 }
 
+// === overloads for MSSMNoFV_onshell ===
+
+double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell& /* model */, double amu_1L)
+{
+   return std::abs(amu_1L);
+}
+
+double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell& model, double amu_2L)
+{
+   return calculate_uncertainty_amu_1loop(make_amu_parameters(model), amu_2L);
+}
+
+double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell& model)
+{
+   return calculate_uncertainty_amu_0loop(make_amu_parameters(model));
+}
+
+double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell& model)
+{
+   return calculate_uncertainty_amu_1loop(make_amu_parameters(model));
+}
+
+double calculate_uncertainty_amu_2loop(const MSSMNoFV_onshell& model)
+{
+   return calculate_uncertainty_amu_2loop(make_amu_parameters(model));
+}
+
 } // namespace gm2calc
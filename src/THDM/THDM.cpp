@@ -18,8 +18,8 @@
 
 #include "gm2calc/THDM.hpp"
 #include "gm2calc/gm2_error.hpp"
+#include "THDM/THDM_couplings.hpp"
 #include "gm2_log.hpp"
-#include "gm2_mf.hpp"
 #include "gm2_numerics.hpp"
 
 #include <cmath>
@@ -30,7 +30,6 @@ namespace gm2calc {
 namespace {
 
 constexpr double sqrt2 = 1.4142135623730950; // Sqrt[2]
-constexpr double inv_sqrt2 = 0.70710678118654752; // 1/Sqrt[2]
 
 /// Eq.(6) arxiv:0908.1554 and arxiv:1001.0293, solved for xi_f
 double calc_xi(double zeta, double tan_beta) noexcept
@@ -38,6 +37,24 @@ double calc_xi(double zeta, double tan_beta) noexcept
    return (tan_beta + zeta)/(1 - tan_beta*zeta);
 }
 
+/// collects the parameters the Yukawa couplings depend on
+thdm::Basic_THDM_coupling_parameters<double> make_coupling_parameters(const THDM& model)
+{
+   thdm::Basic_THDM_coupling_parameters<double> p;
+   p.mh = model.get_Mhh(0);
+   p.mH = model.get_Mhh(1);
+   p.mA = model.get_MAh(1);
+   p.mHp = model.get_MHm(1);
+   p.sba = model.get_sin_beta_minus_alpha();
+   p.cba = model.get_cos_beta_minus_alpha();
+   p.tb = model.get_tan_beta();
+   p.cb = 1/std::sqrt(1 + sqr(p.tb));
+   p.zeta_u = model.get_zeta_u();
+   p.zeta_d = model.get_zeta_d();
+   p.zeta_l = model.get_zeta_l();
+   return p;
+}
+
 } // anonymous namespace
 
 namespace thdm {
@@ -89,49 +106,6 @@ THDM::THDM(const thdm::Mass_basis& basis, const SM& sm_, const thdm::Config& cfg
    set_basis(basis);
 }
 
-/// returns the up-type quark masses
-Eigen::Matrix<double,3,1> THDM::get_mu(double scale) const
-{
-   Eigen::Matrix<double,3,1> mu = sm.get_mu();
-
-   if (config.running_couplings && scale > 0) {
-      const double mt_pole = mu(2);
-      // replace mt_pole by mt(SM(6), MS-bar, Q = scale)
-      mu(2) = calculate_mt_SM6_MSbar(mt_pole, sm.get_alpha_s_mz(), sm.get_mz(), scale);
-   }
-
-   return mu;
-}
-
-/// returns the down-type quark masses
-Eigen::Matrix<double,3,1> THDM::get_md(double scale) const
-{
-   Eigen::Matrix<double,3,1> md = sm.get_md();
-
-   if (config.running_couplings && scale > 0) {
-      const double mb_mb = md(2);
-      const double mt_pole = sm.get_mu(2);
-      // replace mb_mb by mb(SM(6), MS-bar, Q = scale)
-      md(2) = calculate_mb_SM6_MSbar(mb_mb, mt_pole, sm.get_alpha_s_mz(), sm.get_mz(), scale);
-   }
-
-   return md;
-}
-
-/// returns the charged lepton masses
-Eigen::Matrix<double,3,1> THDM::get_ml(double scale) const
-{
-   Eigen::Matrix<double,3,1> ml = sm.get_ml();
-
-   if (config.running_couplings && scale > 0) {
-      const double mtau_pole = ml(2);
-      // replace mtau_pole by mtau(SM(6), MS-bar, Q = scale)
-      ml(2) = calculate_mtau_SM6_MSbar(mtau_pole, sm.get_alpha_em_mz(), scale);
-   }
-
-   return ml;
-}
-
 void THDM::init_gauge_couplings()
 {
    set_alpha_em_and_cw(sm.get_alpha_em_mz(), sm.get_cw());
@@ -199,190 +173,79 @@ void THDM::init_yukawas()
 /// Table 1, arxiv:1607.06292
 double THDM::get_zeta_u() const
 {
-   switch (yukawa_type) {
-   case thdm::Yukawa_type::type_1:
-   case thdm::Yukawa_type::type_2:
-   case thdm::Yukawa_type::type_X:
-   case thdm::Yukawa_type::type_Y:
-      return 1.0/get_tan_beta();
-   case thdm::Yukawa_type::aligned:
-      return zeta_u;
-   case thdm::Yukawa_type::general:
-      return 0; // undefined in the general THDM
-   }
-   throw ESetupError("Bug: unhandled case in get_zeta_u.");
+   return thdm::calc_zeta_u(yukawa_type, get_tan_beta(), zeta_u);
 }
 
 /// Table 1, arxiv:1607.06292
 double THDM::get_zeta_d() const
 {
-   switch (yukawa_type) {
-   case thdm::Yukawa_type::type_1:
-      return 1.0/get_tan_beta();
-   case thdm::Yukawa_type::type_2:
-      return -get_tan_beta();
-   case thdm::Yukawa_type::type_X:
-      return 1.0/get_tan_beta();
-   case thdm::Yukawa_type::type_Y:
-      return -get_tan_beta();
-   case thdm::Yukawa_type::aligned:
-      return zeta_d;
-   case thdm::Yukawa_type::general:
-      return 0; // undefined in the general THDM
-   }
-   throw ESetupError("Bug: unhandled case in get_zeta_d.");
+   return thdm::calc_zeta_d(yukawa_type, get_tan_beta(), zeta_d);
 }
 
 /// Table 1, arxiv:1607.06292
 double THDM::get_zeta_l() const
 {
-   switch (yukawa_type) {
-   case thdm::Yukawa_type::type_1:
-      return 1.0/get_tan_beta();
-   case thdm::Yukawa_type::type_2:
-      return -get_tan_beta();
-   case thdm::Yukawa_type::type_X:
-      return -get_tan_beta();
-   case thdm::Yukawa_type::type_Y:
-      return 1.0/get_tan_beta();
-   case thdm::Yukawa_type::aligned:
-      return zeta_l;
-   case thdm::Yukawa_type::general:
-      return 0; // undefined in the general THDM
-   }
-   throw ESetupError("Bug: unhandled case in get_zeta_l.");
-}
-
-Eigen::Matrix<std::complex<double>,3,3> THDM::get_rho_u(const Eigen::Matrix<double,3,3>& mu) const
-{
-   const double cb = get_cos_beta();
-   const double v = get_v();
-
-   if (yukawa_type != thdm::Yukawa_type::general) {
-      return sqrt2*mu*get_zeta_u()/v + Delta_u;
-   }
-
-   return get_Pi_u().real()/cb - sqrt2*mu*get_tan_beta()/v;
-}
-
-Eigen::Matrix<std::complex<double>,3,3> THDM::get_rho_d(const Eigen::Matrix<double,3,3>& md) const
-{
-   const double cb = get_cos_beta();
-   const double v = get_v();
-
-   if (yukawa_type != thdm::Yukawa_type::general) {
-      return sqrt2*md*get_zeta_d()/v + Delta_d;
-   }
-
-   return get_Pi_d()/cb - sqrt2*md*get_tan_beta()/v;
-}
-
-Eigen::Matrix<std::complex<double>,3,3> THDM::get_rho_l(const Eigen::Matrix<double,3,3>& ml) const
-{
-   const double cb = get_cos_beta();
-   const double v = get_v();
-
-   if (yukawa_type != thdm::Yukawa_type::general) {
-      return sqrt2*ml*get_zeta_l()/v + Delta_l;
-   }
-
-   return get_Pi_l()/cb - sqrt2*ml*get_tan_beta()/v;
+   return thdm::calc_zeta_l(yukawa_type, get_tan_beta(), zeta_l);
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_yuh() const
 {
-   const double cba = get_cos_beta_minus_alpha();
-   const double sba = get_sin_beta_minus_alpha();
-   const double v = get_v();
-   const Eigen::Matrix<double,3,3> mu = get_mu(get_Mhh(0)).asDiagonal();
-
-   return sba*mu/v + cba*get_rho_u(mu)*inv_sqrt2;
+   return thdm::get_yuh(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_yuH() const
 {
-   const double cba = get_cos_beta_minus_alpha();
-   const double sba = get_sin_beta_minus_alpha();
-   const double v = get_v();
-   const Eigen::Matrix<double,3,3> mu = get_mu(get_Mhh(1)).asDiagonal();
-
-   return cba*mu/v - sba*get_rho_u(mu)*inv_sqrt2;
+   return thdm::get_yuH(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_yuA() const
 {
-   const Eigen::Matrix<double,3,3> mu = get_mu(get_MAh(1)).asDiagonal();
-   return get_rho_u(mu)*inv_sqrt2;
+   return thdm::get_yuA(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_yuHp() const
 {
-   const Eigen::Matrix<double,3,3> mu = get_mu(get_MHm(1)).asDiagonal();
-   return -get_rho_u(mu).adjoint()*sm.get_ckm();
+   return thdm::get_yuHp(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ydh() const
 {
-   const double cba = get_cos_beta_minus_alpha();
-   const double sba = get_sin_beta_minus_alpha();
-   const double v = get_v();
-   const Eigen::Matrix<double,3,3> md = get_md(get_Mhh(0)).asDiagonal();
-
-   return sba*md/v + cba*get_rho_d(md)*inv_sqrt2;
+   return thdm::get_ydh(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ydH() const
 {
-   const double cba = get_cos_beta_minus_alpha();
-   const double sba = get_sin_beta_minus_alpha();
-   const double v = get_v();
-   const Eigen::Matrix<double,3,3> md = get_md(get_Mhh(1)).asDiagonal();
-
-   return cba*md/v - sba*get_rho_d(md)*inv_sqrt2;
+   return thdm::get_ydH(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ydA() const
 {
-   const Eigen::Matrix<double,3,3> md = get_md(get_MAh(1)).asDiagonal();
-   return -get_rho_d(md)*inv_sqrt2;
+   return thdm::get_ydA(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ydHp() const
 {
-   const Eigen::Matrix<double,3,3> md = get_md(get_MHm(1)).asDiagonal();
-   return sm.get_ckm()*get_rho_d(md);
+   return thdm::get_ydHp(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ylh() const
 {
-   const double cba = get_cos_beta_minus_alpha();
-   const double sba = get_sin_beta_minus_alpha();
-   const double v = get_v();
-   const Eigen::Matrix<double,3,3> ml = get_ml(get_Mhh(0)).asDiagonal();
-
-   return sba*ml/v + cba*get_rho_l(ml)*inv_sqrt2;
+   return thdm::get_ylh(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ylH() const
 {
-   const double cba = get_cos_beta_minus_alpha();
-   const double sba = get_sin_beta_minus_alpha();
-   const double v = get_v();
-   const Eigen::Matrix<double,3,3> ml = get_ml(get_Mhh(1)).asDiagonal();
-
-   return cba*ml/v - sba*get_rho_l(ml)*inv_sqrt2;
+   return thdm::get_ylH(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ylA() const
 {
-   const Eigen::Matrix<double,3,3> ml = get_ml(get_MAh(1)).asDiagonal();
-   return -get_rho_l(ml)*inv_sqrt2;
+   return thdm::get_ylA(*this, make_coupling_parameters(*this));
 }
 
 Eigen::Matrix<std::complex<double>,3,3> THDM::get_ylHp() const
 {
-   const Eigen::Matrix<double,3,3> ml = get_ml(get_MHm(1)).asDiagonal();
-   return get_rho_l(ml);
+   return thdm::get_ylHp(*this, make_coupling_parameters(*this));
 }
 
 void THDM::set_basis(const thdm::Gauge_basis& basis)
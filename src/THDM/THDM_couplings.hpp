@@ -0,0 +1,353 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_THDM_COUPLINGS_HPP
+#define GM2_THDM_COUPLINGS_HPP
+
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/THDM.hpp"
+#include "gm2_dual.hpp"
+#include "gm2_mf.hpp"
+
+#include <complex>
+
+#include <Eigen/Core>
+
+/**
+ * \file THDM_couplings.hpp
+ *
+ * Contains the Yukawa couplings of the THDM as templates, which are
+ * instantiated with Real = double in THDM.cpp and with Real =
+ * Dual<double> in gm2_amu_gradient.cpp.
+ */
+
+namespace gm2calc {
+
+namespace thdm {
+
+/**
+ * parameters on which the Yukawa couplings depend
+ *
+ * @tparam Real real number type (double or Dual<double>)
+ */
+template <class Real>
+struct Basic_THDM_coupling_parameters {
+   Real mh{};       ///< light CP-even Higgs boson mass
+   Real mH{};       ///< heavy CP-even Higgs boson mass
+   Real mA{};       ///< CP-odd Higgs boson mass
+   Real mHp{};      ///< charged Higgs boson mass
+   Real sba{};      ///< sin(beta - alpha_h)
+   Real cba{};      ///< cos(beta - alpha_h)
+   Real tb{};       ///< tan(beta)
+   Real cb{};       ///< cos(beta)
+   Real zeta_u{};   ///< alignment parameter
+   Real zeta_d{};   ///< alignment parameter
+   Real zeta_l{};   ///< alignment parameter
+};
+
+/// Table 1, arxiv:1607.06292
+template <class Real>
+Real calc_zeta_u(Yukawa_type yukawa_type, const Real& tb, const Real& zeta_u)
+{
+   switch (yukawa_type) {
+   case Yukawa_type::type_1:
+   case Yukawa_type::type_2:
+   case Yukawa_type::type_X:
+   case Yukawa_type::type_Y:
+      return 1/tb;
+   case Yukawa_type::aligned:
+      return zeta_u;
+   case Yukawa_type::general:
+      return Real(0); // undefined in the general THDM
+   }
+   throw ESetupError("Bug: unhandled case in calc_zeta_u.");
+}
+
+/// Table 1, arxiv:1607.06292
+template <class Real>
+Real calc_zeta_d(Yukawa_type yukawa_type, const Real& tb, const Real& zeta_d)
+{
+   switch (yukawa_type) {
+   case Yukawa_type::type_1:
+   case Yukawa_type::type_X:
+      return 1/tb;
+   case Yukawa_type::type_2:
+   case Yukawa_type::type_Y:
+      return -tb;
+   case Yukawa_type::aligned:
+      return zeta_d;
+   case Yukawa_type::general:
+      return Real(0); // undefined in the general THDM
+   }
+   throw ESetupError("Bug: unhandled case in calc_zeta_d.");
+}
+
+/// Table 1, arxiv:1607.06292
+template <class Real>
+Real calc_zeta_l(Yukawa_type yukawa_type, const Real& tb, const Real& zeta_l)
+{
+   switch (yukawa_type) {
+   case Yukawa_type::type_1:
+   case Yukawa_type::type_Y:
+      return 1/tb;
+   case Yukawa_type::type_2:
+   case Yukawa_type::type_X:
+      return -tb;
+   case Yukawa_type::aligned:
+      return zeta_l;
+   case Yukawa_type::general:
+      return Real(0); // undefined in the general THDM
+   }
+   throw ESetupError("Bug: unhandled case in calc_zeta_l.");
+}
+
+/// returns the up-type quark masses at the given scale
+template <class Real>
+Eigen::Matrix<Real,3,3> get_mu(const THDM& model, const Real& scale)
+{
+   const auto& sm = model.get_sm();
+   Eigen::Matrix<Real,3,1> mu = sm.get_mu().template cast<Real>();
+
+   if (model.get_config().running_couplings && scale > 0) {
+      const double mt_pole = sm.get_mu(2);
+      // replace mt_pole by mt(SM(6), MS-bar, Q = scale)
+      mu(2) = calculate_mt_SM6_MSbar(mt_pole, sm.get_alpha_s_mz(), sm.get_mz(), scale);
+   }
+
+   return mu.asDiagonal();
+}
+
+/// returns the down-type quark masses at the given scale
+template <class Real>
+Eigen::Matrix<Real,3,3> get_md(const THDM& model, const Real& scale)
+{
+   const auto& sm = model.get_sm();
+   Eigen::Matrix<Real,3,1> md = sm.get_md().template cast<Real>();
+
+   if (model.get_config().running_couplings && scale > 0) {
+      const double mb_mb = sm.get_md(2);
+      const double mt_pole = sm.get_mu(2);
+      // replace mb_mb by mb(SM(6), MS-bar, Q = scale)
+      md(2) = calculate_mb_SM6_MSbar(mb_mb, mt_pole, sm.get_alpha_s_mz(), sm.get_mz(), scale);
+   }
+
+   return md.asDiagonal();
+}
+
+/// returns the charged lepton masses at the given scale
+template <class Real>
+Eigen::Matrix<Real,3,3> get_ml(const THDM& model, const Real& scale)
+{
+   const auto& sm = model.get_sm();
+   Eigen::Matrix<Real,3,1> ml = sm.get_ml().template cast<Real>();
+
+   if (model.get_config().running_couplings && scale > 0) {
+      const double mtau_pole = sm.get_ml(2);
+      // replace mtau_pole by mtau(SM(6), MS-bar, Q = scale)
+      ml(2) = calculate_mtau_SM6_MSbar(mtau_pole, sm.get_alpha_em_mz(), scale);
+   }
+
+   return ml.asDiagonal();
+}
+
+/**
+ * Returns the matrix \f$\rho_f\f$ of fermion f.
+ *
+ * @param model THDM
+ * @param p parameters
+ * @param m fermion mass matrix
+ * @param zeta alignment parameter of fermion f
+ * @param Delta deviation from alignment of fermion f
+ * @param Pi Yukawa coupling matrix of fermion f in the general THDM
+ */
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_rho(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p,
+   const Eigen::Matrix<Real,3,3>& m, const Real& zeta,
+   const Eigen::Matrix<double,3,3>& Delta,
+   const Eigen::Matrix<std::complex<double>,3,3>& Pi)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Real sqrt2(1.4142135623730950); // Sqrt[2]
+   const Real v(model.get_v());
+
+   if (model.get_yukawa_type() != Yukawa_type::general) {
+      const Eigen::Matrix<Real,3,3> rho = sqrt2*m*zeta/v + Delta.template cast<Real>();
+      return rho.template cast<Complex>();
+   }
+
+   const Eigen::Matrix<Real,3,3> mtb = sqrt2*m*p.tb/v;
+
+   return Pi.template cast<Complex>()/Complex(p.cb) - mtb.template cast<Complex>();
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_rho_u(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p, const Eigen::Matrix<Real,3,3>& mu)
+{
+   const Eigen::Matrix<std::complex<double>,3,3> Pi_u = model.get_Pi_u().real().cast<std::complex<double>>();
+   return get_rho(model, p, mu, p.zeta_u, model.get_Delta_u(), Pi_u);
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_rho_d(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p, const Eigen::Matrix<Real,3,3>& md)
+{
+   return get_rho(model, p, md, p.zeta_d, model.get_Delta_d(), model.get_Pi_d());
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_rho_l(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p, const Eigen::Matrix<Real,3,3>& ml)
+{
+   return get_rho(model, p, ml, p.zeta_l, model.get_Delta_l(), model.get_Pi_l());
+}
+
+/// Yukawa couplings of the light CP-even Higgs boson
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_yh(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p,
+   const Eigen::Matrix<Real,3,3>& m, const Eigen::Matrix<typename Complex_type<Real>::type,3,3>& rho)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Real v(model.get_v());
+   const Complex inv_sqrt2(0.70710678118654752); // 1/Sqrt[2]
+   const Eigen::Matrix<Real,3,3> ym = p.sba*m/v;
+
+   return ym.template cast<Complex>() + Complex(p.cba)*rho*inv_sqrt2;
+}
+
+/// Yukawa couplings of the heavy CP-even Higgs boson
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_yH(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p,
+   const Eigen::Matrix<Real,3,3>& m, const Eigen::Matrix<typename Complex_type<Real>::type,3,3>& rho)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Real v(model.get_v());
+   const Complex inv_sqrt2(0.70710678118654752); // 1/Sqrt[2]
+   const Eigen::Matrix<Real,3,3> ym = p.cba*m/v;
+
+   return ym.template cast<Complex>() - Complex(p.sba)*rho*inv_sqrt2;
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_yuh(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   const Eigen::Matrix<Real,3,3> mu = get_mu(model, p.mh);
+   return get_yh(model, p, mu, get_rho_u(model, p, mu));
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_yuH(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   const Eigen::Matrix<Real,3,3> mu = get_mu(model, p.mH);
+   return get_yH(model, p, mu, get_rho_u(model, p, mu));
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_yuA(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Complex inv_sqrt2(0.70710678118654752); // 1/Sqrt[2]
+   return get_rho_u(model, p, get_mu(model, p.mA))*inv_sqrt2;
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_yuHp(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Eigen::Matrix<Complex,3,3> vckm = model.get_sm().get_ckm().template cast<Complex>();
+   return -get_rho_u(model, p, get_mu(model, p.mHp)).adjoint()*vckm;
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ydh(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   const Eigen::Matrix<Real,3,3> md = get_md(model, p.mh);
+   return get_yh(model, p, md, get_rho_d(model, p, md));
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ydH(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   const Eigen::Matrix<Real,3,3> md = get_md(model, p.mH);
+   return get_yH(model, p, md, get_rho_d(model, p, md));
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ydA(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Complex inv_sqrt2(0.70710678118654752); // 1/Sqrt[2]
+   return -get_rho_d(model, p, get_md(model, p.mA))*inv_sqrt2;
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ydHp(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Eigen::Matrix<Complex,3,3> vckm = model.get_sm().get_ckm().template cast<Complex>();
+   return vckm*get_rho_d(model, p, get_md(model, p.mHp));
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ylh(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   const Eigen::Matrix<Real,3,3> ml = get_ml(model, p.mh);
+   return get_yh(model, p, ml, get_rho_l(model, p, ml));
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ylH(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   const Eigen::Matrix<Real,3,3> ml = get_ml(model, p.mH);
+   return get_yH(model, p, ml, get_rho_l(model, p, ml));
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ylA(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   using Complex = typename Complex_type<Real>::type;
+   const Complex inv_sqrt2(0.70710678118654752); // 1/Sqrt[2]
+   return -get_rho_l(model, p, get_ml(model, p.mA))*inv_sqrt2;
+}
+
+template <class Real>
+Eigen::Matrix<typename Complex_type<Real>::type,3,3> get_ylHp(
+   const THDM& model, const Basic_THDM_coupling_parameters<Real>& p)
+{
+   return get_rho_l(model, p, get_ml(model, p.mHp));
+}
+
+} // namespace thdm
+
+} // namespace gm2calc
+
+#endif
@@ -0,0 +1,539 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/THDM_emulator.hpp"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+
+#include "gm2_parallel.hpp"
+#include "gm2_thdm_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+
+namespace gm2calc {
+
+namespace {
+
+/// magic number at the beginning of an emulator file
+const char emulator_magic[8] = {'G', 'M', '2', 'C', 'T', 'E', 'M', 'U'};
+
+/// version of the emulator file format
+const std::uint64_t emulator_version = 1;
+
+const double pi = 3.141592653589793;
+
+using Setter = std::function<void(thdm::Mass_basis&, double)>;
+
+template <class T>
+void write_value(std::ostream& ostr, const T& value)
+{
+   ostr.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+bool read_value(std::istream& istr, T& value)
+{
+   return static_cast<bool>(istr.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/// applies f to all real parameters of the mass basis
+template <class Basis, class F>
+void visit_parameters(Basis& b, F&& f)
+{
+   f(b.mh); f(b.mH); f(b.mA); f(b.mHp); f(b.sin_beta_minus_alpha);
+   f(b.lambda_6); f(b.lambda_7); f(b.tan_beta); f(b.m122);
+   f(b.zeta_u); f(b.zeta_d); f(b.zeta_l);
+
+   for (auto* m: {&b.Delta_u, &b.Delta_d, &b.Delta_l, &b.Pi_u, &b.Pi_d, &b.Pi_l}) {
+      for (int i = 0; i < m->size(); i++) {
+         f((*m)(i));
+      }
+   }
+}
+
+/// returns the setter of the parameter of an axis
+Setter find_axis_setter(const std::string& name)
+{
+   if (name == "cos_beta_minus_alpha") {
+      return [] (thdm::Mass_basis& b, double v) { b.sin_beta_minus_alpha = std::sqrt(1 - v*v); };
+   }
+
+   Setter setter;
+
+   if (name != "yukawa_type") {
+      setter = find_thdm_mass_basis_setter(name);
+   }
+
+   if (!setter) {
+      throw EInvalidInput("\"" + name + "\" is not a THDM emulator parameter");
+   }
+
+   return setter;
+}
+
+/// converts t in [-1,1] to the parameter value
+double to_parameter(const thdm::Emulator_axis& axis, double t)
+{
+   const double s = 0.5*(t + 1);
+
+   if (axis.log_scale) {
+      return axis.min*std::exp(s*std::log(axis.max/axis.min));
+   }
+
+   return axis.min + s*(axis.max - axis.min);
+}
+
+/// k-th of n Chebyshev nodes (roots of T_n)
+double chebyshev_node(unsigned k, unsigned n)
+{
+   return std::cos(pi*(k + 0.5)/n);
+}
+
+/// calculates the Chebyshev polynomials T_0(t), ..., T_{n-1}(t)
+void chebyshev_polynomials(double t, unsigned n, double* T)
+{
+   T[0] = 1;
+   if (n > 1) {
+      T[1] = t;
+   }
+   for (unsigned j = 2; j < n; j++) {
+      T[j] = 2*t*T[j - 1] - T[j - 2];
+   }
+}
+
+/**
+ * Transforms the function values at the Chebyshev nodes into the
+ * Chebyshev coefficients along one axis of the tensor.
+ *
+ * @param values tensor (row-major)
+ * @param n number of nodes of the axis
+ * @param stride distance of two neighbouring nodes of the axis
+ */
+void transform_axis(std::vector<double>& values, unsigned n, std::size_t stride)
+{
+   // C(j,k) = 2/n T_j(t_k), with T_0 weighted by 1/2
+   std::vector<double> C(n*n);
+   for (unsigned j = 0; j < n; j++) {
+      for (unsigned k = 0; k < n; k++) {
+         C[j*n + k] = (j == 0 ? 1.0 : 2.0)/n*std::cos(pi*j*(k + 0.5)/n);
+      }
+   }
+
+   std::vector<double> line(n);
+   const std::size_t block = stride*n;
+
+   for (std::size_t b = 0; b < values.size(); b += block) {
+      for (std::size_t s = 0; s < stride; s++) {
+         double* v = values.data() + b + s;
+         for (unsigned j = 0; j < n; j++) {
+            double sum = 0;
+            for (unsigned k = 0; k < n; k++) {
+               sum += C[j*n + k]*v[k*stride];
+            }
+            line[j] = sum;
+         }
+         for (unsigned j = 0; j < n; j++) {
+            v[j*stride] = line[j];
+         }
+      }
+   }
+}
+
+double calculate_amu(const thdm::Mass_basis& basis, const SM& sm, const thdm::Config& config)
+{
+   const THDM model(basis, sm, config);
+   return calculate_amu_1loop(model) + calculate_amu_2loop(model);
+}
+
+} // anonymous namespace
+
+/**
+ * Reads the emulator from a file, which has been written by write().
+ *
+ * @param file_name name of the file
+ */
+THDM_emulator::THDM_emulator(const std::string& file_name)
+{
+   std::ifstream istr(file_name, std::ios::binary);
+
+   char magic[sizeof(emulator_magic)];
+   std::uint64_t version = 0, dim = 0, n_coefficients = 0;
+   std::int64_t yukawa_type = 0;
+
+   if (!istr.read(magic, sizeof(magic)) || !read_value(istr, version) ||
+       std::memcmp(magic, emulator_magic, sizeof(emulator_magic)) != 0) {
+      throw EReadError("\"" + file_name + "\" is not a GM2Calc THDM emulator file");
+   }
+
+   if (version != emulator_version) {
+      throw EReadError("THDM emulator file \"" + file_name + "\" has an incompatible format");
+   }
+
+   bool ok = read_value(istr, yukawa_type);
+   visit_parameters(basis, [&] (double& x) { ok = ok && read_value(istr, x); });
+   ok = ok && read_value(istr, dim) && dim >= 1 && dim <= max_dimension;
+
+   for (std::uint64_t d = 0; ok && d < dim; d++) {
+      thdm::Emulator_axis axis;
+      std::uint64_t length = 0;
+      std::uint8_t log_scale = 0;
+      ok = read_value(istr, length) && length < 256;
+      if (ok) {
+         axis.name.resize(length);
+         ok = istr.read(&axis.name[0], length) && read_value(istr, axis.min)
+            && read_value(istr, axis.max) && read_value(istr, axis.nodes)
+            && read_value(istr, log_scale);
+         axis.log_scale = log_scale != 0;
+         axes.push_back(axis);
+      }
+   }
+
+   ok = ok && read_value(istr, max_abs_error) && read_value(istr, max_rel_error)
+      && read_value(istr, samples) && read_value(istr, n_coefficients);
+
+   if (ok) {
+      indices.resize(n_coefficients*dim);
+      coefficients.resize(n_coefficients);
+      ok = istr.read(reinterpret_cast<char*>(indices.data()), indices.size())
+         && istr.read(reinterpret_cast<char*>(coefficients.data()), coefficients.size()*sizeof(double));
+   }
+
+   if (!ok) {
+      throw EReadError("THDM emulator file \"" + file_name + "\" is corrupt");
+   }
+
+   basis.yukawa_type = thdm::int_to_cpp_yukawa_type(static_cast<int>(yukawa_type));
+
+   check();
+
+   for (std::size_t k = 0; k < indices.size(); k++) {
+      if (indices[k] >= axes[k % dim].nodes) {
+         throw EReadError("THDM emulator file \"" + file_name + "\" is corrupt");
+      }
+   }
+
+   initialize();
+}
+
+/**
+ * Builds the emulator of a_mu(1-loop + 2-loop) in the box given by
+ * the axes of the options.  All other parameters are taken from the
+ * given mass basis parameters.
+ *
+ * a_mu is calculated at the tensor product of the Chebyshev nodes
+ * (roots of T_n) of all axes, which requires n_1*...*n_d evaluations.
+ * The Chebyshev coefficients are obtained by a discrete cosine
+ * transform along each axis.  The smallest coefficients are dropped
+ * (see thdm::Emulator_options).  Afterwards, a_mu is calculated at
+ * options.samples random points in the box and the maximum absolute
+ * and relative deviations of the emulator are stored.
+ *
+ * @param basis THDM parameters
+ * @param options parameters of the emulator and options
+ * @param sm Standard Model parameters
+ * @param config THDM configuration
+ *
+ * @return emulator
+ */
+THDM_emulator THDM_emulator::build(
+   const thdm::Mass_basis& basis, const thdm::Emulator_options& options,
+   const SM& sm, const thdm::Config& config)
+{
+   THDM_emulator emulator;
+   emulator.basis = basis;
+   emulator.axes = options.axes;
+   emulator.check();
+
+   if (!(options.truncation >= 0)) {
+      throw EInvalidInput("emulator truncation threshold must not be negative");
+   }
+
+   const std::size_t dim = emulator.axes.size();
+   std::vector<std::size_t> strides(dim, 1);
+   for (std::size_t d = dim - 1; d > 0; d--) {
+      strides[d - 1] = strides[d]*emulator.axes[d].nodes;
+   }
+   const std::size_t size = strides[0]*emulator.axes[0].nodes;
+
+   // a_mu at the Chebyshev nodes
+   std::vector<double> values(size);
+
+   parallel_for(size, options.threads, [&] (std::size_t i) {
+      std::vector<double> x(dim);
+      for (std::size_t d = 0; d < dim; d++) {
+         const auto& axis = emulator.axes[d];
+         x[d] = to_parameter(axis, chebyshev_node((i / strides[d]) % axis.nodes, axis.nodes));
+      }
+      values[i] = calculate_amu(emulator.get_basis(x.data()), sm, config);
+      if (!std::isfinite(values[i])) {
+         throw EPhysicalProblem("a_mu is not finite at a node of the THDM emulator");
+      }
+   });
+
+   double scale = 0;
+   for (const double v: values) {
+      scale = std::max(scale, std::abs(v));
+   }
+
+   for (std::size_t d = 0; d < dim; d++) {
+      transform_axis(values, emulator.axes[d].nodes, strides[d]);
+   }
+
+   // drop the smallest coefficients
+   std::vector<std::size_t> order(size);
+   std::iota(order.begin(), order.end(), 0);
+   std::sort(order.begin(), order.end(), [&values] (std::size_t a, std::size_t b) {
+      return std::abs(values[a]) < std::abs(values[b]);
+   });
+
+   std::vector<bool> keep(size, true);
+   double dropped = 0;
+   for (const std::size_t i: order) {
+      dropped += std::abs(values[i]);
+      if (dropped > options.truncation*scale) {
+         break;
+      }
+      keep[i] = false;
+   }
+
+   for (std::size_t i = 0; i < size; i++) {
+      if (keep[i]) {
+         for (std::size_t d = 0; d < dim; d++) {
+            emulator.indices.push_back(static_cast<std::uint8_t>((i / strides[d]) % emulator.axes[d].nodes));
+         }
+         emulator.coefficients.push_back(values[i]);
+      }
+   }
+
+   emulator.initialize();
+
+   // estimate the error at random points
+   std::mt19937_64 generator(options.seed);
+   std::uniform_real_distribution<double> distribution(-1, 1);
+   std::vector<double> points(options.samples*dim);
+
+   for (std::size_t i = 0; i < points.size(); i++) {
+      points[i] = to_parameter(emulator.axes[i % dim], distribution(generator));
+   }
+
+   std::vector<double> exact(options.samples);
+
+   parallel_for(options.samples, options.threads, [&] (std::size_t i) {
+      exact[i] = calculate_amu(emulator.get_basis(&points[i*dim]), sm, config);
+   });
+
+   for (std::size_t i = 0; i < options.samples; i++) {
+      const double diff = std::abs(emulator.evaluate(&points[i*dim]) - exact[i]);
+      emulator.max_abs_error = std::max(emulator.max_abs_error, diff);
+      if (exact[i] != 0) {
+         emulator.max_rel_error = std::max(emulator.max_rel_error, diff/std::abs(exact[i]));
+      }
+   }
+
+   emulator.samples = options.samples;
+
+   return emulator;
+}
+
+/**
+ * Writes the emulator to a binary file.
+ *
+ * @param file_name name of the file
+ */
+void THDM_emulator::write(const std::string& file_name) const
+{
+   std::ofstream ostr(file_name, std::ios::binary | std::ios::trunc);
+
+   ostr.write(emulator_magic, sizeof(emulator_magic));
+   write_value(ostr, emulator_version);
+   write_value(ostr, static_cast<std::int64_t>(basis.yukawa_type));
+   visit_parameters(basis, [&ostr] (const double& x) { write_value(ostr, x); });
+   write_value(ostr, static_cast<std::uint64_t>(axes.size()));
+
+   for (const auto& axis: axes) {
+      write_value(ostr, static_cast<std::uint64_t>(axis.name.size()));
+      ostr.write(axis.name.data(), axis.name.size());
+      write_value(ostr, axis.min);
+      write_value(ostr, axis.max);
+      write_value(ostr, axis.nodes);
+      write_value(ostr, static_cast<std::uint8_t>(axis.log_scale));
+   }
+
+   write_value(ostr, max_abs_error);
+   write_value(ostr, max_rel_error);
+   write_value(ostr, samples);
+   write_value(ostr, static_cast<std::uint64_t>(coefficients.size()));
+   ostr.write(reinterpret_cast<const char*>(indices.data()), indices.size());
+   ostr.write(reinterpret_cast<const char*>(coefficients.data()), coefficients.size()*sizeof(double));
+
+   if (!ostr) {
+      throw EReadError("cannot write THDM emulator file \"" + file_name + "\"");
+   }
+}
+
+/**
+ * Returns the approximation of a_mu(1-loop + 2-loop).
+ *
+ * @param x values of the parameters (in the order of the axes)
+ *
+ * @return a_mu
+ *
+ * @throw EInvalidInput if a parameter is outside of its range
+ */
+double THDM_emulator::evaluate(const double* x) const
+{
+   const std::size_t dim = axes.size();
+   double T[max_dimension][max_nodes];
+
+   for (std::size_t d = 0; d < dim; d++) {
+      const double y = axes[d].log_scale ? std::log(x[d]) : x[d];
+      const double t = scales[d]*y + offsets[d];
+      if (!(std::abs(t) <= 1 + 1e-12)) {
+         throw EInvalidInput("parameter " + axes[d].name + " = " + std::to_string(x[d])
+                             + " is outside of the range of the THDM emulator");
+      }
+      chebyshev_polynomials(t, degrees[d], T[d]);
+   }
+
+   const std::uint8_t* idx = indices.data();
+   double sum = 0;
+
+   for (const double c: coefficients) {
+      double p = c;
+      for (std::size_t d = 0; d < dim; d++) {
+         p *= T[d][idx[d]];
+      }
+      sum += p;
+      idx += dim;
+   }
+
+   return sum;
+}
+
+/**
+ * Returns the approximation of a_mu(1-loop + 2-loop).
+ *
+ * @param x values of the parameters (in the order of the axes)
+ *
+ * @return a_mu
+ */
+double THDM_emulator::evaluate(const std::vector<double>& x) const
+{
+   if (x.size() != axes.size()) {
+      throw EInvalidInput("THDM emulator expects " + std::to_string(axes.size())
+                          + " parameters, but " + std::to_string(x.size()) + " are given");
+   }
+   return evaluate(x.data());
+}
+
+/**
+ * Calculates a_mu(1-loop + 2-loop) without the emulator, e.g. to
+ * verify the emulator.
+ *
+ * @param x values of the parameters (in the order of the axes)
+ * @param sm Standard Model parameters
+ * @param config THDM configuration
+ *
+ * @return a_mu
+ */
+double THDM_emulator::evaluate_exact(const double* x, const SM& sm, const thdm::Config& config) const
+{
+   return calculate_amu(get_basis(x), sm, config);
+}
+
+/**
+ * Returns the THDM parameters at the given parameter values.
+ *
+ * @param x values of the parameters (in the order of the axes)
+ *
+ * @return THDM parameters
+ */
+thdm::Mass_basis THDM_emulator::get_basis(const double* x) const
+{
+   thdm::Mass_basis b(basis);
+
+   for (std::size_t d = 0; d < axes.size(); d++) {
+      find_axis_setter(axes[d].name)(b, x[d]);
+   }
+
+   return b;
+}
+
+void THDM_emulator::check() const
+{
+   if (axes.empty() || axes.size() > max_dimension) {
+      throw EInvalidInput("number of THDM emulator parameters must be between 1 and "
+                          + std::to_string(max_dimension));
+   }
+
+   for (std::size_t d = 0; d < axes.size(); d++) {
+      const auto& axis = axes[d];
+      find_axis_setter(axis.name);
+      for (std::size_t e = 0; e < d; e++) {
+         if (axes[e].name == axis.name) {
+            throw EInvalidInput("duplicate THDM emulator parameter \"" + axis.name + "\"");
+         }
+      }
+      if (!(axis.min < axis.max)) {
+         throw EInvalidInput("range of THDM emulator parameter " + axis.name + " must not be empty");
+      }
+      if (axis.name == "cos_beta_minus_alpha" && !(axis.min >= 0 && axis.max <= 1)) {
+         throw EInvalidInput("range of THDM emulator parameter " + axis.name
+                             + " must be within [0,1]");
+      }
+      if (axis.log_scale && !(axis.min > 0)) {
+         throw EInvalidInput("range of THDM emulator parameter " + axis.name
+                             + " must be positive for a logarithmic scale");
+      }
+      if (axis.nodes < 1 || axis.nodes > max_nodes) {
+         throw EInvalidInput("number of nodes of THDM emulator parameter " + axis.name
+                             + " must be between 1 and " + std::to_string(max_nodes));
+      }
+   }
+}
+
+/// calculates the linear maps to [-1,1] and the maximum degrees
+void THDM_emulator::initialize()
+{
+   const std::size_t dim = axes.size();
+
+   scales.resize(dim);
+   offsets.resize(dim);
+   degrees.assign(dim, 1);
+
+   for (std::size_t d = 0; d < dim; d++) {
+      const auto& axis = axes[d];
+      const double lo = axis.log_scale ? std::log(axis.min) : axis.min;
+      const double hi = axis.log_scale ? std::log(axis.max) : axis.max;
+      scales[d] = 2/(hi - lo);
+      offsets[d] = -(hi + lo)/(hi - lo);
+   }
+
+   for (std::size_t k = 0; k < indices.size(); k++) {
+      degrees[k % dim] = std::max(degrees[k % dim], indices[k] + 1u);
+   }
+}
+
+} // namespace gm2calc
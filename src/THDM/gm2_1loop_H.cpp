@@ -17,9 +17,13 @@
 // ====================================================================
 
 #include "THDM/gm2_1loop_helpers.hpp"
+#include "gm2_dual.hpp"
 #include "gm2_ffunctions.hpp"
+#include "gm2_numerics.hpp"
+#include "gm2_profile_timer.hpp"
 #include <cmath>
 #include <complex>
+#include <type_traits>
 
 /**
  * \file gm2_1loop_H.cpp
@@ -37,8 +41,6 @@ namespace {
 const double pi = 3.1415926535897932;
 const double pi2 = 9.8696044010893586; // Pi^2
 
-double sqr(double x) noexcept { return x*x; }
-
 /// Eq.(28), arxiv:1607.06292
 double Fh(double x) noexcept
 {
@@ -57,29 +59,42 @@ double FHp(double x) noexcept
    return -F1N(x)/12;
 }
 
-double AS(int gen, const Eigen::Matrix<double,3,1>& ml, double mS2, const Eigen::Matrix<std::complex<double>,3,3>& y) noexcept
+template <class Real, class Complex>
+Real AS(int gen, const Eigen::Matrix<Real,3,1>& ml, const Real& mS2, const Eigen::Matrix<Complex,3,3>& y) noexcept
 {
-   const auto x = sqr(ml(gen))/mS2;
-   const auto y2 = std::conj(y(gen, 1))*std::conj(y(1, gen));
+   using std::conj;
+   using std::norm;
+   using std::real;
+
+   const Real x = sqr(ml(gen))/mS2;
+   const Complex y2 = conj(y(gen, 1))*conj(y(1, gen));
 
    return
-      + (std::norm(y(gen, 1)) + std::norm(y(1, gen)))*F1C(x)/24
-      + std::real(y2)*ml(gen)/ml(1)*F2C(x)/3;
+      + (norm(y(gen, 1)) + norm(y(1, gen)))*F1C(x)/24
+      + real(y2)*ml(gen)/ml(1)*F2C(x)/3;
 }
 
-double AA(int gen, const Eigen::Matrix<double,3,1>& ml, double mS2, const Eigen::Matrix<std::complex<double>,3,3>& y) noexcept
+template <class Real, class Complex>
+Real AA(int gen, const Eigen::Matrix<Real,3,1>& ml, const Real& mS2, const Eigen::Matrix<Complex,3,3>& y) noexcept
 {
-   const auto x = sqr(ml(gen))/mS2;
-   const auto y2 = std::conj(y(gen, 1))*std::conj(y(1, gen));
+   using std::conj;
+   using std::norm;
+   using std::real;
+
+   const Real x = sqr(ml(gen))/mS2;
+   const Complex y2 = conj(y(gen, 1))*conj(y(1, gen));
 
    return
-      + (std::norm(y(gen, 1)) + std::norm(y(1, gen)))*F1C(x)/24
-      - std::real(y2)*ml(gen)/ml(1)*F2C(x)/3;
+      + (norm(y(gen, 1)) + norm(y(1, gen)))*F1C(x)/24
+      - real(y2)*ml(gen)/ml(1)*F2C(x)/3;
 }
 
-double AHp(int gen, const Eigen::Matrix<double,3,1>& mv, double mS2, const Eigen::Matrix<std::complex<double>,3,3>& y) noexcept
+template <class Real, class Complex>
+Real AHp(int gen, const Eigen::Matrix<Real,3,1>& mv, const Real& mS2, const Eigen::Matrix<Complex,3,3>& y) noexcept
 {
-   return -std::norm(y(gen, 1))/48*(
+   using std::norm;
+
+   return -norm(y(gen, 1))/48*(
       F1N(sqr(mv(1))/mS2) + F1N(sqr(mv(gen))/mS2));
 }
 
@@ -125,8 +140,14 @@ double amu1L_approx(const THDM_1L_parameters& pars) noexcept
 /**
  * Full (CP-conserving) 1-loop contribution
  */
-double amu1L(const THDM_1L_parameters& pars) noexcept
+template <class Real>
+Real amu1L(const Basic_THDM_1L_parameters<Real>& pars) noexcept
 {
+   const Profile_timer timer(Profile_id::amu1L, std::is_same<Real,double>::value);
+
+   using std::sqrt;
+   using Complex = typename Basic_THDM_1L_parameters<Real>::Complex;
+
    const auto mm2 = sqr(pars.mm);
    const auto mw2 = sqr(pars.mw);
    const auto mz2 = sqr(pars.mz);
@@ -137,16 +158,16 @@ double amu1L(const THDM_1L_parameters& pars) noexcept
    const auto mHp2 = sqr(pars.mHp);
    const auto sw2 = 1 - mw2/mz2;
    const auto e2 = 4*pi*pars.alpha_em;
-   const auto g2 = std::sqrt(e2/sw2);
+   const auto g2 = sqrt(e2/sw2);
    const auto v = 2*pars.mw/g2;
 
-   const Eigen::Matrix<double, 3, 3> ylhSM{
-      (Eigen::Matrix<double, 3, 3>()
+   const Eigen::Matrix<Complex, 3, 3> ylhSM{
+      (Eigen::Matrix<Complex, 3, 3>()
        << 0.0, 0.0, 0.0,
           0.0, pars.mm/v, 0.0,
           0.0, 0.0, 0.0).finished()};
 
-   double res = 0.0;
+   Real res = 0.0;
 
    for (int g = 0; g < 3; ++g) {
       res += AS(g, pars.ml, mh2, pars.ylh)/mh2;
@@ -161,6 +182,9 @@ double amu1L(const THDM_1L_parameters& pars) noexcept
    return mm2*res/(8*pi2);
 }
 
+template double amu1L(const Basic_THDM_1L_parameters<double>&) noexcept;
+template Dual<double> amu1L(const Basic_THDM_1L_parameters<Dual<double>>&) noexcept;
+
 /**
  * Calculates the 1-loop THDM contribution to \f$\Delta\alpha\f$.
  * \f$\alpha^{\text{THDM}} = \alpha^{\text{SM}}/(1 - \Delta\alpha)\f$
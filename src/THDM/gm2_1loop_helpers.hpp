@@ -19,33 +19,47 @@
 #ifndef GM2_THDM_1LOOP_HELPERS_HPP
 #define GM2_THDM_1LOOP_HELPERS_HPP
 
+#include "gm2_dual.hpp"
+
+#include <complex>
+
 #include <Eigen/Core>
 
 namespace gm2calc {
 
 namespace thdm {
 
-/// parameters to be passed to the 1-loop contribution functions
-struct THDM_1L_parameters {
-   double alpha_em{}; ///< electromagnetic coupling
-   double mm{};       ///< muon mass for prefactor
-   double mw{};       ///< W boson mass
-   double mz{};       ///< Z boson mass
-   double mhSM{};     ///< SM Higgs boson mass
-   double mA{};       ///< CP-odd Higgs boson mass
-   double mHp{};      ///< charged Higgs boson mass
-   Eigen::Matrix<double,3,1> ml{Eigen::Matrix<double,3,1>::Zero()};  ///< down-type lepton masses
-   Eigen::Matrix<double,3,1> mv{Eigen::Matrix<double,3,1>::Zero()};  ///< neutrino masses
-   Eigen::Matrix<double,2,1> mh{Eigen::Matrix<double,2,1>::Zero()};  ///< CP-even Higgs bosons mass
-   Eigen::Matrix<std::complex<double>,3,3> ylh{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< Y_l^h coefficients with l={e,m,τ}
-   Eigen::Matrix<std::complex<double>,3,3> ylH{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< Y_l^H coefficients with l={e,m,τ}
-   Eigen::Matrix<std::complex<double>,3,3> ylA{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< Y_l^A coefficients with l={e,m,τ}
-   Eigen::Matrix<std::complex<double>,3,3> ylHp{Eigen::Matrix<std::complex<double>,3,3>::Zero()};///< Y_l^{H^\pm} coefficients with l={e,m,τ}
+/**
+ * parameters to be passed to the 1-loop contribution functions
+ *
+ * @tparam Real real number type (double or Dual<double>)
+ */
+template <class Real>
+struct Basic_THDM_1L_parameters {
+   using Complex = typename Complex_type<Real>::type;
+
+   Real alpha_em{}; ///< electromagnetic coupling
+   Real mm{};       ///< muon mass for prefactor
+   Real mw{};       ///< W boson mass
+   Real mz{};       ///< Z boson mass
+   Real mhSM{};     ///< SM Higgs boson mass
+   Real mA{};       ///< CP-odd Higgs boson mass
+   Real mHp{};      ///< charged Higgs boson mass
+   Eigen::Matrix<Real,3,1> ml{Eigen::Matrix<Real,3,1>::Zero()};  ///< down-type lepton masses
+   Eigen::Matrix<Real,3,1> mv{Eigen::Matrix<Real,3,1>::Zero()};  ///< neutrino masses
+   Eigen::Matrix<Real,2,1> mh{Eigen::Matrix<Real,2,1>::Zero()};  ///< CP-even Higgs bosons mass
+   Eigen::Matrix<Complex,3,3> ylh{Eigen::Matrix<Complex,3,3>::Zero()}; ///< Y_l^h coefficients with l={e,m,τ}
+   Eigen::Matrix<Complex,3,3> ylH{Eigen::Matrix<Complex,3,3>::Zero()}; ///< Y_l^H coefficients with l={e,m,τ}
+   Eigen::Matrix<Complex,3,3> ylA{Eigen::Matrix<Complex,3,3>::Zero()}; ///< Y_l^A coefficients with l={e,m,τ}
+   Eigen::Matrix<Complex,3,3> ylHp{Eigen::Matrix<Complex,3,3>::Zero()};///< Y_l^{H^\pm} coefficients with l={e,m,τ}
 };
 
+using THDM_1L_parameters = Basic_THDM_1L_parameters<double>;
+
 // === 1-loop contributions ===
 
-double amu1L(const THDM_1L_parameters&) noexcept;
+template <class Real>
+Real amu1L(const Basic_THDM_1L_parameters<Real>&) noexcept;
 
 // === approximations ===
 
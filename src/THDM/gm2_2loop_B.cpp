@@ -18,8 +18,12 @@
 
 #include "THDM/gm2_2loop_helpers.hpp"
 #include "gm2_dilog.hpp"
+#include "gm2_dual.hpp"
 #include "gm2_ffunctions.hpp"
 #include "gm2_numerics.hpp"
+#include "gm2_profile_timer.hpp"
+
+#include <type_traits>
 
 /**
  * \file gm2_2loop_B.cpp
@@ -39,16 +43,27 @@ const double pi2 = 9.8696044010893586; // Pi^2
 
 const double eps_shift = 1e-8; // parameter shift to avoid spurious divergences
 
+// the functions below are templates, which are instantiated with
+// Real = double and Real = Dual<double>
+using std::log;
+using std::real;
+using std::sqrt;
+
+template <class Real>
+using Complex = typename Complex_type<Real>::type;
+
 /// shift value away from limit, if it is close to the limit
-void shift(double& val, double limit, double eps) noexcept
+template <class Real, class Limit>
+void shift(Real& val, const Limit& limit, double eps) noexcept
 {
-   if (is_equal_rel(val, limit, eps)) {
-      val = (1 + eps)*limit;
+   if (is_equal_rel(val, Real(limit), eps)) {
+      val = with_value(val, (1 + eps)*value_of(limit));
    }
 }
 
 /// Eq.(102), arxiv:1607.06292
-double YF1(double u, double w, double cw2) noexcept
+template <class Real>
+Real YF1(Real u, Real w, Real cw2) noexcept
 {
    shift(u, 1.0, eps_shift);
 
@@ -59,19 +74,20 @@ double YF1(double u, double w, double cw2) noexcept
    // Note: Phi(u,w,w) == 0.5*u/w*f_PS(w/u)*(u - 4*w)
 
    return
-      - 72*c0 - 36*c0*std::log(w)
-      + 9*(-8*cw4 - 3*u + 2*cw2*(4 + u))*(u + 2*w)/(2*(u - 1)*u)*std::log(u)
+      - 72*c0 - 36*c0*log(w)
+      + 9*(-8*cw4 - 3*u + 2*cw2*(4 + u))*(u + 2*w)/(2*(u - 1)*u)*log(u)
       + 9./2*(3 - 10*cw2 + 8*cw4)*(u + 2*w)/(u - 1)*f_PS(w)
       - 9./2*(8*cw4 + 3*u - 2*cw2*(4 + u))*(u + 2*w)/((u - 1)*u)*f_PS(w/u)
       ;
 }
 
 /// Eq.(121), arxiv:1607.06292
-double YFZ(double u, double cw2) noexcept
+template <class Real>
+Real YFZ(Real u, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
    const auto u2 = u*u;
-   const auto lu = std::log(u);
+   const auto lu = log(u);
    const auto li = dilog(1.0 - u);
    const auto phi = 0.5*u*f_PS(1/u)*(u - 4); // Phi(u,1,1);
 
@@ -79,7 +95,7 @@ double YFZ(double u, double cw2) noexcept
    const auto z2 = 5 - 12*cw2 + 8*cw4;       // Eq.(123)
    const auto z3 = 3*(1 - 3*cw2 + 2*cw4);    // Eq.(124)
 
-   const double res =
+   const Real res =
       + z1*u*li
       + z2/(2*u2)*(6*(-4 + u)*u + pi2*(4 + 3*u) + 6*u*(4 + u)*lu
                    - 6*(4 + 3*u)*li + 6*u*(2 + u)*phi)
@@ -90,7 +106,8 @@ double YFZ(double u, double cw2) noexcept
 }
 
 /// Eq.(125), arxiv:1607.06292
-double YFW(double u, double cw2) noexcept
+template <class Real>
+Real YFW(Real u, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
    const auto cw6 = cw4*cw2;
@@ -99,17 +116,18 @@ double YFW(double u, double cw2) noexcept
 
    // Note: Phi(u,cw2,cw2) == 0.5*u/cw2*f_PS(cw2/u)*(u - 4*cw2)
 
-   const double res =
+   const Real res =
       - 57.0/2*cw2 - 4*cw6*pi2/u2 + 3./4*cw4*(32 - 3*pi2)/u
       + 3./2*(16*cw6 + 9*cw4*u + 12*cw2*u2 - 19*u3)/u2*dilog(1.0 - u/cw2)
-      + 3./2*cw2*(16*cw2 + 19*u)/u*std::log(cw2/u)
+      + 3./2*cw2*(16*cw2 + 19*u)/u*log(cw2/u)
       - 3./4*(4*cw4 - 50*cw2*u + 19*u2)/cw2*f_PS(cw2/u);
 
    return res;
 }
 
 /// Eq.(105), arxiv:1607.06292
-double YF2(double u, double cw2) noexcept
+template <class Real>
+Real YF2(Real u, Real cw2) noexcept
 {
    shift(u, 4*cw2, eps_shift);
    shift(u, 1.0, eps_shift);
@@ -120,29 +138,29 @@ double YF2(double u, double cw2) noexcept
    const auto u2 = u*u;
    const auto u3 = u2*u;
 
-   const double f0 = 3.0/4*cw4*(-640 + 576*cw2 + 7*pi2);     // Eq.(106)
-   const double f1 = 96*cw6*(11 - 53*cw2 + 36*cw4);          // Eq.(107)
-   const double f2 = -3.0/4*cw2*(-66*cw2 - 48*cw4 + 672*cw6);// Eq.(108)
-   const double f3 = -3.0/4*cw2*(109 - 430*cw2 + 120*cw4);   // Eq.(109)
-   const double f4 = 96*cw6*(-11 + 9*cw2);                   // Eq.(110)
-   const double f5 = 45.0/2*cw4 + 192*cw6;                   // Eq.(111)
-   const double f6 = 3.0/4*cw2*(157 + 90*cw2);               // Eq.(112)
-   const double f7 = -3.0/4*(18 + 61*cw2);                   // Eq.(113)
-   const double f8 = -7 + 61*cw2 - 162*cw4 + 96*cw6;         // Eq.(114)
-   const double f9 = 1 - 5*cw2 + 10*cw4;                     // Eq.(115)
-   const double f10 = -1728*cw8*(-1 + cw2);                  // Eq.(116)
-   const double f11 = 3*cw6*(-899 + 768*cw2);                // Eq.(117)
-   const double f12 = 387*cw4 - 363*cw6;                     // Eq.(118)
-   const double f13 = 9.0/2*cw2*(57 + 106*cw2);              // Eq.(119)
-   const double f14 = -15.0/2*(7 + 45*cw2);                  // Eq.(120)
+   const Real f0 = 3.0/4*cw4*(-640 + 576*cw2 + 7*pi2);     // Eq.(106)
+   const Real f1 = 96*cw6*(11 - 53*cw2 + 36*cw4);          // Eq.(107)
+   const Real f2 = -3.0/4*cw2*(-66*cw2 - 48*cw4 + 672*cw6);// Eq.(108)
+   const Real f3 = -3.0/4*cw2*(109 - 430*cw2 + 120*cw4);   // Eq.(109)
+   const Real f4 = 96*cw6*(-11 + 9*cw2);                   // Eq.(110)
+   const Real f5 = 45.0/2*cw4 + 192*cw6;                   // Eq.(111)
+   const Real f6 = 3.0/4*cw2*(157 + 90*cw2);               // Eq.(112)
+   const Real f7 = -3.0/4*(18 + 61*cw2);                   // Eq.(113)
+   const Real f8 = -7 + 61*cw2 - 162*cw4 + 96*cw6;         // Eq.(114)
+   const Real f9 = 1 - 5*cw2 + 10*cw4;                     // Eq.(115)
+   const Real f10 = -1728*cw8*(-1 + cw2);                  // Eq.(116)
+   const Real f11 = 3*cw6*(-899 + 768*cw2);                // Eq.(117)
+   const Real f12 = 387*cw4 - 363*cw6;                     // Eq.(118)
+   const Real f13 = 9.0/2*cw2*(57 + 106*cw2);              // Eq.(119)
+   const Real f14 = -15.0/2*(7 + 45*cw2);                  // Eq.(120)
 
    // Note: Phi(cw2,cw2,1) == 0.5/cw2*f_PS(cw2)*(1 - 4*cw2)
    // Note: Phi(u,cw2,cw2) == 0.5*u/cw2*f_PS(cw2/u)*(u - 4*cw2)
 
-   const double res =
+   const Real res =
       + 8*cw6*pi2/u2 + f0/u + 393.0/8*cw2
-      + (f1/u + f2 + f3*u)*std::log(cw2)/((4*cw2-1)*(4*cw2-u))
-      + (f4/u + f5 + f6*u + f7*u2)*std::log(u)/((u-1)*(4*cw2-u))
+      + (f1/u + f2 + f3*u)*log(cw2)/((4*cw2-1)*(4*cw2-u))
+      + (f4/u + f5 + f6*u + f7*u2)*log(u)/((u-1)*(4*cw2-u))
       - 3.0/2*(32*cw6/u2 + 21*cw4/u + 15*cw2 - 35*u)*dilog(1.0 - u/cw2)
       + (f8 + f9*u)*9./4*(-3 + 4*cw2)*f_PS(cw2)/((1-4*cw2)*(u-1))
       + 0.5*(f10/u + f11 + f12*u + f13*u2 + f14*u3 + 105.0/2*u2*u2)*f_PS(cw2/u)
@@ -153,7 +171,8 @@ double YF2(double u, double cw2) noexcept
 }
 
 /// Eq.(126), arxiv:1607.06292
-double YF3(double u, double w, double cw2) noexcept
+template <class Real>
+Real YF3(Real u, Real w, Real cw2) noexcept
 {
    shift(u, 4*cw2, eps_shift);
    shift(w, cw2, eps_shift);
@@ -166,9 +185,9 @@ double YF3(double u, double w, double cw2) noexcept
    const auto u4 = u2*u2;
    const auto u5 = u4*u;
    const auto w2 = w*w;
-   const auto lc = std::log(cw2);
-   const auto lu = std::log(u);
-   const auto lw = std::log(w);
+   const auto lc = log(cw2);
+   const auto lu = log(u);
+   const auto lw = log(w);
 
    // Eq.(127)
    const auto a1 = -9*cw2*u3 + 9*cw2*u2*(3*cw2+w) + 27*cw4*u*(w-cw2)
@@ -193,7 +212,7 @@ double YF3(double u, double w, double cw2) noexcept
 
    // Note: Phi(u,cw2,cw2) == 0.5*u/cw2*f_PS(cw2/u)*(u - 4*cw2)
 
-   const double res =
+   const Real res =
       + 9*u*(2*cw2 - u + w)/w
       + (a1*(lu - lc) + 9*cw4*(cw4 - 4*cw2*w + 3*w2)*lc)*(lw - lc)/(2*w2*(cw2-w))
       + a2*lu/(w*(4*cw2-u))
@@ -208,7 +227,8 @@ double YF3(double u, double w, double cw2) noexcept
 }
 
 /// Eq.(72), arxiv:1607.06292
-double T0(double u, double w, double cw2) noexcept
+template <class Real>
+Real T0(Real u, Real w, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
 
@@ -218,7 +238,8 @@ double T0(double u, double w, double cw2) noexcept
 }
 
 /// Eq.(73), arxiv:1607.06292
-double T1(double u, double w, double cw2) noexcept
+template <class Real>
+Real T1(Real u, Real w, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
 
@@ -226,15 +247,16 @@ double T1(double u, double w, double cw2) noexcept
 }
 
 /// calculates potentially divergent (a^2 Log[a] - b^2 Log[b])/(a - b)
-double dxlog(double a, double b) noexcept
+template <class Real>
+Real dxlog(Real a, Real b) noexcept
 {
-   const double lb = std::log(b);
+   const Real lb = log(b);
 
    if (is_equal_rel(a, b, 1e-4)) {
       return b*(1 + 2*lb) + (a - b)*(1.5 + lb) + sqr(a - b)/(3*b);
    }
 
-   return (sqr(a)*std::log(a) - sqr(b)*lb)/(a - b);
+   return (sqr(a)*log(a) - sqr(b)*lb)/(a - b);
 }
 
 /**
@@ -243,7 +265,8 @@ double dxlog(double a, double b) noexcept
  *
  * (xA - xH)/(xA - xHp)*T2p[xA, xH] + T2m[xH, xHp] + T2p[xHp, xH] + T2p[xHp, xA]
  */
-double TX(double xH, double xA, double xHp, double cw2) noexcept
+template <class Real>
+Real TX(Real xH, Real xA, Real xHp, Real cw2) noexcept
 {
    const auto cw4 = sqr(cw2);
    const auto sw2 = 1.0 - cw2;
@@ -251,8 +274,8 @@ double TX(double xH, double xA, double xHp, double cw2) noexcept
    const auto f7 = 1 - 6*cw2 + 4*cw4;
    const auto f8 = (13 - 20*cw2 + 4*cw4)/(cw2*sw2);
    const auto f9 = 7 - 12*cw2 + 8*cw4;
-   const auto lH = std::log(xH);
-   const auto lA = std::log(xA);
+   const auto lH = log(xH);
+   const auto lA = log(xA);
    const auto xAH  = dxlog(xA, xH);
    const auto xAHp = dxlog(xA, xHp);
    const auto xHHp = dxlog(xH, xHp);
@@ -270,37 +293,40 @@ double TX(double xH, double xA, double xHp, double cw2) noexcept
 }
 
 /// Eq.(75), arxiv:1607.06292, prefactor (u-v) has been pulled out
-double T4(double u, double cw2, double xH, double xA) noexcept
+template <class Real>
+Real T4(Real u, Real cw2, Real xH, Real xA) noexcept
 {
    const auto cw4 = cw2*cw2;
    const auto sw2 = 1.0 - cw2;
    const auto f5 = cw2*(5 - 16*cw2 + 8*cw4)/sw2;
 
-   return std::log(u)/4*f5*(xA*(3 + 2*xH) - sqr(xA) + 3*xH - sqr(xH) - 3);
+   return log(u)/4*f5*(xA*(3 + 2*xH) - sqr(xA) + 3*xH - sqr(xH) - 3);
 }
 
 /// Eq.(76), arxiv:1607.06292
-double T5(double u, double w, double cw2) noexcept
+template <class Real>
+Real T5(Real u, Real w, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
    const auto sw2 = 1.0 - cw2;
    const auto f6 = (7 - 14*cw2 + 4*cw4)/(4*cw2*sw2);
    const auto f8 = (13 - 20*cw2 + 4*cw4)/(cw2*sw2);
 
-   return std::log(u)*(
+   return log(u)*(
       3.0/2*u + f6/cw2*(cube(u - w) + 3*cw2*sqr(u - w) + 3*cw4*(u - w))
       - 3.0/2*f8*u*(u - w) - cw2/2 - cw4);
 }
 
 /// Eq.(77), arxiv:1607.06292
-double T6(double u, double w, double cw2) noexcept
+template <class Real>
+Real T6(Real u, Real w, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
    const auto u2 = u*u;
 
    return 9.0/2*(
-      (u - w)*(u2 - 2*u*w + w*(w - cw2))/cw4*std::log(u/w)*std::log(w/cw2)
-      + std::log(cw2)/cw2*(2*u2 + u*(cw2 - 4*w) - w*(cw2 - 2*w)));
+      (u - w)*(u2 - 2*u*w + w*(w - cw2))/cw4*log(u/w)*log(w/cw2)
+      + log(cw2)/cw2*(2*u2 + u*(cw2 - 4*w) - w*(cw2 - 2*w)));
 }
 
 /**
@@ -308,39 +334,42 @@ double T6(double u, double w, double cw2) noexcept
  *
  * @note overall factor -1/2 is missing in arxiv:1607.06292v2
  */
-double T7(double u, double w, double cw2) noexcept
+template <class Real>
+Real T7(Real u, Real w, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
    const auto sw2 = 1.0 - cw2;
    const auto f5 = cw2*(5 - 16*cw2 + 8*cw4)/sw2;
-   const auto ra = std::complex<double>(1 + sqr(u - w) - 2*(u + w), 0.0);
-   const auto s1 = u + w - 1.0 + std::sqrt(ra); // Eq.(79)
+   const Complex<Real> ra(1 + sqr(u - w) - 2*(u + w));
+   const auto s1 = u + w - 1.0 + sqrt(ra); // Eq.(79)
 
    const auto res =
-      -0.5*f5*(2*(u + w) - sqr(u - w) - 1)*std::log(s1/(2*std::sqrt(u*w)))
+      -0.5*f5*(2*(u + w) - sqr(u - w) - 1)*log(s1/(2*sqrt(u*w)))
       *(u + w - 1 - 4*u*w/s1);
 
-   return std::real(res);
+   return real(res);
 }
 
 /// Eq.(80), arxiv:1607.06292
-double T8(double u, double w, double cw2) noexcept
+template <class Real>
+Real T8(Real u, Real w, Real cw2) noexcept
 {
    const auto cw4 = cw2*cw2;
    const auto sw2 = 1.0 - cw2;
    const auto f6 = (7 - 14*cw2 + 4*cw4)/(4*cw2*sw2);
-   const auto ra = std::complex<double>(sqr(u + w - cw2) - 4*u*w, 0.0);
-   const auto s2 = u + w - cw2 + std::sqrt(ra); // Eq.(81)
+   const Complex<Real> ra(sqr(u + w - cw2) - 4*u*w);
+   const auto s2 = u + w - cw2 + sqrt(ra); // Eq.(81)
 
    const auto res =
-      2.0*f6*(4*u*w - sqr(u + w - cw2))*std::log(s2/(2*std::sqrt(u*w)))
+      2.0*f6*(4*u*w - sqr(u + w - cw2))*log(s2/(2*sqrt(u*w)))
       *((u + w)/cw2 - 4.0*u*w/(cw2*s2) - 1.0);
 
-   return std::real(res);
+   return real(res);
 }
 
 /// Eq.(103), arxiv:1607.06292
-double T9(double u, double w, double cw2) noexcept
+template <class Real>
+Real T9(Real u, Real w, Real cw2) noexcept
 {
    shift(w, cw2, eps_shift);
 
@@ -358,14 +387,15 @@ double T9(double u, double w, double cw2) noexcept
 }
 
 /// Eq.(104), arxiv:1607.06292
-double T10(double u, double w, double cw2) noexcept
+template <class Real>
+Real T10(Real u, Real w, Real cw2) noexcept
 {
    shift(w, cw2, eps_shift);
 
    const auto u2 = u*u;
    const auto w2 = w*w;
-   const auto lwu = std::log(w/u);
-   const auto lwc = std::log(w/cw2);
+   const auto lwu = log(w/u);
+   const auto lwc = log(w/cw2);
 
    return
       (u2 - cw2*w - 2*u*w + w2)/(2*(cw2-w))*lwu*lwc
@@ -374,19 +404,22 @@ double T10(double u, double w, double cw2) noexcept
 }
 
 /// Eq.(99), arxiv:1607.06292
-double fb(double u, double w, double al, double cw2) noexcept
+template <class Real>
+Real fb(Real u, Real w, Real al, Real cw2) noexcept
 {
    return al*pi/(cw2*(-1.0 + cw2))*(u + 2*w);
 }
 
 /// Eq.(100), arxiv:1607.06292
-double Fm0(double u, double w, double al, double cw2) noexcept
+template <class Real>
+Real Fm0(Real u, Real w, Real al, Real cw2) noexcept
 {
    return 1.0/(al*pi) * cw2*(-1 + cw2)/(u + 2*w) * YF1(u,w,cw2);
 }
 
 /// Eq.(101), arxiv:1607.06292
-double Fmp(double u, double w, double al, double cw2) noexcept
+template <class Real>
+Real Fmp(Real u, Real w, Real al, Real cw2) noexcept
 {
    return (-9*(-1 + cw2))/(al*pi) * (T9(u,w,cw2)/2 + T10(u,w,cw2));
 }
@@ -398,38 +431,41 @@ double Fmp(double u, double w, double al, double cw2) noexcept
  *
  * Eq (49), arxiv:1607.06292
  */
-double amu2L_B_EWadd(const THDM_B_parameters& thdm) noexcept
+template <class Real>
+Real amu2L_B_EWadd(const Basic_THDM_B_parameters<Real>& thdm) noexcept
 {
+   const Profile_timer timer(Profile_id::amu2L_B_EWadd, std::is_same<Real,double>::value);
+
    const double zeta2 = 1.6449340668482264; // Zeta[2]
-   const double mw2 = sqr(thdm.mw);
-   const double mz2 = sqr(thdm.mz);
-   const double cw2 = mw2/mz2;
-   const double cw4  = cw2*cw2;
-   const double cw6  = cw4*cw2;
-   const double cw8  = cw4*cw4;
-   const double cw10 = cw8*cw2;
-   const double cw12 = cw8*cw4;
-   const double cw14 = cw8*cw6;
-   const double mh2 = sqr(thdm.mh(0));
-   const double xh_ = mh2/mz2; // temporary value
-   const double xh = is_equal_rel(1.0, xh_, eps_shift) ? xh_*(1 + eps_shift) : xh_;
-   const double xw = xh/cw2;
-   const double lh = std::log(xh);
-   const double lw = std::log(cw2);
-   const double liw = dilog(1 - xw);
-   const double lih = dilog(1 - xh);
-   const double lh2 = lh*lh;
-   const double phi1 = 3*xh*f_PS(1/xh)*(xh - 4); // Phi(xh,1,1) == 0.5*xh*f_PS(1/xh)*(xh - 4)
-   const double phi3 = 6*(-liw + zeta2);
-   const double phi4 = 6*(lh2/2 + 2*lih + zeta2);
-   const double phi5 = 3/cw2*f_PS(cw2); // Phi(cw2,cw2,1) == 0.5/cw2*f_PS(cw2)*(1 - 4*cw2)
-   const double phi6 = 6*(-lih + zeta2);
-   const double phi7 = 3*cw2*xw*f_PS(1/xw)*(xw - 4); // Phi(xw,1,1) == 0.5*xw*f_PS(1/xw)*(xw - 4)
-
-   const double xm2 = 256*(32*cw10 - 5*cw4 + 32*cw6 - 56*cw8)*phi6
+   const Real mw2 = sqr(thdm.mw);
+   const Real mz2 = sqr(thdm.mz);
+   const Real cw2 = mw2/mz2;
+   const Real cw4  = cw2*cw2;
+   const Real cw6  = cw4*cw2;
+   const Real cw8  = cw4*cw4;
+   const Real cw10 = cw8*cw2;
+   const Real cw12 = cw8*cw4;
+   const Real cw14 = cw8*cw6;
+   const Real mh2 = sqr(thdm.mh(0));
+   const Real xh_ = mh2/mz2; // temporary value
+   const Real xh = is_equal_rel(1.0, xh_, eps_shift) ? xh_*(1 + eps_shift) : xh_;
+   const Real xw = xh/cw2;
+   const Real lh = log(xh);
+   const Real lw = log(cw2);
+   const Real liw = dilog(1 - xw);
+   const Real lih = dilog(1 - xh);
+   const Real lh2 = lh*lh;
+   const Real phi1 = 3*xh*f_PS(1/xh)*(xh - 4); // Phi(xh,1,1) == 0.5*xh*f_PS(1/xh)*(xh - 4)
+   const Real phi3 = 6*(-liw + zeta2);
+   const Real phi4 = 6*(lh2/2 + 2*lih + zeta2);
+   const Real phi5 = 3/cw2*f_PS(cw2); // Phi(cw2,cw2,1) == 0.5/cw2*f_PS(cw2)*(1 - 4*cw2)
+   const Real phi6 = 6*(-lih + zeta2);
+   const Real phi7 = 3*cw2*xw*f_PS(1/xw)*(xw - 4); // Phi(xw,1,1) == 0.5*xw*f_PS(1/xw)*(xw - 4)
+
+   const Real xm2 = 256*(32*cw10 - 5*cw4 + 32*cw6 - 56*cw8)*phi6
       - 2304*(5*cw10 - 4*cw12 - cw8)*phi7 - 512*(cw10 - 4*cw12)*phi3;
 
-   const double xm1 = 64*(24*(144*cw12 + 5*cw4 - 32*cw6 + 94*cw8) -
+   const Real xm1 = 64*(24*(144*cw12 + 5*cw4 - 32*cw6 + 94*cw8) -
       2*((5*cw4 - 32*cw6)*(12*lh + phi1) +
          8*cw10*(330 + 147*lw - 195*lh - 4*phi1 - phi3) +
          16*cw12*(-54*lw + 54*lh + phi3) +
@@ -437,7 +473,7 @@ double amu2L_B_EWadd(const THDM_B_parameters& thdm) noexcept
       (-32*cw10 + 10*cw2 - 59*cw4 + 80*cw6 - 8*cw8)*phi6) -
       4*(3072*cw10 + 907*cw6 - 4396*cw8)*phi7;
 
-   const double x0 = 96*(730*cw10 - 936*cw12 + 384*cw14 + 21*cw6 - 211*cw8)*phi5 +
+   const Real x0 = 96*(730*cw10 - 936*cw12 + 384*cw14 + 21*cw6 - 211*cw8)*phi5 +
     4*(231*cw4 - 1037*cw6 + 452*cw8)*phi7 +
     16*(-837*cw6 + 852*cw8 + 6672*cw10*lw - 6912*cw12*(2 + lw) +
        20*cw2*(-12 + 12*lh + phi1) - 5*phi6 + 22*cw2*phi6 -
@@ -446,7 +482,7 @@ double amu2L_B_EWadd(const THDM_B_parameters& thdm) noexcept
        4*cw8*(306*lw - 141*lh + 24*phi1 - 2*phi3 + 184*phi6 - 6*pi2) +
        cw6*(-561*lw + 1089*lh + 96*phi1 + 4*phi3 - 464*phi6 + 6*pi2));
 
-   const double x1 = 32*cw2*(54 + 6*lh + 3*phi1 - 19*phi6) + 90*cw2*phi7 +
+   const Real x1 = 32*cw2*(54 + 6*lh + 3*phi1 - 19*phi6) + 90*cw2*phi7 +
     64*cw10*(1824 + 684*lw + 384*lh - 128*phi1 + 627*phi5 - 128*phi6 +
        128*pi2) - 4*(120*lh + 10*phi1 + 3648*cw12*phi5 - 5*(24 + phi6) +
        16*cw8*(2853 + 768*lw + 291*lh - 240*phi1 - 4*phi3 + 519*phi5 -
@@ -456,7 +492,7 @@ double amu2L_B_EWadd(const THDM_B_parameters& thdm) noexcept
         (3939 + 780*lw - 1158*lh - 560*phi1 - 138*phi3 + 615*phi5 - 808*phi6 -
           57*phi7 + 598*pi2));
 
-   const double x2 = cw2*(3867 + 426*lw - 2106*lh - 1392*lh2 - 672*phi1 - 262*phi3 +
+   const Real x2 = cw2*(3867 + 426*lw - 2106*lh - 1392*lh2 - 672*phi1 - 262*phi3 +
        464*phi4 + 126*phi5 - 70*phi7 - 586*pi2) -
     128*cw10*(144 + 288*lh - 96*lh2 - 72*phi1 + 128*phi4 - 3*phi5 - 32*pi2) +
     2*cw4*(-5322 - 144*lw + 1434*lh + 2472*lh2 + 1392*phi1 + 256*phi3 -
@@ -466,7 +502,7 @@ double amu2L_B_EWadd(const THDM_B_parameters& thdm) noexcept
           320*(-3 + pi2)) + cw6*(-4104 + 696*lw + 2892*lh + 48*lh2 - 192*phi1 -
           536*phi3 + 2672*phi4 - 867*phi5 + 672*pi2));
 
-   const double x3 = -24 - 60*lh + 102*lh2 + 68*phi1 - 3072*cw10*phi1 + 32*phi3 -
+   const Real x3 = -24 - 60*lh + 102*lh2 + 68*phi1 - 3072*cw10*phi1 + 32*phi3 -
     34*phi4 + 15360*cw10*phi4 - 6*(3*cw2 - 19*cw4 + 50*cw6 - 40*cw8)*phi5 +
     32*phi7 - 16*cw6*(45*lw + 8*(123 + 240*lh - 78*lh2 - 38*phi1 + 5*phi4 -
           26*pi2)) + 4*cw4*(1683 + 417*lw + 3222*lh - 1056*lh2 - 688*phi1 -
@@ -475,20 +511,20 @@ double amu2L_B_EWadd(const THDM_B_parameters& thdm) noexcept
     cw2*(747 + 426*lw + 1350*lh - 120*lh2 - 112*phi1 - 134*phi3 + 808*phi4 +
        128*phi7 + 94*pi2);
 
-   const double x4 = -2*(-72 - 144*lh + 51*lh2 + 36*phi1 + 16*phi3 - 65*phi4 +
+   const Real x4 = -2*(-72 - 144*lh + 51*lh2 + 36*phi1 + 16*phi3 - 65*phi4 +
       1536*cw10*phi4 + 32*(-24*cw8*phi1 + 36*cw8*phi4 +
          cw6*(18 + 36*lh - 12*lh2 + 33*phi1 - 152*phi4 - 4*pi2)) -
       8*cw4*(126 + 252*lh - 84*lh2 + 21*phi1 - 284*phi4 - 28*pi2) +
       4*cw2*(126 + 252*lh - 87*lh2 - 39*phi1 - 16*phi3 - 7*phi4 - 13*pi2) + pi2);
 
-   const double x5 = 24*((-5 + 27*cw2 - 14*cw4 - 72*cw6 + 64*cw8)*phi4
+   const Real x5 = 24*((-5 + 27*cw2 - 14*cw4 - 72*cw6 + 64*cw8)*phi4
       + (1 - 7*cw2 + 14*cw4 - 8*cw6)*phi1);
 
-   const double x6 = -24*(-1 + 7*cw2 - 14*cw4 + 8*cw6)*phi4;
+   const Real x6 = -24*(-1 + 7*cw2 - 14*cw4 + 8*cw6)*phi4;
 
-   const double res = (xm2/xh + xm1)/xh + x0 + xh*(x1 + xh*(x2 + xh*(x3 + xh*(x4 + xh*(x5 + xh*x6)))));
+   const Real res = (xm2/xh + xm1)/xh + x0 + xh*(x1 + xh*(x2 + xh*(x3 + xh*(x4 + xh*(x5 + xh*x6)))));
 
-   const double pref = sqr(thdm.alpha_em*thdm.mm/(48*thdm.mz*pi*cw2*(4*cw2 - xh)*(1 - cw2)))
+   const Real pref = sqr(thdm.alpha_em*thdm.mm/(48*thdm.mz*pi*cw2*(4*cw2 - xh)*(1 - cw2)))
       /(2*(-1 + 4*cw2)*(-1 + xh));
 
    return pref * res * thdm.cos_beta_minus_alpha * thdm.zetal;
@@ -499,8 +535,11 @@ double amu2L_B_EWadd(const THDM_B_parameters& thdm) noexcept
  *
  * Eq (71), arxiv:1607.06292
  */
-double amu2L_B_nonYuk(const THDM_B_parameters& thdm) noexcept
+template <class Real>
+Real amu2L_B_nonYuk(const Basic_THDM_B_parameters<Real>& thdm) noexcept
 {
+   const Profile_timer timer(Profile_id::amu2L_B_nonYuk, std::is_same<Real,double>::value);
+
    const auto mw2 = sqr(thdm.mw);
    const auto mz2 = sqr(thdm.mz);
    const auto cw2 = mw2/mz2;
@@ -522,7 +561,7 @@ double amu2L_B_nonYuk(const THDM_B_parameters& thdm) noexcept
    const auto f4 = 13.0/2 - 15*cw2 + 10*cw4;
    const auto f5 = cw2*(5 - 16*cw2 + 8*cw4)/sw2;
 
-   const double res =
+   const Real res =
       + TX(xH, xA, xHp, cw2)
       + (xA - xH)*(T4(xA, cw2, xH, xA) - T4(xH, cw2, xH, xA))
       + T5(xHp, xH, cw2)
@@ -557,8 +596,11 @@ double amu2L_B_nonYuk(const THDM_B_parameters& thdm) noexcept
  *
  * Eq (52), arxiv:1607.06292
  */
-double amu2L_B_Yuk(const THDM_B_parameters& thdm) noexcept
+template <class Real>
+Real amu2L_B_Yuk(const Basic_THDM_B_parameters<Real>& thdm) noexcept
 {
+   const Profile_timer timer(Profile_id::amu2L_B_Yuk, std::is_same<Real,double>::value);
+
    const auto tb = thdm.tb;
    const auto sc = tb - 1.0/tb;
    const auto zetal = thdm.zetal;
@@ -580,7 +622,7 @@ double amu2L_B_Yuk(const THDM_B_parameters& thdm) noexcept
    // Eq.(91), arxiv:1607.06292
    const auto a000 = fb(xhSM, xHp, al, cw2)*Fm0(xhSM, xHp, al, cw2);
    // Eq.(92), arxiv:1607.06292
-   const auto a0z0 = -fb(xH, 0.0, al, cw2)*(
+   const auto a0z0 = -fb(xH, Real(0), al, cw2)*(
       Fm0(xH, xHp, al, cw2) + Fmp(xH, xHp, al, cw2));
    // Eq.(93), arxiv:1607.06292
    const auto a500 = Fm0(xhSM, xHp, al, cw2);
@@ -589,8 +631,8 @@ double amu2L_B_Yuk(const THDM_B_parameters& thdm) noexcept
       Fm0(xH, xHp, al, cw2) + Fmp(xH, xHp, al, cw2));
    // Eq.(95), arxiv:1607.06292
    const auto a001 =
-      + fb(xH, 0.0, al, cw2)*Fm0(xH, xHp, al, cw2)
-      - fb(xhSM, 0.0, al, cw2)*Fm0(xhSM, xHp, al, cw2);
+      + fb(xH, Real(0), al, cw2)*Fm0(xH, xHp, al, cw2)
+      - fb(xhSM, Real(0), al, cw2)*Fm0(xhSM, xHp, al, cw2);
    // Eq.(96), arxiv:1607.06292
    const auto a0z1 =
       - (
@@ -618,7 +660,7 @@ double amu2L_B_Yuk(const THDM_B_parameters& thdm) noexcept
       + Fm0(xhSM, xHp, al, cw2)
       + Fmp(xhSM, xHp, al, cw2);
 
-   const double res =
+   const Real res =
       + a000
       + a0z0*sc*zetal
       + a500*lambda5
@@ -640,11 +682,22 @@ double amu2L_B_Yuk(const THDM_B_parameters& thdm) noexcept
  *
  * Eq (48), arxiv:1607.06292
  */
-double amu2L_B(const THDM_B_parameters& thdm) noexcept
+template <class Real>
+Real amu2L_B(const Basic_THDM_B_parameters<Real>& thdm) noexcept
 {
    return amu2L_B_EWadd(thdm) + amu2L_B_nonYuk(thdm) + amu2L_B_Yuk(thdm);
 }
 
+template double amu2L_B(const Basic_THDM_B_parameters<double>&) noexcept;
+template double amu2L_B_EWadd(const Basic_THDM_B_parameters<double>&) noexcept;
+template double amu2L_B_nonYuk(const Basic_THDM_B_parameters<double>&) noexcept;
+template double amu2L_B_Yuk(const Basic_THDM_B_parameters<double>&) noexcept;
+
+template Dual<double> amu2L_B(const Basic_THDM_B_parameters<Dual<double>>&) noexcept;
+template Dual<double> amu2L_B_EWadd(const Basic_THDM_B_parameters<Dual<double>>&) noexcept;
+template Dual<double> amu2L_B_nonYuk(const Basic_THDM_B_parameters<Dual<double>>&) noexcept;
+template Dual<double> amu2L_B_Yuk(const Basic_THDM_B_parameters<Dual<double>>&) noexcept;
+
 } // namespace thdm
 
 } // namespace gm2calc
@@ -18,10 +18,14 @@
 
 #include "THDM/gm2_2loop_helpers.hpp"
 #include "gm2_dilog.hpp"
+#include "gm2_dual.hpp"
 #include "gm2_ffunctions.hpp"
+#include "gm2_numerics.hpp"
+#include "gm2_profile_timer.hpp"
 
 #include <cmath>
 #include <limits>
+#include <type_traits>
 
 /**
  * \file gm2_2loop_F.cpp
@@ -36,9 +40,10 @@ namespace thdm {
 
 namespace {
 
+template <class Real>
 struct F_sm_pars {
-   double mw2{}; ///< squared W boson mass
-   double mz2{}; ///< squared Z boson mass
+   Real mw2{}; ///< squared W boson mass
+   Real mz2{}; ///< squared Z boson mass
 };
 
 struct F_neut_pars {
@@ -65,49 +70,57 @@ const double t3_u = +0.5;     ///< SU(2)_L charge of up-type quark
 const double t3_d = -0.5;     ///< SU(2)_L charge of down-type quark
 const double t3_l = -0.5;     ///< SU(2)_L charge of charged lepton
 
-double sqr(double x) noexcept { return x*x; }
+// the functions below are templates, which are instantiated with
+// Real = double and Real = Dual<double>
+using std::conj;
+using std::real;
 
-double calc_v2(const THDM_F_parameters& thdm) noexcept
+template <class Real>
+Real calc_v2(const Basic_THDM_F_parameters<Real>& thdm) noexcept
 {
-   const double mw2 = sqr(thdm.mw);
-   const double mz2 = sqr(thdm.mz);
-   const double sw2 = 1.0 - mw2/mz2;
-   const double e2 = 4*pi*thdm.alpha_em;
-   const double g22 = e2/sw2;
+   const Real mw2 = sqr(thdm.mw);
+   const Real mz2 = sqr(thdm.mz);
+   const Real sw2 = 1.0 - mw2/mz2;
+   const Real e2 = 4*pi*thdm.alpha_em;
+   const Real g22 = e2/sw2;
    return 4*mw2/g22;
 }
 
 /// Eq (56), arxiv:1607.06292, S = h or H
-double FH(double ms2, double mf2) noexcept
+template <class Real>
+Real FH(const Real& ms2, const Real& mf2) noexcept
 {
-   const double x = mf2/ms2;
+   const Real x = mf2/ms2;
    return 0.5/x*f_S(x);
 }
 
 /// Eq (57), arxiv:1607.06292, S = A
-double FA(double ms2, double mf2) noexcept
+template <class Real>
+Real FA(const Real& ms2, const Real& mf2) noexcept
 {
-   const double x = mf2/ms2;
+   const Real x = mf2/ms2;
    return 0.5/x*f_PS(x);
 }
 
-double FHZ(double mf2, double ms2, double mz2) noexcept
+template <class Real>
+Real FHZ(const Real& mf2, const Real& ms2, const Real& mz2) noexcept
 {
-   const double x = mf2/ms2;
-   const double y = mf2/mz2;
+   const Real x = mf2/ms2;
+   const Real y = mf2/mz2;
    return FSZ(x, y);
 }
 
-double FAZ(double mf2, double ms2, double mz2) noexcept
+template <class Real>
+Real FAZ(const Real& mf2, const Real& ms2, const Real& mz2) noexcept
 {
-   const double x = mf2/ms2;
-   const double y = mf2/mz2;
+   const Real x = mf2/ms2;
+   const Real y = mf2/mz2;
    return FPZ(x, y);
 }
 
 /// Eq (54), arxiv:1607.06292, S = h or H
-template <typename F>
-double fSgamma(double ms2, double mf2, const F_neut_pars& pars, F FH) noexcept
+template <class Real, typename F>
+Real fSgamma(const Real& ms2, const Real& mf2, const F_neut_pars& pars, F FH) noexcept
 {
    const double qf2 = sqr(pars.qf);
    const double nc = pars.nc;
@@ -116,18 +129,18 @@ double fSgamma(double ms2, double mf2, const F_neut_pars& pars, F FH) noexcept
 }
 
 /// Eq (55), arxiv:1607.06292, S = h or H
-template <typename F>
-double fSZ(double ms2, double mf2, const F_neut_pars& pars, const F_sm_pars& sm, F FHZ) noexcept
+template <class Real, typename F>
+Real fSZ(const Real& ms2, const Real& mf2, const F_neut_pars& pars, const F_sm_pars<Real>& sm, F FHZ) noexcept
 {
-   const double mw2 = sm.mw2;
-   const double mz2 = sm.mz2;
-   const double cw2 = mw2/mz2;
-   const double sw2 = 1.0 - cw2;
+   const Real mw2 = sm.mw2;
+   const Real mz2 = sm.mz2;
+   const Real cw2 = mw2/mz2;
+   const Real sw2 = 1.0 - cw2;
    const double qf = pars.qf;
    const double ql = pars.ql;
    const double nc = pars.nc;
-   const double gvf = 0.5*pars.t3f - qf*sw2;
-   const double gvl = 0.5*pars.t3l - ql*sw2;
+   const Real gvf = 0.5*pars.t3f - qf*sw2;
+   const Real gvl = 0.5*pars.t3l - ql*sw2;
 
    // Note: 0.5*FHZ(mf2, ms2, mz2) = -mf2/(ms2 - mz2) * (FH(ms2, mf2) - FH(mz2, mf2))
    // with FH = {f_S, f_PS}
@@ -136,175 +149,245 @@ double fSZ(double ms2, double mf2, const F_neut_pars& pars, const F_sm_pars& sm,
 }
 
 /// Eq (53), arxiv:1607.06292, S = h or H
-template <typename F, typename FZ>
-double ffS(double ms2, double mf2, const F_neut_pars& pars, const F_sm_pars& sm, F FH, FZ FHZ) noexcept
+template <class Real, typename F, typename FZ>
+Real ffS(const Real& ms2, const Real& mf2, const F_neut_pars& pars, const F_sm_pars<Real>& sm, F FH, FZ FHZ) noexcept
 {
    return fSgamma(ms2, mf2, pars, FH) + fSZ(ms2, mf2, pars, sm, FHZ);
 }
 
 /// Eq (59), arxiv:1607.06292, S = H^\pm, f = l
-double flHp(double ms2, double ml2, const F_char_pars& pars, const F_sm_pars& sm) noexcept
+template <class Real>
+Real flHp(const Real& ms2, const Real& ml2, const F_char_pars& pars, const F_sm_pars<Real>& sm) noexcept
 {
-   const double mw2 = sm.mw2;
+   const Real mw2 = sm.mw2;
    const double nc = pars.nc;
-   const double x = ml2/ms2;
-   const double y = ml2/mw2;
+   const Real x = ml2/ms2;
+   const Real y = ml2/mw2;
 
    return -nc*FCWl(x, y);
 }
 
 /// Eq (59), arxiv:1607.06292, S = H^\pm, f = u
-double fuHp(double ms2, double md2, double mu2, const F_char_pars& pars, const F_sm_pars& sm) noexcept
+template <class Real>
+Real fuHp(const Real& ms2, const Real& md2, const Real& mu2, const F_char_pars& pars, const F_sm_pars<Real>& sm) noexcept
 {
-   const double mw2 = sm.mw2;
+   const Real mw2 = sm.mw2;
    const double qd = pars.qd;
    const double qu = pars.qu;
    const double nc = pars.nc;
-   const double xu = mu2/ms2;
-   const double xd = md2/ms2;
-   const double yu = mu2/mw2;
-   const double yd = md2/mw2;
+   const Real xu = mu2/ms2;
+   const Real xd = md2/ms2;
+   const Real yu = mu2/mw2;
+   const Real yd = md2/mw2;
 
    return -nc*FCWu(xu, xd, yu, yd, qu, qd);
 }
 
 /// Eq (59), arxiv:1607.06292, S = H^\pm, f = d
-double fdHp(double ms2, double md2, double mu2, const F_char_pars& pars, const F_sm_pars& sm) noexcept
+template <class Real>
+Real fdHp(const Real& ms2, const Real& md2, const Real& mu2, const F_char_pars& pars, const F_sm_pars<Real>& sm) noexcept
 {
-   const double mw2 = sm.mw2;
+   const Real mw2 = sm.mw2;
    const double qd = pars.qd;
    const double qu = pars.qu;
    const double nc = pars.nc;
-   const double xu = mu2/ms2;
-   const double xd = md2/ms2;
-   const double yu = mu2/mw2;
-   const double yd = md2/mw2;
+   const Real xu = mu2/ms2;
+   const Real xd = md2/ms2;
+   const Real yu = mu2/mw2;
+   const Real yd = md2/mw2;
 
    return -nc*FCWd(xu, xd, yu, yd, qu, qd);
 }
 
-} // anonymous namespace
 
 /// Eq (53), arxiv:1607.06292, f = u, S = h or H
-double fuS(double ms2, double mu2, double mw2, double mz2) noexcept
+template <class Real>
+Real fuS_impl(const Real& ms2, const Real& mu2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_neut_pars pars{q_u, q_l, t3_u, t3_l, 3.0};
-   const F_sm_pars sm{ mw2, mz2 };
-   const auto lFH = [] (double ms2, double mu2) { return FH(ms2, mu2); };
-   const auto lFHZ = [] (double mf2, double ms2, double mz2) { return FHZ(mf2, ms2, mz2); };
+   const F_sm_pars<Real> sm{ mw2, mz2 };
+   const auto lFH = [] (const Real& ms2, const Real& mu2) { return FH(ms2, mu2); };
+   const auto lFHZ = [] (const Real& mf2, const Real& ms2, const Real& mz2) { return FHZ(mf2, ms2, mz2); };
 
    return ffS(ms2, mu2, pars, sm, lFH, lFHZ);
 }
 
 /// Eq (53), arxiv:1607.06292, f = d, S = h or H
-double fdS(double ms2, double md2, double mw2, double mz2) noexcept
+template <class Real>
+Real fdS_impl(const Real& ms2, const Real& md2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_neut_pars pars{q_d, q_l, t3_d, t3_l, 3.0};
-   const F_sm_pars sm{ mw2, mz2 };
-   const auto lFH = [] (double ms2, double md2) { return FH(ms2, md2); };
-   const auto lFHZ = [] (double mf2, double ms2, double mz2) { return FHZ(mf2, ms2, mz2); };
+   const F_sm_pars<Real> sm{ mw2, mz2 };
+   const auto lFH = [] (const Real& ms2, const Real& md2) { return FH(ms2, md2); };
+   const auto lFHZ = [] (const Real& mf2, const Real& ms2, const Real& mz2) { return FHZ(mf2, ms2, mz2); };
 
    return ffS(ms2, md2, pars, sm, lFH, lFHZ);
 }
 
 /// Eq (53), arxiv:1607.06292, f = l, S = h or H
-double flS(double ms2, double ml2, double mw2, double mz2) noexcept
+template <class Real>
+Real flS_impl(const Real& ms2, const Real& ml2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_neut_pars pars{q_l, q_l, t3_l, t3_l, 1.0};
-   const F_sm_pars sm{ mw2, mz2 };
-   const auto lFH = [] (double ms2, double ml2) { return FH(ms2, ml2); };
-   const auto lFHZ = [] (double mf2, double ms2, double mz2) { return FHZ(mf2, ms2, mz2); };
+   const F_sm_pars<Real> sm{ mw2, mz2 };
+   const auto lFH = [] (const Real& ms2, const Real& ml2) { return FH(ms2, ml2); };
+   const auto lFHZ = [] (const Real& mf2, const Real& ms2, const Real& mz2) { return FHZ(mf2, ms2, mz2); };
 
    return ffS(ms2, ml2, pars, sm, lFH, lFHZ);
 }
 
 /// Eq (53), arxiv:1607.06292, f = u, S = A
-double fuA(double ms2, double mu2, double mw2, double mz2) noexcept
+template <class Real>
+Real fuA_impl(const Real& ms2, const Real& mu2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_neut_pars pars{q_u, q_l, t3_u, t3_l, 3.0};
-   const F_sm_pars sm{ mw2, mz2 };
-   const auto lFA = [] (double ms2, double mu2) { return FA(ms2, mu2); };
-   const auto lFAZ = [] (double mf2, double ms2, double mz2) { return FAZ(mf2, ms2, mz2); };
+   const F_sm_pars<Real> sm{ mw2, mz2 };
+   const auto lFA = [] (const Real& ms2, const Real& mu2) { return FA(ms2, mu2); };
+   const auto lFAZ = [] (const Real& mf2, const Real& ms2, const Real& mz2) { return FAZ(mf2, ms2, mz2); };
 
    return ffS(ms2, mu2, pars, sm, lFA, lFAZ);
 }
 
 /// Eq (53), arxiv:1607.06292, f = d, S = A
-double fdA(double ms2, double md2, double mw2, double mz2) noexcept
+template <class Real>
+Real fdA_impl(const Real& ms2, const Real& md2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_neut_pars pars{q_d, q_l, t3_d, t3_l, 3.0};
-   const F_sm_pars sm{ mw2, mz2 };
-   const auto lFA = [] (double ms2, double md2) { return FA(ms2, md2); };
-   const auto lFAZ = [] (double mf2, double ms2, double mz2) { return FAZ(mf2, ms2, mz2); };
+   const F_sm_pars<Real> sm{ mw2, mz2 };
+   const auto lFA = [] (const Real& ms2, const Real& md2) { return FA(ms2, md2); };
+   const auto lFAZ = [] (const Real& mf2, const Real& ms2, const Real& mz2) { return FAZ(mf2, ms2, mz2); };
 
    return ffS(ms2, md2, pars, sm, lFA, lFAZ);
 }
 
 /// Eq (53), arxiv:1607.06292, f = l, S = A
-double flA(double ms2, double ml2, double mw2, double mz2) noexcept
+template <class Real>
+Real flA_impl(const Real& ms2, const Real& ml2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_neut_pars pars{q_l, q_l, t3_l, t3_l, 1.0};
-   const F_sm_pars sm{mw2, mz2};
-   const auto lFA = [] (double ms2, double ml2) { return FA(ms2, ml2); };
-   const auto lFAZ = [] (double mf2, double ms2, double mz2) { return FAZ(mf2, ms2, mz2); };
+   const F_sm_pars<Real> sm{mw2, mz2};
+   const auto lFA = [] (const Real& ms2, const Real& ml2) { return FA(ms2, ml2); };
+   const auto lFAZ = [] (const Real& mf2, const Real& ms2, const Real& mz2) { return FAZ(mf2, ms2, mz2); };
 
    return ffS(ms2, ml2, pars, sm, lFA, lFAZ);
 }
 
 /// Eq (59), arxiv:1607.06292, S = H^\pm, f = u
-double fuHp(double ms2, double md2, double mu2, double mw2, double mz2) noexcept
+template <class Real>
+Real fuHp_impl(const Real& ms2, const Real& md2, const Real& mu2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_char_pars pars{q_d, q_u, 3.0};
-   const F_sm_pars sm{mw2, mz2};
+   const F_sm_pars<Real> sm{mw2, mz2};
    return fuHp(ms2, md2, mu2, pars, sm);
 }
 
 /// Eq (59), arxiv:1607.06292, S = H^\pm, f = d
-double fdHp(double ms2, double md2, double mu2, double mw2, double mz2) noexcept
+template <class Real>
+Real fdHp_impl(const Real& ms2, const Real& md2, const Real& mu2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_char_pars pars{q_d, q_u, 3.0};
-   const F_sm_pars sm{mw2, mz2};
+   const F_sm_pars<Real> sm{mw2, mz2};
    return fdHp(ms2, md2, mu2, pars, sm);
 }
 
 /// Eq (59), arxiv:1607.06292, S = H^\pm, f = l
-double flHp(double ms2, double ml2, double mw2, double mz2) noexcept
+template <class Real>
+Real flHp_impl(const Real& ms2, const Real& ml2, const Real& mw2, const Real& mz2) noexcept
 {
    const F_char_pars pars{q_l, q_v, 1.0};
-   const F_sm_pars sm{mw2, mz2};
+   const F_sm_pars<Real> sm{mw2, mz2};
    return flHp(ms2, ml2, pars, sm);
 }
 
+} // anonymous namespace
+
+/// Eq (53), arxiv:1607.06292, f = u, S = h or H
+double fuS(double ms2, double mu2, double mw2, double mz2) noexcept
+{
+   return fuS_impl(ms2, mu2, mw2, mz2);
+}
+
+/// Eq (53), arxiv:1607.06292, f = d, S = h or H
+double fdS(double ms2, double md2, double mw2, double mz2) noexcept
+{
+   return fdS_impl(ms2, md2, mw2, mz2);
+}
+
+/// Eq (53), arxiv:1607.06292, f = l, S = h or H
+double flS(double ms2, double ml2, double mw2, double mz2) noexcept
+{
+   return flS_impl(ms2, ml2, mw2, mz2);
+}
+
+/// Eq (53), arxiv:1607.06292, f = u, S = A
+double fuA(double ms2, double mu2, double mw2, double mz2) noexcept
+{
+   return fuA_impl(ms2, mu2, mw2, mz2);
+}
+
+/// Eq (53), arxiv:1607.06292, f = d, S = A
+double fdA(double ms2, double md2, double mw2, double mz2) noexcept
+{
+   return fdA_impl(ms2, md2, mw2, mz2);
+}
+
+/// Eq (53), arxiv:1607.06292, f = l, S = A
+double flA(double ms2, double ml2, double mw2, double mz2) noexcept
+{
+   return flA_impl(ms2, ml2, mw2, mz2);
+}
+
+/// Eq (59), arxiv:1607.06292, S = H^\pm, f = u
+double fuHp(double ms2, double md2, double mu2, double mw2, double mz2) noexcept
+{
+   return fuHp_impl(ms2, md2, mu2, mw2, mz2);
+}
+
+/// Eq (59), arxiv:1607.06292, S = H^\pm, f = d
+double fdHp(double ms2, double md2, double mu2, double mw2, double mz2) noexcept
+{
+   return fdHp_impl(ms2, md2, mu2, mw2, mz2);
+}
+
+/// Eq (59), arxiv:1607.06292, S = H^\pm, f = l
+double flHp(double ms2, double ml2, double mw2, double mz2) noexcept
+{
+   return flHp_impl(ms2, ml2, mw2, mz2);
+}
+
 /**
  * Calculates 2-loop fermionic contributions with charged Higgs
  * boson.
  *
  * Eq (52), arXiv:2110.13238
  */
-double amu2L_F_charged(const THDM_F_parameters& thdm) noexcept
+template <class Real>
+Real amu2L_F_charged(const Basic_THDM_F_parameters<Real>& thdm) noexcept
 {
-   const double mHp2 = sqr(thdm.mHp);
-   const double mw2 = sqr(thdm.mw);
-   const double mz2 = sqr(thdm.mz);
-   const double v2 = calc_v2(thdm);
-   const double sw2 = 1 - mw2/mz2;
-   const double pref = sqr(thdm.alpha_em*thdm.mm/(8*pi*thdm.mw*sw2))*v2/thdm.ml(1);
+   const Profile_timer timer(Profile_id::amu2L_F_charged, std::is_same<Real,double>::value);
+
+   const Real mHp2 = sqr(thdm.mHp);
+   const Real mw2 = sqr(thdm.mw);
+   const Real mz2 = sqr(thdm.mz);
+   const Real v2 = calc_v2(thdm);
+   const Real sw2 = 1 - mw2/mz2;
+   const Real pref = sqr(thdm.alpha_em*thdm.mm/(8*pi*thdm.mw*sw2))*v2/thdm.ml(1);
 
-   double res = 0;
+   Real res = 0;
 
    // loop over generations
    for (int i = 0; i < 3; ++i) {
       for (int j = 0; j < 3; ++j) {
          // u
-         res += fuHp(mHp2, sqr(thdm.md(j)), sqr(thdm.mu(i)), mw2, mz2)
-                *std::real(std::conj(thdm.yuHp(i,j))*thdm.vckm(i,j)*thdm.ylHp(1,1))/thdm.mu(i);
+         res += fuHp_impl(mHp2, sqr(thdm.md(j)), sqr(thdm.mu(i)), mw2, mz2)
+                *real(conj(thdm.yuHp(i,j))*thdm.vckm(i,j)*thdm.ylHp(1,1))/thdm.mu(i);
          // d
-         res += fdHp(mHp2, sqr(thdm.md(j)), sqr(thdm.mu(i)), mw2, mz2)
-                *std::real(std::conj(thdm.ydHp(i,j))*thdm.vckm(i,j)*thdm.ylHp(1,1))/thdm.md(j);
+         res += fdHp_impl(mHp2, sqr(thdm.md(j)), sqr(thdm.mu(i)), mw2, mz2)
+                *real(conj(thdm.ydHp(i,j))*thdm.vckm(i,j)*thdm.ylHp(1,1))/thdm.md(j);
       }
       // l
-      res += flHp(mHp2, sqr(thdm.ml(i)), mw2, mz2)
-             *std::real(std::conj(thdm.ylHp(i,i))*thdm.ylHp(1,1))/thdm.ml(i);
+      res += flHp_impl(mHp2, sqr(thdm.ml(i)), mw2, mz2)
+             *real(conj(thdm.ylHp(i,i))*thdm.ylHp(1,1))/thdm.ml(i);
    }
 
    return pref*res;
@@ -316,41 +399,44 @@ double amu2L_F_charged(const THDM_F_parameters& thdm) noexcept
  *
  * Eq (53), arxiv:1607:06292
  */
-double amu2L_F_neutral(const THDM_F_parameters& thdm) noexcept
-{
-   const double mh2 = sqr(thdm.mh(0));
-   const double mH2 = sqr(thdm.mh(1));
-   const double mA2 = sqr(thdm.mA);
-   const double mhSM2 = sqr(thdm.mhSM);
-   const double mw2 = sqr(thdm.mw);
-   const double mz2 = sqr(thdm.mz);
-   const double v2 = calc_v2(thdm);
-   const double sw2 = 1 - mw2/mz2;
+template <class Real>
+Real amu2L_F_neutral(const Basic_THDM_F_parameters<Real>& thdm) noexcept
+{
+   const Profile_timer timer(Profile_id::amu2L_F_neutral, std::is_same<Real,double>::value);
+
+   const Real mh2 = sqr(thdm.mh(0));
+   const Real mH2 = sqr(thdm.mh(1));
+   const Real mA2 = sqr(thdm.mA);
+   const Real mhSM2 = sqr(thdm.mhSM);
+   const Real mw2 = sqr(thdm.mw);
+   const Real mz2 = sqr(thdm.mz);
+   const Real v2 = calc_v2(thdm);
+   const Real sw2 = 1 - mw2/mz2;
    const auto pref = sqr(thdm.alpha_em*thdm.mm/(2*pi*thdm.mw))/sw2;
 
-   double res = 0;
+   Real res = 0;
 
    // loop over generations
    for (int i = 0; i < 3; ++i) {
       // h
-      res += fuS(mh2, sqr(thdm.mu(i)), mw2, mz2)*std::real(std::conj(thdm.yuh(i,i))*thdm.ylh(1,1))*v2/(thdm.mu(i)*thdm.ml(1));
-      res += fdS(mh2, sqr(thdm.md(i)), mw2, mz2)*std::real(std::conj(thdm.ydh(i,i))*thdm.ylh(1,1))*v2/(thdm.md(i)*thdm.ml(1));
-      res += flS(mh2, sqr(thdm.ml(i)), mw2, mz2)*std::real(std::conj(thdm.ylh(i,i))*thdm.ylh(1,1))*v2/(thdm.ml(i)*thdm.ml(1));
+      res += fuS_impl(mh2, sqr(thdm.mu(i)), mw2, mz2)*real(conj(thdm.yuh(i,i))*thdm.ylh(1,1))*v2/(thdm.mu(i)*thdm.ml(1));
+      res += fdS_impl(mh2, sqr(thdm.md(i)), mw2, mz2)*real(conj(thdm.ydh(i,i))*thdm.ylh(1,1))*v2/(thdm.md(i)*thdm.ml(1));
+      res += flS_impl(mh2, sqr(thdm.ml(i)), mw2, mz2)*real(conj(thdm.ylh(i,i))*thdm.ylh(1,1))*v2/(thdm.ml(i)*thdm.ml(1));
 
       // H
-      res += fuS(mH2, sqr(thdm.mu(i)), mw2, mz2)*std::real(std::conj(thdm.yuH(i,i))*thdm.ylH(1,1))*v2/(thdm.mu(i)*thdm.ml(1));
-      res += fdS(mH2, sqr(thdm.md(i)), mw2, mz2)*std::real(std::conj(thdm.ydH(i,i))*thdm.ylH(1,1))*v2/(thdm.md(i)*thdm.ml(1));
-      res += flS(mH2, sqr(thdm.ml(i)), mw2, mz2)*std::real(std::conj(thdm.ylH(i,i))*thdm.ylH(1,1))*v2/(thdm.ml(i)*thdm.ml(1));
+      res += fuS_impl(mH2, sqr(thdm.mu(i)), mw2, mz2)*real(conj(thdm.yuH(i,i))*thdm.ylH(1,1))*v2/(thdm.mu(i)*thdm.ml(1));
+      res += fdS_impl(mH2, sqr(thdm.md(i)), mw2, mz2)*real(conj(thdm.ydH(i,i))*thdm.ylH(1,1))*v2/(thdm.md(i)*thdm.ml(1));
+      res += flS_impl(mH2, sqr(thdm.ml(i)), mw2, mz2)*real(conj(thdm.ylH(i,i))*thdm.ylH(1,1))*v2/(thdm.ml(i)*thdm.ml(1));
 
       // A
-      res += fuA(mA2, sqr(thdm.mu(i)), mw2, mz2)*std::real(std::conj(thdm.yuA(i,i))*thdm.ylA(1,1))*v2/(thdm.mu(i)*thdm.ml(1));
-      res += fdA(mA2, sqr(thdm.md(i)), mw2, mz2)*std::real(std::conj(thdm.ydA(i,i))*thdm.ylA(1,1))*v2/(thdm.md(i)*thdm.ml(1));
-      res += flA(mA2, sqr(thdm.ml(i)), mw2, mz2)*std::real(std::conj(thdm.ylA(i,i))*thdm.ylA(1,1))*v2/(thdm.ml(i)*thdm.ml(1));
+      res += fuA_impl(mA2, sqr(thdm.mu(i)), mw2, mz2)*real(conj(thdm.yuA(i,i))*thdm.ylA(1,1))*v2/(thdm.mu(i)*thdm.ml(1));
+      res += fdA_impl(mA2, sqr(thdm.md(i)), mw2, mz2)*real(conj(thdm.ydA(i,i))*thdm.ylA(1,1))*v2/(thdm.md(i)*thdm.ml(1));
+      res += flA_impl(mA2, sqr(thdm.ml(i)), mw2, mz2)*real(conj(thdm.ylA(i,i))*thdm.ylA(1,1))*v2/(thdm.ml(i)*thdm.ml(1));
 
       // subtract hSM
-      res -= fuS(mhSM2, sqr(thdm.mu(i)), mw2, mz2);
-      res -= fdS(mhSM2, sqr(thdm.md(i)), mw2, mz2);
-      res -= flS(mhSM2, sqr(thdm.ml(i)), mw2, mz2);
+      res -= fuS_impl(mhSM2, sqr(thdm.mu(i)), mw2, mz2);
+      res -= fdS_impl(mhSM2, sqr(thdm.md(i)), mw2, mz2);
+      res -= flS_impl(mhSM2, sqr(thdm.ml(i)), mw2, mz2);
    }
 
    return pref*res;
@@ -362,11 +448,20 @@ double amu2L_F_neutral(const THDM_F_parameters& thdm) noexcept
  *
  * Eq (63), arxiv:1607:06292
  */
-double amu2L_F(const THDM_F_parameters& thdm) noexcept
+template <class Real>
+Real amu2L_F(const Basic_THDM_F_parameters<Real>& thdm) noexcept
 {
    return amu2L_F_neutral(thdm) + amu2L_F_charged(thdm);
 }
 
+template double amu2L_F(const Basic_THDM_F_parameters<double>&) noexcept;
+template double amu2L_F_charged(const Basic_THDM_F_parameters<double>&) noexcept;
+template double amu2L_F_neutral(const Basic_THDM_F_parameters<double>&) noexcept;
+
+template Dual<double> amu2L_F(const Basic_THDM_F_parameters<Dual<double>>&) noexcept;
+template Dual<double> amu2L_F_charged(const Basic_THDM_F_parameters<Dual<double>>&) noexcept;
+template Dual<double> amu2L_F_neutral(const Basic_THDM_F_parameters<Dual<double>>&) noexcept;
+
 } // namespace thdm
 
 } // namespace gm2calc
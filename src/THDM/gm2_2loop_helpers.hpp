@@ -19,75 +19,102 @@
 #ifndef GM2_THDM_2LOOP_HELPERS_HPP
 #define GM2_THDM_2LOOP_HELPERS_HPP
 
+#include "gm2_dual.hpp"
+
+#include <complex>
+
 #include <Eigen/Core>
 
 namespace gm2calc {
 
 namespace thdm {
 
-/// parameters to be passed to the bosonic contribution functions
-struct THDM_B_parameters {
-   double alpha_em{};///< electromagnetic coupling
-   double mm{};      ///< muon mass for prefactor
-   double mw{};      ///< W boson mass
-   double mz{};      ///< Z boson mass
-   double mhSM{};    ///< SM Higgs boson mass
-   double mA{};      ///< CP-odd Higgs boson mass
-   double mHp{};     ///< charged Higgs boson mass
-   Eigen::Matrix<double,2,1> mh{Eigen::Matrix<double,2,1>::Zero()}; ///< CP-even Higgs bosons mass
-   double tb{};      ///< tan(beta)
-   double zetal{};   ///< zeta_l
-   double cos_beta_minus_alpha{}; ///< cos(beta - alpha_h)
-   double lambda5{}; ///< Lambda_5
-   double lambda67{}; ///< difference (Lambda_567 - Lambda_5)
+/**
+ * parameters to be passed to the bosonic contribution functions
+ *
+ * @tparam Real real number type (double or Dual<double>)
+ */
+template <class Real>
+struct Basic_THDM_B_parameters {
+   Real alpha_em{};///< electromagnetic coupling
+   Real mm{};      ///< muon mass for prefactor
+   Real mw{};      ///< W boson mass
+   Real mz{};      ///< Z boson mass
+   Real mhSM{};    ///< SM Higgs boson mass
+   Real mA{};      ///< CP-odd Higgs boson mass
+   Real mHp{};     ///< charged Higgs boson mass
+   Eigen::Matrix<Real,2,1> mh{Eigen::Matrix<Real,2,1>::Zero()}; ///< CP-even Higgs bosons mass
+   Real tb{};      ///< tan(beta)
+   Real zetal{};   ///< zeta_l
+   Real cos_beta_minus_alpha{}; ///< cos(beta - alpha_h)
+   Real lambda5{}; ///< Lambda_5
+   Real lambda67{}; ///< difference (Lambda_567 - Lambda_5)
 };
 
-/// parameters to be passed to the fermionic contribution functions
-struct THDM_F_parameters {
-   double alpha_em{}; ///< electromagnetic coupling
-   double mm{};       ///< muon mass for prefactor
-   double mw{};       ///< W boson mass
-   double mz{};       ///< Z boson mass
-   double mhSM{};     ///< SM Higgs boson mass
-   double mA{};       ///< CP-odd Higgs boson mass
-   double mHp{};      ///< charged Higgs boson mass
-   Eigen::Matrix<double,2,1> mh{Eigen::Matrix<double,2,1>::Zero()};  ///< CP-even Higgs bosons mass
-   Eigen::Matrix<double,3,1> ml{Eigen::Matrix<double,3,1>::Zero()};  ///< down-type lepton masses
-   Eigen::Matrix<double,3,1> mu{Eigen::Matrix<double,3,1>::Zero()};  ///< up-type quark masses
-   Eigen::Matrix<double,3,1> md{Eigen::Matrix<double,3,1>::Zero()};  ///< down-type quark masses
-   Eigen::Matrix<std::complex<double>,3,3> yuh{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={u,c,t} and S=h
-   Eigen::Matrix<std::complex<double>,3,3> yuH{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={u,c,t} and S=H
-   Eigen::Matrix<std::complex<double>,3,3> yuA{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={u,c,t} and S=A
-   Eigen::Matrix<std::complex<double>,3,3> yuHp{Eigen::Matrix<std::complex<double>,3,3>::Zero()};///< y_f^S coefficients with f={u,c,t} and S=H^+
-   Eigen::Matrix<std::complex<double>,3,3> ydh{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={d,s,b} and S=h
-   Eigen::Matrix<std::complex<double>,3,3> ydH{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={d,s,b} and S=H
-   Eigen::Matrix<std::complex<double>,3,3> ydA{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={d,s,b} and S=A
-   Eigen::Matrix<std::complex<double>,3,3> ydHp{Eigen::Matrix<std::complex<double>,3,3>::Zero()};///< y_f^S coefficients with f={d,s,b} and S=H^+
-   Eigen::Matrix<std::complex<double>,3,3> ylh{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={e,m,τ} and S=h
-   Eigen::Matrix<std::complex<double>,3,3> ylH{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={e,m,τ} and S=H
-   Eigen::Matrix<std::complex<double>,3,3> ylA{Eigen::Matrix<std::complex<double>,3,3>::Zero()}; ///< y_f^S coefficients with f={e,m,τ} and S=A
-   Eigen::Matrix<std::complex<double>,3,3> ylHp{Eigen::Matrix<std::complex<double>,3,3>::Zero()};///< y_f^S coefficients with f={e,m,τ} and S=H^+
-   Eigen::Matrix<std::complex<double>,3,3> vckm{Eigen::Matrix<std::complex<double>,3,3>::Identity()};///< CKM matrix
+using THDM_B_parameters = Basic_THDM_B_parameters<double>;
+
+/**
+ * parameters to be passed to the fermionic contribution functions
+ *
+ * @tparam Real real number type (double or Dual<double>)
+ */
+template <class Real>
+struct Basic_THDM_F_parameters {
+   using Complex = typename Complex_type<Real>::type;
+
+   Real alpha_em{}; ///< electromagnetic coupling
+   Real mm{};       ///< muon mass for prefactor
+   Real mw{};       ///< W boson mass
+   Real mz{};       ///< Z boson mass
+   Real mhSM{};     ///< SM Higgs boson mass
+   Real mA{};       ///< CP-odd Higgs boson mass
+   Real mHp{};      ///< charged Higgs boson mass
+   Eigen::Matrix<Real,2,1> mh{Eigen::Matrix<Real,2,1>::Zero()};  ///< CP-even Higgs bosons mass
+   Eigen::Matrix<Real,3,1> ml{Eigen::Matrix<Real,3,1>::Zero()};  ///< down-type lepton masses
+   Eigen::Matrix<Real,3,1> mu{Eigen::Matrix<Real,3,1>::Zero()};  ///< up-type quark masses
+   Eigen::Matrix<Real,3,1> md{Eigen::Matrix<Real,3,1>::Zero()};  ///< down-type quark masses
+   Eigen::Matrix<Complex,3,3> yuh{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={u,c,t} and S=h
+   Eigen::Matrix<Complex,3,3> yuH{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={u,c,t} and S=H
+   Eigen::Matrix<Complex,3,3> yuA{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={u,c,t} and S=A
+   Eigen::Matrix<Complex,3,3> yuHp{Eigen::Matrix<Complex,3,3>::Zero()};///< y_f^S coefficients with f={u,c,t} and S=H^+
+   Eigen::Matrix<Complex,3,3> ydh{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={d,s,b} and S=h
+   Eigen::Matrix<Complex,3,3> ydH{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={d,s,b} and S=H
+   Eigen::Matrix<Complex,3,3> ydA{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={d,s,b} and S=A
+   Eigen::Matrix<Complex,3,3> ydHp{Eigen::Matrix<Complex,3,3>::Zero()};///< y_f^S coefficients with f={d,s,b} and S=H^+
+   Eigen::Matrix<Complex,3,3> ylh{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={e,m,τ} and S=h
+   Eigen::Matrix<Complex,3,3> ylH{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={e,m,τ} and S=H
+   Eigen::Matrix<Complex,3,3> ylA{Eigen::Matrix<Complex,3,3>::Zero()}; ///< y_f^S coefficients with f={e,m,τ} and S=A
+   Eigen::Matrix<Complex,3,3> ylHp{Eigen::Matrix<Complex,3,3>::Zero()};///< y_f^S coefficients with f={e,m,τ} and S=H^+
+   Eigen::Matrix<Complex,3,3> vckm{Eigen::Matrix<Complex,3,3>::Identity()};///< CKM matrix
 };
 
+using THDM_F_parameters = Basic_THDM_F_parameters<double>;
+
 // === 2-loop bosonic contributions ===
 
-double amu2L_B(const THDM_B_parameters&) noexcept;
+template <class Real>
+Real amu2L_B(const Basic_THDM_B_parameters<Real>&) noexcept;
 
 // routines for sub-expressions
 
-double amu2L_B_EWadd(const THDM_B_parameters&) noexcept;
-double amu2L_B_nonYuk(const THDM_B_parameters&) noexcept;
-double amu2L_B_Yuk(const THDM_B_parameters&) noexcept;
+template <class Real>
+Real amu2L_B_EWadd(const Basic_THDM_B_parameters<Real>&) noexcept;
+template <class Real>
+Real amu2L_B_nonYuk(const Basic_THDM_B_parameters<Real>&) noexcept;
+template <class Real>
+Real amu2L_B_Yuk(const Basic_THDM_B_parameters<Real>&) noexcept;
 
 // === 2-loop fermionic contributions ===
 
-double amu2L_F(const THDM_F_parameters&) noexcept;
+template <class Real>
+Real amu2L_F(const Basic_THDM_F_parameters<Real>&) noexcept;
 
 // routines for sub-expressions
 
-double amu2L_F_charged(const THDM_F_parameters&) noexcept;
-double amu2L_F_neutral(const THDM_F_parameters&) noexcept;
+template <class Real>
+Real amu2L_F_charged(const Basic_THDM_F_parameters<Real>&) noexcept;
+template <class Real>
+Real amu2L_F_neutral(const Basic_THDM_F_parameters<Real>&) noexcept;
 
 /// Eq (53), arxiv:1607.06292, f = u, S = h or H
 double fuS(double ms2, double mu2, double mw2, double mz2) noexcept;
@@ -0,0 +1,180 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_gradient.hpp"
+#include "gm2calc/THDM.hpp"
+#include "THDM/THDM_couplings.hpp"
+#include "THDM/gm2_1loop_helpers.hpp"
+#include "THDM/gm2_2loop_helpers.hpp"
+#include "gm2_dual.hpp"
+
+#include <cmath>
+#include <complex>
+
+/**
+ * \file gm2_amu_gradient.cpp
+ *
+ * Contains functions to calculate the THDM contributions to a_mu
+ * together with their derivatives w.r.t. the mass basis parameters
+ * in one pass, using forward-mode automatic differentiation.
+ */
+
+namespace gm2calc {
+
+namespace {
+
+using Real = Dual<double>;
+using Complex = Dual<std::complex<double>>;
+using CMatrix = Eigen::Matrix<Complex,3,3>;
+using Index = thdm::Amu_gradient::Index;
+
+/// THDM mass basis parameters with their derivatives
+struct Dual_parameters : thdm::Basic_THDM_coupling_parameters<Real> {
+   Real lambda6, lambda7, m122;
+};
+
+Dual_parameters make_dual_parameters(const THDM& model)
+{
+   const auto yukawa_type = model.get_yukawa_type();
+   Dual_parameters p;
+
+   p.mh = Real(model.get_Mhh(0), Index::mh);
+   p.mH = Real(model.get_Mhh(1), Index::mH);
+   p.mA = Real(model.get_MAh(1), Index::mA);
+   p.mHp = Real(model.get_MHm(1), Index::mHp);
+   p.sba = Real(model.get_sin_beta_minus_alpha(), Index::sin_beta_minus_alpha);
+   // cos(beta - alpha_h) = +Sqrt[1 - sin(beta - alpha_h)^2]
+   p.cba = Real(model.get_cos_beta_minus_alpha());
+   p.cba.grad[Index::sin_beta_minus_alpha] = -p.sba.val/p.cba.val;
+   p.lambda6 = Real(model.get_lambda6(), Index::lambda_6);
+   p.lambda7 = Real(model.get_lambda7(), Index::lambda_7);
+   p.tb = Real(model.get_tan_beta(), Index::tan_beta);
+   p.cb = 1/sqrt(1 + p.tb*p.tb);
+   p.m122 = Real(model.get_m122(), Index::m122);
+   p.zeta_u = thdm::calc_zeta_u(yukawa_type, p.tb, Real(model.get_zeta_u(), Index::zeta_u));
+   p.zeta_d = thdm::calc_zeta_d(yukawa_type, p.tb, Real(model.get_zeta_d(), Index::zeta_d));
+   p.zeta_l = thdm::calc_zeta_l(yukawa_type, p.tb, Real(model.get_zeta_l(), Index::zeta_l));
+
+   return p;
+}
+
+} // anonymous namespace
+
+/**
+ * Calculates the 1-loop and 2-loop contributions to a_mu in the
+ * general THDM together with their first derivatives w.r.t. the
+ * mass basis parameters (mh, mH, mA, mHp, sin(beta - alpha_h),
+ * lambda_6, lambda_7, tan(beta), m_{12}^2, zeta_u, zeta_d, zeta_l)
+ * in a single evaluation.
+ *
+ * The derivatives w.r.t. zeta_f are zero unless the aligned THDM is
+ * used.  In the type I, II, X and Y THDM the dependence of zeta_f on
+ * tan(beta) is included in the derivative w.r.t. tan(beta).  The
+ * derivatives are undefined for |sin(beta - alpha_h)| = 1.
+ *
+ * @param model THDM model parameters, masses and mixings
+ * @return 1-loop + 2-loop contribution to a_mu and its gradient
+ */
+thdm::Amu_gradient calculate_amu_gradient(const THDM& model)
+{
+   const Dual_parameters p = make_dual_parameters(model);
+   const CMatrix ylh = thdm::get_ylh(model, p);
+   const CMatrix ylH = thdm::get_ylH(model, p);
+   const CMatrix ylA = thdm::get_ylA(model, p);
+   const CMatrix ylHp = thdm::get_ylHp(model, p);
+
+   const Real alpha_em(model.get_alpha_em());
+   const Real mm(model.get_MFe(1));
+   const Real mw(model.get_MVWm());
+   const Real mz(model.get_MVZ());
+   const Real mhSM(model.get_sm().get_mh());
+   const Eigen::Matrix<Real,2,1> mh(p.mh, p.mH);
+
+   thdm::Basic_THDM_1L_parameters<Real> pars;
+   pars.alpha_em = alpha_em;
+   pars.mm = mm;
+   pars.mw = mw;
+   pars.mz = mz;
+   pars.mhSM = mhSM;
+   pars.mA = p.mA;
+   pars.mHp = p.mHp;
+   pars.ml = model.get_MFe().cast<Real>();
+   pars.mv = model.get_MFv().cast<Real>();
+   pars.mh = mh;
+   pars.ylh = ylh;
+   pars.ylH = ylH;
+   pars.ylA = ylA;
+   pars.ylHp = ylHp;
+
+   const Real sb = p.tb*p.cb;
+   const Real sbcb = p.tb/(1 + p.tb*p.tb); // Sin[beta] Cos[beta]
+
+   thdm::Basic_THDM_B_parameters<Real> pars_b;
+   pars_b.alpha_em = alpha_em;
+   pars_b.mm = mm;
+   pars_b.mw = mw;
+   pars_b.mz = mz;
+   pars_b.mhSM = mhSM;
+   pars_b.mA = p.mA;
+   pars_b.mHp = p.mHp;
+   pars_b.mh = mh;
+   pars_b.tb = p.tb;
+   pars_b.zetal = p.zeta_l;
+   pars_b.cos_beta_minus_alpha = p.cba;
+   pars_b.lambda5 = 2*p.m122/(model.get_v_sqr()*sbcb);
+   pars_b.lambda67 = p.lambda6/(sb*sb) - p.lambda7/(p.cb*p.cb);
+
+   thdm::Basic_THDM_F_parameters<Real> pars_f;
+   pars_f.alpha_em = alpha_em;
+   pars_f.mm = mm;
+   pars_f.mw = mw;
+   pars_f.mz = mz;
+   pars_f.mhSM = mhSM;
+   pars_f.mA = p.mA;
+   pars_f.mHp = p.mHp;
+   pars_f.mh = mh;
+   pars_f.ml = model.get_MFe().cast<Real>();
+   pars_f.mu = model.get_MFu().cast<Real>();
+   pars_f.md = model.get_MFd().cast<Real>();
+   pars_f.yuh = thdm::get_yuh(model, p);
+   pars_f.yuH = thdm::get_yuH(model, p);
+   pars_f.yuA = thdm::get_yuA(model, p);
+   pars_f.yuHp = thdm::get_yuHp(model, p);
+   pars_f.ydh = thdm::get_ydh(model, p);
+   pars_f.ydH = thdm::get_ydH(model, p);
+   pars_f.ydA = thdm::get_ydA(model, p);
+   pars_f.ydHp = thdm::get_ydHp(model, p);
+   pars_f.ylh = ylh;
+   pars_f.ylH = ylH;
+   pars_f.ylA = ylA;
+   pars_f.ylHp = ylHp;
+   pars_f.vckm = model.get_sm().get_ckm().cast<Complex>();
+
+   const Real amu = thdm::amu1L(pars) + thdm::amu2L_B(pars_b) + thdm::amu2L_F(pars_f);
+
+   thdm::Amu_gradient result;
+   result.amu = amu.val;
+
+   for (int i = 0; i < thdm::Amu_gradient::NUMBER_OF_PARAMETERS; ++i) {
+      result.gradient(i) = amu.grad[i];
+   }
+
+   return result;
+}
+
+} // namespace gm2calc
@@ -0,0 +1,172 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_batch.h"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/THDM.hpp"
+#include "gm2_log.hpp"
+#include "gm2_parallel.hpp"
+#include "gm2_uncertainty_helpers.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace gm2calc {
+namespace {
+
+/**
+ * Calculates amu and its uncertainty of a single point.
+ *
+ * @return error code
+ */
+template <class Basis, class New_model>
+gm2calc_error calculate_amu_point(
+   const Basis* basis, const ::gm2calc_SM* sm, const gm2calc_THDM_config* config,
+   int loop_order, double& amu, double& damu, New_model new_model) noexcept
+{
+   amu = damu = 0;
+
+   gm2calc_THDM* ptr = nullptr;
+   const gm2calc_error error = new_model(&ptr, basis, sm, config);
+
+   if (error != gm2calc_NoError) {
+      return error;
+   }
+
+   std::unique_ptr<gm2calc_THDM, void(*)(gm2calc_THDM*)> guard(ptr, gm2calc_thdm_free);
+
+   try {
+      const auto model = reinterpret_cast<const THDM*>(ptr);
+      const double amu1L = loop_order > 0 ? calculate_amu_1loop(*model) : 0;
+      const double amu2L = loop_order > 1 ? calculate_amu_2loop(*model) : 0;
+
+      if (loop_order == 0) {
+         damu = calculate_uncertainty_amu_0loop(*model, amu1L, amu2L);
+      } else if (loop_order == 1) {
+         damu = calculate_uncertainty_amu_1loop(*model, amu1L, amu2L);
+      } else if (loop_order > 1) {
+         damu = calculate_uncertainty_amu_2loop(*model, amu1L, amu2L);
+      }
+
+      amu = amu1L + amu2L;
+   } catch (const EInvalidInput&) {
+      amu = damu = 0;
+      return gm2calc_InvalidInput;
+   } catch (const EPhysicalProblem&) {
+      amu = damu = 0;
+      return gm2calc_PhysicalProblem;
+   } catch (...) {
+      amu = damu = 0;
+      return gm2calc_UnknownError;
+   }
+
+   return gm2calc_NoError;
+}
+
+/**
+ * Calculates amu and its uncertainty for each point of the list.  The
+ * points are distributed dynamically over the threads.  No exception
+ * leaves this function: if the points cannot be evaluated, the status
+ * of the points which have not been evaluated is gm2calc_UnknownError.
+ */
+template <class Basis, class New_model>
+void calculate_amu_list(
+   const Basis* basis, std::size_t n, const ::gm2calc_SM* sm,
+   const gm2calc_THDM_config* config, int loop_order, unsigned threads,
+   double* amu, double* damu, gm2calc_error* status, New_model new_model) noexcept
+{
+   std::fill(status, status + n, gm2calc_UnknownError);
+   std::fill(amu, amu + n, 0.0);
+   std::fill(damu, damu + n, 0.0);
+
+   try {
+      parallel_for(n, threads, [&] (std::size_t i) {
+         status[i] = calculate_amu_point(basis + i, sm, config, loop_order,
+                                         amu[i], damu[i], new_model);
+      });
+   } catch (...) {
+      ERROR("unknown exception thrown");
+   }
+}
+
+} // anonymous namespace
+} // namespace gm2calc
+
+extern "C" {
+
+/**
+ * @brief Calculates amu and its uncertainty for a list of THDM points
+ * with gauge basis input.
+ *
+ * For each point, the model is constructed as with
+ * gm2calc_thdm_new_with_gauge_basis() and the contributions up to the
+ * given loop order are summed.  If the model cannot be constructed
+ * or the calculation fails, amu and its uncertainty are set to 0 and
+ * the status contains the error code.
+ *
+ * @param basis array of n input parameter points
+ * @param n number of points
+ * @param sm SM parameters
+ * @param config configuration options
+ * @param loop_order loop order (0, 1 or 2)
+ * @param threads number of threads (0 = number of hardware threads)
+ * @param amu array of n values of amu (output)
+ * @param damu array of n uncertainties of amu (output)
+ * @param status array of n error codes (output)
+ */
+void gm2calc_thdm_calculate_amu_gauge_basis_list(
+   const gm2calc_THDM_gauge_basis* basis, size_t n, const ::gm2calc_SM* sm,
+   const gm2calc_THDM_config* config, int loop_order, unsigned threads,
+   double* amu, double* damu, gm2calc_error* status)
+{
+   gm2calc::calculate_amu_list(basis, n, sm, config, loop_order, threads,
+                               amu, damu, status, gm2calc_thdm_new_with_gauge_basis);
+}
+
+/**
+ * @brief Calculates amu and its uncertainty for a list of THDM points
+ * with mass basis input.
+ *
+ * For each point, the model is constructed as with
+ * gm2calc_thdm_new_with_mass_basis() and the contributions up to the
+ * given loop order are summed.  If the model cannot be constructed
+ * or the calculation fails, amu and its uncertainty are set to 0 and
+ * the status contains the error code.
+ *
+ * @param basis array of n input parameter points
+ * @param n number of points
+ * @param sm SM parameters
+ * @param config configuration options
+ * @param loop_order loop order (0, 1 or 2)
+ * @param threads number of threads (0 = number of hardware threads)
+ * @param amu array of n values of amu (output)
+ * @param damu array of n uncertainties of amu (output)
+ * @param status array of n error codes (output)
+ */
+void gm2calc_thdm_calculate_amu_mass_basis_list(
+   const gm2calc_THDM_mass_basis* basis, size_t n, const ::gm2calc_SM* sm,
+   const gm2calc_THDM_config* config, int loop_order, unsigned threads,
+   double* amu, double* damu, gm2calc_error* status)
+{
+   gm2calc::calculate_amu_list(basis, n, sm, config, loop_order, threads,
+                               amu, damu, status, gm2calc_thdm_new_with_mass_basis);
+}
+
+} // extern "C"
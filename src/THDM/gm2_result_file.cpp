@@ -0,0 +1,170 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_result_file.hpp"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <array>
+#include <limits>
+#include <vector>
+
+/**
+ * \file gm2_result_file.cpp
+ *
+ * Contains the columns of the THDM result file.
+ */
+
+namespace gm2calc {
+
+namespace {
+
+/// input parameter column
+struct Input_column {
+   const char* name;
+   double (*get)(const THDM&);
+};
+
+const Input_column input_columns[] = {
+   {"tan_beta"            , [] (const THDM& m) { return m.get_tan_beta(); }},
+   {"mh"                  , [] (const THDM& m) { return m.get_Mhh(0); }},
+   {"mH"                  , [] (const THDM& m) { return m.get_Mhh(1); }},
+   {"mA"                  , [] (const THDM& m) { return m.get_MAh(1); }},
+   {"mHp"                 , [] (const THDM& m) { return m.get_MHm(1); }},
+   {"sin_beta_minus_alpha", [] (const THDM& m) { return m.get_sin_beta_minus_alpha(); }},
+   {"m122"                , [] (const THDM& m) { return m.get_m122(); }},
+   {"lambda6"             , [] (const THDM& m) { return m.get_lambda6(); }},
+   {"lambda7"             , [] (const THDM& m) { return m.get_lambda7(); }},
+   {"zeta_u"              , [] (const THDM& m) { return m.get_zeta_u(); }},
+   {"zeta_d"              , [] (const THDM& m) { return m.get_zeta_d(); }},
+   {"zeta_l"              , [] (const THDM& m) { return m.get_zeta_l(); }},
+};
+
+/// contributions to amu and the uncertainty
+const char* const result_columns[] = {
+   "amu1L", "amu2L_bosonic", "amu2L_fermionic", "amu2L", "amu", "damu"
+};
+
+constexpr std::size_t number_of_input_columns = sizeof(input_columns) / sizeof(input_columns[0]);
+constexpr std::size_t number_of_result_columns = sizeof(result_columns) / sizeof(result_columns[0]);
+constexpr std::size_t number_of_columns = number_of_input_columns + number_of_result_columns + 2;
+
+using Results = std::array<double, number_of_result_columns>;
+
+/// calculates the contributions in the order of result_columns
+Results calculate_results(const THDM& model)
+{
+   const double amu_1l = calculate_amu_1loop(model);
+   const double amu_2l_B = calculate_amu_2loop_bosonic(model);
+   const double amu_2l_F = calculate_amu_2loop_fermionic(model);
+   const double amu_2l = amu_2l_B + amu_2l_F;
+
+   return Results{
+      amu_1l, amu_2l_B, amu_2l_F, amu_2l, amu_1l + amu_2l,
+      calculate_uncertainty_amu_2loop(model)
+   };
+}
+
+} // anonymous namespace
+
+/**
+ * Returns the columns written by write_result(): the input
+ * parameters, the 1- and 2-loop contributions to amu, the sum amu =
+ * amu1L + amu2L, its uncertainty damu and the problem and warning
+ * flags.
+ *
+ * @return columns
+ */
+std::vector<Result_column> get_thdm_result_columns()
+{
+   std::vector<Result_column> columns;
+   columns.reserve(number_of_columns);
+
+   for (const auto& c: input_columns) {
+      columns.push_back({c.name, Result_column::Float64});
+   }
+   for (const auto& c: result_columns) {
+      columns.push_back({c, Result_column::Float64});
+   }
+
+   columns.push_back({"problems", Result_column::UInt64});
+   columns.push_back({"warnings", Result_column::UInt64});
+
+   return columns;
+}
+
+/**
+ * Calculates the contributions to amu and returns the input
+ * parameters and the results as a row with the columns returned by
+ * get_thdm_result_columns().  If the calculation fails, the results are
+ * set to NaN and the flag Result_problem_error is set.
+ *
+ * @param model model
+ *
+ * @return row
+ */
+std::vector<Result_value> make_result_row(const THDM& model)
+{
+   std::vector<Result_value> row(number_of_columns);
+   std::size_t i = 0;
+   std::uint64_t problems = 0;
+
+   if (model.get_problems().have_tachyon()) {
+      problems |= Result_problem_tachyon;
+   }
+
+   for (const auto& c: input_columns) {
+      row[i++] = c.get(model);
+   }
+
+   Results results;
+
+   try {
+      results = calculate_results(model);
+   } catch (const Error&) {
+      results.fill(std::numeric_limits<double>::quiet_NaN());
+      problems |= Result_problem_error;
+   }
+
+   for (const auto r: results) {
+      row[i++] = r;
+   }
+
+   row[i++] = problems;
+   row[i++] = static_cast<std::uint64_t>(0);
+
+   return row;
+}
+
+/**
+ * Calculates the contributions to amu and appends the input
+ * parameters and the results as a row to the result file.
+ *
+ * @param writer result file writer with the columns returned by
+ * get_thdm_result_columns()
+ * @param model model
+ */
+void write_result(Result_file_writer& writer, const THDM& model)
+{
+   writer.write_row(make_result_row(model));
+}
+
+} // namespace gm2calc
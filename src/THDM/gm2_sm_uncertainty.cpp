@@ -0,0 +1,158 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_sm_uncertainty.hpp"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_scan.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+#include <boost/math/special_functions/erf.hpp>
+
+namespace gm2calc {
+
+namespace {
+
+/// number of sampled SM input parameters
+constexpr unsigned number_of_inputs = 4;
+
+/// converts u in (0,1) to a standard normal variate
+double to_normal(double u)
+{
+   const double eps = std::numeric_limits<double>::epsilon();
+   u = std::min(std::max(u, eps), 1 - eps);
+   return std::sqrt(2.0)*boost::math::erf_inv(2*u - 1);
+}
+
+/// quantile of sorted values with linear interpolation
+double quantile(const std::vector<double>& sorted, double p)
+{
+   const double h = (sorted.size() - 1)*p;
+   const std::size_t lo = static_cast<std::size_t>(std::floor(h));
+   const std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+   return sorted[lo] + (h - lo)*(sorted[hi] - sorted[lo]);
+}
+
+void check(const thdm::SM_uncertainty_options& options)
+{
+   if (!(options.delta_alpha_s_mz >= 0) || !(options.delta_mt >= 0) ||
+       !(options.delta_mbmb >= 0) || !(options.delta_mw >= 0)) {
+      throw EInvalidInput("standard deviations of the SM input parameters must not be negative");
+   }
+   if (options.samples < 2) {
+      throw EInvalidInput("number of samples must be at least 2");
+   }
+   for (const double p: options.probabilities) {
+      if (!(p >= 0 && p <= 1)) {
+         throw EInvalidInput("probability " + std::to_string(p) + " of a quantile must be within [0,1]");
+      }
+   }
+}
+
+} // anonymous namespace
+
+/**
+ * Propagates the uncertainties of the SM input parameters
+ * alpha_s(MZ), the top quark pole mass, mb(mb) and the W boson pole
+ * mass to a_mu(1-loop + 2-loop) in the THDM by Monte Carlo sampling.
+ *
+ * The samples are drawn from a sequence of points in the unit
+ * hypercube (see Scan_sequence), which are mapped to normally
+ * distributed SM input parameters.  The samples are evaluated in
+ * parallel with scan_sequence().  Since each sample only depends on
+ * its index and the seed, the result does not depend on the number
+ * of threads.  Samples, for which the evaluation throws (e.g. due to
+ * invalid input parameters), are counted, but do not enter the
+ * statistics.
+ *
+ * @param basis THDM parameters
+ * @param sm central values of the SM parameters
+ * @param options standard deviations, number of samples and options
+ * @param config THDM configuration
+ *
+ * @return mean, standard deviation and quantiles of a_mu
+ */
+thdm::SM_uncertainty_result calculate_sm_uncertainty_amu(
+   const thdm::Mass_basis& basis, const SM& sm,
+   const thdm::SM_uncertainty_options& options, const thdm::Config& config)
+{
+   check(options);
+
+   const Scan_sequence sequence(options.sequence,
+                                std::vector<Scan_range>(number_of_inputs, Scan_range{0, 1}),
+                                options.samples, options.seed);
+
+   const auto f = [&] (const double* u) {
+      SM s(sm);
+      s.set_alpha_s_mz(sm.get_alpha_s_mz() + options.delta_alpha_s_mz*to_normal(u[0]));
+      s.set_mu(2, sm.get_mu(2) + options.delta_mt*to_normal(u[1]));
+      s.set_md(2, sm.get_md(2) + options.delta_mbmb*to_normal(u[2]));
+      s.set_mw(sm.get_mw() + options.delta_mw*to_normal(u[3]));
+
+      const THDM model(basis, s, config);
+
+      return Scan_value{calculate_amu_1loop(model) + calculate_amu_2loop(model), 0, 0};
+   };
+
+   const auto values = scan_sequence(f, sequence, 0, sequence.size(), options.threads);
+
+   std::vector<double> amu;
+   amu.reserve(values.size());
+
+   for (const auto& v: values) {
+      if (v.flags == 0 && std::isfinite(v.amu)) {
+         amu.push_back(v.amu);
+      }
+   }
+
+   thdm::SM_uncertainty_result result;
+   result.samples = amu.size();
+   result.failed = values.size() - amu.size();
+
+   if (amu.size() < 2) {
+      throw EPhysicalProblem("a_mu could not be evaluated for "
+                             + std::to_string(result.failed) + " of "
+                             + std::to_string(values.size()) + " samples");
+   }
+
+   // mean and standard deviation (Welford)
+   double mean = 0, m2 = 0;
+   for (std::size_t i = 0; i < amu.size(); i++) {
+      const double delta = amu[i] - mean;
+      mean += delta/(i + 1);
+      m2 += delta*(amu[i] - mean);
+   }
+
+   result.mean = mean;
+   result.stddev = std::sqrt(m2/(amu.size() - 1));
+
+   std::sort(amu.begin(), amu.end());
+
+   for (const double p: options.probabilities) {
+      result.quantiles.push_back(quantile(amu, p));
+   }
+
+   return result;
+}
+
+} // namespace gm2calc
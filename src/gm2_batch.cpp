@@ -0,0 +1,590 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_batch.hpp"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/THDM.hpp"
+#include "gm2_parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#if (defined(__unix__) || defined(__APPLE__)) && ATOMIC_LLONG_LOCK_FREE == 2
+#define GM2CALC_HAVE_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gm2calc {
+
+namespace {
+
+const char batch_magic[8] = {'G', 'M', '2', 'C', 'B', 'T', 'C', 'H'};
+constexpr std::uint64_t batch_version = 1;
+constexpr std::size_t cache_line_size = 64;
+
+/**
+ * Waits until the predicate is true.  The waiting thread spins
+ * first, then yields and finally sleeps between the checks, such that
+ * idle workers do not occupy a CPU.
+ */
+template <class Predicate>
+void wait_until(const Predicate& pred)
+{
+   for (unsigned i = 0; !pred(); i++) {
+      if (i < 128) {
+         continue;
+      } else if (i < 4096) {
+         std::this_thread::yield();
+      } else {
+         std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+   }
+}
+
+Eigen::Matrix<double,3,3> diag(const double* d)
+{
+   return Eigen::Vector3d(d[0], d[1], d[2]).asDiagonal();
+}
+
+void evaluate_thdm_mass_basis(Batch_record& r)
+{
+   const double* in = r.input;
+
+   if (in[0] != std::floor(in[0]) || in[0] < 1 || in[0] > 6) {
+      throw EInvalidInput("invalid Yukawa type: " + std::to_string(in[0]) +
+                          " (allowed values: 1,...,6)");
+   }
+
+   thdm::Mass_basis basis;
+   basis.yukawa_type = thdm::int_to_cpp_yukawa_type(static_cast<int>(in[0]));
+   basis.mh = in[1];
+   basis.mH = in[2];
+   basis.mA = in[3];
+   basis.mHp = in[4];
+   basis.sin_beta_minus_alpha = in[5];
+   basis.lambda_6 = in[6];
+   basis.lambda_7 = in[7];
+   basis.tan_beta = in[8];
+   basis.m122 = in[9];
+   basis.zeta_u = in[10];
+   basis.zeta_d = in[11];
+   basis.zeta_l = in[12];
+
+   const THDM model(basis);
+
+   r.amu = calculate_amu_1loop(model) + calculate_amu_2loop(model);
+   r.damu = calculate_uncertainty_amu_2loop(model);
+}
+
+void evaluate_mssmnofv(Batch_record& r)
+{
+   const double* in = r.input;
+
+   MSSMNoFV_onshell model;
+   model.set_TB(in[0]);
+   model.set_Mu(in[1]);
+   model.set_MassB(in[2]);
+   model.set_MassWB(in[3]);
+   model.set_MassG(in[4]);
+   model.set_MA0(in[5]);
+   model.set_scale(in[6]);
+   model.set_mq2(diag(in + 7));
+   model.set_mu2(diag(in + 10));
+   model.set_md2(diag(in + 13));
+   model.set_ml2(diag(in + 16));
+   model.set_me2(diag(in + 19));
+   model.set_Au(diag(in + 22));
+   model.set_Ad(diag(in + 25));
+   model.set_Ae(diag(in + 28));
+   model.calculate_masses();
+
+   if (model.get_problems().have_problem()) {
+      throw EPhysicalProblem(model.get_problems().get_problems());
+   }
+
+   r.amu = calculate_amu_1loop(model) + calculate_amu_2loop(model);
+   r.damu = calculate_uncertainty_amu_2loop(model);
+}
+
+/// evaluates the record and sets the status
+void evaluate_and_set_status(Batch_record& r) noexcept
+{
+   try {
+      evaluate(r);
+      r.status = Batch_ok;
+      return;
+   } catch (const EInvalidInput&) {
+      r.status = Batch_invalid_input;
+   } catch (const EPhysicalProblem&) {
+      r.status = Batch_physical_problem;
+   } catch (...) {
+      r.status = Batch_error;
+   }
+
+   r.amu = r.damu = std::numeric_limits<double>::quiet_NaN();
+}
+
+} // anonymous namespace
+
+/**
+ * Calculates a_mu (1- plus 2-loop) and its uncertainty for the input
+ * parameters of the record with the default SM parameters.
+ *
+ * @param r record
+ */
+void evaluate(Batch_record& r)
+{
+   switch (r.type) {
+   case Batch_thdm_mass_basis:
+      evaluate_thdm_mass_basis(r);
+      break;
+   case Batch_mssmnofv:
+      evaluate_mssmnofv(r);
+      break;
+   default:
+      throw EInvalidInput("unknown batch record type " + std::to_string(r.type));
+   }
+}
+
+/**
+ * @param type_ record type
+ * @param n_ number of points
+ */
+Batch_columns::Batch_columns(Batch_record_type type_, std::size_t n_)
+   : type(type_)
+   , n(n_)
+{
+}
+
+void Batch_columns::set_column(std::size_t i, const double* values_)
+{
+   if (i >= Batch_record::max_inputs) {
+      throw ESetupError("input parameter index " + std::to_string(i) + " out of range");
+   }
+   columns[i] = values_;
+}
+
+void Batch_columns::set_value(std::size_t i, double value)
+{
+   if (i >= Batch_record::max_inputs) {
+      throw ESetupError("input parameter index " + std::to_string(i) + " out of range");
+   }
+   columns[i] = nullptr;
+   values[i] = value;
+}
+
+void Batch_columns::fill(std::size_t k, Batch_record& r) const
+{
+   r.type = type;
+
+   for (std::size_t i = 0; i < Batch_record::max_inputs; i++) {
+      r.input[i] = columns[i] ? columns[i][k] : values[i];
+   }
+}
+
+/**
+ * Calculates a_mu (1- plus 2-loop) and its uncertainty for all points
+ * with the default SM parameters.  The points are distributed
+ * dynamically over the threads.  If the evaluation of a point fails,
+ * its results are NaN and the status describes the error.
+ *
+ * @param columns input parameters
+ * @param amu array of n values of a_mu (output)
+ * @param damu array of n uncertainties of a_mu (output)
+ * @param status array of n status codes (output)
+ * @param threads number of threads (0 = number of hardware threads)
+ */
+void evaluate(const Batch_columns& columns, double* amu, double* damu,
+              std::uint32_t* status, unsigned threads)
+{
+   parallel_for(columns.size(), threads, [&] (std::size_t k) {
+      Batch_record r;
+      columns.fill(k, r);
+      evaluate_and_set_status(r);
+      amu[k] = r.amu;
+      damu[k] = r.damu;
+      status[k] = r.status;
+   });
+}
+
+/**
+ * @class Batch_queue::Header
+ * @brief header of the queue memory
+ *
+ * The records are numbered in the order in which they are written.
+ * The counters are only modified by the producer (head, tail) or the
+ * workers (claim), respectively.
+ */
+struct Batch_queue::Header {
+   char magic[8]{};                   ///< magic number
+   std::uint64_t version{0};          ///< format version
+   std::uint64_t capacity{0};         ///< number of slots
+   std::atomic<std::uint64_t> closed{0}; ///< queue is closed
+   alignas(cache_line_size) std::atomic<std::uint64_t> head{0};  ///< next record to write
+   alignas(cache_line_size) std::atomic<std::uint64_t> tail{0};  ///< next record to read
+   alignas(cache_line_size) std::atomic<std::uint64_t> claim{0}; ///< next record to evaluate
+};
+
+/**
+ * @class Batch_queue::Slot
+ * @brief slot of the ring buffer
+ *
+ * The sequence number of the slot for record n is 3n when the slot is
+ * free, 3n+1 when the input has been written and 3n+2 when the result
+ * has been written.  When the producer has read the result, the slot
+ * is released for record n + capacity.
+ */
+struct Batch_queue::Slot {
+   alignas(cache_line_size) std::atomic<std::uint64_t> seq{0}; ///< sequence number
+   Batch_record record;                                         ///< record
+};
+
+/**
+ * Creates a queue with the given capacity in the memory of the
+ * process.
+ *
+ * @param capacity number of slots
+ */
+Batch_queue::Batch_queue(std::size_t capacity)
+   : owner(true)
+{
+   if (capacity == 0) {
+      throw ESetupError("batch queue capacity must be positive");
+   }
+
+   size = sizeof(Header) + capacity * sizeof(Slot) + cache_line_size;
+   memory = ::operator new(size);
+
+   init(capacity);
+}
+
+/**
+ * Creates a queue with the given capacity in a named POSIX shared
+ * memory object, which is removed when the queue is destroyed.
+ *
+ * @param name_ name of the shared memory object (e.g. /gm2calc)
+ * @param capacity number of slots
+ */
+Batch_queue::Batch_queue(const std::string& name_, std::size_t capacity)
+   : name(name_)
+   , owner(true)
+{
+#ifdef GM2CALC_HAVE_SHM
+   if (capacity == 0) {
+      throw ESetupError("batch queue capacity must be positive");
+   }
+
+   size = sizeof(Header) + capacity * sizeof(Slot) + cache_line_size;
+
+   const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+   if (fd < 0) {
+      throw ESetupError("cannot create shared memory \"" + name + "\": " + std::strerror(errno));
+   }
+
+   if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      const std::string msg = std::strerror(errno);
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      throw ESetupError("cannot resize shared memory \"" + name + "\": " + msg);
+   }
+
+   memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   ::close(fd);
+
+   if (memory == MAP_FAILED) {
+      memory = nullptr;
+      ::shm_unlink(name.c_str());
+      throw ESetupError("cannot map shared memory \"" + name + "\"");
+   }
+
+   init(capacity);
+#else
+   (void)capacity;
+   throw ESetupError("shared memory is not supported on this platform");
+#endif
+}
+
+/**
+ * Opens a queue, which has been created by another process in a named
+ * POSIX shared memory object.
+ *
+ * @param name_ name of the shared memory object
+ */
+Batch_queue::Batch_queue(const std::string& name_)
+   : name(name_)
+{
+#ifdef GM2CALC_HAVE_SHM
+   const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+
+   if (fd < 0) {
+      throw ESetupError("cannot open shared memory \"" + name + "\": " + std::strerror(errno));
+   }
+
+   struct stat st{};
+
+   if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header) + cache_line_size) {
+      ::close(fd);
+      throw EReadError("\"" + name + "\" is not a GM2Calc batch queue");
+   }
+
+   size = static_cast<std::size_t>(st.st_size);
+   memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   ::close(fd);
+
+   if (memory == MAP_FAILED) {
+      memory = nullptr;
+      throw ESetupError("cannot map shared memory \"" + name + "\"");
+   }
+
+   attach();
+
+   if (std::memcmp(header->magic, batch_magic, sizeof(batch_magic)) != 0 ||
+       header->version != batch_version ||
+       sizeof(Header) + header->capacity * sizeof(Slot) + cache_line_size > size) {
+      ::munmap(memory, size);
+      memory = nullptr;
+      throw EReadError("\"" + name + "\" is not a GM2Calc batch queue");
+   }
+#else
+   throw ESetupError("shared memory is not supported on this platform");
+#endif
+}
+
+/**
+ * Closes the queue, if it has been created by this object, and
+ * releases the memory.
+ */
+Batch_queue::~Batch_queue()
+{
+   if (!memory) {
+      return;
+   }
+
+   if (owner) {
+      close();
+   }
+
+   if (name.empty()) {
+      ::operator delete(memory);
+   } else {
+#ifdef GM2CALC_HAVE_SHM
+      ::munmap(memory, size);
+      if (owner) {
+         ::shm_unlink(name.c_str());
+      }
+#endif
+   }
+}
+
+/// sets the pointers to the (aligned) header and the slots
+void Batch_queue::attach()
+{
+   auto address = reinterpret_cast<std::uintptr_t>(memory);
+   address = (address + cache_line_size - 1) / cache_line_size * cache_line_size;
+   header = reinterpret_cast<Header*>(address);
+   slots = reinterpret_cast<Slot*>(address + sizeof(Header));
+}
+
+/// initializes the header and the slots
+void Batch_queue::init(std::size_t capacity)
+{
+   attach();
+
+   new (header) Header();
+   std::memcpy(header->magic, batch_magic, sizeof(batch_magic));
+   header->version = batch_version;
+   header->capacity = capacity;
+
+   for (std::size_t i = 0; i < capacity; i++) {
+      new (slots + i) Slot();
+      slots[i].seq.store(3 * i, std::memory_order_release);
+   }
+}
+
+Batch_queue::Slot& Batch_queue::get_slot(std::uint64_t n) const
+{
+   return slots[n % header->capacity];
+}
+
+std::size_t Batch_queue::get_capacity() const
+{
+   return header->capacity;
+}
+
+std::size_t Batch_queue::get_number_of_pending() const
+{
+   return header->head.load(std::memory_order_relaxed) -
+          header->tail.load(std::memory_order_relaxed);
+}
+
+bool Batch_queue::is_closed() const
+{
+   return header->closed.load(std::memory_order_acquire) != 0;
+}
+
+/**
+ * Closes the queue.  The workers return from consume() as soon as
+ * there is no record left to evaluate.
+ */
+void Batch_queue::close()
+{
+   header->closed.store(1, std::memory_order_release);
+}
+
+/**
+ * Waits until the slot of the next record is free and returns the
+ * record.  The record must be passed to the workers with end_write().
+ *
+ * @return record to write the input parameters to
+ */
+Batch_record& Batch_queue::begin_write()
+{
+   const auto n = header->head.load(std::memory_order_relaxed);
+   auto& slot = get_slot(n);
+
+   wait_until([&] () { return slot.seq.load(std::memory_order_acquire) == 3 * n; });
+
+   return slot.record;
+}
+
+void Batch_queue::end_write()
+{
+   const auto n = header->head.load(std::memory_order_relaxed);
+   get_slot(n).seq.store(3 * n + 1, std::memory_order_release);
+   header->head.store(n + 1, std::memory_order_relaxed);
+}
+
+/**
+ * Waits until the oldest record, which has not been read yet, has
+ * been evaluated, and returns it.  The slot must be released with
+ * end_read().
+ *
+ * @return evaluated record
+ */
+const Batch_record& Batch_queue::begin_read()
+{
+   const auto n = header->tail.load(std::memory_order_relaxed);
+
+   if (n == header->head.load(std::memory_order_relaxed)) {
+      throw ESetupError("no record has been written to the batch queue");
+   }
+
+   auto& slot = get_slot(n);
+
+   wait_until([&] () { return slot.seq.load(std::memory_order_acquire) == 3 * n + 2; });
+
+   return slot.record;
+}
+
+void Batch_queue::end_read()
+{
+   const auto n = header->tail.load(std::memory_order_relaxed);
+   get_slot(n).seq.store(3 * (n + header->capacity), std::memory_order_release);
+   header->tail.store(n + 1, std::memory_order_relaxed);
+}
+
+/**
+ * Evaluates the given records by passing them through the queue.  At
+ * most get_capacity() records are in flight at the same time.  The
+ * queue must not contain pending records.
+ *
+ * @param records records
+ * @param n number of records
+ */
+void Batch_queue::process(Batch_record* records, std::size_t n)
+{
+   const std::size_t capacity = get_capacity();
+   std::size_t written = 0;
+
+   for (std::size_t i = 0; i < n; i++) {
+      while (written < n && written - i < capacity) {
+         begin_write() = records[written++];
+         end_write();
+      }
+      records[i] = begin_read();
+      end_read();
+   }
+}
+
+/**
+ * Claims the next record, waits until it has been written, evaluates
+ * it and passes the result back to the producer.
+ *
+ * @return false if the queue has been closed, true otherwise
+ */
+bool Batch_queue::consume()
+{
+   const auto n = header->claim.fetch_add(1, std::memory_order_relaxed);
+   auto& slot = get_slot(n);
+
+   wait_until([&] () {
+      return slot.seq.load(std::memory_order_acquire) == 3 * n + 1 || is_closed();
+   });
+
+   if (slot.seq.load(std::memory_order_acquire) != 3 * n + 1) {
+      return false;
+   }
+
+   evaluate_and_set_status(slot.record);
+   slot.seq.store(3 * n + 2, std::memory_order_release);
+
+   return true;
+}
+
+/**
+ * Starts the given number of worker threads, which evaluate the
+ * records of the queue.
+ *
+ * @param queue_ queue
+ * @param threads number of threads
+ */
+Batch_worker_pool::Batch_worker_pool(Batch_queue& queue_, unsigned threads)
+   : queue(queue_)
+{
+   for (unsigned i = 0; i < std::max(1u, threads); i++) {
+      workers.emplace_back([this] () { while (queue.consume()) {} });
+   }
+}
+
+/**
+ * Closes the queue and joins the worker threads.
+ */
+Batch_worker_pool::~Batch_worker_pool()
+{
+   queue.close();
+
+   for (auto& w: workers) {
+      w.join();
+   }
+}
+
+} // namespace gm2calc
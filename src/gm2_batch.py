@@ -0,0 +1,140 @@
+#!/usr/bin/env python
+
+# ====================================================================
+# This file is part of GM2Calc.
+#
+# GM2Calc is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published
+# by the Free Software Foundation, either version 3 of the License,
+# or (at your option) any later version.
+#
+# GM2Calc is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GM2Calc.  If not, see
+# <http://www.gnu.org/licenses/>.
+# ====================================================================
+
+"""NumPy batch interface of GM2Calc.
+
+Evaluates a_mu (1- plus 2-loop) and its uncertainty for many
+parameter points in one call.  Each input parameter is given either
+as a one-dimensional array (NumPy array or any object supporting the
+buffer protocol) or as a scalar, which is used for all points.
+Parameters which are not given are zero.  The arrays are passed to
+C++ without copies (if they are contiguous float64 arrays), the GIL
+is released and the points are evaluated on the given number of
+threads (0 = number of hardware threads).  The SM parameters and the
+configuration options are set to their default values, see
+include/gm2calc/gm2_batch.hpp.
+
+Example:
+
+    import numpy
+    import gm2_batch
+
+    mH = numpy.linspace(300, 600, 10000)
+    amu, damu, status = gm2_batch.thdm_mass_basis(
+        yukawa_type=2, mh=125, mH=mH, mA=420, mHp=440,
+        sin_beta_minus_alpha=0.999, tan_beta=3, m122=40000, threads=4)
+
+The results can be written into preallocated arrays with
+out=(amu, damu, status), where amu and damu are float64 arrays and
+status is a uint32 array.  A non-zero status marks a point which
+could not be evaluated (the results are NaN in this case):
+INVALID_INPUT, PHYSICAL_PROBLEM or ERROR.
+"""
+
+from gm2_python_interface import *
+
+import numpy
+
+cppyy.include(os.path.join("gm2calc","gm2_batch.hpp"))
+
+cppyy.load_library("libgm2calc")
+
+from cppyy.gbl import gm2calc
+
+gm2calc.evaluate.__release_gil__ = True
+
+OK, INVALID_INPUT, PHYSICAL_PROBLEM, ERROR = range(4)
+
+THDM_MASS_BASIS_PARAMETERS = [
+    "yukawa_type", "mh", "mH", "mA", "mHp", "sin_beta_minus_alpha",
+    "lambda_6", "lambda_7", "tan_beta", "m122", "zeta_u", "zeta_d", "zeta_l",
+]
+
+MSSMNOFV_PARAMETERS = ["TB", "Mu", "MassB", "MassWB", "MassG", "MA0", "scale"] + [
+    "{}_{}{}".format(m, i, i)
+    for m in ["mq2", "mu2", "md2", "ml2", "me2", "Au", "Ad", "Ae"]
+    for i in range(1, 4)
+]
+
+def _check_output(array, n, dtype, name):
+    if not isinstance(array, numpy.ndarray) or array.dtype != dtype or \
+       array.shape != (n,) or not array.flags.c_contiguous or \
+       not array.flags.writeable:
+        raise ValueError("{} must be a writeable contiguous {} array of length {}".format(
+            name, numpy.dtype(dtype).name, n))
+
+def _evaluate(record_type, names, threads, out, parameters):
+    unknown = [p for p in parameters if p not in names]
+    if unknown:
+        raise TypeError("unknown parameters: " + ", ".join(unknown))
+
+    arrays = {}
+    n = None
+
+    for name, value in parameters.items():
+        array = numpy.asarray(value, dtype=numpy.float64)
+        if array.ndim == 0:
+            continue
+        if array.ndim != 1:
+            raise ValueError("parameter {} is not one-dimensional".format(name))
+        if n is None:
+            n = len(array)
+        elif len(array) != n:
+            raise ValueError("parameter {} has length {} (expected {})".format(name, len(array), n))
+        arrays[name] = numpy.ascontiguousarray(array)
+
+    if n is None:
+        n = 1
+
+    columns = gm2calc.Batch_columns(record_type, n)
+
+    for i, name in enumerate(names):
+        if name in arrays:
+            columns.set_column(i, arrays[name])
+        elif name in parameters:
+            columns.set_value(i, float(parameters[name]))
+
+    if out is None:
+        amu = numpy.empty(n)
+        damu = numpy.empty(n)
+        status = numpy.empty(n, dtype=numpy.uint32)
+    else:
+        amu, damu, status = out
+        _check_output(amu, n, numpy.float64, "amu")
+        _check_output(damu, n, numpy.float64, "damu")
+        _check_output(status, n, numpy.uint32, "status")
+
+    if n > 0:
+        gm2calc.evaluate(columns, amu, damu, status, threads)
+
+    return amu, damu, status
+
+def thdm_mass_basis(threads=0, out=None, **parameters):
+    """returns (amu, damu, status) for THDM mass basis parameters
+    (see THDM_MASS_BASIS_PARAMETERS)"""
+    return _evaluate(gm2calc.Batch_thdm_mass_basis, THDM_MASS_BASIS_PARAMETERS,
+                     threads, out, parameters)
+
+def mssmnofv(threads=0, out=None, **parameters):
+    """returns (amu, damu, status) for MSSMNoFV parameters in the
+    GM2Calc input scheme (see MSSMNOFV_PARAMETERS, the matrices are
+    given by their diagonal elements, e.g. mq2_11)"""
+    return _evaluate(gm2calc.Batch_mssmnofv, MSSMNOFV_PARAMETERS,
+                     threads, out, parameters)
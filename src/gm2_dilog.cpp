@@ -17,6 +17,7 @@
 // ====================================================================
 
 #include "gm2_dilog.hpp"
+#include "gm2_dual.hpp"
 #include <cmath>
 #include <limits>
 
@@ -142,6 +143,19 @@ double dilog(double x) noexcept
    return r + s*y*p/q;
 }
 
+/**
+ * @brief Real dilogarithm \f$\operatorname{Li}_2(x)\f$ and its derivatives
+ * @param x real argument with derivatives
+ * @return \f$\operatorname{Li}_2(x)\f$ with
+ * \f$\operatorname{Li}_2'(x) = -\log|1-x|/x\f$
+ */
+Dual<double> dilog(const Dual<double>& x) noexcept
+{
+   const double df = x.val == 0 ? 1.0
+      : (x.val < 1 ? -std::log1p(-x.val) : -std::log(x.val - 1))/x.val;
+   return apply_chain_rule(x, dilog(x.val), df);
+}
+
 /**
  * @brief Complex dilogarithm \f$\mathrm{Li}_2(z)\f$
  * @param z complex argument
@@ -300,4 +314,16 @@ double clausen_2(double x) noexcept
    return sgn*h;
 }
 
+/**
+ * @brief Clausen function \f$\mathrm{Cl}_2(\theta)\f$ and its derivatives
+ * @param x real angle with derivatives
+ * @return \f$\mathrm{Cl}_2(\theta)\f$ with
+ * \f$\mathrm{Cl}_2'(\theta) = -\log|2\sin(\theta/2)|\f$
+ */
+Dual<double> clausen_2(const Dual<double>& x) noexcept
+{
+   const double df = -std::log(std::abs(2*std::sin(0.5*x.val)));
+   return apply_chain_rule(x, clausen_2(x.val), df);
+}
+
 } // namespace gm2calc
@@ -23,15 +23,23 @@
 
 namespace gm2calc {
 
+template <class T> class Dual;
+
 /// real dilogarithm
 double dilog(double) noexcept;
 
+/// real dilogarithm of a Dual number
+Dual<double> dilog(const Dual<double>&) noexcept;
+
 /// complex dilogarithm
 std::complex<double> dilog(const std::complex<double>&) noexcept;
 
 /// Clausen function Cl_2(x)
 double clausen_2(double x) noexcept;
 
+/// Clausen function Cl_2(x) of a Dual number
+Dual<double> clausen_2(const Dual<double>&) noexcept;
+
 } // namespace gm2calc
 
 #endif
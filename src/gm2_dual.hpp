@@ -0,0 +1,466 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_DUAL_HPP
+#define GM2_DUAL_HPP
+
+#include "gm2_numerics.hpp"
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+#include <Eigen/Core>
+
+/**
+ * \file gm2_dual.hpp
+ *
+ * Contains a dual number type for forward-mode automatic
+ * differentiation.
+ */
+
+namespace gm2calc {
+
+/// maximum number of independent variables of a Dual number
+constexpr int dual_dimension = 12;
+
+/**
+ * @class Dual
+ * @brief number with its first derivatives w.r.t. independent variables
+ *
+ * A Dual<T> represents \f$x + \sum_i x_i \epsilon_i\f$ with
+ * \f$\epsilon_i \epsilon_j = 0\f$, where \f$x_i\f$ is the partial
+ * derivative of \f$x\f$ w.r.t. the i-th independent variable.  The
+ * arithmetic operators and the elementary functions defined below
+ * propagate the derivatives by the chain rule.  T is double or
+ * std::complex<double>.  Comparisons take only the value into
+ * account.
+ */
+template <class T>
+class Dual {
+public:
+   T val{};                              ///< value
+   std::array<T, dual_dimension> grad{}; ///< partial derivatives
+
+   Dual() noexcept = default;
+   /// constant
+   Dual(const T& v) noexcept : val(v) {}
+   /// real constant
+   template <class S, class = typename std::enable_if<
+                         !std::is_same<T,S>::value && std::is_arithmetic<S>::value>::type>
+   Dual(S v) noexcept : val(v) {}
+   /// i-th independent variable with value v
+   Dual(const T& v, int i) noexcept : val(v) { grad[i] = T(1); }
+   /// conversion from a real to a complex Dual
+   template <class U, class = typename std::enable_if<
+                         !std::is_same<T,U>::value && std::is_convertible<U,T>::value>::type>
+   Dual(const Dual<U>& other) noexcept : val(other.val)
+   {
+      for (int i = 0; i < dual_dimension; ++i) {
+         grad[i] = other.grad[i];
+      }
+   }
+
+   template <class U> Dual& operator+=(const U& other) noexcept { return *this = *this + other; }
+   template <class U> Dual& operator-=(const U& other) noexcept { return *this = *this - other; }
+   template <class U> Dual& operator*=(const U& other) noexcept { return *this = *this * other; }
+   template <class U> Dual& operator/=(const U& other) noexcept { return *this = *this / other; }
+};
+
+/// value type of the result of an operation with T and U
+template <class T, class U>
+using Dual_result_t = decltype(std::declval<T>()*std::declval<U>());
+
+/// scalar types which can be combined with a Dual
+template <class S, class = void>
+struct Dual_scalar {};
+
+template <class S>
+struct Dual_scalar<S, typename std::enable_if<std::is_arithmetic<S>::value>::type> {
+   using type = double;
+};
+
+template <>
+struct Dual_scalar<std::complex<double>, void> {
+   using type = std::complex<double>;
+};
+
+template <class S>
+using Dual_scalar_t = typename Dual_scalar<S>::type;
+
+/// complex number type with real and imaginary parts of type Real
+template <class Real>
+struct Complex_type {
+   using type = std::complex<Real>;
+};
+
+template <>
+struct Complex_type<Dual<double>> {
+   using type = Dual<std::complex<double>>;
+};
+
+// === arithmetic operators ===
+
+template <class T>
+Dual<T> operator+(const Dual<T>& a) noexcept
+{
+   return a;
+}
+
+template <class T>
+Dual<T> operator-(const Dual<T>& a) noexcept
+{
+   Dual<T> r(-a.val);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = -a.grad[i];
+   }
+   return r;
+}
+
+template <class T, class U>
+Dual<Dual_result_t<T,U>> operator+(const Dual<T>& a, const Dual<U>& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(a.val + b.val);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = a.grad[i] + b.grad[i];
+   }
+   return r;
+}
+
+template <class T, class S, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator+(const Dual<T>& a, const S& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(a);
+   r.val += static_cast<U>(b);
+   return r;
+}
+
+template <class S, class T, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator+(const S& a, const Dual<T>& b) noexcept
+{
+   return b + a;
+}
+
+template <class T, class U>
+Dual<Dual_result_t<T,U>> operator-(const Dual<T>& a, const Dual<U>& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(a.val - b.val);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = a.grad[i] - b.grad[i];
+   }
+   return r;
+}
+
+template <class T, class S, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator-(const Dual<T>& a, const S& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(a);
+   r.val -= static_cast<U>(b);
+   return r;
+}
+
+template <class S, class T, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator-(const S& a, const Dual<T>& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(-b);
+   r.val += static_cast<U>(a);
+   return r;
+}
+
+template <class T, class U>
+Dual<Dual_result_t<T,U>> operator*(const Dual<T>& a, const Dual<U>& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(a.val*b.val);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = a.grad[i]*b.val + a.val*b.grad[i];
+   }
+   return r;
+}
+
+template <class T, class S, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator*(const Dual<T>& a, const S& b) noexcept
+{
+   const U s = static_cast<U>(b);
+   Dual<Dual_result_t<T,U>> r(a.val*s);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = a.grad[i]*s;
+   }
+   return r;
+}
+
+template <class S, class T, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator*(const S& a, const Dual<T>& b) noexcept
+{
+   return b*a;
+}
+
+template <class T, class U>
+Dual<Dual_result_t<T,U>> operator/(const Dual<T>& a, const Dual<U>& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(a.val/b.val);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = (a.grad[i] - r.val*b.grad[i])/b.val;
+   }
+   return r;
+}
+
+template <class T, class S, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator/(const Dual<T>& a, const S& b) noexcept
+{
+   const U s = static_cast<U>(b);
+   Dual<Dual_result_t<T,U>> r(a.val/s);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = a.grad[i]/s;
+   }
+   return r;
+}
+
+template <class S, class T, class U = Dual_scalar_t<S>>
+Dual<Dual_result_t<T,U>> operator/(const S& a, const Dual<T>& b) noexcept
+{
+   Dual<Dual_result_t<T,U>> r(static_cast<U>(a)/b.val);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = -r.val*b.grad[i]/b.val;
+   }
+   return r;
+}
+
+// === comparison of real Duals ===
+
+inline bool operator==(const Dual<double>& a, const Dual<double>& b) noexcept { return a.val == b.val; }
+inline bool operator!=(const Dual<double>& a, const Dual<double>& b) noexcept { return a.val != b.val; }
+inline bool operator< (const Dual<double>& a, const Dual<double>& b) noexcept { return a.val <  b.val; }
+inline bool operator<=(const Dual<double>& a, const Dual<double>& b) noexcept { return a.val <= b.val; }
+inline bool operator> (const Dual<double>& a, const Dual<double>& b) noexcept { return a.val >  b.val; }
+inline bool operator>=(const Dual<double>& a, const Dual<double>& b) noexcept { return a.val >= b.val; }
+
+inline bool is_zero(const Dual<double>& a, double eps) noexcept
+{
+   return is_zero(a.val, eps);
+}
+
+inline bool is_equal(const Dual<double>& a, const Dual<double>& b, double eps) noexcept
+{
+   return is_equal(a.val, b.val, eps);
+}
+
+inline bool is_equal_rel(const Dual<double>& a, const Dual<double>& b, double eps) noexcept
+{
+   return is_equal_rel(a.val, b.val, eps);
+}
+
+// === elementary functions ===
+
+/**
+ * Returns f(x) from the value f and the derivative df of the function
+ * at x.val.
+ */
+template <class T>
+Dual<T> apply_chain_rule(const Dual<T>& x, const T& f, const T& df) noexcept
+{
+   Dual<T> r(f);
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = df*x.grad[i];
+   }
+   return r;
+}
+
+template <class T>
+Dual<T> sqrt(const Dual<T>& x) noexcept
+{
+   const T f = std::sqrt(x.val);
+   return apply_chain_rule(x, f, T(0.5)/f);
+}
+
+template <class T>
+Dual<T> log(const Dual<T>& x) noexcept
+{
+   return apply_chain_rule(x, T(std::log(x.val)), T(1)/x.val);
+}
+
+template <class T>
+Dual<T> exp(const Dual<T>& x) noexcept
+{
+   const T f = std::exp(x.val);
+   return apply_chain_rule(x, f, f);
+}
+
+inline Dual<double> pow(const Dual<double>& x, double p) noexcept
+{
+   const double f = std::pow(x.val, p);
+   return apply_chain_rule(x, f, p*std::pow(x.val, p - 1));
+}
+
+inline Dual<double> sin(const Dual<double>& x) noexcept
+{
+   return apply_chain_rule(x, std::sin(x.val), std::cos(x.val));
+}
+
+inline Dual<double> cos(const Dual<double>& x) noexcept
+{
+   return apply_chain_rule(x, std::cos(x.val), -std::sin(x.val));
+}
+
+inline Dual<double> asin(const Dual<double>& x) noexcept
+{
+   return apply_chain_rule(x, std::asin(x.val), 1/std::sqrt(1 - x.val*x.val));
+}
+
+inline Dual<double> acos(const Dual<double>& x) noexcept
+{
+   return apply_chain_rule(x, std::acos(x.val), -1/std::sqrt(1 - x.val*x.val));
+}
+
+inline Dual<double> atan(const Dual<double>& x) noexcept
+{
+   return apply_chain_rule(x, std::atan(x.val), 1/(1 + x.val*x.val));
+}
+
+inline Dual<double> atan2(const Dual<double>& y, const Dual<double>& x) noexcept
+{
+   const double r2 = x.val*x.val + y.val*y.val;
+   Dual<double> r(std::atan2(y.val, x.val));
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = (x.val*y.grad[i] - y.val*x.grad[i])/r2;
+   }
+   return r;
+}
+
+inline Dual<double> abs(const Dual<double>& x) noexcept
+{
+   return x.val < 0 ? -x : x;
+}
+
+inline Dual<double> fabs(const Dual<double>& x) noexcept
+{
+   return abs(x);
+}
+
+inline Dual<double> real(const Dual<double>& x) noexcept { return x; }
+inline Dual<double> imag(const Dual<double>&) noexcept { return {}; }
+inline Dual<double> conj(const Dual<double>& x) noexcept { return x; }
+inline Dual<double> norm(const Dual<double>& x) noexcept { return x*x; }
+
+inline Dual<double> real(const Dual<std::complex<double>>& z) noexcept
+{
+   Dual<double> r(std::real(z.val));
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = std::real(z.grad[i]);
+   }
+   return r;
+}
+
+inline Dual<double> imag(const Dual<std::complex<double>>& z) noexcept
+{
+   Dual<double> r(std::imag(z.val));
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = std::imag(z.grad[i]);
+   }
+   return r;
+}
+
+inline Dual<std::complex<double>> conj(const Dual<std::complex<double>>& z) noexcept
+{
+   Dual<std::complex<double>> r(std::conj(z.val));
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = std::conj(z.grad[i]);
+   }
+   return r;
+}
+
+inline Dual<double> norm(const Dual<std::complex<double>>& z) noexcept
+{
+   Dual<double> r(std::norm(z.val));
+   for (int i = 0; i < dual_dimension; ++i) {
+      r.grad[i] = 2*std::real(std::conj(z.val)*z.grad[i]);
+   }
+   return r;
+}
+
+/// returns the value of x
+inline double value_of(double x) noexcept
+{
+   return x;
+}
+
+/// returns the value of x
+inline double value_of(const Dual<double>& x) noexcept
+{
+   return x.val;
+}
+
+/// returns x with the value replaced by v
+inline double with_value(double, double v) noexcept
+{
+   return v;
+}
+
+/// returns x with the value replaced by v, keeping the derivatives
+inline Dual<double> with_value(Dual<double> x, double v) noexcept
+{
+   x.val = v;
+   return x;
+}
+
+} // namespace gm2calc
+
+namespace Eigen {
+
+/// allows to store Dual numbers in Eigen matrices
+template <>
+struct NumTraits<gm2calc::Dual<double>> : NumTraits<double> {
+   using Real = gm2calc::Dual<double>;
+   using NonInteger = gm2calc::Dual<double>;
+   using Nested = gm2calc::Dual<double>;
+   using Literal = gm2calc::Dual<double>;
+
+   enum {
+      IsComplex = 0,
+      IsInteger = 0,
+      IsSigned = 1,
+      RequireInitialization = 1,
+      ReadCost = 1,
+      AddCost = gm2calc::dual_dimension + 1,
+      MulCost = 3*gm2calc::dual_dimension + 1
+   };
+};
+
+/// allows to store complex Dual numbers in Eigen matrices
+template <>
+struct NumTraits<gm2calc::Dual<std::complex<double>>> : NumTraits<std::complex<double>> {
+   using Real = gm2calc::Dual<double>;
+   using NonInteger = gm2calc::Dual<std::complex<double>>;
+   using Nested = gm2calc::Dual<std::complex<double>>;
+   using Literal = gm2calc::Dual<std::complex<double>>;
+
+   enum {
+      IsComplex = 1,
+      IsInteger = 0,
+      IsSigned = 1,
+      RequireInitialization = 1,
+      ReadCost = 2,
+      AddCost = 2*(gm2calc::dual_dimension + 1),
+      MulCost = 6*(3*gm2calc::dual_dimension + 1)
+   };
+};
+
+} // namespace Eigen
+
+#endif
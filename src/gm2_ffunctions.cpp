@@ -18,6 +18,7 @@
 
 #include "gm2_ffunctions.hpp"
 #include "gm2_dilog.hpp"
+#include "gm2_dual.hpp"
 #include "gm2_log.hpp"
 #include "gm2_numerics.hpp"
 
@@ -32,27 +33,39 @@ namespace {
    constexpr double eps = 10.0*std::numeric_limits<double>::epsilon();
    const double qdrt_eps = std::pow(eps, 0.25);
 
+   // the functions below are templates, which are instantiated with
+   // Real = double and Real = Dual<double>
+   using std::abs;
+   using std::acos;
+   using std::asin;
+   using std::atan2;
+   using std::log;
+   using std::sqrt;
+
    /// shift values symmetrically away from equality, if they are close
-   void shift(double& x, double& y, double rel_diff) noexcept
+   template <class Real>
+   void shift(Real& x, Real& y, double rel_diff) noexcept
    {
       if (is_equal_rel(x, y, rel_diff)) {
-         const double mid = 0.5*std::abs(y + x);
+         const double mid = 0.5*std::abs(value_of(y) + value_of(x));
          if (x < y) {
-            x = (1 - rel_diff)*mid;
-            y = (1 + rel_diff)*mid;
+            x = with_value(x, (1 - rel_diff)*mid);
+            y = with_value(y, (1 + rel_diff)*mid);
          } else {
-            x = (1 + rel_diff)*mid;
-            y = (1 - rel_diff)*mid;
+            x = with_value(x, (1 + rel_diff)*mid);
+            y = with_value(y, (1 - rel_diff)*mid);
          }
       }
    }
 
-   void sort(double& x, double& y) noexcept
+   template <class Real>
+   void sort(Real& x, Real& y) noexcept
    {
       if (x > y) { std::swap(x, y); }
    }
 
-   void sort(double& x, double& y, double& z) noexcept
+   template <class Real>
+   void sort(Real& x, Real& y, Real& z) noexcept
    {
       if (x > y) { std::swap(x, y); }
       if (y > z) { std::swap(y, z); }
@@ -61,131 +74,141 @@ namespace {
 
    /// calculates phi(xd, xu, 1)/y with y = (xu - xd)^2 - 2*(xu + xd) + 1,
    /// properly handle the case y = 0
-   double phi_over_y(double xu, double xd) noexcept
+   template <class Real>
+   Real phi_over_y(const Real& xu, const Real& xd) noexcept
    {
-      const double sqrtxd = std::sqrt(xd);
-      const double ixd = 1/xd;
+      const Real sqrtxd = sqrt(xd);
+      const Real ixd = 1/xd;
       constexpr double eps = 1e-8;
 
       // test two cases where y == 0
-      if (std::abs((xu - 1)*ixd + 2/sqrtxd - 1) < eps) {
-         return -std::log(std::abs(-1 + sqrtxd))/sqrtxd + std::log(xd)/(2*(-1 + sqrtxd));
-      } else if (std::abs((xu - 1)*ixd - 2/sqrtxd - 1) < eps) {
-         return std::log(1 + sqrtxd)/sqrtxd - std::log(xd)/(2*(1 + sqrtxd));
+      if (abs((xu - 1)*ixd + 2/sqrtxd - 1) < eps) {
+         return -log(abs(-1 + sqrtxd))/sqrtxd + log(xd)/(2*(-1 + sqrtxd));
+      } else if (abs((xu - 1)*ixd - 2/sqrtxd - 1) < eps) {
+         return log(1 + sqrtxd)/sqrtxd - log(xd)/(2*(1 + sqrtxd));
       }
 
-      const double y = sqr(xu - xd) - 2*(xu + xd) + 1;
-      const double phi = Phi(xd, xu, 1);
+      const Real y = sqr(xu - xd) - 2*(xu + xd) + 1;
+      const Real phi = Phi(xd, xu, Real(1));
 
       return phi/y;
    }
 
    /// lambda^2(u,v)
-   double lambda_2(double u, double v) noexcept
+   template <class Real>
+   Real lambda_2(const Real& u, const Real& v) noexcept
    {
       return sqr(1 - u - v) - 4*u*v;
    }
 
    /// expansion of (1 - lambda + u - v)/2 for u ~ v ~ 0 up to including O(u^3 v^3)
-   double l00(double u, double v) noexcept
+   template <class Real>
+   Real l00(const Real& u, const Real& v) noexcept
    {
       return v*(1 + u*(1 + u*(1 + u)) + v*(u*(1 + u*(3 + 6*u)) + u*(1 + u*(6 + 20*u))*v));
    }
 
    /// expansion of (1 - lambda + u - v)/2 for u ~ 0 and v < 1 up to including O(u^3 v^3)
-   double l0v(double u, double v) noexcept
+   template <class Real>
+   Real l0v(const Real& u, const Real& v) noexcept
    {
-      const double a = 1 - v;
-      const double a2 = a*a;
-      const double a3 = a2*a;
+      const Real a = 1 - v;
+      const Real a2 = a*a;
+      const Real a3 = a2*a;
       return u*(0.5*(1 + (1 + v)/a) + u*(v + u*v*(1 + v)/a2)/a3);
    }
 
    /// expansion of (1 - lambda - u + v)/2 for u ~ 0 and v < 1 up to including O(u^3 v^3)
-   double lv0(double u, double v) noexcept
+   template <class Real>
+   Real lv0(const Real& u, const Real& v) noexcept
    {
-      const double a = 1 - v;
-      const double a2 = a*a;
-      const double a3 = a2*a;
+      const Real a = 1 - v;
+      const Real a2 = a*a;
+      const Real a3 = a2*a;
       return v + u*(0.5*(-1 + (1 + v)/a) + u*(v + u*v*(1 + v)/a2)/a3);
    }
 
    /// returns tuple (0.5*(1 - lambda + u - v), 0.5*(1 - lambda - u + v))
-   std::tuple<double,double> luv(double lambda, double u, double v) noexcept
+   template <class Real>
+   std::tuple<Real,Real> luv(const Real& lambda, const Real& u, const Real& v) noexcept
    {
       if (v < qdrt_eps) {
          return std::make_tuple(l00(u, v), l00(v, u));
       } else if (u < qdrt_eps) {
          return std::make_tuple(l0v(u, v), lv0(u, v));
       }
-      return std::make_tuple(0.5*(1 - lambda + u - v),
-                             0.5*(1 - lambda - u + v));
+      return std::make_tuple(Real(0.5*(1 - lambda + u - v)),
+                             Real(0.5*(1 - lambda - u + v)));
    }
 
    /// u < 1 && v < 1, lambda^2(u,v) > 0; note: phi_pos(u,v) = phi_pos(v,u)
-   double phi_pos(double u, double v) noexcept
+   template <class Real>
+   Real phi_pos(const Real& u, const Real& v) noexcept
    {
-      if (is_equal_rel(u, 1.0, eps) && is_equal_rel(v, 1.0, eps)) {
+      if (is_equal_rel(u, Real(1.0), eps) && is_equal_rel(v, Real(1.0), eps)) {
          return 2.343907238689459;
       }
 
       const double pi23 = 3.2898681336964529; // Pi^2/3
-      const auto lambda = std::sqrt(lambda_2(u,v));
+      const Real lambda = sqrt(lambda_2(u,v));
 
       if (is_equal_rel(u, v, eps)) {
-         const double x = u < qdrt_eps ? u*(1 + u*(1 + u*(2 + 5*u))) : 0.5*(1 - lambda);
+         const Real x = u < qdrt_eps ? Real(u*(1 + u*(1 + u*(2 + 5*u)))) : Real(0.5*(1 - lambda));
 
-         return (- sqr(std::log(u)) + 2*sqr(std::log(x))
+         return (- sqr(log(u)) + 2*sqr(log(x))
                  - 4*dilog(x) + pi23)/lambda;
       }
 
-      double x = 0, y = 0;
+      Real x = 0, y = 0;
       std::tie(x, y) = luv(lambda, u, v);
 
-      return (- std::log(u)*std::log(v) + 2*std::log(x)*std::log(y)
+      return (- log(u)*log(v) + 2*log(x)*log(y)
               - 2*dilog(x) - 2*dilog(y) + pi23)/lambda;
    }
 
    /// clausen_2(2*acos(x))
-   double cl2acos(double x) noexcept
+   template <class Real>
+   Real cl2acos(const Real& x) noexcept
    {
-      return clausen_2(2*std::acos(x));
+      return clausen_2(Real(2*acos(x)));
    }
 
    /// lambda^2(u,v) < 0, u = 1
-   double phi_neg_1v(double v) noexcept
+   template <class Real>
+   Real phi_neg_1v(const Real& v) noexcept
    {
-      return 2*(cl2acos(1 - 0.5*v) + 2*cl2acos(0.5*std::sqrt(v)));
+      return 2*(cl2acos(Real(1 - 0.5*v)) + 2*cl2acos(Real(0.5*sqrt(v))));
    }
 
    /// lambda^2(u,v) < 0; note: phi_neg(u,v) = phi_neg(v,u)
-   double phi_neg(double u, double v) noexcept
+   template <class Real>
+   Real phi_neg(const Real& u, const Real& v) noexcept
    {
-      if (is_equal_rel(u, 1.0, eps) && is_equal_rel(v, 1.0, eps)) {
+      if (is_equal_rel(u, Real(1.0), eps) && is_equal_rel(v, Real(1.0), eps)) {
          // -I/9 (Pi^2 - 36 PolyLog[2, (1 - I Sqrt[3])/2])/Sqrt[3]
          return 2.343907238689459;
       }
 
-      const auto lambda = std::sqrt(-lambda_2(u,v));
+      const Real lambda = sqrt(-lambda_2(u,v));
 
       if (is_equal_rel(u, v, eps)) {
-         return 4*clausen_2(2*std::asin(std::sqrt(0.25/u)))/lambda;
+         return 4*clausen_2(Real(2*asin(Real(sqrt(0.25/u)))))/lambda;
       }
 
-      if (is_equal_rel(u, 1.0, eps)) {
+      if (is_equal_rel(u, Real(1.0), eps)) {
          return phi_neg_1v(v)/lambda;
       }
 
-      if (is_equal_rel(v, 1.0, eps)) {
+      if (is_equal_rel(v, Real(1.0), eps)) {
          return phi_neg_1v(u)/lambda;
       }
 
-      const auto sqrtu = std::sqrt(u);
-      const auto sqrtv = std::sqrt(v);
+      const Real sqrtu = sqrt(u);
+      const Real sqrtv = sqrt(v);
 
-      return 2*(+ cl2acos(0.5*(1 + u - v)/sqrtu)
-                + cl2acos(0.5*(1 - u + v)/sqrtv)
-                + cl2acos(0.5*(-1 + u + v)/(sqrtu*sqrtv)))/lambda;
+      return 2*(+ cl2acos(Real(0.5*(1 + u - v)/sqrtu))
+                + cl2acos(Real(0.5*(1 - u + v)/sqrtv))
+                + cl2acos(Real(0.5*(-1 + u + v)/(sqrtu*sqrtv))))/lambda;
    }
 
    /**
@@ -194,9 +217,10 @@ namespace {
     * The following identities hold:
     * Phi(u,v) = Phi(v,u) = Phi(1/u,v/u)/u = Phi(1/v,u/v)/v
     */
-   double phi_uv(double u, double v) noexcept
+   template <class Real>
+   Real phi_uv(const Real& u, const Real& v) noexcept
    {
-      const auto lambda = lambda_2(u,v);
+      const Real lambda = lambda_2(u,v);
 
       if (is_zero(lambda, eps)) {
          // phi_uv is always multiplied by lambda.  So, in order to
@@ -208,14 +232,14 @@ namespace {
          if (u <= 1 && v <= 1) {
             return phi_pos(u,v);
          }
-         const auto vou = v/u;
+         const Real vou = v/u;
          if (u >= 1 && vou <= 1) {
-            const auto oou = 1/u;
+            const Real oou = 1/u;
             return phi_pos(oou,vou)*oou;
          }
          // v >= 1 && u/v <= 1
-         const auto oov = 1/v;
-         return phi_pos(oov,1/vou)*oov;
+         const Real oov = 1/v;
+         return phi_pos(oov,Real(1/vou))*oov;
       }
 
       return phi_neg(u,v);
@@ -223,12 +247,16 @@ namespace {
 
 } // anonymous namespace
 
-double F1C(double x) noexcept {
+namespace {
+
+template <class Real>
+Real F1C_impl(const Real& x) noexcept
+{
    if (is_zero(x, eps)) {
       return 4.0;
    }
 
-   const double d = x - 1.0;
+   const Real d = x - 1.0;
 
    if (is_equal_rel(x, 1.0, 0.03)) {
       return 1.0 + d*(-0.6 + d*(0.4 + d*(-2.0/7.0
@@ -236,22 +264,46 @@ double F1C(double x) noexcept {
          + 2.0/15.0*d)))));
    }
 
-   return 2.0/pow4(d)*(2.0 + x*(3.0 + 6.0*std::log(x) + x*(-6.0 + x)));
+   return 2.0/pow4(d)*(2.0 + x*(3.0 + 6.0*log(x) + x*(-6.0 + x)));
 }
 
-double F2C(double x) noexcept {
+} // anonymous namespace
+
+double F1C(double x) noexcept {
+   return F1C_impl(x);
+}
+
+Dual<double> F1C(const Dual<double>& x) noexcept {
+   return F1C_impl(x);
+}
+
+namespace {
+
+template <class Real>
+Real F2C_impl(const Real& x) noexcept
+{
    if (is_zero(x, eps)) {
       return 0.0;
    }
 
    if (is_equal_rel(x, 1.0, 0.03)) {
-      const double d = x - 1.0;
+      const Real d = x - 1.0;
 
       return 1.0 + d*(-0.75 + d*(0.6 + d*(-0.5 + d*(3.0/7.0
          + d*(-0.375 + 1.0/3.0*d)))));
    }
 
-   return 3.0/(2.0*pow3(1.0 - x))*(-3.0 - 2.0*std::log(x) + x*(4.0 - x));
+   return 3.0/(2.0*pow3(1.0 - x))*(-3.0 - 2.0*log(x) + x*(4.0 - x));
+}
+
+} // anonymous namespace
+
+double F2C(double x) noexcept {
+   return F2C_impl(x);
+}
+
+Dual<double> F2C(const Dual<double>& x) noexcept {
+   return F2C_impl(x);
 }
 
 double F3C(double x) noexcept {
@@ -305,19 +357,33 @@ double F4C(double x) noexcept {
       );
 }
 
-double F1N(double x) noexcept {
+namespace {
+
+template <class Real>
+Real F1N_impl(const Real& x) noexcept
+{
    if (is_zero(x, eps)) {
       return 2.0;
    }
 
-   const double d = x - 1.0;
+   const Real d = x - 1.0;
 
    if (is_equal_rel(x, 1.0, 0.03)) {
       return 1.0 + d*(-0.4 + d*(0.2 + d*(-4.0/35.0
          + d*(1.0/14.0 + d*(-1.0/21.0 + 1.0/30.0*d)))));
    }
 
-   return 2.0/pow4(d)*(1.0 + x*(-6.0 + x*(+3.0 - 6.0 * std::log(x) + 2.0 * x)));
+   return 2.0/pow4(d)*(1.0 + x*(-6.0 + x*(+3.0 - 6.0 * log(x) + 2.0 * x)));
+}
+
+} // anonymous namespace
+
+double F1N(double x) noexcept {
+   return F1N_impl(x);
+}
+
+Dual<double> F1N(const Dual<double>& x) noexcept {
+   return F1N_impl(x);
 }
 
 double F2N(double x) noexcept {
@@ -609,11 +675,11 @@ double Iabc(double a, double b, double c) noexcept {
    return Ixyz(sqr(a), sqr(b), sqr(c));
 }
 
-/**
- * Calculates \f$f_{PS}(z)\f$, Eq (70) arXiv:hep-ph/0609168
- * @author Alexander Voigt
- */
-double f_PS(double z) noexcept {
+namespace {
+
+template <class Real>
+Real f_PS_impl(const Real& z) noexcept
+{
    if (z < 0.0) {
       ERROR("f_PS: z must not be negative!");
       return std::numeric_limits<double>::quiet_NaN();
@@ -621,41 +687,69 @@ double f_PS(double z) noexcept {
       return 0.0;
    } else if (z < std::numeric_limits<double>::epsilon()) {
       const double pi23 = 3.2898681336964529; // Pi^2/3
-      const double lz = std::log(z);
+      const Real lz = log(z);
       return z*(pi23 + lz*lz);
    } else if (z < 0.25) {
-      const double y = std::sqrt(1 - 4*z); // 0 < y < 1
+      const Real y = sqrt(1 - 4*z); // 0 < y < 1
       const double c = -9.8696044010893586; // -Pi^2
-      const double q = (1 + y)/(1 - y);
-      const double lq = std::log(q);
-      return z/y*(4*dilog(1 + q) - lq*(2*std::log(z) - lq) + c);
+      const Real q = sqr(1 + y)/(4*z); // (1 + y)/(1 - y) without cancellation
+      const Real lq = log(q);
+      return z/y*(4*dilog(1 + q) - lq*(2*log(z) - lq) + c);
    } else if (z == 0.25) {
       return 1.3862943611198906; // Log[4]
    }
 
    // z > 0.25
-   const double y = std::sqrt(-1 + 4*z);
-   const double theta = std::atan2(y, 2*z - 1);
+   const Real y = sqrt(-1 + 4*z);
+   const Real theta = atan2(y, 2*z - 1);
    return 4*z/y*clausen_2(theta);
 }
 
+} // anonymous namespace
+
 /**
- * Calculates \f$f_S(z)\f$, Eq (71) arXiv:hep-ph/0609168
+ * Calculates \f$f_{PS}(z)\f$, Eq (70) arXiv:hep-ph/0609168
+ * @author Alexander Voigt
  */
-double f_S(double z) noexcept {
+double f_PS(double z) noexcept {
+   return f_PS_impl(z);
+}
+
+Dual<double> f_PS(const Dual<double>& z) noexcept {
+   return f_PS_impl(z);
+}
+
+namespace {
+
+template <class Real>
+Real f_S_impl(const Real& z) noexcept
+{
    if (z < 0.0) {
       ERROR("f_S: z must not be negative!");
       return std::numeric_limits<double>::quiet_NaN();
    } else if (z == 0.0) {
       return 0.0;
    } if (z > 1e2) {
-      const double lz = std::log(z);
-      const double iz = 1/z;
+      const Real lz = log(z);
+      const Real iz = 1/z;
       return (-13./9 - 2./3*lz) + iz*(-26./150 - 15./150*lz
          + iz*(-673./22050 - 420./22050*lz + iz*(-971./158760 - 630./158760*lz)));
    }
 
-   return (2*z - 1)*f_PS(z) - 2*z*(2 + std::log(z));
+   return (2*z - 1)*f_PS_impl(z) - 2*z*(2 + log(z));
+}
+
+} // anonymous namespace
+
+/**
+ * Calculates \f$f_S(z)\f$, Eq (71) arXiv:hep-ph/0609168
+ */
+double f_S(double z) noexcept {
+   return f_S_impl(z);
+}
+
+Dual<double> f_S(const Dual<double>& z) noexcept {
+   return f_S_impl(z);
 }
 
 /**
@@ -672,12 +766,11 @@ double f_sferm(double z) noexcept {
    return 0.5*z*(2 + std::log(z) - f_PS(z));
 }
 
-/**
- * Calculates Barr-Zee 2-loop function for diagram with lepton loop
- * and charged Higgs and W boson mediators, Eq (60), arxiv:1607.06292,
- * with extra global prefactor z.
- */
-double f_CSl(double z) noexcept {
+namespace {
+
+template <class Real>
+Real f_CSl_impl(const Real& z) noexcept
+{
    if (z < 0.0) {
       ERROR("f_CSl: z must not be negative!");
       return std::numeric_limits<double>::quiet_NaN();
@@ -687,16 +780,24 @@ double f_CSl(double z) noexcept {
 
    constexpr double pi26 = 1.6449340668482264;
 
-   return z*(z + z*(z - 1)*(dilog(1 - 1/z) - pi26) + (z - 0.5)*std::log(z));
+   return z*(z + z*(z - 1)*(dilog(1 - 1/z) - pi26) + (z - 0.5)*log(z));
 }
 
+} // anonymous namespace
+
 /**
- * Eq (61), arxiv:1607.06292, with extra global prefactor xd
- *
- * @note There is a misprint in Eq (61), arxiv:1607.06292v2: There
- * should be no Phi function in the 2nd line of (61).
+ * Calculates Barr-Zee 2-loop function for diagram with lepton loop
+ * and charged Higgs and W boson mediators, Eq (60), arxiv:1607.06292,
+ * with extra global prefactor z.
  */
-double f_CSd(double xu, double xd, double qu, double qd) noexcept
+double f_CSl(double z) noexcept {
+   return f_CSl_impl(z);
+}
+
+namespace {
+
+template <class Real>
+Real f_CSd_impl(const Real& xu, const Real& xd, double qu, double qd) noexcept
 {
    if (xd < 0.0 || xu < 0.0) {
       ERROR("f_CSd: xu and xd must not be negative!");
@@ -705,33 +806,48 @@ double f_CSd(double xu, double xd, double qu, double qd) noexcept
       return 0.0;
    }
 
-   const double s = 0.25*(qu + qd);
-   const double c = sqr(xu - xd) - qu*xu + qd*xd;
-   const double cbar = (xu - qu)*xu - (xd + qd)*xd;
-   const double lxu = std::log(xu);
-   const double lxd = std::log(xd);
-   const double phiy = phi_over_y(xu, xd);
+   const Real s = 0.25*(qu + qd);
+   const Real c = sqr(xu - xd) - qu*xu + qd*xd;
+   const Real cbar = (xu - qu)*xu - (xd + qd)*xd;
+   const Real lxu = log(xu);
+   const Real lxd = log(xd);
+   const Real phiy = phi_over_y(xu, xd);
 
    return xd*(-(xu - xd) + (cbar - c*(xu - xd)) * phiy
               + c*(dilog(1.0 - xd/xu) - 0.5*lxu*(lxd - lxu))
               + (s + xd)*lxd + (s - xu)*lxu);
 }
 
-/// Eq (62), arxiv:1607.06292, with extra global prefactor xu
-double f_CSu(double xu, double xd, double qu, double qd) noexcept
+} // anonymous namespace
+
+/**
+ * Eq (61), arxiv:1607.06292, with extra global prefactor xd
+ *
+ * @note There is a misprint in Eq (61), arxiv:1607.06292v2: There
+ * should be no Phi function in the 2nd line of (61).
+ */
+double f_CSd(double xu, double xd, double qu, double qd) noexcept
+{
+   return f_CSd_impl(xu, xd, qu, qd);
+}
+
+namespace {
+
+template <class Real>
+Real f_CSu_impl(const Real& xu, const Real& xd, double qu, double qd) noexcept
 {
    if (xd < 0.0 || xu < 0.0) {
       ERROR("f_CSu: xu and xd must not be negative!");
       return std::numeric_limits<double>::quiet_NaN();
    }
 
-   const double s = 1 + 0.25*(qu + qd);
-   const double c = sqr(xu - xd) - (qu + 2)*xu + (qd + 2)*xd;
-   const double cbar = (xu - qu - 2)*xu - (xd + qd + 2)*xd;
-   const double lxu = std::log(xu);
-   const double lxd = std::log(xd);
-   const double phiy = phi_over_y(xu, xd);
-   const double fCSd = -(xu - xd) + (cbar - c*(xu - xd)) * phiy
+   const Real s = 1 + 0.25*(qu + qd);
+   const Real c = sqr(xu - xd) - (qu + 2)*xu + (qd + 2)*xd;
+   const Real cbar = (xu - qu - 2)*xu - (xd + qd + 2)*xd;
+   const Real lxu = log(xu);
+   const Real lxd = log(xd);
+   const Real phiy = phi_over_y(xu, xd);
+   const Real fCSd = -(xu - xd) + (cbar - c*(xu - xd)) * phiy
       + c*(dilog(1.0 - xd/xu) - 0.5*lxu*(lxd - lxu))
       + (s + xd)*lxd + (s - xu)*lxu;
 
@@ -739,6 +855,14 @@ double f_CSu(double xu, double xd, double qu, double qd) noexcept
               - 1.0/3*(lxd + lxu)*(lxd - lxu));
 }
 
+} // anonymous namespace
+
+/// Eq (62), arxiv:1607.06292, with extra global prefactor xu
+double f_CSu(double xu, double xd, double qu, double qd) noexcept
+{
+   return f_CSu_impl(xu, xd, qu, qd);
+}
+
 /**
  * \f$\mathcal{F}_1(\omega)\f$, Eq (25) arxiv:1502.04199
  */
@@ -799,14 +923,10 @@ double F3(double w) noexcept {
    return (0.5 + 7.5*w)*(2 + std::log(w)) + (4.25 - 7.5*w)*f_PS(w);
 }
 
-/**
- * Barr-Zee 2-loop function with fermion loop and pseudoscalar and Z
- * boson mediators.
- *
- * @param x squared mass ratio (mf/ms)^2.
- * @param y squared mass ratio (mf/mz)^2.
- */
-double FPZ(double x, double y) noexcept
+namespace {
+
+template <class Real>
+Real FPZ_impl(Real x, Real y) noexcept
 {
    if (x < 0 || y < 0) {
       ERROR("FPZ: arguments must not be negative.");
@@ -819,25 +939,40 @@ double FPZ(double x, double y) noexcept
 
    if (x == 0 || y == 0) {
       return 0;
-   } else if (std::abs(1 - x/y) < eps) {
-      if (std::abs(x - 0.25) < eps) {
+   } else if (abs(1 - x/y) < eps) {
+      if (abs(x - 0.25) < eps) {
          // -(1 + 2*Log[2])/3 + O(x - 1/4)
          return -0.79543145370663021 - 1.7453806518612167*(x - 0.25);
       }
-      return 2*x*(f_PS(x) + std::log(x))/(1 - 4*x);
+      return 2*x*(f_PS_impl(x) + log(x))/(1 - 4*x);
    }
 
-   return (y*f_PS(x) - x*f_PS(y))/(x - y);
+   return (y*f_PS_impl(x) - x*f_PS_impl(y))/(x - y);
 }
 
+} // anonymous namespace
+
 /**
- * Barr-Zee 2-loop function with fermion loop and scalar and Z boson
- * mediators.
+ * Barr-Zee 2-loop function with fermion loop and pseudoscalar and Z
+ * boson mediators.
  *
  * @param x squared mass ratio (mf/ms)^2.
  * @param y squared mass ratio (mf/mz)^2.
  */
-double FSZ(double x, double y) noexcept
+double FPZ(double x, double y) noexcept
+{
+   return FPZ_impl(x, y);
+}
+
+Dual<double> FPZ(const Dual<double>& x, const Dual<double>& y) noexcept
+{
+   return FPZ_impl(x, y);
+}
+
+namespace {
+
+template <class Real>
+Real FSZ_impl(Real x, Real y) noexcept
 {
    if (x < 0 || y < 0) {
       ERROR("FSZ: arguments must not be negative.");
@@ -850,33 +985,48 @@ double FSZ(double x, double y) noexcept
 
    if (x == 0 || y == 0) {
       return 0;
-   } else if (std::abs(1 - x/y) < eps) {
-      if (std::abs(x - 0.25) < eps) {
+   } else if (abs(1 - x/y) < eps) {
+      if (abs(x - 0.25) < eps) {
          // (-1 + 4*Log[2])/3 + O(x - 1/4)
          return 0.59086290741326041 + 1.2361419555836500*(x - 0.25);
       } else if (x >= 1e3) {
-         const double ix = 1/x;
-         const double lx = std::log(x);
+         const Real ix = 1/x;
+         const Real lx = log(x);
          return 7./9 + 2./3*lx
             + ix*(37./150 + 1./5*lx
             + ix*(533./7350 + 2./35*lx
             + ix*(1627./79380 + 1./63*lx
             + ix*(18107./3201660 + 1./231*lx))));
       }
-      return 2*x*(1 - 4*x + 2*x*f_PS(x) + std::log(x)*(1 - 2*x))/(4*x - 1);
+      return 2*x*(1 - 4*x + 2*x*f_PS_impl(x) + log(x)*(1 - 2*x))/(4*x - 1);
    }
 
-   return (y*f_S(x) - x*f_S(y))/(x - y);
+   return (y*f_S_impl(x) - x*f_S_impl(y))/(x - y);
 }
 
+} // anonymous namespace
+
 /**
- * Barr-Zee 2-loop function with lepton loop and charge scalar and W
- * boson mediators.
+ * Barr-Zee 2-loop function with fermion loop and scalar and Z boson
+ * mediators.
  *
  * @param x squared mass ratio (mf/ms)^2.
- * @param y squared mass ratio (mf/mw)^2.
+ * @param y squared mass ratio (mf/mz)^2.
  */
-double FCWl(double x, double y) noexcept
+double FSZ(double x, double y) noexcept
+{
+   return FSZ_impl(x, y);
+}
+
+Dual<double> FSZ(const Dual<double>& x, const Dual<double>& y) noexcept
+{
+   return FSZ_impl(x, y);
+}
+
+namespace {
+
+template <class Real>
+Real FCWl_impl(Real x, Real y) noexcept
 {
    if (x < 0 || y < 0) {
       ERROR("FCWl: arguments must not be negative.");
@@ -889,27 +1039,38 @@ double FCWl(double x, double y) noexcept
 
    if (x == 0 || y == 0) {
       return 0;
-   } else if (std::abs(1 - x/y) < eps) {
+   } else if (abs(1 - x/y) < eps) {
       const double pi26 = 1.6449340668482264;
-      return -f_CSl(x) + x*(-0.5 + x*(3 + (3*x - 2)*(dilog(1 - 1/x) - pi26))
-         + (3*x - 0.5)*std::log(x));
+      return -f_CSl_impl(x) + x*(-0.5 + x*(3 + (3*x - 2)*(dilog(1 - 1/x) - pi26))
+         + (3*x - 0.5)*log(x));
    }
 
-   return (y*f_CSl(x) - x*f_CSl(y))/(x - y);
+   return (y*f_CSl_impl(x) - x*f_CSl_impl(y))/(x - y);
 }
 
+} // anonymous namespace
+
 /**
- * Barr-Zee 2-loop function with up-type quark loop and charge scalar
- * and W boson mediators.
+ * Barr-Zee 2-loop function with lepton loop and charge scalar and W
+ * boson mediators.
  *
- * @param xu squared mass ratio (mu/ms)^2.
- * @param xd squared mass ratio (md/ms)^2.
- * @param yu squared mass ratio (mu/mw)^2.
- * @param yd squared mass ratio (md/mw)^2.
- * @param qu electric charge count of up-type quark
- * @param qd electric charge count of down-type quark
+ * @param x squared mass ratio (mf/ms)^2.
+ * @param y squared mass ratio (mf/mw)^2.
  */
-double FCWu(double xu, double xd, double yu, double yd, double qu, double qd) noexcept
+double FCWl(double x, double y) noexcept
+{
+   return FCWl_impl(x, y);
+}
+
+Dual<double> FCWl(const Dual<double>& x, const Dual<double>& y) noexcept
+{
+   return FCWl_impl(x, y);
+}
+
+namespace {
+
+template <class Real>
+Real FCWu_impl(Real xu, Real xd, Real yu, Real yd, double qu, double qd) noexcept
 {
    if (xu < 0 || xd < 0 || yu < 0 || yd < 0) {
       ERROR("FCWu: arguments must not be negative.");
@@ -919,17 +1080,19 @@ double FCWu(double xu, double xd, double yu, double yd, double qu, double qd) no
    constexpr double eps = 1e-8;
 
    // Note: xd == yd  <=>  xu == yu, per definition
-   if (std::abs(1 - xu/yu) < eps) {
+   if (abs(1 - xu/yu) < eps) {
       shift(xu, yu, eps);
       shift(xd, yd, eps);
    }
 
-   return (yu*f_CSu(xu, xd, qu, qd) - xu*f_CSu(yu, yd, qu, qd))/(xu - yu);
+   return (yu*f_CSu_impl(xu, xd, qu, qd) - xu*f_CSu_impl(yu, yd, qu, qd))/(xu - yu);
 }
 
+} // anonymous namespace
+
 /**
- * Barr-Zee 2-loop function with down-type quark loop and charge
- * scalar and W boson mediators.
+ * Barr-Zee 2-loop function with up-type quark loop and charge scalar
+ * and W boson mediators.
  *
  * @param xu squared mass ratio (mu/ms)^2.
  * @param xd squared mass ratio (md/ms)^2.
@@ -938,7 +1101,21 @@ double FCWu(double xu, double xd, double yu, double yd, double qu, double qd) no
  * @param qu electric charge count of up-type quark
  * @param qd electric charge count of down-type quark
  */
-double FCWd(double xu, double xd, double yu, double yd, double qu, double qd) noexcept
+double FCWu(double xu, double xd, double yu, double yd, double qu, double qd) noexcept
+{
+   return FCWu_impl(xu, xd, yu, yd, qu, qd);
+}
+
+Dual<double> FCWu(const Dual<double>& xu, const Dual<double>& xd, const Dual<double>& yu,
+                  const Dual<double>& yd, double qu, double qd) noexcept
+{
+   return FCWu_impl(xu, xd, yu, yd, qu, qd);
+}
+
+namespace {
+
+template <class Real>
+Real FCWd_impl(Real xu, Real xd, Real yu, Real yd, double qu, double qd) noexcept
 {
    if (xu < 0 || xd < 0 || yu < 0 || yd < 0) {
       ERROR("FCWd: arguments must not be negative.");
@@ -948,12 +1125,36 @@ double FCWd(double xu, double xd, double yu, double yd, double qu, double qd) no
    constexpr double eps = 1e-8;
 
    // Note: xd == yd  <=>  xu == yu, per definition
-   if (std::abs(1 - xu/yu) < eps) {
+   if (abs(1 - xu/yu) < eps) {
       shift(xu, yu, eps);
       shift(xd, yd, eps);
    }
 
-   return (yd*f_CSd(xu, xd, qu, qd) - xd*f_CSd(yu, yd, qu, qd))/(xd - yd);
+   return (yd*f_CSd_impl(xu, xd, qu, qd) - xd*f_CSd_impl(yu, yd, qu, qd))/(xd - yd);
+}
+
+} // anonymous namespace
+
+/**
+ * Barr-Zee 2-loop function with down-type quark loop and charge
+ * scalar and W boson mediators.
+ *
+ * @param xu squared mass ratio (mu/ms)^2.
+ * @param xd squared mass ratio (md/ms)^2.
+ * @param yu squared mass ratio (mu/mw)^2.
+ * @param yd squared mass ratio (md/mw)^2.
+ * @param qu electric charge count of up-type quark
+ * @param qd electric charge count of down-type quark
+ */
+double FCWd(double xu, double xd, double yu, double yd, double qu, double qd) noexcept
+{
+   return FCWd_impl(xu, xd, yu, yd, qu, qd);
+}
+
+Dual<double> FCWd(const Dual<double>& xu, const Dual<double>& xd, const Dual<double>& yu,
+                  const Dual<double>& yd, double qu, double qd) noexcept
+{
+   return FCWd_impl(xu, xd, yu, yd, qu, qd);
 }
 
 /**
@@ -971,6 +1172,18 @@ double lambda_2(double x, double y, double z) noexcept
    return z*z*lambda_2(x/z, y/z);
 }
 
+namespace {
+
+template <class Real>
+Real Phi_impl(Real x, Real y, Real z) noexcept
+{
+   sort(x, y, z);
+   const Real u = x/z, v = y/z;
+   return phi_uv(u,v)*z*lambda_2(u, v)/2;
+}
+
+} // anonymous namespace
+
 /**
  * \f$\Phi(x,y,z)\f$ function from arxiv:1607.06292 Eq.(68).
 
@@ -986,9 +1199,12 @@ double lambda_2(double x, double y, double z) noexcept
  */
 double Phi(double x, double y, double z) noexcept
 {
-   sort(x, y, z);
-   const auto u = x/z, v = y/z;
-   return phi_uv(u,v)*z*lambda_2(u, v)/2;
+   return Phi_impl(x, y, z);
+}
+
+Dual<double> Phi(const Dual<double>& x, const Dual<double>& y, const Dual<double>& z) noexcept
+{
+   return Phi_impl(x, y, z);
 }
 
 } // namespace gm2calc
@@ -82,6 +82,22 @@ double Phi(double x, double y, double z) noexcept;
 /// Källén lambda function \f$\lambda^2(x, y, z)\f$
 double lambda_2(double x, double y, double z) noexcept;
 
+// overloads for Dual numbers (first derivatives w.r.t. the arguments)
+
+template <class T> class Dual;
+
+Dual<double> F1C(const Dual<double>&) noexcept;
+Dual<double> F2C(const Dual<double>&) noexcept;
+Dual<double> F1N(const Dual<double>&) noexcept;
+Dual<double> f_PS(const Dual<double>&) noexcept;
+Dual<double> f_S(const Dual<double>&) noexcept;
+Dual<double> FPZ(const Dual<double>&, const Dual<double>&) noexcept;
+Dual<double> FSZ(const Dual<double>&, const Dual<double>&) noexcept;
+Dual<double> FCWl(const Dual<double>&, const Dual<double>&) noexcept;
+Dual<double> FCWu(const Dual<double>&, const Dual<double>&, const Dual<double>&, const Dual<double>&, double, double) noexcept;
+Dual<double> FCWd(const Dual<double>&, const Dual<double>&, const Dual<double>&, const Dual<double>&, double, double) noexcept;
+Dual<double> Phi(const Dual<double>&, const Dual<double>&, const Dual<double>&) noexcept;
+
 } // namespace gm2calc
 
 #endif
@@ -17,6 +17,7 @@
 // ====================================================================
 
 #include "gm2_mf.hpp"
+#include "gm2_dual.hpp"
 #include "gm2_log.hpp"
 #include "gm2_numerics.hpp"
 
@@ -218,6 +219,73 @@ double calculate_mb_SM5_DRbar(
    return mb_DRbar;
 }
 
+namespace {
+
+template <class Real>
+Real calculate_mt_SM6_MSbar_impl(
+   double mt_pole, double alpha_s_mz, double mz, const Real& scale) noexcept
+{
+   using std::pow;
+
+   // alpha_s(SM(6), MS-bar, Q = mt_pole)
+   const double alpha_s_mt = calculate_alpha_s_SM6_MSbar_at_mt(mt_pole, alpha_s_mz, mz);
+
+   // mt(SM(6), MS-bar, Q = mt_pole)
+   const double mt_mt = calculate_mt_SM6_MSbar_at(mt_pole, alpha_s_mt);
+
+   // run from Q = mt_pole to Q = scale
+   const Real mt_scale = mt_mt * pow(scale/mt_pole, -2/pi*alpha_s_mt);
+
+   // Note: QCD beta function of the quark mass parameter:
+   // dm/d(log(Q)) = -2/pi*alpha_s*m
+
+   return mt_scale;
+}
+
+template <class Real>
+Real calculate_mb_SM6_MSbar_impl(
+   double mb_mb, double mt_pole, double alpha_s_mz, double mz, const Real& scale) noexcept
+{
+   using std::pow;
+
+   // determine Lambda_QCD
+   const double lambda_qcd = calculate_lambda_qcd(alpha_s_mz, mz);
+
+   // calculate alpha_s(mb)
+   const double alpha_s_mb = calculate_alpha_s_SM5_at(mb_mb, lambda_qcd);
+
+   // calculate alpha_s(mt)
+   const double alpha_s_mt = calculate_alpha_s_SM5_at(mt_pole, lambda_qcd);
+
+   // run mb(mb) to Q = mt_pole
+   const double mb_mt = mb_mb * Fb(alpha_s_mt) / Fb(alpha_s_mb);
+
+   // run mb(mt) to Q = scale
+   const Real mb_scale = mb_mt * pow(scale/mt_pole, -2/pi*alpha_s_mt);
+
+   return mb_scale;
+}
+
+template <class Real>
+Real calculate_mtau_SM6_MSbar_impl(
+   double mtau_pole, double alpha_em_mz, const Real& scale) noexcept
+{
+   using std::pow;
+
+   // calculate mtau(mtau)
+   const double mtau_mtau = mtau_pole; // neglecting loop corrections
+
+   // Note: QED beta function of the lepton mass parameter:
+   // dm/d(log(Q)) = -3/(2*pi)*alpha_em*m
+
+   // run mtau(mtau) to Q = scale
+   const Real mtau_scale = mtau_mtau * pow(scale/mtau_mtau, -3/(2*pi)*alpha_em_mz);
+
+   return mtau_scale;
+}
+
+} // anonymous namespace
+
 /**
  * Calculates the running top quark MS-bar mass mt(SM(6),Q) at the
  * scale Q.
@@ -232,19 +300,14 @@ double calculate_mb_SM5_DRbar(
 double calculate_mt_SM6_MSbar(
    double mt_pole, double alpha_s_mz, double mz, double scale) noexcept
 {
-   // alpha_s(SM(6), MS-bar, Q = mt_pole)
-   const double alpha_s_mt = calculate_alpha_s_SM6_MSbar_at_mt(mt_pole, alpha_s_mz, mz);
-
-   // mt(SM(6), MS-bar, Q = mt_pole)
-   const double mt_mt = calculate_mt_SM6_MSbar_at(mt_pole, alpha_s_mt);
-
-   // run from Q = mt_pole to Q = scale
-   const double mt_scale = mt_mt * std::pow(scale/mt_pole, -2/pi*alpha_s_mt);
-
-   // Note: QCD beta function of the quark mass parameter:
-   // dm/d(log(Q)) = -2/pi*alpha_s*m
+   return calculate_mt_SM6_MSbar_impl(mt_pole, alpha_s_mz, mz, scale);
+}
 
-   return mt_scale;
+/// calculates mt(SM(6),MS-bar,Q) and its derivatives w.r.t. the scale Q
+Dual<double> calculate_mt_SM6_MSbar(
+   double mt_pole, double alpha_s_mz, double mz, const Dual<double>& scale) noexcept
+{
+   return calculate_mt_SM6_MSbar_impl(mt_pole, alpha_s_mz, mz, scale);
 }
 
 /**
@@ -262,22 +325,14 @@ double calculate_mt_SM6_MSbar(
 double calculate_mb_SM6_MSbar(
    double mb_mb, double mt_pole, double alpha_s_mz, double mz, double scale) noexcept
 {
-   // determine Lambda_QCD
-   const double lambda_qcd = calculate_lambda_qcd(alpha_s_mz, mz);
-
-   // calculate alpha_s(mb)
-   const double alpha_s_mb = calculate_alpha_s_SM5_at(mb_mb, lambda_qcd);
-
-   // calculate alpha_s(mt)
-   const double alpha_s_mt = calculate_alpha_s_SM5_at(mt_pole, lambda_qcd);
-
-   // run mb(mb) to Q = mt_pole
-   const double mb_mt = mb_mb * Fb(alpha_s_mt) / Fb(alpha_s_mb);
-
-   // run mb(mt) to Q = scale
-   const double mb_scale = mb_mt * std::pow(scale/mt_pole, -2/pi*alpha_s_mt);
+   return calculate_mb_SM6_MSbar_impl(mb_mb, mt_pole, alpha_s_mz, mz, scale);
+}
 
-   return mb_scale;
+/// calculates mb(MS-bar,SM(6),Q) and its derivatives w.r.t. the scale Q
+Dual<double> calculate_mb_SM6_MSbar(
+   double mb_mb, double mt_pole, double alpha_s_mz, double mz, const Dual<double>& scale) noexcept
+{
+   return calculate_mb_SM6_MSbar_impl(mb_mb, mt_pole, alpha_s_mz, mz, scale);
 }
 
 /**
@@ -293,16 +348,14 @@ double calculate_mb_SM6_MSbar(
 double calculate_mtau_SM6_MSbar(
    double mtau_pole, double alpha_em_mz, double scale) noexcept
 {
-   // calculate mtau(mtau)
-   const double mtau_mtau = mtau_pole; // neglecting loop corrections
-
-   // Note: QED beta function of the lepton mass parameter:
-   // dm/d(log(Q)) = -3/(2*pi)*alpha_em*m
-
-   // run mtau(mtau) to Q = scale
-   const double mtau_scale = mtau_mtau * std::pow(scale/mtau_mtau, -3/(2*pi)*alpha_em_mz);
+   return calculate_mtau_SM6_MSbar_impl(mtau_pole, alpha_em_mz, scale);
+}
 
-   return mtau_scale;
+/// calculates mtau(MS-bar,SM(6),Q) and its derivatives w.r.t. the scale Q
+Dual<double> calculate_mtau_SM6_MSbar(
+   double mtau_pole, double alpha_em_mz, const Dual<double>& scale) noexcept
+{
+   return calculate_mtau_SM6_MSbar_impl(mtau_pole, alpha_em_mz, scale);
 }
 
 } // namespace gm2calc
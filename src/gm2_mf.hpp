@@ -33,6 +33,14 @@ double calculate_mb_SM6_MSbar(double mb_mb, double mt_pole, double alpha_s_mz, d
 /// calculates mtau(Q) MS-bar in the SM(6)
 double calculate_mtau_SM6_MSbar(double mtau_pole, double alpha_em_mz, double scale) noexcept;
 
+// overloads for Dual numbers (first derivatives w.r.t. the scale)
+
+template <class T> class Dual;
+
+Dual<double> calculate_mt_SM6_MSbar(double mt_pole, double alpha_s_mz, double mz, const Dual<double>& scale) noexcept;
+Dual<double> calculate_mb_SM6_MSbar(double mb_mb, double mt_pole, double alpha_s_mz, double mz, const Dual<double>& scale) noexcept;
+Dual<double> calculate_mtau_SM6_MSbar(double mtau_pole, double alpha_em_mz, const Dual<double>& scale) noexcept;
+
 } // namespace gm2calc
 
 #endif
@@ -0,0 +1,128 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_PARALLEL_HPP
+#define GM2_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace gm2calc {
+
+/// returns the number of threads, where 0 means the number of hardware threads
+inline unsigned get_number_of_threads(unsigned threads) noexcept
+{
+   return threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Calls f(i) for i = 0, ..., n - 1 on up to the given number of
+ * threads, including the calling thread.  The indices are distributed
+ * dynamically over the threads.  Before an index is handed out, stop()
+ * is called; if it returns true, no further indices are handed out.
+ *
+ * If f throws, no further indices are handed out and the first
+ * exception is re-thrown after all threads have been joined.  If a
+ * thread cannot be created, the remaining indices are processed by
+ * the threads which have already been created.
+ *
+ * @param n number of calls
+ * @param threads number of threads (0 = number of hardware threads)
+ * @param f function
+ * @param stop predicate
+ *
+ * @return number of indices handed out, i.e. f(i) has been called for
+ * all i smaller than the returned value
+ */
+template <class F, class Stop>
+std::size_t parallel_for(std::size_t n, unsigned threads, const F& f, const Stop& stop)
+{
+   std::atomic<std::size_t> next{0};
+   std::atomic<bool> failed{false};
+   std::exception_ptr error;
+   std::mutex error_mutex;
+
+   const auto work = [&] () {
+      while (!failed && !stop()) {
+         const std::size_t i = next++;
+         if (i >= n) {
+            break;
+         }
+         try {
+            f(i);
+         } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+               error = std::current_exception();
+            }
+            failed = true;
+         }
+      }
+   };
+
+   std::vector<std::thread> pool;
+   const std::size_t pool_size = std::min<std::size_t>(get_number_of_threads(threads), n);
+
+   try {
+      pool.reserve(pool_size);
+      for (std::size_t t = 1; t < pool_size; t++) {
+         pool.emplace_back(work);
+      }
+   } catch (const std::system_error&) {
+      // continue with the threads created so far
+   } catch (const std::bad_alloc&) {
+      // continue with the threads created so far
+   }
+
+   work();
+
+   for (auto& t: pool) {
+      t.join();
+   }
+
+   if (error) {
+      std::rethrow_exception(error);
+   }
+
+   return std::min(next.load(), n);
+}
+
+/**
+ * Calls f(i) for i = 0, ..., n - 1 on up to the given number of
+ * threads, see parallel_for(std::size_t, unsigned, const F&, const Stop&).
+ *
+ * @param n number of calls
+ * @param threads number of threads (0 = number of hardware threads)
+ * @param f function
+ */
+template <class F>
+void parallel_for(std::size_t n, unsigned threads, const F& f)
+{
+   parallel_for(n, threads, f, [] () { return false; });
+}
+
+} // namespace gm2calc
+
+#endif
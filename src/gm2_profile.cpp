@@ -0,0 +1,152 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_profile.hpp"
+#include "gm2_profile_timer.hpp"
+
+#include <iomanip>
+#include <ostream>
+
+namespace gm2calc {
+
+namespace {
+
+constexpr unsigned number_of_ids = static_cast<unsigned>(Profile_id::NUMBER_OF_IDS);
+
+/// names of the profiled functions, in the order of Profile_id
+const char* const profile_names[number_of_ids] = {
+   "amu1L",
+   "amu2L_B_EWadd",
+   "amu2L_B_nonYuk",
+   "amu2L_B_Yuk",
+   "amu2L_F_neutral",
+   "amu2L_F_charged"
+};
+
+struct Profile_counter {
+   std::atomic<unsigned long long> calls{0};
+   std::atomic<long long> nanoseconds{0};
+};
+
+Profile_counter profile_counters[number_of_ids];
+
+} // anonymous namespace
+
+namespace detail {
+
+std::atomic<bool> profiling_enabled{false};
+
+void record_profile(Profile_id id, std::chrono::nanoseconds duration) noexcept
+{
+   auto& counter = profile_counters[static_cast<unsigned>(id)];
+   counter.calls.fetch_add(1, std::memory_order_relaxed);
+   counter.nanoseconds.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/**
+ * Enables or disables the recording of call counts and run times of
+ * the individual THDM contributions.  Profiling is disabled by
+ * default.  The counters are not reset by this function.
+ *
+ * @param enable true to enable, false to disable profiling
+ */
+void enable_profiling(bool enable) noexcept
+{
+   detail::profiling_enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool is_profiling_enabled() noexcept
+{
+   return detail::profiling_enabled.load(std::memory_order_relaxed);
+}
+
+void reset_profile() noexcept
+{
+   for (auto& counter: profile_counters) {
+      counter.calls.store(0, std::memory_order_relaxed);
+      counter.nanoseconds.store(0, std::memory_order_relaxed);
+   }
+}
+
+/**
+ * Returns the call counts and the cumulative run times of all
+ * profiled contributions, accumulated since the last call of
+ * reset_profile().
+ *
+ * @return vector of profile entries, one for each contribution
+ */
+std::vector<Profile_entry> get_profile()
+{
+   std::vector<Profile_entry> entries;
+   entries.reserve(number_of_ids);
+
+   for (unsigned i = 0; i < number_of_ids; ++i) {
+      Profile_entry entry;
+      entry.name = profile_names[i];
+      entry.calls = profile_counters[i].calls.load(std::memory_order_relaxed);
+      entry.seconds = 1e-9*profile_counters[i].nanoseconds.load(std::memory_order_relaxed);
+      entries.push_back(entry);
+   }
+
+   return entries;
+}
+
+void print_profile_table(std::ostream& ostr, const std::vector<Profile_entry>& entries)
+{
+   double total = 0.;
+   for (const auto& e: entries) {
+      total += e.seconds;
+   }
+
+   ostr << "# " << std::left << std::setw(18) << "contribution"
+        << std::right << std::setw(12) << "calls"
+        << std::setw(16) << "total [s]"
+        << std::setw(16) << "per call [s]"
+        << std::setw(9) << "share" << '\n';
+
+   for (const auto& e: entries) {
+      const double per_call = e.calls > 0 ? e.seconds/e.calls : 0.;
+      const double share = total > 0. ? 100*e.seconds/total : 0.;
+      ostr << "  " << std::left << std::setw(18) << e.name
+           << std::right << std::setw(12) << e.calls
+           << std::scientific << std::setprecision(6)
+           << std::setw(16) << e.seconds
+           << std::setw(16) << per_call
+           << std::fixed << std::setprecision(1)
+           << std::setw(8) << share << "%\n";
+   }
+}
+
+void print_profile_json(std::ostream& ostr, const std::vector<Profile_entry>& entries)
+{
+   ostr << "{\n  \"unit\": \"s\",\n  \"profile\": [";
+
+   for (std::size_t i = 0; i < entries.size(); ++i) {
+      const auto& e = entries[i];
+      ostr << (i == 0 ? "\n" : ",\n")
+           << "    {\"name\": \"" << e.name << "\", \"calls\": " << e.calls
+           << ", \"seconds\": " << std::scientific << std::setprecision(9)
+           << e.seconds << '}';
+   }
+
+   ostr << "\n  ]\n}\n";
+}
+
+} // namespace gm2calc
@@ -0,0 +1,91 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_PROFILE_TIMER_HPP
+#define GM2_PROFILE_TIMER_HPP
+
+#include "gm2calc/gm2_profile.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace gm2calc {
+
+/// profiled contribution functions
+enum class Profile_id : unsigned {
+   amu1L,
+   amu2L_B_EWadd,
+   amu2L_B_nonYuk,
+   amu2L_B_Yuk,
+   amu2L_F_neutral,
+   amu2L_F_charged,
+   NUMBER_OF_IDS
+};
+
+namespace detail {
+
+/// global profiling switch
+extern std::atomic<bool> profiling_enabled;
+
+/// adds one call with the given duration to the profile entry
+void record_profile(Profile_id, std::chrono::nanoseconds) noexcept;
+
+} // namespace detail
+
+/**
+ * @class Profile_timer
+ * @brief Measures the life time of the object and adds it to the
+ * profile entry of the given contribution.
+ *
+ * If profiling is disabled when the timer is created, nothing is
+ * recorded and the only overhead is the check of the global switch.
+ * A timer created with record = false never records anything; this
+ * is used to profile only the double instantiation of the templated
+ * contribution functions.
+ */
+class Profile_timer {
+public:
+   explicit Profile_timer(Profile_id id_, bool record = true) noexcept
+      : id(id_)
+      , active(record && detail::profiling_enabled.load(std::memory_order_relaxed))
+   {
+      if (active) {
+         start = std::chrono::steady_clock::now();
+      }
+   }
+   Profile_timer(const Profile_timer&) = delete;
+   Profile_timer(Profile_timer&&) = delete;
+   ~Profile_timer()
+   {
+      if (active) {
+         detail::record_profile(id, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now() - start));
+      }
+   }
+   Profile_timer& operator=(const Profile_timer&) = delete;
+   Profile_timer& operator=(Profile_timer&&) = delete;
+
+private:
+   Profile_id id;
+   bool active{false};
+   std::chrono::steady_clock::time_point start{};
+};
+
+} // namespace gm2calc
+
+#endif
@@ -0,0 +1,428 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_result_file.hpp"
+#include "gm2calc/gm2_error.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GM2CALC_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gm2calc {
+
+namespace {
+
+/// magic number at the beginning of a result file
+const char result_magic[8] = {'G', 'M', '2', 'C', 'R', 'S', 'L', 'T'};
+
+/// version of the result file format
+const std::uint64_t result_version = 1;
+
+/// size of a column name in the header (including the terminating zero)
+const std::size_t column_name_size = Result_column::max_name_length + 1;
+
+/// size of a value (in bytes)
+const std::size_t value_size = sizeof(std::uint64_t);
+
+template <class T>
+void write_value(std::ostream& ostr, const T& value)
+{
+   ostr.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+T read_value(const char* data)
+{
+   T value;
+   std::memcpy(&value, data, sizeof(T));
+   return value;
+}
+
+} // anonymous namespace
+
+constexpr std::size_t Result_column::max_name_length;
+
+Result_value::Result_value(double x)
+   : type(Result_column::Float64)
+{
+   std::memcpy(&bits, &x, sizeof(bits));
+}
+
+Result_value::Result_value(std::uint64_t n)
+   : bits(n), type(Result_column::UInt64)
+{
+}
+
+/**
+ * Creates a result file with the given columns.  An existing file is
+ * overwritten.
+ *
+ * @param file_name_ file name
+ * @param columns_ columns
+ * @param rows_per_chunk_ number of rows per chunk
+ *
+ * @throw EInvalidInput if a column name is too long
+ * @throw EReadError if the file cannot be created
+ */
+Result_file_writer::Result_file_writer(
+   const std::string& file_name_,
+   const std::vector<Result_column>& columns_,
+   std::size_t rows_per_chunk_)
+   : file_name(file_name_)
+   , columns(columns_)
+   , rows_per_chunk(std::max<std::size_t>(rows_per_chunk_, 1))
+{
+   for (const auto& c: columns) {
+      if (c.name.size() > Result_column::max_name_length) {
+         throw EInvalidInput("result file column name too long: \"" + c.name + "\"");
+      }
+   }
+
+   buffer.resize(columns.size() * rows_per_chunk);
+
+   ostr.open(file_name, std::ios::binary | std::ios::trunc);
+
+   ostr.write(result_magic, sizeof(result_magic));
+   write_value(ostr, result_version);
+   write_value(ostr, static_cast<std::uint64_t>(columns.size()));
+
+   for (const auto& c: columns) {
+      char name[column_name_size] = {};
+      std::memcpy(name, c.name.data(), c.name.size());
+      ostr.write(name, sizeof(name));
+      write_value(ostr, static_cast<std::uint64_t>(c.type));
+   }
+
+   if (!ostr) {
+      throw EReadError("cannot create result file \"" + file_name + "\"");
+   }
+}
+
+/// writes the buffered rows to the file
+Result_file_writer::~Result_file_writer() noexcept
+{
+   try {
+      flush();
+   } catch (...) {
+   }
+}
+
+/**
+ * Appends a row to the file.
+ *
+ * @param values pointer to the values (one for each column)
+ * @param n number of values
+ *
+ * @throw EInvalidInput if the number or the types of the values do
+ * not match the columns
+ */
+void Result_file_writer::write_row(const Result_value* values, std::size_t n)
+{
+   if (n != columns.size()) {
+      throw EInvalidInput("number of values (" + std::to_string(n) +
+                          ") does not match number of columns (" +
+                          std::to_string(columns.size()) + ")");
+   }
+
+   for (std::size_t i = 0; i < n; i++) {
+      if (values[i].get_type() != columns[i].type) {
+         throw EInvalidInput("type of value does not match type of column \"" +
+                             columns[i].name + "\"");
+      }
+   }
+
+   for (std::size_t i = 0; i < n; i++) {
+      buffer[i * rows_per_chunk + rows_buffered] = values[i].get_bits();
+   }
+
+   if (++rows_buffered == rows_per_chunk) {
+      flush();
+   }
+}
+
+void Result_file_writer::write_row(std::initializer_list<Result_value> values)
+{
+   write_row(values.begin(), values.size());
+}
+
+void Result_file_writer::write_row(const std::vector<Result_value>& values)
+{
+   write_row(values.data(), values.size());
+}
+
+/**
+ * Appends a row for a point where the calculation has failed: All
+ * Float64 columns are set to NaN, the column "problems" is set to
+ * Result_problem_error and all other UInt64 columns are set to zero.
+ */
+void Result_file_writer::write_error_row()
+{
+   std::vector<Result_value> values;
+   values.reserve(columns.size());
+
+   for (const auto& c: columns) {
+      if (c.type == Result_column::Float64) {
+         values.emplace_back(std::numeric_limits<double>::quiet_NaN());
+      } else if (c.name == "problems") {
+         values.emplace_back(static_cast<std::uint64_t>(Result_problem_error));
+      } else {
+         values.emplace_back(static_cast<std::uint64_t>(0));
+      }
+   }
+
+   write_row(values);
+}
+
+/**
+ * Writes the buffered rows as one chunk to the file.
+ *
+ * @throw EReadError if the file cannot be written
+ */
+void Result_file_writer::flush()
+{
+   if (rows_buffered == 0) {
+      return;
+   }
+
+   write_value(ostr, static_cast<std::uint64_t>(rows_buffered));
+
+   for (std::size_t i = 0; i < columns.size(); i++) {
+      ostr.write(reinterpret_cast<const char*>(&buffer[i * rows_per_chunk]),
+                 static_cast<std::streamsize>(rows_buffered * value_size));
+   }
+
+   ostr.flush();
+
+   if (!ostr) {
+      throw EReadError("cannot write to result file \"" + file_name + "\"");
+   }
+
+   rows_written += rows_buffered;
+   rows_buffered = 0;
+}
+
+/**
+ * Opens the result file with the given name and reads the header and
+ * the positions of the chunks.  A truncated chunk at the end of the
+ * file (e.g. from an interrupted scan) is ignored.
+ *
+ * @param file_name_ file name
+ *
+ * @throw EReadError if the file cannot be read or is not a result file
+ */
+Result_file_reader::Result_file_reader(const std::string& file_name_)
+   : file_name(file_name_)
+{
+   map_file();
+
+   try {
+      read_header_and_chunks();
+   } catch (...) {
+#ifdef GM2CALC_HAVE_MMAP
+      if (mapped) {
+         munmap(const_cast<char*>(data), size);
+      }
+#endif
+      throw;
+   }
+}
+
+Result_file_reader::~Result_file_reader()
+{
+#ifdef GM2CALC_HAVE_MMAP
+   if (mapped) {
+      munmap(const_cast<char*>(data), size);
+   }
+#endif
+}
+
+/// maps the file into memory (or reads it, if mmap is not available)
+void Result_file_reader::map_file()
+{
+#ifdef GM2CALC_HAVE_MMAP
+   const int fd = open(file_name.c_str(), O_RDONLY);
+
+   if (fd < 0) {
+      throw EReadError("cannot read result file \"" + file_name + "\"");
+   }
+
+   struct stat st;
+
+   if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw EReadError("cannot read result file \"" + file_name + "\"");
+   }
+
+   size = static_cast<std::size_t>(st.st_size);
+
+   if (size > 0) {
+      void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+         data = static_cast<const char*>(addr);
+         mapped = true;
+      }
+   }
+
+   close(fd);
+
+   if (mapped || size == 0) {
+      return;
+   }
+#endif
+
+   std::ifstream istr(file_name, std::ios::binary);
+
+   if (!istr) {
+      throw EReadError("cannot read result file \"" + file_name + "\"");
+   }
+
+   content.assign(std::istreambuf_iterator<char>(istr), std::istreambuf_iterator<char>());
+   data = content.data();
+   size = content.size();
+}
+
+/// reads the column descriptions and the positions of the chunks
+void Result_file_reader::read_header_and_chunks()
+{
+   const std::size_t fixed_header_size = sizeof(result_magic) + 2 * value_size;
+
+   if (size < fixed_header_size ||
+       std::memcmp(data, result_magic, sizeof(result_magic)) != 0) {
+      throw EReadError("\"" + file_name + "\" is not a GM2Calc result file");
+   }
+
+   if (read_value<std::uint64_t>(data + sizeof(result_magic)) != result_version) {
+      throw EReadError("result file \"" + file_name + "\" has an incompatible format");
+   }
+
+   const auto number_of_columns = read_value<std::uint64_t>(data + sizeof(result_magic) + value_size);
+   const std::size_t column_size = column_name_size + value_size;
+
+   if (number_of_columns > (size - fixed_header_size) / column_size) {
+      throw EReadError("result file \"" + file_name + "\" is corrupt");
+   }
+
+   std::size_t pos = fixed_header_size;
+
+   for (std::uint64_t i = 0; i < number_of_columns; i++) {
+      const char* name = data + pos;
+      const auto type = read_value<std::uint64_t>(data + pos + column_name_size);
+
+      if (type != Result_column::Float64 && type != Result_column::UInt64) {
+         throw EReadError("result file \"" + file_name + "\" is corrupt");
+      }
+
+      const auto name_end = std::find(name, name + column_name_size, '\0');
+
+      columns.push_back({std::string(name, name_end),
+                         static_cast<Result_column::Type>(type)});
+      pos += column_size;
+   }
+
+   while (pos + value_size <= size) {
+      const auto rows = read_value<std::uint64_t>(data + pos);
+      const std::size_t chunk_begin = pos + value_size;
+
+      if (columns.empty() ||
+          rows > (size - chunk_begin) / (columns.size() * value_size)) {
+         break; // truncated chunk
+      }
+
+      chunks.push_back({chunk_begin, static_cast<std::size_t>(rows)});
+      number_of_rows += rows;
+      pos = chunk_begin + rows * columns.size() * value_size;
+   }
+}
+
+/**
+ * Returns the index of the column with the given name.
+ *
+ * @param name column name
+ *
+ * @throw EInvalidInput if there is no such column
+ */
+std::size_t Result_file_reader::get_column_index(const std::string& name) const
+{
+   const auto it = std::find_if(columns.cbegin(), columns.cend(),
+                                [&name] (const Result_column& c) { return c.name == name; });
+
+   if (it == columns.cend()) {
+      throw EInvalidInput("result file \"" + file_name + "\" has no column \"" + name + "\"");
+   }
+
+   return static_cast<std::size_t>(it - columns.cbegin());
+}
+
+const char* Result_file_reader::get_column_data(
+   std::size_t chunk, std::size_t column, Result_column::Type type) const
+{
+   if (columns.at(column).type != type) {
+      throw EInvalidInput("column \"" + columns[column].name + "\" has a different type");
+   }
+
+   const auto& c = chunks.at(chunk);
+
+   return data + c.offset + column * c.rows * value_size;
+}
+
+const double* Result_file_reader::get_float64_data(std::size_t chunk, std::size_t column) const
+{
+   return reinterpret_cast<const double*>(get_column_data(chunk, column, Result_column::Float64));
+}
+
+const std::uint64_t* Result_file_reader::get_uint64_data(std::size_t chunk, std::size_t column) const
+{
+   return reinterpret_cast<const std::uint64_t*>(get_column_data(chunk, column, Result_column::UInt64));
+}
+
+std::vector<double> Result_file_reader::read_float64_column(std::size_t column) const
+{
+   std::vector<double> values;
+   values.reserve(number_of_rows);
+
+   for (std::size_t i = 0; i < chunks.size(); i++) {
+      const auto first = get_float64_data(i, column);
+      values.insert(values.end(), first, first + chunks[i].rows);
+   }
+
+   return values;
+}
+
+std::vector<std::uint64_t> Result_file_reader::read_uint64_column(std::size_t column) const
+{
+   std::vector<std::uint64_t> values;
+   values.reserve(number_of_rows);
+
+   for (std::size_t i = 0; i < chunks.size(); i++) {
+      const auto first = get_uint64_data(i, column);
+      values.insert(values.end(), first, first + chunks[i].rows);
+   }
+
+   return values;
+}
+
+} // namespace gm2calc
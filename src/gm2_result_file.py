@@ -0,0 +1,156 @@
+#!/usr/bin/env python
+
+# ====================================================================
+# This file is part of GM2Calc.
+#
+# GM2Calc is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published
+# by the Free Software Foundation, either version 3 of the License,
+# or (at your option) any later version.
+#
+# GM2Calc is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GM2Calc.  If not, see
+# <http://www.gnu.org/licenses/>.
+# ====================================================================
+
+"""Reader for GM2Calc result files.
+
+The file format is described in include/gm2calc/gm2_result_file.hpp.
+The file is memory mapped and the columns of each chunk are returned
+without copying.  If numpy is available, the columns are returned as
+numpy arrays, otherwise as memoryview objects.
+
+Example:
+
+    from gm2_result_file import ResultFile
+
+    with ResultFile("scan.bin") as f:
+        amu = f.column("amu")
+
+The file can also be printed as a table:
+
+    python gm2_result_file.py scan.bin
+"""
+
+from __future__ import print_function
+import mmap
+import struct
+import sys
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+MAGIC = b"GM2CRSLT"
+VERSION = 1
+COLUMN_NAME_SIZE = 48
+VALUE_SIZE = 8
+FLOAT64, UINT64 = 0, 1
+TYPE_CODES = {FLOAT64: "d", UINT64: "Q"}
+
+class ResultFile(object):
+    """Memory mapped GM2Calc result file"""
+
+    def __init__(self, file_name):
+        self._file = open(file_name, "rb")
+        self._data = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        self.columns = []  # list of (name, type) pairs
+        self.chunks = []   # list of (offset, rows) pairs
+        self._read_header_and_chunks(file_name)
+        self.number_of_rows = sum(rows for _, rows in self.chunks)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def close(self):
+        """closes the file (the mapping is kept while columns are in use)"""
+        try:
+            self._data.close()
+        except BufferError:
+            pass
+        self._file.close()
+
+    def _read_header_and_chunks(self, file_name):
+        size = len(self._data)
+        if size < len(MAGIC) + 2*VALUE_SIZE or self._data[0:len(MAGIC)] != MAGIC:
+            raise IOError('"{}" is not a GM2Calc result file'.format(file_name))
+        version, ncols = struct.unpack_from("=QQ", self._data, len(MAGIC))
+        if version != VERSION:
+            raise IOError('result file "{}" has an incompatible format'.format(file_name))
+        pos = len(MAGIC) + 2*VALUE_SIZE
+        for _ in range(ncols):
+            name = self._data[pos:pos + COLUMN_NAME_SIZE].split(b"\0", 1)[0]
+            (typ,) = struct.unpack_from("=Q", self._data, pos + COLUMN_NAME_SIZE)
+            if typ not in TYPE_CODES:
+                raise IOError('result file "{}" is corrupt'.format(file_name))
+            self.columns.append((name.decode("ascii"), typ))
+            pos += COLUMN_NAME_SIZE + VALUE_SIZE
+        while ncols > 0 and pos + VALUE_SIZE <= size:
+            (rows,) = struct.unpack_from("=Q", self._data, pos)
+            begin = pos + VALUE_SIZE
+            end = begin + rows*ncols*VALUE_SIZE
+            if end > size:
+                break # truncated chunk
+            self.chunks.append((begin, rows))
+            pos = end
+
+    def column_names(self):
+        """returns the names of all columns"""
+        return [name for name, _ in self.columns]
+
+    def column_index(self, name):
+        """returns the index of the column with the given name"""
+        return self.column_names().index(name)
+
+    def chunk_column(self, chunk, column):
+        """returns the values of a column (name or index) in the given chunk"""
+        if not isinstance(column, int):
+            column = self.column_index(column)
+        offset, rows = self.chunks[chunk]
+        begin = offset + column*rows*VALUE_SIZE
+        code = TYPE_CODES[self.columns[column][1]]
+        if numpy is not None:
+            return numpy.frombuffer(self._data, dtype=numpy.dtype(code),
+                                    count=rows, offset=begin)
+        return memoryview(self._data)[begin:begin + rows*VALUE_SIZE].cast(code)
+
+    def column(self, column):
+        """returns all values of a column (name or index)"""
+        parts = [self.chunk_column(i, column) for i in range(len(self.chunks))]
+        if numpy is not None:
+            if len(parts) == 1:
+                return parts[0]
+            if not parts:
+                return numpy.empty(0)
+            return numpy.concatenate(parts)
+        return [x for part in parts for x in part]
+
+def print_table(file_name, out=sys.stdout):
+    """prints the content of a result file as a table"""
+    with ResultFile(file_name) as f:
+        print("# " + " ".join("{:>16s}".format(n) for n in f.column_names()), file=out)
+        for chunk in range(len(f.chunks)):
+            cols = [f.chunk_column(chunk, i) for i in range(len(f.columns))]
+            for row in range(f.chunks[chunk][1]):
+                fields = []
+                for i, (_, typ) in enumerate(f.columns):
+                    if typ == FLOAT64:
+                        fields.append("{:>16.8e}".format(float(cols[i][row])))
+                    else:
+                        fields.append("{:>16d}".format(int(cols[i][row])))
+                print("  " + " ".join(fields), file=out)
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        print("Usage: {} <result-file>".format(sys.argv[0]), file=sys.stderr)
+        sys.exit(1)
+    print_table(sys.argv[1])
@@ -0,0 +1,788 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_scan.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2_parallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+
+namespace gm2calc {
+
+namespace {
+
+constexpr unsigned max_scan_level = 24;
+
+/// cell of the quadtree, given by its level and its indices
+struct Cell {
+   unsigned level{0};
+   std::uint32_t i{0};
+   std::uint32_t j{0};
+};
+
+/// key of the grid node (i,j) of the finest level
+std::uint64_t node_key(std::uint32_t i, std::uint32_t j)
+{
+   return (static_cast<std::uint64_t>(i) << 32) | j;
+}
+
+/// key of a cell
+std::uint64_t cell_key(const Cell& c)
+{
+   return (static_cast<std::uint64_t>(c.level) << 58)
+      | (static_cast<std::uint64_t>(c.i) << 29) | c.j;
+}
+
+/// i-th of n + 1 equidistant points in [lo, hi]
+double get_coordinate(double lo, double hi, std::uint32_t i, std::uint32_t n)
+{
+   return i == n ? hi : lo + (hi - lo)*i/n;
+}
+
+/// number of cells per axis of the finest level
+std::uint32_t get_n(const Adaptive_scan_options& options)
+{
+   return std::uint32_t(1) << options.max_level;
+}
+
+/// number of nodes of the finest level per cell edge
+std::uint32_t get_cell_size(const Adaptive_scan_options& options, const Cell& c)
+{
+   return std::uint32_t(1) << (options.max_level - c.level);
+}
+
+void check(const Adaptive_scan_options& options)
+{
+   if (!(options.x_min < options.x_max) || !(options.y_min < options.y_max)) {
+      throw EInvalidInput("scan range must not be empty");
+   }
+   if (options.min_level > options.max_level) {
+      throw EInvalidInput("minimum scan level (" + std::to_string(options.min_level)
+                          + ") must not be larger than the maximum level ("
+                          + std::to_string(options.max_level) + ")");
+   }
+   if (options.max_level > max_scan_level) {
+      throw EInvalidInput("maximum scan level must not be larger than "
+                          + std::to_string(max_scan_level));
+   }
+}
+
+Scan_value evaluate_point(const Scan_function& f, double x, double y) noexcept
+{
+   try {
+      return f(x, y);
+   } catch (...) {
+      Scan_value v;
+      v.amu = v.damu = std::numeric_limits<double>::quiet_NaN();
+      v.flags = Scan_value::evaluation_error;
+      return v;
+   }
+}
+
+/// marks a value as not evaluated due to cancellation
+void set_cancelled(Scan_value& v)
+{
+   v.amu = v.damu = std::numeric_limits<double>::quiet_NaN();
+   v.flags = Scan_value::cancelled;
+}
+
+/**
+ * Evaluates the function at the points first, ..., points.size() - 1
+ * in parallel.  The token is checked before each evaluation.
+ *
+ * @return index one past the last evaluated point
+ */
+std::size_t evaluate(const Scan_function& f, std::vector<Scan_point>& points,
+                     std::size_t first, unsigned threads,
+                     const Cancellation_token* token)
+{
+   const auto evaluated = parallel_for(points.size() - first, threads, [&] (std::size_t i) {
+      Scan_point& p = points[first + i];
+      p.value = evaluate_point(f, p.x, p.y);
+   }, [token] () { return is_cancelled(token); });
+
+   return first + evaluated;
+}
+
+/// returns true if the cell must be refined
+bool needs_refinement(const Scan_value* corners, const Adaptive_scan_options& options)
+{
+   double amu_min = corners[0].amu, amu_max = corners[0].amu;
+   double lo = corners[0].amu - corners[0].damu, hi = corners[0].amu + corners[0].damu;
+
+   for (int k = 1; k < 4; k++) {
+      const Scan_value& v = corners[k];
+      if (v.flags != corners[0].flags || std::isfinite(v.amu) != std::isfinite(corners[0].amu)) {
+         return true;
+      }
+      amu_min = std::min(amu_min, v.amu);
+      amu_max = std::max(amu_max, v.amu);
+      lo = std::min(lo, v.amu - v.damu);
+      hi = std::max(hi, v.amu + v.damu);
+   }
+
+   if (amu_max - amu_min > options.max_variation) {
+      return true;
+   }
+
+   return std::any_of(options.targets.cbegin(), options.targets.cend(),
+                      [lo, hi] (double t) { return lo <= t && t <= hi; });
+}
+
+/**
+ * @class Contour_tracer
+ * @brief traces a contour in coordinates (u,v), which are normalized
+ * to the unit square
+ */
+class Contour_tracer {
+public:
+   /// point of the contour
+   struct Node {
+      double u{0.0}, v{0.0}; ///< normalized coordinates
+      Scan_point point;      ///< parameter point and its value
+      double g{0.0};         ///< amu - target
+   };
+
+   Contour_tracer(const Scan_function&, double, const Contour_options&);
+
+   /// reason for the end of the tracing
+   enum class End { closed, boundary, lost, cancelled };
+
+   Node evaluate(double, double);
+   bool find_start(Node, Node, Node&);
+   End trace(const Node&, int, std::vector<Node>&);
+   std::size_t get_number_of_evaluations() const { return evaluations; }
+
+private:
+   const Scan_function& f;
+   double target{0.0};
+   double tolerance{0.0};
+   Contour_options options;
+   std::size_t evaluations{0};
+
+   bool is_cancelled() const { return gm2calc::is_cancelled(options.cancellation); }
+   bool is_on_contour(const Node& n) const { return std::abs(n.g) <= tolerance; }
+   bool calculate_gradient(const Node&, double&, double&);
+   double correct(const Node&, double, double, double, double, double, bool, Node&);
+};
+
+Contour_tracer::Contour_tracer(const Scan_function& f_, double target_, const Contour_options& options_)
+   : f(f_)
+   , target(target_)
+   , tolerance(options_.rel_tolerance*std::abs(target_) + options_.abs_tolerance)
+   , options(options_)
+{
+}
+
+Contour_tracer::Node Contour_tracer::evaluate(double u, double v)
+{
+   Node n;
+   n.u = u;
+   n.v = v;
+   n.point.x = options.x_min + (options.x_max - options.x_min)*u;
+   n.point.y = options.y_min + (options.y_max - options.y_min)*v;
+   n.point.value = evaluate_point(f, n.point.x, n.point.y);
+   n.g = n.point.value.amu - target;
+   evaluations++;
+   return n;
+}
+
+/**
+ * Finds a point on the contour between a and b (Illinois algorithm).
+ *
+ * @return false if the search has been cancelled
+ */
+bool Contour_tracer::find_start(Node a, Node b, Node& start)
+{
+   if (is_on_contour(a)) {
+      start = a;
+      return true;
+   }
+   if (is_on_contour(b)) {
+      start = b;
+      return true;
+   }
+   if (!(a.g*b.g < 0)) {
+      throw EInvalidInput("amu - target does not change its sign within the bracket");
+   }
+
+   int side = 0;
+
+   for (int i = 0; i < 100; i++) {
+      if (is_cancelled()) {
+         return false;
+      }
+
+      const double t = a.g/(a.g - b.g);
+      const Node c = evaluate(a.u + t*(b.u - a.u), a.v + t*(b.v - a.v));
+
+      if (!std::isfinite(c.g)) {
+         break;
+      }
+      if (is_on_contour(c)) {
+         start = c;
+         return true;
+      }
+
+      if (c.g*b.g > 0) {
+         b = c;
+         if (side == -1) {
+            a.g *= 0.5;
+         }
+         side = -1;
+      } else {
+         a = c;
+         if (side == +1) {
+            b.g *= 0.5;
+         }
+         side = +1;
+      }
+   }
+
+   throw EInvalidInput("no point on the contour found within the bracket");
+}
+
+/// calculates the gradient of amu by finite differences
+bool Contour_tracer::calculate_gradient(const Node& n, double& gu, double& gv)
+{
+   constexpr double h = 1e-6;
+   const double du = n.u + h <= 1 ? h : -h;
+   const double dv = n.v + h <= 1 ? h : -h;
+
+   gu = (evaluate(n.u + du, n.v).g - n.g)/du;
+   gv = (evaluate(n.u, n.v + dv).g - n.g)/dv;
+
+   return std::isfinite(gu) && std::isfinite(gv) && (gu != 0 || gv != 0);
+}
+
+/**
+ * Predictor-corrector step of size h from the point p in the
+ * direction (tu,tv).  The corrector is a secant iteration along the
+ * gradient (gu,gv) at p, which is restricted to the boundary if the
+ * predicted point lies on it.
+ *
+ * @return distance between the predicted and the corrected point in
+ * units of h or a negative value if the corrector did not converge
+ */
+double Contour_tracer::correct(const Node& p, double tu, double tv, double h,
+                               double gu, double gv, bool at_boundary, Node& q)
+{
+   const auto clamp = [] (double x) { return std::min(std::max(x, 0.0), 1.0); };
+   const double u0 = clamp(p.u + h*tu), v0 = clamp(p.v + h*tv);
+   double du = gu, dv = gv;
+
+   if (at_boundary) {
+      if (u0 == 0 || u0 == 1) { du = 0; }
+      if (v0 == 0 || v0 == 1) { dv = 0; }
+   }
+
+   const double norm = std::hypot(du, dv);
+
+   if (norm == 0) {
+      return -1;
+   }
+
+   du /= norm;
+   dv /= norm;
+
+   // slope of amu along (du,dv)
+   double slope = gu*du + gv*dv;
+   double s = 0, s_prev = 0, g_prev = 0;
+
+   for (unsigned k = 0; k <= options.max_corrector_iterations; k++) {
+      q = evaluate(clamp(u0 + s*du), clamp(v0 + s*dv));
+      if (!std::isfinite(q.g)) {
+         return -1;
+      }
+      if (is_on_contour(q)) {
+         const double dist = std::hypot(q.u - u0, q.v - v0)/h;
+         // reject jumps to a different branch of the contour
+         return dist <= 1 ? dist : -1;
+      }
+      if (k > 0 && q.g != g_prev) {
+         slope = (q.g - g_prev)/(s - s_prev);
+      }
+      if (slope == 0) {
+         return -1;
+      }
+      s_prev = s;
+      g_prev = q.g;
+      s -= q.g/slope;
+   }
+
+   return -1;
+}
+
+/**
+ * Traces the contour from the start point in the given direction
+ * (+1 or -1) until the boundary is reached, the contour is closed,
+ * the contour is lost or the tracing is cancelled.
+ */
+Contour_tracer::End Contour_tracer::trace(const Node& start, int direction, std::vector<Node>& nodes)
+{
+   double gu = 0, gv = 0;
+
+   if (!calculate_gradient(start, gu, gv)) {
+      return End::lost;
+   }
+
+   Node p = start;
+   double h = options.step;
+   bool left_start = false;
+
+   while (nodes.size() < options.max_points) {
+      if (is_cancelled()) {
+         return End::cancelled;
+      }
+
+      const double dist = std::hypot(p.u - start.u, p.v - start.v);
+
+      if (dist > 2*h) {
+         left_start = true;
+      } else if (left_start && dist < h) {
+         return End::closed;
+      }
+
+      const double norm = std::hypot(gu, gv);
+      const double tu = -direction*gv/norm, tv = direction*gu/norm;
+
+      // distance to the boundary along the tangent
+      double lambda = std::numeric_limits<double>::infinity();
+      if (tu > 0) { lambda = std::min(lambda, (1 - p.u)/tu); }
+      if (tu < 0) { lambda = std::min(lambda, -p.u/tu); }
+      if (tv > 0) { lambda = std::min(lambda, (1 - p.v)/tv); }
+      if (tv < 0) { lambda = std::min(lambda, -p.v/tv); }
+
+      if (lambda < 1e-12) {
+         return End::boundary;
+      }
+
+      const bool at_boundary = h >= lambda;
+      Node q;
+      const double deviation = correct(p, tu, tv, std::min(h, lambda), gu, gv, at_boundary, q);
+
+      if (deviation < 0) {
+         h *= 0.5;
+         if (h < options.min_step) {
+            return End::lost;
+         }
+         continue;
+      }
+
+      nodes.push_back(q);
+
+      if (q.u == 0 || q.u == 1 || q.v == 0 || q.v == 1) {
+         return End::boundary;
+      }
+
+      if (!calculate_gradient(q, gu, gv)) {
+         return End::lost;
+      }
+
+      // adapt the step size to the curvature of the contour
+      if (deviation < 0.05) {
+         h = std::min(1.5*h, options.max_step);
+      } else if (deviation > 0.2) {
+         h = std::max(0.7*h, options.min_step);
+      }
+
+      p = q;
+   }
+
+   return End::lost;
+}
+
+} // anonymous namespace
+
+/**
+ * Returns the number of cells of the quadtree, which have not been
+ * refined.
+ */
+std::size_t Adaptive_scan_result::get_number_of_cells() const
+{
+   // each refinement replaces one cell by four
+   const std::size_t n0 = std::size_t(1) << (2*options.min_level);
+   return n0 + 3*refined.size();
+}
+
+/**
+ * Returns the value at the point (x,y), which is interpolated
+ * bilinearly from the corners of the (unrefined) cell, which
+ * contains the point.  The point is moved into the scan range if it
+ * lies outside.  The problem flags are the union of the flags of the
+ * corners, unless (x,y) is a corner.
+ *
+ * @param x 1st parameter
+ * @param y 2nd parameter
+ *
+ * @return interpolated value
+ */
+Scan_value Adaptive_scan_result::interpolate(double x, double y) const
+{
+   const std::uint32_t n = get_n(options);
+
+   // position in units of the finest cells
+   const double u = std::min(std::max((x - options.x_min)/(options.x_max - options.x_min), 0.0), 1.0)*n;
+   const double v = std::min(std::max((y - options.y_min)/(options.y_max - options.y_min), 0.0), 1.0)*n;
+   const std::uint32_t iu = std::min(static_cast<std::uint32_t>(u), n - 1);
+   const std::uint32_t iv = std::min(static_cast<std::uint32_t>(v), n - 1);
+
+   // descend to the unrefined cell, which contains the point
+   Cell c{options.min_level, iu >> (options.max_level - options.min_level),
+          iv >> (options.max_level - options.min_level)};
+
+   while (refined.count(cell_key(c)) != 0) {
+      c.level++;
+      c.i = iu >> (options.max_level - c.level);
+      c.j = iv >> (options.max_level - c.level);
+   }
+
+   const std::uint32_t s = get_cell_size(options, c);
+   const std::uint32_t i0 = c.i*s, j0 = c.j*s;
+   const double tu = (u - i0)/s, tv = (v - j0)/s;
+
+   const auto get = [this] (std::uint32_t i, std::uint32_t j) -> const Scan_value& {
+      return points[index.at(node_key(i, j))].value;
+   };
+
+   const Scan_value& v00 = get(i0, j0);
+   const Scan_value& v10 = get(i0 + s, j0);
+   const Scan_value& v01 = get(i0, j0 + s);
+   const Scan_value& v11 = get(i0 + s, j0 + s);
+
+   const double w00 = (1 - tu)*(1 - tv), w10 = tu*(1 - tv), w01 = (1 - tu)*tv, w11 = tu*tv;
+
+   Scan_value result;
+   result.amu = w00*v00.amu + w10*v10.amu + w01*v01.amu + w11*v11.amu;
+   result.damu = w00*v00.damu + w10*v10.damu + w01*v01.damu + w11*v11.damu;
+
+   if (w00 == 1) {
+      result.flags = v00.flags;
+   } else if (w10 == 1) {
+      result.flags = v10.flags;
+   } else if (w01 == 1) {
+      result.flags = v01.flags;
+   } else if (w11 == 1) {
+      result.flags = v11.flags;
+   } else {
+      result.flags = v00.flags | v10.flags | v01.flags | v11.flags;
+   }
+
+   return result;
+}
+
+/**
+ * Scans a_mu over the rectangle [x_min, x_max] x [y_min, y_max] with
+ * an adaptively refined quadtree of cells, see Adaptive_scan_options.
+ *
+ * The corners of all cells of one refinement level are evaluated in
+ * parallel.  Each point is evaluated only once, even if it is shared
+ * by several cells.  If the function throws, the value of the point
+ * is NaN and the flag Scan_value::evaluation_error is set.  The
+ * result does not depend on the number of threads.
+ *
+ * If the scan is cancelled (see Adaptive_scan_options::cancellation),
+ * the partially evaluated refinement level is discarded, such that
+ * the result is the complete quadtree of the previous level.  If the
+ * initial grid is incomplete, its remaining points are NaN and have
+ * the flag Scan_value::cancelled set.
+ *
+ * Example:
+ * @code
+ * Adaptive_scan_options options;
+ * options.x_min = 100; options.x_max = 1000; // mA
+ * options.y_min = 1;   options.y_max = 100;  // tan(beta)
+ * options.targets = {amu_exp - 2*damu_exp, amu_exp + 2*damu_exp};
+ *
+ * const auto result = scan_adaptive([] (double mA, double tb) {
+ *    ...
+ *    const THDM model(basis);
+ *    return Scan_value{calculate_amu_1loop(model) + calculate_amu_2loop(model),
+ *                      calculate_uncertainty_amu_2loop(model), 0};
+ * }, options);
+ * @endcode
+ *
+ * @param f function which evaluates a_mu at a point (x,y)
+ * @param options scan range and refinement criteria
+ *
+ * @return evaluated points and cells
+ */
+Adaptive_scan_result scan_adaptive(const Scan_function& f, const Adaptive_scan_options& options)
+{
+   check(options);
+
+   Adaptive_scan_result result;
+   result.options = options;
+
+   const std::uint32_t n = get_n(options);
+
+   // adds the corners of the cells, which have not been evaluated yet
+   const auto add_corners = [&] (const std::vector<Cell>& cells) {
+      for (const auto& c: cells) {
+         const std::uint32_t s = get_cell_size(options, c);
+         for (std::uint32_t di = 0; di <= s; di += s) {
+            for (std::uint32_t dj = 0; dj <= s; dj += s) {
+               const std::uint32_t i = c.i*s + di, j = c.j*s + dj;
+               if (result.index.emplace(node_key(i, j), result.points.size()).second) {
+                  Scan_point p;
+                  p.x = get_coordinate(options.x_min, options.x_max, i, n);
+                  p.y = get_coordinate(options.y_min, options.y_max, j, n);
+                  result.points.push_back(p);
+               }
+            }
+         }
+      }
+   };
+
+   const auto get_corners = [&] (const Cell& c, Scan_value* corners) {
+      const std::uint32_t s = get_cell_size(options, c);
+      const std::uint32_t i0 = c.i*s, j0 = c.j*s;
+      corners[0] = result.points[result.index.at(node_key(i0, j0))].value;
+      corners[1] = result.points[result.index.at(node_key(i0 + s, j0))].value;
+      corners[2] = result.points[result.index.at(node_key(i0, j0 + s))].value;
+      corners[3] = result.points[result.index.at(node_key(i0 + s, j0 + s))].value;
+   };
+
+   // initial grid
+   std::vector<Cell> cells;
+   const std::uint32_t n0 = std::uint32_t(1) << options.min_level;
+   for (std::uint32_t i = 0; i < n0; i++) {
+      for (std::uint32_t j = 0; j < n0; j++) {
+         cells.push_back(Cell{options.min_level, i, j});
+      }
+   }
+
+   std::size_t first = 0;
+   std::vector<std::uint64_t> parents; // cells refined into the current level
+
+   while (!cells.empty()) {
+      add_corners(cells);
+      const std::size_t last = evaluate(f, result.points, first, options.threads, options.cancellation);
+
+      if (last < result.points.size()) {
+         result.cancelled = true;
+         if (first == 0) {
+            for (std::size_t k = last; k < result.points.size(); k++) {
+               set_cancelled(result.points[k].value);
+            }
+         } else {
+            // undo the refinement into the current level
+            for (const auto key: parents) {
+               result.refined.erase(key);
+            }
+            for (auto it = result.index.begin(); it != result.index.end();) {
+               it = it->second >= first ? result.index.erase(it) : std::next(it);
+            }
+            result.points.resize(first);
+         }
+         break;
+      }
+
+      first = result.points.size();
+      parents.clear();
+
+      std::vector<Cell> children;
+
+      for (const auto& c: cells) {
+         Scan_value corners[4];
+         get_corners(c, corners);
+         if (c.level < options.max_level && needs_refinement(corners, options)) {
+            result.refined.insert(cell_key(c));
+            parents.push_back(cell_key(c));
+            for (std::uint32_t di = 0; di < 2; di++) {
+               for (std::uint32_t dj = 0; dj < 2; dj++) {
+                  children.push_back(Cell{c.level + 1, 2*c.i + di, 2*c.j + dj});
+               }
+            }
+         }
+      }
+
+      cells.swap(children);
+   }
+
+   return result;
+}
+
+/**
+ * Traces the contour a_mu = target through the parameter region
+ * [x_min, x_max] x [y_min, y_max].
+ *
+ * A first point on the contour is searched for on the line between
+ * (x0,y0) and (x1,y1), where a_mu - target must change its sign.
+ * Starting from this point, the contour is followed in both
+ * directions with predictor-corrector steps: The predictor is a step
+ * along the tangent of the contour, the corrector a secant iteration
+ * along the gradient of a_mu, which is calculated by finite
+ * differences.  The step size is adapted to the deviation of the
+ * corrected from the predicted point.  The tracing stops at the
+ * boundary of the parameter region, when the contour is closed or
+ * when it is cancelled (see Contour_options::cancellation).  A
+ * cancelled contour contains the points traced so far.
+ *
+ * The function is evaluated sequentially along the contour, such that
+ * it may re-use the state of the model from the previous evaluation
+ * (e.g. as starting point of an iteration), which has been performed
+ * at a nearby point.
+ *
+ * @param f function which evaluates a_mu at a point (x,y)
+ * @param target value of a_mu on the contour
+ * @param x0 1st parameter of the 1st end of the bracket
+ * @param y0 2nd parameter of the 1st end of the bracket
+ * @param x1 1st parameter of the 2nd end of the bracket
+ * @param y1 2nd parameter of the 2nd end of the bracket
+ * @param options parameter region, step sizes and tolerances
+ *
+ * @return points along the contour
+ */
+Contour trace_contour(const Scan_function& f, double target,
+                      double x0, double y0, double x1, double y1,
+                      const Contour_options& options)
+{
+   if (!(options.x_min < options.x_max) || !(options.y_min < options.y_max)) {
+      throw EInvalidInput("contour range must not be empty");
+   }
+   if (!(options.rel_tolerance*std::abs(target) + options.abs_tolerance > 0)) {
+      throw EInvalidInput("contour tolerance must be positive");
+   }
+   if (!(0 < options.min_step && options.min_step <= options.step && options.step <= options.max_step)) {
+      throw EInvalidInput("contour step sizes must satisfy 0 < min_step <= step <= max_step");
+   }
+
+   const auto in_range = [&options] (double x, double y) {
+      return options.x_min <= x && x <= options.x_max && options.y_min <= y && y <= options.y_max;
+   };
+
+   if (!in_range(x0, y0) || !in_range(x1, y1)) {
+      throw EInvalidInput("contour bracket must lie within the parameter region");
+   }
+
+   Contour contour;
+
+   if (is_cancelled(options.cancellation)) {
+      contour.cancelled = true;
+      return contour;
+   }
+
+   Contour_tracer tracer(f, target, options);
+
+   const auto u = [&options] (double x) { return (x - options.x_min)/(options.x_max - options.x_min); };
+   const auto v = [&options] (double y) { return (y - options.y_min)/(options.y_max - options.y_min); };
+
+   Contour_tracer::Node start;
+
+   if (!tracer.find_start(tracer.evaluate(u(x0), v(y0)), tracer.evaluate(u(x1), v(y1)), start)) {
+      contour.cancelled = true;
+      contour.number_of_evaluations = tracer.get_number_of_evaluations();
+      return contour;
+   }
+
+   std::vector<Contour_tracer::Node> forward, backward;
+
+   using End = Contour_tracer::End;
+
+   const End forward_end = tracer.trace(start, +1, forward);
+   const End backward_end = forward_end == End::closed || forward_end == End::cancelled
+      ? forward_end : tracer.trace(start, -1, backward);
+
+   for (auto it = backward.crbegin(); it != backward.crend(); ++it) {
+      contour.points.push_back(it->point);
+   }
+   contour.points.push_back(start.point);
+   for (const auto& n: forward) {
+      contour.points.push_back(n.point);
+   }
+
+   contour.closed = forward_end == End::closed;
+   contour.cancelled = forward_end == End::cancelled || backward_end == End::cancelled;
+   contour.complete = contour.closed
+      || (forward_end == End::boundary && backward_end == End::boundary);
+   contour.number_of_evaluations = tracer.get_number_of_evaluations();
+
+   return contour;
+}
+
+/**
+ * Evaluates a_mu at the points first, ..., first + count - 1 of the
+ * given sequence.  The points are distributed dynamically over the
+ * threads.  Since each point of the sequence only depends on its
+ * index, the result does not depend on the number of threads.  If
+ * the function throws, the value of the point is NaN and the flag
+ * Scan_value::evaluation_error is set.  If the scan is cancelled by
+ * the given token, the points which have not been evaluated are NaN
+ * and have the flag Scan_value::cancelled set.
+ *
+ * The scan can be split into several parts (e.g. over several jobs
+ * of a batch system) by choosing different ranges [first, first +
+ * count) of the same sequence.
+ *
+ * Example:
+ * @code
+ * const Scan_sequence sequence(Scan_sequence::Type::sobol,
+ *                              {{20, 100}, {10, 100}, {200, 800}}, 4096);
+ *
+ * const auto values = scan_sequence([] (const double* x) {
+ *    basis.mA = x[0]; basis.tan_beta = x[1]; basis.mH = x[2];
+ *    const THDM model(basis);
+ *    return Scan_value{calculate_amu_1loop(model) + calculate_amu_2loop(model), 0, 0};
+ * }, sequence, 0, sequence.size());
+ * @endcode
+ *
+ * @param f function which evaluates a_mu at a point
+ * @param sequence sequence of points
+ * @param first index of the first point
+ * @param count number of points
+ * @param threads number of threads (0 = number of hardware threads)
+ * @param token optional cancellation token (may be nullptr)
+ *
+ * @return values at the points, the k-th value belongs to the point first + k
+ */
+std::vector<Scan_value> scan_sequence(const Scan_sequence_function& f, const Scan_sequence& sequence,
+                                      std::uint64_t first, std::uint64_t count,
+                                      unsigned threads, const Cancellation_token* token)
+{
+   if (first > sequence.size() || count > sequence.size() - first) {
+      throw EInvalidInput("scan points [" + std::to_string(first) + ", "
+                          + std::to_string(first + count) + ") out of range [0, "
+                          + std::to_string(sequence.size()) + ")");
+   }
+
+   std::vector<Scan_value> values(count);
+
+   const std::uint64_t evaluated = parallel_for(count, threads, [&] (std::size_t k) {
+      double x[Scan_sequence::max_dimension];
+      sequence.get_point(first + k, x);
+      try {
+         values[k] = f(x);
+      } catch (...) {
+         Scan_value& v = values[k];
+         v.amu = v.damu = std::numeric_limits<double>::quiet_NaN();
+         v.flags = Scan_value::evaluation_error;
+      }
+   }, [token] () { return is_cancelled(token); });
+
+   for (std::uint64_t k = evaluated; k < count; k++) {
+      set_cancelled(values[k]);
+   }
+
+   return values;
+}
+
+} // namespace gm2calc
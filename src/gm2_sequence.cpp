@@ -0,0 +1,284 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_sequence.hpp"
+#include "gm2calc/gm2_error.hpp"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace gm2calc {
+
+namespace {
+
+/// first prime numbers (bases of the Halton sequence)
+const unsigned primes[Scan_sequence::max_dimension] = {
+   2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53
+};
+
+/// number of bits of the Sobol points
+constexpr unsigned sobol_bits = 32;
+
+/**
+ * Sobol direction numbers of the dimensions 2, 3, ... from the file
+ * new-joe-kuo-6.21201 of S. Joe and F. Y. Kuo: degree s of the
+ * primitive polynomial, its coefficients a and the initial direction
+ * numbers m_1, ..., m_s.
+ */
+const struct {
+   unsigned s;
+   unsigned a;
+   unsigned m[6];
+} sobol_directions[Scan_sequence::max_dimension - 1] = {
+   {1,  0, {1}},
+   {2,  1, {1, 3}},
+   {3,  1, {1, 3, 1}},
+   {3,  2, {1, 1, 1}},
+   {4,  1, {1, 1, 3, 3}},
+   {4,  4, {1, 3, 5, 13}},
+   {5,  2, {1, 1, 5, 5, 17}},
+   {5,  4, {1, 1, 5, 5, 5}},
+   {5,  7, {1, 1, 7, 11, 19}},
+   {5, 11, {1, 1, 5, 1, 1}},
+   {5, 13, {1, 1, 1, 3, 11}},
+   {5, 14, {1, 3, 5, 5, 31}},
+   {6,  1, {1, 3, 3, 9, 7, 49}},
+   {6, 13, {1, 1, 1, 15, 21, 21}},
+   {6, 16, {1, 3, 1, 13, 27, 49}},
+};
+
+/// keys of the independent random streams derived from the seed
+enum Stream : std::uint64_t {
+   stream_uniform = 0,
+   stream_shift = 1,
+   stream_permutation = 2,
+   stream_jitter = 3,
+};
+
+/// SplitMix64 finalizer
+std::uint64_t mix(std::uint64_t z) noexcept
+{
+   z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+   z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+   return z ^ (z >> 31);
+}
+
+/**
+ * Counter-based random number generator: returns 64 random bits,
+ * which only depend on the seed, the stream and the counter.
+ */
+std::uint64_t random_bits(std::uint64_t seed, Stream stream, std::uint64_t counter) noexcept
+{
+   const std::uint64_t key = mix(seed*0x9e3779b97f4a7c15ULL + stream);
+   return mix(key + (counter + 1)*0x9e3779b97f4a7c15ULL);
+}
+
+/// converts random bits to a number in [0,1)
+double to_unit(std::uint64_t bits) noexcept
+{
+   return (bits >> 11)*(1.0/9007199254740992.0);
+}
+
+/// radical inverse of i in the given base
+double radical_inverse(std::uint64_t i, unsigned base) noexcept
+{
+   const double inv_base = 1.0/base;
+   double f = inv_base, r = 0;
+
+   while (i > 0) {
+      r += (i % base)*f;
+      i /= base;
+      f *= inv_base;
+   }
+
+   return r;
+}
+
+/// direction numbers of the d-th dimension of the Sobol sequence
+void calculate_sobol_directions(unsigned d, std::uint32_t* v)
+{
+   if (d == 0) {
+      for (unsigned k = 0; k < sobol_bits; k++) {
+         v[k] = std::uint32_t(1) << (sobol_bits - 1 - k);
+      }
+      return;
+   }
+
+   const auto& p = sobol_directions[d - 1];
+
+   for (unsigned k = 0; k < sobol_bits; k++) {
+      if (k < p.s) {
+         v[k] = p.m[k] << (sobol_bits - 1 - k);
+      } else {
+         v[k] = v[k - p.s] ^ (v[k - p.s] >> p.s);
+         for (unsigned j = 1; j < p.s; j++) {
+            if ((p.a >> (p.s - 1 - j)) & 1) {
+               v[k] ^= v[k - j];
+            }
+         }
+      }
+   }
+}
+
+} // anonymous namespace
+
+/**
+ * Creates a sequence of points in the given box.
+ *
+ * @param type_ type of the sequence
+ * @param ranges_ parameter ranges
+ * @param size_ number of points
+ * @param seed_ seed of the random numbers
+ */
+Scan_sequence::Scan_sequence(Type type_, const std::vector<Scan_range>& ranges_,
+                             std::uint64_t size_, std::uint64_t seed_)
+   : type(type_), ranges(ranges_), n(size_), seed(seed_)
+{
+   const auto dim = get_dimension();
+
+   if (dim < 1 || dim > max_dimension) {
+      throw EInvalidInput("number of scan parameters must be between 1 and "
+                          + std::to_string(max_dimension));
+   }
+   for (const auto& r: ranges) {
+      if (!(r.min < r.max) || !std::isfinite(r.max - r.min)) {
+         throw EInvalidInput("scan range must not be empty");
+      }
+   }
+   if (n < 1) {
+      throw EInvalidInput("number of scan points must be positive");
+   }
+
+   switch (type) {
+   case Type::uniform:
+      break;
+   case Type::halton:
+   case Type::sobol:
+      if (type == Type::sobol) {
+         if (n > (std::uint64_t(1) << sobol_bits)) {
+            throw EInvalidInput("number of Sobol points must not be larger than 2^32");
+         }
+         directions.resize(dim*sobol_bits);
+         for (unsigned d = 0; d < dim; d++) {
+            calculate_sobol_directions(d, &directions[d*sobol_bits]);
+         }
+      }
+      shifts.assign(dim, 0.0);
+      if (seed != 0) {
+         for (unsigned d = 0; d < dim; d++) {
+            shifts[d] = to_unit(random_bits(seed, stream_shift, d));
+         }
+      }
+      break;
+   case Type::latin_hypercube:
+      if (n > std::numeric_limits<std::uint32_t>::max()) {
+         throw EInvalidInput("number of Latin hypercube points must be less than 2^32");
+      }
+      // random permutation of the intervals for each parameter (Fisher-Yates)
+      strata.resize(dim*n);
+      for (unsigned d = 0; d < dim; d++) {
+         std::uint32_t* p = &strata[d*n];
+         for (std::uint64_t i = 0; i < n; i++) {
+            p[i] = static_cast<std::uint32_t>(i);
+         }
+         for (std::uint64_t i = n - 1; i > 0; i--) {
+            const std::uint64_t bits = random_bits(seed, stream_permutation, d*n + i) >> 32;
+            const std::uint64_t j = (bits*(i + 1)) >> 32;
+            std::swap(p[i], p[j]);
+         }
+      }
+      break;
+   default:
+      throw EInvalidInput("unknown scan sequence type");
+   }
+}
+
+/**
+ * Returns the d-th coordinate of the i-th point in the unit cube.
+ *
+ * @param i index of the point
+ * @param d index of the parameter
+ *
+ * @return coordinate in [0,1)
+ */
+double Scan_sequence::get_unit_coordinate(std::uint64_t i, unsigned d) const
+{
+   switch (type) {
+   case Type::uniform:
+      return to_unit(random_bits(seed, stream_uniform, i*max_dimension + d));
+   case Type::halton: {
+      const double x = radical_inverse(i, primes[d]) + shifts[d];
+      return x < 1 ? x : x - 1;
+   }
+   case Type::sobol: {
+      const std::uint32_t* v = &directions[d*sobol_bits];
+      std::uint64_t g = i ^ (i >> 1); // Gray code
+      std::uint32_t bits = 0;
+      for (unsigned k = 0; g != 0; k++, g >>= 1) {
+         if (g & 1) {
+            bits ^= v[k];
+         }
+      }
+      const double x = bits*(1.0/4294967296.0) + shifts[d];
+      return x < 1 ? x : x - 1;
+   }
+   case Type::latin_hypercube: {
+      const double u = to_unit(random_bits(seed, stream_jitter, i*max_dimension + d));
+      return (strata[d*n + i] + u)/n;
+   }
+   }
+
+   return 0;
+}
+
+/**
+ * Returns the i-th point of the sequence.
+ *
+ * @param i index of the point (0 <= i < size())
+ * @param x parameter values of the point (get_dimension() values)
+ */
+void Scan_sequence::get_point(std::uint64_t i, double* x) const
+{
+   if (i >= n) {
+      throw EInvalidInput("index of scan point " + std::to_string(i)
+                          + " out of range [0, " + std::to_string(n) + ")");
+   }
+
+   for (unsigned d = 0; d < get_dimension(); d++) {
+      const auto& r = ranges[d];
+      x[d] = r.min + (r.max - r.min)*get_unit_coordinate(i, d);
+   }
+}
+
+/**
+ * Returns the i-th point of the sequence.
+ *
+ * @param i index of the point (0 <= i < size())
+ *
+ * @return parameter values of the point
+ */
+std::vector<double> Scan_sequence::get_point(std::uint64_t i) const
+{
+   std::vector<double> x(get_dimension());
+   get_point(i, x.data());
+   return x;
+}
+
+} // namespace gm2calc
@@ -0,0 +1,500 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2_server.hpp"
+
+#include "gm2calc/gm2_error.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GM2CALC_HAVE_UNIX_SOCKETS 1
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace gm2calc {
+
+namespace {
+
+/// names of the request types
+const char* const request_type_names[GM2_number_of_request_types] = {
+   "statistics", "slha", "gm2calc", "thdm", "thdm_mass_basis", "mssmnofv", "shutdown"
+};
+
+#ifdef GM2CALC_HAVE_UNIX_SOCKETS
+
+#ifdef MSG_NOSIGNAL
+const int send_flags = MSG_NOSIGNAL;
+#else
+const int send_flags = 0;
+#endif
+
+/// reads exactly size bytes, returns false if the connection is closed
+bool read_all(int fd, char* data, std::size_t size)
+{
+   while (size > 0) {
+      const auto n = ::recv(fd, data, size, 0);
+      if (n < 0 && errno == EINTR) {
+         continue;
+      }
+      if (n <= 0) {
+         return false;
+      }
+      data += n;
+      size -= static_cast<std::size_t>(n);
+   }
+   return true;
+}
+
+/// writes exactly size bytes, returns false if the connection is closed
+bool write_all(int fd, const char* data, std::size_t size)
+{
+   while (size > 0) {
+      const auto n = ::send(fd, data, size, send_flags);
+      if (n < 0 && errno == EINTR) {
+         continue;
+      }
+      if (n <= 0) {
+         return false;
+      }
+      data += n;
+      size -= static_cast<std::size_t>(n);
+   }
+   return true;
+}
+
+/// sends a response, returns false if the connection is closed
+bool write_response(int fd, std::uint32_t status, const std::string& payload)
+{
+   const std::uint32_t header[2] = { status, static_cast<std::uint32_t>(payload.size()) };
+   std::string buffer(reinterpret_cast<const char*>(header), sizeof(header));
+   buffer += payload;
+   return write_all(fd, buffer.data(), buffer.size());
+}
+
+#endif
+
+} // anonymous namespace
+
+/**
+ * Creates a Unix domain socket at the given path and starts listening
+ * for connections.  An existing socket at the path (e.g. left over by
+ * a previous server) is removed.
+ *
+ * @param socket_path_ path of the socket
+ * @param handler_ request handler (must be thread-safe)
+ * @param threads_ number of worker threads
+ */
+GM2_server::GM2_server(const std::string& socket_path_, const Handler& handler_,
+                       unsigned threads_)
+   : socket_path(socket_path_)
+   , handler(handler_)
+   , threads(std::max(1u, threads_))
+{
+#ifdef GM2CALC_HAVE_UNIX_SOCKETS
+   sockaddr_un addr{};
+
+   if (socket_path.empty() || socket_path.size() >= sizeof(addr.sun_path)) {
+      throw ESetupError("invalid socket path: \"" + socket_path + "\"");
+   }
+
+   addr.sun_family = AF_UNIX;
+   std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+   struct stat st{};
+   if (::stat(socket_path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+      ::unlink(socket_path.c_str());
+   }
+
+   listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+   if (listen_fd < 0) {
+      throw ESetupError(std::string("cannot create socket: ") + std::strerror(errno));
+   }
+
+   if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 ||
+       ::listen(listen_fd, SOMAXCONN) != 0) {
+      const std::string msg = std::strerror(errno);
+      ::close(listen_fd);
+      listen_fd = -1;
+      throw ESetupError("cannot listen on socket \"" + socket_path + "\": " + msg);
+   }
+
+   if (::pipe(wake_fd) != 0) {
+      const std::string msg = std::strerror(errno);
+      ::close(listen_fd);
+      ::unlink(socket_path.c_str());
+      listen_fd = -1;
+      throw ESetupError("cannot create pipe: " + msg);
+   }
+
+   for (const int fd: wake_fd) {
+      ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+   }
+#else
+   throw ESetupError("Unix domain sockets are not supported on this platform");
+#endif
+}
+
+/**
+ * Closes and removes the socket.
+ */
+GM2_server::~GM2_server()
+{
+#ifdef GM2CALC_HAVE_UNIX_SOCKETS
+   if (listen_fd >= 0) {
+      ::close(listen_fd);
+      ::unlink(socket_path.c_str());
+   }
+   for (const int fd: wake_fd) {
+      if (fd >= 0) {
+         ::close(fd);
+      }
+   }
+#endif
+}
+
+/**
+ * Accepts connections and polls the idle connections until stop() is
+ * called or a shutdown request is received.  A connection with a
+ * request is passed to the worker threads, which return it after the
+ * response has been sent.  Returns after all connections have been
+ * closed.
+ */
+void GM2_server::run()
+{
+#ifdef GM2CALC_HAVE_UNIX_SOCKETS
+   std::vector<std::thread> workers;
+
+   for (unsigned i = 0; i < threads; i++) {
+      workers.emplace_back([this] () { serve_requests(); });
+   }
+
+   std::vector<pollfd> pfds;
+
+   while (!stopped) {
+      pfds.clear();
+      pfds.push_back(pollfd{listen_fd, POLLIN, 0});
+      pfds.push_back(pollfd{wake_fd[0], POLLIN, 0});
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         for (const int fd: idle) {
+            pfds.push_back(pollfd{fd, POLLIN, 0});
+         }
+      }
+
+      if (::poll(pfds.data(), pfds.size(), 100) <= 0) {
+         continue;
+      }
+
+      if (pfds[1].revents != 0) {
+         char buffer[64];
+         while (::read(wake_fd[0], buffer, sizeof(buffer)) > 0) {}
+      }
+
+      std::size_t n_ready = 0;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         for (auto p = std::next(pfds.cbegin(), 2); p != pfds.cend(); ++p) {
+            if (p->revents != 0) {
+               idle.erase(p->fd);
+               ready.push_back(p->fd);
+               n_ready++;
+            }
+         }
+         if (pfds[0].revents != 0) {
+            const int fd = ::accept(listen_fd, nullptr, nullptr);
+            if (fd >= 0) {
+               idle.insert(fd);
+            }
+         }
+      }
+
+      for (std::size_t i = 0; i < n_ready; i++) {
+         cv.notify_one();
+      }
+   }
+
+   {
+      // interrupt the connections which are being served
+      std::lock_guard<std::mutex> lock(mutex);
+      for (const int fd: active) {
+         ::shutdown(fd, SHUT_RDWR);
+      }
+   }
+
+   cv.notify_all();
+
+   for (auto& w: workers) {
+      w.join();
+   }
+
+   for (const int fd: idle) {
+      ::close(fd);
+   }
+   for (const int fd: ready) {
+      ::close(fd);
+   }
+   idle.clear();
+   ready.clear();
+#endif
+}
+
+/**
+ * Stops the server.  The connections which are being served are
+ * closed.
+ */
+void GM2_server::stop()
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopped = true;
+   }
+   cv.notify_all();
+   wake();
+}
+
+/**
+ * Interrupts the poll() in run(), such that the set of idle
+ * connections is updated.
+ */
+void GM2_server::wake()
+{
+#ifdef GM2CALC_HAVE_UNIX_SOCKETS
+   // the pipe is non-blocking: if it is full, run() is woken anyway
+   const char c = 0;
+   const auto n = ::write(wake_fd[1], &c, 1);
+   static_cast<void>(n);
+#endif
+}
+
+/**
+ * Returns the latency statistics of all request types.
+ */
+GM2_server::Statistics GM2_server::get_statistics() const
+{
+   std::lock_guard<std::mutex> lock(mutex);
+   return statistics;
+}
+
+/**
+ * Serves the requests of the ready connections, one request at a
+ * time, until the server is stopped.
+ */
+void GM2_server::serve_requests()
+{
+   while (true) {
+      int fd = -1;
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         cv.wait(lock, [this] () { return stopped || !ready.empty(); });
+         if (stopped) {
+            return;
+         }
+         fd = ready.front();
+         ready.pop_front();
+         active.insert(fd);
+      }
+      release(fd, serve(fd));
+   }
+}
+
+/**
+ * Returns a served connection to the idle connections, or closes it.
+ *
+ * @param fd connection
+ * @param open false if the connection is to be closed
+ */
+void GM2_server::release(int fd, bool open)
+{
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      active.erase(fd);
+      if (open) {
+         idle.insert(fd);
+      }
+   }
+
+#ifdef GM2CALC_HAVE_UNIX_SOCKETS
+   if (open) {
+      wake();
+   } else {
+      ::close(fd);
+   }
+#endif
+}
+
+/**
+ * Serves one request of a connection.
+ *
+ * @param fd connection
+ *
+ * @return false if the connection is closed or must be closed
+ */
+bool GM2_server::serve(int fd)
+{
+#ifdef GM2CALC_HAVE_UNIX_SOCKETS
+   std::uint32_t header[2] = {0, 0};
+
+   if (!read_all(fd, reinterpret_cast<char*>(header), sizeof(header))) {
+      return false;
+   }
+
+   const auto start = std::chrono::steady_clock::now();
+   const std::uint32_t type = header[0];
+   const std::uint32_t size = header[1];
+
+   if (size > max_payload_size) {
+      write_response(fd, GM2_response_error, "request too large");
+      return false;
+   }
+
+   std::string payload(size, '\0');
+
+   if (!read_all(fd, &payload[0], size)) {
+      return false;
+   }
+
+   std::uint32_t status = GM2_response_ok;
+   const auto response = handle(type, payload, status);
+   const bool success = write_response(fd, status, response);
+
+   const std::chrono::duration<double> latency = std::chrono::steady_clock::now() - start;
+   record(type, latency.count(), status != GM2_response_ok);
+
+   // stop after the response has been sent, because stopping
+   // interrupts the connections
+   if (type == GM2_request_shutdown) {
+      stop();
+   }
+
+   return success;
+#else
+   return false;
+#endif
+}
+
+/**
+ * Handles a request.
+ *
+ * @param type request type
+ * @param payload request payload
+ * @param status response status
+ *
+ * @return response payload
+ */
+std::string GM2_server::handle(std::uint32_t type, const std::string& payload,
+                               std::uint32_t& status)
+{
+   switch (type) {
+   case GM2_request_statistics:
+      return format_statistics(get_statistics());
+   case GM2_request_shutdown:
+      return {};
+   default:
+      break;
+   }
+
+   if (type >= GM2_number_of_request_types) {
+      status = GM2_response_error;
+      return "unknown request type " + std::to_string(type);
+   }
+
+   try {
+      return handler(type, payload);
+   } catch (const std::exception& e) {
+      status = GM2_response_error;
+      return e.what();
+   }
+}
+
+/**
+ * Records the latency of a request.
+ *
+ * @param type request type
+ * @param latency latency [s]
+ * @param error true if the request failed
+ */
+void GM2_server::record(std::uint32_t type, double latency, bool error)
+{
+   if (type >= GM2_number_of_request_types) {
+      return;
+   }
+
+   std::lock_guard<std::mutex> lock(mutex);
+   auto& l = statistics[type];
+
+   if (l.count == 0) {
+      l.min = l.max = latency;
+   } else {
+      l.min = std::min(l.min, latency);
+      l.max = std::max(l.max, latency);
+   }
+
+   l.count++;
+   l.total += latency;
+
+   if (error) {
+      l.errors++;
+   }
+}
+
+/**
+ * Formats the latency statistics as a table, with one row per request
+ * type which has been used.  The latencies are given in microseconds.
+ *
+ * @param statistics latency statistics
+ *
+ * @return table
+ */
+std::string format_statistics(const GM2_server::Statistics& statistics)
+{
+   std::string result;
+   char line[256];
+
+   std::snprintf(line, sizeof(line), "# %-16s %10s %10s %12s %12s %12s\n",
+                 "type", "count", "errors", "mean/us", "min/us", "max/us");
+   result += line;
+
+   for (std::size_t i = 0; i < statistics.size(); i++) {
+      const auto& l = statistics[i];
+      if (l.count == 0) {
+         continue;
+      }
+      std::snprintf(line, sizeof(line), "  %-16s %10zu %10zu %12.1f %12.1f %12.1f\n",
+                    request_type_names[i], l.count, l.errors,
+                    1e6 * l.total / l.count, 1e6 * l.min, 1e6 * l.max);
+      result += line;
+   }
+
+   return result;
+}
+
+} // namespace gm2calc
@@ -0,0 +1,142 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_SERVER_HPP
+#define GM2_SERVER_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace gm2calc {
+
+/// request types of the GM2Calc server protocol
+enum GM2_request_type : std::uint32_t {
+   GM2_request_statistics = 0,       ///< latency statistics (text)
+   GM2_request_slha = 1,             ///< MSSMNoFV, SLHA input (text)
+   GM2_request_gm2calc = 2,          ///< MSSMNoFV, GM2Calc input (text)
+   GM2_request_thdm = 3,             ///< THDM, SLHA input (text)
+   GM2_request_thdm_mass_basis = 4,  ///< THDM, mass basis record (binary)
+   GM2_request_mssmnofv = 5,         ///< MSSMNoFV, GM2Calc input record (binary)
+   GM2_request_shutdown = 6,         ///< stop the server
+   GM2_number_of_request_types = 7
+};
+
+/// response status of the GM2Calc server protocol
+enum GM2_response_status : std::uint32_t {
+   GM2_response_ok = 0,    ///< payload contains the result
+   GM2_response_error = 1, ///< payload contains the error message
+};
+
+/**
+ * @class GM2_server
+ * @brief serves requests over a Unix domain socket
+ *
+ * Each request and each response consists of an 8 byte header,
+ * followed by a payload:
+ *
+ * @code
+ * request:  uint32 type (GM2_request_type), uint32 payload size n, n bytes payload
+ * response: uint32 status (GM2_response_status), uint32 payload size n, n bytes payload
+ * @endcode
+ *
+ * All integers are stored in the native byte order.  A client may
+ * send any number of requests over one connection; the responses are
+ * sent in the order of the requests.  The idle connections are
+ * polled by run(), and each request is passed to one of a pool of
+ * worker threads.  A connection is served by at most one worker at a
+ * time, and only while it has a request, so idle clients do not
+ * occupy the workers.
+ *
+ * The requests GM2_request_statistics and GM2_request_shutdown are
+ * handled by the server itself, all other requests are passed to the
+ * request handler.  If the handler throws, an error response with the
+ * exception message is sent.
+ *
+ * The latency of each request, i.e. the time between the receipt of
+ * the request and the sending of the response, is recorded per
+ * request type.
+ */
+class GM2_server {
+public:
+   /// returns the response payload of a request
+   using Handler = std::function<std::string(std::uint32_t, const std::string&)>;
+
+   /// latency statistics of one request type
+   struct Latency {
+      std::size_t count{0};   ///< number of requests
+      std::size_t errors{0};  ///< number of failed requests
+      double total{0.0};      ///< total latency [s]
+      double min{0.0};        ///< minimum latency [s]
+      double max{0.0};        ///< maximum latency [s]
+   };
+
+   using Statistics = std::array<Latency, GM2_number_of_request_types>;
+
+   /// maximum payload size of a request
+   static constexpr std::uint32_t max_payload_size = 64u << 20;
+
+   GM2_server(const std::string&, const Handler&, unsigned threads);
+   GM2_server(const GM2_server&) = delete;
+   GM2_server(GM2_server&&) = delete;
+   ~GM2_server();
+   GM2_server& operator=(const GM2_server&) = delete;
+   GM2_server& operator=(GM2_server&&) = delete;
+
+   /// accepts connections until stop() is called or a shutdown request is received
+   void run();
+   /// stops the server (may be called from any thread)
+   void stop();
+   /// latency statistics
+   Statistics get_statistics() const;
+
+private:
+   std::string socket_path;         ///< path of the socket
+   Handler handler;                 ///< request handler
+   unsigned threads{1};             ///< number of worker threads
+   int listen_fd{-1};               ///< listening socket
+   int wake_fd[2]{-1, -1};          ///< pipe to interrupt poll() in run()
+   std::atomic<bool> stopped{false}; ///< stop requested
+   mutable std::mutex mutex;        ///< protects the members below
+   std::condition_variable cv;      ///< signals ready connections
+   std::set<int> idle;              ///< connections waiting for a request
+   std::deque<int> ready;           ///< connections with a request, not yet served
+   std::set<int> active;            ///< connections being served
+   Statistics statistics{};         ///< latency statistics
+
+   void serve_requests();
+   bool serve(int);
+   void release(int, bool);
+   void wake();
+   std::string handle(std::uint32_t, const std::string&, std::uint32_t&);
+   void record(std::uint32_t, double, bool);
+};
+
+/// formats the latency statistics as a table
+std::string format_statistics(const GM2_server::Statistics&);
+
+} // namespace gm2calc
+
+#endif
@@ -0,0 +1,168 @@
+#!/usr/bin/env python
+
+# ====================================================================
+# This file is part of GM2Calc.
+#
+# GM2Calc is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published
+# by the Free Software Foundation, either version 3 of the License,
+# or (at your option) any later version.
+#
+# GM2Calc is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with GM2Calc.  If not, see
+# <http://www.gnu.org/licenses/>.
+# ====================================================================
+
+"""Client for the GM2Calc server.
+
+The server is started with
+
+    gm2calc.x --serve=/tmp/gm2calc.sock
+
+The protocol is described in src/gm2_server.hpp, the request records
+in src/gm2calc.cpp.
+
+Example:
+
+    from gm2_server_client import Client
+
+    with Client("/tmp/gm2calc.sock") as c:
+        amu, damu = c.thdm_mass_basis(mh=125, mH=400, mA=420, mHp=440,
+                                      sin_beta_minus_alpha=0.999,
+                                      tan_beta=3, m122=40000)
+
+The client can also be used from the command line:
+
+    python gm2_server_client.py /tmp/gm2calc.sock thdm ../input/example.thdm
+    python gm2_server_client.py /tmp/gm2calc.sock statistics
+    python gm2_server_client.py /tmp/gm2calc.sock shutdown
+"""
+
+from __future__ import print_function
+import socket
+import struct
+import sys
+
+STATISTICS, SLHA, GM2CALC, THDM, THDM_MASS_BASIS, MSSMNOFV, SHUTDOWN = range(7)
+OK, ERROR = 0, 1
+
+THDM_MASS_BASIS_FIELDS = [
+    ("yukawa_type", 2), ("mh", 0), ("mH", 0), ("mA", 0), ("mHp", 0),
+    ("sin_beta_minus_alpha", 0), ("lambda_6", 0), ("lambda_7", 0),
+    ("tan_beta", 0), ("m122", 0), ("zeta_u", 0), ("zeta_d", 0), ("zeta_l", 0),
+]
+
+MSSMNOFV_FIELDS = ["TB", "Mu", "MassB", "MassWB", "MassG", "MA0", "scale"]
+MSSMNOFV_MATRICES = ["mq2", "mu2", "md2", "ml2", "me2", "Au", "Ad", "Ae"]
+
+class ServerError(Exception):
+    """error reported by the server"""
+
+class Client(object):
+    """connection to a GM2Calc server"""
+
+    def __init__(self, socket_path):
+        self._socket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self._socket.connect(socket_path)
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def close(self):
+        """closes the connection"""
+        self._socket.close()
+
+    def _read(self, size):
+        data = b""
+        while len(data) < size:
+            part = self._socket.recv(size - len(data))
+            if not part:
+                raise IOError("connection closed by the server")
+            data += part
+        return data
+
+    def request(self, request_type, payload=b""):
+        """sends a request and returns the response payload"""
+        self._socket.sendall(struct.pack("=II", request_type, len(payload)) + payload)
+        status, size = struct.unpack("=II", self._read(8))
+        data = self._read(size)
+        if status != OK:
+            raise ServerError(data.decode("utf-8", "replace"))
+        return data
+
+    def _amu(self, request_type, payload):
+        return struct.unpack("=dd", self.request(request_type, payload))
+
+    def slha(self, text):
+        """returns (amu, damu) for MSSMNoFV SLHA input"""
+        return self._amu(SLHA, text.encode("utf-8"))
+
+    def gm2calc(self, text):
+        """returns (amu, damu) for MSSMNoFV GM2Calc input"""
+        return self._amu(GM2CALC, text.encode("utf-8"))
+
+    def thdm(self, text):
+        """returns (amu, damu) for THDM SLHA input"""
+        return self._amu(THDM, text.encode("utf-8"))
+
+    def thdm_mass_basis(self, **kwargs):
+        """returns (amu, damu) for THDM mass basis parameters"""
+        values = [float(kwargs.pop(name, default)) for name, default in THDM_MASS_BASIS_FIELDS]
+        if kwargs:
+            raise TypeError("unknown parameters: " + ", ".join(kwargs))
+        return self._amu(THDM_MASS_BASIS, struct.pack("=13d", *values))
+
+    def mssmnofv(self, **kwargs):
+        """returns (amu, damu) for MSSMNoFV parameters in the GM2Calc
+        input scheme (matrices are given by their diagonal)"""
+        values = [float(kwargs.pop(name, 0)) for name in MSSMNOFV_FIELDS]
+        for name in MSSMNOFV_MATRICES:
+            values.extend(float(x) for x in kwargs.pop(name, (0, 0, 0)))
+        if kwargs:
+            raise TypeError("unknown parameters: " + ", ".join(kwargs))
+        return self._amu(MSSMNOFV, struct.pack("=31d", *values))
+
+    def statistics(self):
+        """returns the latency statistics of the server"""
+        return self.request(STATISTICS).decode("utf-8")
+
+    def shutdown(self):
+        """stops the server"""
+        self.request(SHUTDOWN)
+
+def main(argv):
+    """command line interface"""
+    if len(argv) < 3:
+        print("Usage: {} <socket> (slha|gm2calc|thdm) <file>\n"
+              "       {} <socket> (statistics|shutdown)".format(argv[0], argv[0]),
+              file=sys.stderr)
+        return 1
+    with Client(argv[1]) as c:
+        command = argv[2]
+        if command in ("slha", "gm2calc", "thdm"):
+            with open(argv[3]) as f:
+                amu, damu = getattr(c, command)(f.read())
+            print("{:.8e} {:.8e}".format(amu, damu))
+        elif command == "statistics":
+            print(c.statistics(), end="")
+        elif command == "shutdown":
+            c.shutdown()
+        else:
+            print("Unknown command: " + command, file=sys.stderr)
+            return 1
+    return 0
+
+if __name__ == "__main__":
+    try:
+        sys.exit(main(sys.argv))
+    except ServerError as e:
+        print("Error: " + str(e), file=sys.stderr)
+        sys.exit(1)
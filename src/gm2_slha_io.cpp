@@ -26,21 +26,20 @@
 #include "gm2_log.hpp"
 #include "gm2_numerics.hpp"
 
+#include <algorithm>
+#include <cerrno>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <string>
 
-#include <boost/format.hpp>
 #include <boost/lexical_cast.hpp>
 #include <Eigen/Core>
 
-#define FORMAT_ELEMENT(pdg,value,name)                                  \
-   boost::format(" %5d   %16.8E   # %s\n") % (pdg) % (value) % (name)
-#define FORMAT_SPINFO(n,str)                                            \
-   boost::format(" %5d   %s\n") % (n) % (str)
-
 namespace gm2calc {
 
 namespace {
@@ -79,8 +78,87 @@ namespace {
    void process_msoft_tuple(MSSMNoFV_onshell& /*model*/, int /*key*/, double /*value*/);
    void process_vckm_tuple(CKM_wolfenstein& /* ckm */, int /* key */, double /* value */);
 
+   /// SLHA whitespace characters
+   bool is_space(char c)
+   {
+      return c == ' ' || c == '\t' || c == '\v' || c == '\f' || c == '\r';
+   }
+
+   /// converts ASCII character to upper case
+   char to_upper(char c)
+   {
+      return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+   }
+
+   /// maximum length of a formatted key and value
+   const std::size_t max_entry_prefix_length = 64;
+
+   /**
+    * Formats the key and value of a block entry as
+    * " %5d   %16.8E   # " into the given buffer.
+    *
+    * @return number of characters written
+    */
+   std::size_t format_entry_prefix(char* buf, unsigned key, double value)
+   {
+      const int n = std::snprintf(buf, max_entry_prefix_length,
+                                  " %5u   %16.8E   # ", key, value);
+      return n > 0 ? std::min(static_cast<std::size_t>(n), max_entry_prefix_length - 1) : 0;
+   }
+
+   /**
+    * Formats the key of a block entry as " %5d   " into the given
+    * buffer.
+    *
+    * @return number of characters written
+    */
+   std::size_t format_entry_prefix(char* buf, unsigned key)
+   {
+      const int n = std::snprintf(buf, max_entry_prefix_length, " %5u   ", key);
+      return n > 0 ? std::min(static_cast<std::size_t>(n), max_entry_prefix_length - 1) : 0;
+   }
+
 } // anonymous namespace
 
+constexpr std::size_t GM2_slha_io::npos;
+
+std::size_t GM2_slha_io::Name_hash::operator()(const std::string& name) const
+{
+   // FNV-1a
+   std::size_t hash = 2166136261U;
+   for (const char c: name) {
+      hash = (hash ^ static_cast<unsigned char>(to_upper(c))) * 16777619U;
+   }
+   return hash;
+}
+
+bool GM2_slha_io::Name_equal::operator()(const std::string& a, const std::string& b) const
+{
+   if (a.size() != b.size()) {
+      return false;
+   }
+   for (std::size_t i = 0; i < a.size(); i++) {
+      if (to_upper(a[i]) != to_upper(b[i])) {
+         return false;
+      }
+   }
+   return true;
+}
+
+/**
+ * @brief removes all input and output data
+ */
+void GM2_slha_io::clear()
+{
+   buffer.clear();
+   tokens.clear();
+   lines.clear();
+   blocks.clear();
+   block_index.clear();
+   data.clear();
+   data_size = 0;
+}
+
 /**
  * @brief reads from source
  *
@@ -104,10 +182,16 @@ void GM2_slha_io::read_from_source(const std::string& source)
  */
 void GM2_slha_io::read_from_file(const std::string& file_name)
 {
-   std::ifstream ifs(file_name);
+   std::ifstream ifs(file_name, std::ios::binary);
    if (ifs.good()) {
-      data.clear();
-      data.read(ifs);
+      clear();
+      ifs.seekg(0, std::ios::end);
+      const auto size = ifs.tellg();
+      ifs.seekg(0, std::ios::beg);
+      if (size > 0) {
+         buffer.reserve(static_cast<std::size_t>(size));
+      }
+      append(ifs);
    } else {
       throw EReadError("cannot read input file: \"" + file_name + "\"");
    }
@@ -115,11 +199,214 @@ void GM2_slha_io::read_from_file(const std::string& file_name)
 
 /**
  * @brief reads SLHA data from a stream
+ *
+ * The data is appended to the data read so far.
+ *
  * @param istr input stream
  */
 void GM2_slha_io::read_from_stream(std::istream& istr)
 {
-   data.read(istr);
+   append(istr);
+}
+
+/**
+ * @brief replaces the SLHA data by the content of a string
+ * @param str SLHA data
+ */
+void GM2_slha_io::read_from_string(const std::string& str)
+{
+   clear();
+   buffer.assign(str);
+   parse(0);
+}
+
+/**
+ * Appends the content of the stream to the buffer and tokenizes the
+ * new content.
+ *
+ * @param istr input stream
+ */
+void GM2_slha_io::append(std::istream& istr)
+{
+   // separate from previous content
+   if (!buffer.empty() && buffer.back() != '\n') {
+      buffer.push_back('\n');
+   }
+
+   const std::size_t begin = buffer.size();
+   char chunk[1 << 14];
+
+   while (istr.read(chunk, sizeof(chunk)) || istr.gcount() > 0) {
+      buffer.append(chunk, static_cast<std::size_t>(istr.gcount()));
+   }
+
+   parse(begin);
+}
+
+/**
+ * Splits the lines of the buffer, starting at the given position,
+ * into tokens and registers block definitions and data lines.  As in
+ * SLHAea, a line is split into whitespace-separated fields, followed
+ * by the comment (if any) as last token.  Lines before the first
+ * block definition are ignored.  Afterwards, the scales of the new
+ * blocks are read.
+ *
+ * @param pos position of the first character to parse
+ */
+void GM2_slha_io::parse(std::size_t pos)
+{
+   const auto is_comment = [this] (const Token& t) {
+      return t.len > 0 && buffer[t.pos] == '#';
+   };
+
+   const auto is_block_specifier = [this] (const Token& t) {
+      if (t.len != 5) {
+         return false;
+      }
+      char s[5];
+      for (std::size_t i = 0; i < 5; i++) {
+         s[i] = to_upper(buffer[t.pos + i]);
+      }
+      return std::equal(s, s + 5, "BLOCK") || std::equal(s, s + 5, "DECAY");
+   };
+
+   const std::size_t size = buffer.size();
+   const std::size_t first_block = blocks.size();
+   std::size_t block = npos; // current block
+
+   while (pos < size) {
+      std::size_t eol = buffer.find('\n', pos);
+      if (eol == std::string::npos) {
+         eol = size;
+      }
+
+      // split line into tokens
+      const std::size_t first = tokens.size();
+      std::size_t p = pos;
+
+      while (true) {
+         while (p < eol && is_space(buffer[p])) {
+            p++;
+         }
+         if (p == eol) {
+            break;
+         }
+         if (buffer[p] == '#') {
+            std::size_t e = eol;
+            while (e > p && is_space(buffer[e - 1])) {
+               e--;
+            }
+            tokens.push_back(Token{p, e - p});
+            break;
+         }
+         const std::size_t start = p;
+         while (p < eol && !is_space(buffer[p]) && buffer[p] != '#') {
+            p++;
+         }
+         tokens.push_back(Token{start, p - start});
+      }
+
+      pos = eol + 1;
+
+      const Line line{first, tokens.size() - first};
+
+      if (line.size >= 2 && is_block_specifier(field(line, 0)) &&
+          !is_comment(field(line, 1))) {
+         // block definition
+         const auto& name = field(line, 1);
+         lines.push_back(line);
+         block = blocks.size();
+         blocks.push_back(Block{lines.size() - 1, lines.size(), npos});
+
+         const auto it = block_index.emplace(buffer.substr(name.pos, name.len), block);
+         if (!it.second) {
+            auto b = it.first->second;
+            while (blocks[b].next != npos) {
+               b = blocks[b].next;
+            }
+            blocks[b].next = block;
+         }
+      } else if (block != npos && line.size > 0 &&
+                 !is_comment(field(line, 0)) &&
+                 !is_block_specifier(field(line, 0))) {
+         // data line
+         lines.push_back(line);
+         blocks[block].end = lines.size();
+      } else {
+         // empty line, comment or line before the first block
+         tokens.resize(first);
+      }
+   }
+
+   for (std::size_t b = first_block; b < blocks.size(); b++) {
+      read_block_scale(blocks[b]);
+   }
+}
+
+/**
+ * Reads the scale after Q= from the block definition.
+ *
+ * @param block block
+ */
+void GM2_slha_io::read_block_scale(Block& block)
+{
+   const auto& def = lines[block.def];
+
+   if (def.size > 3) {
+      const auto& q = field(def, 2);
+      if (buffer.compare(q.pos, q.len, "Q=") == 0) {
+         const auto& value = field(def, 3);
+         block.scale_def = parse_number(buffer.c_str() + value.pos, block.scale)
+            ? Scale_def::numeric : Scale_def::non_numeric;
+      }
+   }
+}
+
+/**
+ * Returns the index of the first block with the given name
+ * (case-insensitive).
+ *
+ * @param block_name block name
+ *
+ * @return block index (or npos if there is no such block)
+ */
+std::size_t GM2_slha_io::find_block(const std::string& block_name) const
+{
+   const auto it = block_index.find(block_name);
+   return it == block_index.end() ? npos : it->second;
+}
+
+/**
+ * Parses an integer from the beginning of a string.
+ *
+ * @param str string
+ * @param value parsed number
+ *
+ * @return true on success, false otherwise
+ */
+bool GM2_slha_io::parse_number(const char* str, long long& value)
+{
+   char* end = nullptr;
+   errno = 0;
+   value = std::strtoll(str, &end, 10);
+   return end != str && errno != ERANGE;
+}
+
+/**
+ * Parses a finite floating point number from the beginning of a
+ * string.
+ *
+ * @param str string
+ * @param value parsed number
+ *
+ * @return true on success, false otherwise
+ */
+bool GM2_slha_io::parse_number(const char* str, double& value)
+{
+   char* end = nullptr;
+   errno = 0;
+   value = std::strtod(str, &end);
+   return end != str && errno != ERANGE && std::isfinite(value);
 }
 
 /**
@@ -129,18 +416,18 @@ void GM2_slha_io::read_from_stream(std::istream& istr)
  *
  * @return scale (or 0 if no scale is defined)
  */
-double GM2_slha_io::read_scale(const SLHAea::Block& block)
+double GM2_slha_io::read_scale(const Block& block) const
 {
-   double scale = 0.0;
-
-   for (const auto& line : block) {
-      // read scale from block definition
-      if (line.is_block_def() && line.size() > 3 && line[2] == "Q=") {
-         scale = convert_to<double>(line[3]);
-      }
+   switch (block.scale_def) {
+   case Scale_def::numeric:
+      return block.scale;
+   case Scale_def::non_numeric:
+      throw EReadError("non-numeric input");
+   default:
+      break;
    }
 
-   return scale;
+   return 0.0;
 }
 
 /**
@@ -153,12 +440,9 @@ double GM2_slha_io::read_scale(const SLHAea::Block& block)
 double GM2_slha_io::read_scale(const std::string& block_name) const
 {
    double scale = 0.;
-   auto block = data.find(block_name);
 
-   while (block != data.cend()) {
-      scale = GM2_slha_io::read_scale(*block);
-      ++block;
-      block = data.find(block, data.end(), block_name);
+   for (auto b = find_block(block_name); b != npos; b = blocks[b].next) {
+      scale = read_scale(blocks[b]);
    }
 
    return scale;
@@ -172,13 +456,13 @@ double GM2_slha_io::read_scale(const std::string& block_name) const
  * @param scale scale
  * @param eps absolute tolerance to treat two scales being the same
  */
-bool GM2_slha_io::is_at_scale(const SLHAea::Block& block, double scale, double eps)
+bool GM2_slha_io::is_at_scale(const Block& block, double scale, double eps) const
 {
    if (is_zero(scale, std::numeric_limits<double>::epsilon())) {
       return true;
    }
 
-   const auto block_scale = GM2_slha_io::read_scale(block);
+   const auto block_scale = read_scale(block);
 
    return is_equal(scale, block_scale, eps);
 }
@@ -190,12 +474,13 @@ bool GM2_slha_io::is_at_scale(const SLHAea::Block& block, double scale, double e
  * @param block the block
  * @param processor tuple processor to be applied
  */
-void GM2_slha_io::read_block(const SLHAea::Block& block, const Tuple_processor& processor)
+void GM2_slha_io::read_block(const Block& block, const Tuple_processor& processor) const
 {
-   for (const auto& line : block) {
-      if (line.is_data_line() && line.size() >= 2) {
-         const auto key = convert_to<int>(line[0]);
-         const auto value = convert_to<double>(line[1]);
+   for (std::size_t l = block.def + 1; l < block.end; l++) {
+      const auto& line = lines[l];
+      if (line.size >= 2) {
+         const auto key = convert_to<int>(field(line, 0));
+         const auto value = convert_to<double>(field(line, 1));
          processor(key, value);
       }
    }
@@ -213,15 +498,23 @@ void GM2_slha_io::read_block(const std::string& block_name,
                              const Tuple_processor& processor,
                              double scale) const
 {
-   auto block = data.find(block_name);
-
-   while (block != data.cend()) {
-      if (is_at_scale(*block, scale)) {
-         GM2_slha_io::read_block(*block, processor);
+   for (auto b = find_block(block_name); b != npos; b = blocks[b].next) {
+      if (is_at_scale(blocks[b], scale)) {
+         read_block(blocks[b], processor);
       }
+   }
+}
 
-      ++block;
-      block = data.find(block, data.end(), block_name);
+/**
+ * Adds the input characters, which have not been added yet, to the
+ * SLHAea output document.
+ */
+void GM2_slha_io::sync_data()
+{
+   if (data_size < buffer.size()) {
+      std::istringstream istr(buffer.substr(data_size));
+      data.read(istr);
+      data_size = buffer.size();
    }
 }
 
@@ -233,6 +526,8 @@ void GM2_slha_io::write_to_file(const std::string& file_name)
 
 void GM2_slha_io::write_to_stream(std::ostream& ostr)
 {
+   sync_data();
+
    if (ostr.good()) {
       ostr << data;
    } else {
@@ -240,6 +535,24 @@ void GM2_slha_io::write_to_stream(std::ostream& ostr)
    }
 }
 
+/**
+ * Writes the input characters verbatim to a stream, terminated by a
+ * newline.  Entries added with fill_block_entry() are not written.
+ *
+ * @param ostr output stream
+ */
+void GM2_slha_io::write_input_to_stream(std::ostream& ostr) const
+{
+   if (ostr.good()) {
+      ostr.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      if (!buffer.empty() && buffer.back() != '\n') {
+         ostr << '\n';
+      }
+   } else {
+      ERROR("cannot write SLHA file");
+   }
+}
+
 /**
  * Fills a block entry with a value.  If the block or the entry do not
  * exist, the block / entry is created.
@@ -253,6 +566,8 @@ void GM2_slha_io::fill_block_entry(const std::string& block_name,
                                    unsigned entry, double value,
                                    const std::string& description)
 {
+   sync_data();
+
    auto block = data.find(block_name);
 
    if (block == data.cend()) {
@@ -261,7 +576,10 @@ void GM2_slha_io::fill_block_entry(const std::string& block_name,
       data.push_back(block);
    }
 
-   data[block_name][entry] = (FORMAT_ELEMENT(entry, value, description)).str();
+   char buf[max_entry_prefix_length];
+   const auto len = format_entry_prefix(buf, entry, value);
+
+   data[block_name][entry] = std::string(buf, len) + description + '\n';
 }
 
 /**
@@ -276,6 +594,8 @@ void GM2_slha_io::fill_block_entry(const std::string& block_name,
                                    unsigned entry,
                                    const std::string& description)
 {
+   sync_data();
+
    auto block = data.find(block_name);
 
    if (block == data.cend()) {
@@ -284,7 +604,47 @@ void GM2_slha_io::fill_block_entry(const std::string& block_name,
       data.push_front(block);
    }
 
-   data[block_name][entry] = (FORMAT_SPINFO(entry, description)).str();
+   char buf[max_entry_prefix_length];
+   const auto len = format_entry_prefix(buf, entry);
+
+   data[block_name][entry] = std::string(buf, len) + description + '\n';
+}
+
+/**
+ * Writes a block entry with a value to a stream, in the same format
+ * as fill_block_entry().
+ *
+ * @param ostr output stream
+ * @param entry number of the entry
+ * @param value value
+ * @param description comment
+ */
+void GM2_slha_io::write_block_entry(std::ostream& ostr, unsigned entry,
+                                    double value, const std::string& description)
+{
+   char buf[max_entry_prefix_length];
+   const auto len = format_entry_prefix(buf, entry, value);
+
+   ostr.write(buf, static_cast<std::streamsize>(len));
+   ostr << description << '\n';
+}
+
+/**
+ * Writes a block entry with a string to a stream, in the same format
+ * as fill_block_entry().
+ *
+ * @param ostr output stream
+ * @param entry number of the entry
+ * @param description comment
+ */
+void GM2_slha_io::write_block_entry(std::ostream& ostr, unsigned entry,
+                                    const std::string& description)
+{
+   char buf[max_entry_prefix_length];
+   const auto len = format_entry_prefix(buf, entry);
+
+   ostr.write(buf, static_cast<std::streamsize>(len));
+   ostr << description << '\n';
 }
 
 void GM2_slha_io::fill_from_msoft(MSSMNoFV_onshell& model) const
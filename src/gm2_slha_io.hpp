@@ -24,9 +24,14 @@
 #include "slhaea.h"
 
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <iosfwd>
+#include <limits>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include <Eigen/Core>
 
@@ -46,6 +51,16 @@ struct Mass_basis;
 /**
  * @class GM2_slha_io
  * @brief class for reading input files and writing SLHA output files
+ *
+ * The input is read once into a single character buffer, which is
+ * tokenized in place.  The tokens refer to positions in the buffer,
+ * such that no string is allocated per token.  The blocks are
+ * indexed by their (case-insensitive) name.
+ *
+ * The SLHAea document, which is used for the output, is built from
+ * the buffer only when an output function is called.  Entries
+ * written with fill_block_entry() are not visible to the reading
+ * functions.
  */
 class GM2_slha_io {
 public:
@@ -57,6 +72,7 @@ public:
    void read_from_file(const std::string&);
    void read_from_source(const std::string&);
    void read_from_stream(std::istream&);
+   void read_from_string(const std::string&);
    void read_block(const std::string&, const Tuple_processor&, double scale = 0) const;
    template <class Derived>
    void read_block(const std::string&, Eigen::MatrixBase<Derived>&, double scale = 0) const;
@@ -65,8 +81,11 @@ public:
    // writing functions
    void write_to_file(const std::string&);
    void write_to_stream(std::ostream&);
+   void write_input_to_stream(std::ostream&) const;
    void fill_block_entry(const std::string&, unsigned, double, const std::string&);
    void fill_block_entry(const std::string&, unsigned, const std::string&);
+   static void write_block_entry(std::ostream&, unsigned, double, const std::string&);
+   static void write_block_entry(std::ostream&, unsigned, const std::string&);
 
    /// read model parameters (GM2Calc input format)
    void fill_gm2calc(MSSMNoFV_onshell&) const;
@@ -87,26 +106,84 @@ public:
    void fill(Config_options&) const;
 
 private:
-   SLHAea::Coll data;          ///< SHLA data
-
-   /// convert string to number
+   /// token (field or comment) in the input buffer
+   struct Token {
+      std::size_t pos{0};        ///< position of the first character
+      std::size_t len{0};        ///< number of characters
+   };
+
+   /// block definition or data line in the input buffer
+   struct Line {
+      std::size_t first{0};      ///< index of the first token
+      std::size_t size{0};       ///< number of tokens (including comment)
+   };
+
+   /// scale definition of a block
+   enum class Scale_def { none, numeric, non_numeric };
+
+   /// block in the input buffer
+   struct Block {
+      std::size_t def{0};        ///< index of the block definition line
+      std::size_t end{0};        ///< index past the last data line
+      std::size_t next{npos};    ///< index of the next block with the same name
+      Scale_def scale_def{Scale_def::none}; ///< kind of scale definition
+      double scale{0.0};         ///< scale after Q=
+   };
+
+   /// case-insensitive hash of a block name
+   struct Name_hash {
+      std::size_t operator()(const std::string&) const;
+   };
+
+   /// case-insensitive comparison of block names
+   struct Name_equal {
+      bool operator()(const std::string&, const std::string&) const;
+   };
+
+   static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+   std::string buffer;         ///< input characters
+   std::vector<Token> tokens;  ///< tokens of the stored lines
+   std::vector<Line> lines;    ///< block definitions and data lines
+   std::vector<Block> blocks;  ///< blocks in the order of appearance
+   std::unordered_map<std::string, std::size_t, Name_hash, Name_equal> block_index; ///< block name -> first block
+   SLHAea::Coll data;          ///< SHLA output data
+   std::size_t data_size{0};   ///< number of input characters in data
+
+   /// append stream content to the buffer
+   void append(std::istream&);
+   /// tokenize the buffer, starting at the given position
+   void parse(std::size_t);
+   /// read the scale of a block
+   void read_block_scale(Block&);
+   /// add input characters, which are not yet in data, to data
+   void sync_data();
+   /// find first block with the given name
+   std::size_t find_block(const std::string&) const;
+   /// returns token of a line
+   const Token& field(const Line& line, std::size_t i) const { return tokens[line.first + i]; }
+   /// parse number
+   static bool parse_number(const char*, long long&);
+   /// parse number
+   static bool parse_number(const char*, double&);
+   /// convert token to number
    template <class Scalar>
-   static Scalar convert_to(const std::string&);
+   Scalar convert_to(const Token&) const;
    /// compare block scale
-   static bool is_at_scale(const SLHAea::Block&, double, double eps = 0.01);
+   bool is_at_scale(const Block&, double, double eps = 0.01) const;
    /// read scale from block
-   static double read_scale(const SLHAea::Block&);
+   double read_scale(const Block&) const;
    /// read block with tuple processor
-   static void read_block(const SLHAea::Block&, const Tuple_processor&);
+   void read_block(const Block&, const Tuple_processor&) const;
    /// read block into Eigen::MatrixBase
    template <class Derived>
-   static void read_block(const SLHAea::Block&, Eigen::MatrixBase<Derived>&);
+   void read_block(const Block&, Eigen::MatrixBase<Derived>&) const;
    /// read block into matrix
    template <class Derived>
-   static void read_matrix(const SLHAea::Block&, Eigen::MatrixBase<Derived>&);
+   void read_matrix(const Block&, Eigen::MatrixBase<Derived>&) const;
    /// read block into vector
    template <class Derived>
-   static void read_vector(const SLHAea::Block&, Eigen::MatrixBase<Derived>&);
+   void read_vector(const Block&, Eigen::MatrixBase<Derived>&) const;
 
    void fill_scale(MSSMNoFV_onshell&) const;
    void fill_alpha_from_gm2calcinput(MSSMNoFV_onshell&) const;
@@ -118,37 +195,32 @@ private:
    void fill_from_sminputs(MSSMNoFV_onshell&) const;
 };
 
+/**
+ * Converts the leading characters of a token to a number.  Like
+ * std::stoi() and std::stod(), trailing non-numeric characters are
+ * ignored.
+ *
+ * @param token token
+ *
+ * @return number
+ */
 template <class Scalar>
-Scalar GM2_slha_io::convert_to(const std::string& str)
+Scalar GM2_slha_io::convert_to(const Token& token) const
 {
-   Scalar value;
-   try {
-      if (std::is_same<Scalar, int>::value) {
-         value = std::stoi(str);
-      } else if (std::is_same<Scalar, long>::value) {
-         value = std::stol(str);
-      } else if (std::is_same<Scalar, long long>::value) {
-         value = std::stoll(str);
-      } else if (std::is_same<Scalar, unsigned long>::value) {
-         value = std::stoul(str);
-      } else if (std::is_same<Scalar, unsigned long long>::value) {
-         value = std::stoull(str);
-      } else if (std::is_same<Scalar, float>::value) {
-         value = std::stof(str);
-      } else if (std::is_same<Scalar, double>::value) {
-         value = std::stod(str);
-      } else if (std::is_same<Scalar, long double>::value) {
-         value = std::stold(str);
-      } else {
-         value = SLHAea::to<Scalar>(str);
-      }
-      if (!std::isfinite(static_cast<double>(value))) {
-         throw 1;
-      }
-   }  catch (...) {
+   static_assert(std::is_arithmetic<Scalar>::value, "Scalar must be an arithmetic type.");
+
+   using Number_t = typename std::conditional<
+      std::is_integral<Scalar>::value, long long, double>::type;
+
+   Number_t value{0};
+
+   if (!parse_number(buffer.c_str() + token.pos, value) ||
+       value < std::numeric_limits<Scalar>::lowest() ||
+       value > std::numeric_limits<Scalar>::max()) {
       throw EReadError("non-numeric input");
    }
-   return value;
+
+   return static_cast<Scalar>(value);
 }
 
 /**
@@ -158,19 +230,20 @@ Scalar GM2_slha_io::convert_to(const std::string& str)
  * @param matrix matrix to be filled
  */
 template <class Derived>
-void GM2_slha_io::read_matrix(const SLHAea::Block& block, Eigen::MatrixBase<Derived>& matrix)
+void GM2_slha_io::read_matrix(const Block& block, Eigen::MatrixBase<Derived>& matrix) const
 {
    using Index_t = Eigen::Index;
    static_assert(std::is_signed<Index_t>::value, "Eigen::Index must be a signed integer type.");
 
    const Index_t cols = matrix.cols(), rows = matrix.rows();
 
-   for (const auto& line : block) {
-      if (line.is_data_line() && line.size() >= 3) {
-         const Index_t i = convert_to<Index_t>(line[0]) - 1;
-         const Index_t k = convert_to<Index_t>(line[1]) - 1;
+   for (std::size_t l = block.def + 1; l < block.end; l++) {
+      const auto& line = lines[l];
+      if (line.size >= 3) {
+         const Index_t i = convert_to<Index_t>(field(line, 0)) - 1;
+         const Index_t k = convert_to<Index_t>(field(line, 1)) - 1;
          if (0 <= i && i < rows && 0 <= k && k < cols) {
-            matrix(i, k) = convert_to<double>(line[2]);
+            matrix(i, k) = convert_to<double>(field(line, 2));
          }
       }
    }
@@ -183,18 +256,19 @@ void GM2_slha_io::read_matrix(const SLHAea::Block& block, Eigen::MatrixBase<Deri
  * @param vector vector to be filled
  */
 template <class Derived>
-void GM2_slha_io::read_vector(const SLHAea::Block& block, Eigen::MatrixBase<Derived>& vector)
+void GM2_slha_io::read_vector(const Block& block, Eigen::MatrixBase<Derived>& vector) const
 {
    using Index_t = Eigen::Index;
    static_assert(std::is_signed<Index_t>::value, "Eigen::Index must be a signed integer type.");
 
    const Index_t rows = vector.rows();
 
-   for (const auto& line : block) {
-      if (line.is_data_line() && line.size() >= 2) {
-         const Index_t i = convert_to<Index_t>(line[0]) - 1;
+   for (std::size_t l = block.def + 1; l < block.end; l++) {
+      const auto& line = lines[l];
+      if (line.size >= 2) {
+         const Index_t i = convert_to<Index_t>(field(line, 0)) - 1;
          if (0 <= i && i < rows) {
-            vector(i) = convert_to<double>(line[1]);
+            vector(i) = convert_to<double>(field(line, 1));
          }
       }
    }
@@ -207,12 +281,12 @@ void GM2_slha_io::read_vector(const SLHAea::Block& block, Eigen::MatrixBase<Deri
  * @param matrix matrix to be filled
  */
 template <class Derived>
-void GM2_slha_io::read_block(const SLHAea::Block& block, Eigen::MatrixBase<Derived>& matrix)
+void GM2_slha_io::read_block(const Block& block, Eigen::MatrixBase<Derived>& matrix) const
 {
    if (matrix.cols() == 1) {
-      GM2_slha_io::read_vector(block, matrix);
+      read_vector(block, matrix);
    } else {
-      GM2_slha_io::read_matrix(block, matrix);
+      read_matrix(block, matrix);
    }
 }
 
@@ -228,15 +302,10 @@ void GM2_slha_io::read_block(const std::string& block_name,
                              Eigen::MatrixBase<Derived>& matrix,
                              double scale) const
 {
-   auto block = data.find(block_name);
-
-   while (block != data.cend()) {
-      if (is_at_scale(*block, scale)) {
-         GM2_slha_io::read_block(*block, matrix);
+   for (auto b = find_block(block_name); b != npos; b = blocks[b].next) {
+      if (is_at_scale(blocks[b], scale)) {
+         read_block(blocks[b], matrix);
       }
-
-      ++block;
-      block = data.find(block, data.end(), block_name);
    }
 }
 
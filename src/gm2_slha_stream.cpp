@@ -0,0 +1,249 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2_slha_stream.hpp"
+#include "gm2_slha_io.hpp"
+
+#include "gm2calc/gm2_error.hpp"
+
+#include <fstream>
+#include <iostream>
+
+namespace gm2calc {
+
+namespace {
+
+/// SLHA whitespace characters
+const char* const whitespace = " \t\v\f\r";
+
+/// SLHA whitespace characters and comment character
+const char* const field_delimiters = " \t\v\f\r#";
+
+/**
+ * Finds the next field (before a comment) of a line.
+ *
+ * @param line line
+ * @param first position of the first character of the field
+ * @param last on input: position to start the search at, on output:
+ * position past the last character of the field
+ *
+ * @return true if a field has been found, false otherwise
+ */
+bool next_field(const std::string& line, std::size_t& first, std::size_t& last)
+{
+   first = line.find_first_not_of(whitespace, last);
+
+   if (first == std::string::npos || line[first] == '#') {
+      return false;
+   }
+
+   last = line.find_first_of(field_delimiters, first);
+
+   if (last == std::string::npos) {
+      last = line.size();
+   }
+
+   return true;
+}
+
+/// case-insensitive comparison of a field with an upper-case word
+bool field_equals(const std::string& line, std::size_t first, std::size_t last,
+                  const char* word)
+{
+   for (std::size_t i = first; i < last; i++, word++) {
+      const char c = line[i];
+      const char upper = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+      if (*word == '\0' || upper != *word) {
+         return false;
+      }
+   }
+   return *word == '\0';
+}
+
+/**
+ * Checks whether a line is a block definition.
+ *
+ * @param line line
+ * @param name_first position of the first character of the block name
+ * @param name_last position past the last character of the block name
+ *
+ * @return true if the line is a block definition, false otherwise
+ */
+bool is_block_def(const std::string& line, std::size_t& name_first, std::size_t& name_last)
+{
+   std::size_t first = 0, last = 0;
+
+   if (!next_field(line, first, last) ||
+       !(field_equals(line, first, last, "BLOCK") ||
+         field_equals(line, first, last, "DECAY"))) {
+      return false;
+   }
+
+   name_last = last;
+
+   return next_field(line, name_first, name_last);
+}
+
+/// checks whether the line contains data, i.e. is neither empty nor a comment
+bool is_data(const std::string& line)
+{
+   const auto first = line.find_first_not_of(whitespace);
+
+   return first != std::string::npos && line[first] != '#';
+}
+
+/// returns the line without leading and trailing whitespace
+std::string trim(const std::string& str)
+{
+   const auto first = str.find_first_not_of(whitespace);
+
+   if (first == std::string::npos) {
+      return {};
+   }
+
+   const auto last = str.find_last_not_of(whitespace);
+
+   return str.substr(first, last - first + 1);
+}
+
+/// checks whether the line is equal to the (trimmed) separator
+bool is_separator(const std::string& line, const std::string& separator)
+{
+   if (separator.empty()) {
+      return false;
+   }
+
+   const auto first = line.find_first_not_of(whitespace);
+
+   if (first == std::string::npos) {
+      return false;
+   }
+
+   const auto last = line.find_last_not_of(whitespace);
+
+   return line.compare(first, last - first + 1, separator) == 0;
+}
+
+} // anonymous namespace
+
+/**
+ * Reads SLHA documents from the given source.
+ *
+ * @param source file name or - for stdin
+ * @param separator_ document separator line (empty if none)
+ */
+GM2_slha_stream::GM2_slha_stream(const std::string& source, const std::string& separator_)
+   : separator(trim(separator_))
+{
+   if (source == "-") {
+      istr = &std::cin;
+   } else {
+      file.reset(new std::ifstream(source));
+      if (!file->good()) {
+         throw EReadError("cannot read input file: \"" + source + "\"");
+      }
+      istr = file.get();
+   }
+}
+
+/**
+ * Reads SLHA documents from the given stream.
+ *
+ * @param istr_ input stream
+ * @param separator_ document separator line (empty if none)
+ */
+GM2_slha_stream::GM2_slha_stream(std::istream& istr_, const std::string& separator_)
+   : istr(&istr_), separator(trim(separator_))
+{
+}
+
+GM2_slha_stream::~GM2_slha_stream() = default;
+
+/**
+ * Reads the next document from the stream into the given SLHA i/o
+ * object.  The previous content of the SLHA i/o object is removed.
+ * Documents which do not contain any block are skipped.
+ *
+ * If the document contains data outside of a block, the whole
+ * document is skipped and an EReadError is thrown; the next call
+ * reads the following document.  If the input cannot be read, an
+ * EReadError is thrown and the stream ends.
+ *
+ * @param slha_io SLHA i/o object
+ *
+ * @return true if a document has been read, false at the end of the stream
+ */
+bool GM2_slha_stream::next(GM2_slha_io& slha_io)
+{
+   if (istr->bad()) {
+      return false;
+   }
+
+   document.clear();
+   bool have_block = false;
+   std::string error;
+
+   if (have_pending_line) {
+      document.append(line).push_back('\n');
+      have_pending_line = false;
+      have_block = true;
+   }
+
+   while (std::getline(*istr, line)) {
+      if (is_separator(line, separator)) {
+         if (have_block || !error.empty()) {
+            break;
+         }
+         document.clear();
+         continue;
+      }
+
+      std::size_t name_first = 0, name_last = 0;
+
+      if (is_block_def(line, name_first, name_last)) {
+         if (have_block && field_equals(line, name_first, name_last, "SPINFO")) {
+            have_pending_line = true;
+            break;
+         }
+         have_block = true;
+      } else if (!have_block && error.empty() && is_data(line)) {
+         error = "data outside of a block: \"" + trim(line) + "\"";
+      }
+
+      document.append(line).push_back('\n');
+   }
+
+   if (istr->bad()) {
+      throw EReadError("cannot read input");
+   }
+
+   if (!error.empty()) {
+      throw EReadError(error);
+   }
+
+   if (!have_block) {
+      return false;
+   }
+
+   slha_io.read_from_string(document);
+   number_of_documents++;
+
+   return true;
+}
+
+} // namespace gm2calc
@@ -0,0 +1,87 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_SLHA_STREAM_HPP
+#define GM2_SLHA_STREAM_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace gm2calc {
+
+class GM2_slha_io;
+
+/**
+ * @class GM2_slha_stream
+ * @brief reads a sequence of concatenated SLHA documents
+ *
+ * The documents are read one at a time with next(), such that only
+ * one document is held in memory.  A document ends
+ *
+ * - at a separator line (if a separator is given), i.e. a line which
+ *   is equal to the separator, up to leading and trailing whitespace,
+ *   or
+ *
+ * - before a definition of the block SPINFO, if the document already
+ *   contains a block.  (Spectrum generators write SPINFO as the first
+ *   block of each document.)
+ *
+ * Example:
+ * @code
+ * GM2_slha_stream stream("points.slha");
+ * GM2_slha_io slha_io;
+ *
+ * while (stream.next(slha_io)) {
+ *    MSSMNoFV_onshell model;
+ *    slha_io.fill_slha(model);
+ *    ...
+ * }
+ * @endcode
+ */
+class GM2_slha_stream {
+public:
+   /// read from the given source (file name or - for stdin)
+   explicit GM2_slha_stream(const std::string& source, const std::string& separator = "");
+   /// read from the given stream (must outlive this object)
+   explicit GM2_slha_stream(std::istream&, const std::string& separator = "");
+   GM2_slha_stream(const GM2_slha_stream&) = delete;
+   GM2_slha_stream(GM2_slha_stream&&) = delete;
+   ~GM2_slha_stream();
+   GM2_slha_stream& operator=(const GM2_slha_stream&) = delete;
+   GM2_slha_stream& operator=(GM2_slha_stream&&) = delete;
+
+   /// read the next document, returns false if there is none
+   bool next(GM2_slha_io&);
+   /// number of documents read so far
+   std::size_t get_number_of_documents() const { return number_of_documents; }
+
+private:
+   std::unique_ptr<std::istream> file;  ///< owned input file (if any)
+   std::istream* istr{nullptr};         ///< input stream
+   std::string separator;               ///< document separator line
+   std::string document;                ///< current document
+   std::string line;                    ///< current line
+   bool have_pending_line{false};       ///< line belongs to the next document
+   std::size_t number_of_documents{0};  ///< number of documents read
+};
+
+} // namespace gm2calc
+
+#endif
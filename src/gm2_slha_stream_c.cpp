@@ -0,0 +1,345 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_slha_stream.h"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/SM.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include "gm2_slha_io.hpp"
+#include "gm2_slha_stream.hpp"
+
+#include <complex>
+#include <string>
+
+/**
+ * @file gm2_slha_stream_c.cpp
+ * @brief contains definitions of C interface functions for reading
+ * a sequence of SLHA documents
+ */
+
+namespace gm2calc {
+namespace {
+
+/// stream of SLHA documents and the current document
+struct SLHA_stream_data {
+   SLHA_stream_data(const std::string& source, const std::string& separator)
+      : stream(source, separator)
+   {
+   }
+
+   GM2_slha_stream stream;
+   GM2_slha_io slha_io;
+};
+
+const GM2_slha_io& get_slha_io(const gm2calc_slha_stream* stream)
+{
+   return reinterpret_cast<const SLHA_stream_data*>(stream)->slha_io;
+}
+
+/**
+ * Calls the given function and translates exceptions into error
+ * codes.
+ *
+ * @param f function
+ *
+ * @return error code
+ */
+template <class F>
+gm2calc_error call_and_catch(F f)
+{
+   gm2calc_error error = gm2calc_NoError;
+
+   try {
+      f();
+   } catch (const gm2calc::EInvalidInput&) {
+      error = gm2calc_InvalidInput;
+   } catch (const gm2calc::EReadError&) {
+      error = gm2calc_InvalidInput;
+   } catch (const gm2calc::EPhysicalProblem&) {
+      error = gm2calc_PhysicalProblem;
+   } catch (...) {
+      error = gm2calc_UnknownError;
+   }
+
+   return error;
+}
+
+void convert_to_c(const gm2calc::SM& s, ::gm2calc_SM* sm)
+{
+   sm->alpha_em_0 = s.get_alpha_em_0();
+   sm->alpha_em_mz = s.get_alpha_em_mz();
+   sm->alpha_s_mz = s.get_alpha_s_mz();
+   sm->mh = s.get_mh();
+   sm->mw = s.get_mw();
+   sm->mz = s.get_mz();
+   for (int i = 0; i < 3; i++) {
+      sm->mu[i] = s.get_mu(i);
+      sm->md[i] = s.get_md(i);
+      sm->mv[i] = s.get_mv(i);
+      sm->ml[i] = s.get_ml(i);
+   }
+   for (int i = 0; i < 3; i++) {
+      for (int k = 0; k < 3; k++) {
+         sm->ckm_real[i][k] = std::real(s.get_ckm(i, k));
+         sm->ckm_imag[i][k] = std::imag(s.get_ckm(i, k));
+      }
+   }
+}
+
+template <class Basis, class C_basis>
+void convert_yukawa_couplings_to_c(const Basis& b, C_basis* basis)
+{
+   basis->yukawa_type = static_cast<gm2calc_THDM_yukawa_type>(b.yukawa_type);
+   basis->tan_beta = b.tan_beta;
+   basis->m122 = b.m122;
+   basis->zeta_u = b.zeta_u;
+   basis->zeta_d = b.zeta_d;
+   basis->zeta_l = b.zeta_l;
+   for (int i = 0; i < 3; i++) {
+      for (int k = 0; k < 3; k++) {
+         basis->Delta_u[i][k] = b.Delta_u(i, k);
+         basis->Delta_d[i][k] = b.Delta_d(i, k);
+         basis->Delta_l[i][k] = b.Delta_l(i, k);
+         basis->Pi_u[i][k] = b.Pi_u(i, k);
+         basis->Pi_d[i][k] = b.Pi_d(i, k);
+         basis->Pi_l[i][k] = b.Pi_l(i, k);
+      }
+   }
+}
+
+void convert_to_c(const gm2calc::thdm::Gauge_basis& b, gm2calc_THDM_gauge_basis* basis)
+{
+   convert_yukawa_couplings_to_c(b, basis);
+   for (int i = 0; i < 7; i++) {
+      basis->lambda[i] = b.lambda(i);
+   }
+}
+
+void convert_to_c(const gm2calc::thdm::Mass_basis& b, gm2calc_THDM_mass_basis* basis)
+{
+   convert_yukawa_couplings_to_c(b, basis);
+   basis->mh = b.mh;
+   basis->mH = b.mH;
+   basis->mA = b.mA;
+   basis->mHp = b.mHp;
+   basis->sin_beta_minus_alpha = b.sin_beta_minus_alpha;
+   basis->lambda_6 = b.lambda_6;
+   basis->lambda_7 = b.lambda_7;
+}
+
+} // anonymous namespace
+} // namespace gm2calc
+
+extern "C"
+{
+
+/**
+ * @brief Opens a stream of SLHA documents.
+ *
+ * The stream should be deleted with gm2calc_slha_stream_free() .
+ *
+ * @param stream pointer to the stream object
+ * @param source file name (or "-" for stdin)
+ * @param separator document separator line (or NULL if none)
+ *
+ * @return error code
+ */
+gm2calc_error gm2calc_slha_stream_open(
+   gm2calc_slha_stream** stream, const char* source, const char* separator)
+{
+   if (stream == nullptr || source == nullptr) {
+      return gm2calc_InvalidInput;
+   }
+
+   *stream = nullptr;
+
+   return gm2calc::call_and_catch([&] {
+      *stream = reinterpret_cast<gm2calc_slha_stream*>(
+         new gm2calc::SLHA_stream_data(source, separator ? separator : ""));
+   });
+}
+
+/**
+ * @brief Deletes a stream of SLHA documents.
+ *
+ * @param stream pointer to the stream object
+ */
+void gm2calc_slha_stream_free(gm2calc_slha_stream* stream)
+{
+   delete reinterpret_cast<gm2calc::SLHA_stream_data*>(stream);
+}
+
+/**
+ * @brief Reads the next SLHA document from the stream.
+ *
+ * If the document cannot be read (e.g. because it contains data
+ * outside of a block), -1 is returned and the next call reads the
+ * following document.  If the input cannot be read, -1 is returned
+ * and the stream ends.
+ *
+ * @param stream pointer to the stream object
+ *
+ * @return 1 if a document has been read, 0 at the end of the stream,
+ * -1 on error
+ */
+int gm2calc_slha_stream_next(gm2calc_slha_stream* stream)
+{
+   if (stream == nullptr) {
+      return -1;
+   }
+
+   auto data = reinterpret_cast<gm2calc::SLHA_stream_data*>(stream);
+   bool have_document = false;
+
+   const gm2calc_error error = gm2calc::call_and_catch([&] {
+      have_document = data->stream.next(data->slha_io);
+   });
+
+   if (error != gm2calc_NoError) {
+      return -1;
+   }
+
+   return have_document ? 1 : 0;
+}
+
+/**
+ * @brief Reads MSSMNoFV parameters in SLHA format from the current
+ * document.
+ *
+ * The parameters must be converted to the on-shell scheme with
+ * gm2calc_mssmnofv_convert_to_onshell() afterwards.
+ *
+ * @param stream pointer to the stream object
+ * @param model pointer to the model object
+ *
+ * @return error code
+ */
+gm2calc_error gm2calc_slha_stream_fill_mssmnofv_slha(
+   const gm2calc_slha_stream* stream, MSSMNoFV_onshell* model)
+{
+   if (stream == nullptr || model == nullptr) {
+      return gm2calc_InvalidInput;
+   }
+
+   return gm2calc::call_and_catch([&] {
+      gm2calc::get_slha_io(stream).fill_slha(
+         *reinterpret_cast<gm2calc::MSSMNoFV_onshell*>(model));
+   });
+}
+
+/**
+ * @brief Reads MSSMNoFV parameters in GM2Calc format from the
+ * current document.
+ *
+ * The masses must be calculated with
+ * gm2calc_mssmnofv_calculate_masses() afterwards.
+ *
+ * @param stream pointer to the stream object
+ * @param model pointer to the model object
+ *
+ * @return error code
+ */
+gm2calc_error gm2calc_slha_stream_fill_mssmnofv_gm2calc(
+   const gm2calc_slha_stream* stream, MSSMNoFV_onshell* model)
+{
+   if (stream == nullptr || model == nullptr) {
+      return gm2calc_InvalidInput;
+   }
+
+   return gm2calc::call_and_catch([&] {
+      gm2calc::get_slha_io(stream).fill_gm2calc(
+         *reinterpret_cast<gm2calc::MSSMNoFV_onshell*>(model));
+   });
+}
+
+/**
+ * @brief Reads SM parameters from the current document.
+ *
+ * Parameters which are not given in the document are set to their
+ * default values.
+ *
+ * @param stream pointer to the stream object
+ * @param sm pointer to the SM parameters
+ *
+ * @return error code
+ */
+gm2calc_error gm2calc_slha_stream_fill_sm(
+   const gm2calc_slha_stream* stream, ::gm2calc_SM* sm)
+{
+   if (stream == nullptr || sm == nullptr) {
+      return gm2calc_InvalidInput;
+   }
+
+   return gm2calc::call_and_catch([&] {
+      gm2calc::SM s;
+      gm2calc::get_slha_io(stream).fill(s);
+      gm2calc::convert_to_c(s, sm);
+   });
+}
+
+/**
+ * @brief Reads THDM gauge basis parameters from the current document.
+ *
+ * Parameters which are not given in the document are set to zero.
+ *
+ * @param stream pointer to the stream object
+ * @param basis pointer to the gauge basis parameters
+ *
+ * @return error code
+ */
+gm2calc_error gm2calc_slha_stream_fill_thdm_gauge_basis(
+   const gm2calc_slha_stream* stream, gm2calc_THDM_gauge_basis* basis)
+{
+   if (stream == nullptr || basis == nullptr) {
+      return gm2calc_InvalidInput;
+   }
+
+   return gm2calc::call_and_catch([&] {
+      gm2calc::thdm::Gauge_basis b;
+      gm2calc::get_slha_io(stream).fill(b);
+      gm2calc::convert_to_c(b, basis);
+   });
+}
+
+/**
+ * @brief Reads THDM mass basis parameters from the current document.
+ *
+ * Parameters which are not given in the document are set to zero.
+ *
+ * @param stream pointer to the stream object
+ * @param basis pointer to the mass basis parameters
+ *
+ * @return error code
+ */
+gm2calc_error gm2calc_slha_stream_fill_thdm_mass_basis(
+   const gm2calc_slha_stream* stream, gm2calc_THDM_mass_basis* basis)
+{
+   if (stream == nullptr || basis == nullptr) {
+      return gm2calc_InvalidInput;
+   }
+
+   return gm2calc::call_and_catch([&] {
+      gm2calc::thdm::Mass_basis b;
+      gm2calc::get_slha_io(stream).fill(b);
+      gm2calc::convert_to_c(b, basis);
+   });
+}
+
+} /* extern "C" */
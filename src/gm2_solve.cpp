@@ -0,0 +1,247 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2calc/gm2_solve.hpp"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/MSSMNoFV_onshell_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/math/tools/roots.hpp>
+
+namespace gm2calc {
+
+namespace {
+
+/// a_mu - target, records the evaluated points
+class Difference {
+public:
+   Difference(const Solve_function& amu_, double target_)
+      : amu(amu_), target(target_) {}
+
+   double operator()(double x)
+   {
+      const double a = amu(x);
+      if (!std::isfinite(a)) {
+         throw EPhysicalProblem("a_mu is not finite at x = " + std::to_string(x));
+      }
+      points.emplace_back(x, a);
+      return a - target;
+   }
+
+   /// returns the evaluated point closest to x
+   const std::pair<double,double>& find(double x) const
+   {
+      return *std::min_element(
+         points.cbegin(), points.cend(),
+         [x] (const std::pair<double,double>& a, const std::pair<double,double>& b) {
+            return std::abs(a.first - x) < std::abs(b.first - x);
+         });
+   }
+
+   unsigned get_number_of_evaluations() const { return points.size(); }
+
+private:
+   const Solve_function& amu;
+   double target{0.0};
+   std::vector<std::pair<double,double>> points; ///< evaluated points (x, a_mu)
+};
+
+void check(double x_min, double x_max, const Solve_options& options)
+{
+   if (!(x_min < x_max)) {
+      throw EInvalidInput("bracket [" + std::to_string(x_min) + ", "
+                          + std::to_string(x_max) + "] must not be empty");
+   }
+   if (!(options.rel_tolerance > 0) && !(options.abs_tolerance > 0)) {
+      throw EInvalidInput("tolerance must be positive");
+   }
+   if (options.max_iterations < 1) {
+      throw EInvalidInput("maximum number of iterations must be positive");
+   }
+}
+
+} // anonymous namespace
+
+/**
+ * Finds the value x of a parameter in the bracket [x_min, x_max],
+ * for which amu(x) = target.  The root is determined with the
+ * TOMS 748 algorithm (Alefeld, Potra and Shi), which, like Brent's
+ * method, combines inverse cubic/quadratic interpolation with
+ * bisection steps and converges superlinearly for smooth functions.
+ * The two ends of the bracket are evaluated first and a_mu - target
+ * must have a different sign at them.
+ *
+ * If the tolerance has not been reached after the maximum number of
+ * iterations, the best point found so far is returned and the flag
+ * converged of the result is false.
+ *
+ * @param amu a_mu as a function of the parameter
+ * @param target target value of a_mu
+ * @param x_min lower end of the bracket
+ * @param x_max upper end of the bracket
+ * @param options options of the root finder
+ *
+ * @return parameter value, a_mu, final bracket, number of iterations
+ * and evaluations and the elapsed time
+ *
+ * @throw EInvalidInput if the bracket is empty or if a_mu - target
+ * does not change its sign in the bracket
+ * @throw EPhysicalProblem if a_mu is not finite
+ */
+Solve_result solve_for_parameter(const Solve_function& amu, double target,
+                                 double x_min, double x_max,
+                                 const Solve_options& options)
+{
+   check(x_min, x_max, options);
+
+   const auto start = std::chrono::steady_clock::now();
+
+   Difference diff(amu, target);
+   const double f_min = diff(x_min);
+   const double f_max = diff(x_max);
+
+   if (f_min*f_max > 0) {
+      throw EInvalidInput("a_mu - target does not change its sign in the bracket ["
+                          + std::to_string(x_min) + ", " + std::to_string(x_max) + "]");
+   }
+
+   const double rel_tol = options.rel_tolerance;
+   const double abs_tol = options.abs_tolerance;
+   const auto stop_crit = [rel_tol, abs_tol] (double a, double b) {
+      return std::abs(a - b) <= abs_tol + rel_tol*std::max(std::abs(a), std::abs(b));
+   };
+
+   boost::uintmax_t it = options.max_iterations;
+   std::pair<double,double> bracket(x_min, x_max);
+
+   if (f_min == 0) {
+      bracket = std::make_pair(x_min, x_min);
+      it = 0;
+   } else if (f_max == 0) {
+      bracket = std::make_pair(x_max, x_max);
+      it = 0;
+   } else {
+      bracket = boost::math::tools::toms748_solve(
+         std::ref(diff), x_min, x_max, f_min, f_max, stop_crit, it);
+   }
+
+   // return the end of the final bracket closer to the target
+   const auto& lo = diff.find(bracket.first);
+   const auto& hi = diff.find(bracket.second);
+   const auto& best = std::abs(lo.second - target) <= std::abs(hi.second - target) ? lo : hi;
+
+   Solve_result result;
+   result.value = best.first;
+   result.amu = best.second;
+   result.lower = bracket.first;
+   result.upper = bracket.second;
+   result.iterations = static_cast<unsigned>(it);
+   result.evaluations = diff.get_number_of_evaluations();
+   result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   result.converged = stop_crit(bracket.first, bracket.second);
+
+   return result;
+}
+
+/**
+ * Finds the value of a parameter of the THDM in the bracket
+ * [x_min, x_max], for which a_mu(1-loop + 2-loop) = target.  For each
+ * evaluation the setter is applied to a copy of the given mass basis
+ * parameters, before the model is constructed.
+ *
+ * @param basis THDM parameters
+ * @param setter function which sets the parameter
+ * @param target target value of a_mu
+ * @param x_min lower end of the bracket
+ * @param x_max upper end of the bracket
+ * @param options options of the root finder
+ * @param sm Standard Model parameters
+ * @param config THDM configuration
+ *
+ * @return see solve_for_parameter(const Solve_function&, ...)
+ */
+Solve_result solve_for_parameter(const thdm::Mass_basis& basis, const THDM_setter& setter,
+                                 double target, double x_min, double x_max,
+                                 const Solve_options& options, const SM& sm,
+                                 const thdm::Config& config)
+{
+   thdm::Mass_basis b(basis);
+
+   const auto amu = [&] (double x) {
+      b = basis;
+      setter(b, x);
+      const THDM model(b, sm, config);
+      return calculate_amu_1loop(model) + calculate_amu_2loop(model);
+   };
+
+   return solve_for_parameter(amu, target, x_min, x_max, options);
+}
+
+/**
+ * Finds the value of a parameter of the MSSMNoFV in the bracket
+ * [x_min, x_max], for which a_mu(1-loop + 2-loop) = target.
+ *
+ * For each evaluation a model is borrowed from the thread-local
+ * model pool (see MSSMNoFV_onshell_pool), the parameters of the given
+ * model are assigned to it and the setter is applied.  Afterwards,
+ * the mass spectrum is calculated from the on-shell parameters with
+ * MSSMNoFV_onshell::calculate_masses() or, if
+ * options.convert_to_onshell is true, the DR-bar parameters are
+ * converted to the on-shell scheme with
+ * MSSMNoFV_onshell::convert_to_onshell().
+ *
+ * @param model MSSMNoFV parameters
+ * @param setter function which sets the parameter
+ * @param target target value of a_mu
+ * @param x_min lower end of the bracket
+ * @param x_max upper end of the bracket
+ * @param options options of the root finder
+ *
+ * @return see solve_for_parameter(const Solve_function&, ...)
+ */
+Solve_result solve_for_parameter(const MSSMNoFV_onshell& model, const MSSMNoFV_setter& setter,
+                                 double target, double x_min, double x_max,
+                                 const Solve_options& options)
+{
+   auto& pool = MSSMNoFV_onshell_pool::thread_local_instance();
+
+   const auto amu = [&] (double x) {
+      auto m = pool.acquire(model);
+      setter(*m, x);
+      if (options.convert_to_onshell) {
+         m->convert_to_onshell(options.onshell_precision);
+      } else {
+         m->calculate_masses();
+      }
+      return calculate_amu_1loop(*m) + calculate_amu_2loop(*m);
+   };
+
+   return solve_for_parameter(amu, target, x_min, x_max, options);
+}
+
+} // namespace gm2calc
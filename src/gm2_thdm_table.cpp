@@ -0,0 +1,421 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#include "gm2_thdm_table.hpp"
+
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace gm2calc {
+
+namespace {
+
+/// whitespace characters
+const char* const whitespace = " \t\v\f\r";
+
+/// names of the columns which exist only in the mass basis
+const char* const mass_basis_columns[] = {
+   "mh", "mH", "mA", "mHp", "sin_beta_minus_alpha"
+};
+
+/// names of the columns which exist only in the gauge basis
+const char* const gauge_basis_columns[] = {
+   "lambda_1", "lambda_2", "lambda_3", "lambda_4", "lambda_5"
+};
+
+/// returns the string without leading and trailing whitespace
+std::string trim(const std::string& str)
+{
+   const auto first = str.find_first_not_of(whitespace);
+
+   if (first == std::string::npos) {
+      return {};
+   }
+
+   const auto last = str.find_last_not_of(whitespace);
+
+   return str.substr(first, last - first + 1);
+}
+
+/// checks whether the line is empty or a comment
+bool is_empty_or_comment(const std::string& line)
+{
+   const auto first = line.find_first_not_of(whitespace);
+   return first == std::string::npos || line[first] == '#';
+}
+
+/**
+ * Splits a line into fields.  If the delimiter is '\0', the fields
+ * are separated by whitespace.
+ *
+ * @param line line
+ * @param delimiter delimiter
+ * @param fields fields (without leading and trailing whitespace)
+ */
+void split(const std::string& line, char delimiter, std::vector<std::string>& fields)
+{
+   fields.clear();
+
+   if (delimiter == '\0') {
+      std::size_t last = 0;
+      while (true) {
+         const auto first = line.find_first_not_of(whitespace, last);
+         if (first == std::string::npos) {
+            break;
+         }
+         last = std::min(line.find_first_of(whitespace, first), line.size());
+         fields.push_back(line.substr(first, last - first));
+      }
+   } else {
+      std::size_t first = 0;
+      while (true) {
+         const auto last = line.find(delimiter, first);
+         fields.push_back(trim(line.substr(first, last - first)));
+         if (last == std::string::npos) {
+            break;
+         }
+         first = last + 1;
+      }
+   }
+}
+
+bool contains(const std::vector<std::string>& names, const char* name)
+{
+   return std::find(names.cbegin(), names.cend(), name) != names.cend();
+}
+
+int read_yukawa_type(double value)
+{
+   double intpart{0.0};
+   if (std::modf(value, &intpart) != 0.0) {
+      throw EInvalidInput("Yukawa type is not an integer");
+   }
+   return static_cast<int>(value);
+}
+
+/**
+ * Returns the setter of a field, which exists in both bases.
+ *
+ * @param name column name
+ *
+ * @return setter (empty if there is no such field)
+ */
+template <class T>
+std::function<void(T&, double)> find_common_setter(const std::string& name)
+{
+   using Matrix = Eigen::Matrix<double,3,3>;
+
+   if (name == "yukawa_type") {
+      return [] (T& b, double v) { b.yukawa_type = thdm::int_to_cpp_yukawa_type(read_yukawa_type(v)); };
+   } else if (name == "tan_beta") {
+      return [] (T& b, double v) { b.tan_beta = v; };
+   } else if (name == "m122") {
+      return [] (T& b, double v) { b.m122 = v; };
+   } else if (name == "zeta_u") {
+      return [] (T& b, double v) { b.zeta_u = v; };
+   } else if (name == "zeta_d") {
+      return [] (T& b, double v) { b.zeta_d = v; };
+   } else if (name == "zeta_l") {
+      return [] (T& b, double v) { b.zeta_l = v; };
+   }
+
+   // matrix entries, e.g. Delta_u_12
+   static const struct {
+      const char* prefix;
+      Matrix T::* matrix;
+   } matrices[] = {
+      {"Delta_u_", &T::Delta_u}, {"Delta_d_", &T::Delta_d}, {"Delta_l_", &T::Delta_l},
+      {"Pi_u_"   , &T::Pi_u   }, {"Pi_d_"   , &T::Pi_d   }, {"Pi_l_"   , &T::Pi_l   },
+   };
+
+   for (const auto& m: matrices) {
+      const std::string prefix(m.prefix);
+      if (name.size() == prefix.size() + 2 && name.compare(0, prefix.size(), prefix) == 0) {
+         const int i = name[prefix.size()] - '1';
+         const int k = name[prefix.size() + 1] - '1';
+         if (i >= 0 && i < 3 && k >= 0 && k < 3) {
+            const auto matrix = m.matrix;
+            return [matrix, i, k] (T& b, double v) { (b.*matrix)(i, k) = v; };
+         }
+      }
+   }
+
+   return nullptr;
+}
+
+/// returns the setter of a field of the mass basis
+std::function<void(thdm::Mass_basis&, double)> find_setter(
+   const std::string& name, const thdm::Mass_basis*)
+{
+   using B = thdm::Mass_basis;
+
+   if (name == "mh") {
+      return [] (B& b, double v) { b.mh = v; };
+   } else if (name == "mH") {
+      return [] (B& b, double v) { b.mH = v; };
+   } else if (name == "mA") {
+      return [] (B& b, double v) { b.mA = v; };
+   } else if (name == "mHp") {
+      return [] (B& b, double v) { b.mHp = v; };
+   } else if (name == "sin_beta_minus_alpha") {
+      return [] (B& b, double v) { b.sin_beta_minus_alpha = v; };
+   } else if (name == "lambda_6") {
+      return [] (B& b, double v) { b.lambda_6 = v; };
+   } else if (name == "lambda_7") {
+      return [] (B& b, double v) { b.lambda_7 = v; };
+   }
+
+   return find_common_setter<B>(name);
+}
+
+/// returns the setter of a field of the gauge basis
+std::function<void(thdm::Gauge_basis&, double)> find_setter(
+   const std::string& name, const thdm::Gauge_basis*)
+{
+   using B = thdm::Gauge_basis;
+
+   if (name.size() == 8 && name.compare(0, 7, "lambda_") == 0 &&
+       name[7] >= '1' && name[7] <= '7') {
+      const int i = name[7] - '1';
+      return [i] (B& b, double v) { b.lambda(i) = v; };
+   }
+
+   return find_common_setter<B>(name);
+}
+
+/// returns the setters of the given columns
+template <class T>
+std::vector<std::function<void(T&, double)>> find_setters(
+   const std::vector<std::string>& names)
+{
+   std::vector<std::function<void(T&, double)>> setters;
+   setters.reserve(names.size());
+
+   for (std::size_t i = 0; i < names.size(); i++) {
+      auto setter = find_setter(names[i], static_cast<const T*>(nullptr));
+      if (!setter) {
+         throw EInvalidInput("unknown column \"" + names[i] + "\" in THDM table header");
+      }
+      if (std::find(names.cbegin(), names.cbegin() + i, names[i]) != names.cbegin() + i) {
+         throw EInvalidInput("duplicate column \"" + names[i] + "\" in THDM table header");
+      }
+      setters.push_back(std::move(setter));
+   }
+
+   return setters;
+}
+
+} // anonymous namespace
+
+/**
+ * Returns the setter of a field of the mass basis, given by its
+ * column name in a THDM table.
+ *
+ * @param name column name
+ *
+ * @return setter (empty if there is no such field)
+ */
+std::function<void(thdm::Mass_basis&, double)> find_thdm_mass_basis_setter(const std::string& name)
+{
+   return find_setter(name, static_cast<const thdm::Mass_basis*>(nullptr));
+}
+
+/**
+ * Reads THDM parameter points from the given source.
+ *
+ * @param source file name or - for stdin
+ */
+GM2_thdm_table::GM2_thdm_table(const std::string& source)
+{
+   if (source == "-") {
+      istr = &std::cin;
+   } else {
+      file.reset(new std::ifstream(source));
+      if (!file->good()) {
+         throw EReadError("cannot read input file: \"" + source + "\"");
+      }
+      istr = file.get();
+   }
+
+   read_header();
+}
+
+/**
+ * Reads THDM parameter points from the given stream.
+ *
+ * @param istr_ input stream
+ */
+GM2_thdm_table::GM2_thdm_table(std::istream& istr_)
+   : istr(&istr_)
+{
+   read_header();
+}
+
+GM2_thdm_table::~GM2_thdm_table() = default;
+
+/**
+ * Reads the header and determines the delimiter, the basis and the
+ * setters of the columns.
+ */
+void GM2_thdm_table::read_header()
+{
+   do {
+      if (!std::getline(*istr, line)) {
+         throw EReadError("THDM table has no header");
+      }
+      line_number++;
+   } while (is_empty_or_comment(line));
+
+   if (line.find('\t') != std::string::npos) {
+      delimiter = '\t';
+   } else if (line.find(',') != std::string::npos) {
+      delimiter = ',';
+   } else {
+      delimiter = '\0';
+   }
+
+   split(line, delimiter, column_names);
+
+   const auto has_any_of = [this] (const char* const* first, const char* const* last) {
+      return std::any_of(first, last, [this] (const char* n) { return contains(column_names, n); });
+   };
+
+   const bool is_mass = has_any_of(std::begin(mass_basis_columns), std::end(mass_basis_columns));
+   const bool is_gauge = has_any_of(std::begin(gauge_basis_columns), std::end(gauge_basis_columns));
+
+   if (is_mass == is_gauge) {
+      throw EInvalidInput("Cannot distinguish between mass and gauge basis.");
+   }
+
+   if (is_mass) {
+      basis = Basis::Mass;
+      mass_setters = find_setters<thdm::Mass_basis>(column_names);
+   } else {
+      basis = Basis::Gauge;
+      gauge_setters = find_setters<thdm::Gauge_basis>(column_names);
+   }
+}
+
+/**
+ * Reads the next line, which is neither empty nor a comment, and
+ * splits it into fields.
+ *
+ * @return false if there is no such line
+ */
+bool GM2_thdm_table::read_fields()
+{
+   do {
+      if (!std::getline(*istr, line)) {
+         return false;
+      }
+      line_number++;
+   } while (is_empty_or_comment(line));
+
+   split(line, delimiter, fields);
+
+   return true;
+}
+
+/**
+ * Reads the next row and sets the fields of the basis.  Fields which
+ * are not given in the table are set to their default values.
+ *
+ * @param b basis
+ * @param setters setters of the columns
+ *
+ * @return false if there is no row
+ */
+template <class T>
+bool GM2_thdm_table::read_row(T& b, const std::vector<Setter<T>>& setters)
+{
+   if (!read_fields()) {
+      return false;
+   }
+
+   // error message prefix, only built if an error occurs
+   const auto where = [this] () {
+      return "line " + std::to_string(line_number) + " of THDM table: ";
+   };
+
+   if (fields.size() != setters.size()) {
+      throw EReadError(where() + "expected " + std::to_string(setters.size()) +
+                       " fields, found " + std::to_string(fields.size()));
+   }
+
+   b = T{};
+
+   for (std::size_t i = 0; i < fields.size(); i++) {
+      const char* str = fields[i].c_str();
+      char* end = nullptr;
+      const double value = std::strtod(str, &end);
+
+      if (end == str || *end != '\0') {
+         throw EReadError(where() + "invalid value \"" + fields[i] +
+                          "\" in column \"" + column_names[i] + "\"");
+      }
+
+      try {
+         setters[i](b, value);
+      } catch (const Error& e) {
+         throw EReadError(where() + e.what());
+      }
+   }
+
+   return true;
+}
+
+/**
+ * Reads the next row of a table in the mass basis.
+ *
+ * @param b mass basis parameters
+ *
+ * @return false if there is no row
+ */
+bool GM2_thdm_table::next(thdm::Mass_basis& b)
+{
+   if (basis != Basis::Mass) {
+      throw ESetupError("THDM table is not given in the mass basis");
+   }
+
+   return read_row(b, mass_setters);
+}
+
+/**
+ * Reads the next row of a table in the gauge basis.
+ *
+ * @param b gauge basis parameters
+ *
+ * @return false if there is no row
+ */
+bool GM2_thdm_table::next(thdm::Gauge_basis& b)
+{
+   if (basis != Basis::Gauge) {
+      throw ESetupError("THDM table is not given in the gauge basis");
+   }
+
+   return read_row(b, gauge_setters);
+}
+
+} // namespace gm2calc
@@ -0,0 +1,123 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+#ifndef GM2_THDM_TABLE_HPP
+#define GM2_THDM_TABLE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gm2calc {
+
+namespace thdm {
+struct Gauge_basis;
+struct Mass_basis;
+}
+
+/**
+ * @class GM2_thdm_table
+ * @brief reads THDM parameter points from a table (CSV, TSV or
+ * whitespace-separated)
+ *
+ * The first line, which is neither empty nor a comment (starting with
+ * `#'), is the header.  It contains the names of the columns, which
+ * are the names of the fields of thdm::Mass_basis or
+ * thdm::Gauge_basis:
+ *
+ * - mass basis: mh, mH, mA, mHp, sin_beta_minus_alpha, lambda_6,
+ *   lambda_7
+ * - gauge basis: lambda_1, ..., lambda_7
+ * - both bases: yukawa_type (1,...,6), tan_beta, m122, zeta_u,
+ *   zeta_d, zeta_l, Delta_u_ij, Delta_d_ij, Delta_l_ij, Pi_u_ij,
+ *   Pi_d_ij, Pi_l_ij (i,j = 1,2,3)
+ *
+ * The basis is determined from the header.  Fields which are not
+ * given in the table are set to their default values.  The columns
+ * are separated by tabs if the header contains a tab, by commas if
+ * the header contains a comma and by whitespace otherwise.
+ *
+ * The rows are read one at a time with next().
+ *
+ * Example:
+ * @code
+ * GM2_thdm_table table("points.csv");
+ * thdm::Mass_basis basis;
+ *
+ * while (table.next(basis)) {
+ *    THDM model(basis);
+ *    ...
+ * }
+ * @endcode
+ */
+class GM2_thdm_table {
+public:
+   enum class Basis { Mass, Gauge };
+
+   /// read from the given source (file name or - for stdin)
+   explicit GM2_thdm_table(const std::string& source);
+   /// read from the given stream (must outlive this object)
+   explicit GM2_thdm_table(std::istream&);
+   GM2_thdm_table(const GM2_thdm_table&) = delete;
+   GM2_thdm_table(GM2_thdm_table&&) = delete;
+   ~GM2_thdm_table();
+   GM2_thdm_table& operator=(const GM2_thdm_table&) = delete;
+   GM2_thdm_table& operator=(GM2_thdm_table&&) = delete;
+
+   /// basis of the parameter points
+   Basis get_basis() const { return basis; }
+   /// column names
+   const std::vector<std::string>& get_column_names() const { return column_names; }
+   /// line number of the last row read
+   std::size_t get_line_number() const { return line_number; }
+
+   /// read the next row, returns false if there is none
+   bool next(thdm::Mass_basis&);
+   /// read the next row, returns false if there is none
+   bool next(thdm::Gauge_basis&);
+
+private:
+   template <class T>
+   using Setter = std::function<void(T&, double)>;
+
+   std::unique_ptr<std::istream> file;         ///< owned input file (if any)
+   std::istream* istr{nullptr};                ///< input stream
+   char delimiter{'\0'};                       ///< column delimiter ('\0' = whitespace)
+   Basis basis{Basis::Mass};                   ///< basis
+   std::vector<std::string> column_names;      ///< column names
+   std::vector<Setter<thdm::Mass_basis>> mass_setters;   ///< setters (mass basis)
+   std::vector<Setter<thdm::Gauge_basis>> gauge_setters; ///< setters (gauge basis)
+   std::vector<std::string> fields;            ///< fields of the current line
+   std::string line;                           ///< current line
+   std::size_t line_number{0};                 ///< current line number
+
+   void read_header();
+   bool read_fields();
+   template <class T>
+   bool read_row(T&, const std::vector<Setter<T>>&);
+};
+
+/// returns the setter of a field of thdm::Mass_basis (empty if there is no such field)
+std::function<void(thdm::Mass_basis&, double)> find_thdm_mass_basis_setter(const std::string&);
+
+} // namespace gm2calc
+
+#endif
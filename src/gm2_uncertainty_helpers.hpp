@@ -22,6 +22,7 @@
 namespace gm2calc {
 
 class MSSMNoFV_onshell;
+struct MSSMNoFV_amu_parameters;
 class THDM;
 
 /// calculates uncertainty for amu(0-loop)
@@ -35,9 +36,11 @@ double calculate_uncertainty_amu_2loop(const THDM& /* model */, double /* amu_1L
 
 /// calculates uncertainty for amu(0-loop) w/ tan(beta) resummation
 double calculate_uncertainty_amu_0loop(const MSSMNoFV_onshell& /* model */, double /* amu_1L*/);
+double calculate_uncertainty_amu_0loop(const MSSMNoFV_amu_parameters& /* pars */, double /* amu_1L*/);
 
 /// calculates uncertainty for amu(1-loop) w/ tan(beta) resummation
 double calculate_uncertainty_amu_1loop(const MSSMNoFV_onshell& /* model */, double /* amu_2L */);
+double calculate_uncertainty_amu_1loop(const MSSMNoFV_amu_parameters& /* pars */, double /* amu_2L */);
 
 } // namespace gm2calc
 
@@ -18,25 +18,40 @@
 
 #include "gm2calc/gm2_1loop.hpp"
 #include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_batch.hpp"
 #include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_profile.hpp"
+#include "gm2calc/gm2_result_file.hpp"
 #include "gm2calc/gm2_uncertainty.hpp"
 #include "gm2calc/gm2_version.h"
 #include "gm2calc/MSSMNoFV_onshell.hpp"
 #include "gm2calc/THDM.hpp"
 
+#include "MSSMNoFV/MSSMNoFV_onshell_cache.hpp"
 #include "MSSMNoFV/gm2_1loop_helpers.hpp"
 #include "MSSMNoFV/gm2_2loop_helpers.hpp"
 #include "THDM/gm2_2loop_helpers.hpp"
 #include "gm2_config_options.hpp"
 #include "gm2_log.hpp"
+#include "gm2_parallel.hpp"
+#include "gm2_server.hpp"
 #include "gm2_slha_io.hpp"
+#include "gm2_slha_stream.hpp"
+#include "gm2_thdm_table.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #define FORMAT_AMU(amu) std::scientific << std::setprecision(8) << std::setw(15) << (amu)
 #define FORMAT_DEL(amu) std::scientific << std::setprecision(8) << std::setw(14) << (amu)
@@ -63,10 +78,21 @@ using THDM_writer = std::function<void(const gm2calc::THDM&,
  * @brief command line options for GM2Calc
  */
 struct Gm2_cmd_line_options {
-   enum E_input_type { SLHA, GM2Calc, THDM };
+   enum E_input_type { SLHA, GM2Calc, THDM, THDM_table };
+   enum E_slha_output { Document, Results, Echo };
 
    std::string input_source; ///< input source (file name or `-' for stdin)
-   E_input_type input_type{SLHA}; ///< input format (SLHA, GM2Calc or THDM)
+   E_input_type input_type{SLHA}; ///< input format (SLHA, GM2Calc, THDM or THDM_table)
+   std::string sm_input_source; ///< SLHA input source of SM parameters (THDM table input)
+   unsigned threads{0}; ///< number of threads (0 = number of hardware threads)
+   std::string serve_socket; ///< socket path of the server (empty if disabled)
+   std::string batch_queue; ///< shared memory name of the batch queue (empty if disabled)
+   std::string profile_format; ///< profile output format (empty, table or json)
+   std::string cache_file; ///< on-shell conversion cache file (empty if disabled)
+   bool multi_document{false}; ///< input contains multiple SLHA documents
+   std::string document_separator; ///< separator line between SLHA documents
+   E_slha_output slha_output{Document}; ///< content of SLHA output
+   std::string result_file; ///< binary result file (empty if disabled)
 
    static bool starts_with(const std::string& str, const std::string& prefix) {
       return str.compare(0, prefix.size(), prefix) == 0;
@@ -81,6 +107,23 @@ void print_usage(const char* program_name)
       "  --slha-input-file=<source>      SLHA input source (file name or - for stdin)\n"
       "  --gm2calc-input-file=<source>   GM2Calc input source (file name or - for stdin)\n"
       "  --thdm-input-file=<source>      THDM input source (file name or - for stdin)\n"
+      "  --thdm-table-input-file=<source>\n"
+      "                                  THDM table input source (CSV, TSV or whitespace-\n"
+      "                                  separated, file name or - for stdin)\n"
+      "  --sm-input-file=<source>        SLHA input source of SM parameters and\n"
+      "                                  GM2CalcConfig for THDM table input\n"
+      "  --threads=<n>                   number of threads for THDM table input, server\n"
+      "                                  or batch queue\n"
+      "  --serve=<socket>                serve requests over the Unix domain socket <socket>\n"
+      "  --batch-queue=<name>            evaluate the records of the shared memory batch\n"
+      "                                  queue <name> until it is closed\n"
+      "  --profile[=table|json]          print run time profile of THDM contributions to stderr\n"
+      "  --cache-file=<file>             cache the on-shell conversion of SLHA input in <file>\n"
+      "  --multi-document[=<separator>]  process each SLHA document of the input source\n"
+      "  --slha-output=<mode>            SLHA output: document (input with results, default),\n"
+      "                                  results (result blocks only) or\n"
+      "                                  echo (verbatim input followed by result blocks)\n"
+      "  --result-file=<file>            write results in binary columnar format to <file>\n"
       "  --help,-h                       print this help message\n"
       "  --version,-v                    print version number"
       "\n";
@@ -103,7 +146,8 @@ bool process_input_type(const std::string& str, Gm2_cmd_line_options& options)
    } input_file_options[] = {
       { "--slha-input-file="   , Gm2_cmd_line_options::SLHA    },
       { "--gm2calc-input-file=", Gm2_cmd_line_options::GM2Calc },
-      { "--thdm-input-file="   , Gm2_cmd_line_options::THDM    }
+      { "--thdm-input-file="   , Gm2_cmd_line_options::THDM    },
+      { "--thdm-table-input-file=", Gm2_cmd_line_options::THDM_table }
    };
 
    for (const auto& ifo: input_file_options) {
@@ -136,6 +180,98 @@ Gm2_cmd_line_options get_cmd_line_options(int argc, const char* argv[])
          continue;
       }
 
+      if (option_string == "--profile") {
+         options.profile_format = "table";
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--profile=")) {
+         options.profile_format = option_string.substr(10);
+         if (options.profile_format != "table" && options.profile_format != "json") {
+            ERROR("Unknown profile format: " << options.profile_format
+                  << " (allowed values: table, json)");
+            exit(EXIT_FAILURE);
+         }
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--cache-file=")) {
+         options.cache_file = option_string.substr(13);
+         if (options.cache_file.empty()) {
+            ERROR("No cache file given");
+            exit(EXIT_FAILURE);
+         }
+         continue;
+      }
+
+      if (option_string == "--multi-document") {
+         options.multi_document = true;
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--multi-document=")) {
+         options.multi_document = true;
+         options.document_separator = option_string.substr(17);
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--sm-input-file=")) {
+         options.sm_input_source = option_string.substr(16);
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--threads=")) {
+         const auto threads = option_string.substr(10);
+         if (threads.empty() ||
+             threads.find_first_not_of("0123456789") != std::string::npos ||
+             threads.size() > 6 || std::stoul(threads) == 0) {
+            ERROR("Invalid number of threads: " << threads
+                  << " (allowed values: positive integers)");
+            exit(EXIT_FAILURE);
+         }
+         options.threads = static_cast<unsigned>(std::stoul(threads));
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--serve=")) {
+         options.serve_socket = option_string.substr(8);
+         if (options.serve_socket.empty()) {
+            ERROR("No socket given");
+            exit(EXIT_FAILURE);
+         }
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--batch-queue=")) {
+         options.batch_queue = option_string.substr(14);
+         if (options.batch_queue.empty()) {
+            ERROR("No batch queue given");
+            exit(EXIT_FAILURE);
+         }
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--result-file=")) {
+         options.result_file = option_string.substr(14);
+         continue;
+      }
+
+      if (Gm2_cmd_line_options::starts_with(option_string, "--slha-output=")) {
+         const auto mode = option_string.substr(14);
+         if (mode == "document") {
+            options.slha_output = Gm2_cmd_line_options::Document;
+         } else if (mode == "results") {
+            options.slha_output = Gm2_cmd_line_options::Results;
+         } else if (mode == "echo") {
+            options.slha_output = Gm2_cmd_line_options::Echo;
+         } else {
+            ERROR("Unknown SLHA output mode: " << mode
+                  << " (allowed values: document, results, echo)");
+            exit(EXIT_FAILURE);
+         }
+         continue;
+      }
+
       if (option_string == "--help" || option_string == "-h") {
          print_usage(argv[0]);
          exit(EXIT_SUCCESS);
@@ -180,32 +316,108 @@ void set_to_default(gm2calc::Config_options& config_options,
    case Gm2_cmd_line_options::THDM:
       config_options.output_format = gm2calc::Config_options::GM2Calc;
       break;
+   case Gm2_cmd_line_options::THDM_table:
+      config_options.output_format = gm2calc::Config_options::Minimal;
+      break;
    default:
       throw gm2calc::ESetupError("Unknown input option");
       break;
    }
 }
 
+/// SLHA entry (block name, key, value, comment)
+using SLHA_entry = std::tuple<std::string, int, double, std::string>;
+
+/// SPINFO entry (key, text)
+using SPINFO_entry = std::pair<unsigned, std::string>;
+
+/**
+ * Writes SLHA output with the given result and SPINFO entries.
+ *
+ * In the Document mode, the entries are inserted into the input
+ * document, which is then written.  In the Results mode, only the
+ * blocks with the entries are written.  In the Echo mode, the input
+ * is written verbatim, followed by the blocks with the entries.
+ *
+ * @param ostr output stream
+ * @param slha_io SLHA object with the input
+ * @param mode SLHA output mode
+ * @param spinfo SPINFO entries
+ * @param entries result entries
+ */
+void write_slha_output(std::ostream& ostr,
+                       gm2calc::GM2_slha_io& slha_io,
+                       Gm2_cmd_line_options::E_slha_output mode,
+                       const std::vector<SPINFO_entry>& spinfo,
+                       const std::vector<SLHA_entry>& entries)
+{
+   switch (mode) {
+   case Gm2_cmd_line_options::Document:
+      for (const auto& e: entries) {
+         slha_io.fill_block_entry(std::get<0>(e), std::get<1>(e),
+                                  std::get<2>(e), std::get<3>(e));
+      }
+      for (const auto& e: spinfo) {
+         slha_io.fill_block_entry("SPINFO", e.first, e.second);
+      }
+      slha_io.write_to_stream(ostr);
+      return;
+   case Gm2_cmd_line_options::Echo:
+      slha_io.write_input_to_stream(ostr);
+      break;
+   case Gm2_cmd_line_options::Results:
+      break;
+   }
+
+   if (!spinfo.empty()) {
+      ostr << "Block SPINFO\n";
+      for (const auto& e: spinfo) {
+         gm2calc::GM2_slha_io::write_block_entry(ostr, e.first, e.second);
+      }
+   }
+
+   // write entries grouped by block, in the order of appearance
+   for (std::size_t i = 0; i < entries.size(); i++) {
+      const auto& block = std::get<0>(entries[i]);
+      const auto is_block = [&block] (const SLHA_entry& e) { return std::get<0>(e) == block; };
+
+      if (std::any_of(entries.cbegin(), entries.cbegin() + i, is_block)) {
+         continue;
+      }
+
+      ostr << "Block " << block << '\n';
+
+      for (std::size_t k = i; k < entries.size(); k++) {
+         if (is_block(entries[k])) {
+            gm2calc::GM2_slha_io::write_block_entry(
+               ostr, std::get<1>(entries[k]), std::get<2>(entries[k]),
+               std::get<3>(entries[k]));
+         }
+      }
+   }
+}
+
 /**
  * Prints output if an error has occured.
  *
  * @param error error object
  * @param slha_io SLHA object
  * @param config_options configuration options
+ * @param slha_output SLHA output mode
  */
 void print_error(const gm2calc::Error& error,
                  gm2calc::GM2_slha_io& slha_io,
-                 const gm2calc::Config_options& config_options)
+                 const gm2calc::Config_options& config_options,
+                 Gm2_cmd_line_options::E_slha_output slha_output)
 {
    switch (config_options.output_format) {
    case gm2calc::Config_options::NMSSMTools:
    case gm2calc::Config_options::SPheno:
    case gm2calc::Config_options::GM2Calc:
       // print SPINFO block with error description
-      slha_io.fill_block_entry("SPINFO", 1, "GM2Calc");
-      slha_io.fill_block_entry("SPINFO", 2, GM2CALC_VERSION);
-      slha_io.fill_block_entry("SPINFO", 4, error.what());
-      slha_io.write_to_stream(std::cout);
+      write_slha_output(std::cout, slha_io, slha_output,
+                        {{1, "GM2Calc"}, {2, GM2CALC_VERSION}, {4, error.what()}},
+                        {});
       break;
    default:
       ERROR(error.what());
@@ -306,17 +518,24 @@ double calculate_uncertainty(const Model& model,
 
 /**
  * Reads parameters from SLHA i/o object (SLHA scheme) and initializes
- * model accordingly.
+ * model accordingly.  If a cache is given, the conversion to the
+ * on-shell scheme is taken from the cache if possible.
  *
  * @param model model to initialize
  * @param slha_io SLHA i/o object to read parameters from
  */
 struct SLHA_reader {
+   std::shared_ptr<gm2calc::MSSMNoFV_onshell_cache> cache;
+
    void operator()(gm2calc::MSSMNoFV_onshell& model,
                    const gm2calc::GM2_slha_io& slha_io)
    {
       slha_io.fill_slha(model);
-      model.convert_to_onshell();
+      if (cache) {
+         cache->convert_to_onshell(model);
+      } else {
+         model.convert_to_onshell();
+      }
    }
 };
 
@@ -590,22 +809,24 @@ struct Detailed_writer<gm2calc::THDM> {
 
 /**
  * Calculates a_mu (and potentially also the uncertainty) and writes
- * it to the SLHA i/o object.
+ * it in SLHA format to stdout.
  *
  * @param model the model (must be initialized)
  * @param options calculation options
- * @param slha_io SLHA i/o object where results are stored
+ * @param slha_io SLHA i/o object with the input
  */
 template<class Model>
 struct SLHA_writer {
-   /// SLHA entry (block name, key, value, comment)
-   using SLHA_entry = std::tuple<std::string, int, double, std::string>;
+   Gm2_cmd_line_options::E_slha_output slha_output{Gm2_cmd_line_options::Document};
 
    void operator()(const Model& model,
                    const gm2calc::Config_options& options,
                    gm2calc::GM2_slha_io& slha_io)
    {
-      const SLHA_entry amu_entry = [&] {
+      std::vector<SLHA_entry> entries;
+      std::vector<SPINFO_entry> spinfo;
+
+      entries.push_back([&] {
          const auto amu = calculate_amu(model, options);
          const auto amu_comment = "Delta(g-2)_muon/2";
 
@@ -619,40 +840,53 @@ struct SLHA_writer {
          }
 
          return SLHA_entry{"GM2CalcOutput", 0, amu, amu_comment};
-      }();
-
-      set_SLHA_value(slha_io, amu_entry);
+      }());
 
       if (options.calculate_uncertainty) {
          const auto damu = calculate_uncertainty(model, options);
-         const SLHA_entry damu_entry{"GM2CalcOutput", 1, damu,
-                                     "uncertainty of Delta(g-2)_muon/2"};
-         set_SLHA_value(slha_io, damu_entry);
+         entries.push_back(SLHA_entry{"GM2CalcOutput", 1, damu,
+                                      "uncertainty of Delta(g-2)_muon/2"});
       }
 
       if (model.get_problems().have_warning()) {
-         slha_io.fill_block_entry("SPINFO", 1, "GM2Calc");
-         slha_io.fill_block_entry("SPINFO", 2, GM2CALC_VERSION);
-         slha_io.fill_block_entry("SPINFO", 3, model.get_problems().get_warnings());
+         spinfo.emplace_back(1, "GM2Calc");
+         spinfo.emplace_back(2, GM2CALC_VERSION);
+         spinfo.emplace_back(3, model.get_problems().get_warnings());
       }
 
-      slha_io.write_to_stream(std::cout);
+      write_slha_output(std::cout, slha_io, slha_output, spinfo, entries);
    }
+};
 
-private:
-   /**
-    * Sets a entry in a given SLHA block/key.
-    *
-    * @param slha_io SLHA input/output object
-    * @param entry tuple defining the SLHA (block name, key, value, comment)
-    */
-   void set_SLHA_value(gm2calc::GM2_slha_io& slha_io, const SLHA_entry& entry)
+/**
+ * Calculates the contributions to a_mu and appends them as a row to
+ * the binary result file.
+ *
+ * @param model the model (must be initialized)
+ * @param options calculation options (unused)
+ * @param slha_io SLHA i/o object (unused)
+ */
+template<class Model>
+struct Binary_result_writer {
+   std::shared_ptr<gm2calc::Result_file_writer> result_file;
+
+   void operator()(const Model& model,
+                   const gm2calc::Config_options& /* unused */,
+                   gm2calc::GM2_slha_io& /* unused */)
    {
-      slha_io.fill_block_entry(std::get<0>(entry), std::get<1>(entry),
-                               std::get<2>(entry), std::get<3>(entry));
+      gm2calc::write_result(*result_file, model);
    }
 };
 
+/**
+ * @class Run_context
+ * @brief resources shared between the calculations of several documents
+ */
+struct Run_context {
+   std::shared_ptr<gm2calc::MSSMNoFV_onshell_cache> cache; ///< on-shell conversion cache
+   std::shared_ptr<gm2calc::Result_file_writer> result_file; ///< binary result file
+};
+
 /**
  * Class which handles input/output for the MSSM.
  */
@@ -744,26 +978,34 @@ private:
  *
  * @param input_type type of input (SLHA/GM2Calc)
  * @param options configuration options
+ * @param context cache and result file (may be null)
+ * @param slha_output SLHA output mode
  *
  * @return MSSMNoFV_setup object
  */
 MSSMNoFV_setup make_mssmnofv_setup(
    Gm2_cmd_line_options::E_input_type input_type,
-   const gm2calc::Config_options& options)
+   const gm2calc::Config_options& options,
+   const Run_context& context,
+   Gm2_cmd_line_options::E_slha_output slha_output)
 {
    const auto reader = [&] () -> MSSMNoFV_reader {
       switch (input_type) {
       case Gm2_cmd_line_options::SLHA:
-         return SLHA_reader();
+         return SLHA_reader{context.cache};
       case Gm2_cmd_line_options::GM2Calc:
          return GM2Calc_reader();
       case Gm2_cmd_line_options::THDM:
+      case Gm2_cmd_line_options::THDM_table:
          break;
       }
       throw gm2calc::ESetupError("Unknown input type");
    }();
 
    const auto writer = [&] () -> MSSMNoFV_writer {
+      if (context.result_file) {
+         return Binary_result_writer<gm2calc::MSSMNoFV_onshell>{context.result_file};
+      }
       switch (options.output_format) {
       case gm2calc::Config_options::Minimal:
          return Minimal_writer<gm2calc::MSSMNoFV_onshell>();
@@ -772,7 +1014,7 @@ MSSMNoFV_setup make_mssmnofv_setup(
       default:
          break;
       }
-      return SLHA_writer<gm2calc::MSSMNoFV_onshell>();
+      return SLHA_writer<gm2calc::MSSMNoFV_onshell>{slha_output};
    }();
 
    return MSSMNoFV_setup(options, reader, writer);
@@ -783,12 +1025,19 @@ MSSMNoFV_setup make_mssmnofv_setup(
  *
  * @param input_type type of input (SLHA/GM2Calc)
  * @param options configuration options
+ * @param context result file (may be null)
+ * @param slha_output SLHA output mode
  *
  * @return MSSMNoFV_setup object
  */
-THDM_setup make_thdm_setup(const gm2calc::Config_options& options)
+THDM_setup make_thdm_setup(const gm2calc::Config_options& options,
+                           const Run_context& context,
+                           Gm2_cmd_line_options::E_slha_output slha_output)
 {
    const auto writer = [&] () -> THDM_writer {
+      if (context.result_file) {
+         return Binary_result_writer<gm2calc::THDM>{context.result_file};
+      }
       switch (options.output_format) {
       case gm2calc::Config_options::Minimal:
          return Minimal_writer<gm2calc::THDM>();
@@ -797,24 +1046,437 @@ THDM_setup make_thdm_setup(const gm2calc::Config_options& options)
       default:
          break;
       }
-      return SLHA_writer<gm2calc::THDM>();
+      return SLHA_writer<gm2calc::THDM>{slha_output};
    }();
 
    return THDM_setup(options, THDM_reader(), writer);
 }
 
+/**
+ * Reads the configuration from the SLHA i/o object, calculates a_mu
+ * and writes the output.
+ *
+ * @param options command line options
+ * @param slha_io SLHA i/o object with the input
+ * @param context cache and result file (created if needed)
+ *
+ * @return exit code
+ */
+int run(const Gm2_cmd_line_options& options,
+        gm2calc::GM2_slha_io& slha_io,
+        Run_context& context)
+{
+   gm2calc::Config_options config_options;
+   int exit_code = EXIT_SUCCESS;
+
+   try {
+      set_to_default(config_options, options);
+      slha_io.fill(config_options);
+
+      switch (options.input_type) {
+      case Gm2_cmd_line_options::SLHA:
+      case Gm2_cmd_line_options::GM2Calc: {
+         if (!context.cache && !options.cache_file.empty()) {
+            context.cache = std::make_shared<gm2calc::MSSMNoFV_onshell_cache>(options.cache_file);
+         }
+         if (!context.result_file && !options.result_file.empty()) {
+            context.result_file = std::make_shared<gm2calc::Result_file_writer>(
+               options.result_file, gm2calc::get_mssmnofv_result_columns());
+         }
+         auto setup = make_mssmnofv_setup(
+            options.input_type, config_options, context, options.slha_output);
+         exit_code = setup.run(slha_io);
+         }
+         break;
+      case Gm2_cmd_line_options::THDM: {
+         if (!context.result_file && !options.result_file.empty()) {
+            context.result_file = std::make_shared<gm2calc::Result_file_writer>(
+               options.result_file, gm2calc::get_thdm_result_columns());
+         }
+         auto setup = make_thdm_setup(config_options, context, options.slha_output);
+         exit_code = setup.run(slha_io);
+         }
+         break;
+      case Gm2_cmd_line_options::THDM_table:
+         throw gm2calc::ESetupError("THDM table input cannot be read as SLHA input");
+      }
+   } catch (const gm2calc::Error& error) {
+      if (context.result_file) {
+         context.result_file->write_error_row();
+         ERROR(error.what());
+      } else {
+         print_error(error, slha_io, config_options, options.slha_output);
+      }
+      exit_code = EXIT_FAILURE;
+   }
+
+   return exit_code;
+}
+
+/**
+ * Reads the SLHA documents of the input source one after the other
+ * and runs the calculation for each of them.  If a document separator
+ * is given, it is written between the outputs of two documents.
+ *
+ * @param options command line options
+ * @param slha_io SLHA i/o object
+ *
+ * A malformed document is reported and skipped.
+ *
+ * @return exit code (EXIT_FAILURE if the calculation failed for any document)
+ */
+int run_documents(const Gm2_cmd_line_options& options, gm2calc::GM2_slha_io& slha_io)
+{
+   Run_context context;
+   int exit_code = EXIT_SUCCESS;
+
+   gm2calc::GM2_slha_stream stream(options.input_source, options.document_separator);
+
+   while (true) {
+      try {
+         if (!stream.next(slha_io)) {
+            break;
+         }
+      } catch (const gm2calc::Error& error) {
+         ERROR(error.what());
+         exit_code = EXIT_FAILURE;
+         continue;
+      }
+      if (stream.get_number_of_documents() > 1 && !options.document_separator.empty() &&
+          options.result_file.empty()) {
+         std::cout << options.document_separator << '\n';
+      }
+      if (run(options, slha_io, context) != EXIT_SUCCESS) {
+         exit_code = EXIT_FAILURE;
+      }
+   }
+
+   return exit_code;
+}
+
+/**
+ * @class THDM_table_row
+ * @brief parameter point of a THDM table and its results
+ */
+template <class Basis>
+struct THDM_table_row {
+   std::size_t line_number{0}; ///< line number in the table
+   Basis basis;                ///< input parameters
+   std::string error;          ///< error message (empty if none)
+   double amu{0.0};            ///< a_mu
+   double damu{0.0};           ///< uncertainty of a_mu
+   std::vector<gm2calc::Result_value> result; ///< row of the result file
+};
+
+/**
+ * Reads the parameter points of a THDM table in blocks, calculates
+ * a_mu for the points of each block in parallel and writes one output
+ * row per point in the order of the table.  If no result file is
+ * given, a_mu and its uncertainty are written to stdout.  Points for
+ * which the calculation fails yield NaN.
+ *
+ * @param table THDM table
+ * @param sm Standard Model parameters
+ * @param config_options configuration options
+ * @param result_file binary result file (may be null)
+ * @param threads number of threads
+ *
+ * @return exit code (EXIT_FAILURE if the calculation failed for any point)
+ */
+template <class Basis>
+int run_thdm_table(gm2calc::GM2_thdm_table& table,
+                   const gm2calc::SM& sm,
+                   const gm2calc::Config_options& config_options,
+                   gm2calc::Result_file_writer* result_file,
+                   unsigned threads)
+{
+   const std::size_t block_size = 4096;
+   const double nan = std::numeric_limits<double>::quiet_NaN();
+   std::vector<THDM_table_row<Basis>> rows(block_size);
+   int exit_code = EXIT_SUCCESS;
+
+   gm2calc::thdm::Config thdm_config;
+   thdm_config.force_output = config_options.force_output;
+   thdm_config.running_couplings = config_options.running_couplings;
+
+   const auto calculate = [&] (std::size_t i) {
+      auto& row = rows[i];
+      if (!row.error.empty()) {
+         return;
+      }
+      try {
+         const gm2calc::THDM model(row.basis, sm, thdm_config);
+         if (result_file) {
+            row.result = gm2calc::make_result_row(model);
+         } else {
+            row.amu = calculate_amu(model, config_options);
+            row.damu = calculate_uncertainty(model, config_options);
+         }
+      } catch (const std::exception& error) {
+         row.error = "line " + std::to_string(row.line_number) +
+                     " of THDM table: " + error.what();
+      }
+   };
+
+   if (!result_file) {
+      std::cout << '#' << std::setw(14) << "amu" << ' ' << std::setw(15) << "damu" << '\n';
+   }
+
+   std::size_t n = block_size;
+
+   while (n == block_size) {
+      for (n = 0; n < block_size; n++) {
+         auto& row = rows[n];
+         row.error.clear();
+         try {
+            if (!table.next(row.basis)) {
+               break;
+            }
+         } catch (const gm2calc::Error& error) {
+            row.error = error.what();
+         }
+         row.line_number = table.get_line_number();
+      }
+
+      gm2calc::parallel_for(n, threads, calculate);
+
+      for (std::size_t i = 0; i < n; i++) {
+         auto& row = rows[i];
+         if (!row.error.empty()) {
+            ERROR(row.error);
+            exit_code = EXIT_FAILURE;
+            row.amu = row.damu = nan;
+            if (result_file) {
+               result_file->write_error_row();
+               continue;
+            }
+         } else if (result_file) {
+            result_file->write_row(row.result);
+            continue;
+         }
+         std::cout << FORMAT_AMU(row.amu) << ' ' << FORMAT_AMU(row.damu) << '\n';
+      }
+   }
+
+   return exit_code;
+}
+
+/**
+ * Reads the SM parameters and the configuration options from the SM
+ * input source (if given), and runs the calculation for each
+ * parameter point of the THDM table.
+ *
+ * @param options command line options
+ *
+ * @return exit code (EXIT_FAILURE if the calculation failed for any point)
+ */
+int run_thdm_table(const Gm2_cmd_line_options& options)
+{
+   gm2calc::Config_options config_options;
+   gm2calc::SM sm;
+
+   set_to_default(config_options, options);
+
+   if (!options.sm_input_source.empty()) {
+      gm2calc::GM2_slha_io slha_io;
+      slha_io.read_from_source(options.sm_input_source);
+      slha_io.fill(config_options);
+      slha_io.fill(sm);
+   }
+
+   const unsigned threads = gm2calc::get_number_of_threads(options.threads);
+
+   gm2calc::GM2_thdm_table table(options.input_source);
+
+   std::unique_ptr<gm2calc::Result_file_writer> result_file;
+
+   if (!options.result_file.empty()) {
+      result_file.reset(new gm2calc::Result_file_writer(
+         options.result_file, gm2calc::get_thdm_result_columns()));
+   }
+
+   switch (table.get_basis()) {
+   case gm2calc::GM2_thdm_table::Basis::Mass:
+      return run_thdm_table<gm2calc::thdm::Mass_basis>(
+         table, sm, config_options, result_file.get(), threads);
+   case gm2calc::GM2_thdm_table::Basis::Gauge:
+      return run_thdm_table<gm2calc::thdm::Gauge_basis>(
+         table, sm, config_options, result_file.get(), threads);
+   }
+
+   throw gm2calc::ESetupError("Unknown THDM basis");
+}
+
+/**
+ * Returns a_mu and its uncertainty as response payload of the server.
+ *
+ * @param model the model (must be initialized)
+ * @param options calculation options
+ *
+ * @return two doubles: a_mu, uncertainty of a_mu
+ */
+template <class Model>
+std::string make_response(const Model& model, const gm2calc::Config_options& options)
+{
+   const double result[2] = {
+      calculate_amu(model, options), calculate_uncertainty(model, options)
+   };
+   return std::string(reinterpret_cast<const char*>(result), sizeof(result));
+}
+
+/**
+ * Reads the doubles of a binary record.
+ *
+ * @param payload request payload
+ * @param n expected number of doubles
+ * @param record doubles
+ */
+void read_record(const std::string& payload, std::size_t n, double* record)
+{
+   if (payload.size() != n * sizeof(double)) {
+      throw gm2calc::EInvalidInput(
+         "invalid record size " + std::to_string(payload.size()) +
+         " (expected " + std::to_string(n * sizeof(double)) + " bytes)");
+   }
+   std::memcpy(record, payload.data(), payload.size());
+}
+
+/**
+ * Checks the MSSMNoFV model for problems.
+ *
+ * @param model the model
+ * @param options calculation options
+ */
+void check_problems(const gm2calc::MSSMNoFV_onshell& model,
+                    const gm2calc::Config_options& options)
+{
+   if (!options.force_output && model.get_problems().have_problem()) {
+      std::ostringstream sstr;
+      sstr << model.get_problems();
+      throw gm2calc::EPhysicalProblem(sstr.str());
+   }
+}
+
+/**
+ * Calculates a_mu and its uncertainty for a request of the server.
+ *
+ * Text requests contain an input document in the same format as the
+ * corresponding input file of gm2calc.x, including the optional
+ * GM2CalcConfig block.  SM parameters which are not given are set to
+ * their default values.
+ *
+ * Binary requests contain the input parameters of a Batch_record
+ * (13 doubles for GM2_request_thdm_mass_basis, 31 doubles for
+ * GM2_request_mssmnofv), which are evaluated with the default SM
+ * parameters and configuration options.
+ *
+ * @param type request type
+ * @param payload request payload
+ *
+ * @return two doubles: a_mu, uncertainty of a_mu
+ */
+std::string handle_request(std::uint32_t type, const std::string& payload)
+{
+   gm2calc::Config_options options;
+
+   switch (type) {
+   case gm2calc::GM2_request_slha:
+   case gm2calc::GM2_request_gm2calc: {
+      gm2calc::GM2_slha_io slha_io;
+      slha_io.read_from_string(payload);
+      slha_io.fill(options);
+      gm2calc::MSSMNoFV_onshell model;
+      model.do_force_output(options.force_output);
+      if (type == gm2calc::GM2_request_slha) {
+         SLHA_reader()(model, slha_io);
+      } else {
+         GM2Calc_reader()(model, slha_io);
+      }
+      check_problems(model, options);
+      return make_response(model, options);
+      }
+   case gm2calc::GM2_request_thdm: {
+      gm2calc::GM2_slha_io slha_io;
+      slha_io.read_from_string(payload);
+      slha_io.fill(options);
+      return make_response(THDM_reader()(slha_io, options), options);
+      }
+   case gm2calc::GM2_request_thdm_mass_basis:
+   case gm2calc::GM2_request_mssmnofv: {
+      gm2calc::Batch_record record;
+      record.type = type == gm2calc::GM2_request_thdm_mass_basis
+         ? gm2calc::Batch_thdm_mass_basis : gm2calc::Batch_mssmnofv;
+      read_record(payload, type == gm2calc::GM2_request_thdm_mass_basis ? 13 : 31,
+                  record.input);
+      gm2calc::evaluate(record);
+      const double result[2] = { record.amu, record.damu };
+      return std::string(reinterpret_cast<const char*>(result), sizeof(result));
+      }
+   default:
+      break;
+   }
+
+   throw gm2calc::EInvalidInput("unsupported request type " + std::to_string(type));
+}
+
+/**
+ * Serves requests over a Unix domain socket until a shutdown request
+ * is received.  The latency statistics are printed to stderr when the
+ * server stops.
+ *
+ * @param options command line options
+ *
+ * @return exit code
+ */
+int run_server(const Gm2_cmd_line_options& options)
+{
+   const unsigned threads = gm2calc::get_number_of_threads(options.threads);
+
+   gm2calc::GM2_server server(options.serve_socket, handle_request, threads);
+   server.run();
+
+   std::cerr << gm2calc::format_statistics(server.get_statistics());
+
+   return EXIT_SUCCESS;
+}
+
+/**
+ * Evaluates the records of a batch queue, which has been created by
+ * another process, until the queue is closed.
+ *
+ * @param options command line options
+ *
+ * @return exit code
+ */
+int run_batch_queue(const Gm2_cmd_line_options& options)
+{
+   const unsigned threads = gm2calc::get_number_of_threads(options.threads);
+
+   gm2calc::Batch_queue queue(options.batch_queue);
+
+   gm2calc::parallel_for(threads, threads, [&queue] (std::size_t) {
+      while (queue.consume()) {}
+   });
+
+   return EXIT_SUCCESS;
+}
+
 } // anonymous namespace
 
 int main(int argc, const char* argv[])
 {
    Gm2_cmd_line_options options(get_cmd_line_options(argc, argv));
 
-   if (options.input_source.empty()) {
+   if (options.input_source.empty() && options.serve_socket.empty() &&
+       options.batch_queue.empty()) {
       ERROR(std::string("No input source given!\n") +
             "Examples: \n" +
             "   " + argv[0] + " --slha-input-file=<file>     # MSSM SLHA input\n"
             "   " + argv[0] + " --gm2calc-input-file=<file>  # MSSM GM2Calc input\n"
-            "   " + argv[0] + " --thdm-input-file=<file>     # THDM input");
+            "   " + argv[0] + " --thdm-input-file=<file>     # THDM input\n"
+            "   " + argv[0] + " --thdm-table-input-file=<file> # THDM table input\n"
+            "   " + argv[0] + " --serve=<socket>             # server\n"
+            "   " + argv[0] + " --batch-queue=<name>         # batch queue worker");
       return EXIT_FAILURE;
    }
 
@@ -822,28 +1484,35 @@ int main(int argc, const char* argv[])
    gm2calc::Config_options config_options;
    int exit_code = EXIT_SUCCESS;
 
+   if (!options.profile_format.empty()) {
+      gm2calc::enable_profiling();
+   }
+
    try {
       set_to_default(config_options, options);
-      slha_io.read_from_source(options.input_source);
-      slha_io.fill(config_options);
-
-      switch (options.input_type) {
-      case Gm2_cmd_line_options::SLHA:
-      case Gm2_cmd_line_options::GM2Calc: {
-         auto setup = make_mssmnofv_setup(options.input_type, config_options);
-         exit_code = setup.run(slha_io);
-         }
-         break;
-      case Gm2_cmd_line_options::THDM: {
-         auto setup = make_thdm_setup(config_options);
-         exit_code = setup.run(slha_io);
-         }
-         break;
+      if (!options.serve_socket.empty()) {
+         exit_code = run_server(options);
+      } else if (!options.batch_queue.empty()) {
+         exit_code = run_batch_queue(options);
+      } else if (options.input_type == Gm2_cmd_line_options::THDM_table) {
+         exit_code = run_thdm_table(options);
+      } else if (options.multi_document) {
+         exit_code = run_documents(options, slha_io);
+      } else {
+         Run_context context;
+         slha_io.read_from_source(options.input_source);
+         exit_code = run(options, slha_io, context);
       }
    } catch (const gm2calc::Error& error) {
-      print_error(error, slha_io, config_options);
+      print_error(error, slha_io, config_options, options.slha_output);
       exit_code = EXIT_FAILURE;
    }
 
+   if (options.profile_format == "json") {
+      gm2calc::print_profile_json(std::cerr, gm2calc::get_profile());
+   } else if (options.profile_format == "table") {
+      gm2calc::print_profile_table(std::cerr, gm2calc::get_profile());
+   }
+
    return exit_code;
 }
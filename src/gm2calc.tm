@@ -87,6 +87,12 @@
 :Evaluate: Damu::usage =
     "Uncertainty of the calculated value of the anomalous magnetic moment of the muon.";
 
+:Evaluate: status::usage =
+    "Status codes of a list of evaluated parameter points: 0 = no error, 1 = invalid input, 2 = physical problem, 3 = unknown error.";
+
+:Evaluate: threads::usage =
+    "Number of threads used to evaluate a list of parameter points (0 = number of hardware threads).";
+
 :Evaluate: UM::usage =
     "Mixing matrix of the negatively charged charginos.";
 
@@ -285,14 +291,26 @@
 :Evaluate: GM2CalcAmuTHDMMassBasis::usage =
     "GM2CalcAmuTHDMMassBasis calculates amu and its uncertainty in the Two-Higgs Doublet Model using the given input parameters.  Unset input parameters are set to zero.  See Options[GM2CalcAmuTHDMMassBasis] for all parameters and their default values."
 
+:Evaluate: GM2CalcAmuGM2CalcSchemeList::usage =
+    "GM2CalcAmuGM2CalcSchemeList[points] calculates amu and its uncertainty in the MSSM for a list of parameter points in the GM2Calc-specific renormalization scheme in a single call.  Each point is a list of rules or an association with the parameters of GM2CalcAmuGM2CalcScheme; unset parameters are set to zero.  The points are evaluated on the number of threads given by the option threads.  Returns {amu -> {...}, Damu -> {...}, status -> {...}} with packed arrays.  For points with a non-zero status, amu and Damu are set to zero."
+
+:Evaluate: GM2CalcAmuTHDMGaugeBasisList::usage =
+    "GM2CalcAmuTHDMGaugeBasisList[points] calculates amu and its uncertainty in the Two-Higgs Doublet Model for a list of parameter points in the gauge basis in a single call.  Each point is a list of rules or an association with the parameters of GM2CalcAmuTHDMGaugeBasis; unset parameters are set to zero.  The points are evaluated on the number of threads given by the option threads.  Returns {amu -> {...}, Damu -> {...}, status -> {...}} with packed arrays.  For points with a non-zero status, amu and Damu are set to zero."
+
+:Evaluate: GM2CalcAmuTHDMMassBasisList::usage =
+    "GM2CalcAmuTHDMMassBasisList[points] calculates amu and its uncertainty in the Two-Higgs Doublet Model for a list of parameter points in the mass basis in a single call.  Each point is a list of rules or an association with the parameters of GM2CalcAmuTHDMMassBasis; unset parameters are set to zero.  The points are evaluated on the number of threads given by the option threads.  Returns {amu -> {...}, Damu -> {...}, status -> {...}} with packed arrays.  For points with a non-zero status, amu and Damu are set to zero."
+
 :Evaluate: GM2CalcAmuSLHAScheme::error = "`1`";
 :Evaluate: GM2CalcAmuSLHAScheme::warning = "`1`";
 
 :Evaluate: GM2CalcAmuGM2CalcScheme::error = "`1`";
 :Evaluate: GM2CalcAmuGM2CalcScheme::warning = "`1`";
+:Evaluate: GM2CalcAmuGM2CalcSchemeList::error = "`1`";
 
 :Evaluate: GM2CalcAmuTHDMMassBasis::error = "`1`";
 :Evaluate: GM2CalcAmuTHDMGaugeBasis::error = "`1`";
+:Evaluate: GM2CalcAmuTHDMMassBasisList::error = "`1`";
+:Evaluate: GM2CalcAmuTHDMGaugeBasisList::error = "`1`";
 
 :Evaluate: Begin["`Private`"]
 
@@ -722,6 +740,80 @@
     Pid               -> {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}},
     Pil               -> {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}} }
 
+:Begin:
+:Function: GM2CalcAmuTHDMGaugeBasisListPacked
+:Pattern: GM2CalcAmuTHDMGaugeBasisListPacked[data_, threads_Integer]
+:Arguments: { data, threads }
+:ArgumentTypes: { RealList, Integer }
+:ReturnType: Manual
+:End:
+
+:Evaluate: thdmGaugeBasisRow[point_] :=
+    Module[{ov},
+        ov[name_] := OptionValue[GM2CalcAmuTHDMGaugeBasis, Normal[point], name];
+        N @ Flatten[{
+            ov[yukawaType], ov[lambda][[1;;7]], ov[TB], ov[m122],
+            ov[zetau], ov[zetad], ov[zetal],
+            Re @ {ov[Deltau], ov[Deltad], ov[Deltal], ov[Piu], ov[Pid], ov[Pil]} }]
+    ]
+
+:Evaluate: Options[GM2CalcAmuTHDMGaugeBasisList] = { threads -> 0 }
+
+:Evaluate: GM2CalcAmuTHDMGaugeBasisList[points_List, OptionsPattern[]] :=
+    GM2CalcAmuTHDMGaugeBasisListPacked[
+        Developer`ToPackedArray[Flatten[thdmGaugeBasisRow /@ points]],
+        OptionValue[threads]]
+
+:Begin:
+:Function: GM2CalcAmuTHDMMassBasisListPacked
+:Pattern: GM2CalcAmuTHDMMassBasisListPacked[data_, threads_Integer]
+:Arguments: { data, threads }
+:ArgumentTypes: { RealList, Integer }
+:ReturnType: Manual
+:End:
+
+:Evaluate: thdmMassBasisRow[point_] :=
+    Module[{ov},
+        ov[name_] := OptionValue[GM2CalcAmuTHDMMassBasis, Normal[point], name];
+        N @ Flatten[{
+            ov[yukawaType], ov[Mhh][[1;;2]], ov[MAh], ov[MHp],
+            ov[sinBetaMinusAlpha], ov[lambda6], ov[lambda7], ov[TB], ov[m122],
+            ov[zetau], ov[zetad], ov[zetal],
+            Re @ {ov[Deltau], ov[Deltad], ov[Deltal], ov[Piu], ov[Pid], ov[Pil]} }]
+    ]
+
+:Evaluate: Options[GM2CalcAmuTHDMMassBasisList] = { threads -> 0 }
+
+:Evaluate: GM2CalcAmuTHDMMassBasisList[points_List, OptionsPattern[]] :=
+    GM2CalcAmuTHDMMassBasisListPacked[
+        Developer`ToPackedArray[Flatten[thdmMassBasisRow /@ points]],
+        OptionValue[threads]]
+
+:Begin:
+:Function: GM2CalcAmuGM2CalcSchemeListPacked
+:Pattern: GM2CalcAmuGM2CalcSchemeListPacked[data_, threads_Integer]
+:Arguments: { data, threads }
+:ArgumentTypes: { RealList, Integer }
+:ReturnType: Manual
+:End:
+
+:Evaluate: mssmnofvGM2CalcSchemeRow[point_] :=
+    Module[{ov},
+        ov[name_] := OptionValue[GM2CalcAmuGM2CalcScheme, Normal[point], name];
+        N @ Flatten[{
+            ov[MAh], ov[TB], ov[Mu], ov[MassB], ov[MassWB], ov[MassG],
+            Diagonal /@ {ov[mq2], ov[ml2], ov[mu2], ov[md2], ov[me2]},
+            ov[Au][[3,3]], ov[Ad][[3,3]], ov[Ae][[2,2]], ov[Ae][[3,3]],
+            ov[Q] }]
+    ]
+
+:Evaluate: Options[GM2CalcAmuGM2CalcSchemeList] = { threads -> 0 }
+
+:Evaluate: GM2CalcAmuGM2CalcSchemeList[points_List, OptionsPattern[]] :=
+    GM2CalcAmuGM2CalcSchemeListPacked[
+        Developer`ToPackedArray[Flatten[mssmnofvGM2CalcSchemeRow /@ points]],
+        OptionValue[threads]]
+
 :Evaluate: End[]
 
 :Evaluate: EndPackage[]
@@ -729,6 +821,7 @@
 
 #include "gm2calc/gm2_1loop.h"
 #include "gm2calc/gm2_2loop.h"
+#include "gm2calc/gm2_batch.h"
 #include "gm2calc/gm2_uncertainty.h"
 #include "gm2calc/gm2_version.h"
 #include "gm2calc/MSSMNoFV_onshell.h"
@@ -1047,8 +1140,8 @@ gm2calc_error setup_model_slha_scheme(MSSMNoFV_onshell* model,
 
 /******************************************************************/
 
-gm2calc_error setup_model_gm2calc_scheme(MSSMNoFV_onshell* model,
-                                         const struct GM2Calc_parameters* pars)
+void fill_model_gm2calc_scheme(MSSMNoFV_onshell* model,
+                               const struct GM2Calc_parameters* pars)
 {
    /* fill SM parameters */
    gm2calc_mssmnofv_set_alpha_MZ(model, sm.alpha_em_mz);
@@ -1085,6 +1178,14 @@ gm2calc_error setup_model_gm2calc_scheme(MSSMNoFV_onshell* model,
          gm2calc_mssmnofv_set_Ae(model, i, k, pars->Ae[i][k]);
       }
    }
+}
+
+/******************************************************************/
+
+gm2calc_error setup_model_gm2calc_scheme(MSSMNoFV_onshell* model,
+                                         const struct GM2Calc_parameters* pars)
+{
+   fill_model_gm2calc_scheme(model, pars);
 
    /* convert DR-bar parameters to on-shell */
    const gm2calc_error error = gm2calc_mssmnofv_calculate_masses(model);
@@ -1938,6 +2039,276 @@ void GM2CalcAmuTHDMMassBasis(
 
 /******************************************************************/
 
+/* number of input parameters per THDM point of a list */
+#define THDM_LIST_COLUMNS 67
+
+/* checks the size of a flattened list of THDM points */
+int check_thdm_list(const char* function_name, const double* data, long len)
+{
+   long i;
+
+   if (len % THDM_LIST_COLUMNS != 0) {
+      put_error_message(function_name, "error",
+                        "Malformed list of parameter points.");
+      return 0;
+   }
+
+   for (i = 0; i < len; i += THDM_LIST_COLUMNS) {
+      if (data[i] != floor(data[i]) || data[i] < 1 || data[i] > 6) {
+         put_error_message(function_name, "error",
+                           "yukawaType must be between 1 and 6.");
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+/******************************************************************/
+
+/* copies 3x3 matrices from a row of a list of THDM points */
+const double* fill_thdm_matrix(double m[3][3], const double* row)
+{
+   int i, k;
+
+   for (i = 0; i < 3; i++) {
+      for (k = 0; k < 3; k++) {
+         m[i][k] = *row++;
+      }
+   }
+
+   return row;
+}
+
+/******************************************************************/
+
+const double* fill_thdm_couplings(
+   double Delta_u[3][3], double Delta_d[3][3], double Delta_l[3][3],
+   double Pi_u[3][3], double Pi_d[3][3], double Pi_l[3][3],
+   const double* row)
+{
+   row = fill_thdm_matrix(Delta_u, row);
+   row = fill_thdm_matrix(Delta_d, row);
+   row = fill_thdm_matrix(Delta_l, row);
+   row = fill_thdm_matrix(Pi_u, row);
+   row = fill_thdm_matrix(Pi_d, row);
+   row = fill_thdm_matrix(Pi_l, row);
+
+   return row;
+}
+
+/******************************************************************/
+
+void create_list_output(size_t n, const double* amu, const double* damu,
+                        const gm2calc_error* status)
+{
+   size_t i;
+   int* istatus = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+
+   for (i = 0; i < n; i++) {
+      istatus[i] = (int)status[i];
+   }
+
+   MLPutFunction(stdlink, "List", 3);
+   MLPutRule(stdlink, "amu");
+   MLPutReal64List(stdlink, amu, (int)n);
+   MLPutRule(stdlink, "Damu");
+   MLPutReal64List(stdlink, damu, (int)n);
+   MLPutRule(stdlink, "status");
+   MLPutInteger32List(stdlink, istatus, (int)n);
+   MLEndPacket(stdlink);
+
+   free(istatus);
+}
+
+/******************************************************************/
+
+void GM2CalcAmuTHDMGaugeBasisListPacked(double* data, long len, int threads)
+{
+   size_t i, n;
+   gm2calc_THDM_gauge_basis* basis = 0;
+   double *amu = 0, *damu = 0;
+   gm2calc_error* status = 0;
+   gm2calc_THDM_config config;
+
+   if (!check_thdm_list("GM2CalcAmuTHDMGaugeBasisList", data, len)) {
+      create_error_output();
+      return;
+   }
+
+   n = (size_t)(len / THDM_LIST_COLUMNS);
+   basis = (gm2calc_THDM_gauge_basis*)malloc((n > 0 ? n : 1) * sizeof(gm2calc_THDM_gauge_basis));
+   amu = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+   damu = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+   status = (gm2calc_error*)malloc((n > 0 ? n : 1) * sizeof(gm2calc_error));
+
+   for (i = 0; i < n; i++) {
+      const double* row = data + i*THDM_LIST_COLUMNS;
+      gm2calc_THDM_gauge_basis* b = basis + i;
+      int k;
+      b->yukawa_type = int_to_c_yukawa_type((int)row[0]);
+      for (k = 0; k < 7; k++) {
+         b->lambda[k] = row[1 + k];
+      }
+      b->tan_beta = row[8];
+      b->m122 = row[9];
+      b->zeta_u = row[10];
+      b->zeta_d = row[11];
+      b->zeta_l = row[12];
+      fill_thdm_couplings(b->Delta_u, b->Delta_d, b->Delta_l,
+                          b->Pi_u, b->Pi_d, b->Pi_l, row + 13);
+   }
+
+   config.force_output = config_flags.forceOutput;
+   config.running_couplings = config_flags.runningCouplings;
+
+   gm2calc_thdm_calculate_amu_gauge_basis_list(
+      basis, n, &sm, &config, config_flags.loopOrder,
+      threads > 0 ? (unsigned)threads : 0, amu, damu, status);
+
+   create_list_output(n, amu, damu, status);
+
+   free(status);
+   free(damu);
+   free(amu);
+   free(basis);
+}
+
+/******************************************************************/
+
+void GM2CalcAmuTHDMMassBasisListPacked(double* data, long len, int threads)
+{
+   size_t i, n;
+   gm2calc_THDM_mass_basis* basis = 0;
+   double *amu = 0, *damu = 0;
+   gm2calc_error* status = 0;
+   gm2calc_THDM_config config;
+
+   if (!check_thdm_list("GM2CalcAmuTHDMMassBasisList", data, len)) {
+      create_error_output();
+      return;
+   }
+
+   n = (size_t)(len / THDM_LIST_COLUMNS);
+   basis = (gm2calc_THDM_mass_basis*)malloc((n > 0 ? n : 1) * sizeof(gm2calc_THDM_mass_basis));
+   amu = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+   damu = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+   status = (gm2calc_error*)malloc((n > 0 ? n : 1) * sizeof(gm2calc_error));
+
+   for (i = 0; i < n; i++) {
+      const double* row = data + i*THDM_LIST_COLUMNS;
+      gm2calc_THDM_mass_basis* b = basis + i;
+      b->yukawa_type = int_to_c_yukawa_type((int)row[0]);
+      b->mh = row[1];
+      b->mH = row[2];
+      b->mA = row[3];
+      b->mHp = row[4];
+      b->sin_beta_minus_alpha = row[5];
+      b->lambda_6 = row[6];
+      b->lambda_7 = row[7];
+      b->tan_beta = row[8];
+      b->m122 = row[9];
+      b->zeta_u = row[10];
+      b->zeta_d = row[11];
+      b->zeta_l = row[12];
+      fill_thdm_couplings(b->Delta_u, b->Delta_d, b->Delta_l,
+                          b->Pi_u, b->Pi_d, b->Pi_l, row + 13);
+   }
+
+   config.force_output = config_flags.forceOutput;
+   config.running_couplings = config_flags.runningCouplings;
+
+   gm2calc_thdm_calculate_amu_mass_basis_list(
+      basis, n, &sm, &config, config_flags.loopOrder,
+      threads > 0 ? (unsigned)threads : 0, amu, damu, status);
+
+   create_list_output(n, amu, damu, status);
+
+   free(status);
+   free(damu);
+   free(amu);
+   free(basis);
+}
+
+/******************************************************************/
+
+/* number of input parameters per GM2Calc-scheme point of a list */
+#define GM2CALC_SCHEME_LIST_COLUMNS 26
+
+void GM2CalcAmuGM2CalcSchemeListPacked(double* data, long len, int threads)
+{
+   size_t i, n;
+   MSSMNoFV_onshell** models = 0;
+   double *amu = 0, *damu = 0;
+   gm2calc_error* status = 0;
+
+   if (len % GM2CALC_SCHEME_LIST_COLUMNS != 0) {
+      put_error_message("GM2CalcAmuGM2CalcSchemeList", "error",
+                        "Malformed list of parameter points.");
+      create_error_output();
+      return;
+   }
+
+   n = (size_t)(len / GM2CALC_SCHEME_LIST_COLUMNS);
+   models = (MSSMNoFV_onshell**)malloc((n > 0 ? n : 1) * sizeof(MSSMNoFV_onshell*));
+   amu = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+   damu = (double*)malloc((n > 0 ? n : 1) * sizeof(double));
+   status = (gm2calc_error*)malloc((n > 0 ? n : 1) * sizeof(gm2calc_error));
+
+   for (i = 0; i < n; i++) {
+      const double* row = data + i*GM2CALC_SCHEME_LIST_COLUMNS;
+      struct GM2Calc_parameters pars;
+      initialize_gm2calc_parameters(&pars);
+
+      pars.MAh       = row[0];
+      pars.TB        = row[1];
+      pars.Mu        = row[2];
+      pars.MassB     = row[3];
+      pars.MassWB    = row[4];
+      pars.MassG     = row[5];
+      pars.mq2[0][0] = row[6];
+      pars.mq2[1][1] = row[7];
+      pars.mq2[2][2] = row[8];
+      pars.ml2[0][0] = row[9];
+      pars.ml2[1][1] = row[10];
+      pars.ml2[2][2] = row[11];
+      pars.mu2[0][0] = row[12];
+      pars.mu2[1][1] = row[13];
+      pars.mu2[2][2] = row[14];
+      pars.md2[0][0] = row[15];
+      pars.md2[1][1] = row[16];
+      pars.md2[2][2] = row[17];
+      pars.me2[0][0] = row[18];
+      pars.me2[1][1] = row[19];
+      pars.me2[2][2] = row[20];
+      pars.Au[2][2]  = row[21];
+      pars.Ad[2][2]  = row[22];
+      pars.Ae[1][1]  = row[23];
+      pars.Ae[2][2]  = row[24];
+      pars.Q         = row[25];
+
+      models[i] = gm2calc_mssmnofv_new();
+      fill_model_gm2calc_scheme(models[i], &pars);
+   }
+
+   gm2calc_mssmnofv_calculate_amu_gm2calc_scheme_list(
+      models, n, config_flags.loopOrder, config_flags.tanBetaResummation,
+      threads > 0 ? (unsigned)threads : 0, amu, damu, status);
+
+   create_list_output(n, amu, damu, status);
+
+   for (i = 0; i < n; i++) {
+      gm2calc_mssmnofv_free(models[i]);
+   }
+
+   free(status);
+   free(damu);
+   free(amu);
+   free(models);
+}
+
+/******************************************************************/
+
 int main(int argc, char *argv[])
 {
    gm2calc_sm_set_to_default(&sm);
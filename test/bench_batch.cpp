@@ -0,0 +1,247 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+/**
+ * @file bench_batch.cpp
+ * @brief throughput of the batch queue compared to the C interface
+ *
+ * Usage:
+ *
+ *    bench_batch.x [--points=<n>] [--threads=<n>] [--capacity=<n>]
+ *
+ * The same pseudo-random THDM parameter points are evaluated
+ *
+ * - one after the other with the C interface (construction of the
+ *   model, 1- and 2-loop contributions and uncertainty),
+ * - through a Batch_queue in the memory of the process with 1 and
+ *   <threads> worker threads,
+ * - through a Batch_queue in POSIX shared memory with <threads>
+ *   worker threads (if supported).
+ *
+ * The number of points per second is printed for each method.
+ */
+
+#include "gm2calc/gm2_1loop.h"
+#include "gm2calc/gm2_2loop.h"
+#include "gm2calc/gm2_batch.hpp"
+#include "gm2calc/gm2_uncertainty.h"
+#include "gm2calc/SM.h"
+#include "gm2calc/THDM.h"
+
+#include "stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// benchmark options
+struct Bench_options {
+   unsigned points{2000};   ///< number of parameter points
+   unsigned threads{std::max(1u, std::thread::hardware_concurrency())}; ///< number of worker threads
+   unsigned capacity{1024}; ///< queue capacity
+};
+
+/// prevents the compiler from optimizing away benchmarked results
+volatile double sink = 0.0;
+
+double sqr(double x) noexcept { return x*x; }
+
+/// THDM mass basis records (type 2) with pseudo-random masses
+std::vector<gm2calc::Batch_record> make_records(unsigned n)
+{
+   std::minstd_rand generator(1);
+   std::uniform_real_distribution<double> rMH(300, 500);
+   std::uniform_real_distribution<double> rTB(1, 10);
+
+   std::vector<gm2calc::Batch_record> records(n);
+
+   for (auto& r: records) {
+      const double in[13] = {
+         2, 125, rMH(generator), rMH(generator), rMH(generator), 0.995,
+         0.1, 0.2, rTB(generator), sqr(rMH(generator)), 0, 0, 0
+      };
+      r.type = gm2calc::Batch_thdm_mass_basis;
+      std::copy(in, in + 13, r.input);
+   }
+
+   return records;
+}
+
+/// RAII wrapper for C interface THDM handle
+struct C_thdm_deleter {
+   void operator()(gm2calc_THDM* model) const { gm2calc_thdm_free(model); }
+};
+
+/// evaluates the records one after the other with the C interface
+void run_c_interface(std::vector<gm2calc::Batch_record>& records)
+{
+   gm2calc_SM sm;
+   gm2calc_THDM_config config;
+   gm2calc_sm_set_to_default(&sm);
+   gm2calc_thdm_config_set_to_default(&config);
+
+   for (auto& r: records) {
+      gm2calc_THDM_mass_basis basis{};
+      basis.yukawa_type = static_cast<gm2calc_THDM_yukawa_type>(static_cast<int>(r.input[0]));
+      basis.mh = r.input[1];
+      basis.mH = r.input[2];
+      basis.mA = r.input[3];
+      basis.mHp = r.input[4];
+      basis.sin_beta_minus_alpha = r.input[5];
+      basis.lambda_6 = r.input[6];
+      basis.lambda_7 = r.input[7];
+      basis.tan_beta = r.input[8];
+      basis.m122 = r.input[9];
+      basis.zeta_u = r.input[10];
+      basis.zeta_d = r.input[11];
+      basis.zeta_l = r.input[12];
+
+      gm2calc_THDM* ptr = nullptr;
+      const auto error = gm2calc_thdm_new_with_mass_basis(&ptr, &basis, &sm, &config);
+      std::unique_ptr<gm2calc_THDM, C_thdm_deleter> model(ptr);
+
+      if (error != gm2calc_NoError) {
+         r.amu = r.damu = std::nan("");
+         continue;
+      }
+
+      r.amu = gm2calc_thdm_calculate_amu_1loop(model.get())
+         + gm2calc_thdm_calculate_amu_2loop(model.get());
+      r.damu = gm2calc_thdm_calculate_uncertainty_amu_2loop(model.get());
+   }
+}
+
+/// evaluates the records through the queue with the given number of workers
+void run_queue(gm2calc::Batch_queue& queue, unsigned threads,
+               std::vector<gm2calc::Batch_record>& records)
+{
+   gm2calc::Batch_worker_pool workers(queue, threads);
+   queue.process(records.data(), records.size());
+}
+
+/// runs the function and prints the throughput
+template <class F>
+void measure(const std::string& name, std::vector<gm2calc::Batch_record> records, const F& f)
+{
+   gm2calc::Stopwatch sw;
+   sw.start();
+   f(records);
+   sw.stop();
+
+   double sum = 0.0;
+   for (const auto& r: records) {
+      sum += r.amu;
+   }
+   sink = sink + sum;
+
+   std::cout << std::left << std::setw(32) << name << std::right
+             << std::setw(14) << std::fixed << std::setprecision(1)
+             << records.size() / sw.get_time_in_seconds()
+             << std::setw(16) << std::scientific << std::setprecision(8) << sum
+             << '\n';
+}
+
+bool starts_with(const std::string& str, const std::string& prefix)
+{
+   return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+unsigned to_unsigned(const std::string& str)
+{
+   return std::max(1u, static_cast<unsigned>(std::stoul(str)));
+}
+
+Bench_options get_options(int argc, const char* argv[])
+{
+   Bench_options options;
+
+   for (int i = 1; i < argc; ++i) {
+      const std::string arg(argv[i]);
+      if (starts_with(arg, "--points=")) {
+         options.points = to_unsigned(arg.substr(9));
+      } else if (starts_with(arg, "--threads=")) {
+         options.threads = to_unsigned(arg.substr(10));
+      } else if (starts_with(arg, "--capacity=")) {
+         options.capacity = to_unsigned(arg.substr(11));
+      } else if (arg == "--help" || arg == "-h") {
+         std::cout << "Usage: " << argv[0]
+                   << " [--points=<n>] [--threads=<n>] [--capacity=<n>]\n";
+         std::exit(EXIT_SUCCESS);
+      } else {
+         std::cerr << "Error: unrecognized option: " << arg << '\n';
+         std::exit(EXIT_FAILURE);
+      }
+   }
+
+   return options;
+}
+
+} // anonymous namespace
+
+int main(int argc, const char* argv[])
+{
+   const auto options = get_options(argc, argv);
+   const auto records = make_records(options.points);
+   const std::string threads = std::to_string(options.threads);
+
+   std::cout << "# " << options.points << " THDM points, queue capacity "
+             << options.capacity << '\n'
+             << std::left << std::setw(32) << "# method" << std::right
+             << std::setw(14) << "points/s" << std::setw(16) << "sum(amu)" << '\n';
+
+   measure("c/thdm_new_and_calculate_amu", records, run_c_interface);
+
+   measure("batch/private/1", records, [&] (std::vector<gm2calc::Batch_record>& r) {
+      gm2calc::Batch_queue queue(options.capacity);
+      run_queue(queue, 1, r);
+   });
+
+   measure("batch/private/" + threads, records, [&] (std::vector<gm2calc::Batch_record>& r) {
+      gm2calc::Batch_queue queue(options.capacity);
+      run_queue(queue, options.threads, r);
+   });
+
+#if defined(__unix__) || defined(__APPLE__)
+   try {
+      const std::string name = "/gm2calc_bench_batch_" + std::to_string(::getpid());
+      measure("batch/shm/" + threads, records, [&] (std::vector<gm2calc::Batch_record>& r) {
+         gm2calc::Batch_queue queue(name, options.capacity);
+         run_queue(queue, options.threads, r);
+      });
+   } catch (const std::exception& e) {
+      std::cerr << "batch/shm: " << e.what() << '\n';
+   }
+#endif
+
+   return 0;
+}
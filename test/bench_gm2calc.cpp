@@ -0,0 +1,771 @@
+// ====================================================================
+// This file is part of GM2Calc.
+//
+// GM2Calc is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License,
+// or (at your option) any later version.
+//
+// GM2Calc is distributed in the hope that it will be useful, but
+// WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with GM2Calc.  If not, see
+// <http://www.gnu.org/licenses/>.
+// ====================================================================
+
+/**
+ * @file bench_gm2calc.cpp
+ * @brief benchmark suite for GM2Calc
+ *
+ * Usage:
+ *
+ *    bench_gm2calc.x [--warmup=<n>] [--repetitions=<n>] [--points=<n>]
+ *                    [--filter=<substring>] [--json=<file>|-]
+ *
+ * Each benchmark is run on a fixed set of pseudo-random parameter
+ * points.  After the warm-up runs, the time per point is measured in
+ * each repetition.  The mean, standard deviation and percentiles
+ * over all repetitions are printed as a table and can optionally be
+ * written in JSON format for regression tracking.  If a benchmark
+ * throws, the error is printed and the exit code is non-zero.
+ */
+
+#include "gm2calc/gm2_1loop.h"
+#include "gm2calc/gm2_2loop.h"
+#include "gm2calc/gm2_error.h"
+#include "gm2calc/gm2_uncertainty.h"
+#include "gm2calc/MSSMNoFV_onshell.h"
+#include "gm2calc/SM.h"
+#include "gm2calc/THDM.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/gm2_version.h"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include "gm2_slha_io.hpp"
+
+#include "stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define GM2CALC_HAVE_RDTSC 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define GM2CALC_HAVE_RDTSC 1
+#endif
+
+namespace {
+
+const char* const example_slha_file = TEST_DATA_DIR "/../../input/example.slha";
+const char* const example_thdm_file = TEST_DATA_DIR "/../../input/example.thdm";
+
+/// prevents the compiler from optimizing away benchmarked results
+volatile double sink = 0.0;
+
+double sqr(double x) noexcept { return x*x; }
+
+/// reads the CPU time stamp counter (or 0 if not available)
+std::uint64_t read_cycles() noexcept
+{
+#ifdef GM2CALC_HAVE_RDTSC
+   return __rdtsc();
+#else
+   return 0;
+#endif
+}
+
+/// benchmark options
+struct Bench_options {
+   unsigned warmup{2};         ///< number of warm-up runs
+   unsigned repetitions{10};   ///< number of timed repetitions
+   unsigned points{200};       ///< number of parameter points per run
+   std::string filter;         ///< run only benchmarks containing this string
+   std::string json_output;    ///< JSON output file (- for stdout)
+};
+
+/// timing statistics of a single benchmark
+struct Bench_result {
+   std::string name;           ///< benchmark name
+   unsigned points{0};         ///< number of points per repetition
+   unsigned repetitions{0};    ///< number of repetitions
+   double mean{0};             ///< mean time per point [ns]
+   double stddev{0};           ///< standard deviation of time per point [ns]
+   double min{0};              ///< minimum time per point [ns]
+   double p05{0};              ///< 5% percentile of time per point [ns]
+   double median{0};           ///< median time per point [ns]
+   double p95{0};              ///< 95% percentile of time per point [ns]
+   double max{0};              ///< maximum time per point [ns]
+   double cycles{0};           ///< median CPU cycles per point (0 = unavailable)
+};
+
+/**
+ * A benchmark runs a function over a set of prepared points.  The
+ * function receives the point index and returns a value that is fed
+ * into the sink.
+ */
+struct Benchmark {
+   std::string name;
+   std::function<void(unsigned)> prepare; ///< prepares n points (not timed)
+   std::function<double(unsigned)> run;   ///< evaluates the i-th point
+};
+
+/// linearly interpolated percentile of sorted data
+double percentile(const std::vector<double>& sorted, double p)
+{
+   if (sorted.empty()) {
+      return 0.0;
+   }
+   const double pos = p*(sorted.size() - 1);
+   const auto lo = static_cast<std::size_t>(std::floor(pos));
+   const auto hi = std::min(lo + 1, sorted.size() - 1);
+   const double frac = pos - lo;
+   return sorted[lo]*(1 - frac) + sorted[hi]*frac;
+}
+
+Bench_result run_benchmark(const Benchmark& bench, const Bench_options& options)
+{
+   const unsigned N = std::max(options.points, 1U);
+
+   if (bench.prepare) {
+      bench.prepare(N);
+   }
+
+   const auto run_all = [&bench, N] {
+      double sum = 0.0;
+      for (unsigned i = 0; i < N; ++i) {
+         sum += bench.run(i);
+      }
+      sink = sink + sum;
+   };
+
+   for (unsigned w = 0; w < options.warmup; ++w) {
+      run_all();
+   }
+
+   std::vector<double> times, cycles;
+   times.reserve(options.repetitions);
+   cycles.reserve(options.repetitions);
+
+   for (unsigned r = 0; r < std::max(options.repetitions, 1U); ++r) {
+      gm2calc::Stopwatch sw;
+      const auto c0 = read_cycles();
+      sw.start();
+      run_all();
+      sw.stop();
+      const auto c1 = read_cycles();
+      times.push_back(sw.get_time_in_nanoseconds()/N);
+      cycles.push_back(static_cast<double>(c1 - c0)/N);
+   }
+
+   std::sort(times.begin(), times.end());
+   std::sort(cycles.begin(), cycles.end());
+
+   const double n = times.size();
+   const double mean = std::accumulate(times.begin(), times.end(), 0.0)/n;
+   const double var = std::accumulate(
+      times.begin(), times.end(), 0.0,
+      [mean] (double s, double t) { return s + sqr(t - mean); })/std::max(n - 1, 1.0);
+
+   Bench_result res;
+   res.name = bench.name;
+   res.points = N;
+   res.repetitions = times.size();
+   res.mean = mean;
+   res.stddev = std::sqrt(var);
+   res.min = times.front();
+   res.p05 = percentile(times, 0.05);
+   res.median = percentile(times, 0.5);
+   res.p95 = percentile(times, 0.95);
+   res.max = times.back();
+   res.cycles = percentile(cycles, 0.5);
+
+   return res;
+}
+
+// === random parameter points ===
+
+/// random number generator with fixed seed for reproducibility
+std::minstd_rand generator;
+
+double random(double start, double stop)
+{
+   std::uniform_real_distribution<double> dist(start, stop);
+   return dist(generator);
+}
+
+double rMS() { return random(400, 500); }
+double rMH() { return random(130, 200); }
+double rTB() { return random(5, 100); }
+
+void fill_sm(gm2calc::MSSMNoFV_onshell& model)
+{
+   const double Pi = 3.141592653589793;
+   model.set_alpha_MZ(0.0077552);
+   model.set_alpha_thompson(0.00729735);
+   model.set_g3(std::sqrt(4 * Pi * 0.1184));
+   model.get_physical().MFt   = 173.34;
+   model.get_physical().MFb   = 4.18;
+   model.get_physical().MFm   = 0.1056583715;
+   model.get_physical().MFtau = 1.777;
+   model.get_physical().MVWm  = 80.385;
+   model.get_physical().MVZ   = 91.1876;
+}
+
+void fill_soft(gm2calc::MSSMNoFV_onshell& model)
+{
+   const Eigen::Matrix<double,3,3> UnitMatrix
+      = Eigen::Matrix<double,3,3>::Identity();
+
+   model.set_TB(rTB());
+   model.set_Mu(rMS());
+   model.set_MassB(rMS());
+   model.set_MassWB(rMS());
+   model.set_MassG(rMS());
+   model.set_mq2(sqr(rMS()) * UnitMatrix);
+   model.set_ml2(sqr(rMS()) * UnitMatrix);
+   model.set_md2(sqr(rMS()) * UnitMatrix);
+   model.set_mu2(sqr(rMS()) * UnitMatrix);
+   model.set_me2(sqr(rMS()) * UnitMatrix);
+   model.set_Au(0.0 * UnitMatrix);
+   model.set_Ad(0.0 * UnitMatrix);
+   model.set_Ae(0.0 * UnitMatrix);
+   model.set_scale(rMS());
+}
+
+/// random MSSM point in the SLHA scheme (not yet converted)
+gm2calc::MSSMNoFV_onshell random_point_slha()
+{
+   gm2calc::MSSMNoFV_onshell model;
+   model.do_force_output(true);
+   fill_sm(model);
+   fill_soft(model);
+   model.get_physical().MSvmL   = rMS();
+   model.get_physical().MSm(0)  = rMS();
+   model.get_physical().MSm(1)  = rMS();
+   model.get_physical().MChi(0) = rMS();
+   model.get_physical().MChi(1) = rMS();
+   model.get_physical().MChi(2) = rMS();
+   model.get_physical().MChi(3) = rMS();
+   model.get_physical().MCha(0) = rMS();
+   model.get_physical().MCha(1) = rMS();
+   model.get_physical().MAh(1)  = rMS();
+   return model;
+}
+
+/// random MSSM point in the GM2Calc scheme (no masses calculated yet)
+gm2calc::MSSMNoFV_onshell random_point_gm2calc()
+{
+   gm2calc::MSSMNoFV_onshell model;
+   model.do_force_output(true);
+   fill_sm(model);
+   fill_soft(model);
+   model.set_MA0(rMS());
+   return model;
+}
+
+/// random MSSM point in the GM2Calc scheme with calculated masses
+gm2calc::MSSMNoFV_onshell random_point_gm2calc_with_masses()
+{
+   auto model = random_point_gm2calc();
+   model.calculate_masses();
+   return model;
+}
+
+gm2calc::SM make_sm()
+{
+   gm2calc::SM sm;
+   sm.set_alpha_em_mz(1.0/127.934);
+   sm.set_mu(2, 172.5);
+   sm.set_mu(1, 1.42);
+   sm.set_md(2, 4.75);
+   sm.set_ml(2, 1.77684);
+   return sm;
+}
+
+gm2calc::thdm::Mass_basis random_mass_basis()
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::aligned;
+   basis.mh = 125;
+   basis.mH = rMH();
+   basis.mA = rMH();
+   basis.mHp = rMH();
+   basis.sin_beta_minus_alpha = 0.995;
+   basis.lambda_6 = 0.1;
+   basis.lambda_7 = 0.2;
+   basis.tan_beta = rTB();
+   basis.m122 = sqr(rMH());
+   basis.zeta_l = random(-10, 10);
+   return basis;
+}
+
+gm2calc::thdm::Gauge_basis random_gauge_basis()
+{
+   gm2calc::thdm::Gauge_basis basis;
+   basis.lambda << random(0.5, 0.9), random(0.4, 0.8), random(0.3, 0.7),
+      random(0.2, 0.6), random(0.1, 0.5), 0.2, 0.1;
+   basis.tan_beta = rTB();
+   basis.m122 = sqr(random(150, 250));
+   return basis;
+}
+
+gm2calc::thdm::Config make_thdm_config()
+{
+   gm2calc::thdm::Config config;
+   config.force_output = true;
+   return config;
+}
+
+std::string read_file(const std::string& file_name)
+{
+   std::ifstream ifs(file_name);
+   if (!ifs.good()) {
+      throw std::runtime_error("cannot read file " + file_name);
+   }
+   std::ostringstream oss;
+   oss << ifs.rdbuf();
+   return oss.str();
+}
+
+// === benchmark definitions ===
+
+/**
+ * Creates a benchmark which evaluates @a f on a vector of
+ * pre-computed points produced by @a make_point.
+ */
+template <class Point, class Make, class F>
+Benchmark make_point_benchmark(const std::string& name, Make make_point, F f)
+{
+   auto points = std::make_shared<std::vector<Point>>();
+
+   Benchmark bench;
+   bench.name = name;
+   bench.prepare = [points, make_point] (unsigned n) {
+      generator.seed(1);
+      points->clear();
+      points->reserve(n);
+      for (unsigned i = 0; i < n; ++i) {
+         points->push_back(make_point());
+      }
+   };
+   bench.run = [points, f] (unsigned i) { return f((*points)[i]); };
+
+   return bench;
+}
+
+std::vector<Benchmark> make_slha_benchmarks()
+{
+   std::vector<Benchmark> benchmarks;
+
+   auto slha_text = std::make_shared<std::string>();
+   auto thdm_text = std::make_shared<std::string>();
+   auto slha_io = std::make_shared<gm2calc::GM2_slha_io>();
+   auto thdm_io = std::make_shared<gm2calc::GM2_slha_io>();
+
+   const auto prepare = [=] (unsigned) {
+      *slha_text = read_file(example_slha_file);
+      *thdm_text = read_file(example_thdm_file);
+      std::istringstream slha_stream(*slha_text);
+      std::istringstream thdm_stream(*thdm_text);
+      *slha_io = gm2calc::GM2_slha_io();
+      slha_io->read_from_stream(slha_stream);
+      *thdm_io = gm2calc::GM2_slha_io();
+      thdm_io->read_from_stream(thdm_stream);
+   };
+
+   benchmarks.push_back({
+      "slha/read_from_stream", prepare,
+      [=] (unsigned) {
+         gm2calc::GM2_slha_io io;
+         std::istringstream istr(*slha_text);
+         io.read_from_stream(istr);
+         return 1.0;
+      }});
+
+   benchmarks.push_back({
+      "slha/fill_slha", prepare,
+      [=] (unsigned) {
+         gm2calc::MSSMNoFV_onshell model;
+         slha_io->fill_slha(model);
+         return model.get_TB();
+      }});
+
+   benchmarks.push_back({
+      "slha/read_and_fill_slha", prepare,
+      [=] (unsigned) {
+         gm2calc::GM2_slha_io io;
+         std::istringstream istr(*slha_text);
+         io.read_from_stream(istr);
+         gm2calc::MSSMNoFV_onshell model;
+         io.fill_slha(model);
+         return model.get_TB();
+      }});
+
+   benchmarks.push_back({
+      "slha/fill_thdm_mass_basis", prepare,
+      [=] (unsigned) {
+         gm2calc::SM sm;
+         gm2calc::thdm::Mass_basis basis;
+         thdm_io->fill(sm);
+         thdm_io->fill(basis);
+         return basis.mA;
+      }});
+
+   return benchmarks;
+}
+
+std::vector<Benchmark> make_mssm_benchmarks()
+{
+   using Model = gm2calc::MSSMNoFV_onshell;
+
+   std::vector<Benchmark> benchmarks;
+
+   benchmarks.push_back(make_point_benchmark<Model>(
+      "mssm/convert_to_onshell", random_point_slha,
+      [] (const Model& point) {
+         Model model(point);
+         model.convert_to_onshell();
+         return model.get_Mu();
+      }));
+
+   benchmarks.push_back(make_point_benchmark<Model>(
+      "mssm/calculate_masses", random_point_gm2calc,
+      [] (const Model& point) {
+         Model model(point);
+         model.calculate_masses();
+         return model.get_MSm(0);
+      }));
+
+   const std::vector<std::pair<std::string, double(*)(const Model&)>> contributions = {
+      {"mssm/amu1LChi0"          , gm2calc::amu1LChi0},
+      {"mssm/amu1LChipm"         , gm2calc::amu1LChipm},
+      {"mssm/amu2LFSfapprox"     , gm2calc::amu2LFSfapprox},
+      {"mssm/amu2LChipmPhotonic" , gm2calc::amu2LChipmPhotonic},
+      {"mssm/amu2LChi0Photonic"  , gm2calc::amu2LChi0Photonic},
+      {"mssm/amu2LaSferm"        , gm2calc::amu2LaSferm},
+      {"mssm/amu2LaCha"          , gm2calc::amu2LaCha},
+      {"mssm/calculate_amu_1loop", gm2calc::calculate_amu_1loop},
+      {"mssm/calculate_amu_2loop", gm2calc::calculate_amu_2loop},
+      {"mssm/calculate_uncertainty_amu_2loop", gm2calc::calculate_uncertainty_amu_2loop},
+   };
+
+   for (const auto& c: contributions) {
+      const auto f = c.second;
+      benchmarks.push_back(make_point_benchmark<Model>(
+         c.first, random_point_gm2calc_with_masses,
+         [f] (const Model& model) { return f(model); }));
+   }
+
+   return benchmarks;
+}
+
+std::vector<Benchmark> make_thdm_benchmarks()
+{
+   using gm2calc::THDM;
+   using gm2calc::thdm::Gauge_basis;
+   using gm2calc::thdm::Mass_basis;
+
+   std::vector<Benchmark> benchmarks;
+
+   benchmarks.push_back(make_point_benchmark<Mass_basis>(
+      "thdm/construct_mass_basis", random_mass_basis,
+      [] (const Mass_basis& basis) {
+         const THDM model(basis, make_sm(), make_thdm_config());
+         return model.get_MAh(1);
+      }));
+
+   benchmarks.push_back(make_point_benchmark<Gauge_basis>(
+      "thdm/construct_gauge_basis", random_gauge_basis,
+      [] (const Gauge_basis& basis) {
+         const THDM model(basis, make_sm(), make_thdm_config());
+         return model.get_MAh(1);
+      }));
+
+   const auto make_model = [] {
+      return THDM(random_mass_basis(), make_sm(), make_thdm_config());
+   };
+
+   const std::vector<std::pair<std::string, double(*)(const THDM&)>> contributions = {
+      {"thdm/calculate_amu_1loop"          , gm2calc::calculate_amu_1loop},
+      {"thdm/calculate_amu_2loop_bosonic"  , gm2calc::calculate_amu_2loop_bosonic},
+      {"thdm/calculate_amu_2loop_fermionic", gm2calc::calculate_amu_2loop_fermionic},
+      {"thdm/calculate_amu_2loop"          , gm2calc::calculate_amu_2loop},
+      {"thdm/calculate_uncertainty_amu_2loop", gm2calc::calculate_uncertainty_amu_2loop},
+   };
+
+   for (const auto& c: contributions) {
+      const auto f = c.second;
+      benchmarks.push_back(make_point_benchmark<THDM>(
+         c.first, make_model, [f] (const THDM& model) { return f(model); }));
+   }
+
+   return benchmarks;
+}
+
+/// RAII wrapper for C interface MSSMNoFV handle
+struct C_mssmnofv_deleter {
+   void operator()(MSSMNoFV_onshell* model) const { gm2calc_mssmnofv_free(model); }
+};
+
+/// RAII wrapper for C interface THDM handle
+struct C_thdm_deleter {
+   void operator()(gm2calc_THDM* model) const { gm2calc_thdm_free(model); }
+};
+
+std::vector<Benchmark> make_c_interface_benchmarks()
+{
+   std::vector<Benchmark> benchmarks;
+
+   {
+      using Handle = std::shared_ptr<MSSMNoFV_onshell>;
+      auto models = std::make_shared<std::vector<Handle>>();
+
+      const auto prepare = [models] (unsigned n) {
+         generator.seed(1);
+         models->clear();
+         for (unsigned i = 0; i < n; ++i) {
+            Handle model(gm2calc_mssmnofv_new(), C_mssmnofv_deleter());
+            gm2calc_mssmnofv_set_alpha_MZ(model.get(), 0.0077552);
+            gm2calc_mssmnofv_set_alpha_thompson(model.get(), 0.00729735);
+            gm2calc_mssmnofv_set_g3(model.get(), 1.2);
+            gm2calc_mssmnofv_set_MT_pole(model.get(), 173.34);
+            gm2calc_mssmnofv_set_MB_running(model.get(), 4.18);
+            gm2calc_mssmnofv_set_MM_pole(model.get(), 0.1056583715);
+            gm2calc_mssmnofv_set_ML_pole(model.get(), 1.777);
+            gm2calc_mssmnofv_set_MW_pole(model.get(), 80.385);
+            gm2calc_mssmnofv_set_MZ_pole(model.get(), 91.1876);
+            gm2calc_mssmnofv_set_TB(model.get(), rTB());
+            gm2calc_mssmnofv_set_Mu(model.get(), rMS());
+            gm2calc_mssmnofv_set_MassB(model.get(), rMS());
+            gm2calc_mssmnofv_set_MassWB(model.get(), rMS());
+            gm2calc_mssmnofv_set_MassG(model.get(), rMS());
+            gm2calc_mssmnofv_set_MAh_pole(model.get(), rMS());
+            gm2calc_mssmnofv_set_scale(model.get(), rMS());
+            for (unsigned k = 0; k < 3; k++) {
+               gm2calc_mssmnofv_set_mq2(model.get(), k, k, sqr(rMS()));
+               gm2calc_mssmnofv_set_ml2(model.get(), k, k, sqr(rMS()));
+               gm2calc_mssmnofv_set_md2(model.get(), k, k, sqr(rMS()));
+               gm2calc_mssmnofv_set_mu2(model.get(), k, k, sqr(rMS()));
+               gm2calc_mssmnofv_set_me2(model.get(), k, k, sqr(rMS()));
+            }
+            gm2calc_mssmnofv_calculate_masses(model.get());
+            models->push_back(model);
+         }
+      };
+
+      benchmarks.push_back({
+         "c/mssmnofv_calculate_amu", prepare,
+         [models] (unsigned i) {
+            const auto* model = (*models)[i].get();
+            return gm2calc_mssmnofv_calculate_amu_1loop(model)
+               + gm2calc_mssmnofv_calculate_amu_2loop(model)
+               + gm2calc_mssmnofv_calculate_uncertainty_amu_2loop(model);
+         }});
+   }
+
+   {
+      auto bases = std::make_shared<std::vector<gm2calc_THDM_mass_basis>>();
+      auto sm = std::make_shared<gm2calc_SM>();
+      auto config = std::make_shared<gm2calc_THDM_config>();
+
+      const auto prepare = [bases, sm, config] (unsigned n) {
+         generator.seed(1);
+         gm2calc_sm_set_to_default(sm.get());
+         gm2calc_thdm_config_set_to_default(config.get());
+         config->force_output = 1;
+         bases->clear();
+         for (unsigned i = 0; i < n; ++i) {
+            gm2calc_THDM_mass_basis basis{};
+            basis.yukawa_type = gm2calc_THDM_type_2;
+            basis.mh = 125;
+            basis.mH = rMH();
+            basis.mA = rMH();
+            basis.mHp = rMH();
+            basis.sin_beta_minus_alpha = 0.995;
+            basis.lambda_6 = 0.1;
+            basis.lambda_7 = 0.2;
+            basis.tan_beta = rTB();
+            basis.m122 = sqr(rMH());
+            bases->push_back(basis);
+         }
+      };
+
+      benchmarks.push_back({
+         "c/thdm_new_and_calculate_amu", prepare,
+         [bases, sm, config] (unsigned i) {
+            gm2calc_THDM* ptr = nullptr;
+            const auto error = gm2calc_thdm_new_with_mass_basis(
+               &ptr, &(*bases)[i], sm.get(), config.get());
+            std::unique_ptr<gm2calc_THDM, C_thdm_deleter> model(ptr);
+            if (error != gm2calc_NoError) {
+               throw std::runtime_error(std::string("cannot create THDM: ") +
+                                        gm2calc_error_str(error));
+            }
+            return gm2calc_thdm_calculate_amu_1loop(model.get())
+               + gm2calc_thdm_calculate_amu_2loop(model.get())
+               + gm2calc_thdm_calculate_uncertainty_amu_2loop(model.get());
+         }});
+   }
+
+   return benchmarks;
+}
+
+std::vector<Benchmark> make_benchmarks()
+{
+   std::vector<Benchmark> benchmarks;
+
+   for (auto&& group: {make_slha_benchmarks(), make_mssm_benchmarks(),
+                       make_thdm_benchmarks(), make_c_interface_benchmarks()}) {
+      benchmarks.insert(benchmarks.end(), group.begin(), group.end());
+   }
+
+   return benchmarks;
+}
+
+// === output ===
+
+void print_table(std::ostream& ostr, const std::vector<Bench_result>& results)
+{
+   ostr << std::left << std::setw(42) << "# benchmark" << std::right
+        << std::setw(12) << "mean/ns" << std::setw(12) << "stddev/ns"
+        << std::setw(12) << "p05/ns" << std::setw(12) << "median/ns"
+        << std::setw(12) << "p95/ns" << std::setw(12) << "cycles" << '\n';
+
+   for (const auto& r: results) {
+      ostr << std::left << std::setw(42) << r.name << std::right
+           << std::fixed << std::setprecision(1)
+           << std::setw(12) << r.mean << std::setw(12) << r.stddev
+           << std::setw(12) << r.p05 << std::setw(12) << r.median
+           << std::setw(12) << r.p95 << std::setw(12) << r.cycles << '\n';
+   }
+}
+
+void print_json(std::ostream& ostr, const std::vector<Bench_result>& results,
+                const Bench_options& options)
+{
+   ostr << "{\n"
+        << "  \"gm2calc_version\": \"" << GM2CALC_VERSION << "\",\n"
+        << "  \"warmup\": " << options.warmup << ",\n"
+        << "  \"repetitions\": " << options.repetitions << ",\n"
+        << "  \"points\": " << options.points << ",\n"
+        << "  \"unit\": \"ns/point\",\n"
+        << "  \"benchmarks\": [\n";
+
+   ostr << std::setprecision(6) << std::scientific;
+
+   for (std::size_t i = 0; i < results.size(); ++i) {
+      const auto& r = results[i];
+      ostr << "    {\"name\": \"" << r.name << "\""
+           << ", \"points\": " << r.points
+           << ", \"repetitions\": " << r.repetitions
+           << ", \"mean\": " << r.mean
+           << ", \"stddev\": " << r.stddev
+           << ", \"min\": " << r.min
+           << ", \"p05\": " << r.p05
+           << ", \"median\": " << r.median
+           << ", \"p95\": " << r.p95
+           << ", \"max\": " << r.max
+           << ", \"cycles_per_point\": " << r.cycles
+           << '}' << (i + 1 < results.size() ? "," : "") << '\n';
+   }
+
+   ostr << "  ]\n}\n";
+}
+
+bool starts_with(const std::string& str, const std::string& prefix)
+{
+   return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+unsigned to_unsigned(const std::string& str)
+{
+   return static_cast<unsigned>(std::stoul(str));
+}
+
+Bench_options get_options(int argc, const char* argv[])
+{
+   Bench_options options;
+
+   for (int i = 1; i < argc; ++i) {
+      const std::string arg(argv[i]);
+      if (starts_with(arg, "--warmup=")) {
+         options.warmup = to_unsigned(arg.substr(9));
+      } else if (starts_with(arg, "--repetitions=")) {
+         options.repetitions = to_unsigned(arg.substr(14));
+      } else if (starts_with(arg, "--points=")) {
+         options.points = to_unsigned(arg.substr(9));
+      } else if (starts_with(arg, "--filter=")) {
+         options.filter = arg.substr(9);
+      } else if (starts_with(arg, "--json=")) {
+         options.json_output = arg.substr(7);
+      } else if (arg == "--help" || arg == "-h") {
+         std::cout << "Usage: " << argv[0]
+                   << " [--warmup=<n>] [--repetitions=<n>] [--points=<n>]"
+                      " [--filter=<substring>] [--json=<file>|-]\n";
+         std::exit(EXIT_SUCCESS);
+      } else {
+         std::cerr << "Error: unrecognized option: " << arg << '\n';
+         std::exit(EXIT_FAILURE);
+      }
+   }
+
+   return options;
+}
+
+} // anonymous namespace
+
+int main(int argc, const char* argv[])
+{
+   const auto options = get_options(argc, argv);
+   std::vector<Bench_result> results;
+   int exit_code = EXIT_SUCCESS;
+
+   for (const auto& bench: make_benchmarks()) {
+      if (!options.filter.empty() &&
+          bench.name.find(options.filter) == std::string::npos) {
+         continue;
+      }
+      try {
+         results.push_back(run_benchmark(bench, options));
+      } catch (const std::exception& e) {
+         std::cerr << "Error: benchmark " << bench.name << " failed: " << e.what() << '\n';
+         exit_code = EXIT_FAILURE;
+      }
+   }
+
+   if (options.json_output == "-") {
+      print_json(std::cout, results, options);
+   } else {
+      print_table(std::cout, results);
+      if (!options.json_output.empty()) {
+         std::ofstream ofs(options.json_output);
+         print_json(ofs, results, options);
+      }
+   }
+
+   return exit_code;
+}
@@ -25,33 +25,37 @@ namespace gm2calc {
 
 class Stopwatch {
 private:
-   using microseconds_t = std::chrono::duration<int,std::micro>;
+   using nanoseconds_t = std::chrono::duration<double,std::nano>;
 
-   microseconds_t::rep get_ticks() const {
-      microseconds_t duration(std::chrono::duration_cast<microseconds_t>(
-                                 stop_point - start_point));
+   nanoseconds_t::rep get_ticks() const {
+      nanoseconds_t duration(std::chrono::duration_cast<nanoseconds_t>(
+                                stop_point - start_point));
       return duration.count();
    }
 
 public:
    void start() {
-      start_point = std::chrono::high_resolution_clock::now();
+      start_point = std::chrono::steady_clock::now();
    }
 
    void stop() {
-      stop_point = std::chrono::high_resolution_clock::now();
+      stop_point = std::chrono::steady_clock::now();
    }
 
    double get_time_in_seconds() const {
-      return get_ticks() * 0.000001;
+      return get_ticks() * 1e-9;
    }
 
    double get_time_in_milliseconds() const {
-      return get_ticks() * 0.001;
+      return get_ticks() * 1e-6;
+   }
+
+   double get_time_in_nanoseconds() const {
+      return get_ticks();
    }
 
 private:
-   std::chrono::high_resolution_clock::time_point start_point, stop_point;
+   std::chrono::steady_clock::time_point start_point, stop_point;
 };
 
 } // namespace gm2calc
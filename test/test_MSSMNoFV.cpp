@@ -1,10 +1,18 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
 
 #include "doctest.h"
+#include "gm2calc/MSSMNoFV_amu_parameters.hpp"
 #include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_cancellation.hpp"
 #include "gm2calc/gm2_uncertainty.hpp"
 #include "gm2_linalg.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <string>
 #include <Eigen/Core>
 
 
@@ -220,6 +228,96 @@ TEST_CASE("conversion_to_onshell")
 }
 
 
+TEST_CASE("conversion_to_onshell_roundtrip")
+{
+   // on-shell parameters with a bino heavier than the wino
+   gm2calc::MSSMNoFV_onshell model(setup_gm2calc());
+   model.set_MassB(320);
+   model.set_MassWB(250);
+   model.set_me2(1, 1, 400 * 400);
+   model.calculate_masses();
+   model.get_physical().MChi = model.get_MChi();
+   model.get_physical().ZN = model.get_ZN();
+   model.get_physical().MCha = model.get_MCha();
+   model.get_physical().MSm = model.get_MSm();
+   model.get_physical().MSvmL = model.get_MSvmL();
+
+   const double Mu = model.get_Mu();
+   const double MassB = model.get_MassB();
+   const double MassWB = model.get_MassWB();
+   const double me211 = model.get_me2(1,1);
+
+   // start the conversion from a distant initial guess
+   model.set_verbose_output(false);
+   model.set_Mu(1.2 * Mu);
+   model.set_MassB(0.8 * MassB);
+   model.set_MassWB(1.1 * MassWB);
+   model.set_me2(1, 1, 1.3 * me211);
+   model.convert_to_onshell(1e-10);
+
+   CHECK(!model.get_problems().no_Mu_MassB_MassWB_convergence());
+   CHECK(!model.get_problems().no_me2_convergence());
+   CHECK_CLOSE(model.get_Mu()      , Mu    , 1e-9);
+   CHECK_CLOSE(model.get_MassB()   , MassB , 1e-9);
+   CHECK_CLOSE(model.get_MassWB()  , MassWB, 1e-9);
+   // me2(1,1) is affected by the final update of the resummed muon Yukawa coupling
+   CHECK_CLOSE(model.get_me2(1,1)  , me211 , 1e-8);
+}
+
+
+TEST_CASE("conversion_to_onshell_cancelled")
+{
+   gm2calc::MSSMNoFV_onshell model(setup_gm2calc());
+   model.calculate_masses();
+   model.get_physical().MChi = model.get_MChi();
+   model.get_physical().ZN = model.get_ZN();
+   model.get_physical().MCha = model.get_MCha();
+   model.get_physical().MSm = model.get_MSm();
+   model.get_physical().MSvmL = model.get_MSvmL();
+   model.set_verbose_output(false);
+   model.set_Mu(1.2 * model.get_Mu());
+   model.set_me2(1, 1, 1.3 * model.get_me2(1,1));
+
+   {
+      // deadline not reached: same result as without token
+      const gm2calc::Cancellation_token token(std::chrono::hours(1));
+      gm2calc::MSSMNoFV_onshell m1(model), m2(model);
+      m1.convert_to_onshell(1e-10);
+      m2.convert_to_onshell(1e-10, 1000, &token);
+      CHECK(!m2.get_problems().have_warning());
+      CHECK(m1.get_Mu() == m2.get_Mu());
+      CHECK(m1.get_me2(1,1) == m2.get_me2(1,1));
+   }
+
+   {
+      // deadline has passed: the iterations stop immediately
+      const gm2calc::Cancellation_token token(std::chrono::steady_clock::now());
+      gm2calc::MSSMNoFV_onshell m(model);
+      m.convert_to_onshell(1e-10, 1000, &token);
+      const auto& problems = m.get_problems();
+      CHECK(problems.conversion_cancelled());
+      CHECK(problems.no_Mu_MassB_MassWB_convergence());
+      CHECK(problems.no_me2_convergence());
+      CHECK(std::isfinite(problems.get_Mu_MassB_MassWB_convergence_problem().precision));
+      CHECK(problems.get_Mu_MassB_MassWB_convergence_problem().precision > 1e-10);
+      CHECK(problems.get_me2_convergence_problem().precision > 1e-10);
+      CHECK(problems.get_warnings().find("cancelled") != std::string::npos);
+
+      // the token is not kept by the model
+      m.convert_to_onshell(1e-10);
+      CHECK(!m.get_problems().have_warning());
+   }
+
+   {
+      gm2calc::Cancellation_token token;
+      CHECK(!token.has_deadline());
+      CHECK(!token.is_cancelled());
+      token.cancel();
+      CHECK(token.is_cancelled());
+   }
+}
+
+
 TEST_CASE("calculate_masses")
 {
    const double eps = 1e-15;
@@ -320,6 +418,31 @@ TEST_CASE("uncertainty-size")
 }
 
 
+TEST_CASE("amu_parameters")
+{
+   const auto model = setup_gm2calc();
+   const auto pars = gm2calc::make_amu_parameters(model);
+
+   // the parameters survive a round-trip through raw bytes
+   unsigned char bytes[sizeof(pars)];
+   std::memcpy(bytes, &pars, sizeof(pars));
+   gm2calc::MSSMNoFV_amu_parameters copy;
+   std::memcpy(&copy, bytes, sizeof(copy));
+
+   CHECK(copy.MM == model.get_MM());
+   CHECK(copy.ml2[1] == model.get_ml2(1,1));
+   CHECK(copy.ZN[2 + 4*1] == model.get_ZN(2,1));
+   CHECK(copy.UP[1] == model.get_UP(1,0));
+
+   CHECK(gm2calc::calculate_amu_1loop(copy) == gm2calc::calculate_amu_1loop(model));
+   CHECK(gm2calc::calculate_amu_2loop(copy) == gm2calc::calculate_amu_2loop(model));
+   CHECK(gm2calc::amu1LChi0(copy) == gm2calc::amu1LChi0(model));
+   CHECK(gm2calc::amu2LaCha(copy) == gm2calc::amu2LaCha(model));
+   CHECK(gm2calc::calculate_uncertainty_amu_2loop(copy) ==
+         gm2calc::calculate_uncertainty_amu_2loop(model));
+}
+
+
 TEST_CASE("print")
 {
    const auto model = setup_gm2calc();
@@ -363,6 +486,17 @@ TEST_CASE("problems")
       CHECK(!p.have_warning());
    }
 
+   {
+      gm2calc::MSSMNoFV_onshell_problems p;
+      p.flag_conversion_cancelled();
+      CHECK(!p.have_problem());
+      CHECK(p.have_warning());
+      CHECK(p.conversion_cancelled());
+      p.unflag_conversion_cancelled();
+      CHECK(!p.have_problem());
+      CHECK(!p.have_warning());
+   }
+
    {
       gm2calc::MSSMNoFV_onshell_problems p;
       p.flag_tachyon("h");
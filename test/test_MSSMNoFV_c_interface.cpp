@@ -4,14 +4,18 @@
 
 #include "gm2calc/gm2_1loop.h"
 #include "gm2calc/gm2_2loop.h"
+#include "gm2calc/gm2_batch.h"
 #include "gm2calc/gm2_uncertainty.h"
 #include "gm2calc/MSSMNoFV_onshell.h"
+#include "gm2_uncertainty_helpers.h"
 
 #include "gm2calc/gm2_1loop.hpp"
 #include "gm2calc/gm2_2loop.hpp"
 #include "gm2calc/gm2_uncertainty.hpp"
 #include "gm2calc/MSSMNoFV_onshell.hpp"
 
+#include <vector>
+
 #define CHECK_CLOSE(a,b,eps)                            \
    do {                                                 \
       CHECK((a) == doctest::Approx(b).epsilon(eps));    \
@@ -395,3 +399,82 @@ TEST_CASE("uncertainty-size")
    CHECK_GT(damu_0l, damu_1l);
    CHECK_GT(damu_1l, damu_2l);
 }
+
+
+TEST_CASE("gm2calc_scheme_list")
+{
+   const std::size_t n = 8;
+   std::vector<MSSMNoFV_onshell*> models(n);
+   std::vector<MSSMNoFV_onshell*> references(n);
+
+   for (std::size_t i = 0; i < n; i++) {
+      models[i] = gm2calc_mssmnofv_new();
+      references[i] = gm2calc_mssmnofv_new();
+      setup_gm2calc_scheme(models[i]);
+      gm2calc_mssmnofv_set_Mu(models[i], 300 + 20*i);
+      setup_gm2calc_scheme(references[i]);
+      gm2calc_mssmnofv_set_Mu(references[i], 300 + 20*i);
+   }
+
+   // tachyonic smuon
+   gm2calc_mssmnofv_set_ml2(models[3], 1, 1, -500*500);
+   gm2calc_mssmnofv_set_ml2(references[3], 1, 1, -500*500);
+
+   for (int loop_order = 0; loop_order <= 2; loop_order++) {
+      for (int tan_beta_resummation = 0; tan_beta_resummation <= 1; tan_beta_resummation++) {
+         std::vector<double> amu(n), damu(n);
+         std::vector<gm2calc_error> status(n);
+
+         gm2calc_mssmnofv_calculate_amu_gm2calc_scheme_list(
+            models.data(), n, loop_order, tan_beta_resummation, 3,
+            amu.data(), damu.data(), status.data());
+
+         CHECK(status[3] != gm2calc_NoError);
+
+         for (std::size_t i = 0; i < n; i++) {
+            MSSMNoFV_onshell* model = references[i];
+            gm2calc_error error = gm2calc_mssmnofv_calculate_masses(model);
+
+            if (error == gm2calc_NoError && gm2calc_mssmnofv_have_problem(model)) {
+               error = gm2calc_PhysicalProblem;
+            }
+
+            CHECK(status[i] == error);
+
+            if (error != gm2calc_NoError) {
+               CHECK(amu[i] == 0);
+               CHECK(damu[i] == 0);
+               continue;
+            }
+
+            double amu1L = 0, amu2L = 0;
+
+            if (loop_order > 0) {
+               amu1L = tan_beta_resummation
+                  ? gm2calc_mssmnofv_calculate_amu_1loop(model)
+                  : gm2calc_mssmnofv_calculate_amu_1loop_non_tan_beta_resummed(model);
+            }
+            if (loop_order > 1) {
+               amu2L = tan_beta_resummation
+                  ? gm2calc_mssmnofv_calculate_amu_2loop(model)
+                  : gm2calc_mssmnofv_calculate_amu_2loop_non_tan_beta_resummed(model);
+            }
+
+            CHECK(amu[i] == amu1L + amu2L);
+
+            if (loop_order == 0) {
+               CHECK(damu[i] == gm2calc_mssmnofv_calculate_uncertainty_amu_0loop_amu1L(model, amu1L));
+            } else if (loop_order == 1) {
+               CHECK(damu[i] == gm2calc_mssmnofv_calculate_uncertainty_amu_1loop_amu2L(model, amu2L));
+            } else {
+               CHECK(damu[i] == gm2calc_mssmnofv_calculate_uncertainty_amu_2loop(model));
+            }
+         }
+      }
+   }
+
+   for (std::size_t i = 0; i < n; i++) {
+      gm2calc_mssmnofv_free(models[i]);
+      gm2calc_mssmnofv_free(references[i]);
+   }
+}
@@ -0,0 +1,150 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+
+#include "MSSMNoFV/MSSMNoFV_onshell_cache.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+/// returns a model with DR-bar parameters (not yet converted)
+gm2calc::MSSMNoFV_onshell setup_slha(double tan_beta)
+{
+   gm2calc::MSSMNoFV_onshell model;
+
+   const double Pi = 3.141592653589793;
+   const Eigen::Matrix<double,3,3> UnitMatrix
+      = Eigen::Matrix<double,3,3>::Identity();
+
+   model.set_alpha_MZ(0.0077552);
+   model.set_alpha_thompson(0.00729735);
+   model.set_g3(std::sqrt(4 * Pi * 0.1184));
+   model.get_physical().MFt   = 173.34;
+   model.get_physical().MFb   = 4.18;
+   model.get_physical().MFm   = 0.1056583715;
+   model.get_physical().MFtau = 1.777;
+   model.get_physical().MVWm  = 80.385;
+   model.get_physical().MVZ   = 91.1876;
+   model.get_physical().MSvmL   = 5.18860573e+02;
+   model.get_physical().MSm(0)  = 5.05095249e+02;
+   model.get_physical().MSm(1)  = 5.25187016e+02;
+   model.get_physical().MChi(0) = 2.01611468e+02;
+   model.get_physical().MChi(1) = 4.10040273e+02;
+   model.get_physical().MChi(2) = 5.16529941e+02;
+   model.get_physical().MChi(3) = 5.45628749e+02;
+   model.get_physical().MCha(0) = 4.09989890e+02;
+   model.get_physical().MCha(1) = 5.46057190e+02;
+   model.get_physical().MAh(1)  = 1.50000000e+03;
+   model.set_TB(tan_beta);
+   model.set_Mu(500);
+   model.set_MassB(200);
+   model.set_MassWB(400);
+   model.set_MassG(2000);
+   model.set_mq2(7000 * 7000 * UnitMatrix);
+   model.set_ml2(500 * 500 * UnitMatrix);
+   model.set_md2(7000 * 7000 * UnitMatrix);
+   model.set_mu2(7000 * 7000 * UnitMatrix);
+   model.set_me2(500 * 500 * UnitMatrix);
+   model.set_scale(1000);
+
+   return model;
+}
+
+double calculate_amu(const gm2calc::MSSMNoFV_onshell& model)
+{
+   return gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("cache_hit")
+{
+   const char* file_name = "test_MSSMNoFV_onshell_cache.bin";
+   std::remove(file_name);
+
+   auto reference = setup_slha(40);
+   reference.convert_to_onshell();
+
+   gm2calc::MSSMNoFV_onshell_cache cache(file_name);
+   CHECK(cache.size() == 0);
+
+   // first conversion is a miss
+   auto model1 = setup_slha(40);
+   cache.convert_to_onshell(model1);
+   CHECK(cache.get_misses() == 1);
+   CHECK(cache.get_hits() == 0);
+   CHECK(cache.size() == 1);
+
+   // second conversion of the same point is a hit
+   auto model2 = setup_slha(40);
+   cache.convert_to_onshell(model2);
+   CHECK(cache.get_misses() == 1);
+   CHECK(cache.get_hits() == 1);
+
+   CHECK(model2.get_Mu() == reference.get_Mu());
+   CHECK(model2.get_MassB() == reference.get_MassB());
+   CHECK(model2.get_me2(1,1) == reference.get_me2(1,1));
+   CHECK(model2.get_MSm(0) == reference.get_MSm(0));
+   CHECK(model2.get_MChi(0) == reference.get_MChi(0));
+   CHECK(model2.get_EL() == reference.get_EL());
+   CHECK(model2.get_MB() == reference.get_MB());
+   CHECK(calculate_amu(model2) == calculate_amu(reference));
+
+   // a different point is a miss
+   auto model3 = setup_slha(20);
+   cache.convert_to_onshell(model3);
+   CHECK(cache.get_misses() == 2);
+   CHECK(cache.size() == 2);
+
+   // a different precision goal is a miss
+   auto model4 = setup_slha(40);
+   cache.convert_to_onshell(model4, 1e-6);
+   CHECK(cache.get_misses() == 3);
+   CHECK(cache.size() == 3);
+}
+
+
+TEST_CASE("cache_persistence")
+{
+   const char* file_name = "test_MSSMNoFV_onshell_cache_persistence.bin";
+   std::remove(file_name);
+
+   double amu = 0;
+
+   {
+      gm2calc::MSSMNoFV_onshell_cache cache(file_name);
+      auto model = setup_slha(40);
+      cache.convert_to_onshell(model);
+      amu = calculate_amu(model);
+   }
+
+   gm2calc::MSSMNoFV_onshell_cache cache(file_name);
+   CHECK(cache.size() == 1);
+
+   auto model = setup_slha(40);
+   cache.convert_to_onshell(model);
+   CHECK(cache.get_hits() == 1);
+   CHECK(calculate_amu(model) == amu);
+}
+
+
+TEST_CASE("cache_invalid_file")
+{
+   const char* file_name = "test_MSSMNoFV_onshell_cache_invalid.bin";
+
+   {
+      std::ofstream ostr(file_name);
+      ostr << "Block SMINPUTS\n";
+   }
+
+   CHECK_THROWS_AS(gm2calc::MSSMNoFV_onshell_cache cache(file_name), gm2calc::EReadError);
+}
@@ -0,0 +1,236 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/MSSMNoFV_onshell_pool.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+/// number of heap allocations
+std::atomic<unsigned long> number_of_allocations{0};
+
+void* allocate(std::size_t size) noexcept
+{
+   number_of_allocations++;
+   return std::malloc(size ? size : 1);
+}
+
+} // anonymous namespace
+
+// All replaceable allocation and deallocation functions are replaced,
+// so that every new/delete pair uses malloc/free.  GCC (>= 11) does
+// not take the replacements into account and warns about free() on
+// pointers returned by operator new.
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+   if (void* p = allocate(size)) {
+      return p;
+   }
+   throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+   if (void* p = allocate(size)) {
+      return p;
+   }
+   throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+   return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+   return allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+   std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+   std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+   std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+   std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+gm2calc::MSSMNoFV_onshell setup()
+{
+   gm2calc::MSSMNoFV_onshell model;
+
+   const double Pi = 3.141592653589793;
+   const Eigen::Matrix<double,3,3> UnitMatrix
+      = Eigen::Matrix<double,3,3>::Identity();
+
+   model.set_alpha_MZ(0.0077552);
+   model.set_alpha_thompson(0.00729735);
+   model.set_g3(std::sqrt(4 * Pi * 0.1184));
+   model.get_physical().MFt   = 173.34;
+   model.get_physical().MFb   = 4.18;
+   model.get_physical().MFm   = 0.1056583715;
+   model.get_physical().MFtau = 1.777;
+   model.get_physical().MVWm  = 80.385;
+   model.get_physical().MVZ   = 91.1876;
+   model.set_TB(10);
+   model.set_Mu(350);
+   model.set_MassB(150);
+   model.set_MassWB(300);
+   model.set_MassG(1000);
+   model.set_mq2(500 * 500 * UnitMatrix);
+   model.set_ml2(500 * 500 * UnitMatrix);
+   model.set_md2(500 * 500 * UnitMatrix);
+   model.set_mu2(500 * 500 * UnitMatrix);
+   model.set_me2(500 * 500 * UnitMatrix);
+   model.set_MA0(1500);
+   model.set_scale(454.7);
+
+   return model;
+}
+
+double calculate_amu(const gm2calc::MSSMNoFV_onshell& model)
+{
+   return gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("reset")
+{
+   const gm2calc::MSSMNoFV_onshell reference;
+
+   auto model = setup();
+   model.calculate_masses();
+   model.get_problems().flag_tachyon("Sm");
+   model.reset();
+
+   CHECK(model.get_Mu() == reference.get_Mu());
+   CHECK(model.get_MassB() == reference.get_MassB());
+   CHECK(model.get_EL() == reference.get_EL());
+   CHECK(model.get_scale() == reference.get_scale());
+   CHECK(model.get_MM() == reference.get_MM());
+   CHECK(model.get_physical().MSm(0) == reference.get_physical().MSm(0));
+   CHECK(!model.get_problems().have_problem());
+}
+
+
+TEST_CASE("assign_inputs")
+{
+   const auto inputs = setup();
+
+   auto model = setup();
+   model.set_TB(20);
+   model.calculate_masses();
+   model.get_problems().flag_tachyon("Sm");
+   model.assign_inputs(inputs);
+
+   CHECK(model.get_TB() == inputs.get_TB());
+   CHECK(!model.get_problems().have_problem());
+
+   model.calculate_masses();
+
+   auto copy = inputs;
+   copy.calculate_masses();
+
+   CHECK(calculate_amu(model) == calculate_amu(copy));
+}
+
+
+TEST_CASE("pool")
+{
+   gm2calc::MSSMNoFV_onshell_pool pool;
+   pool.reserve(2);
+   CHECK(pool.size() == 2);
+
+   {
+      auto m1 = pool.acquire();
+      auto m2 = pool.acquire();
+      CHECK(pool.size() == 0);
+      const auto allocations_before = number_of_allocations.load();
+      auto m3 = pool.acquire(); // allocates a new model
+      CHECK(number_of_allocations.load() > allocations_before);
+      CHECK(m1.get() != m2.get());
+      CHECK(m2.get() != m3.get());
+   }
+
+   CHECK(pool.size() == 3);
+}
+
+
+TEST_CASE("pool_no_allocations_per_point")
+{
+   const auto inputs = setup();
+   auto& pool = gm2calc::MSSMNoFV_onshell_pool::thread_local_instance();
+   pool.reserve(1);
+
+   const auto scan = [&] (unsigned number_of_points) {
+      double sum = 0;
+      for (unsigned n = 0; n < number_of_points; n++) {
+         auto model = pool.acquire(inputs);
+         model->set_TB(2 + n);
+         model->calculate_masses();
+         sum += calculate_amu(*model);
+      }
+      return sum;
+   };
+
+   // warm-up
+   scan(1);
+
+   const auto allocations_before = number_of_allocations.load();
+   const double sum = scan(100);
+   const auto allocations_after = number_of_allocations.load();
+
+   CHECK(std::isfinite(sum));
+   CHECK(allocations_after == allocations_before);
+}
+
+
+TEST_CASE("thread_local_instance")
+{
+   CHECK(&gm2calc::MSSMNoFV_onshell_pool::thread_local_instance() ==
+         &gm2calc::MSSMNoFV_onshell_pool::thread_local_instance());
+}
@@ -0,0 +1,121 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_gradient.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using gm2calc::thdm::Amu_gradient;
+
+double calculate_amu(const gm2calc::thdm::Mass_basis& basis, const gm2calc::thdm::Config& config)
+{
+   const gm2calc::THDM model(basis, gm2calc::SM{}, config);
+   return gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model);
+}
+
+double& get_parameter(gm2calc::thdm::Mass_basis& basis, int i)
+{
+   switch (i) {
+   case Amu_gradient::mh: return basis.mh;
+   case Amu_gradient::mH: return basis.mH;
+   case Amu_gradient::mA: return basis.mA;
+   case Amu_gradient::mHp: return basis.mHp;
+   case Amu_gradient::sin_beta_minus_alpha: return basis.sin_beta_minus_alpha;
+   case Amu_gradient::lambda_6: return basis.lambda_6;
+   case Amu_gradient::lambda_7: return basis.lambda_7;
+   case Amu_gradient::tan_beta: return basis.tan_beta;
+   case Amu_gradient::m122: return basis.m122;
+   case Amu_gradient::zeta_u: return basis.zeta_u;
+   case Amu_gradient::zeta_d: return basis.zeta_d;
+   default: break;
+   }
+   return basis.zeta_l;
+}
+
+/// compares the gradient with central finite differences
+void test_gradient(const gm2calc::thdm::Mass_basis& basis,
+                   const gm2calc::thdm::Config& config = gm2calc::thdm::Config{})
+{
+   const gm2calc::THDM model(basis, gm2calc::SM{}, config);
+   const auto result = gm2calc::calculate_amu_gradient(model);
+   const double amu = calculate_amu(basis, config);
+
+   CHECK(result.amu == doctest::Approx(amu).epsilon(1e-14).scale(0));
+
+   for (int i = 0; i < Amu_gradient::NUMBER_OF_PARAMETERS; i++) {
+      INFO("parameter " << i);
+      if (i >= Amu_gradient::zeta_u && basis.yukawa_type != gm2calc::thdm::Yukawa_type::aligned) {
+         CHECK(result.gradient(i) == 0); // zeta_f is not an input
+         continue;
+      }
+      auto lo = basis, hi = basis;
+      const double p = get_parameter(hi, i);
+      const double h = 1e-5*std::max(1.0, std::abs(p));
+      get_parameter(hi, i) += h;
+      get_parameter(lo, i) -= h;
+      const double fd = (calculate_amu(hi, config) - calculate_amu(lo, config))/(2*h);
+      const double tol = 1e-5*(std::abs(fd) + std::abs(amu)/std::max(1.0, std::abs(p)));
+      CHECK(std::abs(result.gradient(i) - fd) <= tol);
+   }
+}
+
+gm2calc::thdm::Mass_basis make_basis(gm2calc::thdm::Yukawa_type type)
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = type;
+   basis.mh = 125;
+   basis.mH = 400;
+   basis.mA = 420;
+   basis.mHp = 440;
+   basis.sin_beta_minus_alpha = 0.95;
+   basis.lambda_6 = 0.2;
+   basis.lambda_7 = 0.1;
+   basis.tan_beta = 3;
+   basis.m122 = 40000;
+   return basis;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("type_2")
+{
+   test_gradient(make_basis(gm2calc::thdm::Yukawa_type::type_2));
+}
+
+
+TEST_CASE("type_X_fixed_couplings")
+{
+   gm2calc::thdm::Config config;
+   config.running_couplings = false;
+   test_gradient(make_basis(gm2calc::thdm::Yukawa_type::type_X), config);
+}
+
+
+TEST_CASE("aligned")
+{
+   auto basis = make_basis(gm2calc::thdm::Yukawa_type::aligned);
+   basis.zeta_u = 0.4;
+   basis.zeta_d = -2;
+   basis.zeta_l = 50;
+   basis.Delta_l(1,1) = 0.001;
+   test_gradient(basis);
+}
+
+
+TEST_CASE("general")
+{
+   auto basis = make_basis(gm2calc::thdm::Yukawa_type::general);
+   basis.Pi_u(2,2) = 0.5;
+   basis.Pi_d(2,2) = 0.1;
+   basis.Pi_l(1,1) = 0.002;
+   basis.Pi_l(2,2) = 0.05;
+   test_gradient(basis);
+}
@@ -4,9 +4,11 @@
 
 #include "gm2calc/gm2_1loop.h"
 #include "gm2calc/gm2_2loop.h"
+#include "gm2calc/gm2_batch.h"
 #include "gm2calc/gm2_uncertainty.h"
 #include "gm2calc/THDM.h"
 #include "gm2calc/SM.h"
+#include "gm2_uncertainty_helpers.h"
 
 #include "gm2calc/gm2_1loop.hpp"
 #include "gm2calc/gm2_2loop.hpp"
@@ -14,6 +16,7 @@
 #include "gm2calc/THDM.hpp"
 
 #include <utility>
+#include <vector>
 
 
 void setup_SM(gm2calc::SM& cppsm, gm2calc_SM& csm)
@@ -222,3 +225,71 @@ TEST_CASE("gauge_basis")
    test_gauge_basis(gm2calc::thdm::Yukawa_type::aligned);
    test_gauge_basis(gm2calc::thdm::Yukawa_type::general);
 }
+
+
+TEST_CASE("mass_basis_list")
+{
+   gm2calc_SM sm;
+   gm2calc_sm_set_to_default(&sm);
+
+   gm2calc_THDM_config config;
+   gm2calc_thdm_config_set_to_default(&config);
+
+   const std::size_t n = 20;
+   std::vector<gm2calc_THDM_mass_basis> bases(n);
+
+   for (std::size_t i = 0; i < n; i++) {
+      auto& b = bases[i];
+      b = gm2calc_THDM_mass_basis{};
+      b.yukawa_type = gm2calc_THDM_type_2;
+      b.mh = 125;
+      b.mH = 300 + 10*i;
+      b.mA = 420;
+      b.mHp = 440;
+      b.sin_beta_minus_alpha = 0.999;
+      b.tan_beta = 3;
+      b.m122 = 40000;
+   }
+
+   // invalid point
+   bases[5].tan_beta = -1;
+
+   for (int loop_order = 0; loop_order <= 2; loop_order++) {
+      std::vector<double> amu(n), damu(n);
+      std::vector<gm2calc_error> status(n);
+
+      gm2calc_thdm_calculate_amu_mass_basis_list(
+         bases.data(), n, &sm, &config, loop_order, 3,
+         amu.data(), damu.data(), status.data());
+
+      CHECK(status[5] == gm2calc_InvalidInput);
+
+      for (std::size_t i = 0; i < n; i++) {
+         gm2calc_THDM* model = nullptr;
+         const auto error = gm2calc_thdm_new_with_mass_basis(&model, &bases[i], &sm, &config);
+
+         CHECK(status[i] == error);
+
+         if (error != gm2calc_NoError) {
+            CHECK(amu[i] == 0);
+            CHECK(damu[i] == 0);
+            continue;
+         }
+
+         const double amu1L = loop_order > 0 ? gm2calc_thdm_calculate_amu_1loop(model) : 0;
+         const double amu2L = loop_order > 1 ? gm2calc_thdm_calculate_amu_2loop(model) : 0;
+
+         CHECK(amu[i] == amu1L + amu2L);
+
+         if (loop_order == 0) {
+            CHECK(damu[i] == gm2calc_thdm_calculate_uncertainty_amu_0loop_amu1L_amu2L(model, amu1L, amu2L));
+         } else if (loop_order == 1) {
+            CHECK(damu[i] == gm2calc_thdm_calculate_uncertainty_amu_1loop_amu1L_amu2L(model, amu1L, amu2L));
+         } else {
+            CHECK(damu[i] == gm2calc_thdm_calculate_uncertainty_amu_2loop_amu1L_amu2L(model, amu1L, amu2L));
+         }
+
+         gm2calc_thdm_free(model);
+      }
+   }
+}
@@ -0,0 +1,159 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/THDM_emulator.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace {
+
+gm2calc::thdm::Mass_basis make_basis()
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::type_X;
+   basis.mh = 125;
+   basis.mH = 400;
+   basis.mA = 50;
+   basis.mHp = 400;
+   basis.sin_beta_minus_alpha = 1;
+   basis.tan_beta = 40;
+   basis.m122 = 4000;
+   return basis;
+}
+
+gm2calc::thdm::Emulator_options make_options()
+{
+   gm2calc::thdm::Emulator_options options;
+   options.axes = {{"mA", 20, 100, 16, true}, {"tan_beta", 10, 100, 12}};
+   options.truncation = 1e-8;
+   options.samples = 200;
+   return options;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("build")
+{
+   const auto emulator = gm2calc::THDM_emulator::build(make_basis(), make_options());
+
+   CHECK(emulator.get_dimension() == 2);
+   CHECK(emulator.get_number_of_samples() == 200);
+   CHECK(emulator.get_number_of_coefficients() > 0);
+   CHECK(emulator.get_number_of_coefficients() < 16*12);
+
+   // the sampled error is small compared to a_mu
+   const double x0[2] = {20, 100};
+   const double amu_max = std::abs(emulator.evaluate_exact(x0));
+
+   CHECK(emulator.get_max_abs_error() > 0);
+   CHECK(emulator.get_max_abs_error() < 1e-7*amu_max);
+
+   // independent random points
+   std::mt19937_64 generator(42);
+   std::uniform_real_distribution<double> mA(20, 100), tb(10, 100);
+
+   for (int i = 0; i < 50; i++) {
+      const double x[2] = {mA(generator), tb(generator)};
+      INFO("mA = " << x[0] << ", tan(beta) = " << x[1]);
+      CHECK(std::abs(emulator.evaluate(x) - emulator.evaluate_exact(x)) < 2*emulator.get_max_abs_error());
+   }
+
+   // parameters outside of the box
+   const double x1[2] = {10, 50};
+   CHECK_THROWS_AS(emulator.evaluate(x1), gm2calc::EInvalidInput);
+   CHECK_THROWS_AS(emulator.evaluate(std::vector<double>{50}), gm2calc::EInvalidInput);
+}
+
+
+TEST_CASE("basis")
+{
+   gm2calc::thdm::Emulator_options options;
+   options.axes = {{"cos_beta_minus_alpha", 0, 0.1, 8}, {"zeta_l", -10, 10, 4}};
+   options.samples = 10;
+
+   auto basis = make_basis();
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::aligned;
+
+   const auto emulator = gm2calc::THDM_emulator::build(basis, options);
+
+   const double x[2] = {0.05, 3};
+   const auto b = emulator.get_basis(x);
+
+   CHECK(b.sin_beta_minus_alpha == doctest::Approx(std::sqrt(1 - 0.05*0.05)));
+   CHECK(b.zeta_l == 3);
+   CHECK(b.mA == basis.mA);
+   CHECK(emulator.evaluate(x) == doctest::Approx(emulator.evaluate_exact(x)).epsilon(1e-6));
+}
+
+
+TEST_CASE("write_read")
+{
+   const std::string file_name = "test_THDM_emulator.emu";
+   const auto emulator = gm2calc::THDM_emulator::build(make_basis(), make_options());
+
+   emulator.write(file_name);
+
+   const gm2calc::THDM_emulator emulator_read(file_name);
+
+   CHECK(emulator_read.get_dimension() == emulator.get_dimension());
+   CHECK(emulator_read.get_number_of_coefficients() == emulator.get_number_of_coefficients());
+   CHECK(emulator_read.get_max_abs_error() == emulator.get_max_abs_error());
+   CHECK(emulator_read.get_max_rel_error() == emulator.get_max_rel_error());
+   CHECK(emulator_read.get_axes()[0].log_scale);
+
+   const double x[2] = {42, 77};
+   CHECK(emulator_read.evaluate(x) == emulator.evaluate(x));
+   CHECK(emulator_read.evaluate_exact(x) == emulator.evaluate_exact(x));
+
+   std::ofstream(file_name, std::ios::trunc) << "not an emulator";
+   CHECK_THROWS_AS(gm2calc::THDM_emulator{file_name}, gm2calc::EReadError);
+
+   std::remove(file_name.c_str());
+
+   CHECK_THROWS_AS(gm2calc::THDM_emulator{file_name}, gm2calc::EReadError);
+}
+
+
+TEST_CASE("invalid_input")
+{
+   const auto basis = make_basis();
+   gm2calc::thdm::Emulator_options options;
+
+   // no parameters
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"mX", 0, 1, 4}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"yukawa_type", 1, 4, 4}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"mA", 100, 20, 4}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"zeta_l", -1, 1, 4, true}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"mA", 20, 100, 0}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"mA", 20, 100, 4}, {"mA", 20, 100, 4}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"cos_beta_minus_alpha", -0.1, 0.1, 4}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   options.axes = {{"cos_beta_minus_alpha", 0.5, 1.1, 4}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+
+   // invalid THDM parameters at the nodes
+   options.axes = {{"mH", -100, 100, 4}};
+   CHECK_THROWS_AS(gm2calc::THDM_emulator::build(basis, options), gm2calc::EInvalidInput);
+}
@@ -0,0 +1,229 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_batch.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+gm2calc::thdm::Mass_basis make_basis(double mH)
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::type_2;
+   basis.mh = 125;
+   basis.mH = mH;
+   basis.mA = 420;
+   basis.mHp = 440;
+   basis.sin_beta_minus_alpha = 0.999;
+   basis.tan_beta = 3;
+   basis.m122 = 40000;
+   return basis;
+}
+
+gm2calc::Batch_record make_record(const gm2calc::thdm::Mass_basis& basis)
+{
+   gm2calc::Batch_record r;
+   r.type = gm2calc::Batch_thdm_mass_basis;
+   const double in[13] = {
+      static_cast<double>(basis.yukawa_type), basis.mh, basis.mH, basis.mA,
+      basis.mHp, basis.sin_beta_minus_alpha, basis.lambda_6, basis.lambda_7,
+      basis.tan_beta, basis.m122, basis.zeta_u, basis.zeta_d, basis.zeta_l
+   };
+   std::copy(in, in + 13, r.input);
+   return r;
+}
+
+double calculate_amu(const gm2calc::thdm::Mass_basis& basis)
+{
+   const gm2calc::THDM model(basis);
+   return gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("evaluate")
+{
+   const auto basis = make_basis(400);
+   auto r = make_record(basis);
+   const gm2calc::THDM model(basis);
+
+   gm2calc::evaluate(r);
+
+   CHECK(r.amu == doctest::Approx(calculate_amu(basis)).epsilon(1e-14));
+   CHECK(r.damu == doctest::Approx(gm2calc::calculate_uncertainty_amu_2loop(model)).epsilon(1e-14));
+
+   r.input[0] = 2.5;
+   CHECK_THROWS_AS(gm2calc::evaluate(r), gm2calc::EInvalidInput);
+
+   r.type = 42;
+   CHECK_THROWS_AS(gm2calc::evaluate(r), gm2calc::EInvalidInput);
+}
+
+
+TEST_CASE("evaluate_columns")
+{
+   const int N = 20;
+   std::vector<double> mH(N);
+   std::vector<double> yukawa_type(N, 2);
+   std::vector<double> amu(N), damu(N);
+   std::vector<std::uint32_t> status(N);
+
+   for (int i = 0; i < N; i++) {
+      mH[i] = 300 + 10*i;
+   }
+
+   yukawa_type[5] = 7; // invalid
+
+   gm2calc::Batch_columns columns(gm2calc::Batch_thdm_mass_basis, N);
+   columns.set_column(0, yukawa_type.data());
+   columns.set_value(1, 125);
+   columns.set_column(2, mH.data());
+   columns.set_value(3, 420);
+   columns.set_value(4, 440);
+   columns.set_value(5, 0.999);
+   columns.set_value(8, 3);
+   columns.set_value(9, 40000);
+
+   CHECK_THROWS_AS(columns.set_value(31, 0), gm2calc::ESetupError);
+   CHECK(columns.size() == N);
+
+   gm2calc::evaluate(columns, amu.data(), damu.data(), status.data(), 3);
+
+   for (int i = 0; i < N; i++) {
+      INFO("point " << i);
+      if (i == 5) {
+         CHECK(status[i] == gm2calc::Batch_invalid_input);
+         CHECK(std::isnan(amu[i]));
+      } else {
+         const auto basis = make_basis(mH[i]);
+         const gm2calc::THDM model(basis);
+         CHECK(status[i] == gm2calc::Batch_ok);
+         CHECK(amu[i] == doctest::Approx(calculate_amu(basis)).epsilon(1e-14));
+         CHECK(damu[i] == doctest::Approx(gm2calc::calculate_uncertainty_amu_2loop(model)).epsilon(1e-14));
+      }
+   }
+}
+
+
+TEST_CASE("process_in_order")
+{
+   const int N = 50;
+   std::vector<gm2calc::Batch_record> records;
+
+   for (int i = 0; i < N; i++) {
+      records.push_back(make_record(make_basis(300 + 4*i)));
+   }
+
+   // invalid Yukawa type and unknown record type
+   records[7].input[0] = 0;
+   records[13].type = 42;
+
+   gm2calc::Batch_queue queue(8);
+   gm2calc::Batch_worker_pool workers(queue, 3);
+
+   CHECK(queue.get_capacity() == 8);
+
+   queue.process(records.data(), records.size());
+
+   CHECK(queue.get_number_of_pending() == 0);
+
+   for (int i = 0; i < N; i++) {
+      INFO("record " << i);
+      if (i == 7 || i == 13) {
+         CHECK(records[i].status == gm2calc::Batch_invalid_input);
+         CHECK(std::isnan(records[i].amu));
+      } else {
+         CHECK(records[i].status == gm2calc::Batch_ok);
+         CHECK(records[i].amu == doctest::Approx(calculate_amu(make_basis(300 + 4*i))).epsilon(1e-14));
+      }
+   }
+}
+
+
+TEST_CASE("write_read")
+{
+   gm2calc::Batch_queue queue(2);
+
+   CHECK_THROWS_AS(queue.begin_read(), gm2calc::ESetupError);
+
+   queue.begin_write() = make_record(make_basis(400));
+   queue.end_write();
+   queue.begin_write() = make_record(make_basis(500));
+   queue.end_write();
+
+   CHECK(queue.get_number_of_pending() == 2);
+
+   // evaluate in the calling thread
+   CHECK(queue.consume());
+   CHECK(queue.consume());
+
+   CHECK(queue.begin_read().amu == doctest::Approx(calculate_amu(make_basis(400))));
+   queue.end_read();
+   CHECK(queue.begin_read().amu == doctest::Approx(calculate_amu(make_basis(500))));
+   queue.end_read();
+
+   CHECK(queue.get_number_of_pending() == 0);
+   CHECK(!queue.is_closed());
+
+   queue.close();
+
+   CHECK(queue.is_closed());
+   CHECK(!queue.consume());
+}
+
+
+#if defined(__unix__) || defined(__APPLE__)
+
+TEST_CASE("shared_memory")
+{
+   const std::string name = "/gm2calc_test_batch_" + std::to_string(::getpid());
+
+   gm2calc::Batch_queue queue(name, 4);
+
+   CHECK_THROWS_AS(gm2calc::Batch_queue(name, 4), gm2calc::ESetupError);
+
+   std::vector<gm2calc::Batch_record> records;
+   for (int i = 0; i < 10; i++) {
+      records.push_back(make_record(make_basis(350 + 10*i)));
+   }
+
+   {
+      // workers attached to the same shared memory object
+      gm2calc::Batch_queue worker_queue(name);
+      CHECK(worker_queue.get_capacity() == 4);
+      std::thread worker([&worker_queue] () { while (worker_queue.consume()) {} });
+      queue.process(records.data(), records.size());
+      queue.close();
+      worker.join();
+   }
+
+   for (int i = 0; i < 10; i++) {
+      CHECK(records[i].status == gm2calc::Batch_ok);
+      CHECK(records[i].amu == doctest::Approx(calculate_amu(make_basis(350 + 10*i))));
+   }
+}
+
+
+TEST_CASE("open_nonexistent")
+{
+   CHECK_THROWS_AS(gm2calc::Batch_queue("/gm2calc_test_batch_nonexistent"), gm2calc::ESetupError);
+}
+
+#endif
@@ -0,0 +1,169 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+#include "gm2_dilog.hpp"
+#include "gm2_dual.hpp"
+#include "gm2_ffunctions.hpp"
+#include "gm2_mf.hpp"
+
+#include <cmath>
+#include <complex>
+
+#define CHECK_CLOSE(a,b,eps)                            \
+   do {                                                 \
+      CHECK((a) == doctest::Approx(b).epsilon(eps));    \
+   } while (0)
+
+
+namespace {
+
+using gm2calc::Dual;
+
+/// central finite difference of f at x
+template <class F>
+double diff(F f, double x, double h = 1e-6)
+{
+   const double dx = h*std::max(1.0, std::abs(x));
+   return (f(x + dx) - f(x - dx))/(2*dx);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("arithmetic")
+{
+   const Dual<double> x(2.0, 0), y(3.0, 1);
+
+   const auto r = (x*y + x/y - 2*x + y*3 - 1)/(x - 0.5);
+
+   const double dx = diff([] (double a) { return (a*3 + a/3 - 2*a + 9 - 1)/(a - 0.5); }, 2.0);
+   const double dy = diff([] (double b) { return (2*b + 2/b - 4 + b*3 - 1)/1.5; }, 3.0);
+
+   CHECK_CLOSE(r.val, (6 + 2./3 - 4 + 9 - 1)/1.5, 1e-15);
+   CHECK_CLOSE(r.grad[0], dx, 1e-8);
+   CHECK_CLOSE(r.grad[1], dy, 1e-8);
+   CHECK(r.grad[2] == 0);
+
+   Dual<double> z(x);
+   z += y;
+   z *= x;
+   z -= 1;
+   z /= y;
+   CHECK_CLOSE(z.val, ((2 + 3)*2 - 1)/3., 1e-15);
+
+   CHECK(x < y);
+   CHECK(x == 2.0);
+   CHECK(gm2calc::value_of(x) == 2.0);
+}
+
+
+TEST_CASE("elementary_functions")
+{
+   using std::sqrt; using std::log; using std::exp; using std::pow;
+   using std::sin; using std::cos; using std::asin; using std::acos;
+   using std::atan; using std::atan2; using std::abs;
+
+   const double x0 = 0.3;
+   const Dual<double> x(x0, 0);
+
+#define CHECK_FUNCTION(f)                                               \
+   do {                                                                 \
+      INFO(#f);                                                         \
+      const auto fx = [] (auto a) { return f; };                        \
+      const auto r = fx(x);                                             \
+      CHECK_CLOSE(r.val, fx(x0), 1e-15);                                \
+      CHECK_CLOSE(r.grad[0], diff([&] (double a) { return fx(a); }, x0), 1e-7); \
+   } while (0)
+
+   CHECK_FUNCTION(sqrt(a));
+   CHECK_FUNCTION(log(a));
+   CHECK_FUNCTION(exp(a));
+   CHECK_FUNCTION(pow(a, 2.5));
+   CHECK_FUNCTION(sin(a));
+   CHECK_FUNCTION(cos(a));
+   CHECK_FUNCTION(asin(a));
+   CHECK_FUNCTION(acos(a));
+   CHECK_FUNCTION(atan(a));
+   CHECK_FUNCTION(atan2(a, 2.0));
+   CHECK_FUNCTION(abs(-a));
+
+#undef CHECK_FUNCTION
+}
+
+
+TEST_CASE("complex")
+{
+   const Dual<double> x(0.3, 0);
+   const Dual<std::complex<double>> z = Dual<std::complex<double>>(x)*std::complex<double>(1, 2);
+
+   CHECK_CLOSE(std::real(z.grad[0]), 1, 1e-15);
+   CHECK_CLOSE(std::imag(z.grad[0]), 2, 1e-15);
+
+   const auto n = gm2calc::norm(z);
+   CHECK_CLOSE(n.val, 5*0.09, 1e-15);
+   CHECK_CLOSE(n.grad[0], 10*0.3, 1e-15);
+
+   const auto r = gm2calc::real(gm2calc::conj(z)*z);
+   CHECK_CLOSE(r.grad[0], 10*0.3, 1e-15);
+}
+
+
+TEST_CASE("special_functions")
+{
+   const double xs[] = {0.2, 0.7, 1.5, 4.0};
+
+   for (const double x0: xs) {
+      INFO("x = " << x0);
+      const Dual<double> x(x0, 0);
+
+      CHECK_CLOSE(gm2calc::dilog(x).val, gm2calc::dilog(x0), 1e-15);
+      CHECK_CLOSE(gm2calc::dilog(x).grad[0], diff([] (double a) { return gm2calc::dilog(a); }, x0), 1e-7);
+      CHECK_CLOSE(gm2calc::clausen_2(x).grad[0], diff([] (double a) { return gm2calc::clausen_2(a); }, x0), 1e-7);
+      CHECK_CLOSE(gm2calc::F1C(x).grad[0], diff([] (double a) { return gm2calc::F1C(a); }, x0), 1e-6);
+      CHECK_CLOSE(gm2calc::F2C(x).grad[0], diff([] (double a) { return gm2calc::F2C(a); }, x0), 1e-6);
+      CHECK_CLOSE(gm2calc::F1N(x).grad[0], diff([] (double a) { return gm2calc::F1N(a); }, x0), 1e-6);
+      CHECK_CLOSE(gm2calc::f_PS(x).grad[0], diff([] (double a) { return gm2calc::f_PS(a); }, x0), 1e-6);
+      CHECK_CLOSE(gm2calc::f_S(x).grad[0], diff([] (double a) { return gm2calc::f_S(a); }, x0), 1e-6);
+   }
+}
+
+
+TEST_CASE("loop_functions")
+{
+   const double x0 = 0.3, y0 = 2.5;
+   const Dual<double> x(x0, 0), y(y0, 1);
+
+   const auto check = [&] (const Dual<double>& r, auto f) {
+      CHECK_CLOSE(r.val, f(x0, y0), 1e-15);
+      CHECK_CLOSE(r.grad[0], diff([&] (double a) { return f(a, y0); }, x0), 1e-6);
+      CHECK_CLOSE(r.grad[1], diff([&] (double b) { return f(x0, b); }, y0), 1e-6);
+   };
+
+   check(gm2calc::FPZ(x, y), [] (double a, double b) { return gm2calc::FPZ(a, b); });
+   check(gm2calc::FSZ(x, y), [] (double a, double b) { return gm2calc::FSZ(a, b); });
+   check(gm2calc::FCWl(x, y), [] (double a, double b) { return gm2calc::FCWl(a, b); });
+   check(gm2calc::FCWu(x, Dual<double>(0.1), y, Dual<double>(0.2), 2./3, -1./3),
+         [] (double a, double b) { return gm2calc::FCWu(a, 0.1, b, 0.2, 2./3, -1./3); });
+   check(gm2calc::FCWd(x, Dual<double>(0.1), y, Dual<double>(0.2), 2./3, -1./3),
+         [] (double a, double b) { return gm2calc::FCWd(a, 0.1, b, 0.2, 2./3, -1./3); });
+
+   // lambda^2 < 0 and lambda^2 > 0
+   check(gm2calc::Phi(x, y, Dual<double>(2.0)), [] (double a, double b) { return gm2calc::Phi(a, b, 2.0); });
+   check(gm2calc::Phi(x, y, Dual<double>(10.0)), [] (double a, double b) { return gm2calc::Phi(a, b, 10.0); });
+}
+
+
+TEST_CASE("running_masses")
+{
+   const double Q0 = 400;
+   const Dual<double> Q(Q0, 0);
+
+   const auto mt = gm2calc::calculate_mt_SM6_MSbar(173.34, 0.1184, 91.1876, Q);
+   const auto mb = gm2calc::calculate_mb_SM6_MSbar(4.18, 173.34, 0.1184, 91.1876, Q);
+   const auto mtau = gm2calc::calculate_mtau_SM6_MSbar(1.777, 1/127.9, Q);
+
+   CHECK_CLOSE(mt.val, gm2calc::calculate_mt_SM6_MSbar(173.34, 0.1184, 91.1876, Q0), 1e-15);
+   CHECK_CLOSE(mt.grad[0], diff([] (double q) { return gm2calc::calculate_mt_SM6_MSbar(173.34, 0.1184, 91.1876, q); }, Q0), 1e-7);
+   CHECK_CLOSE(mb.grad[0], diff([] (double q) { return gm2calc::calculate_mb_SM6_MSbar(4.18, 173.34, 0.1184, 91.1876, q); }, Q0), 1e-7);
+   CHECK_CLOSE(mtau.grad[0], diff([] (double q) { return gm2calc::calculate_mtau_SM6_MSbar(1.777, 1/127.9, q); }, Q0), 1e-7);
+}
@@ -93,6 +93,174 @@ EOF
     expect_success "$?"
 }
 
+test_cache_file() {
+    printf "%s" "test_cache_file"
+    cache_file="test_gm2calc_cache.bin"
+    rm -f "${cache_file}"
+    output1=$(${GM2CALC} "--slha-input-file=$1" "--cache-file=${cache_file}" 2>/dev/null)
+    output2=$(${GM2CALC} "--slha-input-file=$1" "--cache-file=${cache_file}" 2>/dev/null)
+    rm -f "${cache_file}"
+    test -n "${output1}" && test "${output1}" = "${output2}"
+    expect_success "$?"
+}
+
+test_multi_document() {
+    printf "%s" "test_multi_document $1"
+    document=$({ cat $2
+      cat <<EOF
+Block GM2CalcConfig
+     0     0     # minimal output
+EOF
+    })
+    output=$(printf "%s\n# END\n%s\n" "${document}" "${document}" | \
+        ${GM2CALC} "--$1-input-file=-" "--multi-document=# END" 2>/dev/null)
+    test "$(printf "%s\n" "${output}" | wc -l)" -eq 3 && \
+        test "$(printf "%s\n" "${output}" | sed -n 1p)" = "$(printf "%s\n" "${output}" | sed -n 3p)" && \
+        test "$(printf "%s\n" "${output}" | sed -n 2p)" = "# END"
+    expect_success "$?"
+}
+
+test_multi_document_spinfo() {
+    printf "%s" "test_multi_document_spinfo $1"
+    document=$({ cat <<EOF
+Block SPINFO
+     1     SpectrumGenerator
+EOF
+      cat $2
+      cat <<EOF
+Block GM2CalcConfig
+     0     0     # minimal output
+EOF
+    })
+    output=$(printf "%s\n%s\n%s\n" "${document}" "${document}" "${document}" | \
+        ${GM2CALC} "--$1-input-file=-" "--multi-document" 2>/dev/null)
+    test "$(printf "%s\n" "${output}" | wc -l)" -eq 3
+    expect_success "$?"
+}
+
+test_slha_output_results() {
+    printf "%s" "test_slha_output_results $1"
+    output=$(${GM2CALC} "--$1-input-file=$2" "--slha-output=results" 2>/dev/null)
+    test "$(printf "%s\n" "${output}" | sed -n 1p)" = "Block GM2CalcOutput" && \
+        test "$(printf "%s\n" "${output}" | grep -ci '^ *block')" -eq 1
+    expect_success "$?"
+}
+
+test_slha_output_echo() {
+    printf "%s" "test_slha_output_echo $1"
+    input_size=$(wc -c < "$2")
+    ${GM2CALC} "--$1-input-file=$2" "--slha-output=echo" 2>/dev/null | \
+        head -c "${input_size}" | cmp -s - "$2"
+    expect_success "$?"
+}
+
+test_slha_output_invalid() {
+    printf "%s" "test_slha_output_invalid"
+    ${GM2CALC} "--slha-input-file=$1" "--slha-output=unknown" >/dev/null 2>&1
+    expect_failure "$?"
+}
+
+test_result_file() {
+    printf "%s" "test_result_file $1"
+    result_file="test_gm2calc_result_$1.bin"
+    rm -f "${result_file}"
+    document=$({ cat $2
+      cat <<EOF
+Block GM2CalcConfig
+     0     0     # minimal output
+     5     0     # calculate amu
+EOF
+    })
+    amu=$(printf "%s\n" "${document}" | ${GM2CALC} "--$1-input-file=-" 2>/dev/null)
+    printf "%s\n# END\n%s\n" "${document}" "${document}" | \
+        ${GM2CALC} "--$1-input-file=-" "--multi-document=# END" \
+                   "--result-file=${result_file}" >/dev/null 2>&1
+    # header (24 bytes) followed by the chunks
+    size=$(wc -c < "${result_file}")
+    test "${size}" -gt 24 && \
+    if command -v python3 >/dev/null 2>&1; then
+        table=$(python3 "${BASEDIR}/../src/gm2_result_file.py" "${result_file}")
+        column=$(printf "%s\n" "${table}" | sed -n 1p | tr -s ' ' '\n' | grep -n '^amu$' | cut -d: -f1)
+        test "$(printf "%s\n" "${table}" | wc -l)" -eq 3 && \
+            test "$(printf "%s\n" "${table}" | sed -n 2p | tr -s ' ' '\n' | sed -n ${column}p)" = "${amu}"
+    fi
+    ret=$?
+    rm -f "${result_file}"
+    expect_success "${ret}"
+}
+
+test_thdm_table() {
+    printf "%s" "test_thdm_table $1"
+    sm_input="test_gm2calc_thdm_table_sm.slha"
+    { cat $2
+      cat <<EOF
+Block GM2CalcConfig
+     0     0     # minimal output
+     5     0     # calculate amu
+EOF
+    } > "${sm_input}"
+    amu=$(${GM2CALC} "--thdm-input-file=${sm_input}" 2>/dev/null)
+    table=$(printf "%s\n%s\n%s\n" \
+        "mh,mH,mA,mHp,sin_beta_minus_alpha,lambda_6,lambda_7,tan_beta,m122,zeta_u,zeta_d,zeta_l,yukawa_type" \
+        "100,400,420,440,0.995,0.2,0.1,3,40000,0,0,0,2" \
+        "100,400,420,440,0.995,0.2,0.1,3,40000,0,0,0,2" | \
+        ${GM2CALC} "--thdm-table-input-file=-" "--sm-input-file=${sm_input}" "--threads=$1" 2>/dev/null)
+    ret=$?
+    rm -f "${sm_input}"
+    test ${ret} -eq 0 && \
+        test "$(printf "%s\n" "${table}" | wc -l)" -eq 3 && \
+        test "$(printf "%s\n" "${table}" | awk 'NR > 1 { print $1 }' | uniq)" = "${amu}"
+    expect_success "$?"
+}
+
+test_thdm_table_invalid() {
+    printf "%s" "test_thdm_table_invalid"
+    table=$(printf "%s\n%s\n%s\n" "mh,mA,tan_beta" "125,abc,3" "125,500,3" | \
+        ${GM2CALC} "--thdm-table-input-file=-" 2>/dev/null)
+    ret=$?
+    test ${ret} -ne 0 && \
+        test "$(printf "%s\n" "${table}" | wc -l)" -eq 3 && \
+        test "$(printf "%s\n" "${table}" | awk 'NR == 2 { print $1 }')" = "nan"
+    expect_success "$?"
+}
+
+test_server() {
+    printf "%s" "test_server"
+    if ! command -v python3 >/dev/null 2>&1; then
+        expect_success 0
+        return
+    fi
+    socket="test_gm2calc_server.sock"
+    client="python3 ${BASEDIR}/../src/gm2_server_client.py ${socket}"
+    input="test_gm2calc_server.thdm"
+    { cat $1
+      cat <<EOF
+Block GM2CalcConfig
+     0     0     # minimal output
+     5     0     # calculate amu
+EOF
+    } > "${input}"
+    amu=$(${GM2CALC} "--thdm-input-file=${input}" 2>/dev/null)
+    ${GM2CALC} "--serve=${socket}" "--threads=2" 2>/dev/null &
+    pid=$!
+    i=0
+    while test ! -S "${socket}" && test $i -lt 50; do
+        sleep 0.1
+        i=$(expr $i + 1)
+    done
+    result=$(${client} thdm "${input}" 2>/dev/null)
+    stats=$(${client} statistics 2>/dev/null)
+    ${client} shutdown >/dev/null 2>&1
+    wait ${pid}
+    ret=$?
+    rm -f "${input}"
+    test ${ret} -eq 0 && \
+        test "$(printf "%s\n" "${result}" | awk '{ print $1 }')" = "${amu}" && \
+        test "$(printf "%s\n" "${stats}" | awk '$1 == "thdm" { print $2 }')" = "1" && \
+        test ! -e "${socket}"
+    expect_success "$?"
+}
+
 # run tests
 test_help_output
 test_version_output
@@ -111,6 +279,21 @@ test_nmssmtools_output "thdm" "${BASEDIR}/../input/example.thdm"
 test_spheno_output "gm2calc" "${BASEDIR}/../input/example.gm2"
 test_spheno_output "slha" "${BASEDIR}/../input/example.slha"
 test_spheno_output "thdm" "${BASEDIR}/../input/example.thdm"
+test_cache_file "${BASEDIR}/../input/example.slha"
+test_multi_document "slha" "${BASEDIR}/../input/example.slha"
+test_multi_document "thdm" "${BASEDIR}/../input/example.thdm"
+test_multi_document_spinfo "gm2calc" "${BASEDIR}/../input/example.gm2"
+test_slha_output_results "slha" "${BASEDIR}/../input/example.slha"
+test_slha_output_results "thdm" "${BASEDIR}/../input/example.thdm"
+test_slha_output_echo "slha" "${BASEDIR}/../input/example.slha"
+test_slha_output_echo "thdm" "${BASEDIR}/../input/example.thdm"
+test_slha_output_invalid "${BASEDIR}/../input/example.slha"
+test_result_file "slha" "${BASEDIR}/../input/example.slha"
+test_result_file "thdm" "${BASEDIR}/../input/example.thdm"
+test_thdm_table 1 "${BASEDIR}/../input/example.thdm"
+test_thdm_table 4 "${BASEDIR}/../input/example.thdm"
+test_thdm_table_invalid
+test_server "${BASEDIR}/../input/example.thdm"
 
 count=$(expr $errors + $passes)
 
@@ -466,6 +466,39 @@ point = {
 
 TestClose[myAmu, 3.247273665589615*^-11];
 
+(* list of THDM gauge basis points *)
+points = Table[Prepend[point, TB -> tb], {tb, 2, 10, 2}];
+
+result = GM2CalcAmuTHDMGaugeBasisList[points, threads -> 2];
+
+TestEqual[Developer`PackedArrayQ[amu /. result], True];
+TestEqual[status /. result, ConstantArray[0, Length[points]]];
+
+MapThread[
+    TestClose[#1, amu /. GM2CalcAmuTHDMGaugeBasis[#2]]&,
+    {amu /. result, points}];
+
+MapThread[
+    TestClose[#1, Damu /. GM2CalcAmuTHDMGaugeBasis[#2]]&,
+    {Damu /. result, points}];
+
+(* list of THDM mass basis points with an invalid point *)
+points = {
+    { yukawaType -> 2, Mhh -> { 125, 400 }, MAh -> 420, MHp -> 440,
+      sinBetaMinusAlpha -> 0.999, TB -> 3, m122 -> 200^2 },
+    <| yukawaType -> 2, Mhh -> { 125, 500 }, MAh -> 420, MHp -> 440,
+       sinBetaMinusAlpha -> 0.999, TB -> 3, m122 -> 200^2 |>,
+    { yukawaType -> 2, Mhh -> { 125, 500 }, MAh -> 420, MHp -> 440,
+      sinBetaMinusAlpha -> 0.999, TB -> -1, m122 -> 200^2 }
+};
+
+result = GM2CalcAmuTHDMMassBasisList[points];
+
+TestEqual[status /. result, {0, 0, 1}];
+TestClose[(amu /. result)[[1]], amu /. GM2CalcAmuTHDMMassBasis[points[[1]]]];
+TestClose[(amu /. result)[[2]], amu /. GM2CalcAmuTHDMMassBasis[Normal[points[[2]]]]];
+TestEqual[(amu /. result)[[3]], 0.];
+
 Print[];
 Print["Passed tests: [", passed, "/", passed + errors,"]"];
 
@@ -0,0 +1,130 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_gradient.hpp"
+#include "gm2calc/gm2_profile.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+gm2calc::THDM make_point()
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.mh = 125;
+   basis.mH = 400;
+   basis.mA = 420;
+   basis.mHp = 440;
+   basis.sin_beta_minus_alpha = 0.999;
+   basis.lambda_6 = 0.1;
+   basis.lambda_7 = 0.2;
+   basis.tan_beta = 3;
+   basis.m122 = 4000;
+
+   return gm2calc::THDM(basis);
+}
+
+const gm2calc::Profile_entry& find(const std::vector<gm2calc::Profile_entry>& entries,
+                                   const std::string& name)
+{
+   for (const auto& e: entries) {
+      if (name == e.name) {
+         return e;
+      }
+   }
+   FAIL("no profile entry for " << name);
+   return entries.front();
+}
+
+} // anonymous namespace
+
+TEST_CASE("profiling_disabled")
+{
+   const auto model = make_point();
+
+   gm2calc::enable_profiling(false);
+   gm2calc::reset_profile();
+
+   CHECK(!gm2calc::is_profiling_enabled());
+
+   gm2calc::calculate_amu_1loop(model);
+   gm2calc::calculate_amu_2loop(model);
+
+   for (const auto& e: gm2calc::get_profile()) {
+      CHECK(e.calls == 0);
+      CHECK(e.seconds == 0.);
+   }
+}
+
+TEST_CASE("profiling_enabled")
+{
+   const auto model = make_point();
+
+   gm2calc::enable_profiling();
+   gm2calc::reset_profile();
+
+   CHECK(gm2calc::is_profiling_enabled());
+
+   const int n = 3;
+
+   for (int i = 0; i < n; ++i) {
+      gm2calc::calculate_amu_1loop(model);
+      gm2calc::calculate_amu_2loop(model);
+   }
+
+   const auto profile = gm2calc::get_profile();
+
+   CHECK(profile.size() == 6);
+
+   for (const auto name: {"amu1L", "amu2L_B_EWadd", "amu2L_B_nonYuk",
+                          "amu2L_B_Yuk", "amu2L_F_neutral", "amu2L_F_charged"}) {
+      const auto& e = find(profile, name);
+      CHECK(e.calls == n);
+      CHECK(e.seconds >= 0.);
+   }
+
+   // only the bosonic contributions are called
+   gm2calc::reset_profile();
+   gm2calc::calculate_amu_2loop_bosonic(model);
+
+   CHECK(find(gm2calc::get_profile(), "amu2L_B_Yuk").calls == 1);
+   CHECK(find(gm2calc::get_profile(), "amu2L_F_neutral").calls == 0);
+   CHECK(find(gm2calc::get_profile(), "amu1L").calls == 0);
+
+   gm2calc::enable_profiling(false);
+}
+
+TEST_CASE("profiling_gradient")
+{
+   const auto model = make_point();
+
+   gm2calc::enable_profiling();
+   gm2calc::reset_profile();
+
+   // only the double instantiations of the contributions are profiled
+   gm2calc::calculate_amu_gradient(model);
+
+   for (const auto& e: gm2calc::get_profile()) {
+      CHECK_MESSAGE(e.calls == 0, e.name);
+      CHECK(e.seconds == 0.);
+   }
+
+   gm2calc::enable_profiling(false);
+}
+
+TEST_CASE("profile_output")
+{
+   gm2calc::reset_profile();
+
+   std::ostringstream table;
+   gm2calc::print_profile_table(table, gm2calc::get_profile());
+   CHECK(table.str().find("amu2L_F_charged") != std::string::npos);
+
+   std::ostringstream json;
+   gm2calc::print_profile_json(json, gm2calc::get_profile());
+   CHECK(json.str().find("\"name\": \"amu1L\", \"calls\": 0") != std::string::npos);
+}
@@ -0,0 +1,255 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_result_file.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+gm2calc::MSSMNoFV_onshell setup_mssmnofv()
+{
+   gm2calc::MSSMNoFV_onshell model;
+
+   const double Pi = 3.141592653589793;
+   const Eigen::Matrix<double,3,3> UnitMatrix
+      = Eigen::Matrix<double,3,3>::Identity();
+
+   model.set_alpha_MZ(0.0077552);
+   model.set_alpha_thompson(0.00729735);
+   model.set_g3(std::sqrt(4 * Pi * 0.1184));
+   model.get_physical().MFt   = 173.34;
+   model.get_physical().MFb   = 4.18;
+   model.get_physical().MFm   = 0.1056583715;
+   model.get_physical().MFtau = 1.777;
+   model.get_physical().MVWm  = 80.385;
+   model.get_physical().MVZ   = 91.1876;
+   model.set_TB(10);
+   model.set_Mu(350);
+   model.set_MassB(150);
+   model.set_MassWB(300);
+   model.set_MassG(1000);
+   model.set_mq2(500 * 500 * UnitMatrix);
+   model.set_ml2(500 * 500 * UnitMatrix);
+   model.set_md2(500 * 500 * UnitMatrix);
+   model.set_mu2(500 * 500 * UnitMatrix);
+   model.set_me2(500 * 500 * UnitMatrix);
+   model.set_MA0(1500);
+   model.set_scale(454.7);
+   model.calculate_masses();
+
+   return model;
+}
+
+const std::vector<gm2calc::Result_column> test_columns = {
+   {"x", gm2calc::Result_column::Float64},
+   {"problems", gm2calc::Result_column::UInt64},
+};
+
+} // anonymous namespace
+
+
+TEST_CASE("write_and_read_chunks")
+{
+   const std::string file_name = "test_result_file_chunks.bin";
+   const unsigned n = 10;
+
+   {
+      // 3 rows per chunk => 4 chunks, the last one with 1 row
+      gm2calc::Result_file_writer writer(file_name, test_columns, 3);
+      for (unsigned i = 0; i < n; i++) {
+         writer.write_row({0.5 * i, static_cast<std::uint64_t>(i)});
+      }
+      CHECK(writer.get_number_of_rows() == n);
+   }
+
+   gm2calc::Result_file_reader reader(file_name);
+
+   REQUIRE(reader.get_columns().size() == 2);
+   CHECK(reader.get_columns()[0].name == "x");
+   CHECK(reader.get_columns()[1].type == gm2calc::Result_column::UInt64);
+   CHECK(reader.get_column_index("problems") == 1);
+   CHECK(reader.get_number_of_rows() == n);
+   CHECK(reader.get_number_of_chunks() == 4);
+   CHECK(reader.get_chunk_rows(3) == 1);
+
+   const auto x = reader.read_float64_column(0);
+   const auto p = reader.read_uint64_column(1);
+
+   REQUIRE(x.size() == n);
+   REQUIRE(p.size() == n);
+
+   for (unsigned i = 0; i < n; i++) {
+      CHECK(x[i] == 0.5 * i);
+      CHECK(p[i] == i);
+   }
+
+   CHECK(reader.get_float64_data(1, 0)[0] == 1.5);
+   CHECK_THROWS_AS(reader.get_uint64_data(0, 0), gm2calc::EInvalidInput);
+   CHECK_THROWS_AS(reader.get_column_index("y"), gm2calc::EInvalidInput);
+
+   std::remove(file_name.c_str());
+}
+
+
+TEST_CASE("write_invalid_rows")
+{
+   const std::string file_name = "test_result_file_invalid.bin";
+
+   gm2calc::Result_file_writer writer(file_name, test_columns);
+
+   CHECK_THROWS_AS(writer.write_row({1.0}), gm2calc::EInvalidInput);
+   CHECK_THROWS_AS(writer.write_row({1.0, 2.0}), gm2calc::EInvalidInput);
+   CHECK(writer.get_number_of_rows() == 0);
+
+   writer.write_error_row();
+   writer.flush();
+
+   gm2calc::Result_file_reader reader(file_name);
+
+   REQUIRE(reader.get_number_of_rows() == 1);
+   CHECK(std::isnan(reader.get_float64_data(0, 0)[0]));
+   CHECK(reader.get_uint64_data(0, 1)[0] == gm2calc::Result_problem_error);
+
+   std::remove(file_name.c_str());
+}
+
+
+TEST_CASE("read_truncated_file")
+{
+   const std::string file_name = "test_result_file_truncated.bin";
+
+   {
+      gm2calc::Result_file_writer writer(file_name, test_columns, 2);
+      for (unsigned i = 0; i < 4; i++) {
+         writer.write_row({1.0 * i, static_cast<std::uint64_t>(0)});
+      }
+   }
+
+   // cut the last chunk
+   std::string content;
+   {
+      std::ifstream istr(file_name, std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(istr), std::istreambuf_iterator<char>());
+   }
+   {
+      std::ofstream ostr(file_name, std::ios::binary | std::ios::trunc);
+      ostr.write(content.data(), content.size() - 8);
+   }
+
+   gm2calc::Result_file_reader reader(file_name);
+   CHECK(reader.get_number_of_chunks() == 1);
+   CHECK(reader.get_number_of_rows() == 2);
+
+   {
+      std::ofstream ostr(file_name, std::ios::binary | std::ios::trunc);
+      ostr << "no result file";
+   }
+
+   CHECK_THROWS_AS(gm2calc::Result_file_reader{file_name}, gm2calc::EReadError);
+
+   std::remove(file_name.c_str());
+}
+
+
+TEST_CASE("write_mssmnofv_result")
+{
+   const std::string file_name = "test_result_file_mssmnofv.bin";
+   const auto model = setup_mssmnofv();
+
+   {
+      gm2calc::Result_file_writer writer(file_name, gm2calc::get_mssmnofv_result_columns());
+      gm2calc::write_result(writer, model);
+   }
+
+   gm2calc::Result_file_reader reader(file_name);
+
+   REQUIRE(reader.get_number_of_rows() == 1);
+
+   const auto get = [&reader] (const char* name) {
+      return reader.get_float64_data(0, reader.get_column_index(name))[0];
+   };
+
+   CHECK(get("TB") == model.get_TB());
+   CHECK(get("amu1L") == gm2calc::calculate_amu_1loop(model));
+   CHECK(get("amu2L") == gm2calc::calculate_amu_2loop(model));
+   CHECK(get("amu") == gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model));
+   CHECK(get("damu") == gm2calc::calculate_uncertainty_amu_2loop(model));
+   CHECK(reader.get_uint64_data(0, reader.get_column_index("problems"))[0] == 0);
+   CHECK(reader.get_uint64_data(0, reader.get_column_index("warnings"))[0] == 0);
+
+   std::remove(file_name.c_str());
+}
+
+
+TEST_CASE("write_mssmnofv_cancelled")
+{
+   const std::string file_name = "test_result_file_mssmnofv_cancelled.bin";
+   auto model = setup_mssmnofv();
+   model.get_problems().flag_conversion_cancelled();
+
+   {
+      gm2calc::Result_file_writer writer(file_name, gm2calc::get_mssmnofv_result_columns());
+      gm2calc::write_result(writer, model);
+   }
+
+   gm2calc::Result_file_reader reader(file_name);
+
+   REQUIRE(reader.get_number_of_rows() == 1);
+
+   const auto warnings = reader.get_uint64_data(0, reader.get_column_index("warnings"))[0];
+   CHECK(warnings == gm2calc::Result_warning_conversion_cancelled);
+   CHECK(model.get_problems().get_warnings().find("cancelled") != std::string::npos);
+
+   std::remove(file_name.c_str());
+}
+
+
+TEST_CASE("write_thdm_result")
+{
+   const std::string file_name = "test_result_file_thdm.bin";
+
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::type_2;
+   basis.mh = 125;
+   basis.mH = 400;
+   basis.mA = 420;
+   basis.mHp = 440;
+   basis.sin_beta_minus_alpha = 0.999;
+   basis.tan_beta = 3;
+   basis.m122 = 40000;
+
+   gm2calc::THDM model(basis);
+
+   {
+      gm2calc::Result_file_writer writer(file_name, gm2calc::get_thdm_result_columns());
+      gm2calc::write_result(writer, model);
+   }
+
+   gm2calc::Result_file_reader reader(file_name);
+
+   REQUIRE(reader.get_number_of_rows() == 1);
+
+   const auto get = [&reader] (const char* name) {
+      return reader.get_float64_data(0, reader.get_column_index(name))[0];
+   };
+
+   CHECK(get("mA") == doctest::Approx(420));
+   CHECK(get("amu1L") == gm2calc::calculate_amu_1loop(model));
+   CHECK(get("amu2L") == doctest::Approx(gm2calc::calculate_amu_2loop(model)));
+   CHECK(get("damu") == gm2calc::calculate_uncertainty_amu_2loop(model));
+
+   std::remove(file_name.c_str());
+}
@@ -0,0 +1,451 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_scan.hpp"
+#include "gm2calc/gm2_uncertainty.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+gm2calc::Scan_value circle(double x, double y)
+{
+   return gm2calc::Scan_value{x*x + y*y, 0.0, 0};
+}
+
+/// a_mu in the type X THDM as a function of mA and tan(beta)
+gm2calc::Scan_value thdm_amu(double mA, double tb)
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::type_X;
+   basis.mh = 125;
+   basis.mH = 400;
+   basis.mA = mA;
+   basis.mHp = 400;
+   basis.sin_beta_minus_alpha = 1;
+   basis.tan_beta = tb;
+   basis.m122 = 400*400*tb/(1 + tb*tb);
+
+   const gm2calc::THDM model(basis);
+
+   return gm2calc::Scan_value{
+      gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model),
+      gm2calc::calculate_uncertainty_amu_2loop(model), 0};
+}
+
+/// counts the nodes of the finest uniform grid, where the
+/// interpolated and the exact value lie on different sides of the target
+template <class F>
+int count_misclassified(const gm2calc::Adaptive_scan_result& result,
+                        const gm2calc::Adaptive_scan_options& options,
+                        F f, double target)
+{
+   const int n = 1 << options.max_level;
+   int count = 0;
+
+   for (int i = 0; i <= n; i++) {
+      for (int j = 0; j <= n; j++) {
+         const double x = options.x_min + (options.x_max - options.x_min)*i/n;
+         const double y = options.y_min + (options.y_max - options.y_min)*j/n;
+         const bool exact = f(x, y).amu > target;
+         const bool interpolated = result.interpolate(x, y).amu > target;
+         if (exact != interpolated) {
+            count++;
+         }
+      }
+   }
+
+   return count;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("uniform_grid")
+{
+   gm2calc::Adaptive_scan_options options;
+   options.min_level = 3;
+   options.max_level = 3;
+
+   const auto result = gm2calc::scan_adaptive(circle, options);
+
+   CHECK(result.get_number_of_evaluations() == 81);
+   CHECK(result.get_number_of_cells() == 64);
+
+   for (const auto& p: result.get_points()) {
+      CHECK(p.value.amu == p.x*p.x + p.y*p.y);
+   }
+
+   // exact at the grid points, bilinear in between
+   CHECK(result.interpolate(0.25, 0.5).amu == 0.25*0.25 + 0.5*0.5);
+   CHECK(result.interpolate(1.0, 1.0).amu == 2.0);
+   CHECK(result.interpolate(2.0, -1.0).amu == 1.0);
+   CHECK(result.interpolate(1./16, 0.0).amu == doctest::Approx(0.5*(1./64)));
+}
+
+
+TEST_CASE("circle_contour")
+{
+   const double target = 0.5;
+
+   gm2calc::Adaptive_scan_options options;
+   options.x_min = -1;
+   options.y_min = -1;
+   options.min_level = 2;
+   options.max_level = 7;
+   options.targets = {target};
+
+   const auto result = gm2calc::scan_adaptive(circle, options);
+   const std::size_t n_uniform = (128 + 1)*(128 + 1);
+
+   CHECK(result.get_number_of_evaluations() < n_uniform/5);
+   CHECK(count_misclassified(result, options, circle, target) == 0);
+}
+
+
+TEST_CASE("max_variation")
+{
+   gm2calc::Adaptive_scan_options options;
+   options.min_level = 1;
+   options.max_level = 8;
+   options.max_variation = 0.01;
+
+   const auto f = [] (double x, double y) {
+      return gm2calc::Scan_value{std::tanh(50*(x - 0.5)) + 0.1*y, 0.0, 0};
+   };
+
+   const auto result = gm2calc::scan_adaptive(f, options);
+
+   CHECK(result.get_number_of_evaluations() < 257*257/2);
+
+   for (double x = 0.01; x < 1; x += 0.0123) {
+      for (double y = 0.01; y < 1; y += 0.0456) {
+         CHECK(result.interpolate(x, y).amu == doctest::Approx(f(x, y).amu).epsilon(0.02).scale(1));
+      }
+   }
+}
+
+
+TEST_CASE("flags_and_exceptions")
+{
+   gm2calc::Adaptive_scan_options options;
+   options.min_level = 2;
+   options.max_level = 6;
+
+   // problem flag for x > 0.3, exception for y > 0.8
+   const auto f = [] (double x, double y) {
+      if (y > 0.8) {
+         throw gm2calc::EPhysicalProblem("tachyon");
+      }
+      return gm2calc::Scan_value{1.0, 0.0, x > 0.3 ? 1u : 0u};
+   };
+
+   const auto result = gm2calc::scan_adaptive(f, options);
+
+   // cells along the edges are refined down to the finest level
+   CHECK(result.interpolate(0.29, 0.5).flags == 0);
+   CHECK(result.interpolate(0.32, 0.5).flags == 1);
+   CHECK(result.interpolate(0.1, 0.79).flags == 0);
+   CHECK(result.interpolate(0.1, 0.82).flags == gm2calc::Scan_value::evaluation_error);
+   CHECK(std::isnan(result.interpolate(0.1, 0.9).amu));
+   CHECK(result.get_number_of_evaluations() < 65*65/2);
+}
+
+
+TEST_CASE("thdm_amu_band")
+{
+   const double target = 2.5e-9;
+
+   gm2calc::Adaptive_scan_options options;
+   options.x_min = 20;
+   options.x_max = 100;
+   options.y_min = 10;
+   options.y_max = 100;
+   options.min_level = 2;
+   options.max_level = 6;
+   options.targets = {target};
+   options.threads = 1;
+
+   const auto result = gm2calc::scan_adaptive(thdm_amu, options);
+
+   CHECK(result.get_number_of_evaluations() < 65*65/2);
+   CHECK(count_misclassified(result, options, thdm_amu, target) == 0);
+
+   // the result does not depend on the number of threads
+   options.threads = 3;
+   const auto result_mt = gm2calc::scan_adaptive(thdm_amu, options);
+
+   REQUIRE(result_mt.get_number_of_evaluations() == result.get_number_of_evaluations());
+
+   for (std::size_t i = 0; i < result.get_number_of_evaluations(); i++) {
+      CHECK(result_mt.get_points()[i].x == result.get_points()[i].x);
+      CHECK(result_mt.get_points()[i].y == result.get_points()[i].y);
+      CHECK(result_mt.get_points()[i].value.amu == result.get_points()[i].value.amu);
+   }
+}
+
+
+TEST_CASE("invalid_options")
+{
+   gm2calc::Adaptive_scan_options options;
+
+   options.x_max = options.x_min;
+   CHECK_THROWS_AS(gm2calc::scan_adaptive(circle, options), gm2calc::EInvalidInput);
+
+   options = gm2calc::Adaptive_scan_options{};
+   options.min_level = 5;
+   options.max_level = 4;
+   CHECK_THROWS_AS(gm2calc::scan_adaptive(circle, options), gm2calc::EInvalidInput);
+
+   options = gm2calc::Adaptive_scan_options{};
+   options.max_level = 25;
+   CHECK_THROWS_AS(gm2calc::scan_adaptive(circle, options), gm2calc::EInvalidInput);
+}
+
+
+TEST_CASE("contour_circle")
+{
+   const double target = 0.5;
+
+   gm2calc::Contour_options options;
+   options.x_min = -1;
+   options.y_min = -1;
+   options.rel_tolerance = 1e-10;
+
+   const auto contour = gm2calc::trace_contour(circle, target, 0, 0, 1, 0, options);
+
+   CHECK(contour.closed);
+   CHECK(contour.complete);
+   CHECK(contour.number_of_evaluations < 500);
+   REQUIRE(contour.points.size() > 10);
+
+   // points lie on the circle and cover it without large gaps
+   double max_gap = 0;
+   for (std::size_t i = 0; i < contour.points.size(); i++) {
+      const auto& p = contour.points[i];
+      const auto& q = contour.points[(i + 1) % contour.points.size()];
+      CHECK(std::abs(p.value.amu - target) <= 1e-10*target);
+      CHECK(p.value.amu == p.x*p.x + p.y*p.y);
+      max_gap = std::max(max_gap, std::hypot(p.x - q.x, p.y - q.y));
+   }
+
+   CHECK(max_gap < 0.2);
+}
+
+
+TEST_CASE("contour_boundary_to_boundary")
+{
+   const auto line = [] (double x, double y) {
+      return gm2calc::Scan_value{x + y, 0.0, 0};
+   };
+
+   gm2calc::Contour_options options;
+   options.abs_tolerance = 1e-12;
+
+   const auto contour = gm2calc::trace_contour(line, 1.0, 0, 0, 1, 1, options);
+
+   CHECK(!contour.closed);
+   CHECK(contour.complete);
+   REQUIRE(contour.points.size() >= 2);
+
+   const auto& first = contour.points.front();
+   const auto& last = contour.points.back();
+
+   // ends in the corners (0,1) and (1,0)
+   CHECK(std::min(first.x, last.x) == doctest::Approx(0.0));
+   CHECK(std::max(first.x, last.x) == doctest::Approx(1.0));
+   CHECK(first.x + first.y == doctest::Approx(1.0));
+   CHECK(last.x + last.y == doctest::Approx(1.0));
+}
+
+
+TEST_CASE("contour_thdm")
+{
+   const double target = 2.5e-9;
+
+   gm2calc::Contour_options options;
+   options.x_min = 20;
+   options.x_max = 100;
+   options.y_min = 10;
+   options.y_max = 100;
+   options.rel_tolerance = 1e-8;
+
+   // the function is evaluated sequentially along the contour
+   std::size_t calls = 0;
+   const auto f = [&calls] (double mA, double tb) {
+      calls++;
+      return thdm_amu(mA, tb);
+   };
+
+   const auto contour = gm2calc::trace_contour(f, target, 20, 90, 100, 90, options);
+
+   CHECK(contour.complete);
+   CHECK(!contour.closed);
+   CHECK(calls == contour.number_of_evaluations);
+   CHECK(contour.number_of_evaluations < 65*65/10);
+
+   for (const auto& p: contour.points) {
+      CHECK(std::abs(p.value.amu - target) <= 1e-8*target);
+      CHECK(p.value.amu == thdm_amu(p.x, p.y).amu);
+   }
+}
+
+
+TEST_CASE("contour_invalid_input")
+{
+   gm2calc::Contour_options options;
+
+   // no sign change
+   CHECK_THROWS_AS(gm2calc::trace_contour(circle, 5.0, 0, 0, 1, 1, options), gm2calc::EInvalidInput);
+   // bracket outside of the region
+   CHECK_THROWS_AS(gm2calc::trace_contour(circle, 0.5, 0, 0, 2, 0, options), gm2calc::EInvalidInput);
+   // vanishing tolerance
+   options.rel_tolerance = 0;
+   CHECK_THROWS_AS(gm2calc::trace_contour(circle, 0.5, 0, 0, 1, 0, options), gm2calc::EInvalidInput);
+}
+
+
+TEST_CASE("sequence")
+{
+   const gm2calc::Scan_sequence sequence(
+      gm2calc::Scan_sequence::Type::sobol, {{20, 100}, {10, 100}, {-1, 1}}, 256);
+
+   const auto f = [] (const double* x) {
+      if (x[2] < -0.9) {
+         throw gm2calc::EInvalidInput("invalid point");
+      }
+      return thdm_amu(x[0], x[1]);
+   };
+
+   const auto values_1 = gm2calc::scan_sequence(f, sequence, 0, 256, 1);
+   const auto values_4 = gm2calc::scan_sequence(f, sequence, 0, 256, 4);
+
+   // the result does not depend on the number of threads or on the splitting
+   const auto part_1 = gm2calc::scan_sequence(f, sequence, 0, 100, 3);
+   const auto part_2 = gm2calc::scan_sequence(f, sequence, 100, 156, 2);
+
+   CHECK(values_1.size() == 256);
+   CHECK(part_1.size() + part_2.size() == 256);
+
+   for (std::size_t i = 0; i < 256; i++) {
+      const auto x = sequence.get_point(i);
+      const auto& split = i < 100 ? part_1[i] : part_2[i - 100];
+      INFO("point " << i);
+      if (x[2] < -0.9) {
+         CHECK(values_1[i].flags == gm2calc::Scan_value::evaluation_error);
+         CHECK(std::isnan(values_1[i].amu));
+         CHECK(values_4[i].flags == gm2calc::Scan_value::evaluation_error);
+      } else {
+         CHECK(values_1[i].amu == thdm_amu(x[0], x[1]).amu);
+         CHECK(values_4[i].amu == values_1[i].amu);
+         CHECK(split.amu == values_1[i].amu);
+      }
+   }
+
+   CHECK_THROWS_AS(gm2calc::scan_sequence(f, sequence, 200, 57), gm2calc::EInvalidInput);
+}
+
+
+TEST_CASE("cancellation")
+{
+   gm2calc::Cancellation_token token;
+   std::size_t evaluations = 0;
+
+   // cancels the token after a given number of evaluations
+   const auto cancel_after = [&token, &evaluations] (std::size_t n) {
+      return [&token, &evaluations, n] (double x, double y) {
+         if (++evaluations >= n) {
+            token.cancel();
+         }
+         return circle(x, y);
+      };
+   };
+
+   SUBCASE("scan_adaptive")
+   {
+      gm2calc::Adaptive_scan_options options;
+      options.x_min = -1;
+      options.y_min = -1;
+      options.min_level = 2;
+      options.max_level = 7;
+      options.targets = {0.5};
+      options.threads = 2;
+      options.cancellation = &token;
+
+      const auto full = gm2calc::scan_adaptive(circle, options);
+      CHECK(!full.is_cancelled());
+
+      const auto result = gm2calc::scan_adaptive(cancel_after(200), options);
+
+      // the incomplete refinement level has been discarded
+      CHECK(result.is_cancelled());
+      CHECK(result.get_number_of_evaluations() > 25);
+      CHECK(result.get_number_of_evaluations() < 200);
+      CHECK(result.get_number_of_cells() < full.get_number_of_cells());
+
+      for (int i = 0; i <= 16; i++) {
+         for (int j = 0; j <= 16; j++) {
+            const auto v = result.interpolate(-1 + i/8.0, -1 + j/8.0);
+            CHECK(std::isfinite(v.amu));
+            CHECK(v.flags == 0);
+         }
+      }
+   }
+
+   SUBCASE("scan_adaptive_initial_grid")
+   {
+      gm2calc::Adaptive_scan_options options;
+      options.threads = 1;
+      options.cancellation = &token;
+
+      const auto result = gm2calc::scan_adaptive(cancel_after(3), options);
+      const auto& points = result.get_points();
+
+      CHECK(result.is_cancelled());
+      REQUIRE(points.size() == 25);
+      CHECK(points[2].value.flags == 0);
+      CHECK(points[3].value.flags == gm2calc::Scan_value::cancelled);
+      CHECK(std::isnan(points[24].value.amu));
+   }
+
+   SUBCASE("trace_contour")
+   {
+      gm2calc::Contour_options options;
+      options.x_min = -1;
+      options.y_min = -1;
+      options.rel_tolerance = 1e-10;
+      options.cancellation = &token;
+
+      const auto contour = gm2calc::trace_contour(cancel_after(40), 0.5, 0, 0, 1, 0, options);
+
+      CHECK(contour.cancelled);
+      CHECK(!contour.complete);
+      CHECK(contour.number_of_evaluations < 50);
+      for (const auto& p: contour.points) {
+         CHECK(std::abs(p.value.amu - 0.5) <= 1e-10*0.5);
+      }
+   }
+
+   SUBCASE("scan_sequence")
+   {
+      const gm2calc::Scan_sequence sequence(
+         gm2calc::Scan_sequence::Type::halton, {{-1, 1}, {-1, 1}}, 100);
+      const auto f = cancel_after(10);
+
+      const auto values = gm2calc::scan_sequence(
+         [&f] (const double* x) { return f(x[0], x[1]); }, sequence, 0, 100, 1, &token);
+
+      REQUIRE(values.size() == 100);
+      for (std::size_t i = 0; i < 100; i++) {
+         INFO("point " << i);
+         CHECK(values[i].flags == (i < 10 ? 0 : gm2calc::Scan_value::cancelled));
+         CHECK(std::isfinite(values[i].amu) == (i < 10));
+      }
+   }
+}
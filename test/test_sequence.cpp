@@ -0,0 +1,179 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_sequence.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using Type = gm2calc::Scan_sequence::Type;
+
+namespace {
+
+std::vector<gm2calc::Scan_range> unit_cube(unsigned dim)
+{
+   return std::vector<gm2calc::Scan_range>(dim, gm2calc::Scan_range{0, 1});
+}
+
+/// checks that each of the n intervals of [0,1) contains exactly one coordinate
+bool is_stratified(const gm2calc::Scan_sequence& seq, unsigned d, std::uint64_t n)
+{
+   std::vector<int> count(n, 0);
+   for (std::uint64_t i = 0; i < n; i++) {
+      count[static_cast<std::uint64_t>(seq.get_point(i)[d]*n)]++;
+   }
+   for (const int c: count) {
+      if (c != 1) {
+         return false;
+      }
+   }
+   return true;
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("sobol")
+{
+   const unsigned dim = gm2calc::Scan_sequence::max_dimension;
+   const unsigned m = 10;
+   const std::uint64_t n = 1u << m;
+   const gm2calc::Scan_sequence seq(Type::sobol, unit_cube(dim), n);
+
+   // first points
+   CHECK(seq.get_point(0) == std::vector<double>(dim, 0.0));
+   CHECK(seq.get_point(1) == std::vector<double>(dim, 0.5));
+   CHECK(seq.get_point(2)[0] == 0.75);
+   CHECK(seq.get_point(2)[1] == 0.25);
+   CHECK(seq.get_point(3)[0] == 0.25);
+   CHECK(seq.get_point(3)[1] == 0.75);
+
+   // each coordinate is stratified
+   for (unsigned d = 0; d < dim; d++) {
+      INFO("dimension " << d);
+      CHECK(is_stratified(seq, d, n));
+   }
+
+   // the first two coordinates form a (0,m,2)-net: each elementary
+   // interval of volume 2^-m contains exactly one point
+   for (unsigned a = 0; a <= m; a++) {
+      const std::uint64_t nx = std::uint64_t(1) << a, ny = n/nx;
+      std::vector<int> count(n, 0);
+      for (std::uint64_t i = 0; i < n; i++) {
+         const auto x = seq.get_point(i);
+         count[static_cast<std::uint64_t>(x[0]*nx)*ny + static_cast<std::uint64_t>(x[1]*ny)]++;
+      }
+      INFO("elementary intervals " << nx << " x " << ny);
+      CHECK(std::count(count.cbegin(), count.cend(), 1) == static_cast<long>(n));
+   }
+}
+
+
+TEST_CASE("halton")
+{
+   const gm2calc::Scan_sequence seq(Type::halton, unit_cube(2), 100);
+
+   CHECK(seq.get_point(1)[0] == doctest::Approx(1.0/2));
+   CHECK(seq.get_point(1)[1] == doctest::Approx(1.0/3));
+   CHECK(seq.get_point(2)[0] == doctest::Approx(1.0/4));
+   CHECK(seq.get_point(2)[1] == doctest::Approx(2.0/3));
+   CHECK(seq.get_point(3)[0] == doctest::Approx(3.0/4));
+   CHECK(seq.get_point(3)[1] == doctest::Approx(1.0/9));
+
+   // random shift modulo 1
+   const gm2calc::Scan_sequence shifted(Type::halton, unit_cube(2), 100, 42);
+   const double shift = shifted.get_point(0)[0];
+
+   for (std::uint64_t i = 0; i < 100; i++) {
+      const double x = std::fmod(seq.get_point(i)[0] + shift, 1.0);
+      CHECK(shifted.get_point(i)[0] == doctest::Approx(x));
+   }
+}
+
+
+TEST_CASE("latin_hypercube")
+{
+   const std::uint64_t n = 500;
+   const gm2calc::Scan_sequence seq(Type::latin_hypercube, unit_cube(5), n, 7);
+
+   for (unsigned d = 0; d < 5; d++) {
+      INFO("dimension " << d);
+      CHECK(is_stratified(seq, d, n));
+   }
+
+   // different seeds yield different permutations
+   const gm2calc::Scan_sequence seq2(Type::latin_hypercube, unit_cube(5), n, 8);
+   CHECK(seq.get_point(0) != seq2.get_point(0));
+}
+
+
+TEST_CASE("uniform")
+{
+   const std::uint64_t n = 100000;
+   const gm2calc::Scan_sequence seq(Type::uniform, {{-1, 1}, {10, 20}}, n, 1);
+
+   double sum[2] = {0, 0};
+   for (std::uint64_t i = 0; i < n; i++) {
+      const auto x = seq.get_point(i);
+      CHECK((x[0] >= -1 && x[0] < 1 && x[1] >= 10 && x[1] < 20));
+      sum[0] += x[0];
+      sum[1] += x[1];
+   }
+
+   CHECK(sum[0]/n == doctest::Approx(0).scale(1).epsilon(0.01));
+   CHECK(sum[1]/n == doctest::Approx(15).epsilon(0.001));
+
+   // the points only depend on the seed and the index
+   const gm2calc::Scan_sequence same(Type::uniform, {{-1, 1}, {10, 20}}, n, 1);
+   const gm2calc::Scan_sequence other(Type::uniform, {{-1, 1}, {10, 20}}, n, 2);
+   CHECK(same.get_point(12345) == seq.get_point(12345));
+   CHECK(other.get_point(12345) != seq.get_point(12345));
+}
+
+
+TEST_CASE("invalid_input")
+{
+   CHECK_THROWS_AS(gm2calc::Scan_sequence(Type::sobol, {}, 10), gm2calc::EInvalidInput);
+   CHECK_THROWS_AS(gm2calc::Scan_sequence(Type::sobol, unit_cube(17), 10), gm2calc::EInvalidInput);
+   CHECK_THROWS_AS(gm2calc::Scan_sequence(Type::sobol, {{1, 0}}, 10), gm2calc::EInvalidInput);
+   CHECK_THROWS_AS(gm2calc::Scan_sequence(Type::sobol, unit_cube(1), 0), gm2calc::EInvalidInput);
+   CHECK_THROWS_AS(gm2calc::Scan_sequence(Type::sobol, unit_cube(1), (std::uint64_t(1) << 32) + 1), gm2calc::EInvalidInput);
+
+   const gm2calc::Scan_sequence seq(Type::halton, unit_cube(1), 10);
+   CHECK_THROWS_AS(seq.get_point(10), gm2calc::EInvalidInput);
+}
+
+
+TEST_CASE("coverage")
+{
+   // mean of a smooth function over the unit square (exact: 2/3)
+   const std::uint64_t n = 1024;
+   const auto mean = [n] (const gm2calc::Scan_sequence& seq) {
+      double sum = 0;
+      for (std::uint64_t i = 0; i < n; i++) {
+         const auto x = seq.get_point(i);
+         sum += x[0]*x[0] + x[1]*x[1];
+      }
+      return sum/n;
+   };
+
+   // root mean square error over different seeds
+   const auto error = [&mean, n] (Type type) {
+      double sum = 0;
+      for (std::uint64_t seed = 1; seed <= 16; seed++) {
+         const double diff = mean(gm2calc::Scan_sequence(type, unit_cube(2), n, seed)) - 2./3;
+         sum += diff*diff;
+      }
+      return std::sqrt(sum/16);
+   };
+
+   const double error_uniform = error(Type::uniform);
+
+   CHECK(error(Type::sobol) < 0.1*error_uniform);
+   CHECK(error(Type::halton) < 0.1*error_uniform);
+   CHECK(error(Type::latin_hypercube) < 0.1*error_uniform);
+}
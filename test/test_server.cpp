@@ -0,0 +1,174 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2_server.hpp"
+
+#include "gm2calc/gm2_error.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const char* const socket_path = "test_server.sock";
+
+/// returns the reversed payload, throws for an empty payload
+std::string reverse(std::uint32_t, const std::string& payload)
+{
+   if (payload.empty()) {
+      throw gm2calc::EInvalidInput("empty payload");
+   }
+   return std::string(payload.rbegin(), payload.rend());
+}
+
+class Client {
+public:
+   Client() {
+      fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+      sockaddr_un addr{};
+      addr.sun_family = AF_UNIX;
+      std::strcpy(addr.sun_path, socket_path);
+      REQUIRE(::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0);
+      // fail instead of blocking forever if the request is not served
+      timeval timeout{10, 0};
+      ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+   }
+   ~Client() { ::close(fd); }
+
+   std::pair<std::uint32_t, std::string> request(std::uint32_t type, const std::string& payload)
+   {
+      const std::uint32_t header[2] = { type, static_cast<std::uint32_t>(payload.size()) };
+      std::string buffer(reinterpret_cast<const char*>(header), sizeof(header));
+      buffer += payload;
+      REQUIRE(::send(fd, buffer.data(), buffer.size(), 0) == static_cast<ssize_t>(buffer.size()));
+
+      std::uint32_t response[2] = { 0, 0 };
+      read(reinterpret_cast<char*>(response), sizeof(response));
+      std::string data(response[1], '\0');
+      read(&data[0], data.size());
+
+      return { response[0], data };
+   }
+
+private:
+   int fd{-1};
+
+   void read(char* data, std::size_t size)
+   {
+      while (size > 0) {
+         const auto n = ::recv(fd, data, size, 0);
+         REQUIRE(n > 0);
+         data += n;
+         size -= static_cast<std::size_t>(n);
+      }
+   }
+};
+
+} // anonymous namespace
+
+
+TEST_CASE("serve_requests")
+{
+   gm2calc::GM2_server server(socket_path, reverse, 2);
+   std::thread thread([&server] () { server.run(); });
+
+   {
+      Client client;
+
+      const auto r1 = client.request(gm2calc::GM2_request_thdm, "abc");
+      CHECK(r1.first == gm2calc::GM2_response_ok);
+      CHECK(r1.second == "cba");
+
+      const auto r2 = client.request(gm2calc::GM2_request_slha, "");
+      CHECK(r2.first == gm2calc::GM2_response_error);
+      CHECK(r2.second == "empty payload");
+
+      const auto r3 = client.request(1000, "abc");
+      CHECK(r3.first == gm2calc::GM2_response_error);
+
+      // second connection while the first one is open
+      Client client2;
+      CHECK(client2.request(gm2calc::GM2_request_gm2calc, "xy").second == "yx");
+
+      const auto stats = client.request(gm2calc::GM2_request_statistics, "");
+      CHECK(stats.first == gm2calc::GM2_response_ok);
+      CHECK(stats.second.find("thdm") != std::string::npos);
+
+      CHECK(client.request(gm2calc::GM2_request_shutdown, "").first == gm2calc::GM2_response_ok);
+   }
+
+   thread.join();
+
+   const auto statistics = server.get_statistics();
+   CHECK(statistics[gm2calc::GM2_request_thdm].count == 1);
+   CHECK(statistics[gm2calc::GM2_request_slha].count == 1);
+   CHECK(statistics[gm2calc::GM2_request_slha].errors == 1);
+   CHECK(statistics[gm2calc::GM2_request_gm2calc].count == 1);
+   CHECK(statistics[gm2calc::GM2_request_thdm].min <= statistics[gm2calc::GM2_request_thdm].max);
+}
+
+
+TEST_CASE("more_idle_clients_than_threads")
+{
+   gm2calc::GM2_server server(socket_path, reverse, 2);
+   std::thread thread([&server] () { server.run(); });
+
+   {
+      // persistent clients, which stay connected without sending requests
+      std::vector<Client> clients(5);
+
+      for (auto& c: clients) {
+         CHECK(c.request(gm2calc::GM2_request_thdm, "ab").second == "ba");
+      }
+
+      // a new client is served while the others are idle
+      Client client;
+      CHECK(client.request(gm2calc::GM2_request_thdm, "abc").second == "cba");
+
+      // responses are in request order per connection
+      for (auto& c: clients) {
+         CHECK(c.request(gm2calc::GM2_request_thdm, "xyz").second == "zyx");
+         CHECK(c.request(gm2calc::GM2_request_slha, "uv").second == "vu");
+      }
+
+      CHECK(client.request(gm2calc::GM2_request_shutdown, "").first == gm2calc::GM2_response_ok);
+   }
+
+   thread.join();
+
+   CHECK(server.get_statistics()[gm2calc::GM2_request_thdm].count == 11);
+}
+
+
+TEST_CASE("stop_with_open_connection")
+{
+   gm2calc::GM2_server server(socket_path, reverse, 1);
+   std::thread thread([&server] () { server.run(); });
+
+   Client client;
+   CHECK(client.request(gm2calc::GM2_request_thdm, "ab").second == "ba");
+
+   server.stop();
+   thread.join();
+}
+
+
+TEST_CASE("invalid_socket_path")
+{
+   CHECK_THROWS_AS(gm2calc::GM2_server("", reverse, 1), gm2calc::ESetupError);
+   CHECK_THROWS_AS(gm2calc::GM2_server("/nonexistent/dir/test.sock", reverse, 1), gm2calc::ESetupError);
+}
+
+#endif
@@ -5,7 +5,12 @@
 #include "gm2_config_options.hpp"
 #include "gm2_numerics.hpp"
 #include "gm2_slha_io.hpp"
+#include "gm2_slha_stream.hpp"
 
+#include "gm2calc/gm2_slha_stream.h"
+
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 
 #define CHECK_CLOSE(a,b,eps)                            \
@@ -149,6 +154,40 @@ TEST_CASE("fill_block_entry")
 }
 
 
+TEST_CASE("write_block_entry")
+{
+   gm2calc::GM2_slha_io slha;
+   slha.fill_block_entry("MAT", 1, 2.0, "description");
+   slha.fill_block_entry("INFO", 1, "description");
+
+   std::ostringstream document;
+   slha.write_to_stream(document);
+
+   // fill_block_entry() inserts new blocks at the front
+   std::ostringstream entries;
+   entries << "Block INFO\n";
+   gm2calc::GM2_slha_io::write_block_entry(entries, 1, "description");
+   entries << "Block MAT\n";
+   gm2calc::GM2_slha_io::write_block_entry(entries, 1, 2.0, "description");
+
+   CHECK(document.str() == entries.str());
+}
+
+
+TEST_CASE("write_input_to_stream")
+{
+   const std::string input = "Block A\n   1   2.0   # a\nBlock B Q= 10\n   1   3.0";
+
+   gm2calc::GM2_slha_io slha;
+   slha.read_from_string(input);
+
+   std::ostringstream ostr;
+   slha.write_input_to_stream(ostr);
+
+   CHECK(ostr.str() == input + '\n');
+}
+
+
 TEST_CASE("read_scale")
 {
    const double eps = std::numeric_limits<double>::epsilon();
@@ -189,3 +228,214 @@ BLOCK VEC
    const double scale = slha.read_scale("VEC");
    CHECK_CLOSE(scale, 0.0, eps);
 }
+
+
+TEST_CASE("read_block_case_insensitive")
+{
+   char const * const slha_input = R"(
+# comment before the first block
+   1   99
+block mass # comment
+    1   1   # comment
+    2   2#comment
+# comment line
+    3
+DECAY 6   1.5
+    4   4
+)";
+
+   std::istringstream stream(slha_input);
+   gm2calc::GM2_slha_io slha;
+   slha.read_from_stream(stream);
+
+   int number_of_entries = 0;
+   double sum = 0;
+
+   slha.read_block("MASS", [&] (int key, double value) {
+      number_of_entries++;
+      sum += key * value;
+   });
+
+   CHECK(number_of_entries == 2);
+   CHECK(sum == 5.0);
+}
+
+
+TEST_CASE("read_from_stream_appends")
+{
+   std::istringstream stream1("Block A\n    1   1");
+   std::istringstream stream2("Block a\n    2   2\n");
+
+   gm2calc::GM2_slha_io slha;
+   slha.read_from_stream(stream1);
+   slha.read_from_stream(stream2);
+
+   Eigen::Matrix<double,2,1> v;
+   v.setZero();
+   slha.read_block("A", v);
+
+   CHECK(v(0) == 1.0);
+   CHECK(v(1) == 2.0);
+}
+
+
+TEST_CASE("read_block_non_numeric")
+{
+   char const * const slha_input[] = {
+      "Block A\n 1 x\n",
+      "Block A\n x 1\n",
+      "Block A\n 1 # comment\n",
+      "Block A\n 1 inf\n",
+      "Block A\n 1 1e400\n",
+      "Block A\n 99999999999 1\n"
+   };
+
+   for (const auto input: slha_input) {
+      std::istringstream stream(input);
+      gm2calc::GM2_slha_io slha;
+      slha.read_from_stream(stream);
+      CHECK_THROWS_AS(slha.read_block("A", [] (int, double) {}), gm2calc::EReadError);
+   }
+}
+
+
+TEST_CASE("read_scale")
+{
+   std::istringstream stream("Block HMIX Q= 100\n    2   20\nBlock A\n    1   1\n");
+   gm2calc::GM2_slha_io slha;
+   slha.read_from_stream(stream);
+
+   CHECK(slha.read_scale("HMIX") == 100.0);
+   CHECK(slha.read_scale("A") == 0.0);
+
+   // scale of the last block is not a finite number
+   std::istringstream stream2("Block HMIX Q= 1e400\n    2   22\n");
+   slha.read_from_stream(stream2);
+
+   CHECK_THROWS_AS(slha.read_scale("HMIX"), gm2calc::EReadError);
+}
+
+
+TEST_CASE("slha_stream")
+{
+   char const * const slha_input = R"(
+# comment before the first document
+Block SPINFO
+    1   A
+Block A
+    1   1
+block spinfo
+    1   B
+Block A
+    1   2
+   ---
+# comment
+   ---
+Block A
+    1   3
+---
+)";
+
+   std::istringstream stream(slha_input);
+   gm2calc::GM2_slha_stream slha_stream(stream, "---");
+   gm2calc::GM2_slha_io slha;
+
+   std::vector<double> values;
+
+   while (slha_stream.next(slha)) {
+      slha.read_block("A", [&values] (int key, double value) {
+         if (key == 1) {
+            values.push_back(value);
+         }
+      });
+   }
+
+   CHECK(slha_stream.get_number_of_documents() == 3);
+   REQUIRE(values.size() == 3);
+   CHECK(values[0] == 1.0);
+   CHECK(values[1] == 2.0);
+   CHECK(values[2] == 3.0);
+   CHECK(!slha_stream.next(slha));
+}
+
+
+TEST_CASE("slha_stream_c_interface")
+{
+   const char* file_name = "test_slha_io_stream.slha";
+
+   {
+      std::ofstream ofs(file_name);
+      for (int i = 1; i <= 3; i++) {
+         ofs << "Block MINPAR\n"
+             << "    3   " << 10*i << "   # tan(beta)\n"
+             << "Block MASS\n"
+             << "   36   " << 100*i << "   # mA\n"
+             << "# END\n";
+      }
+   }
+
+   gm2calc_slha_stream* stream = nullptr;
+
+   CHECK(gm2calc_slha_stream_open(&stream, "non-existing-file.slha", nullptr) == gm2calc_InvalidInput);
+   CHECK(stream == nullptr);
+
+   REQUIRE(gm2calc_slha_stream_open(&stream, file_name, "# END") == gm2calc_NoError);
+
+   int n = 0;
+
+   while (gm2calc_slha_stream_next(stream) > 0) {
+      n++;
+      gm2calc_THDM_mass_basis basis;
+      CHECK(gm2calc_slha_stream_fill_thdm_mass_basis(stream, &basis) == gm2calc_NoError);
+      CHECK(basis.tan_beta == 10.0*n);
+      CHECK(basis.mA == 100.0*n);
+   }
+
+   CHECK(n == 3);
+
+   gm2calc_slha_stream_free(stream);
+   std::remove(file_name);
+}
+
+
+TEST_CASE("slha_stream_c_interface_malformed_document")
+{
+   const char* file_name = "test_slha_io_stream_malformed.slha";
+
+   {
+      std::ofstream ofs(file_name);
+      ofs << "Block MINPAR\n"
+          << "    3   10   # tan(beta)\n"
+          << "# END\n"
+          << "malformed\n"
+          << "Block MINPAR\n"
+          << "    3   20   # tan(beta)\n"
+          << "# END\n"
+          << "Block MINPAR\n"
+          << "    3   30   # tan(beta)\n"
+          << "# END\n";
+   }
+
+   gm2calc_slha_stream* stream = nullptr;
+
+   REQUIRE(gm2calc_slha_stream_open(&stream, file_name, "# END") == gm2calc_NoError);
+
+   gm2calc_THDM_mass_basis basis;
+
+   CHECK(gm2calc_slha_stream_next(stream) == 1);
+   CHECK(gm2calc_slha_stream_fill_thdm_mass_basis(stream, &basis) == gm2calc_NoError);
+   CHECK(basis.tan_beta == 10.0);
+
+   // the malformed second document is reported, not taken as the end
+   CHECK(gm2calc_slha_stream_next(stream) == -1);
+
+   CHECK(gm2calc_slha_stream_next(stream) == 1);
+   CHECK(gm2calc_slha_stream_fill_thdm_mass_basis(stream, &basis) == gm2calc_NoError);
+   CHECK(basis.tan_beta == 30.0);
+
+   CHECK(gm2calc_slha_stream_next(stream) == 0);
+   CHECK(gm2calc_slha_stream_next(nullptr) == -1);
+
+   gm2calc_slha_stream_free(stream);
+   std::remove(file_name);
+}
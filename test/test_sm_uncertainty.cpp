@@ -0,0 +1,151 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_sm_uncertainty.hpp"
+#include "gm2calc/SM.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+gm2calc::thdm::Mass_basis make_basis()
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::type_2;
+   basis.mh = 125;
+   basis.mH = 400;
+   basis.mA = 420;
+   basis.mHp = 440;
+   basis.sin_beta_minus_alpha = 0.999;
+   basis.tan_beta = 3;
+   basis.m122 = 40000;
+   return basis;
+}
+
+double calculate_amu(const gm2calc::thdm::Mass_basis& basis, const gm2calc::SM& sm)
+{
+   const gm2calc::THDM model(basis, sm);
+   return gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("no_uncertainty")
+{
+   const auto basis = make_basis();
+   const gm2calc::SM sm;
+
+   gm2calc::thdm::SM_uncertainty_options options;
+   options.delta_alpha_s_mz = options.delta_mt = options.delta_mbmb = options.delta_mw = 0;
+   options.samples = 10;
+
+   const auto result = gm2calc::calculate_sm_uncertainty_amu(basis, sm, options);
+   const double amu = calculate_amu(basis, sm);
+
+   CHECK(result.samples == 10);
+   CHECK(result.failed == 0);
+   CHECK(result.mean == doctest::Approx(amu).epsilon(1e-14));
+   CHECK(result.stddev <= 1e-14*std::abs(amu));
+   REQUIRE(result.quantiles.size() == options.probabilities.size());
+
+   for (const double q: result.quantiles) {
+      CHECK(q == amu);
+   }
+}
+
+
+TEST_CASE("linear_propagation")
+{
+   const auto basis = make_basis();
+   const gm2calc::SM sm;
+
+   gm2calc::thdm::SM_uncertainty_options options;
+   options.samples = 2000;
+   options.sequence = gm2calc::Scan_sequence::Type::latin_hypercube;
+
+   const auto result = gm2calc::calculate_sm_uncertainty_amu(basis, sm, options);
+
+   // linear error propagation with finite differences
+   const double amu = calculate_amu(basis, sm);
+   double var = 0;
+
+   {
+      gm2calc::SM s(sm);
+      s.set_alpha_s_mz(sm.get_alpha_s_mz() + options.delta_alpha_s_mz);
+      var += std::pow(calculate_amu(basis, s) - amu, 2);
+   }
+   {
+      gm2calc::SM s(sm);
+      s.set_mu(2, sm.get_mu(2) + options.delta_mt);
+      var += std::pow(calculate_amu(basis, s) - amu, 2);
+   }
+   {
+      gm2calc::SM s(sm);
+      s.set_md(2, sm.get_md(2) + options.delta_mbmb);
+      var += std::pow(calculate_amu(basis, s) - amu, 2);
+   }
+   {
+      gm2calc::SM s(sm);
+      s.set_mw(sm.get_mw() + options.delta_mw);
+      var += std::pow(calculate_amu(basis, s) - amu, 2);
+   }
+
+   CHECK(result.samples == 2000);
+   CHECK(result.stddev > 0);
+   CHECK(result.stddev == doctest::Approx(std::sqrt(var)).epsilon(0.05));
+   CHECK(result.mean == doctest::Approx(amu).epsilon(0.1*result.stddev/std::abs(amu)));
+
+   // 68% interval and median
+   CHECK(std::is_sorted(result.quantiles.cbegin(), result.quantiles.cend()));
+   CHECK(result.quantiles[2] == doctest::Approx(result.mean).epsilon(0.1*result.stddev/std::abs(amu)));
+   CHECK(0.5*(result.quantiles[3] - result.quantiles[1]) == doctest::Approx(result.stddev).epsilon(0.1));
+}
+
+
+TEST_CASE("deterministic")
+{
+   const auto basis = make_basis();
+   const gm2calc::SM sm;
+
+   gm2calc::thdm::SM_uncertainty_options options;
+   options.samples = 100;
+   options.seed = 42;
+
+   options.threads = 1;
+   const auto result_1 = gm2calc::calculate_sm_uncertainty_amu(basis, sm, options);
+   options.threads = 3;
+   const auto result_3 = gm2calc::calculate_sm_uncertainty_amu(basis, sm, options);
+   options.seed = 43;
+   const auto result_other = gm2calc::calculate_sm_uncertainty_amu(basis, sm, options);
+
+   CHECK(result_1.mean == result_3.mean);
+   CHECK(result_1.stddev == result_3.stddev);
+   CHECK(result_1.quantiles == result_3.quantiles);
+   CHECK(result_1.mean != result_other.mean);
+}
+
+
+TEST_CASE("invalid_input")
+{
+   const auto basis = make_basis();
+   const gm2calc::SM sm;
+   gm2calc::thdm::SM_uncertainty_options options;
+
+   options.delta_mt = -1;
+   CHECK_THROWS_AS(gm2calc::calculate_sm_uncertainty_amu(basis, sm, options), gm2calc::EInvalidInput);
+
+   options = gm2calc::thdm::SM_uncertainty_options{};
+   options.samples = 1;
+   CHECK_THROWS_AS(gm2calc::calculate_sm_uncertainty_amu(basis, sm, options), gm2calc::EInvalidInput);
+
+   options = gm2calc::thdm::SM_uncertainty_options{};
+   options.probabilities = {1.5};
+   CHECK_THROWS_AS(gm2calc::calculate_sm_uncertainty_amu(basis, sm, options), gm2calc::EInvalidInput);
+}
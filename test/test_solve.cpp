@@ -0,0 +1,183 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2calc/gm2_1loop.hpp"
+#include "gm2calc/gm2_2loop.hpp"
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/gm2_solve.hpp"
+#include "gm2calc/MSSMNoFV_onshell.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <cmath>
+
+namespace {
+
+gm2calc::thdm::Mass_basis make_basis(double tb)
+{
+   gm2calc::thdm::Mass_basis basis;
+   basis.yukawa_type = gm2calc::thdm::Yukawa_type::type_X;
+   basis.mh = 125;
+   basis.mH = 400;
+   basis.mA = 50;
+   basis.mHp = 400;
+   basis.sin_beta_minus_alpha = 1;
+   basis.tan_beta = tb;
+   basis.m122 = 400*400*tb/(1 + tb*tb);
+   return basis;
+}
+
+void set_tan_beta(gm2calc::thdm::Mass_basis& basis, double tb)
+{
+   basis.tan_beta = tb;
+   basis.m122 = basis.mH*basis.mH*tb/(1 + tb*tb);
+}
+
+double calculate_amu(const gm2calc::thdm::Mass_basis& basis)
+{
+   const gm2calc::THDM model(basis);
+   return gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model);
+}
+
+gm2calc::MSSMNoFV_onshell setup()
+{
+   gm2calc::MSSMNoFV_onshell model;
+
+   const double Pi = 3.141592653589793;
+   const Eigen::Matrix<double,3,3> UnitMatrix
+      = Eigen::Matrix<double,3,3>::Identity();
+
+   model.set_alpha_MZ(0.0077552);
+   model.set_alpha_thompson(0.00729735);
+   model.set_g3(std::sqrt(4 * Pi * 0.1184));
+   model.get_physical().MFt   = 173.34;
+   model.get_physical().MFb   = 4.18;
+   model.get_physical().MFm   = 0.1056583715;
+   model.get_physical().MFtau = 1.777;
+   model.get_physical().MVWm  = 80.385;
+   model.get_physical().MVZ   = 91.1876;
+   model.set_TB(10);
+   model.set_Mu(350);
+   model.set_MassB(150);
+   model.set_MassWB(300);
+   model.set_MassG(1000);
+   model.set_mq2(500 * 500 * UnitMatrix);
+   model.set_ml2(500 * 500 * UnitMatrix);
+   model.set_md2(500 * 500 * UnitMatrix);
+   model.set_mu2(500 * 500 * UnitMatrix);
+   model.set_me2(500 * 500 * UnitMatrix);
+   model.set_MA0(1500);
+   model.set_scale(454.7);
+
+   return model;
+}
+
+double calculate_amu(gm2calc::MSSMNoFV_onshell model)
+{
+   model.calculate_masses();
+   return gm2calc::calculate_amu_1loop(model) + gm2calc::calculate_amu_2loop(model);
+}
+
+} // anonymous namespace
+
+
+TEST_CASE("function")
+{
+   const auto f = [] (double x) { return x*x*x; };
+
+   gm2calc::Solve_options options;
+   options.rel_tolerance = 1e-12;
+
+   const auto result = gm2calc::solve_for_parameter(f, 2, 0, 3, options);
+
+   CHECK(result.converged);
+   CHECK(result.value == doctest::Approx(std::cbrt(2.0)).epsilon(1e-12));
+   CHECK(result.amu == doctest::Approx(2).epsilon(1e-11));
+   CHECK(result.lower <= result.value);
+   CHECK(result.value <= result.upper);
+   CHECK(result.evaluations == result.iterations + 2);
+   CHECK(result.evaluations < 15);
+   CHECK(result.seconds >= 0);
+
+   // root at the end of the bracket
+   const auto result_end = gm2calc::solve_for_parameter(f, 27, 0, 3, options);
+
+   CHECK(result_end.converged);
+   CHECK(result_end.value == 3);
+   CHECK(result_end.evaluations == 2);
+}
+
+
+TEST_CASE("max_iterations")
+{
+   const auto f = [] (double x) { return std::exp(x) - 1; };
+
+   gm2calc::Solve_options options;
+   options.rel_tolerance = 1e-14;
+   options.max_iterations = 2;
+
+   const auto result = gm2calc::solve_for_parameter(f, 1, -5, 5, options);
+
+   CHECK(!result.converged);
+   CHECK(result.iterations == 2);
+   CHECK(result.lower < std::log(2.0));
+   CHECK(result.upper > std::log(2.0));
+}
+
+
+TEST_CASE("THDM_tan_beta")
+{
+   const double tb = 40;
+   const double target = calculate_amu(make_basis(tb));
+
+   gm2calc::Solve_options options;
+   options.rel_tolerance = 1e-10;
+
+   const auto result = gm2calc::solve_for_parameter(
+      make_basis(10), set_tan_beta, target, 10, 100, options);
+
+   CHECK(result.converged);
+   CHECK(result.value == doctest::Approx(tb).epsilon(1e-8));
+   CHECK(result.amu == doctest::Approx(target).epsilon(1e-8));
+   CHECK(result.evaluations < 15);
+}
+
+
+TEST_CASE("MSSMNoFV_tan_beta")
+{
+   auto model = setup();
+   model.set_TB(25);
+   const double target = calculate_amu(model);
+
+   gm2calc::Solve_options options;
+   options.rel_tolerance = 1e-10;
+
+   const auto result = gm2calc::solve_for_parameter(
+      setup(), [] (gm2calc::MSSMNoFV_onshell& m, double tb) { m.set_TB(tb); },
+      target, 5, 50, options);
+
+   CHECK(result.converged);
+   CHECK(result.value == doctest::Approx(25).epsilon(1e-8));
+   CHECK(result.amu == doctest::Approx(target).epsilon(1e-8));
+   CHECK(result.evaluations < 15);
+}
+
+
+TEST_CASE("invalid_input")
+{
+   const auto f = [] (double x) { return x*x; };
+   gm2calc::Solve_options options;
+
+   // no sign change
+   CHECK_THROWS_AS(gm2calc::solve_for_parameter(f, -1, -1, 1, options), gm2calc::EInvalidInput);
+
+   // empty bracket
+   CHECK_THROWS_AS(gm2calc::solve_for_parameter(f, 0.5, 1, 0, options), gm2calc::EInvalidInput);
+
+   // a_mu not finite
+   const auto g = [] (double x) { return x > 0 ? NAN : x; };
+   CHECK_THROWS_AS(gm2calc::solve_for_parameter(g, -0.5, -1, 1, options), gm2calc::EPhysicalProblem);
+
+   options.rel_tolerance = 0;
+   CHECK_THROWS_AS(gm2calc::solve_for_parameter(f, 0.5, 0, 1, options), gm2calc::EInvalidInput);
+}
@@ -0,0 +1,136 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN 1
+
+#include "doctest.h"
+
+#include "gm2_thdm_table.hpp"
+
+#include "gm2calc/gm2_error.hpp"
+#include "gm2calc/THDM.hpp"
+
+#include <sstream>
+
+
+TEST_CASE("read_mass_basis_csv")
+{
+   std::istringstream istr(R"(# THDM points
+mh, mH, mA, mHp, sin_beta_minus_alpha, lambda_6, lambda_7, tan_beta, m122, zeta_u, zeta_d, zeta_l, yukawa_type, Delta_l_23
+
+125, 400, 420, 440, 0.999, 0.2, 0.1, 3, 40000, 0, 0, 0, 2, 0.5
+# comment
+126, 401, 421, 441, 0.998, 0.3, 0.4, 4, 50000, 1, 2, 3, 6, 0
+)");
+
+   gm2calc::GM2_thdm_table table(istr);
+   gm2calc::thdm::Mass_basis basis;
+
+   CHECK(table.get_basis() == gm2calc::GM2_thdm_table::Basis::Mass);
+   CHECK(table.get_column_names().size() == 14);
+
+   REQUIRE(table.next(basis));
+   CHECK(table.get_line_number() == 4);
+   CHECK(basis.mh == 125);
+   CHECK(basis.mH == 400);
+   CHECK(basis.mA == 420);
+   CHECK(basis.mHp == 440);
+   CHECK(basis.sin_beta_minus_alpha == 0.999);
+   CHECK(basis.lambda_6 == 0.2);
+   CHECK(basis.lambda_7 == 0.1);
+   CHECK(basis.tan_beta == 3);
+   CHECK(basis.m122 == 40000);
+   CHECK(basis.yukawa_type == gm2calc::thdm::Yukawa_type::type_2);
+   CHECK(basis.Delta_l(1,2) == 0.5);
+
+   REQUIRE(table.next(basis));
+   CHECK(table.get_line_number() == 6);
+   CHECK(basis.mh == 126);
+   CHECK(basis.zeta_u == 1);
+   CHECK(basis.zeta_d == 2);
+   CHECK(basis.zeta_l == 3);
+   CHECK(basis.yukawa_type == gm2calc::thdm::Yukawa_type::general);
+   CHECK(basis.Delta_l(1,2) == 0);
+
+   CHECK(!table.next(basis));
+
+   gm2calc::thdm::Gauge_basis gauge_basis;
+   CHECK_THROWS_AS(table.next(gauge_basis), gm2calc::ESetupError);
+}
+
+
+TEST_CASE("read_gauge_basis_whitespace")
+{
+   std::istringstream istr(
+      "lambda_1 lambda_2 lambda_3 lambda_4 lambda_5 lambda_6 lambda_7 tan_beta\n"
+      "  0.7  0.6 0.5 0.4 0.3 0.2 0.1  3\n");
+
+   gm2calc::GM2_thdm_table table(istr);
+   gm2calc::thdm::Gauge_basis basis;
+
+   CHECK(table.get_basis() == gm2calc::GM2_thdm_table::Basis::Gauge);
+
+   REQUIRE(table.next(basis));
+   CHECK(basis.lambda(0) == 0.7);
+   CHECK(basis.lambda(4) == 0.3);
+   CHECK(basis.lambda(6) == 0.1);
+   CHECK(basis.tan_beta == 3);
+   CHECK(basis.m122 == 0);
+
+   CHECK(!table.next(basis));
+}
+
+
+TEST_CASE("read_tsv")
+{
+   std::istringstream istr("mh\tmA\ttan_beta\n125\t 500\t10\n");
+
+   gm2calc::GM2_thdm_table table(istr);
+   gm2calc::thdm::Mass_basis basis;
+
+   REQUIRE(table.next(basis));
+   CHECK(basis.mh == 125);
+   CHECK(basis.mA == 500);
+   CHECK(basis.tan_beta == 10);
+}
+
+
+TEST_CASE("read_invalid_header")
+{
+   const char* headers[] = {
+      "",                      // no header
+      "tan_beta,m122",         // no basis
+      "mh,lambda_1",           // mass and gauge basis
+      "mh,mA,unknown",         // unknown column
+      "mh,mA,mh",              // duplicate column
+      "mh,Delta_u_14",         // invalid matrix index
+   };
+
+   for (const auto h: headers) {
+      std::istringstream istr(h);
+      CHECK_THROWS_AS(gm2calc::GM2_thdm_table{istr}, gm2calc::Error);
+   }
+}
+
+
+TEST_CASE("read_invalid_rows")
+{
+   std::istringstream istr(R"(mh,mA,yukawa_type
+125,500
+125,abc,2
+125,500,7
+125,500,2.5
+125,500,1
+)");
+
+   gm2calc::GM2_thdm_table table(istr);
+   gm2calc::thdm::Mass_basis basis;
+
+   // each invalid row is consumed, such that reading can continue
+   CHECK_THROWS_AS(table.next(basis), gm2calc::EReadError);
+   CHECK(table.get_line_number() == 2);
+   CHECK_THROWS_AS(table.next(basis), gm2calc::EReadError);
+   CHECK_THROWS_AS(table.next(basis), gm2calc::EReadError);
+   CHECK_THROWS_AS(table.next(basis), gm2calc::EReadError);
+
+   REQUIRE(table.next(basis));
+   CHECK(basis.yukawa_type == gm2calc::thdm::Yukawa_type::type_1);
+   CHECK(!table.next(basis));
+}